@@ -167,6 +167,16 @@ MeshCodec::loadModel(const Path& filePath) {
 
   SPtr<Model> model = chMakeShared<Model>();
 
+  // Count the hierarchy first so every node comes from a single reservation
+  Function<uint32(const aiNode*)> countNodes = [&countNodes](const aiNode* node) {
+    uint32 count = 1;
+    for (uint32 i = 0; i < node->mNumChildren; ++i) {
+      count += countNodes(node->mChildren[i]);
+    }
+    return count;
+  };
+  model->reserveNodes(countNodes(scene->mRootNode));
+
   // Procesar el árbol de nodos comenzando por la raíz
   processNodeForModel(scene->mRootNode, scene, model, nullptr);
 
@@ -323,6 +333,13 @@ MeshCodec::processMesh(aiMesh* mesh, const aiScene* scene) {
     }
   }
 
+  const MeshOptimizationStats stats = newMesh->optimize();
+  CH_LOG_INFO(MeshSystem,
+              "Optimized mesh {0}: vertices {1} -> {2}, ACMR {3} -> {4}, "
+              "ATVR {5} -> {6}",
+              String(mesh->mName.C_Str()), stats.verticesBefore, stats.verticesAfter,
+              stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr);
+
   return newMesh;
 }
 
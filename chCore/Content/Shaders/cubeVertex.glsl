@@ -5,24 +5,26 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 
-layout(binding = 0) uniform ProjectionViewModel {
+// Per instance, one column per location
+layout(location = 3) in mat4 inModel;
+
+layout(binding = 0) uniform ProjectionView {
     mat4 projection;
     mat4 view;
-    mat4 model;
-} pvm;
+} pv;
 
 layout(location = 0) out vec3 fragNormal;
 layout(location = 1) out vec2 fragTexCoord;
 layout(location = 2) out vec3 fragPosition;
 
 void main() {
-    vec4 worldPos = pvm.model * vec4(inPosition, 1.0);
+    vec4 worldPos = inModel * vec4(inPosition, 1.0);
     
     fragPosition = worldPos.xyz;
     
-    gl_Position = pvm.projection * pvm.view * worldPos;
+    gl_Position = pv.projection * pv.view * worldPos;
     
-    fragNormal = mat3(pvm.model) * inNormal;
+    fragNormal = mat3(inModel) * inNormal;
     
     fragTexCoord = inTexCoord;
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
  */
 #include "chBaseApplication.h"
 
+#include "chJobSystem.h"
 #include "chLogger.h"
 #include "chStringUtils.h"
 
@@ -71,11 +72,34 @@ BaseApplication::run() {
 
     // Update the accumulator
     accumulator += deltaTime;
-    while (accumulator >= fixedTimeStamp) {
+    uint32 fixedSteps = 0;
+    while (accumulator >= fixedTimeStamp && fixedSteps < MAX_FIXED_STEPS_PER_FRAME) {
       // Update the application logic
       update(static_cast<float>(fixedTimeStamp));
       accumulator -= fixedTimeStamp;
+      ++fixedSteps;
     }
+    accumulator = Math::min(accumulator, fixedTimeStamp);
+  }
+}
+
+/*
+*/
+void
+BaseApplication::initializeModules() {
+  if (!JobSystem::isStarted()) {
+    JobSystem::startUp();
+    CH_LOG_INFO(BaseApp, "JobSystem started with {0} workers.",
+                JobSystem::instance().getWorkerCount());
+  }
+}
+
+/*
+*/
+void
+BaseApplication::destroyModules() {
+  if (JobSystem::isStarted()) {
+    JobSystem::shutDown();
   }
 }
 
@@ -52,11 +52,22 @@ class CH_CORE_EXPORT BaseApplication : public Module<BaseApplication> {
   requestExit(const String& reason);
 
  protected:
+  /*
+   * Description:
+   *     Most fixed updates run before a frame is rendered. Time that could not be
+   *     simulated is dropped, the simulation slows down instead of stalling the frame.
+   */
+  static constexpr uint32 MAX_FIXED_STEPS_PER_FRAME = 4;
+
+  /*
+   * Description:
+   *     Starts the JobSystem, overrides must call it.
+   */
   virtual void
-  initializeModules() {}
+  initializeModules();
 
   virtual void
-  destroyModules() {}
+  destroyModules();
 
   virtual void
   onPostInitialize() {}
@@ -82,11 +82,15 @@ WindowedApplication::run() {
 
     // Update the accumulator
     accumulator += deltaTime;
-    while (accumulator >= fixedTimeStamp) {
+    uint32 fixedSteps = 0;
+    while (accumulator >= fixedTimeStamp && fixedSteps < MAX_FIXED_STEPS_PER_FRAME) {
       // Update the application logic
       update(static_cast<float>(fixedTimeStamp));
       accumulator -= fixedTimeStamp;
+      ++fixedSteps;
     }
+    // Catch-up is capped so a slow frame is still rendered, the backlog is dropped
+    accumulator = Math::min(accumulator, fixedTimeStamp);
 
     // Render the application
     render(static_cast<float>(deltaTime));
@@ -298,6 +302,7 @@ WindowedApplication::destroyGraphics() {
 
   IGraphicsAPI& graphicsAPI = IGraphicsAPI::instance();
   graphicsAPI.waitIdle();
+  graphicsAPI.savePipelineCache();
 
   CH_LOG_INFO(WindowedApp, "Graphics subsystem destroyed successfully.");
 }
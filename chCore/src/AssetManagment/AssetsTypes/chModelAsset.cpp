@@ -97,7 +97,7 @@ ModelAsset::serializeNode(SPtr<DataStream> stream, ModelNode* node,
   stream << node->getGlobalTransform();
 
   // Serialize meshes (as indices to unique mesh array)
-  const Vector<SPtr<Mesh>>& meshes = node->getMeshes();
+  const ModelNode::MeshList& meshes = node->getMeshes();
   stream << static_cast<uint32>(meshes.size());
 
   for (const SPtr<Mesh>& mesh : meshes) {
@@ -113,7 +113,7 @@ ModelAsset::serializeNode(SPtr<DataStream> stream, ModelNode* node,
   }
 
   // Serialize children recursively
-  const Vector<ModelNode*>& children = node->getChildren();
+  const ModelNode::NodeList& children = node->getChildren();
   stream << static_cast<uint32>(children.size());
 
   for (ModelNode* child : children) {
@@ -224,8 +224,9 @@ ModelAsset::deserialize(SPtr<DataStream> stream) {
       return false;
     }
 
-    // Create new model
+    // Create new model, all nodes come from a single reservation
     m_model = chMakeShared<Model>();
+    m_model->reserveNodes(modelHeader.nodeCount);
 
     // Read global model transform
     Matrix4 globalTransform;
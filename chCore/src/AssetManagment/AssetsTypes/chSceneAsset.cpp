@@ -0,0 +1,41 @@
+/************************************************************************/
+/**
+ * @file chSceneAsset.cpp
+ * @author AccelMR
+ * @date 2025/08/01
+ * @brief
+ */
+/************************************************************************/
+#include "chSceneAsset.h"
+
+#include "chScene.h"
+#include "chSceneSnapshot.h"
+
+namespace chEngineSDK {
+
+/*
+*/
+void
+SceneAsset::clearAssetData() {
+  m_scene.reset();
+}
+
+/*
+*/
+bool
+SceneAsset::serialize(SPtr<DataStream> stream) {
+  if (!m_scene) {
+    return false;
+  }
+  return SceneSnapshot::save(*m_scene, stream);
+}
+
+/*
+*/
+bool
+SceneAsset::deserialize(SPtr<DataStream> stream) {
+  m_scene = SceneSnapshot::load(stream, getName(), getUUID());
+  return m_scene != nullptr;
+}
+
+} // namespace chEngineSDK
@@ -25,27 +25,25 @@ class CH_CORE_EXPORT SceneAsset : public IAsset {
     return m_scene;
   }
 
+  /**
+   * Set the scene written by the next save, stored as a binary SceneSnapshot
+   */
+  void
+  setScene(const SPtr<Scene>& scene) {
+    m_scene = scene;
+  }
 
  protected:
   void
-  clearAssetData() override {
-    // Clear scene-specific data here
-  }
+  clearAssetData() override;
 
   bool
-  serialize(SPtr<DataStream> stream) override {
-    // Implement scene serialization logic here
-    return true;
-  }
+  serialize(SPtr<DataStream> stream) override;
 
   bool
-  deserialize(SPtr<DataStream> stream) override {
-    // Implement scene deserialization logic here
-    return true;
-  }
+  deserialize(SPtr<DataStream> stream) override;
 
  private:
-  // Scene-specific data members
   SPtr<Scene> m_scene;
 };
 DECLARE_ASSET_TYPE(SceneAsset);
@@ -26,6 +26,16 @@ enum class QueueType : uint32 {
   Count
 };
 
+enum class CommandBufferLevel : uint8 {
+  Primary,
+  Secondary // Recorded on its own and run by a primary with executeCommands
+};
+
+enum class SubpassContents : uint8 {
+  Inline,
+  SecondaryCommandBuffers
+};
+
 enum class CompareOp {
   Never,
   Less,
@@ -78,6 +88,11 @@ enum class Format : uint32 {
   COUNT
 };
 
+NODISCARD constexpr bool
+isDepthFormat(Format format) {
+  return format == Format::D32_SFLOAT || format == Format::D24_UNORM_S8_UINT;
+}
+
 enum class LoadOp : uint32 {
   Load = 0,
   Clear,
@@ -159,7 +174,8 @@ enum class BufferUsage : uint16 {
   UniformBuffer = 0x04,
   StorageBuffer = 0x08,
   TransferSrc = 0x10,
-  TransferDst = 0x20
+  TransferDst = 0x20,
+  IndirectBuffer = 0x40
 };
 CH_FLAGS_OPERATORS_EXT(BufferUsage, uint16);
 using BufferUsageFlags = Flags<BufferUsage, uint16>;
@@ -193,6 +209,8 @@ enum class DescriptorType {
   UniformBuffer,
   StorageBuffer,
   CombinedImageSampler,
+  UniformBufferDynamic, ///< Offset given at bind time through dynamicOffsets
+  StorageBufferDynamic, ///< Offset given at bind time through dynamicOffsets
 };
 
 enum class PipelineStage : uint32 {
@@ -207,7 +225,9 @@ enum class PipelineStage : uint32 {
   Transfer                = 1 << 7,
   BottomOfPipe            = 1 << 8,
   AllGraphics             = 1 << 9,
-  AllCommands             = 1 << 10
+  AllCommands             = 1 << 10,
+  EarlyFragmentTests      = 1 << 11,
+  LateFragmentTests       = 1 << 12
 };
 CH_FLAGS_OPERATORS_EXT(PipelineStage, uint32);
 using PipelineStageFlags = Flags<PipelineStage, uint32>;
@@ -403,6 +423,36 @@ struct RenderPassBeginInfo {
   SPtr<IFrameBuffer> framebuffer;
   Vector<LinearColor> clearValues;
   Optional<std::pair<float, uint32>> depthStencilClearValue = NullOpt;
+
+  // SecondaryCommandBuffers when the pass is only filled with executeCommands
+  SubpassContents contents = SubpassContents::Inline;
+};
+
+/**
+ * Render pass a secondary command buffer is going to be executed in
+ */
+struct CommandBufferInheritanceInfo {
+  SPtr<IRenderPass> renderPass;
+  SPtr<IFrameBuffer> framebuffer; // Optional, may let the driver optimize
+  uint32 subpass = 0;
+};
+
+/**
+ * Layout of one draw in an indirect buffer, matches what the GPU reads
+ */
+struct DrawIndirectCommand {
+  uint32 vertexCount;
+  uint32 instanceCount;
+  uint32 firstVertex;
+  uint32 firstInstance;
+};
+
+struct DrawIndexedIndirectCommand {
+  uint32 indexCount;
+  uint32 instanceCount;
+  uint32 firstIndex;
+  int32 vertexOffset;
+  uint32 firstInstance;
 };
 
 struct SubmitInfo {
@@ -412,6 +462,17 @@ struct SubmitInfo {
   Vector<SPtr<ISemaphore>> signalSemaphores;
 };
 
+/**
+ * Layout transition and memory dependency of a whole texture, every mip and layer
+ */
+struct TextureBarrier {
+  SPtr<ITexture> texture;
+  TextureLayout oldLayout = TextureLayout::Undefined;
+  TextureLayout newLayout = TextureLayout::Undefined;
+  AccessFlags srcAccess = Access::NoAccess;
+  AccessFlags dstAccess = Access::NoAccess;
+};
+
 struct DescriptorSetLayoutBinding {
   uint32 binding = 0;
   DescriptorType type = DescriptorType::UniformBuffer;
@@ -426,6 +487,7 @@ struct DescriptorSetLayoutCreateInfo {
 struct DescriptorPoolCreateInfo {
   uint32 maxSets = 0;
   Vector<Pair<DescriptorType, uint32>> poolSizes;
+  bool freeDescriptorSets = true; ///< False when sets are only released through reset
 };
 
 struct DescriptorSetAllocateInfo {
@@ -34,6 +34,14 @@ class ICommandBuffer {
   virtual void
   begin() = 0;
 
+  /**
+   * Begin a secondary command buffer that runs entirely inside a subpass of the given
+   * render pass. Viewport, scissor, pipeline and descriptor sets are not inherited from
+   * the primary and have to be set again.
+   */
+  virtual void
+  beginSecondary(const CommandBufferInheritanceInfo& inheritanceInfo) = 0;
+
   virtual void
   end() = 0;
 
@@ -78,6 +86,35 @@ class ICommandBuffer {
               int32 vertexOffset = 0,
               uint32 firstInstance = 0) = 0;
 
+  /**
+   * @brief Issues draws whose parameters are read from a buffer when the GPU runs them.
+   *
+   * @param buffer Buffer created with BufferUsage::IndirectBuffer.
+   * @param offset Byte offset of the first DrawIndirectCommand.
+   * @param drawCount Number of consecutive commands to draw.
+   * @param stride Bytes between two commands.
+   */
+  virtual void
+  drawIndirect(SPtr<IBuffer> buffer,
+               uint64 offset,
+               uint32 drawCount = 1,
+               uint32 stride = sizeof(DrawIndirectCommand)) = 0;
+
+  /**
+   * @brief Issues indexed draws whose parameters are read from a buffer, several commands
+   * go out as a single multi draw when the device supports it.
+   *
+   * @param buffer Buffer created with BufferUsage::IndirectBuffer.
+   * @param offset Byte offset of the first DrawIndexedIndirectCommand.
+   * @param drawCount Number of consecutive commands to draw.
+   * @param stride Bytes between two commands.
+   */
+  virtual void
+  drawIndexedIndirect(SPtr<IBuffer> buffer,
+                      uint64 offset,
+                      uint32 drawCount = 1,
+                      uint32 stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+
   virtual void
   setViewport(float x, float y,
               float width, float height,
@@ -93,6 +130,22 @@ class ICommandBuffer {
                      const Vector<SPtr<IDescriptorSet>>& descriptorSets,
                      const Vector<uint32>& dynamicOffsets = {}) = 0;
 
+  /**
+   * Make the work of srcStages available to dstStages and move textures to new layouts.
+   * Has to be recorded outside of a render pass.
+   */
+  virtual void
+  pipelineBarrier(PipelineStageFlags srcStages,
+                  PipelineStageFlags dstStages,
+                  const Vector<TextureBarrier>& textureBarriers) = 0;
+
+  /**
+   * Run recorded secondary command buffers, the render pass has to be begun with
+   * SubpassContents::SecondaryCommandBuffers.
+   */
+  virtual void
+  executeCommands(const Vector<SPtr<ICommandBuffer>>& commandBuffers) = 0;
+
   NODISCARD virtual
   CommandBufferState getState() const = 0;
 };
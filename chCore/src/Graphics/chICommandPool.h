@@ -13,14 +13,20 @@
 
 #include "chPrerequisitesCore.h"
 
+#include "chGraphicsTypes.h"
+
 namespace chEngineSDK {
 class ICommandPool {
  public:
   ICommandPool() = default;
   virtual ~ICommandPool() = default;
 
-  NODISCARD virtual SPtr<ICommandBuffer> 
-  allocateCommandBuffer() = 0;
+  /**
+   * Secondary buffers can be recorded while the primary is recorded on another thread as
+   * long as every thread records from its own pool.
+   */
+  NODISCARD virtual SPtr<ICommandBuffer>
+  allocateCommandBuffer(CommandBufferLevel level = CommandBufferLevel::Primary) = 0;
 
   virtual void 
   reset() = 0;
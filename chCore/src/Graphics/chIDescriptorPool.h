@@ -32,5 +32,20 @@ class IDescriptorPool {
    */
   virtual SPtr<IDescriptorSet>
   allocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) = 0;
+
+  /**
+   * @brief Allocate a descriptor set, without throwing when the pool is exhausted.
+   * @param allocInfo Information about the descriptor set to allocate.
+   * @return The allocated descriptor set, nullptr if the pool has no room left for it.
+   */
+  virtual SPtr<IDescriptorSet>
+  tryAllocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) = 0;
+
+  /**
+   * @brief Return every descriptor set allocated from the pool to it at once.
+   * Sets allocated before the call become invalid, the GPU must be done with them.
+   */
+  virtual void
+  reset() = 0;
 };
 } // namespace chEngineSDK
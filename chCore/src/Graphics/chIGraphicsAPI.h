@@ -80,6 +80,19 @@ class CH_CORE_EXPORT IGraphicsAPI : public Module<IGraphicsAPI> {
   virtual void
   updateDescriptorSets(const Vector<WriteDescriptorSet>& writeDescriptorSets) = 0;
 
+  /**
+   * Submit the staging copies recorded by buffer and texture creation. Graphics queue
+   * submits do it on their own, call it to start uploads early or to block on them.
+   */
+  virtual void
+  flushUploads(bool waitForCompletion = false) = 0;
+
+  /**
+   * Persist compiled pipelines so the next run can skip compiling them again
+   */
+  virtual void
+  savePipelineCache() = 0;
+
   virtual void
   waitIdle() = 0;
 
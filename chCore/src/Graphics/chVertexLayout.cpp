@@ -40,6 +40,18 @@ VertexLayout::createPositionNormalTexCoordLayout() {
   return layout;
 }
 
+/*
+*/
+VertexLayout
+VertexLayout::createPositionNormalTexCoordInstancedLayout() {
+  VertexLayout layout = createPositionNormalTexCoordLayout();
+  for (uint32 column = 0; column < 4; ++column) {
+    layout.addCustomAttribute("MODEL", VertexFormat::Float4, UINT32_MAX, 1);
+  }
+  layout.setInputRate(1, VertexInputRate::Instance);
+  return layout;
+}
+
 /*
 */
 VertexLayout
@@ -101,6 +113,45 @@ VertexLayout::addCustomAttribute(const String& semanticName,
   updateSizes(binding, desc.offset, format);
 }
 
+/*
+*/
+void
+VertexLayout::setInputRate(uint32 binding, VertexInputRate inputRate) {
+  if (binding >= m_inputRates.size()) {
+    m_inputRates.resize(binding + 1, VertexInputRate::Vertex);
+  }
+  m_inputRates[binding] = inputRate;
+}
+
+/*
+*/
+bool
+VertexLayout::operator==(const VertexLayout& other) const {
+  if (m_strides != other.m_strides ||
+      m_attributes.size() != other.m_attributes.size() ||
+      getBindingCount() != other.getBindingCount()) {
+    return false;
+  }
+
+  for (uint32 binding = 0; binding < getBindingCount(); ++binding) {
+    if (getInputRate(binding) != other.getInputRate(binding)) {
+      return false;
+    }
+  }
+
+  for (SIZE_T i = 0; i < m_attributes.size(); ++i) {
+    const VertexAttributeDesc& a = m_attributes[i];
+    const VertexAttributeDesc& b = other.m_attributes[i];
+    if (a.type != b.type || a.format != b.format || a.offset != b.offset ||
+        a.binding != b.binding ||
+        std::strncmp(a.semanticName, b.semanticName, sizeof(a.semanticName)) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /*
 */
 void
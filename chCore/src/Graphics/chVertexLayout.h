@@ -59,6 +59,11 @@ enum class VertexFormat : uint32 {
   COUNT
 };
 
+enum class VertexInputRate : uint32 {
+  Vertex,
+  Instance // Advances once per instance, for per instance data like transforms
+};
+
 struct VertexAttributeDesc {
   VertexAttributeType type;      // 4 bytes
   VertexFormat format;           // 4 bytes
@@ -101,6 +106,20 @@ class CH_CORE_EXPORT VertexLayout {
     return static_cast<uint32>(m_strides.size());
   }
 
+  void
+  setInputRate(uint32 binding, VertexInputRate inputRate);
+
+  /**
+   * Same attributes, strides and input rates, the data of one can be read with the other
+   */
+  NODISCARD bool
+  operator==(const VertexLayout& other) const;
+
+  NODISCARD FORCEINLINE VertexInputRate
+  getInputRate(uint32 binding = 0) const {
+    return binding < m_inputRates.size() ? m_inputRates[binding] : VertexInputRate::Vertex;
+  }
+
  private:
 
   uint32
@@ -115,11 +134,18 @@ class CH_CORE_EXPORT VertexLayout {
  public:
   static VertexLayout createPostionColorLayout();
   static VertexLayout createPositionNormalTexCoordLayout();
+
+  /**
+   * Position, normal and texcoord in binding 0, a per instance model matrix in binding 1
+   * as four Float4 columns.
+   */
+  static VertexLayout createPositionNormalTexCoordInstancedLayout();
   static VertexLayout createGBufferLayout();
 
  private:
   Vector<VertexAttributeDesc> m_attributes;
   Vector<uint32> m_strides;   // Tamaño en bytes de cada binding
+  Vector<VertexInputRate> m_inputRates;
   uint32 m_vertexSize = 0;   // Tamaño total de un vértice en el binding 0
 };
 
@@ -16,6 +16,7 @@ namespace chEngineSDK {
 
 namespace chEnginePathsVars {
 static const Path ASSETS_PATH = Path("Assets");
+static const Path CACHE_PATH = Path("Cache");
 } // namespace chEnginePaths
 using namespace chEnginePathsVars;
 
@@ -94,4 +95,12 @@ EnginePaths::getEditorContentDirectory(){
   return editorContentDir;
 }
 
+/*
+*/
+Path
+EnginePaths::getEngineCacheDirectory() {
+  static Path cacheDir = FileSystem::absolutePath(CACHE_PATH);
+  return cacheDir;
+}
+
 } // namespace chEngineSDK
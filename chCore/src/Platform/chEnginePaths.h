@@ -61,6 +61,15 @@ class CH_CORE_EXPORT EnginePaths {
    */
   static Path
   getEditorContentDirectory();
+
+  /**
+   * Get the absolute path to the directory for data the engine regenerates when it is
+   * missing, like driver pipeline caches.
+   *
+   * @return Absolute path to the cache directory
+   */
+  static Path
+  getEngineCacheDirectory();
 };
 
 } // namespace chEngineSDK
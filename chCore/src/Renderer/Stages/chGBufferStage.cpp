@@ -15,12 +15,9 @@
 // Graphics includes
 #include "chIBuffer.h"
 #include "chICommandBuffer.h"
-#include "chICommandPool.h"
-#include "chICommandQueue.h"
 #include "chIFrameBuffer.h"
 #include "chIPipeline.h"
 #include "chIRenderPass.h"
-#include "chISynchronization.h"
 #include "chITexture.h"
 
 namespace chEngineSDK {
@@ -33,6 +30,44 @@ namespace chEngineSDK {
 
 CH_LOG_DECLARE_STATIC(GBufferStageLog, CH_GBUFFER_STAGE_LOG_LEVEL);
 
+namespace GBufferStageHelpers {
+struct TargetDesc
+{
+  const char* name;
+  Format format;
+  const UUID& typeId;
+};
+
+/**
+ * Targets in attachment order of the render pass
+ */
+static const Array<TargetDesc, GBufferStage::TARGET_COUNT>&
+getTargets() {
+  static const Array<TargetDesc, GBufferStage::TARGET_COUNT> targets{{
+      // Albedo Target (RGBA8 - RGB: albedo, A: unused)
+      {"GBuffer Albedo", Format::R8G8B8A8_UNORM, TypeTraits<AlbedoData>::getTypeId()},
+      // Normal Target (RGBA16F - RGB: world normal, A: unused)
+      {"GBuffer Normal", Format::R16G16B16A16_SFLOAT, TypeTraits<NormalData>::getTypeId()},
+      // Metallic and roughness use RGBA8 for simplicity, could optimize to R8
+      {"GBuffer Metallic", Format::R8G8B8A8_UNORM, TypeTraits<MetallicData>::getTypeId()},
+      {"GBuffer Roughness", Format::R8G8B8A8_UNORM, TypeTraits<RoughnessData>::getTypeId()},
+      {"GBuffer Emissive",
+       Format::R16G16B16A16_SFLOAT,
+       TypeTraits<EmissiveData>::getTypeId()},
+      {"GBuffer Depth", Format::D32_SFLOAT, TypeTraits<DepthData>::getTypeId()},
+  }};
+  return targets;
+}
+
+template <typename T>
+static void
+setTextureOutput(RenderStageIO& outputs, const SPtr<ITextureView>& view) {
+  auto data = chMakeShared<T>();
+  data->texture = view;
+  outputs.setOutput(data);
+}
+} // namespace GBufferStageHelpers
+
 /*
  */
 GBufferStage::GBufferStage() {
@@ -69,35 +104,61 @@ GBufferStage::initialize(uint32 width, uint32 height) {
   m_width = width;
   m_height = height;
 
-  createGBufferTargets();
   createGBufferRenderPass();
   createGBufferPipeline();
-  createCommandResources();
 
   CH_LOG_INFO(GBufferStageLog, "GBufferStage initialized successfully");
 }
 
 /*
  */
-bool
-GBufferStage::execute(SPtr<ICommandBuffer> commandBuffer, const RenderStageIO& inputs, RenderStageIO&, float) {
-  if (!commandBuffer) {
-    return false;
+void
+GBufferStage::setupGraph(RenderGraph::PassBuilder& builder,
+                         Map<UUID, RenderGraphHandle>& outputResources) {
+  m_renderGraph = &builder.getGraph();
+
+  const auto& targets = GBufferStageHelpers::getTargets();
+  for (uint32 i = 0; i < TARGET_COUNT; ++i) {
+    const bool isDepth = isDepthFormat(targets[i].format);
+    m_targetHandles[i] = builder.createTexture(
+        targets[i].name, {.format = targets[i].format, .width = m_width, .height = m_height});
+    builder.write(m_targetHandles[i], isDepth ? RenderGraphUsage::DepthStencilAttachment
+                                              : RenderGraphUsage::ColorAttachment);
+    outputResources[targets[i].typeId] = m_targetHandles[i];
   }
+}
 
-  // Get material data from inputs
-  MaterialData materialData;
-  if (!AnyUtils::tryGetValue<MaterialData>(inputs, materialData)){
-    CH_LOG_WARNING(GBufferStageLog, "No material data provided to GBufferStage");
+/*
+ */
+bool
+GBufferStage::execute(SPtr<ICommandBuffer> commandBuffer, const RenderStageIO& inputs, RenderStageIO& outputs, float) {
+  if (!commandBuffer || !m_renderGraph || !m_renderPass) {
     return false;
   }
 
-  if (!materialData.isValid()) {
-    CH_LOG_WARNING(GBufferStageLog, "Invalid material data provided to GBufferStage");
-    return false;
+  Vector<SPtr<ITextureView>> attachments;
+  attachments.reserve(TARGET_COUNT);
+  for (const RenderGraphHandle handle : m_targetHandles) {
+    attachments.push_back(m_renderGraph->getTextureView(handle));
   }
+  // Begin render pass, the graph already moved the targets to attachment layouts
+  RenderPassBeginInfo renderPassInfo{
+    .renderPass = m_renderPass,
+    .framebuffer = updateFramebuffer(attachments),
+    .clearValues = m_clearColors,
+    .depthStencilClearValue = {{1.0f, 0}}
+  };
 
-  // Begin render pass...
+  commandBuffer->beginRenderPass(renderPassInfo);
+  commandBuffer->setViewport(0, 0, static_cast<float>(m_width), static_cast<float>(m_height));
+  commandBuffer->setScissor(0, 0, m_width, m_height);
+
+  // Get material data from inputs, without it the G-Buffer is only cleared
+  MaterialData materialData;
+  if (!AnyUtils::tryGetValue<MaterialData>(inputs, materialData) || !materialData.isValid()) {
+    CH_LOG_DEBUG(GBufferStageLog, "No valid material data provided to GBufferStage");
+    materialData.materials.clear();
+  }
 
   // Render each material group
   for (const auto& material : materialData.materials) {
@@ -105,7 +166,6 @@ GBufferStage::execute(SPtr<ICommandBuffer> commandBuffer, const RenderStageIO& i
       continue;
     }
 
-    // Get or create pipeline for this materiaI think we al
     auto pipeline = getPipelineForMaterial(material);
     if (!pipeline) {
       continue;
@@ -120,7 +180,15 @@ GBufferStage::execute(SPtr<ICommandBuffer> commandBuffer, const RenderStageIO& i
     //renderMeshesWithMaterial(commandBuffer, material, materialData);
   }
 
-  // End render pass and set outputs...
+  commandBuffer->endRenderPass();
+
+  using GBufferStageHelpers::setTextureOutput;
+  setTextureOutput<AlbedoData>(outputs, attachments[0]);
+  setTextureOutput<NormalData>(outputs, attachments[1]);
+  setTextureOutput<MetallicData>(outputs, attachments[2]);
+  setTextureOutput<RoughnessData>(outputs, attachments[3]);
+  setTextureOutput<EmissiveData>(outputs, attachments[4]);
+  setTextureOutput<DepthData>(outputs, attachments[5]);
   return true;
 }
 
@@ -130,22 +198,10 @@ void
 GBufferStage::resize(uint32 width, uint32 height) {
   CH_LOG_INFO(GBufferStageLog, "Resizing GBufferStage to {0}x{1}", width, height);
 
-  auto& graphicsAPI = IGraphicsAPI::instance();
-  graphicsAPI.waitIdle();
-
-  if (m_fence) {
-    m_fence->wait();
-  }
-
+  // The graph creates targets of the new size next frame, the framebuffer follows them
   m_width = width;
   m_height = height;
 
-  // Recreate targets and render pass with new dimensions
-  createGBufferTargets();
-  createGBufferRenderPass();
-
-  // Pipeline doesn't need recreation for resize
-
   CH_LOG_INFO(GBufferStageLog, "GBufferStage resized successfully");
 }
 
@@ -153,172 +209,13 @@ GBufferStage::resize(uint32 width, uint32 height) {
  */
 void
 GBufferStage::cleanup() {
-  if (IGraphicsAPI::instancePtr()) {
-    auto& graphicsAPI = IGraphicsAPI::instance();
-    graphicsAPI.waitIdle();
-
-    if (m_fence) {
-      m_fence->wait();
-    }
-  }
-
-  // Reset all resources
-  m_commandBuffer.reset();
-  m_commandPool.reset();
-  m_fence.reset();
-  //m_pipeline.reset();
-  m_framebuffer.reset();
+  // The renderer waits for the frames using these resources before cleaning its stages
+  m_framebuffers.clear();
   m_renderPass.reset();
+  m_materialPipelines.clear();
 
-  // Reset texture views
-  m_albedoView.reset();
-  m_normalView.reset();
-  m_metallicView.reset();
-  m_roughnessView.reset();
-  m_depthView.reset();
-
-  // Reset textures
-  m_albedoTarget.reset();
-  m_normalTarget.reset();
-  m_metallicTarget.reset();
-  m_roughnessTarget.reset();
-  m_depthTarget.reset();
-}
-
-/*
- */
-void
-GBufferStage::createGBufferTargets() {
-   if (m_width == 0 || m_height == 0) {
-    CH_LOG_ERROR(GBufferStageLog, "Invalid dimensions for G-Buffer targets");
-    return;
-  }
-
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
-  // Albedo Target (RGBA8 - RGB: albedo, A: unused)
-  TextureCreateInfo albedoInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::R8G8B8A8_UNORM,
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::ColorAttachment | TextureUsage::Sampled
-  };
-  m_albedoTarget = graphicsAPI.createTexture(albedoInfo);
-
-  TextureViewCreateInfo albedoViewInfo{
-    .format = Format::R8G8B8A8_UNORM,
-    .viewType = TextureViewType::View2D
-  };
-  m_albedoView = m_albedoTarget->createView(albedoViewInfo);
-
-  // Normal Target (RGBA16F - RGB: world normal, A: unused)
-  // Using 16F for better precision on normals
-  TextureCreateInfo normalInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::R16G16B16A16_SFLOAT,
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::ColorAttachment | TextureUsage::Sampled
-  };
-  m_normalTarget = graphicsAPI.createTexture(normalInfo);
-
-  TextureViewCreateInfo normalViewInfo{
-    .format = Format::R16G16B16A16_SFLOAT,
-    .viewType = TextureViewType::View2D
-  };
-  m_normalView = m_normalTarget->createView(normalViewInfo);
-
-  // Metallic Target (R8 - R: metallic, GBA: unused)
-  TextureCreateInfo metallicInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::R8G8B8A8_UNORM,  // Using RGBA8 for simplicity, could optimize to R8
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::ColorAttachment | TextureUsage::Sampled
-  };
-  m_metallicTarget = graphicsAPI.createTexture(metallicInfo);
-
-  TextureViewCreateInfo metallicViewInfo{
-    .format = Format::R8G8B8A8_UNORM,
-    .viewType = TextureViewType::View2D
-  };
-  m_metallicView = m_metallicTarget->createView(metallicViewInfo);
-
-  // Roughness Target (R8 - R: roughness, GBA: unused)
-  TextureCreateInfo roughnessInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::R8G8B8A8_UNORM,  // Using RGBA8 for simplicity, could optimize to R8
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::ColorAttachment | TextureUsage::Sampled
-  };
-  m_roughnessTarget = graphicsAPI.createTexture(roughnessInfo);
-
-  TextureViewCreateInfo roughnessViewInfo{
-    .format = Format::R8G8B8A8_UNORM,
-    .viewType = TextureViewType::View2D
-  };
-  m_roughnessView = m_roughnessTarget->createView(roughnessViewInfo);
-
-  // Motion Vector Target (RG16F - RG: motion vectors, BA: unused)
-  TextureCreateInfo motionInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::R16G16B16A16_SFLOAT,
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::ColorAttachment | TextureUsage::Sampled
-  };
-  m_emissiveTarget = graphicsAPI.createTexture(motionInfo);
-
-  TextureViewCreateInfo motionViewInfo{
-    .format = Format::R16G16B16A16_SFLOAT,
-    .viewType = TextureViewType::View2D
-  };
-  m_emissiveView = m_emissiveTarget->createView(motionViewInfo);
-
-  // Depth Target
-  TextureCreateInfo depthInfo{
-    .type = TextureType::Texture2D,
-    .format = Format::D32_SFLOAT,
-    .width = m_width,
-    .height = m_height,
-    .depth = 1,
-    .mipLevels = 1,
-    .arrayLayers = 1,
-    .samples = SampleCount::Count1,
-    .usage = TextureUsage::DepthStencil
-  };
-  m_depthTarget = graphicsAPI.createTexture(depthInfo);
-
-  TextureViewCreateInfo depthViewInfo{
-    .format = Format::D32_SFLOAT,
-    .viewType = TextureViewType::View2D,
-    .bIsDepthStencil = true
-  };
-  m_depthView = m_depthTarget->createView(depthViewInfo);
-
-  CH_LOG_INFO(GBufferStageLog, "G-Buffer targets created: {0}x{1}", m_width, m_height);
+  m_renderGraph = nullptr;
+  m_targetHandles.fill(RenderGraph::INVALID_HANDLE);
 }
 
 /*
@@ -327,59 +224,21 @@ void
 GBufferStage::createGBufferRenderPass() {
  auto& graphicsAPI = IGraphicsAPI::instance();
 
-  // Define attachments for G-Buffer (5 color + 1 depth)
-  Vector<AttachmentDescription> attachments{
-    // Attachment 0: Albedo
-    {
-      .format = Format::R8G8B8A8_UNORM,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::Store,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::ShaderReadOnly
-    },
-    // Attachment 1: Normal
-    {
-      .format = Format::R16G16B16A16_SFLOAT,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::Store,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::ShaderReadOnly
-    },
-    // Attachment 2: Metallic
-    {
-      .format = Format::R8G8B8A8_UNORM,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::Store,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::ShaderReadOnly
-    },
-    // Attachment 3: Roughness
-    {
-      .format = Format::R8G8B8A8_UNORM,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::Store,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::ShaderReadOnly
-    },
-    // Attachment 4: Motion Vectors
-    {
-      .format = Format::R16G16B16A16_SFLOAT,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::Store,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::ShaderReadOnly
-    },
-    // Attachment 5: Depth
-    {
-      .format = Format::D32_SFLOAT,
-      .loadOp = LoadOp::Clear,
-      .storeOp = StoreOp::DontCare,
-      .stencilLoadOp = LoadOp::DontCare,
-      .stencilStoreOp = StoreOp::DontCare,
-      .initialLayout = TextureLayout::Undefined,
-      .finalLayout = TextureLayout::DepthStencilAttachment
-    }
-  };
+  // Define attachments for G-Buffer (5 color + 1 depth), the render graph moves them in and
+  // out of the attachment layouts
+  Vector<AttachmentDescription> attachments;
+  for (const auto& target : GBufferStageHelpers::getTargets()) {
+    const TextureLayout layout = isDepthFormat(target.format)
+                                     ? TextureLayout::DepthStencilAttachment
+                                     : TextureLayout::ColorAttachment;
+    attachments.push_back({.format = target.format,
+                           .loadOp = LoadOp::Clear,
+                           .storeOp = StoreOp::Store,
+                           .stencilLoadOp = LoadOp::DontCare,
+                           .stencilStoreOp = StoreOp::DontCare,
+                           .initialLayout = layout,
+                           .finalLayout = layout});
+  }
 
   // Color attachment references (5 color targets)
   Vector<AttachmentReference> colorRefs{
@@ -422,20 +281,10 @@ GBufferStage::createGBufferRenderPass() {
 
   m_renderPass = graphicsAPI.createRenderPass(renderPassInfo);
 
-  // Create framebuffer
-  FrameBufferCreateInfo fbInfo{
-    .renderPass = m_renderPass,
-    .attachments = {
-      m_albedoView, m_normalView, m_metallicView,
-      m_roughnessView, m_emissiveView, m_depthView
-    },
-    .width = m_width,
-    .height = m_height,
-    .layers = 1
-  };
-  m_framebuffer = graphicsAPI.createFrameBuffer(fbInfo);
+  // Framebuffers are created with the first targets handed out by each graph
+  m_framebuffers.clear();
 
-  CH_LOG_INFO(GBufferStageLog, "G-Buffer render pass and framebuffer created");
+  CH_LOG_INFO(GBufferStageLog, "G-Buffer render pass created");
 }
 
 /*
@@ -458,99 +307,25 @@ GBufferStage::createGBufferPipeline() {
 
 /*
  */
-void
-GBufferStage::createCommandResources() {
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
-  // Create command pool for graphics operations
-  m_commandPool = graphicsAPI.createCommandPool(QueueType::Graphics);
-  if (!m_commandPool) {
-    CH_LOG_ERROR(GBufferStageLog, "Failed to create command pool");
-    return;
-  }
-
-  // Allocate command buffer
-  m_commandBuffer = m_commandPool->allocateCommandBuffer();
-  if (!m_commandBuffer) {
-    CH_LOG_ERROR(GBufferStageLog, "Failed to allocate command buffer");
-    return;
+const SPtr<IFrameBuffer>&
+GBufferStage::updateFramebuffer(const Vector<SPtr<ITextureView>>& attachments) {
+  GraphFramebuffer& entry = m_framebuffers[m_renderGraph];
+  if (entry.framebuffer && attachments == entry.views) {
+    return entry.framebuffer;
   }
 
-  // Create fence for synchronization
-  m_fence = graphicsAPI.createFence(true); // Start signaled
-  if (!m_fence) {
-    CH_LOG_ERROR(GBufferStageLog, "Failed to create fence");
-    return;
-  }
-
-  CH_LOG_INFO(GBufferStageLog, "Command resources created successfully");
-}
-
-/*
- */
-bool
-GBufferStage::renderGeometry(SPtr<Camera> camera, SPtr<Model> model, float ) {
-  if (!camera) {
-    CH_LOG_ERROR(GBufferStageLog, "Invalid camera for rendering");
-    return false;
-  }
-
-  if (!m_commandBuffer || !m_renderPass || !m_framebuffer) {
-    CH_LOG_ERROR(GBufferStageLog, "Render resources not initialized");
-    return false;
-  }
-
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
-  // Wait for previous frame
-  if (!m_fence->wait(1000000000)) { // 1 second timeout
-    CH_LOG_WARNING(GBufferStageLog, "Fence timeout");
-    return false;
-  }
-  m_fence->reset();
-
-  // Begin command buffer recording
-  m_commandBuffer->begin();
-
-  // Begin render pass
-  RenderPassBeginInfo renderPassInfo{
+  FrameBufferCreateInfo fbInfo{
     .renderPass = m_renderPass,
-    .framebuffer = m_framebuffer,
-    .clearValues = m_clearColors,
-    .depthStencilClearValue = {{1.0f, 0}}
-  };
-
-  m_commandBuffer->beginRenderPass(renderPassInfo);
-  m_commandBuffer->setViewport(0, 0, static_cast<float>(m_width), static_cast<float>(m_height));
-  m_commandBuffer->setScissor(0, 0, m_width, m_height);
-
-  // If we have a model, render it. Otherwise just clear the G-Buffer
-  if (model) {
-    // TODO: Bind G-Buffer pipeline and render model
-    // For now, we'll just clear the render targets (same as before)
-    CH_LOG_DEBUG(GBufferStageLog, "Rendering model to G-Buffer");
-
-    // if (m_pipeline) {
-    //   m_commandBuffer->bindPipeline(m_pipeline);
-    //   // Render model here
-    // }
-  }
-  else {
-  }
-
-  m_commandBuffer->endRenderPass();
-  m_commandBuffer->end();
-
-  // Submit command buffer
-  SubmitInfo submitInfo{
-    .commandBuffers = {m_commandBuffer},
-    .waitSemaphores = {},
-    .waitStages = {},
-    .signalSemaphores = {}
+    .attachments = attachments,
+    .width = m_width,
+    .height = m_height,
+    .layers = 1
   };
+  entry.framebuffer = IGraphicsAPI::instance().createFrameBuffer(fbInfo);
+  entry.views = attachments;
 
-  graphicsAPI.getQueue(QueueType::Graphics)->submit(submitInfo, m_fence);
-  return true;
+  CH_LOG_DEBUG(GBufferStageLog, "G-Buffer framebuffer created: {0}x{1}", m_width, m_height);
+  return entry.framebuffer;
 }
 
 } // namespace chEngineSDK
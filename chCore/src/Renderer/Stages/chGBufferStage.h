@@ -34,10 +34,14 @@ enum class GBufferDisplayMode {
 /**
  * @brief G-Buffer generation stage
  * Takes camera and model data, outputs G-Buffer textures
+ * @note The targets are transient textures of the render graph, reused by later stages
+ *       once nothing reads them anymore
  */
 class CH_CORE_EXPORT GBufferStage : public IRenderStage
 {
  public:
+  static constexpr uint32 TARGET_COUNT = 6; // 5 color + depth, in attachment order
+
   GBufferStage();
   ~GBufferStage() override;
 
@@ -83,6 +87,10 @@ class CH_CORE_EXPORT GBufferStage : public IRenderStage
   void
   initialize(uint32 width, uint32 height) override;
 
+  void
+  setupGraph(RenderGraph::PassBuilder& builder,
+             Map<UUID, RenderGraphHandle>& outputResources) override;
+
   bool
   execute(SPtr<ICommandBuffer> commandBuffer, const RenderStageIO& inputs, RenderStageIO& outputs, float deltaTime) override;
 
@@ -122,50 +130,43 @@ class CH_CORE_EXPORT GBufferStage : public IRenderStage
 #endif
 
  private:
-  void
-  createGBufferTargets();
   void
   createGBufferRenderPass();
   void
   createGBufferPipeline();
-  void
-  createCommandResources();
+
+  /**
+   * @brief Get the framebuffer of the current graph, recreated when the graph handed out
+   *        other textures
+   * @param attachments Views of the targets this frame
+   * @return Framebuffer with the attachments
+   */
+  const SPtr<IFrameBuffer>&
+  updateFramebuffer(const Vector<SPtr<ITextureView>>& attachments);
 
   SPtr<IPipeline>
   getPipelineForMaterial(const SPtr<IMaterial>& material) { return m_materialPipelines[material->getMaterialId()]; }
 
-  bool
-  renderGeometry(SPtr<Camera> camera, SPtr<Model> model, float deltaTime);
-
   SPtr<IPipeline>
   createPipelineForMaterial(const SPtr<IMaterial>& material);
 
-  // G-Buffer render targets (6 targets)
-  SPtr<ITexture> m_albedoTarget;
-  SPtr<ITexture> m_normalTarget;
-  SPtr<ITexture> m_metallicTarget;
-  SPtr<ITexture> m_roughnessTarget;
-  SPtr<ITexture> m_depthTarget;
-  SPtr<ITexture> m_emissiveTarget;
-  //SPtr<ITexture> m_motionTarget;
-
-  // Texture views
-  SPtr<ITextureView> m_albedoView;
-  SPtr<ITextureView> m_normalView;
-  SPtr<ITextureView> m_metallicView;
-  SPtr<ITextureView> m_roughnessView;
-  SPtr<ITextureView> m_depthView;
-  SPtr<ITextureView> m_emissiveView;
-  //SPtr<ITextureView> m_motionView;
+  // G-Buffer render targets (6 targets), declared in the render graph every frame
+  RenderGraph* m_renderGraph = nullptr;
+  Array<RenderGraphHandle, TARGET_COUNT> m_targetHandles{};
 
   Map<UUID, SPtr<IPipeline>> m_materialPipelines;
 
   // Render resources
   SPtr<IRenderPass> m_renderPass;
-  SPtr<IFrameBuffer> m_framebuffer;
-  SPtr<ICommandPool> m_commandPool;
-  SPtr<ICommandBuffer> m_commandBuffer;
-  SPtr<IFence> m_fence;
+
+  // One framebuffer per render graph. A graph is only built again once its last frame
+  // finished, so replacing its framebuffer never touches one in flight
+  struct GraphFramebuffer
+  {
+    Vector<SPtr<ITextureView>> views;
+    SPtr<IFrameBuffer> framebuffer;
+  };
+  Map<const RenderGraph*, GraphFramebuffer> m_framebuffers;
 
 #if USING(CH_EDITOR)
   // Debug display mode
@@ -0,0 +1,99 @@
+/************************************************************************/
+/**
+ * @file chDescriptorAllocator.cpp
+ * @author AccelMR
+ * @date 2025/08/08
+ * @brief
+ *  Descriptor set allocator that grows a list of pools on demand.
+ */
+/************************************************************************/
+
+#include "chDescriptorAllocator.h"
+
+#include "chIDescriptorPool.h"
+#include "chIGraphicsAPI.h"
+
+namespace chEngineSDK {
+/*
+*/
+DescriptorAllocator::DescriptorAllocator(const PoolSizeRatios& ratios,
+                                         uint32 setsPerPool,
+                                         uint32 maxSetsPerPool)
+  : m_ratios(ratios),
+    m_setsPerPool(Math::max(setsPerPool, 1u)),
+    m_initialSetsPerPool(m_setsPerPool),
+    m_maxSetsPerPool(Math::max(maxSetsPerPool, m_setsPerPool)) {
+  CH_ASSERT(!ratios.empty());
+}
+
+/*
+*/
+SPtr<IDescriptorSet>
+DescriptorAllocator::allocate(const SPtr<IDescriptorSetLayout>& layout) {
+  CH_ASSERT(layout != nullptr);
+
+  DescriptorSetAllocateInfo allocInfo{.pool = getReadyPool(), .layout = layout};
+  SPtr<IDescriptorSet> descriptorSet = allocInfo.pool->tryAllocateDescriptorSet(allocInfo);
+  if (!descriptorSet) {
+    // Out of sets or of one descriptor type, the rest of the pool is still reused on reset
+    m_fullPools.push_back(allocInfo.pool);
+    m_readyPools.pop_back();
+
+    allocInfo.pool = getReadyPool();
+    descriptorSet = allocInfo.pool->tryAllocateDescriptorSet(allocInfo);
+    if (!descriptorSet) {
+      CH_EXCEPT(InternalErrorException,
+                "Descriptor set layout doesn't fit in an empty pool, check the pool ratios.");
+    }
+  }
+
+  ++m_allocatedSets;
+  return descriptorSet;
+}
+
+/*
+*/
+void
+DescriptorAllocator::reset() {
+  for (const auto& pool : m_readyPools) {
+    pool->reset();
+  }
+  for (auto& pool : m_fullPools) {
+    pool->reset();
+    m_readyPools.push_back(std::move(pool));
+  }
+  m_fullPools.clear();
+  m_allocatedSets = 0;
+}
+
+/*
+*/
+void
+DescriptorAllocator::clear() {
+  m_readyPools.clear();
+  m_fullPools.clear();
+  m_setsPerPool = m_initialSetsPerPool;
+  m_allocatedSets = 0;
+}
+
+/*
+*/
+const SPtr<IDescriptorPool>&
+DescriptorAllocator::getReadyPool() {
+  if (!m_readyPools.empty()) {
+    return m_readyPools.back();
+  }
+
+  DescriptorPoolCreateInfo createInfo{
+      .maxSets = m_setsPerPool, .poolSizes = {}, .freeDescriptorSets = false};
+  createInfo.poolSizes.reserve(m_ratios.size());
+  for (const auto& [type, ratio] : m_ratios) {
+    const float count = Math::max(ratio * static_cast<float>(m_setsPerPool), 1.0f);
+    createInfo.poolSizes.emplace_back(type, static_cast<uint32>(count));
+  }
+
+  m_readyPools.push_back(IGraphicsAPI::instance().createDescriptorPool(createInfo));
+  m_setsPerPool = Math::min(m_setsPerPool + m_setsPerPool / 2, m_maxSetsPerPool);
+  return m_readyPools.back();
+}
+} // namespace chEngineSDK
@@ -0,0 +1,101 @@
+/************************************************************************/
+/**
+ * @file chDescriptorAllocator.h
+ * @author AccelMR
+ * @date 2025/08/08
+ * @brief
+ *  Descriptor set allocator that grows a list of pools on demand.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGraphicsTypes.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Allocates descriptor sets of any layout without knowing up front how many are
+ *     needed. Sets come from the current pool, when it runs out it is put aside as full
+ *     and the next one is used, creating it if needed. Every new pool holds more sets
+ *     than the previous one up to maxSetsPerPool, so a scene with thousands of sets ends
+ *     up in a handful of pools.
+ *
+ *     Pool sizes are given per set, a ratio of 2 for CombinedImageSampler reserves two
+ *     samplers for every set the pool can hold. Sets are never freed one by one, reset
+ *     returns all of them to their pools in a single call per pool. Used as a per frame
+ *     allocator, reset it after waiting for that frame's fence.
+ *
+ *     Not thread safe, like the pools it owns.
+ *
+ * Sample usage:
+ *  DescriptorAllocator allocator({{DescriptorType::UniformBuffer, 1.0f},
+ *                                 {DescriptorType::CombinedImageSampler, 2.0f}});
+ *  SPtr<IDescriptorSet> set = allocator.allocate(materialLayout);
+ *  ...
+ *  allocator.reset();
+ */
+class CH_CORE_EXPORT DescriptorAllocator
+{
+ public:
+  using PoolSizeRatios = Vector<Pair<DescriptorType, float>>;
+
+  static constexpr uint32 DEFAULT_SETS_PER_POOL = 64;
+  static constexpr uint32 DEFAULT_MAX_SETS_PER_POOL = 4096;
+
+  /**
+   * @param ratios Descriptors of each type reserved per set
+   * @param setsPerPool Sets the first pool can hold
+   * @param maxSetsPerPool Limit for the growth of the following pools
+   */
+  explicit DescriptorAllocator(const PoolSizeRatios& ratios,
+                               uint32 setsPerPool = DEFAULT_SETS_PER_POOL,
+                               uint32 maxSetsPerPool = DEFAULT_MAX_SETS_PER_POOL);
+
+  /**
+   * Allocate a set from the current pool, moving to a new one when it is full
+   * Throws InternalErrorException if the layout doesn't fit even in an empty pool.
+   */
+  NODISCARD SPtr<IDescriptorSet>
+  allocate(const SPtr<IDescriptorSetLayout>& layout);
+
+  /**
+   * Release every set allocated so far, pools are kept for the next allocations
+   */
+  void
+  reset();
+
+  /**
+   * Destroy every pool, sets allocated so far become invalid
+   */
+  void
+  clear();
+
+  NODISCARD FORCEINLINE uint32
+  getPoolCount() const {
+    return static_cast<uint32>(m_readyPools.size() + m_fullPools.size());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getAllocatedSetCount() const {
+    return m_allocatedSets;
+  }
+
+ private:
+  /**
+   * Current pool to allocate from, created when there is none left
+   */
+  NODISCARD const SPtr<IDescriptorPool>&
+  getReadyPool();
+
+  PoolSizeRatios m_ratios;
+  uint32 m_setsPerPool = 0;
+  uint32 m_initialSetsPerPool = 0;
+  uint32 m_maxSetsPerPool = 0;
+  uint32 m_allocatedSets = 0;
+
+  Vector<SPtr<IDescriptorPool>> m_readyPools;
+  Vector<SPtr<IDescriptorPool>> m_fullPools;
+};
+} // namespace chEngineSDK
@@ -0,0 +1,103 @@
+/************************************************************************/
+/**
+ * @file chDescriptorSetCache.cpp
+ * @author AccelMR
+ * @date 2025/08/08
+ * @brief
+ *  Reuses descriptor sets with the same layout and bindings.
+ */
+/************************************************************************/
+
+#include "chDescriptorSetCache.h"
+
+#include "chIGraphicsAPI.h"
+
+namespace chEngineSDK {
+namespace DescriptorSetCacheHelpers {
+NODISCARD static FORCEINLINE uint64
+toWord(const void* pointer) {
+  return static_cast<uint64>(reinterpret_cast<uintptr_t>(pointer));
+}
+} // namespace DescriptorSetCacheHelpers
+
+/*
+*/
+DescriptorSetCache::DescriptorSetCache(const DescriptorAllocator::PoolSizeRatios& ratios,
+                                       uint32 setsPerPool)
+  : m_allocator(ratios, setsPerPool) {}
+
+/*
+*/
+const SPtr<IDescriptorSet>&
+DescriptorSetCache::getOrCreate(const SPtr<IDescriptorSetLayout>& layout,
+                                const Vector<WriteDescriptorSet>& writes) {
+  Key key = makeKey(layout, writes);
+  auto it = m_entries.find(key);
+  if (it != m_entries.end()) {
+    ++m_hitCount;
+    return it->second.descriptorSet;
+  }
+
+  ++m_missCount;
+  Entry entry{
+      .descriptorSet = m_allocator.allocate(layout), .layout = layout, .writes = writes};
+  for (auto& write : entry.writes) {
+    write.dstSet = entry.descriptorSet;
+  }
+  IGraphicsAPI::instance().updateDescriptorSets(entry.writes);
+
+  return m_entries.emplace(std::move(key), std::move(entry)).first->second.descriptorSet;
+}
+
+/*
+*/
+void
+DescriptorSetCache::clear() {
+  m_entries.clear();
+  m_allocator.reset();
+}
+
+/*
+*/
+SIZE_T
+DescriptorSetCache::KeyHash::operator()(const Key& key) const {
+  // FNV-1a over the words
+  uint64 hash = 14695981039346656037ull;
+  for (const uint64 word : key.words) {
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+  return static_cast<SIZE_T>(hash);
+}
+
+/*
+*/
+DescriptorSetCache::Key
+DescriptorSetCache::makeKey(const SPtr<IDescriptorSetLayout>& layout,
+                            const Vector<WriteDescriptorSet>& writes) {
+  using DescriptorSetCacheHelpers::toWord;
+
+  Key key;
+  key.words.reserve(1 + writes.size() * 8);
+  key.words.push_back(toWord(layout.get()));
+
+  for (const auto& write : writes) {
+    key.words.push_back(static_cast<uint64>(write.dstBinding) << 32 | write.dstArrayElement);
+    key.words.push_back(static_cast<uint64>(write.descriptorType));
+    key.words.push_back(static_cast<uint64>(write.bufferInfos.size()) << 32 |
+                        write.imageInfos.size());
+
+    for (const auto& bufferInfo : write.bufferInfos) {
+      key.words.push_back(toWord(bufferInfo.buffer.get()));
+      key.words.push_back(static_cast<uint64>(bufferInfo.offset) << 32 | bufferInfo.range);
+    }
+
+    for (const auto& imageInfo : write.imageInfos) {
+      key.words.push_back(toWord(imageInfo.sampler.get()));
+      key.words.push_back(toWord(imageInfo.imageView.get()));
+      key.words.push_back(static_cast<uint64>(imageInfo.imageLayout));
+    }
+  }
+
+  return key;
+}
+} // namespace chEngineSDK
@@ -0,0 +1,113 @@
+/************************************************************************/
+/**
+ * @file chDescriptorSetCache.h
+ * @author AccelMR
+ * @date 2025/08/08
+ * @brief
+ *  Reuses descriptor sets with the same layout and bindings.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chDescriptorAllocator.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Descriptor sets are looked up by their layout plus a hash of what they bind, every
+ *     buffer, range, texture view, sampler and layout of the writes. The first request
+ *     allocates the set from a DescriptorAllocator and writes it, every request with the
+ *     same bindings after that returns the same set without touching the device.
+ *
+ *     An entry keeps the resources of its writes alive, so a destroyed resource can never
+ *     be confused with a new one created at the same address. Entries live until clear,
+ *     which also releases their sets at once; the GPU must be done with them first.
+ *
+ *     Not thread safe.
+ *
+ * Sample usage:
+ *  const SPtr<IDescriptorSet>& set = cache.getOrCreate(materialLayout,
+ *    {{.dstBinding = 0, .descriptorType = DescriptorType::CombinedImageSampler,
+ *      .imageInfos = {{sampler, albedoView}}}});
+ *  commandBuffer->bindDescriptorSets(PipelineBindPoint::Graphics, layout, 1, {set});
+ */
+class CH_CORE_EXPORT DescriptorSetCache
+{
+ public:
+  /**
+   * @param ratios Descriptors of each type reserved per set by the pools
+   * @param setsPerPool Sets the first pool can hold
+   */
+  explicit DescriptorSetCache(
+      const DescriptorAllocator::PoolSizeRatios& ratios,
+      uint32 setsPerPool = DescriptorAllocator::DEFAULT_SETS_PER_POOL);
+
+  /**
+   * Find the set with this layout and bindings, allocating and writing it the first time
+   *
+   * @param writes Bindings of the set, dstSet is ignored
+   */
+  NODISCARD const SPtr<IDescriptorSet>&
+  getOrCreate(const SPtr<IDescriptorSetLayout>& layout,
+              const Vector<WriteDescriptorSet>& writes);
+
+  /**
+   * Drop every entry and return their sets to the pools
+   */
+  void
+  clear();
+
+  NODISCARD FORCEINLINE uint32
+  getSize() const {
+    return static_cast<uint32>(m_entries.size());
+  }
+
+  NODISCARD FORCEINLINE uint64
+  getHitCount() const {
+    return m_hitCount;
+  }
+
+  NODISCARD FORCEINLINE uint64
+  getMissCount() const {
+    return m_missCount;
+  }
+
+ private:
+  /**
+   * Layout and bindings flattened to words, cheap to hash and to compare
+   */
+  struct Key
+  {
+    Vector<uint64> words;
+
+    bool
+    operator==(const Key& other) const {
+      return words == other.words;
+    }
+  };
+
+  struct KeyHash
+  {
+    SIZE_T
+    operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    SPtr<IDescriptorSet> descriptorSet;
+    SPtr<IDescriptorSetLayout> layout;
+    Vector<WriteDescriptorSet> writes;
+  };
+
+  NODISCARD static Key
+  makeKey(const SPtr<IDescriptorSetLayout>& layout,
+          const Vector<WriteDescriptorSet>& writes);
+
+  DescriptorAllocator m_allocator;
+  UnorderedMap<Key, Entry, KeyHash> m_entries;
+  uint64 m_hitCount = 0;
+  uint64 m_missCount = 0;
+};
+} // namespace chEngineSDK
@@ -0,0 +1,134 @@
+/************************************************************************/
+/**
+ * @file chFramePacer.cpp
+ * @author AccelMR
+ * @date 2025/08/10
+ * @brief
+ *  Per frame fences, command buffers and deletion queues for frames in flight.
+ */
+/************************************************************************/
+
+#include "chFramePacer.h"
+
+#include "chICommandBuffer.h"
+#include "chICommandPool.h"
+#include "chICommandQueue.h"
+#include "chIGraphicsAPI.h"
+#include "chISynchronization.h"
+#include "chLogger.h"
+
+namespace chEngineSDK {
+using namespace std::chrono;
+
+#if USING(CH_DEBUG_MODE)
+#define CH_FRAME_PACER_LOG_LEVEL All
+#else
+#define CH_FRAME_PACER_LOG_LEVEL Info
+#endif
+
+CH_LOG_DECLARE_STATIC(FramePacerLog, CH_FRAME_PACER_LOG_LEVEL);
+
+/*
+*/
+FramePacer::FramePacer(uint32 framesInFlight, QueueType queueType)
+  : m_queueType(queueType) {
+  CH_ASSERT(framesInFlight > 0);
+
+  auto& graphicsAPI = IGraphicsAPI::instance();
+  m_commandPool = graphicsAPI.createCommandPool(queueType);
+  m_frames.resize(Math::max(framesInFlight, 1u));
+  for (auto& frame : m_frames) {
+    frame.commandBuffer = m_commandPool->allocateCommandBuffer();
+    frame.fence = graphicsAPI.createFence(true); // Start signaled
+  }
+}
+
+/*
+*/
+FramePacer::~FramePacer() {
+  if (IGraphicsAPI::instancePtr()) {
+    waitAll();
+  }
+}
+
+/*
+*/
+bool
+FramePacer::beginFrame(uint64 timeout) {
+  const uint32 nextIndex =
+      m_hasBegun ? (m_frameIndex + 1) % static_cast<uint32>(m_frames.size()) : 0;
+  Frame& frame = m_frames[nextIndex];
+
+  // The last submitted frame already finished, the GPU idled until this one
+  const Frame& lastFrame = m_frames[m_frameIndex];
+  const bool gpuStarved = m_hasBegun && lastFrame.submitted && lastFrame.fence->isSignaled();
+
+  const auto waitStart = steady_clock::now();
+  if (!frame.fence->wait(timeout)) {
+    CH_LOG_WARNING(FramePacerLog, "Fence of frame {0} timed out", nextIndex);
+    return false;
+  }
+  const auto now = steady_clock::now();
+
+  if (m_hasBegun) {
+    m_stats.cpuFrameMs += duration<double, std::milli>(now - m_lastBeginTime).count();
+    m_stats.cpuWaitMs += duration<double, std::milli>(now - waitStart).count();
+    m_stats.gpuStarvedFrames += gpuStarved ? 1 : 0;
+    ++m_stats.frameCount;
+
+    if (m_stats.frameCount % STATS_REPORT_FRAMES == 0) {
+      CH_LOG_INFO(FramePacerLog,
+                  "{0} frames, {1} ms average: CPU waited on GPU {2}% of the time, GPU "
+                  "waited on CPU in {3}% of the frames",
+                  m_stats.frameCount, m_stats.getAverageFrameMs(),
+                  m_stats.getCpuWaitRatio() * 100.0, m_stats.getGpuStarvedRatio() * 100.0);
+    }
+  }
+
+  m_lastBeginTime = now;
+  m_hasBegun = true;
+  m_frameIndex = nextIndex;
+
+  // Anything queued while this slot was recorded last is no longer used by the GPU
+  frame.releaseQueue.clear();
+  frame.submitted = false;
+  return true;
+}
+
+/*
+*/
+void
+FramePacer::submit(SubmitInfo submitInfo) {
+  Frame& frame = m_frames[m_frameIndex];
+  submitInfo.commandBuffers.push_back(frame.commandBuffer);
+
+  // Reset right before submitting, a frame that is skipped keeps its fence signaled
+  frame.fence->reset();
+  IGraphicsAPI::instance().getQueue(m_queueType)->submit(submitInfo, frame.fence);
+  frame.submitted = true;
+}
+
+/*
+*/
+void
+FramePacer::deferRelease(SPtr<void> resource) {
+  if (resource) {
+    m_frames[m_frameIndex].releaseQueue.push_back(std::move(resource));
+  }
+}
+
+/*
+*/
+void
+FramePacer::waitAll() {
+  for (auto& frame : m_frames) {
+    if (frame.submitted) {
+      frame.fence->wait();
+    }
+  }
+
+  for (auto& frame : m_frames) {
+    frame.releaseQueue.clear();
+  }
+}
+} // namespace chEngineSDK
@@ -0,0 +1,169 @@
+/************************************************************************/
+/**
+ * @file chFramePacer.h
+ * @author AccelMR
+ * @date 2025/08/10
+ * @brief
+ *  Per frame fences, command buffers and deletion queues for frames in flight.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGraphicsTypes.h"
+
+namespace chEngineSDK {
+/**
+ * How much of the frames the CPU and the GPU spent waiting on each other. The GPU side
+ * comes from the fences: when a frame begins with the last submitted one already done,
+ * the GPU ran out of work before the CPU submitted more.
+ */
+struct FramePacingStats
+{
+  uint64 frameCount = 0;
+  uint64 gpuStarvedFrames = 0; ///< Frames begun with the GPU already idle
+  double cpuFrameMs = 0.0;     ///< Sum of the time between beginFrame calls
+  double cpuWaitMs = 0.0;      ///< Sum of the time beginFrame blocked on fences
+
+  NODISCARD FORCEINLINE double
+  getAverageFrameMs() const {
+    return frameCount > 0 ? cpuFrameMs / static_cast<double>(frameCount) : 0.0;
+  }
+
+  /**
+   * Part of the CPU frame time blocked on the GPU
+   */
+  NODISCARD FORCEINLINE double
+  getCpuWaitRatio() const {
+    return cpuFrameMs > 0.0 ? cpuWaitMs / cpuFrameMs : 0.0;
+  }
+
+  /**
+   * Part of the frames where the GPU waited on the CPU
+   */
+  NODISCARD FORCEINLINE double
+  getGpuStarvedRatio() const {
+    return frameCount > 0
+               ? static_cast<double>(gpuStarvedFrames) / static_cast<double>(frameCount)
+               : 0.0;
+  }
+};
+
+/*
+ * Description:
+ *     Keeps up to framesInFlight frames on the GPU. Every frame slot owns a fence, a
+ *     primary command buffer and a deletion queue:
+ *
+ *     - beginFrame moves to the next slot and waits for the fence of the frame that used
+ *       it last, then releases what was queued for deletion during that frame.
+ *     - submit sends the command buffer of the slot signaling its fence.
+ *     - deferRelease keeps a resource alive until the frames that may still read it are
+ *       done, instead of waiting for the device before destroying it.
+ *
+ *     A slot skipped without submit keeps its fence signaled, beginFrame never blocks on
+ *     a frame that was not sent. The waits are timed into FramePacingStats and reported
+ *     in the log every STATS_REPORT_FRAMES frames.
+ *
+ *     Not thread safe.
+ *
+ * Sample usage:
+ *  if (!pacer.beginFrame()) {
+ *    return;
+ *  }
+ *  uniformRing.beginFrame(pacer.getFrameIndex());
+ *  const SPtr<ICommandBuffer>& commandBuffer = pacer.getCommandBuffer();
+ *  commandBuffer->begin();
+ *  ...
+ *  commandBuffer->end();
+ *  pacer.submit();
+ */
+class CH_CORE_EXPORT FramePacer
+{
+ public:
+  static constexpr uint64 STATS_REPORT_FRAMES = 1000;
+
+  /**
+   * @param framesInFlight Frames the CPU may record ahead of the GPU
+   * @param queueType Queue the command buffers are submitted to
+   */
+  explicit FramePacer(uint32 framesInFlight, QueueType queueType = QueueType::Graphics);
+
+  /**
+   * Waits for every frame in flight before the fences and queued resources go away
+   */
+  ~FramePacer();
+
+  /**
+   * Move to the next frame slot once the GPU is done with it
+   *
+   * @param timeout Nanoseconds to wait for the fence of the slot
+   * @return False if the fence timed out, the frame must be skipped
+   */
+  NODISCARD bool
+  beginFrame(uint64 timeout = UINT64_MAX);
+
+  /**
+   * Submit the command buffer of the current frame, it signals the frame fence
+   *
+   * @param submitInfo Semaphores to wait on or signal, its command buffers are sent first
+   */
+  void
+  submit(SubmitInfo submitInfo = {});
+
+  /**
+   * Release a resource once the frames that could be using it finished
+   */
+  void
+  deferRelease(SPtr<void> resource);
+
+  /**
+   * Wait for every submitted frame and release all the queued resources
+   */
+  void
+  waitAll();
+
+  NODISCARD FORCEINLINE uint32
+  getFrameIndex() const {
+    return m_frameIndex;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getFramesInFlight() const {
+    return static_cast<uint32>(m_frames.size());
+  }
+
+  NODISCARD FORCEINLINE const SPtr<ICommandBuffer>&
+  getCommandBuffer() const {
+    return m_frames[m_frameIndex].commandBuffer;
+  }
+
+  NODISCARD FORCEINLINE const FramePacingStats&
+  getStats() const {
+    return m_stats;
+  }
+
+  FORCEINLINE void
+  resetStats() {
+    m_stats = {};
+  }
+
+ private:
+  struct Frame
+  {
+    SPtr<ICommandBuffer> commandBuffer;
+    SPtr<IFence> fence;
+    Vector<SPtr<void>> releaseQueue;
+    bool submitted = false; ///< The fence signals the end of a submitted frame
+  };
+
+  QueueType m_queueType;
+  SPtr<ICommandPool> m_commandPool;
+  Vector<Frame> m_frames;
+  uint32 m_frameIndex = 0;
+
+  FramePacingStats m_stats;
+  std::chrono::steady_clock::time_point m_lastBeginTime;
+  bool m_hasBegun = false;
+};
+} // namespace chEngineSDK
@@ -0,0 +1,60 @@
+/************************************************************************/
+/**
+ * @file chFrameUniformRing.cpp
+ * @author AccelMR
+ * @date 2025/08/04
+ * @brief
+ *  Persistently mapped uniform buffer split in one linear region per frame in flight.
+ */
+/************************************************************************/
+
+#include "chFrameUniformRing.h"
+
+#include "chIBuffer.h"
+#include "chIGraphicsAPI.h"
+#include "chStringUtils.h"
+
+namespace chEngineSDK {
+/*
+*/
+FrameUniformRing::FrameUniformRing(uint32 frameCount, uint32 frameSize)
+  : m_frameRange(getSlotSize(frameSize)),
+    m_frameCount(frameCount),
+    m_frameSize(getSlotSize(frameSize)) {
+  CH_ASSERT(frameCount > 0);
+  CH_ASSERT(frameSize > 0);
+
+  // CpuToGpu memory stays mapped for the whole life of the buffer, update only copies
+  BufferCreateInfo createInfo{.size = m_frameSize * m_frameCount,
+                              .usage = BufferUsage::UniformBuffer,
+                              .memoryUsage = MemoryUsage::CpuToGpu};
+  m_buffer = IGraphicsAPI::instance().createBuffer(createInfo);
+}
+
+/*
+*/
+void
+FrameUniformRing::beginFrame(uint32 frameIndex) {
+  CH_ASSERT(frameIndex < m_frameCount);
+  m_frameIndex = frameIndex;
+  m_frameRange.reset();
+}
+
+/*
+*/
+uint32
+FrameUniformRing::push(const void* data, uint32 size) {
+  CH_ASSERT(data != nullptr);
+
+  const uint64 localOffset = m_frameRange.allocate(size, OFFSET_ALIGNMENT);
+  if (localOffset == RangeAllocator::INVALID_OFFSET) {
+    CH_EXCEPT(InternalErrorException,
+              chString::format("Frame uniform ring out of space: {0} of {1} bytes used.",
+                               getUsedSize(), m_frameSize));
+  }
+
+  const uint32 offset = m_frameIndex * m_frameSize + static_cast<uint32>(localOffset);
+  m_buffer->update(data, size, offset);
+  return offset;
+}
+} // namespace chEngineSDK
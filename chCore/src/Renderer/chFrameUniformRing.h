@@ -0,0 +1,111 @@
+/************************************************************************/
+/**
+ * @file chFrameUniformRing.h
+ * @author AccelMR
+ * @date 2025/08/04
+ * @brief
+ *  Persistently mapped uniform buffer split in one linear region per frame in flight.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chRangeAllocator.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Transient per draw constants. The buffer holds frameCount regions, every frame bump
+ *     allocates from its own region, so data written for frame N never overwrites what an
+ *     in flight frame N - 1 is still reading. Draws bind one descriptor set with a dynamic
+ *     uniform buffer and pass the offset returned by push.
+ *
+ *     The region of a frame is only reused after beginFrame is called with its index
+ *     again, the caller has to wait for that frame's fence first.
+ *
+ * Sample usage:
+ *  ring.beginFrame(frameIndex);
+ *  for (const DrawItem& item : items) {
+ *    const uint32 offset = ring.push(item.constants);
+ *    commandBuffer->bindDescriptorSets(PipelineBindPoint::Graphics, layout, 0, {set},
+ *                                      {offset});
+ *    commandBuffer->drawIndexed(item.indexCount);
+ *  }
+ */
+class CH_CORE_EXPORT FrameUniformRing
+{
+ public:
+  /**
+   * Vulkan guarantees minUniformBufferOffsetAlignment is at most 256 bytes, so dynamic
+   * offsets aligned to it are valid on every device.
+   */
+  static constexpr uint32 OFFSET_ALIGNMENT = 256;
+
+  /**
+   * Bytes a push of size bytes takes from a frame region
+   */
+  NODISCARD static constexpr uint32
+  getSlotSize(uint32 size) {
+    return (size + OFFSET_ALIGNMENT - 1) & ~(OFFSET_ALIGNMENT - 1);
+  }
+
+  /**
+   * @param frameCount Frames that can be in flight at the same time
+   * @param frameSize Bytes available to a frame, rounded up to OFFSET_ALIGNMENT
+   */
+  FrameUniformRing(uint32 frameCount, uint32 frameSize);
+
+  /**
+   * Start writing the region of a frame, everything pushed the last time this frame
+   * index was used is discarded.
+   */
+  void
+  beginFrame(uint32 frameIndex);
+
+  /**
+   * Copy data into the current frame region
+   * Throws InternalErrorException when the region is full.
+   *
+   * @return Dynamic offset of the data inside getBuffer()
+   */
+  NODISCARD uint32
+  push(const void* data, uint32 size);
+
+  template<typename T>
+  NODISCARD uint32
+  push(const T& value) {
+    return push(&value, static_cast<uint32>(sizeof(T)));
+  }
+
+  NODISCARD FORCEINLINE const SPtr<IBuffer>&
+  getBuffer() const {
+    return m_buffer;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getFrameCount() const {
+    return m_frameCount;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getFrameSize() const {
+    return m_frameSize;
+  }
+
+  /**
+   * Bytes pushed to the current frame, alignment padding included
+   */
+  NODISCARD FORCEINLINE uint32
+  getUsedSize() const {
+    return static_cast<uint32>(m_frameRange.getUsedSize());
+  }
+
+ private:
+  SPtr<IBuffer> m_buffer;
+  LinearRangeAllocator m_frameRange;
+  uint32 m_frameCount = 0;
+  uint32 m_frameSize = 0;
+  uint32 m_frameIndex = 0;
+};
+} // namespace chEngineSDK
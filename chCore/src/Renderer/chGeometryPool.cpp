@@ -0,0 +1,226 @@
+/************************************************************************/
+/**
+ * @file chGeometryPool.cpp
+ * @author AccelMR
+ * @date 2025/08/07
+ * @brief
+ *  Shared vertex and index buffers for every mesh with the same vertex layout.
+ */
+/************************************************************************/
+
+#include "chGeometryPool.h"
+
+#include "chIBuffer.h"
+#include "chIGraphicsAPI.h"
+#include "chMesh.h"
+#include "chStringUtils.h"
+
+namespace chEngineSDK {
+namespace GeometryPoolHelpers {
+NODISCARD static SPtr<IBuffer>
+createBuffer(uint64 size, BufferUsage usage) {
+  if (size > UINT32_MAX) {
+    CH_EXCEPT(InternalErrorException,
+              chString::format("Geometry pool buffer of {0} bytes exceeds the 4 GiB limit.",
+                               size));
+  }
+
+  BufferCreateInfo createInfo{.size = Math::max(static_cast<uint32>(size), 1u),
+                              .usage = usage,
+                              .memoryUsage = MemoryUsage::GpuOnly};
+  return IGraphicsAPI::instance().createBuffer(createInfo);
+}
+} // namespace GeometryPoolHelpers
+
+/*
+*/
+GeometryPool::GeometryPool(const VertexLayout& layout,
+                           uint32 vertexCapacity,
+                           uint32 indexCapacity,
+                           BufferReleaseFunction releaseBuffer)
+  : m_layout(layout),
+    m_vertexStride(layout.getStride(0)),
+    m_releaseBuffer(std::move(releaseBuffer)) {
+  CH_ASSERT(m_vertexStride > 0);
+  reallocate(Math::max(vertexCapacity, 1u), Math::max(indexCapacity, 1u));
+}
+
+/*
+*/
+const GeometryRange&
+GeometryPool::add(const SPtr<Mesh>& mesh) {
+  CH_ASSERT(mesh != nullptr);
+
+  auto it = m_entries.find(mesh.get());
+  if (it != m_entries.end()) {
+    return it->second.range;
+  }
+
+  if (!(mesh->getVertexLayout() == m_layout)) {
+    CH_EXCEPT(InternalErrorException,
+              chString::format("Mesh with a vertex stride of {0} doesn't match the {1} "
+                               "bytes layout of the geometry pool.",
+                               mesh->getVertexLayout().getStride(0), m_vertexStride));
+  }
+
+  Entry entry{.mesh = mesh,
+              .range = {.indexCount = mesh->getIndexCount(),
+                        .vertexCount = mesh->getVertexCount()}};
+  if (!allocateRanges(entry)) {
+    const uint64 neededVertices = m_vertexRanges->getUsedSize() + entry.range.vertexCount;
+    const uint64 neededIndices = m_indexRanges->getUsedSize() + entry.range.indexCount;
+
+    // Holes alone may be enough, packing the meshes again keeps the buffers the same size
+    uint32 vertexCapacity = getVertexCapacity();
+    uint32 indexCapacity = getIndexCapacity();
+    if (neededVertices > vertexCapacity) {
+      const uint64 doubled = static_cast<uint64>(vertexCapacity) * 2;
+      vertexCapacity = static_cast<uint32>(
+          Math::min(Math::max(neededVertices, doubled), static_cast<uint64>(UINT32_MAX)));
+    }
+    if (neededIndices > indexCapacity) {
+      const uint64 doubled = static_cast<uint64>(indexCapacity) * 2;
+      indexCapacity = static_cast<uint32>(
+          Math::min(Math::max(neededIndices, doubled), static_cast<uint64>(UINT32_MAX)));
+    }
+
+    reallocate(vertexCapacity, indexCapacity);
+    if (!allocateRanges(entry)) {
+      CH_EXCEPT(InternalErrorException, "Geometry pool failed to fit a mesh after growing.");
+    }
+  }
+
+  upload(entry);
+  return m_entries.emplace(mesh.get(), std::move(entry)).first->second.range;
+}
+
+/*
+*/
+void
+GeometryPool::remove(const Mesh* mesh) {
+  auto it = m_entries.find(mesh);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  const GeometryRange& range = it->second.range;
+  if (range.vertexCount > 0) {
+    m_vertexRanges->free(static_cast<uint64>(range.vertexOffset));
+  }
+  if (range.indexCount > 0) {
+    m_indexRanges->free(range.firstIndex);
+  }
+  m_entries.erase(it);
+}
+
+/*
+*/
+void
+GeometryPool::compact() {
+  reallocate(getVertexCapacity(), getIndexCapacity());
+}
+
+/*
+*/
+const GeometryRange*
+GeometryPool::find(const Mesh* mesh) const {
+  auto it = m_entries.find(mesh);
+  return it != m_entries.end() ? &it->second.range : nullptr;
+}
+
+/*
+*/
+bool
+GeometryPool::allocateRanges(Entry& entry) {
+  GeometryRange& range = entry.range;
+
+  uint64 vertexOffset = 0;
+  if (range.vertexCount > 0) {
+    vertexOffset = m_vertexRanges->allocate(range.vertexCount);
+    if (vertexOffset == RangeAllocator::INVALID_OFFSET) {
+      return false;
+    }
+  }
+
+  uint64 firstIndex = 0;
+  if (range.indexCount > 0) {
+    firstIndex = m_indexRanges->allocate(range.indexCount);
+    if (firstIndex == RangeAllocator::INVALID_OFFSET) {
+      if (range.vertexCount > 0) {
+        m_vertexRanges->free(vertexOffset);
+      }
+      return false;
+    }
+  }
+
+  range.vertexOffset = static_cast<int32>(vertexOffset);
+  range.firstIndex = static_cast<uint32>(firstIndex);
+  return true;
+}
+
+/*
+*/
+void
+GeometryPool::upload(const Entry& entry) {
+  const Mesh& mesh = *entry.mesh;
+  const GeometryRange& range = entry.range;
+
+  // Ranges live inside buffers created with less than 4 GiB, their byte offsets fit
+  if (range.vertexCount > 0) {
+    const uint64 vertexOffset = static_cast<uint64>(range.vertexOffset) * m_vertexStride;
+    m_vertexBuffer->update(mesh.getVertexData().data(),
+                           static_cast<SIZE_T>(range.vertexCount) * m_vertexStride,
+                           static_cast<uint32>(vertexOffset));
+  }
+
+  if (range.indexCount == 0) {
+    return;
+  }
+
+  const uint32 indexOffset =
+      static_cast<uint32>(static_cast<uint64>(range.firstIndex) * sizeof(uint32));
+  const SIZE_T indexBytes = static_cast<SIZE_T>(range.indexCount) * sizeof(uint32);
+  if (mesh.getIndexType() == IndexType::UInt32) {
+    m_indexBuffer->update(mesh.getIndexData().data(), indexBytes, indexOffset);
+    return;
+  }
+
+  const Vector<uint16> shortIndices = mesh.getIndicesAsUInt16();
+  const Vector<uint32> indices(shortIndices.begin(), shortIndices.end());
+  m_indexBuffer->update(indices.data(), indexBytes, indexOffset);
+}
+
+/*
+*/
+void
+GeometryPool::reallocate(uint32 vertexCapacity, uint32 indexCapacity) {
+  SPtr<IBuffer> vertexBuffer = GeometryPoolHelpers::createBuffer(
+      static_cast<uint64>(vertexCapacity) * m_vertexStride, BufferUsage::VertexBuffer);
+  SPtr<IBuffer> indexBuffer = GeometryPoolHelpers::createBuffer(
+      static_cast<uint64>(indexCapacity) * sizeof(uint32), BufferUsage::IndexBuffer);
+
+  // Frames in flight may still draw from the old buffers
+  if (m_releaseBuffer) {
+    if (m_vertexBuffer) {
+      m_releaseBuffer(std::move(m_vertexBuffer));
+    }
+    if (m_indexBuffer) {
+      m_releaseBuffer(std::move(m_indexBuffer));
+    }
+  }
+
+  m_vertexBuffer = std::move(vertexBuffer);
+  m_indexBuffer = std::move(indexBuffer);
+  m_vertexRanges = chMakeUnique<TLSFRangeAllocator>(vertexCapacity);
+  m_indexRanges = chMakeUnique<TLSFRangeAllocator>(indexCapacity);
+
+  // Every mesh went through add, so each one fits in capacities at least as big as the
+  // used ones and is packed right after the previous
+  for (auto& [mesh, entry] : m_entries) {
+    if (!allocateRanges(entry)) {
+      CH_EXCEPT(InternalErrorException, "Geometry pool failed to repack its meshes.");
+    }
+    upload(entry);
+  }
+}
+} // namespace chEngineSDK
@@ -0,0 +1,188 @@
+/************************************************************************/
+/**
+ * @file chGeometryPool.h
+ * @author AccelMR
+ * @date 2025/08/07
+ * @brief
+ *  Shared vertex and index buffers for every mesh with the same vertex layout.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGraphicsTypes.h"
+#include "chRangeAllocator.h"
+#include "chVertexLayout.h"
+
+namespace chEngineSDK {
+class Mesh;
+
+/**
+ * Where a mesh lives inside the buffers of a GeometryPool, in elements, ready to be used
+ * as the firstIndex and vertexOffset of an indexed draw.
+ */
+struct GeometryRange
+{
+  uint32 firstIndex = 0;
+  uint32 indexCount = 0;
+  int32 vertexOffset = 0;
+  uint32 vertexCount = 0;
+};
+
+/*
+ * Description:
+ *     Packs the vertices and indices of many meshes into one device local vertex buffer
+ *     and one index buffer, so drawing all of them needs a single bind and every draw only
+ *     differs in its firstIndex / vertexOffset. Indices are always stored as UInt32, 16
+ *     bit meshes are widened when they are added.
+ *
+ *     Ranges are handed out by a TLSF allocator in elements. When a mesh doesn't fit the
+ *     pool is compacted if the free space is enough, otherwise it grows. Both rebuild the
+ *     buffers and upload every mesh again from its CPU data, packed from the start, so the
+ *     ranges of the meshes already added change; look them up again after add or compact.
+ *     The replaced buffers are handed to the release function given at construction,
+ *     usually FramePacer::deferRelease, so frames in flight keep reading them until they
+ *     retire. Without one they are destroyed right away, which is only safe while no
+ *     frame in flight draws from the pool, like when it is filled at load time.
+ *
+ *     Removing a mesh releases its range right away, the caller has to make sure no frame
+ *     in flight still draws it.
+ *
+ * Sample usage:
+ *  GeometryPool pool(VertexNormalTexCoord::getLayout(),
+ *                    GeometryPool::DEFAULT_VERTEX_CAPACITY,
+ *                    GeometryPool::DEFAULT_INDEX_CAPACITY,
+ *                    [&pacer](SPtr<IBuffer> buffer) { pacer.deferRelease(buffer); });
+ *  pool.add(mesh);
+ *  ...
+ *  commandBuffer->bindVertexBuffer(pool.getVertexBuffer());
+ *  commandBuffer->bindIndexBuffer(pool.getIndexBuffer(), GeometryPool::INDEX_TYPE);
+ *  const GeometryRange* range = pool.find(mesh.get());
+ *  commandBuffer->drawIndexed(range->indexCount, 1, range->firstIndex, range->vertexOffset);
+ */
+class CH_CORE_EXPORT GeometryPool
+{
+ public:
+  static constexpr IndexType INDEX_TYPE = IndexType::UInt32;
+  static constexpr uint32 DEFAULT_VERTEX_CAPACITY = 64 * 1024;
+  static constexpr uint32 DEFAULT_INDEX_CAPACITY = 3 * DEFAULT_VERTEX_CAPACITY;
+
+  using BufferReleaseFunction = Function<void(SPtr<IBuffer>)>;
+
+  /**
+   * @param layout Vertex layout every mesh added has to use
+   * @param vertexCapacity Initial number of vertices
+   * @param indexCapacity Initial number of indices
+   * @param releaseBuffer Receives the buffers replaced when the pool grows or compacts
+   */
+  explicit GeometryPool(const VertexLayout& layout,
+                        uint32 vertexCapacity = DEFAULT_VERTEX_CAPACITY,
+                        uint32 indexCapacity = DEFAULT_INDEX_CAPACITY,
+                        BufferReleaseFunction releaseBuffer = nullptr);
+
+  /**
+   * Upload a mesh, does nothing if it was already added
+   * Throws InternalErrorException if the mesh uses another vertex layout.
+   *
+   * @return Range of the mesh
+   */
+  const GeometryRange&
+  add(const SPtr<Mesh>& mesh);
+
+  /**
+   * Release the ranges of a mesh, does nothing if it was not added
+   */
+  void
+  remove(const Mesh* mesh);
+
+  /**
+   * Repack every mesh at the start of the buffers, removing the holes left by remove
+   */
+  void
+  compact();
+
+  /**
+   * @return Range of the mesh, nullptr if it was not added
+   */
+  NODISCARD const GeometryRange*
+  find(const Mesh* mesh) const;
+
+  NODISCARD FORCEINLINE const VertexLayout&
+  getVertexLayout() const {
+    return m_layout;
+  }
+
+  NODISCARD FORCEINLINE const SPtr<IBuffer>&
+  getVertexBuffer() const {
+    return m_vertexBuffer;
+  }
+
+  NODISCARD FORCEINLINE const SPtr<IBuffer>&
+  getIndexBuffer() const {
+    return m_indexBuffer;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getMeshCount() const {
+    return static_cast<uint32>(m_entries.size());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getVertexCapacity() const {
+    return static_cast<uint32>(m_vertexRanges->getSize());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getIndexCapacity() const {
+    return static_cast<uint32>(m_indexRanges->getSize());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getUsedVertexCount() const {
+    return static_cast<uint32>(m_vertexRanges->getUsedSize());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getUsedIndexCount() const {
+    return static_cast<uint32>(m_indexRanges->getUsedSize());
+  }
+
+ private:
+  struct Entry
+  {
+    SPtr<Mesh> mesh;
+    GeometryRange range;
+  };
+
+  /**
+   * Allocate the ranges of an entry from the current allocators
+   *
+   * @return False if one of them doesn't fit, nothing stays allocated then
+   */
+  NODISCARD bool
+  allocateRanges(Entry& entry);
+
+  void
+  upload(const Entry& entry);
+
+  /**
+   * Replace the buffers with new ones of the given capacities and add every mesh again,
+   *   the old buffers go to m_releaseBuffer
+   */
+  void
+  reallocate(uint32 vertexCapacity, uint32 indexCapacity);
+
+  VertexLayout m_layout;
+  uint32 m_vertexStride = 0;
+
+  SPtr<IBuffer> m_vertexBuffer;
+  SPtr<IBuffer> m_indexBuffer;
+  UniquePtr<TLSFRangeAllocator> m_vertexRanges;
+  UniquePtr<TLSFRangeAllocator> m_indexRanges;
+
+  UnorderedMap<const Mesh*, Entry> m_entries;
+
+  BufferReleaseFunction m_releaseBuffer;
+};
+} // namespace chEngineSDK
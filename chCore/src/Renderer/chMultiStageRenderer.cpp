@@ -8,7 +8,12 @@
 /************************************************************************/
 
 #include "chMultiStageRenderer.h"
+
+#include "chFramePacer.h"
+#include "chICommandBuffer.h"
+#include "chIGraphicsAPI.h"
 #include "chLogger.h"
+#include "Data/chTextureData.h"
 
 namespace chEngineSDK {
 
@@ -42,6 +47,8 @@ MultiStageRenderer::initialize(uint32 width, uint32 height) {
   m_renderWidth = width;
   m_renderHeight = height;
 
+  createCommandResources();
+
   // Initialize all stages
   for (auto& stageInstance : m_stages) {
     if (stageInstance.stage) {
@@ -71,6 +78,8 @@ MultiStageRenderer::onRender(float deltaTime) {
  */
 void
 MultiStageRenderer::resize(uint32 width, uint32 height) {
+  waitForFrames();
+
   m_renderWidth = width;
   m_renderHeight = height;
 
@@ -86,6 +95,8 @@ MultiStageRenderer::resize(uint32 width, uint32 height) {
  */
 void
 MultiStageRenderer::cleanup() {
+  waitForFrames();
+
   // Cleanup all stages
   for (auto& stageInstance : m_stages) {
     if (stageInstance.stage) {
@@ -96,6 +107,12 @@ MultiStageRenderer::cleanup() {
   m_stages.clear();
   m_stageMap.clear();
   m_sceneData.clear();
+  m_frameData.clear();
+
+  for (auto& renderGraph : m_renderGraphs) {
+    renderGraph.clear();
+  }
+  m_framePacer.reset();
 }
 
 /*
@@ -162,6 +179,7 @@ MultiStageRenderer::removeStage(const UUID& instanceId) {
 
   // Cleanup stage
   if (m_stages[index].stage) {
+    waitForFrames();
     m_stages[index].stage->cleanup();
   }
 
@@ -233,12 +251,108 @@ MultiStageRenderer::getStageIds() const {
   return ids;
 }
 
+/*
+ */
+const RenderGraph&
+MultiStageRenderer::getRenderGraph() const {
+  const uint32 frameIndex = m_framePacer ? m_framePacer->getFrameIndex() : 0;
+  return m_renderGraphs[frameIndex];
+}
+
+/*
+ */
+const FramePacingStats&
+MultiStageRenderer::getFramePacingStats() const {
+  static const FramePacingStats emptyStats;
+  return m_framePacer ? m_framePacer->getStats() : emptyStats;
+}
+
+/*
+ */
+void
+MultiStageRenderer::createCommandResources() {
+  if (!IGraphicsAPI::instancePtr()) {
+    CH_LOG_ERROR(MultiStageRendererLog, "Graphics API not initialized");
+    return;
+  }
+
+  if (!m_framePacer) {
+    m_framePacer = chMakeShared<FramePacer>(FRAMES_IN_FLIGHT);
+  }
+}
+
+/*
+ */
+void
+MultiStageRenderer::waitForFrames() {
+  if (m_framePacer) {
+    m_framePacer->waitAll();
+  }
+}
+
 /*
  */
 void
 MultiStageRenderer::executeRenderPipeline(float deltaTime) {
-  RenderStageIO currentInputs = m_sceneData; // Start with scene data
-  RenderStageIO currentOutputs;
+  if (!m_framePacer) {
+    CH_LOG_ERROR(MultiStageRendererLog, "Command resources not initialized");
+    return;
+  }
+
+  // The graph of this frame hands out its textures again, the GPU must be done with them
+  if (!m_framePacer->beginFrame()) {
+    return;
+  }
+
+  RenderGraph& renderGraph = m_renderGraphs[m_framePacer->getFrameIndex()];
+  renderGraph.reset();
+  m_frameData = m_sceneData;
+
+  Vector<UUID> outputTypes = buildRenderGraph(renderGraph, deltaTime);
+  if (!renderGraph.compile()) {
+    CH_LOG_ERROR(MultiStageRendererLog, "Render graph failed to compile, frame skipped");
+    return;
+  }
+
+  const SPtr<ICommandBuffer>& commandBuffer = m_framePacer->getCommandBuffer();
+  commandBuffer->begin();
+  renderGraph.execute(*commandBuffer);
+  commandBuffer->end();
+  m_framePacer->submit();
+
+  CH_LOG_DEBUG(MultiStageRendererLog, "Executed {0} of {1} stages",
+               renderGraph.getExecutedPassCount(), renderGraph.getPassCount());
+
+  // Color and depth targets come from the first texture outputs
+  m_finalOutput = {};
+  for (const UUID& typeId : outputTypes) {
+    auto data = std::dynamic_pointer_cast<TextureData>(m_frameData.getData(typeId));
+    if (!data || !data->isValid()) {
+      continue;
+    }
+
+    if (typeId == TypeTraits<DepthData>::getTypeId()) {
+      if (!m_finalOutput.depthTarget) {
+        m_finalOutput.depthTarget = data->texture;
+      }
+    }
+    else if (!m_finalOutput.colorTarget) {
+      m_finalOutput.colorTarget = data->texture;
+    }
+  }
+
+  m_finalOutput.width = m_renderWidth;
+  m_finalOutput.height = m_renderHeight;
+  m_finalOutput.isValid = true;
+}
+
+/*
+ */
+Vector<UUID>
+MultiStageRenderer::buildRenderGraph(RenderGraph& renderGraph, float deltaTime) {
+  Vector<Pair<uint32, IRenderStage*>> stagePasses;
+  Map<UUID, RenderGraphHandle> typeResources; // Latest producer of each type
+  Vector<UUID> producedTypes;
 
   for (const auto& stageInstance : m_stages) {
     // Early continue for disabled stages
@@ -246,31 +360,75 @@ MultiStageRenderer::executeRenderPipeline(float deltaTime) {
       continue;
     }
 
-    // Clear outputs for this stage
-    currentOutputs.clear();
-
-    // Execute stage
-    bool success = stageInstance.stage->execute(nullptr, currentInputs, currentOutputs, deltaTime);
+    IRenderStage* stage = stageInstance.stage.get();
+    auto setup = [&](RenderGraph::PassBuilder& builder) {
+      Map<UUID, RenderGraphHandle> outputResources;
+      stage->setupGraph(builder, outputResources);
+
+      // Data without texture still orders the stages producing and consuming it
+      for (const UUID& typeId : stage->getProvidedOutputTypes()) {
+        if (outputResources.find(typeId) == outputResources.end()) {
+          RenderGraphHandle handle = builder.createResource(typeId.toString());
+          builder.write(handle, RenderGraphUsage::None);
+          outputResources[typeId] = handle;
+        }
+      }
+
+      for (const auto& [typeId, handle] : outputResources) {
+        if (typeResources.find(typeId) == typeResources.end()) {
+          producedTypes.push_back(typeId);
+        }
+        typeResources[typeId] = handle;
+      }
+    };
+
+    auto execute = [this, stage, deltaTime](ICommandBuffer&) {
+      RenderStageIO outputs;
+      if (!stage->execute(m_framePacer->getCommandBuffer(), m_frameData, outputs,
+                          deltaTime)) {
+        CH_LOG_ERROR(MultiStageRendererLog, "Stage '{0}' execution failed", stage->getName());
+        return;
+      }
+
+      m_frameData.merge(outputs);
+    };
+
+    stagePasses.emplace_back(renderGraph.addPass(stage->getName(), setup, execute), stage);
+  }
 
-    // Early return on stage failure
-    if (!success) {
-      CH_LOG_ERROR( MultiStageRendererLog, "Stage '{0}' execution failed",
-                   stageInstance.stage->getName());
-      return;
+  // Inputs are declared once every producer is known, stages may be added in any order
+  Vector<UUID> consumedTypes;
+  for (const auto& [passIndex, stage] : stagePasses) {
+    RenderGraph::PassBuilder builder = renderGraph.getPassBuilder(passIndex);
+    for (const UUID& typeId : stage->getRequiredInputTypes()) {
+      consumedTypes.push_back(typeId);
+
+      auto it = typeResources.find(typeId);
+      if (it != typeResources.end()) {
+        builder.read(it->second, RenderGraphUsage::ShaderRead);
+      }
     }
+  }
 
-    // Chain outputs to next stage inputs
-    currentInputs = currentOutputs;
+  Vector<UUID> outputTypes = m_outputTypes;
+  if (outputTypes.empty()) {
+    for (const UUID& typeId : producedTypes) {
+      if (std::find(consumedTypes.begin(), consumedTypes.end(), typeId) ==
+          consumedTypes.end()) {
+        outputTypes.push_back(typeId);
+      }
+    }
   }
 
-  // Update final output (simplified for now)
-  // In a real implementation, you'd extract the final color texture
-  m_finalOutput.width = m_renderWidth;
-  m_finalOutput.height = m_renderHeight;
-  m_finalOutput.isValid = true;
+  // Outputs are sampled by whoever displays them after the frame
+  for (const UUID& typeId : outputTypes) {
+    auto it = typeResources.find(typeId);
+    if (it != typeResources.end()) {
+      renderGraph.markOutput(it->second, TextureLayout::ShaderReadOnly);
+    }
+  }
 
-  // TODO: Extract final color target from last stage outputs
-  // For now, we'll leave colorTarget and depthTarget as nullptr
+  return outputTypes;
 }
 
 } // namespace chEngineSDK
@@ -15,6 +15,8 @@
 #include "chRenderStageFactory.h"
 
 namespace chEngineSDK {
+class FramePacer;
+struct FramePacingStats;
 
 /**
  * @brief Multi-stage renderer that can execute multiple render stages
@@ -111,10 +113,51 @@ class CH_CORE_EXPORT MultiStageRenderer : public IRenderer
   Vector<UUID>
   getStageIds() const;
 
+  /**
+   * @brief Set the data types read after the frame, stages not contributing to them are
+   *        culled
+   * @param outputTypes Output type IDs, empty to keep every type no enabled stage consumes
+   */
+  void
+  setOutputTypes(const Vector<UUID>& outputTypes) {
+    m_outputTypes = outputTypes;
+  }
+
+  /**
+   * @brief Get the render graph of the last frame
+   * @return Render graph, to inspect culled passes and texture reuse
+   */
+  const RenderGraph&
+  getRenderGraph() const;
+
+  /**
+   * @brief Get how much the CPU and the GPU waited on each other
+   * @return Stats since the renderer was initialized
+   */
+  const FramePacingStats&
+  getFramePacingStats() const;
+
  private:
+  void
+  createCommandResources();
+
+  /**
+   * @brief Wait until the GPU is done with every submitted frame
+   */
+  void
+  waitForFrames();
+
   void
   executeRenderPipeline(float deltaTime);
 
+  /**
+   * @brief Add a pass per enabled stage and link them through their data types
+   * @param renderGraph Graph of the current frame, already reset
+   * @return Output type IDs of the frame
+   */
+  Vector<UUID>
+  buildRenderGraph(RenderGraph& renderGraph, float deltaTime);
+
   struct StageInstance {
     SPtr<IRenderStage> stage;
     UUID instanceId;
@@ -126,6 +169,16 @@ class CH_CORE_EXPORT MultiStageRenderer : public IRenderer
   Map<UUID, SIZE_T> m_stageMap; // instanceId -> index in m_stages
 
   RenderStageIO m_sceneData; // Initial data for pipeline
+  RenderStageIO m_frameData; // Scene data plus the outputs of the stages run this frame
+  Vector<UUID> m_outputTypes;
+
+  /**
+   * @brief Frames recorded ahead of the GPU. Every frame has its own graph, so transient
+   *        textures are only handed out again once the frame that used them finished
+   */
+  static constexpr uint32 FRAMES_IN_FLIGHT = 2;
+  SPtr<FramePacer> m_framePacer;
+  Array<RenderGraph, FRAMES_IN_FLIGHT> m_renderGraphs;
 
   uint32 m_renderWidth = 0;
   uint32 m_renderHeight = 0;
@@ -27,7 +27,6 @@
 #include "chICommandBuffer.h"
 #include "chICommandPool.h"
 #include "chICommandQueue.h"
-#include "chIDescriptorPool.h"
 #include "chIGraphicsAPI.h"
 #include "chIPipeline.h"
 #include "chIShader.h"
@@ -35,7 +34,12 @@
 #include "chITexture.h"
 #include "chITextureView.h"
 
+#include "chDescriptorSetCache.h"
+#include "chFramePacer.h"
+#include "chFrameUniformRing.h"
+#include "chGeometryPool.h"
 #include "chModel.h"
+#include "chParallelCommandRecorder.h"
 
 namespace chEngineSDK {
 
@@ -51,7 +55,6 @@ namespace RendererHelpers {
 struct ProjectionViewMatrix {
   Matrix4 projectionMatrix;
   Matrix4 viewMatrix;
-  Matrix4 modelMatrix;
 };
 
 } // namespace RendererHelpers
@@ -106,55 +109,70 @@ NastyRenderer::initialize(uint32 width, uint32 height) {
  */
 RendererOutput
 NastyRenderer::onRender(float deltaTime) {
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
-  // Wait for previous frame
-  if (!m_renderFence->wait(MAX_WAIT_TIME)) {
+  // Wait for the frame that used this frame's resources last
+  if (!m_framePacer->beginFrame(MAX_WAIT_TIME)) {
     CH_LOG_WARNING(NastyRendererSystem, "Render fence timeout");
     return {}; // Return invalid output
   }
-  m_renderFence->reset();
-
-  // Begin command buffer recording
-  m_commandBuffer->begin();
-
-  // Begin render pass
-  RenderPassBeginInfo renderPassInfo{.renderPass = m_renderPass,
-                                     .framebuffer = m_framebuffer,
-                                     .clearValues = m_clearColors,
-                                     .depthStencilClearValue = {{1.0f, 0}}};
+  m_frameIndex = m_framePacer->getFrameIndex();
+  const SPtr<ICommandBuffer>& commandBuffer = m_framePacer->getCommandBuffer();
 
-  m_commandBuffer->beginRenderPass(renderPassInfo);
-  m_commandBuffer->setViewport(0, 0, static_cast<float>(m_renderWidth), static_cast<float>(m_renderHeight));
-  m_commandBuffer->setScissor(0, 0, static_cast<float>(m_renderWidth), static_cast<float>(m_renderHeight));
-  m_commandBuffer->bindPipeline(m_pipeline);
+  if (m_uniformRing) {
+    m_uniformRing->beginFrame(m_frameIndex);
+  }
 
   // Update camera matrices
+  m_batchDraws.clear();
   if (m_camera) {
     projectionViewMatrix.viewMatrix = m_camera->getViewMatrix();
     projectionViewMatrix.projectionMatrix = m_camera->getProjectionMatrix();
 
-    // Render the model
     if (m_currentModel) {
-      renderModel(m_commandBuffer, deltaTime);
+      prepareDraws(deltaTime);
     }
   }
 
-  m_commandBuffer->endRenderPass();
-  m_commandBuffer->end();
+  // Large models are split across the JobSystem workers in secondary command buffers
+  const bool recordInParallel = m_commandRecorder &&
+                                m_commandRecorder->getSlotCount() > 1 &&
+                                m_batchDraws.size() >= PARALLEL_RECORD_MIN_DRAWS;
+
+  // Begin command buffer recording
+  commandBuffer->begin();
+
+  // Begin render pass
+  const FrameTargets& targets = m_frameTargets[m_frameIndex];
+  RenderPassBeginInfo renderPassInfo{.renderPass = m_renderPass,
+                                     .framebuffer = targets.framebuffer,
+                                     .clearValues = m_clearColors,
+                                     .depthStencilClearValue = {{1.0f, 0}},
+                                     .contents = recordInParallel
+                                                     ? SubpassContents::SecondaryCommandBuffers
+                                                     : SubpassContents::Inline};
+
+  commandBuffer->beginRenderPass(renderPassInfo);
+  if (recordInParallel) {
+    const auto& secondaryBuffers = m_commandRecorder->record(
+        m_frameIndex, {.renderPass = m_renderPass, .framebuffer = targets.framebuffer},
+        m_batchDraws.size(), [this](ICommandBuffer& commandBuffer, SIZE_T begin, SIZE_T end) {
+          recordDraws(commandBuffer, begin, end);
+        });
+    commandBuffer->executeCommands(secondaryBuffers);
+  }
+  else {
+    recordDraws(*commandBuffer, 0, m_batchDraws.size());
+  }
 
-  // Submit command buffer
-  SubmitInfo submitInfo{.commandBuffers = {m_commandBuffer},
-                        .waitSemaphores = {},
-                        .waitStages = {},
-                        .signalSemaphores = {}};
+  commandBuffer->endRenderPass();
+  commandBuffer->end();
 
-  graphicsAPI.getQueue(QueueType::Graphics)->submit(submitInfo, m_renderFence);
+  // Submit command buffer, it signals the fence of this frame
+  m_framePacer->submit();
 
   // Return output
   RendererOutput output;
-  output.colorTarget = m_colorTargetView;
-  output.depthTarget = m_depthTargetView;
+  output.colorTarget = targets.colorTargetView;
+  output.depthTarget = targets.depthTargetView;
   output.width = m_renderWidth;
   output.height = m_renderHeight;
   output.isValid = true;
@@ -168,28 +186,23 @@ void
 NastyRenderer::resize(uint32 width, uint32 height) {
   CH_LOG_INFO(NastyRendererSystem, "Resizing NastyRenderer to {0}x{1}", width, height);
 
-  auto& graphicsAPI = IGraphicsAPI::instance();
-  graphicsAPI.waitIdle();
-
-  if (m_renderFence) {
-    m_renderFence->wait(MAX_WAIT_TIME);
+  // Frames in flight still render to the old targets, they go away once those retire
+  for (FrameTargets& targets : m_frameTargets) {
+    m_framePacer->deferRelease(std::move(targets.framebuffer));
+    m_framePacer->deferRelease(std::move(targets.colorTargetView));
+    m_framePacer->deferRelease(std::move(targets.colorTarget));
+    m_framePacer->deferRelease(std::move(targets.depthTargetView));
+    m_framePacer->deferRelease(std::move(targets.depthTarget));
   }
+  m_framePacer->deferRelease(std::move(m_renderPass));
 
   m_renderWidth = width;
   m_renderHeight = height;
 
-  // Recreate render targets with new dimensions
+  // Recreate render targets, render pass and framebuffer with new dimensions
   createRenderTargets();
   createRenderPass();
 
-  // Recreate framebuffer
-  FrameBufferCreateInfo fbInfo{.renderPass = m_renderPass,
-                               .attachments = {m_colorTargetView, m_depthTargetView},
-                               .width = m_renderWidth,
-                               .height = m_renderHeight,
-                               .layers = 1};
-  m_framebuffer = graphicsAPI.createFrameBuffer(fbInfo);
-
   // Update camera viewport
   if (m_camera) {
     m_camera->setViewportSize(static_cast<float>(width), static_cast<float>(height));
@@ -205,19 +218,16 @@ void
 NastyRenderer::cleanup() {
   CH_LOG_INFO(NastyRendererSystem, "Cleaning up NastyRenderer");
 
-  auto& graphicsAPI = IGraphicsAPI::instance();
-  graphicsAPI.waitIdle();
-
-  if (m_renderFence) {
-    m_renderFence->wait();
+  // Only the frames of this renderer use its resources
+  if (m_framePacer) {
+    m_framePacer->waitAll();
   }
 
   cleanupModelResources();
 
-  // Reset command resources
-  m_commandBuffer.reset();
-  m_commandPool.reset();
-  m_renderFence.reset();
+  // Reset command resources, the pacer releases what is still queued
+  m_commandRecorder.reset();
+  m_framePacer.reset();
 
   // Reset pipeline resources
   m_pipeline.reset();
@@ -225,17 +235,14 @@ NastyRenderer::cleanup() {
   m_fragmentShader.reset();
 
   // Reset render targets
-  m_framebuffer.reset();
+  m_frameTargets = {};
   m_renderPass.reset();
-  m_colorTargetView.reset();
-  m_colorTarget.reset();
-  m_depthTargetView.reset();
-  m_depthTarget.reset();
 
   // Reset material resources
   m_sampler.reset();
+  m_descriptorSetCache.reset();
   m_descriptorSetLayout.reset();
-  m_descriptorPool.reset();
+  m_uniformRing.reset();
 
   // Reset scene resources
   m_camera.reset();
@@ -261,11 +268,8 @@ NastyRenderer::createRenderTargets() {
                                      .samples = SampleCount::Count1,
                                      .usage = TextureUsage::ColorAttachment
                                               | TextureUsage::Sampled};
-  m_colorTarget = graphicsAPI.createTexture(colorTextureInfo);
-
   TextureViewCreateInfo colorViewInfo{.format = Format::R8G8B8A8_UNORM,
                                       .viewType = TextureViewType::View2D};
-  m_colorTargetView = m_colorTarget->createView(colorViewInfo);
 
   // Create depth target
   TextureCreateInfo depthTextureInfo{.type = TextureType::Texture2D,
@@ -277,12 +281,17 @@ NastyRenderer::createRenderTargets() {
                                      .arrayLayers = 1,
                                      .samples = SampleCount::Count1,
                                      .usage = TextureUsage::DepthStencil};
-  m_depthTarget = graphicsAPI.createTexture(depthTextureInfo);
-
   TextureViewCreateInfo depthViewInfo{.format = Format::D32_SFLOAT,
                                       .viewType = TextureViewType::View2D,
                                       .bIsDepthStencil = true};
-  m_depthTargetView = m_depthTarget->createView(depthViewInfo);
+
+  // One set per frame in flight
+  for (FrameTargets& targets : m_frameTargets) {
+    targets.colorTarget = graphicsAPI.createTexture(colorTextureInfo);
+    targets.colorTargetView = targets.colorTarget->createView(colorViewInfo);
+    targets.depthTarget = graphicsAPI.createTexture(depthTextureInfo);
+    targets.depthTargetView = targets.depthTarget->createView(depthViewInfo);
+  }
 
   CH_LOG_INFO(NastyRendererSystem, "Render targets created: {0}x{1}", m_renderWidth,
               m_renderHeight);
@@ -332,15 +341,18 @@ NastyRenderer::createRenderPass() {
 
   m_renderPass = graphicsAPI.createRenderPass(renderPassInfo);
 
-  // Create framebuffer
-  FrameBufferCreateInfo fbInfo{.renderPass = m_renderPass,
-                               .attachments = {m_colorTargetView, m_depthTargetView},
-                               .width = m_renderWidth,
-                               .height = m_renderHeight,
-                               .layers = 1};
-  m_framebuffer = graphicsAPI.createFrameBuffer(fbInfo);
+  // Create a framebuffer per frame in flight
+  for (FrameTargets& targets : m_frameTargets) {
+    FrameBufferCreateInfo fbInfo{.renderPass = m_renderPass,
+                                 .attachments = {targets.colorTargetView,
+                                                 targets.depthTargetView},
+                                 .width = m_renderWidth,
+                                 .height = m_renderHeight,
+                                 .layers = 1};
+    targets.framebuffer = graphicsAPI.createFrameBuffer(fbInfo);
+  }
 
-  CH_LOG_INFO(NastyRendererSystem, "Render pass and framebuffer created");
+  CH_LOG_INFO(NastyRendererSystem, "Render pass and framebuffers created");
 }
 
 /*
@@ -349,10 +361,10 @@ void
 NastyRenderer::initializeRenderResources() {
   auto& graphicsAPI = IGraphicsAPI::instance();
 
-  // Create command pool and buffer
-  m_commandPool = graphicsAPI.createCommandPool(QueueType::Graphics);
-  m_commandBuffer = m_commandPool->allocateCommandBuffer();
-  m_renderFence = graphicsAPI.createFence(true);
+  // Create per frame command buffers and fences
+  m_framePacer = chMakeShared<FramePacer>(FRAMES_IN_FLIGHT);
+  m_commandRecorder =
+      chMakeShared<ParallelCommandRecorder>(FRAMES_IN_FLIGHT, PARALLEL_RECORD_MIN_DRAWS / 4);
 
   // Create camera
   m_camera =
@@ -364,7 +376,7 @@ NastyRenderer::initializeRenderResources() {
 
   // Create descriptor set layout
   Vector<DescriptorSetLayoutBinding> bindings{{.binding = 0,
-                                               .type = DescriptorType::UniformBuffer,
+                                               .type = DescriptorType::UniformBufferDynamic,
                                                .count = 1,
                                                .stageFlags = ShaderStage::Vertex},
                                               {.binding = 1,
@@ -375,6 +387,17 @@ NastyRenderer::initializeRenderResources() {
   DescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{.bindings = bindings};
   m_descriptorSetLayout = graphicsAPI.createDescriptorSetLayout(descriptorSetLayoutCreateInfo);
 
+  // A model binds a single set, a few per pool are enough
+  m_descriptorSetCache = chMakeShared<DescriptorSetCache>(
+      DescriptorAllocator::PoolSizeRatios{{DescriptorType::UniformBufferDynamic, 1.0f},
+                                          {DescriptorType::CombinedImageSampler, 1.0f}},
+      4);
+
+  // Node transforms go through the instance buffers, a frame only pushes the camera
+  constexpr uint32 slotSize =
+      FrameUniformRing::getSlotSize(sizeof(RendererHelpers::ProjectionViewMatrix));
+  m_uniformRing = chMakeShared<FrameUniformRing>(FRAMES_IN_FLIGHT, slotSize);
+
   // Create sampler
   SamplerCreateInfo samplerCreateInfo{.magFilter = SamplerFilter::Linear,
                                       .minFilter = SamplerFilter::Linear,
@@ -410,7 +433,7 @@ NastyRenderer::initializeRenderResources() {
   PipelineCreateInfo pipelineCreateInfo{
       .shaders = {{ShaderStage::Vertex, m_vertexShader},
                   {ShaderStage::Fragment, m_fragmentShader}},
-      .vertexLayout = VertexNormalTexCoord::getLayout(),
+      .vertexLayout = VertexLayout::createPositionNormalTexCoordInstancedLayout(),
       .topology = PrimitiveTopology::TriangleList,
       .depthStencil = {.enable = true, .writeEnable = true, .compareOp = CompareOp::Less},
       .renderPass = m_renderPass,
@@ -456,156 +479,95 @@ NastyRenderer::loadModel(const SPtr<Model>& model) {
  */
 void
 NastyRenderer::createMeshBuffers() {
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
   if (!m_currentModel) {
     return;
   }
 
-  Vector<SPtr<Mesh>> uniqueMeshes;
-  UnorderedMap<SPtr<Mesh>, uint32> meshToIndexMap;
-
-  // Collect all unique meshes from the model
   for (ModelNode* node : m_currentModel->getAllNodes()) {
     NodeNames.push_back(node->getName());
-    for (const auto& mesh : node->getMeshes()) {
-      // If this mesh is not already in our list
-      if (meshToIndexMap.find(mesh) == meshToIndexMap.end()) {
-        meshToIndexMap[mesh] = static_cast<uint32>(uniqueMeshes.size());
-        uniqueMeshes.push_back(mesh);
-      }
-    }
   }
 
-  // Resize our buffer arrays
-  m_meshVertexBuffers.resize(uniqueMeshes.size());
-  m_meshIndexBuffers.resize(uniqueMeshes.size());
-  m_meshIndexCounts.resize(uniqueMeshes.size());
-  m_meshIndexTypes.resize(uniqueMeshes.size());
-
-  // Create vertex and index buffers for each unique mesh
-  for (size_t i = 0; i < uniqueMeshes.size(); ++i) {
-    const auto& mesh = uniqueMeshes[i];
-
-    // Create vertex buffer
-    const Vector<uint8>& vertexData = mesh->getVertexData();
-    const uint32 vertexDataSize = static_cast<uint32>(mesh->getVertexDataSize());
-
-    BufferCreateInfo vertexBufferCreateInfo{
-        .size = vertexDataSize,
-        .usage = BufferUsage::VertexBuffer,
-        .memoryUsage = MemoryUsage::CpuToGpu,
-        .initialData = const_cast<void*>(static_cast<const void*>(vertexData.data())),
-        .initialDataSize = vertexDataSize,
-    };
-    m_meshVertexBuffers[i] = graphicsAPI.createBuffer(vertexBufferCreateInfo);
-
-    // Store index information
-    m_meshIndexTypes[i] = mesh->getIndexType();
-    m_meshIndexCounts[i] = mesh->getIndexCount();
-
-    // Create index buffer based on index type
-    if (m_meshIndexTypes[i] == IndexType::UInt16) {
-      Vector<uint16> indexData = mesh->getIndicesAsUInt16();
-      const uint32 indexDataSize = static_cast<uint32>( mesh->getIndexDataSize());
-
-      BufferCreateInfo indexBufferCreateInfo{
-          .size = indexDataSize,
-          .usage = BufferUsage::IndexBuffer,
-          .memoryUsage = MemoryUsage::CpuToGpu,
-          .initialData = const_cast<void*>(static_cast<const void*>(indexData.data())),
-          .initialDataSize = indexDataSize,
-      };
-      m_meshIndexBuffers[i] = graphicsAPI.createBuffer(indexBufferCreateInfo);
+  // Instance batches already hold every unique mesh once, the pools are sized to fit all
+  // of them so loading never grows them
+  const Vector<MeshInstanceBatch>& batches = m_currentModel->getInstanceBatches();
+  Vector<VertexLayout> poolLayouts;
+  Vector<Pair<uint32, uint32>> poolCapacities;
+  Vector<uint32> meshPools;
+  meshPools.reserve(batches.size());
+  for (const MeshInstanceBatch& batch : batches) {
+    const VertexLayout& layout = batch.mesh->getVertexLayout();
+    auto it = std::find(poolLayouts.begin(), poolLayouts.end(), layout);
+    const uint32 poolIndex = static_cast<uint32>(it - poolLayouts.begin());
+    if (it == poolLayouts.end()) {
+      poolLayouts.push_back(layout);
+      poolCapacities.push_back({0, 0});
     }
-    else {
-      Vector<uint32> indexData = mesh->getIndicesAsUInt32();
-      const uint32 indexDataSize = static_cast<uint32>(mesh->getIndexDataSize());
-
-      BufferCreateInfo indexBufferCreateInfo{
-          .size = indexDataSize,
-          .usage = BufferUsage::IndexBuffer,
-          .memoryUsage = MemoryUsage::CpuToGpu,
-          .initialData = const_cast<void*>(static_cast<const void*>(indexData.data())),
-          .initialDataSize = indexDataSize,
-      };
-      m_meshIndexBuffers[i] = graphicsAPI.createBuffer(indexBufferCreateInfo);
+
+    poolCapacities[poolIndex].first += batch.mesh->getVertexCount();
+    poolCapacities[poolIndex].second += batch.mesh->getIndexCount();
+    meshPools.push_back(poolIndex);
+  }
+
+  // Buffers replaced when a pool grows wait for the frames that may still draw from them
+  auto releaseBuffer = [weakPacer = WeakPtr<FramePacer>(m_framePacer)](SPtr<IBuffer> buffer) {
+    if (SPtr<FramePacer> pacer = weakPacer.lock()) {
+      pacer->deferRelease(std::move(buffer));
     }
+  };
+
+  for (SIZE_T i = 0; i < poolLayouts.size(); ++i) {
+    m_geometryPools.push_back(chMakeShared<GeometryPool>(poolLayouts[i],
+                                                         poolCapacities[i].first,
+                                                         poolCapacities[i].second,
+                                                         releaseBuffer));
   }
 
-  // Store the mesh to index mapping
-  m_meshToIndexMap = std::move(meshToIndexMap);
+  // The data is staged and reaches device local memory with the next upload batch
+  for (SIZE_T i = 0; i < batches.size(); ++i) {
+    m_geometryPools[meshPools[i]]->add(batches[i].mesh);
+    m_meshToPool[batches[i].mesh.get()] = meshPools[i];
+  }
 
-  CH_LOG_INFO(NastyRendererSystem, "Created mesh buffers for {0} unique meshes",
-              uniqueMeshes.size());
+  CH_LOG_INFO(NastyRendererSystem, "Packed {0} unique meshes in {1} geometry pools",
+              batches.size(), m_geometryPools.size());
 }
 
 /*
  */
 void
 NastyRenderer::createNodeDescriptorResources() {
-  auto& graphicsAPI = IGraphicsAPI::instance();
-
   if (!m_currentModel) {
     return;
   }
 
-  uint32 nodeCount = static_cast<uint32>(m_currentModel->getAllNodes().size());
-
-  // Create descriptor pool for all nodes
-  DescriptorPoolCreateInfo descriptorPoolCreateInfo{
-      .maxSets = nodeCount,
-      .poolSizes = {{DescriptorType::UniformBuffer, nodeCount},
-                    {DescriptorType::CombinedImageSampler, nodeCount}}};
-  m_descriptorPool = graphicsAPI.createDescriptorPool(descriptorPoolCreateInfo);
-
-  // Create descriptor resources for each node
-  for (ModelNode* node : m_currentModel->getAllNodes()) {
-    if (node->getMeshes().empty()) {
-      continue;
-    }
-
-    // Create uniform buffer for this node
-    BufferCreateInfo bufferCreateInfo{.size = sizeof(RendererHelpers::ProjectionViewMatrix),
-                                      .usage = BufferUsage::UniformBuffer,
-                                      .memoryUsage = MemoryUsage::CpuToGpu};
-    SPtr<IBuffer> nodeBuffer = graphicsAPI.createBuffer(bufferCreateInfo);
-
-    // Allocate descriptor set for this node
-    DescriptorSetAllocateInfo allocInfo{.pool = m_descriptorPool,
-                                        .layout = m_descriptorSetLayout};
-    SPtr<IDescriptorSet> nodeDescriptorSet =
-        m_descriptorPool->allocateDescriptorSet(allocInfo);
-
-    // Setup descriptor writes
-    DescriptorBufferInfo bufferInfo{.buffer = nodeBuffer,
-                                    .offset = 0,
-                                    .range = sizeof(RendererHelpers::ProjectionViewMatrix)};
-
-    DescriptorImageInfo imageInfo{.sampler = m_sampler,
-                                  .imageView = m_textureView,
-                                  .imageLayout = TextureLayout::ShaderReadOnly};
-
-    Vector<WriteDescriptorSet> writeDescriptorSets{
-        {.dstSet = nodeDescriptorSet,
-         .dstBinding = 0,
-         .dstArrayElement = 0,
-         .descriptorType = DescriptorType::UniformBuffer,
-         .bufferInfos = {bufferInfo}},
-        {.dstSet = nodeDescriptorSet,
-         .dstBinding = 1,
-         .dstArrayElement = 0,
-         .descriptorType = DescriptorType::CombinedImageSampler,
-         .imageInfos = {imageInfo}}};
-
-    // Update descriptor sets
-    graphicsAPI.updateDescriptorSets(writeDescriptorSets);
-
-    // Store node resources
-    m_nodeResources[node] = {.uniformBuffer = nodeBuffer, .descriptorSet = nodeDescriptorSet};
-  }
-
-  CH_LOG_INFO(NastyRendererSystem, "Created descriptor resources for {0} nodes", nodeCount);
+  // The range covers one frame, the dynamic offset moves it through the ring
+  DescriptorBufferInfo bufferInfo{.buffer = m_uniformRing->getBuffer(),
+                                  .offset = 0,
+                                  .range = sizeof(RendererHelpers::ProjectionViewMatrix)};
+
+  DescriptorImageInfo imageInfo{.sampler = m_sampler,
+                                .imageView = m_textureView,
+                                .imageLayout = TextureLayout::ShaderReadOnly};
+
+  Vector<WriteDescriptorSet> writeDescriptorSets{
+      {.dstSet = nullptr,
+       .dstBinding = 0,
+       .dstArrayElement = 0,
+       .descriptorType = DescriptorType::UniformBufferDynamic,
+       .bufferInfos = {bufferInfo}},
+      {.dstSet = nullptr,
+       .dstBinding = 1,
+       .dstArrayElement = 0,
+       .descriptorType = DescriptorType::CombinedImageSampler,
+       .imageInfos = {imageInfo}}};
+
+  // Reloading a model binds the same resources, so the set written the first time is reused
+  m_descriptorSet = m_descriptorSetCache->getOrCreate(m_descriptorSetLayout,
+                                                      writeDescriptorSets);
+
+  CH_LOG_INFO(NastyRendererSystem,
+              "Created descriptor resources for {0} mesh batches, {1} cached sets",
+              m_currentModel->getInstanceBatches().size(), m_descriptorSetCache->getSize());
 }
 
 /*
@@ -725,8 +687,8 @@ NastyRenderer::bindInputEvents() {
 /*
  */
 void
-NastyRenderer::renderModel(const SPtr<ICommandBuffer>& commandBuffer, float deltaTime) {
-  if (!m_currentModel) {
+NastyRenderer::prepareDraws(float deltaTime) {
+  if (!m_currentModel || !m_uniformRing) {
     return;
   }
 
@@ -741,41 +703,120 @@ NastyRenderer::renderModel(const SPtr<ICommandBuffer>& commandBuffer, float delt
     }
   }
 
-  const Matrix4& projectionMatrix = m_camera->getProjectionMatrix();
-  const Matrix4& viewMatrix = m_camera->getViewMatrix();
+  const RendererHelpers::ProjectionViewMatrix matrices = {
+      .projectionMatrix = m_camera->getProjectionMatrix(),
+      .viewMatrix = m_camera->getViewMatrix()};
+  m_frameUniformOffset = m_uniformRing->push(matrices);
 
-  for (ModelNode* node : m_currentModel->getAllNodes()) {
-    if (node->getMeshes().empty()) {
+  // The batches keep the global transform of every node using their mesh up to date
+  const Vector<MeshInstanceBatch>& batches = m_currentModel->getInstanceBatches();
+  SIZE_T instanceCount = 0;
+  for (const MeshInstanceBatch& batch : batches) {
+    instanceCount += batch.transforms.size();
+  }
+  reserveFrameDrawBuffers(instanceCount, batches.size());
+
+  const SPtr<IBuffer>& instanceBuffer = m_instanceBuffers[m_frameIndex];
+  m_indirectCommands.clear();
+  uint64 instanceOffset = 0;
+  for (const MeshInstanceBatch& batch : batches) {
+    auto it = m_meshToPool.find(batch.mesh.get());
+    if (batch.transforms.empty() || it == m_meshToPool.end()) {
       continue;
     }
 
-    auto it = m_nodeResources.find(node);
-    if (it == m_nodeResources.end()) {
-      CH_LOG_ERROR(NastyRendererSystem, "No render resources found for node: {0}",
-                   node->getName());
+    const uint32 poolIndex = it->second;
+    const GeometryRange* range = m_geometryPools[poolIndex]->find(batch.mesh.get());
+    if (!range || range->indexCount == 0) {
       continue;
     }
 
-    NodeRenderResources& resources = it->second;
+    const SIZE_T transformsSize = batch.transforms.size() * sizeof(Matrix4);
+    instanceBuffer->update(batch.transforms.data(), transformsSize,
+                           static_cast<uint32>(instanceOffset));
+
+    // The instance buffer is bound at the batch offset, so every batch starts at instance 0
+    m_batchDraws.push_back({.poolIndex = poolIndex,
+                            .instanceOffset = instanceOffset,
+                            .indirectOffset = m_indirectCommands.size() *
+                                              sizeof(DrawIndexedIndirectCommand)});
+    m_indirectCommands.push_back(
+        {.indexCount = range->indexCount,
+         .instanceCount = static_cast<uint32>(batch.transforms.size()),
+         .firstIndex = range->firstIndex,
+         .vertexOffset = range->vertexOffset,
+         .firstInstance = 0});
+    instanceOffset += transformsSize;
+  }
+
+  std::stable_sort(m_batchDraws.begin(), m_batchDraws.end(),
+                   [](const BatchDraw& a, const BatchDraw& b) {
+                     return a.poolIndex < b.poolIndex;
+                   });
+
+  if (!m_indirectCommands.empty()) {
+    m_indirectBuffers[m_frameIndex]->update(
+        m_indirectCommands.data(),
+        m_indirectCommands.size() * sizeof(DrawIndexedIndirectCommand));
+  }
+}
+
+/*
+ */
+void
+NastyRenderer::reserveFrameDrawBuffers(SIZE_T instanceCount, SIZE_T drawCount) {
+  auto& graphicsAPI = IGraphicsAPI::instance();
+
+  // Buffers of the other frames may still be read, only the current one is replaced
+  const uint32 instanceBytes =
+      static_cast<uint32>(Math::max(instanceCount, static_cast<SIZE_T>(1)) * sizeof(Matrix4));
+  SPtr<IBuffer>& instanceBuffer = m_instanceBuffers[m_frameIndex];
+  if (!instanceBuffer || instanceBuffer->getSize() < instanceBytes) {
+    instanceBuffer = graphicsAPI.createBuffer({.size = instanceBytes,
+                                               .usage = BufferUsage::VertexBuffer,
+                                               .memoryUsage = MemoryUsage::CpuToGpu});
+  }
 
-    RendererHelpers::ProjectionViewMatrix matrices = {.projectionMatrix = projectionMatrix,
-                                                      .viewMatrix = viewMatrix,
-                                                      .modelMatrix =
-                                                          node->getGlobalTransform()};
+  const uint32 indirectBytes = static_cast<uint32>(
+      Math::max(drawCount, static_cast<SIZE_T>(1)) * sizeof(DrawIndexedIndirectCommand));
+  SPtr<IBuffer>& indirectBuffer = m_indirectBuffers[m_frameIndex];
+  if (!indirectBuffer || indirectBuffer->getSize() < indirectBytes) {
+    indirectBuffer = graphicsAPI.createBuffer({.size = indirectBytes,
+                                               .usage = BufferUsage::IndirectBuffer,
+                                               .memoryUsage = MemoryUsage::CpuToGpu});
+  }
+}
 
-    resources.uniformBuffer->update(&matrices, sizeof(matrices));
+/*
+ */
+void
+NastyRenderer::recordDraws(ICommandBuffer& commandBuffer, SIZE_T begin, SIZE_T end) const {
+  commandBuffer.setViewport(0, 0, static_cast<float>(m_renderWidth),
+                            static_cast<float>(m_renderHeight));
+  commandBuffer.setScissor(0, 0, m_renderWidth, m_renderHeight);
+  commandBuffer.bindPipeline(m_pipeline);
+  if (begin == end) {
+    return;
+  }
 
-    commandBuffer->bindDescriptorSets(PipelineBindPoint::Graphics, m_pipeline->getLayout(), 0,
-                                      {resources.descriptorSet});
+  commandBuffer.bindDescriptorSets(PipelineBindPoint::Graphics, m_pipeline->getLayout(), 0,
+                                   {m_descriptorSet}, {m_frameUniformOffset});
 
-    for (const auto& mesh : node->getMeshes()) {
-      uint32 meshIndex = m_meshToIndexMap[mesh];
+  const SPtr<IBuffer>& instanceBuffer = m_instanceBuffers[m_frameIndex];
+  const SPtr<IBuffer>& indirectBuffer = m_indirectBuffers[m_frameIndex];
+  const GeometryPool* boundPool = nullptr;
+  for (SIZE_T i = begin; i < end; ++i) {
+    const BatchDraw& draw = m_batchDraws[i];
 
-      commandBuffer->bindVertexBuffer(m_meshVertexBuffers[meshIndex]);
-      commandBuffer->bindIndexBuffer(m_meshIndexBuffers[meshIndex],
-                                     m_meshIndexTypes[meshIndex]);
-      commandBuffer->drawIndexed(m_meshIndexCounts[meshIndex]);
+    const GeometryPool* pool = m_geometryPools[draw.poolIndex].get();
+    if (pool != boundPool) {
+      commandBuffer.bindVertexBuffer(pool->getVertexBuffer());
+      commandBuffer.bindIndexBuffer(pool->getIndexBuffer(), GeometryPool::INDEX_TYPE);
+      boundPool = pool;
     }
+
+    commandBuffer.bindVertexBuffer(instanceBuffer, 1, draw.instanceOffset);
+    commandBuffer.drawIndexedIndirect(indirectBuffer, draw.indirectOffset);
   }
 }
 
@@ -783,29 +824,32 @@ NastyRenderer::renderModel(const SPtr<ICommandBuffer>& commandBuffer, float delt
  */
 void
 NastyRenderer::cleanupModelResources() {
-  // Clear mesh buffers
-  m_meshVertexBuffers.clear();
-  m_meshIndexBuffers.clear();
-  m_meshIndexCounts.clear();
-  m_meshIndexTypes.clear();
-  m_meshToIndexMap.clear();
-
-  // Clear node resources
-  for (auto& pair : m_nodeResources) {
-    pair.second.uniformBuffer.reset();
-    pair.second.descriptorSet.reset();
+  // Frames in flight may still draw the old model, its buffers go away once those retire
+  if (m_framePacer) {
+    for (auto& pool : m_geometryPools) {
+      m_framePacer->deferRelease(std::move(pool));
+    }
+    for (SIZE_T i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+      m_framePacer->deferRelease(std::move(m_instanceBuffers[i]));
+      m_framePacer->deferRelease(std::move(m_indirectBuffers[i]));
+    }
   }
-  m_nodeResources.clear();
+
+  // Clear mesh buffers
+  m_geometryPools.clear();
+  m_meshToPool.clear();
+
+  // Clear per draw resources
+  m_batchDraws.clear();
+  m_indirectCommands.clear();
+  m_instanceBuffers = {};
+  m_indirectBuffers = {};
+  m_descriptorSet.reset();
 
   // Clear node names
   NodeNames.clear();
   NodeIndex = 0;
 
-  // Reset descriptor pool
-  if (m_descriptorPool) {
-    m_descriptorPool.reset();
-  }
-
   // Reset current model
   m_currentModel.reset();
 
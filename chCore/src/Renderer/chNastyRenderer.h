@@ -13,7 +13,12 @@
 #include "chGraphicsTypes.h"
 
 namespace chEngineSDK {
+class DescriptorSetCache;
+class FramePacer;
+class FrameUniformRing;
+class GeometryPool;
 class ModelNode;
+class ParallelCommandRecorder;
 class CH_CORE_EXPORT NastyRenderer : public IRenderer {
 public:
   NastyRenderer();
@@ -56,6 +61,9 @@ public:
 
  private:
 
+  /**
+   * Pack the meshes of the current model in one geometry pool per vertex layout
+   */
   void
   createMeshBuffers();
 
@@ -69,28 +77,70 @@ public:
   void
   initializeRenderResources();
 
+  /**
+   * Update the model transforms and write this frame's instance and indirect buffers,
+   * one indirect draw per mesh with every node using it as an instance.
+   */
   void
-  renderModel(const SPtr<ICommandBuffer>& commandBuffer, float deltaTime);
+  prepareDraws(float deltaTime);
+
+  /**
+   * Grow the buffers of the current frame to hold the given counts
+   */
+  void
+  reserveFrameDrawBuffers(SIZE_T instanceCount, SIZE_T drawCount);
+
+  /**
+   * Record the draws [begin, end) of the draw list, sets every state they use so it can
+   * run on a secondary command buffer from any thread.
+   */
+  void
+  recordDraws(ICommandBuffer& commandBuffer, SIZE_T begin, SIZE_T end) const;
 
   void
   cleanupModelResources();
 
   bool m_bIsfocused = false;
 
-  SPtr<ITexture> m_colorTarget;
-  SPtr<ITextureView> m_colorTargetView;
-  SPtr<ITexture> m_depthTarget;
-  SPtr<ITextureView> m_depthTargetView;
+  /**
+   * Frames recorded ahead of the GPU. Each one has its own fence, command buffer, uniform
+   * ring region, draw buffers and render targets.
+   */
+  static constexpr uint32 FRAMES_IN_FLIGHT = 2;
+  SPtr<FramePacer> m_framePacer;
+  uint32 m_frameIndex = 0;
+
+  /**
+   * Images one frame renders to. Two frames in flight never share them, so the clear of a
+   * frame can't race the depth writes or the sampling of the previous one.
+   */
+  struct FrameTargets
+  {
+    SPtr<ITexture> colorTarget;
+    SPtr<ITextureView> colorTargetView;
+    SPtr<ITexture> depthTarget;
+    SPtr<ITextureView> depthTargetView;
+    SPtr<IFrameBuffer> framebuffer;
+  };
+
+  Array<FrameTargets, FRAMES_IN_FLIGHT> m_frameTargets;
 
   Vector<LinearColor> m_clearColors;
 
   SPtr<IRenderPass> m_renderPass;
-  SPtr<IFrameBuffer> m_framebuffer;
 
-  SPtr<ICommandPool> m_commandPool;
-  SPtr<ICommandBuffer> m_commandBuffer;
+  /**
+   * Below this many draws recording inline is cheaper than starting secondary buffers.
+   */
+  static constexpr SIZE_T PARALLEL_RECORD_MIN_DRAWS = 256;
 
-  SPtr<IFence> m_renderFence;
+  /**
+   * Written every frame, so each frame in flight has its own.
+   */
+  Array<SPtr<IBuffer>, FRAMES_IN_FLIGHT> m_instanceBuffers;
+  Array<SPtr<IBuffer>, FRAMES_IN_FLIGHT> m_indirectBuffers;
+  Vector<DrawIndexedIndirectCommand> m_indirectCommands;
+  SPtr<ParallelCommandRecorder> m_commandRecorder;
 
   uint32 m_renderWidth = 1280;
   uint32 m_renderHeight = 720;
@@ -104,23 +154,31 @@ public:
   SPtr<IShader> m_fragmentShader;
   SPtr<IPipeline> m_pipeline;
 
-  Vector<SPtr<IBuffer>> m_meshVertexBuffers;
-  Vector<SPtr<IBuffer>> m_meshIndexBuffers;
-  Vector<uint32> m_meshIndexCounts;
-  Vector<IndexType> m_meshIndexTypes;
-  UnorderedMap<SPtr<Mesh>, uint32> m_meshToIndexMap;
+  Vector<SPtr<GeometryPool>> m_geometryPools;
+  UnorderedMap<const Mesh*, uint32> m_meshToPool;
 
   SPtr<ITexture> m_texture;
   SPtr<ITextureView> m_textureView;
   SPtr<ISampler> m_sampler;
   SPtr<IDescriptorSetLayout> m_descriptorSetLayout;
-  SPtr<IDescriptorPool> m_descriptorPool;
-
-  struct NodeRenderResources {
-    SPtr<IBuffer> uniformBuffer;
-    SPtr<IDescriptorSet> descriptorSet;
+  SPtr<DescriptorSetCache> m_descriptorSetCache;
+
+  // Every draw uses the same set, the frame matrices are selected with a dynamic offset
+  SPtr<IDescriptorSet> m_descriptorSet;
+  SPtr<FrameUniformRing> m_uniformRing;
+  uint32 m_frameUniformOffset = 0;
+
+  /**
+   * One instanced draw of a mesh, offsets point into this frame's buffers. Draws are
+   * sorted by pool so the geometry buffers are bound once per pool.
+   */
+  struct BatchDraw
+  {
+    uint32 poolIndex = 0;
+    uint64 instanceOffset = 0;
+    uint64 indirectOffset = 0;
   };
-  UnorderedMap<ModelNode*, NodeRenderResources> m_nodeResources;
+  Vector<BatchDraw> m_batchDraws;
 
   HEvent listenKeyDown;
   HEvent listenKeys;
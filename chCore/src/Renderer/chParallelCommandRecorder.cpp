@@ -0,0 +1,90 @@
+/************************************************************************/
+/**
+ * @file chParallelCommandRecorder.cpp
+ * @author AccelMR
+ * @date 2025/08/06
+ * @brief
+ *  Records the draws of a render pass into secondary command buffers on the JobSystem.
+ */
+/************************************************************************/
+
+#include "chParallelCommandRecorder.h"
+
+#include "chICommandBuffer.h"
+#include "chICommandPool.h"
+#include "chIGraphicsAPI.h"
+#include "chJobSystem.h"
+
+namespace chEngineSDK {
+/*
+*/
+ParallelCommandRecorder::ParallelCommandRecorder(uint32 frameCount, SIZE_T minItemsPerSlot)
+  : m_frameCount(frameCount),
+    m_minItemsPerSlot(Math::max(minItemsPerSlot, static_cast<SIZE_T>(1))) {
+  CH_ASSERT(frameCount > 0);
+
+  m_slotCount = 1;
+  if (JobSystem::isStarted()) {
+    m_slotCount += JobSystem::instance().getWorkerCount();
+  }
+
+  m_slotFrames.resize(static_cast<SIZE_T>(m_slotCount) * m_frameCount);
+}
+
+/*
+*/
+const Vector<SPtr<ICommandBuffer>>&
+ParallelCommandRecorder::record(uint32 frameIndex,
+                                const CommandBufferInheritanceInfo& inheritanceInfo,
+                                SIZE_T itemCount,
+                                const RecordFn& fn) {
+  CH_ASSERT(frameIndex < m_frameCount);
+  m_recorded.clear();
+  if (itemCount == 0) {
+    return m_recorded;
+  }
+
+  JobSystem* jobSystem = JobSystem::isStarted() ? JobSystem::instancePtr() : nullptr;
+  const SIZE_T maxSlots = (itemCount + m_minItemsPerSlot - 1) / m_minItemsPerSlot;
+  const SIZE_T slotLimit =
+      jobSystem ? Math::min(static_cast<SIZE_T>(m_slotCount), maxSlots) : 1;
+  const SIZE_T chunkSize = (itemCount + slotLimit - 1) / slotLimit;
+  const uint32 usedSlots = static_cast<uint32>((itemCount + chunkSize - 1) / chunkSize);
+
+  // Pools and buffers are created here so the jobs only record
+  auto& graphicsAPI = IGraphicsAPI::instance();
+  for (uint32 slot = 0; slot < usedSlots; ++slot) {
+    SlotFrame& slotFrame = getSlotFrame(slot, frameIndex);
+    if (!slotFrame.commandPool) {
+      slotFrame.commandPool = graphicsAPI.createCommandPool(QueueType::Graphics, true);
+      slotFrame.commandBuffer =
+          slotFrame.commandPool->allocateCommandBuffer(CommandBufferLevel::Secondary);
+    }
+    m_recorded.push_back(slotFrame.commandBuffer);
+  }
+
+  auto recordSlot = [this, &inheritanceInfo, &fn, frameIndex, itemCount, chunkSize](
+                        uint32 slot) {
+    SlotFrame& slotFrame = getSlotFrame(slot, frameIndex);
+    slotFrame.commandPool->reset();
+
+    const SIZE_T begin = slot * chunkSize;
+    const SIZE_T end = Math::min(begin + chunkSize, itemCount);
+    slotFrame.commandBuffer->beginSecondary(inheritanceInfo);
+    fn(*slotFrame.commandBuffer, begin, end);
+    slotFrame.commandBuffer->end();
+  };
+
+  JobCounter counter;
+  for (uint32 slot = 1; slot < usedSlots; ++slot) {
+    jobSystem->schedule([&recordSlot, slot]() { recordSlot(slot); }, &counter);
+  }
+
+  recordSlot(0);
+  if (jobSystem) {
+    jobSystem->wait(counter);
+  }
+
+  return m_recorded;
+}
+} // namespace chEngineSDK
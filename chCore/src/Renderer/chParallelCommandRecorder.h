@@ -0,0 +1,88 @@
+/************************************************************************/
+/**
+ * @file chParallelCommandRecorder.h
+ * @author AccelMR
+ * @date 2025/08/06
+ * @brief
+ *  Records the draws of a render pass into secondary command buffers on the JobSystem.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGraphicsTypes.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Splits a range of draw items in contiguous chunks and records every chunk into its
+ *     own secondary command buffer from a JobSystem job. Command pools are externally
+ *     synchronized, so every recording slot owns one pool per frame in flight and only
+ *     the job recording that slot touches it. A frame resets its pools when it records
+ *     again, the caller has to wait for that frame's fence first.
+ *
+ *     The secondary buffers are returned in range order, executing them from the primary
+ *     keeps the original draw order. Without a started JobSystem one chunk is recorded
+ *     on the calling thread.
+ *
+ * Sample usage:
+ *  commandBuffer->beginRenderPass({..., .contents = SubpassContents::SecondaryCommandBuffers});
+ *  auto secondaries = recorder.record(frameIndex, {renderPass, framebuffer}, items.size(),
+ *    [&](ICommandBuffer& cmd, SIZE_T begin, SIZE_T end) {
+ *      cmd.bindPipeline(pipeline);
+ *      for (SIZE_T i = begin; i < end; ++i) { drawItem(cmd, items[i]); }
+ *    });
+ *  commandBuffer->executeCommands(secondaries);
+ */
+class CH_CORE_EXPORT ParallelCommandRecorder
+{
+ public:
+  using RecordFn = Function<void(ICommandBuffer&, SIZE_T, SIZE_T)>;
+
+  /**
+   * @param frameCount Frames that can be in flight at the same time
+   * @param minItemsPerSlot Smallest chunk worth a secondary command buffer
+   */
+  ParallelCommandRecorder(uint32 frameCount, SIZE_T minItemsPerSlot);
+
+  /**
+   * Record [0, itemCount) into secondary command buffers for the given frame
+   *
+   * @param fn Called once per chunk with a begun secondary buffer, it has to bind every
+   *        state the draws use.
+   * @return Recorded secondary buffers in range order, valid until frameIndex records again
+   */
+  NODISCARD const Vector<SPtr<ICommandBuffer>>&
+  record(uint32 frameIndex,
+         const CommandBufferInheritanceInfo& inheritanceInfo,
+         SIZE_T itemCount,
+         const RecordFn& fn);
+
+  /**
+   * Recording slots, the worker count of the JobSystem plus the calling thread
+   */
+  NODISCARD FORCEINLINE uint32
+  getSlotCount() const {
+    return m_slotCount;
+  }
+
+ private:
+  struct SlotFrame
+  {
+    SPtr<ICommandPool> commandPool;
+    SPtr<ICommandBuffer> commandBuffer;
+  };
+
+  NODISCARD SlotFrame&
+  getSlotFrame(uint32 slot, uint32 frameIndex) {
+    return m_slotFrames[slot * m_frameCount + frameIndex];
+  }
+
+  Vector<SlotFrame> m_slotFrames;
+  Vector<SPtr<ICommandBuffer>> m_recorded;
+  uint32 m_frameCount = 0;
+  uint32 m_slotCount = 0;
+  SIZE_T m_minItemsPerSlot = 1;
+};
+} // namespace chEngineSDK
@@ -0,0 +1,692 @@
+/************************************************************************/
+/**
+ * @file chRenderGraph.cpp
+ * @author AccelMR
+ * @date 2025/08/09
+ * @brief
+ *  Frame graph of render passes with automatic ordering, barriers and texture reuse.
+ */
+/************************************************************************/
+
+#include "chRenderGraph.h"
+
+#include "chICommandBuffer.h"
+#include "chIGraphicsAPI.h"
+#include "chITexture.h"
+#include "chLogger.h"
+
+namespace chEngineSDK {
+
+#if USING(CH_DEBUG_MODE)
+#define CH_RENDER_GRAPH_LOG_LEVEL All
+#else
+#define CH_RENDER_GRAPH_LOG_LEVEL Info
+#endif
+
+CH_LOG_DECLARE_STATIC(RenderGraphLog, CH_RENDER_GRAPH_LOG_LEVEL);
+
+namespace RenderGraphHelpers {
+struct UsageInfo
+{
+  TextureLayout layout = TextureLayout::Undefined;
+  PipelineStageFlags stages = PipelineStage::None;
+  AccessFlags access = Access::NoAccess;
+  TextureUsageFlags textureUsage = TextureUsage::NoneUsage;
+};
+
+NODISCARD static UsageInfo
+getUsageInfo(RenderGraphUsage usage) {
+  switch (usage) {
+    case RenderGraphUsage::ColorAttachment:
+      return {TextureLayout::ColorAttachment,
+              PipelineStage::ColorAttachmentOutput,
+              Access::ColorAttachmentRead | Access::ColorAttachmentWrite,
+              TextureUsage::ColorAttachment};
+    case RenderGraphUsage::DepthStencilAttachment:
+      return {TextureLayout::DepthStencilAttachment,
+              PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests,
+              Access::DepthStencilAttachmentRead | Access::DepthStencilAttachmentWrite,
+              TextureUsage::DepthStencil};
+    case RenderGraphUsage::DepthStencilRead:
+      return {TextureLayout::DepthStencilReadOnly,
+              PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests |
+                  PipelineStage::FragmentShader,
+              Access::DepthStencilAttachmentRead | Access::ShaderRead,
+              TextureUsage::DepthStencil | TextureUsage::Sampled};
+    case RenderGraphUsage::ShaderRead:
+      return {TextureLayout::ShaderReadOnly,
+              PipelineStage::FragmentShader,
+              Access::ShaderRead,
+              TextureUsage::Sampled};
+    case RenderGraphUsage::TransferSrc:
+      return {TextureLayout::TransferSrc,
+              PipelineStage::Transfer,
+              Access::TransferRead,
+              TextureUsage::TransferSrc};
+    case RenderGraphUsage::TransferDst:
+      return {TextureLayout::TransferDst,
+              PipelineStage::Transfer,
+              Access::TransferWrite,
+              TextureUsage::TransferDst};
+    default:
+      return {};
+  }
+}
+
+/**
+ * Usage a texture needs to be left in a layout after the graph
+ */
+NODISCARD static TextureUsageFlags
+getLayoutUsage(TextureLayout layout) {
+  switch (layout) {
+    case TextureLayout::ColorAttachment:
+      return TextureUsage::ColorAttachment;
+    case TextureLayout::DepthStencilAttachment:
+    case TextureLayout::DepthStencilReadOnly:
+      return TextureUsage::DepthStencil;
+    case TextureLayout::ShaderReadOnly:
+      return TextureUsage::Sampled;
+    case TextureLayout::TransferSrc:
+      return TextureUsage::TransferSrc;
+    case TextureLayout::TransferDst:
+      return TextureUsage::TransferDst;
+    default:
+      return TextureUsage::NoneUsage;
+  }
+}
+
+NODISCARD static bool
+isCompatible(const RenderGraphTextureDesc& a, const RenderGraphTextureDesc& b) {
+  return a.format == b.format && a.width == b.width && a.height == b.height &&
+         a.samples == b.samples;
+}
+} // namespace RenderGraphHelpers
+
+/*
+*/
+RenderGraphHandle
+RenderGraph::PassBuilder::createTexture(const String& name,
+                                        const RenderGraphTextureDesc& desc) {
+  Resource resource;
+  resource.name = name;
+  resource.desc = desc;
+  resource.hasTexture = true;
+  return m_graph.addResource(std::move(resource));
+}
+
+/*
+*/
+RenderGraphHandle
+RenderGraph::PassBuilder::createResource(const String& name) {
+  return m_graph.createResource(name);
+}
+
+/*
+*/
+void
+RenderGraph::PassBuilder::read(RenderGraphHandle handle, RenderGraphUsage usage) {
+  m_graph.addAccess(m_passIndex, handle, usage, false);
+}
+
+/*
+*/
+void
+RenderGraph::PassBuilder::write(RenderGraphHandle handle, RenderGraphUsage usage) {
+  m_graph.addAccess(m_passIndex, handle, usage, true);
+}
+
+/*
+*/
+void
+RenderGraph::PassBuilder::setSideEffect() {
+  m_graph.m_passes[m_passIndex].sideEffect = true;
+}
+
+/*
+*/
+RenderGraph::RenderGraph(uint32 framesInFlight)
+  : m_framesInFlight(Math::max(framesInFlight, 1u)) {}
+
+/*
+*/
+RenderGraphHandle
+RenderGraph::importTexture(const String& name,
+                           const SPtr<ITexture>& texture,
+                           const SPtr<ITextureView>& view,
+                           TextureLayout currentLayout,
+                           TextureLayout finalLayout) {
+  CH_ASSERT(texture != nullptr);
+
+  Resource resource;
+  resource.name = name;
+  resource.desc = {.format = texture->getFormat(),
+                   .width = texture->getWidth(),
+                   .height = texture->getHeight()};
+  resource.hasTexture = true;
+  resource.imported = true;
+  resource.texture = texture;
+  resource.view = view;
+  resource.finalLayout = finalLayout;
+
+  // Nothing is known about the work that used it before, the first barrier waits for all
+  resource.state = {.layout = currentLayout,
+                    .stages = PipelineStage::AllCommands,
+                    .access = Access::MemoryWrite,
+                    .written = true};
+  return addResource(std::move(resource));
+}
+
+/*
+*/
+RenderGraphHandle
+RenderGraph::createResource(const String& name) {
+  Resource resource;
+  resource.name = name;
+  return addResource(std::move(resource));
+}
+
+/*
+*/
+uint32
+RenderGraph::addPass(const String& name, const SetupFn& setup, ExecuteFn execute) {
+  const uint32 passIndex = static_cast<uint32>(m_passes.size());
+  Pass& pass = m_passes.emplace_back();
+  pass.name = name;
+  pass.execute = std::move(execute);
+  m_compiled = false;
+
+  if (setup) {
+    PassBuilder builder(*this, passIndex);
+    setup(builder);
+  }
+  return passIndex;
+}
+
+/*
+*/
+RenderGraph::PassBuilder
+RenderGraph::getPassBuilder(uint32 passIndex) {
+  CH_ASSERT(passIndex < m_passes.size());
+  return PassBuilder(*this, passIndex);
+}
+
+/*
+*/
+void
+RenderGraph::markOutput(RenderGraphHandle handle, TextureLayout finalLayout) {
+  CH_ASSERT(handle < m_resources.size());
+  Resource& resource = m_resources[handle];
+  resource.output = true;
+  resource.finalLayout = finalLayout;
+  if (resource.hasTexture) {
+    resource.usage |= RenderGraphHelpers::getLayoutUsage(finalLayout);
+  }
+  m_compiled = false;
+}
+
+/*
+*/
+bool
+RenderGraph::compile() {
+  m_order.clear();
+  m_finalBarriers.clear();
+  m_finalSrcStages = PipelineStage::None;
+  m_compiled = false;
+
+  cullPasses();
+  if (!sortPasses()) {
+    m_order.clear();
+    return false;
+  }
+
+  assignPhysicalTextures();
+  computeBarriers();
+  m_compiled = true;
+
+  CH_LOG_DEBUG(RenderGraphLog, "Compiled {0} of {1} passes, {2} physical textures",
+               m_order.size(), m_passes.size(), m_physicalTextures.size());
+  return true;
+}
+
+/*
+*/
+void
+RenderGraph::execute(ICommandBuffer& commandBuffer) {
+  CH_ASSERT(m_compiled);
+
+  for (const uint32 passIndex : m_order) {
+    const Pass& pass = m_passes[passIndex];
+    if (!pass.barriers.empty()) {
+      commandBuffer.pipelineBarrier(pass.srcStages, pass.dstStages, pass.barriers);
+    }
+    if (pass.execute) {
+      pass.execute(commandBuffer);
+    }
+  }
+
+  if (!m_finalBarriers.empty()) {
+    commandBuffer.pipelineBarrier(m_finalSrcStages, PipelineStage::AllCommands,
+                                  m_finalBarriers);
+  }
+}
+
+/*
+*/
+void
+RenderGraph::reset() {
+  m_passes.clear();
+  m_resources.clear();
+  m_order.clear();
+  m_finalBarriers.clear();
+  m_finalSrcStages = PipelineStage::None;
+  m_compiled = false;
+}
+
+/*
+*/
+void
+RenderGraph::clear() {
+  reset();
+  m_physicalTextures.clear();
+}
+
+/*
+*/
+const SPtr<ITexture>&
+RenderGraph::getTexture(RenderGraphHandle handle) const {
+  CH_ASSERT(handle < m_resources.size());
+  return m_resources[handle].texture;
+}
+
+/*
+*/
+const SPtr<ITextureView>&
+RenderGraph::getTextureView(RenderGraphHandle handle) const {
+  CH_ASSERT(handle < m_resources.size());
+  return m_resources[handle].view;
+}
+
+/*
+*/
+TextureLayout
+RenderGraph::getFinalLayout(RenderGraphHandle handle) const {
+  CH_ASSERT(handle < m_resources.size());
+  return getState(m_resources[handle]).layout;
+}
+
+/*
+*/
+bool
+RenderGraph::isPassCulled(uint32 passIndex) const {
+  CH_ASSERT(passIndex < m_passes.size());
+  return !m_passes[passIndex].alive;
+}
+
+/*
+*/
+RenderGraphHandle
+RenderGraph::addResource(Resource&& resource) {
+  m_resources.push_back(std::move(resource));
+  m_compiled = false;
+  return static_cast<RenderGraphHandle>(m_resources.size() - 1);
+}
+
+/*
+*/
+void
+RenderGraph::addAccess(uint32 passIndex,
+                       RenderGraphHandle handle,
+                       RenderGraphUsage usage,
+                       bool write) {
+  CH_ASSERT(passIndex < m_passes.size());
+  CH_ASSERT(handle < m_resources.size());
+  m_compiled = false;
+
+  Resource& resource = m_resources[handle];
+  if (!resource.hasTexture) {
+    usage = RenderGraphUsage::None;
+  }
+  resource.usage |= RenderGraphHelpers::getUsageInfo(usage).textureUsage;
+
+  Vector<uint32>& passes = write ? resource.writers : resource.readers;
+  if (passes.empty() || passes.back() != passIndex) {
+    passes.push_back(passIndex);
+  }
+
+  // A pass touches a resource once, reading and writing it is a read-modify-write
+  Pass& pass = m_passes[passIndex];
+  for (auto& access : pass.accesses) {
+    if (access.handle != handle) {
+      continue;
+    }
+    access.read |= !write;
+    access.write |= write;
+    if (write || access.usage == RenderGraphUsage::None) {
+      access.usage = usage;
+    }
+    return;
+  }
+
+  pass.accesses.push_back({.handle = handle, .usage = usage, .read = !write, .write = write});
+}
+
+/*
+*/
+bool
+RenderGraph::readsFrom(const Resource& resource, uint32 reader, uint32 writer) const {
+  if (writer == reader) {
+    return false;
+  }
+  if (writer < reader) {
+    return true;
+  }
+  return std::none_of(resource.writers.begin(), resource.writers.end(),
+                      [reader](uint32 other) { return other < reader; });
+}
+
+/*
+*/
+void
+RenderGraph::cullPasses() {
+  Vector<uint32> alivePasses;
+  for (uint32 passIndex = 0; passIndex < m_passes.size(); ++passIndex) {
+    Pass& pass = m_passes[passIndex];
+    pass.alive = pass.sideEffect;
+    for (const auto& access : pass.accesses) {
+      const Resource& resource = m_resources[access.handle];
+      if (access.write && (resource.imported || resource.output)) {
+        pass.alive = true;
+      }
+    }
+    if (pass.alive) {
+      alivePasses.push_back(passIndex);
+    }
+  }
+
+  // Whatever an alive pass reads keeps the writers it reads from alive
+  while (!alivePasses.empty()) {
+    const uint32 passIndex = alivePasses.back();
+    alivePasses.pop_back();
+
+    for (const auto& access : m_passes[passIndex].accesses) {
+      if (!access.read) {
+        continue;
+      }
+      const Resource& resource = m_resources[access.handle];
+      for (const uint32 writer : resource.writers) {
+        if (readsFrom(resource, passIndex, writer) && !m_passes[writer].alive) {
+          m_passes[writer].alive = true;
+          alivePasses.push_back(writer);
+        }
+      }
+    }
+  }
+}
+
+/*
+*/
+bool
+RenderGraph::sortPasses() {
+  const SIZE_T passCount = m_passes.size();
+  Vector<Vector<uint32>> successors(passCount);
+  Vector<uint32> predecessorCount(passCount, 0);
+  auto addEdge = [&](uint32 from, uint32 to) {
+    successors[from].push_back(to);
+    ++predecessorCount[to];
+  };
+
+  for (const auto& resource : m_resources) {
+    uint32 previousWriter = INVALID_HANDLE;
+    for (const uint32 writer : resource.writers) {
+      if (!m_passes[writer].alive) {
+        continue;
+      }
+      if (previousWriter != INVALID_HANDLE) {
+        addEdge(previousWriter, writer);
+      }
+      previousWriter = writer;
+    }
+
+    for (const uint32 reader : resource.readers) {
+      const bool isWriter = std::find(resource.writers.begin(), resource.writers.end(),
+                                      reader) != resource.writers.end();
+      if (!m_passes[reader].alive || isWriter) {
+        continue;
+      }
+
+      // Writers the reader doesn't read from wait for it, write after read
+      for (const uint32 writer : resource.writers) {
+        if (!m_passes[writer].alive) {
+          continue;
+        }
+        if (readsFrom(resource, reader, writer)) {
+          addEdge(writer, reader);
+        }
+        else {
+          addEdge(reader, writer);
+        }
+      }
+    }
+  }
+
+  // The few passes of a frame make the quadratic pick of the lowest ready index cheap, it
+  // keeps the order passes were added in whenever dependencies allow it
+  SIZE_T aliveCount = 0;
+  Vector<bool> emitted(passCount, false);
+  for (SIZE_T passIndex = 0; passIndex < passCount; ++passIndex) {
+    aliveCount += m_passes[passIndex].alive ? 1 : 0;
+  }
+
+  while (m_order.size() < aliveCount) {
+    uint32 ready = INVALID_HANDLE;
+    for (uint32 passIndex = 0; passIndex < passCount; ++passIndex) {
+      if (m_passes[passIndex].alive && !emitted[passIndex] &&
+          predecessorCount[passIndex] == 0) {
+        ready = passIndex;
+        break;
+      }
+    }
+
+    if (ready == INVALID_HANDLE) {
+      for (uint32 passIndex = 0; passIndex < passCount; ++passIndex) {
+        if (m_passes[passIndex].alive && !emitted[passIndex]) {
+          CH_LOG_ERROR(RenderGraphLog, "Render pass '{0}' is part of a dependency cycle",
+                       m_passes[passIndex].name);
+        }
+      }
+      return false;
+    }
+
+    emitted[ready] = true;
+    m_order.push_back(ready);
+    for (const uint32 successor : successors[ready]) {
+      --predecessorCount[successor];
+    }
+  }
+
+  return true;
+}
+
+/*
+*/
+void
+RenderGraph::assignPhysicalTextures() {
+  // Textures no compile handed out since the frames that used them finished
+  std::erase_if(m_physicalTextures, [this](const PhysicalTexture& physical) {
+    return physical.idleCompiles >= m_framesInFlight;
+  });
+  for (auto& physical : m_physicalTextures) {
+    physical.busyUntil = INVALID_HANDLE;
+  }
+
+  const uint32 frameEnd = static_cast<uint32>(m_order.size());
+  for (uint32 position = 0; position < frameEnd; ++position) {
+    for (const auto& access : m_passes[m_order[position]].accesses) {
+      Resource& resource = m_resources[access.handle];
+      resource.firstUse = Math::min(resource.firstUse, position);
+      resource.lastUse = Math::max(resource.lastUse, position);
+    }
+  }
+
+  Vector<RenderGraphHandle> transients;
+  for (RenderGraphHandle handle = 0; handle < m_resources.size(); ++handle) {
+    Resource& resource = m_resources[handle];
+    if (!resource.hasTexture || resource.imported || resource.firstUse == INVALID_HANDLE) {
+      continue;
+    }
+    if (resource.writers.empty()) {
+      CH_LOG_WARNING(RenderGraphLog, "Texture '{0}' is read but never written",
+                     resource.name);
+    }
+    if (resource.output) {
+      resource.lastUse = frameEnd;
+    }
+    transients.push_back(handle);
+  }
+
+  std::stable_sort(transients.begin(), transients.end(),
+                   [this](RenderGraphHandle a, RenderGraphHandle b) {
+                     return m_resources[a].firstUse < m_resources[b].firstUse;
+                   });
+
+  for (const RenderGraphHandle handle : transients) {
+    Resource& resource = m_resources[handle];
+    resource.physicalIndex = acquirePhysicalTexture(resource, resource.firstUse);
+
+    PhysicalTexture& physical = m_physicalTextures[resource.physicalIndex];
+    physical.busyUntil = resource.lastUse;
+    physical.idleCompiles = 0;
+    resource.texture = physical.texture;
+    resource.view = physical.view;
+  }
+
+  for (auto& physical : m_physicalTextures) {
+    if (physical.busyUntil == INVALID_HANDLE) {
+      ++physical.idleCompiles;
+    }
+  }
+}
+
+/*
+*/
+uint32
+RenderGraph::acquirePhysicalTexture(const Resource& resource, uint32 position) {
+  for (uint32 index = 0; index < m_physicalTextures.size(); ++index) {
+    const PhysicalTexture& physical = m_physicalTextures[index];
+    const bool isFree = physical.busyUntil == INVALID_HANDLE || physical.busyUntil < position;
+    if (isFree && RenderGraphHelpers::isCompatible(physical.desc, resource.desc) &&
+        (physical.usage & resource.usage) == resource.usage) {
+      return index;
+    }
+  }
+
+  TextureCreateInfo createInfo{.type = TextureType::Texture2D,
+                               .format = resource.desc.format,
+                               .width = resource.desc.width,
+                               .height = resource.desc.height,
+                               .samples = resource.desc.samples,
+                               .usage = resource.usage};
+  PhysicalTexture physical;
+  physical.desc = resource.desc;
+  physical.usage = resource.usage;
+  physical.texture = IGraphicsAPI::instance().createTexture(createInfo);
+  physical.view =
+      physical.texture->createView({.format = resource.desc.format,
+                                    .viewType = TextureViewType::View2D,
+                                    .bIsDepthStencil = isDepthFormat(resource.desc.format)});
+
+  CH_LOG_DEBUG(RenderGraphLog, "Created physical texture {0} for '{1}' ({2}x{3})",
+               m_physicalTextures.size(), resource.name, resource.desc.width,
+               resource.desc.height);
+
+  m_physicalTextures.push_back(std::move(physical));
+  return static_cast<uint32>(m_physicalTextures.size() - 1);
+}
+
+/*
+*/
+void
+RenderGraph::computeBarriers() {
+  for (uint32 position = 0; position < m_order.size(); ++position) {
+    Pass& pass = m_passes[m_order[position]];
+    pass.barriers.clear();
+    pass.srcStages = PipelineStage::None;
+    pass.dstStages = PipelineStage::None;
+
+    for (const auto& access : pass.accesses) {
+      Resource& resource = m_resources[access.handle];
+      if (!resource.hasTexture) {
+        continue;
+      }
+
+      const RenderGraphHelpers::UsageInfo usage =
+          RenderGraphHelpers::getUsageInfo(access.usage);
+      TextureState& state = getState(resource);
+
+      // A transient starts undefined, even when its texture was used by another resource
+      const bool discard = !resource.imported && resource.firstUse == position;
+      const TextureLayout oldLayout = discard ? TextureLayout::Undefined : state.layout;
+      if (!discard && !access.write && !state.written && oldLayout == usage.layout) {
+        // Reads after reads only widen the stages the next write has to wait for
+        state.stages |= usage.stages;
+        continue;
+      }
+
+      pass.srcStages |= state.stages;
+      pass.dstStages |= usage.stages;
+      pass.barriers.push_back({.texture = resource.texture,
+                               .oldLayout = oldLayout,
+                               .newLayout = usage.layout,
+                               .srcAccess = state.written ? state.access : Access::NoAccess,
+                               .dstAccess = usage.access});
+
+      state = {.layout = usage.layout,
+               .stages = usage.stages,
+               .access = usage.access,
+               .written = access.write};
+    }
+  }
+
+  for (auto& resource : m_resources) {
+    if (!resource.texture || resource.finalLayout == TextureLayout::Undefined) {
+      continue;
+    }
+
+    TextureState& state = getState(resource);
+    if (state.layout == resource.finalLayout) {
+      continue;
+    }
+
+    m_finalSrcStages |= state.stages;
+    m_finalBarriers.push_back({.texture = resource.texture,
+                               .oldLayout = state.layout,
+                               .newLayout = resource.finalLayout,
+                               .srcAccess = state.written ? state.access : Access::NoAccess,
+                               .dstAccess = Access::MemoryRead | Access::MemoryWrite});
+    state = {.layout = resource.finalLayout,
+             .stages = PipelineStage::AllCommands,
+             .access = Access::MemoryRead | Access::MemoryWrite,
+             .written = true};
+  }
+}
+
+/*
+*/
+RenderGraph::TextureState&
+RenderGraph::getState(Resource& resource) {
+  if (resource.physicalIndex != INVALID_HANDLE) {
+    return m_physicalTextures[resource.physicalIndex].state;
+  }
+  return resource.state;
+}
+
+/*
+*/
+const RenderGraph::TextureState&
+RenderGraph::getState(const Resource& resource) const {
+  if (resource.physicalIndex != INVALID_HANDLE) {
+    return m_physicalTextures[resource.physicalIndex].state;
+  }
+  return resource.state;
+}
+} // namespace chEngineSDK
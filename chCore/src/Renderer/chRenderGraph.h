@@ -0,0 +1,372 @@
+/************************************************************************/
+/**
+ * @file chRenderGraph.h
+ * @author AccelMR
+ * @date 2025/08/09
+ * @brief
+ *  Frame graph of render passes with automatic ordering, barriers and texture reuse.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGraphicsTypes.h"
+
+namespace chEngineSDK {
+using RenderGraphHandle = uint32;
+
+/**
+ * How a pass touches a resource, decides the layout and the pipeline stages of the barriers
+ */
+enum class RenderGraphUsage : uint8 {
+  None,                   ///< Ordering only, the only usage of resources without texture
+  ColorAttachment,
+  DepthStencilAttachment,
+  DepthStencilRead,       ///< Depth test without writes or depth sampled in fragment shaders
+  ShaderRead,             ///< Sampled in fragment shaders
+  TransferSrc,
+  TransferDst
+};
+
+/**
+ * Texture created and owned by the graph, it only lives between its first and last use
+ */
+struct RenderGraphTextureDesc {
+  Format format = Format::R8G8B8A8_UNORM;
+  uint32 width = 1;
+  uint32 height = 1;
+  SampleCount samples = SampleCount::Count1;
+};
+
+/*
+ * Description:
+ *     Passes are added every frame with the resources they read and write, compile then
+ *     works out the frame from those declarations:
+ *
+ *     - Culling: only passes with side effects, passes writing an imported texture or an
+ *       output, and the passes whose writes they read are kept.
+ *     - Ordering: writers of the same resource keep the order they were added in. A reader
+ *       runs after the writers added before it and before the ones added after it, so a
+ *       later write never lands under an earlier read. A reader added before every writer
+ *       waits for all of them, passes may be declared in any order. Passes are sorted
+ *       topologically and otherwise keep the order they were added in, cycles make
+ *       compile fail.
+ *     - Barriers: the layout, stages and accesses of every texture are tracked through the
+ *       sorted passes, one pipelineBarrier with every transition and hazard is recorded
+ *       before each pass that needs it. Render passes used inside a pass must keep their
+ *       attachments in the layout of the declared usage, initial and final layout alike.
+ *     - Aliasing: transient textures whose lifetimes don't overlap share one physical
+ *       texture when format, size and sample count match. Physical textures outlive the
+ *       frame and are handed out again on the next compile, the ones no compile used for
+ *       framesInFlight frames are released.
+ *
+ *     Not thread safe. Passes record into the command buffer given to execute, in order.
+ *
+ * Sample usage:
+ *  graph.reset();
+ *  RenderGraphHandle backBuffer = graph.importTexture("BackBuffer", texture, view,
+ *                                                     TextureLayout::Undefined,
+ *                                                     TextureLayout::PresentSrc);
+ *  RenderGraphHandle albedo;
+ *  graph.addPass("GBuffer", [&](RenderGraph::PassBuilder& builder) {
+ *    albedo = builder.createTexture("Albedo", {Format::R8G8B8A8_UNORM, width, height});
+ *    builder.write(albedo, RenderGraphUsage::ColorAttachment);
+ *  }, [&](ICommandBuffer& cmd) { drawGBuffer(cmd, graph.getTextureView(albedo)); });
+ *  graph.addPass("Lighting", [&](RenderGraph::PassBuilder& builder) {
+ *    builder.read(albedo, RenderGraphUsage::ShaderRead);
+ *    builder.write(backBuffer, RenderGraphUsage::ColorAttachment);
+ *  }, [&](ICommandBuffer& cmd) { drawLighting(cmd); });
+ *  if (graph.compile()) {
+ *    graph.execute(*commandBuffer);
+ *  }
+ */
+class CH_CORE_EXPORT RenderGraph
+{
+ public:
+  static constexpr RenderGraphHandle INVALID_HANDLE = ~0u;
+
+  /**
+   * Declares the resources of one pass, only valid during its setup or through
+   * getPassBuilder before compile.
+   */
+  class CH_CORE_EXPORT PassBuilder
+  {
+   public:
+    /**
+     * Create a transient texture, its usage flags come from how the passes use it
+     */
+    RenderGraphHandle
+    createTexture(const String& name, const RenderGraphTextureDesc& desc);
+
+    /**
+     * Create a resource without texture, only used to order passes
+     */
+    RenderGraphHandle
+    createResource(const String& name);
+
+    void
+    read(RenderGraphHandle handle, RenderGraphUsage usage = RenderGraphUsage::ShaderRead);
+
+    void
+    write(RenderGraphHandle handle,
+          RenderGraphUsage usage = RenderGraphUsage::ColorAttachment);
+
+    /**
+     * Never cull the pass, for work visible outside of the graph
+     */
+    void
+    setSideEffect();
+
+    NODISCARD FORCEINLINE RenderGraph&
+    getGraph() const {
+      return m_graph;
+    }
+
+   private:
+    friend class RenderGraph;
+
+    PassBuilder(RenderGraph& graph, uint32 passIndex)
+      : m_graph(graph),
+        m_passIndex(passIndex) {}
+
+    RenderGraph& m_graph;
+    uint32 m_passIndex = 0;
+  };
+
+  using SetupFn = Function<void(PassBuilder&)>;
+  using ExecuteFn = Function<void(ICommandBuffer&)>;
+
+  /**
+   * @param framesInFlight Frames a physical texture may still be used by the GPU after the
+   *        last compile that handed it out
+   */
+  explicit RenderGraph(uint32 framesInFlight = 1);
+
+  /**
+   * Add a texture owned by someone else, it is never aliased
+   *
+   * @param currentLayout Layout the texture is in when the graph executes
+   * @param finalLayout Layout to leave it in, Undefined keeps the one of its last use
+   */
+  RenderGraphHandle
+  importTexture(const String& name,
+                const SPtr<ITexture>& texture,
+                const SPtr<ITextureView>& view,
+                TextureLayout currentLayout,
+                TextureLayout finalLayout = TextureLayout::Undefined);
+
+  /**
+   * Create a resource without texture outside of a pass
+   */
+  RenderGraphHandle
+  createResource(const String& name);
+
+  /**
+   * Add a pass, setup is called right away to declare its resources
+   *
+   * @return Index of the pass
+   */
+  uint32
+  addPass(const String& name, const SetupFn& setup, ExecuteFn execute);
+
+  /**
+   * Declare more resources of a pass after it was added
+   */
+  NODISCARD PassBuilder
+  getPassBuilder(uint32 passIndex);
+
+  /**
+   * Keep the writers of a resource and the texture behind it alive until the end of the
+   * frame, for results read after execute
+   *
+   * @param finalLayout Layout to leave the texture in, Undefined keeps the one of its last use
+   */
+  void
+  markOutput(RenderGraphHandle handle, TextureLayout finalLayout = TextureLayout::Undefined);
+
+  /**
+   * Cull, sort, place the transient textures and compute the barriers
+   *
+   * @return False if the passes depend on each other in a cycle
+   */
+  NODISCARD bool
+  compile();
+
+  /**
+   * Record the compiled passes with their barriers
+   */
+  void
+  execute(ICommandBuffer& commandBuffer);
+
+  /**
+   * Remove every pass and resource to build the next frame, physical textures are kept
+   */
+  void
+  reset();
+
+  /**
+   * Reset and release every physical texture, the GPU must be done with them
+   */
+  void
+  clear();
+
+  /**
+   * Texture behind a resource, nullptr before compile for transient textures
+   */
+  NODISCARD const SPtr<ITexture>&
+  getTexture(RenderGraphHandle handle) const;
+
+  NODISCARD const SPtr<ITextureView>&
+  getTextureView(RenderGraphHandle handle) const;
+
+  /**
+   * Layout a texture is left in once execute recorded every pass
+   */
+  NODISCARD TextureLayout
+  getFinalLayout(RenderGraphHandle handle) const;
+
+  NODISCARD bool
+  isPassCulled(uint32 passIndex) const;
+
+  NODISCARD FORCEINLINE uint32
+  getPassCount() const {
+    return static_cast<uint32>(m_passes.size());
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getExecutedPassCount() const {
+    return static_cast<uint32>(m_order.size());
+  }
+
+  /**
+   * Indices of the passes execute records, in order, after a successful compile
+   */
+  NODISCARD FORCEINLINE const Vector<uint32>&
+  getExecutionOrder() const {
+    return m_order;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getPhysicalTextureCount() const {
+    return static_cast<uint32>(m_physicalTextures.size());
+  }
+
+ private:
+  struct ResourceAccess
+  {
+    RenderGraphHandle handle = INVALID_HANDLE;
+    RenderGraphUsage usage = RenderGraphUsage::None;
+    bool read = false;
+    bool write = false;
+  };
+
+  struct Pass
+  {
+    String name;
+    ExecuteFn execute;
+    Vector<ResourceAccess> accesses;
+    bool sideEffect = false;
+    bool alive = false;
+
+    PipelineStageFlags srcStages = PipelineStage::None;
+    PipelineStageFlags dstStages = PipelineStage::None;
+    Vector<TextureBarrier> barriers;
+  };
+
+  /**
+   * What the GPU last did with a texture
+   */
+  struct TextureState
+  {
+    TextureLayout layout = TextureLayout::Undefined;
+    PipelineStageFlags stages = PipelineStage::None;
+    AccessFlags access = Access::NoAccess;
+    bool written = false;
+  };
+
+  struct Resource
+  {
+    String name;
+    RenderGraphTextureDesc desc;
+    TextureUsageFlags usage = TextureUsage::NoneUsage;
+    bool hasTexture = false;
+    bool imported = false;
+    bool output = false;
+
+    SPtr<ITexture> texture;
+    SPtr<ITextureView> view;
+    TextureLayout finalLayout = TextureLayout::Undefined;
+    TextureState state;
+
+    Vector<uint32> writers;
+    Vector<uint32> readers;
+    uint32 physicalIndex = INVALID_HANDLE;
+    uint32 firstUse = INVALID_HANDLE;
+    uint32 lastUse = 0;
+  };
+
+  struct PhysicalTexture
+  {
+    RenderGraphTextureDesc desc;
+    TextureUsageFlags usage = TextureUsage::NoneUsage;
+    SPtr<ITexture> texture;
+    SPtr<ITextureView> view;
+    TextureState state;
+    uint32 busyUntil = INVALID_HANDLE; ///< Sorted position of the last use this frame
+    uint32 idleCompiles = 0;
+  };
+
+  RenderGraphHandle
+  addResource(Resource&& resource);
+
+  void
+  addAccess(uint32 passIndex, RenderGraphHandle handle, RenderGraphUsage usage, bool write);
+
+  /**
+   * Whether a pass reading the resource sees what the writer wrote: the writers added
+   *   before the reader do, or every writer if none was added before it
+   */
+  NODISCARD bool
+  readsFrom(const Resource& resource, uint32 reader, uint32 writer) const;
+
+  void
+  cullPasses();
+
+  NODISCARD bool
+  sortPasses();
+
+  void
+  assignPhysicalTextures();
+
+  void
+  computeBarriers();
+
+  /**
+   * Physical texture for a transient resource whose lifetime starts at position
+   */
+  NODISCARD uint32
+  acquirePhysicalTexture(const Resource& resource, uint32 position);
+
+  /**
+   * State of the texture behind a resource, shared by every resource aliasing it
+   */
+  NODISCARD TextureState&
+  getState(Resource& resource);
+
+  NODISCARD const TextureState&
+  getState(const Resource& resource) const;
+
+  Vector<Pass> m_passes;
+  Vector<Resource> m_resources;
+  Vector<uint32> m_order;
+  Vector<PhysicalTexture> m_physicalTextures;
+
+  // Imported textures and outputs moved to their final layout after the last pass
+  Vector<TextureBarrier> m_finalBarriers;
+  PipelineStageFlags m_finalSrcStages = PipelineStage::None;
+
+  uint32 m_framesInFlight = 1;
+  bool m_compiled = false;
+};
+} // namespace chEngineSDK
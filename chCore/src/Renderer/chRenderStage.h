@@ -9,6 +9,7 @@
 #pragma once
 
 #include "chPrerequisitesCore.h"
+#include "chRenderGraph.h"
 #include "chRenderStageIO.h"
 
 namespace chEngineSDK {
@@ -43,6 +44,18 @@ class CH_CORE_EXPORT IRenderStage
   virtual void
   initialize(uint32 width, uint32 height) = 0;
 
+  /**
+   * @brief Declare the graph resources the stage writes, called once per frame
+   * @param builder Builder of the pass recording this stage
+   * @param outputResources Graph resource written for each provided output type. Provided
+   *        types left out are tracked as resources without texture
+   * @note Every required input type is read by the pass as a sampled texture when its
+   *       producer wrote one. Views of transient textures are only valid during execute.
+   */
+  virtual void
+  setupGraph(RenderGraph::PassBuilder& /*builder*/,
+             Map<UUID, RenderGraphHandle>& /*outputResources*/) {}
+
   /**
    * @brief Execute the render stage
    * @param inputs Type-safe input data from previous stages
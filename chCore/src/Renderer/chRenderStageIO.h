@@ -58,6 +58,20 @@ public:
     return std::static_pointer_cast<T>(it->second);
   }
 
+  /**
+   * @brief Get data by its type ID
+   * @param typeId Type ID of the data
+   * @return Shared pointer to the data, or nullptr if not found
+   */
+  SPtr<RenderStageData> getData(const UUID& typeId) const {
+    auto it = m_data.find(typeId);
+    if (it == m_data.end()) {
+      return nullptr;
+    }
+
+    return it->second;
+  }
+
   /**
    * @brief Check if input data exists and is valid
    * @tparam T The data type to check
@@ -69,6 +83,16 @@ public:
     return input && input->isValid();
   }
 
+  /**
+   * @brief Add all data of another container, replacing the types both have
+   * @param other Container to copy the data from
+   */
+  void merge(const RenderStageIO& other) {
+    for (const auto& [typeId, data] : other.m_data) {
+      m_data[typeId] = data;
+    }
+  }
+
   /**
    * @brief Clear all data
    */
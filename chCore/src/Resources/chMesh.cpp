@@ -10,52 +10,162 @@
 
 #include "chMesh.h"
 
+#include <numeric>
+
 namespace chEngineSDK {
 /*
 */
 NODISCARD Vector<Vector3> 
 Mesh::extractPositions() const {
-  if (!hasVertexData() || m_vertexCount == 0) {
+  const PositionView view = getPositionView();
+  if (view.count == 0) {
     return {};
   }
-  
-  bool foundPosition = false;
-  uint32 positionOffset = 0;
-  VertexFormat positionFormat = VertexFormat::Float3;
-  
-  for (const auto& attr : m_vertexLayout.getAttributes()) {
-    if (attr.type == VertexAttributeType::Position) {
-      positionOffset = attr.offset;
-      positionFormat = attr.format;
-      foundPosition = true;
-      break;
-    }
+
+  Vector<Vector3> positions;
+  positions.reserve(view.count);
+
+  for (uint32 i = 0; i < view.count; ++i) {
+    const float* posFloat = view.at(i);
+    const float z = view.components == 3 ? posFloat[2] : 0.0f;
+    positions.emplace_back(posFloat[0], posFloat[1], z);
   }
-  
-  if (!foundPosition) {
-    return {};
+
+  return positions;
+}
+
+/*
+*/
+Mesh::PositionView
+Mesh::getPositionView() const {
+  PositionView view;
+  if (!hasVertexData() || m_vertexCount == 0) {
+    return view;
   }
-  
-  Vector<Vector3> positions;
-  positions.reserve(m_vertexCount);
-  
-  uint32 vertexStride = m_vertexLayout.getVertexSize();
-  
-  for (uint32 i = 0; i < m_vertexCount; ++i) {
-    const uint8* vertexPtr = m_vertexData.data() + (i * vertexStride) + positionOffset;
-    
-    Vector3 position;
-    if (positionFormat == VertexFormat::Float3) {
-      const float* posFloat = reinterpret_cast<const float*>(vertexPtr);
-      position = Vector3(posFloat[0], posFloat[1], posFloat[2]);
+
+  for (const auto& attr : m_vertexLayout.getAttributes()) {
+    if (attr.type != VertexAttributeType::Position) {
+      continue;
+    }
+
+    if (attr.format == VertexFormat::Float3 || attr.format == VertexFormat::Float4) {
+      view.components = 3;
+    }
+    else if (attr.format == VertexFormat::Float2) {
+      view.components = 2;
     }
-    else if (positionFormat == VertexFormat::Float2) {
-      const float* posFloat = reinterpret_cast<const float*>(vertexPtr);
-      position = Vector3(posFloat[0], posFloat[1], 0.0f);
+    else {
+      return view;
     }
-    positions.push_back(position);
+
+    view.stride = m_vertexLayout.getVertexSize();
+    const SIZE_T lastPosition = static_cast<SIZE_T>(m_vertexCount - 1) * view.stride +
+                                attr.offset + view.components * sizeof(float);
+    if (lastPosition > m_vertexData.size()) {
+      view.components = 0;
+      return view;
+    }
+
+    view.data = m_vertexData.data() + attr.offset;
+    view.count = m_vertexCount;
+    return view;
+  }
+
+  return view;
+}
+
+/*
+ * Overdraw sorting goes after the cache pass because it reorders the cache friendly
+ * clusters, the fetch remap goes last since it follows the final triangle order.
+ */
+MeshOptimizationStats
+Mesh::optimize() {
+  MeshOptimizationStats stats;
+  stats.verticesBefore = m_vertexCount;
+  stats.verticesAfter = m_vertexCount;
+
+  const uint32 stride = m_vertexLayout.getVertexSize();
+  if (m_vertexCount == 0 || stride == 0 ||
+      m_vertexData.size() != static_cast<SIZE_T>(m_vertexCount) * stride) {
+    return stats;
+  }
+
+  Vector<uint32> indices;
+  if (!hasIndexData()) {
+    indices.resize(m_vertexCount);
+    std::iota(indices.begin(), indices.end(), 0);
+  }
+  else if (m_indexType == IndexType::UInt16) {
+    const Vector<uint16> indices16 = getIndicesAsUInt16();
+    indices.assign(indices16.begin(), indices16.end());
+  }
+  else {
+    indices = getIndicesAsUInt32();
+  }
+
+  const bool validIndices = std::all_of(indices.begin(), indices.end(),
+                                        [this](uint32 index) { return index < m_vertexCount; });
+  if (indices.empty() || indices.size() % 3 != 0 || !validIndices) {
+    return stats;
+  }
+
+  stats.before = MeshOptimizer::analyzeVertexCache(indices, m_vertexCount);
+
+  Vector<uint32> remap;
+  uint32 vertexCount = MeshOptimizer::generateVertexRemap(indices, m_vertexData.data(),
+                                                          m_vertexCount, stride, remap);
+  MeshOptimizer::remapIndices(indices, remap);
+  m_vertexData = MeshOptimizer::remapVertices(m_vertexData.data(), m_vertexCount, stride,
+                                              remap, vertexCount);
+  m_vertexCount = vertexCount;
+
+  MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+
+  const PositionView positions = getPositionView();
+  if (positions.components == 3) {
+    MeshOptimizer::optimizeOverdraw(indices, positions.data, positions.stride, vertexCount);
+  }
+
+  vertexCount = MeshOptimizer::generateVertexFetchRemap(indices, vertexCount, remap);
+  MeshOptimizer::remapIndices(indices, remap);
+  m_vertexData = MeshOptimizer::remapVertices(m_vertexData.data(), m_vertexCount, stride,
+                                              remap, vertexCount);
+  m_vertexCount = vertexCount;
+
+  if (vertexCount <= std::numeric_limits<uint16>::max()) {
+    Vector<uint16> indices16(indices.size());
+    std::transform(indices.begin(), indices.end(), indices16.begin(),
+                   [](uint32 index) { return static_cast<uint16>(index); });
+    setIndexData(indices16);
+  }
+  else {
+    setIndexData(indices);
+  }
+
+  // Unreferenced vertices are gone, they may have been part of the old bounds
+  updateLocalBounds();
+
+  stats.after = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+  stats.verticesAfter = vertexCount;
+  return stats;
+}
+
+/*
+*/
+void
+Mesh::updateLocalBounds() {
+  const PositionView view = getPositionView();
+  if (view.count == 0) {
+    m_localBounds = AABox(Vector3::ZERO, Vector3::ZERO);
+    return;
+  }
+
+  const float* first = view.at(0);
+  const Vector3 firstPoint(first[0], first[1], view.components == 3 ? first[2] : 0.0f);
+  m_localBounds = AABox(firstPoint, firstPoint);
+  for (uint32 i = 1; i < view.count; ++i) {
+    const float* p = view.at(i);
+    m_localBounds += Vector3(p[0], p[1], view.components == 3 ? p[2] : 0.0f);
   }
-  
-  return positions;
 }
-} // namespace chEngineSDK
\ No newline at end of file
+} // namespace chEngineSDK
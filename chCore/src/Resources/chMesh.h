@@ -11,10 +11,23 @@
 
 #include "chPrerequisitesCore.h"
 
+#include "chBox.h"
 #include "chGraphicsTypes.h"
+#include "chMeshOptimizer.h"
 #include "chVertexLayout.h"
 
 namespace chEngineSDK {
+/**
+ * Result of Mesh::optimize, cache statistics use MeshOptimizer::DEFAULT_CACHE_SIZE
+ */
+struct MeshOptimizationStats
+{
+  VertexCacheStats before;
+  VertexCacheStats after;
+  uint32 verticesBefore = 0;
+  uint32 verticesAfter = 0;
+};
+
 /**
  * Class to store mesh data.
  * This is a simple data structure without much functionality.
@@ -23,6 +36,22 @@ namespace chEngineSDK {
 class CH_CORE_EXPORT Mesh
 {
  public:
+  /**
+   * Strided view of the vertex positions inside the raw vertex data
+   */
+  struct PositionView
+  {
+    NODISCARD FORCEINLINE const float*
+    at(uint32 index) const {
+      return reinterpret_cast<const float*>(data + static_cast<SIZE_T>(index) * stride);
+    }
+
+    const uint8* data = nullptr;
+    uint32 stride = 0;
+    uint32 count = 0;
+    uint32 components = 0; ///< 3 for Float3 positions, 2 for Float2 (z is zero)
+  };
+
   Mesh() = default;
   ~Mesh() = default;
 
@@ -42,6 +71,7 @@ class CH_CORE_EXPORT Mesh
       std::memcpy(m_vertexData.data(), vertices.data(), size);
     }
     m_vertexLayout = T::getLayout();
+    updateLocalBounds();
   }
 
   /**
@@ -70,7 +100,10 @@ class CH_CORE_EXPORT Mesh
    * @param layout Vertex layout
   */
   FORCEINLINE void
-  setVertexLayout(const VertexLayout& layout) { m_vertexLayout = layout; }
+  setVertexLayout(const VertexLayout& layout) {
+    m_vertexLayout = layout;
+    updateLocalBounds();
+  }
 
   /**
    * Get raw vertex data
@@ -84,6 +117,7 @@ class CH_CORE_EXPORT Mesh
   setVertexData(const Vector<uint8>& data, uint32 vertexCount) {
     m_vertexData = data;
     m_vertexCount = vertexCount;
+    updateLocalBounds();
   }
 
   /**
@@ -216,6 +250,41 @@ class CH_CORE_EXPORT Mesh
   NODISCARD Vector<Vector3>
   extractPositions() const;
 
+  /**
+   * Get the vertex positions in place, without copying them
+   *
+   * @return View over the positions, count is zero if the mesh has none
+   */
+  NODISCARD PositionView
+  getPositionView() const;
+
+  /**
+   * Get the bounds of the vertex positions in mesh space
+   * Cached every time the vertex data or layout changes.
+   *
+   * @return Local bounding box, an empty box at the origin if the mesh has no positions
+   */
+  NODISCARD FORCEINLINE const AABox&
+  getLocalBounds() const { return m_localBounds; }
+
+  /**
+   * Optimize the vertex and index data for rendering, meant to run once at import
+   * Merges identical vertices, reorders triangles for the vertex cache and overdraw,
+   * stores vertices in the order they are used and switches to 16 bit indices when the
+   * vertex count fits. Meshes without indices get them. Only triangle lists are touched.
+   *
+   * @return Vertex cache statistics before and after, equal if nothing was done
+   */
+  MeshOptimizationStats
+  optimize();
+
+ private:
+  /**
+   * Recompute the cached local bounds from the vertex data
+   */
+  void
+  updateLocalBounds();
+
  private:
   Vector<uint8> m_vertexData;
   Vector<uint8> m_indexData;
@@ -223,5 +292,6 @@ class CH_CORE_EXPORT Mesh
   uint32 m_indexCount = 0;
   IndexType m_indexType = IndexType::UInt16;
   VertexLayout m_vertexLayout;
+  AABox m_localBounds{Vector3::ZERO, Vector3::ZERO};
 };
 } // namespace chEngineSDK
@@ -8,6 +8,8 @@
  */
 /************************************************************************/
 #include "chModel.h"
+#include "chMatrix3x4.h"
+#include "chParallel.h"
 #include "chSphereBoxBounds.h"
 #include "chVector3.h"
 #include "chVector4.h"
@@ -15,6 +17,13 @@
 #include "chStringUtils.h"
 
 namespace chEngineSDK {
+namespace {
+// Levels smaller than this are not worth splitting across threads.
+constexpr SIZE_T PARALLEL_LEVEL_BATCH_SIZE = 2048;
+
+// Vertices per task when computing exact bounds.
+constexpr uint32 EXACT_BOUNDS_CHUNK_SIZE = 16384;
+}
 
 /*
  * ModelNode constructor
@@ -22,6 +31,10 @@ namespace chEngineSDK {
 ModelNode::ModelNode(const String& nodeName, Model* ownerModel, ModelNode* parent)
  : m_name(""),
    m_parent(parent),
+   m_children(ArenaStdAllocator<ModelNode*>(ownerModel ? &ownerModel->m_arena : nullptr)),
+   m_meshes(ArenaStdAllocator<SPtr<Mesh>>(ownerModel ? &ownerModel->m_arena : nullptr)),
+   m_instanceSlots(
+       ArenaStdAllocator<InstanceSlot>(ownerModel ? &ownerModel->m_arena : nullptr)),
    m_localTransform(Matrix4::IDENTITY),
    m_globalTransform(Matrix4::IDENTITY),
    m_model(ownerModel),
@@ -43,6 +56,9 @@ ModelNode::addChild(ModelNode* child) {
     m_children.push_back(child);
     child->m_parent = this;
     child->markDirty();
+    if (m_model) {
+      m_model->m_topologyDirty = true;
+    }
   }
 }
 
@@ -55,6 +71,9 @@ ModelNode::removeChild(ModelNode* child) {
   if (it != m_children.end()) {
     (*it)->m_parent = nullptr;
     m_children.erase(it);
+    if (m_model) {
+      m_model->m_topologyDirty = true;
+    }
   }
 }
 
@@ -115,6 +134,13 @@ ModelNode::updateGlobalTransform() {
     m_globalTransform = m_localTransform;
   }
 
+  // Every slot belongs to this node only, so levels updated in parallel never share one
+  if (m_model) {
+    for (const InstanceSlot& slot : m_instanceSlots) {
+      m_model->m_instanceBatches[slot.batch].transforms[slot.index] = m_globalTransform;
+    }
+  }
+
   m_dirty = false;
 }
 
@@ -137,6 +163,9 @@ ModelNode::findChildByName(const String& name) {
 void
 ModelNode::markDirty() {
   m_dirty = true;
+  if (m_model) {
+    m_model->m_hasDirtyNodes = true;
+  }
   for (ModelNode* child : m_children) {
     child->markDirty();
   }
@@ -151,14 +180,17 @@ Model::Model() : m_globalTransform(Matrix4::IDENTITY) {}
  * Model destructor
  */
 Model::~Model() {
-  // Limpiar todos los nodos
+  // Nodes live in the arena, only their destructors are run here and the memory goes
+  // away in bulk with m_arena.
   for (ModelNode* node : m_allNodes) {
-    delete node;
+    node->~ModelNode();
   }
   m_allNodes.clear();
   m_rootNodes.clear();
   m_nodeMap.clear();
   m_meshToNodesMap.clear();
+  m_instanceBatches.clear();
+  m_meshToBatch.clear();
 }
 
 /*
@@ -174,7 +206,7 @@ Model::createNode(const String& name, ModelNode* parent) {
  */
 ModelNode*
 Model::createNode(const String& name, const Matrix4& localTransform, ModelNode* parent) {
-  ModelNode* node = new ModelNode(name, this, parent);
+  ModelNode* node = m_arena.construct<ModelNode>(name, this, parent);
   node->setLocalTransform(localTransform);
 
   if (parent) {
@@ -185,9 +217,22 @@ Model::createNode(const String& name, const Matrix4& localTransform, ModelNode*
   }
 
   addNodeToStructures(node);
+  m_topologyDirty = true;
   return node;
 }
 
+/*
+ * Reserve room for more nodes
+ */
+void
+Model::reserveNodes(uint32 nodeCount) {
+  m_allNodes.reserve(m_allNodes.size() + nodeCount);
+  // Every node is also one child entry and usually references one mesh.
+  m_arena.reserve(static_cast<SIZE_T>(nodeCount) *
+                  (sizeof(ModelNode) + sizeof(ModelNode*) + sizeof(SPtr<Mesh>) +
+                   sizeof(ModelNode::InstanceSlot)));
+}
+
 /*
  * Find a node by name
  */
@@ -205,12 +250,53 @@ Model::findNode(const String& name) const {
  */
 void
 Model::updateTransforms() {
-  // Primero actualizar los nodos raíz
-  for (ModelNode* root : m_rootNodes) {
-    updateNodeHierarchy(root);
+  if (!m_hasDirtyNodes) {
+    return;
+  }
+  m_hasDirtyNodes = false;
+
+  if (m_topologyDirty) {
+    rebuildTopology();
+  }
+
+  // Every parent lives in a previous level, so nodes inside a level are independent.
+  for (SIZE_T level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+    ModelNode** levelNodes = m_topologicalNodes.data() + m_levelOffsets[level];
+    const SIZE_T levelSize = m_levelOffsets[level + 1] - m_levelOffsets[level];
+    Parallel::forRange(levelSize, PARALLEL_LEVEL_BATCH_SIZE,
+                       [levelNodes](SIZE_T begin, SIZE_T end) {
+      for (SIZE_T i = begin; i < end; ++i) {
+        levelNodes[i]->updateGlobalTransform();
+      }
+    });
   }
 }
 
+/*
+ * Rebuild the breadth first order of the nodes
+ */
+void
+Model::rebuildTopology() {
+  m_topologicalNodes.clear();
+  m_topologicalNodes.reserve(m_allNodes.size());
+  m_levelOffsets.clear();
+
+  m_topologicalNodes.insert(m_topologicalNodes.end(), m_rootNodes.begin(), m_rootNodes.end());
+  SIZE_T levelBegin = 0;
+  while (levelBegin < m_topologicalNodes.size()) {
+    const SIZE_T levelEnd = m_topologicalNodes.size();
+    m_levelOffsets.push_back(static_cast<uint32>(levelBegin));
+    for (SIZE_T i = levelBegin; i < levelEnd; ++i) {
+      const ModelNode::NodeList& children = m_topologicalNodes[i]->getChildren();
+      m_topologicalNodes.insert(m_topologicalNodes.end(), children.begin(), children.end());
+    }
+    levelBegin = levelEnd;
+  }
+  m_levelOffsets.push_back(static_cast<uint32>(m_topologicalNodes.size()));
+
+  m_topologyDirty = false;
+}
+
 /*
  * Update transform for a specific node
  */
@@ -241,27 +327,123 @@ Model::updateNodeHierarchy(ModelNode* node) {
  */
 SphereBoxBounds
 Model::calculateBounds() const {
-  Vector<Vector3> allPositions;
+  Optional<AABox> bounds;
 
-  // Para cada nodo
   for (ModelNode* node : m_allNodes) {
-    // Para cada mesh en el nodo
+    if (node->getMeshes().empty()) {
+      continue;
+    }
+
+    const Matrix3x4 world(node->getGlobalTransform());
     for (const auto& mesh : node->getMeshes()) {
-      // Extraer posiciones
-      Vector<Vector3> meshPositions = mesh->extractPositions();
+      if (mesh->getPositionView().count == 0) {
+        continue;
+      }
 
-      // Aplicar transformación global del nodo
-      for (auto& pos : meshPositions) {
-        const Vector4 transformPos = node->getGlobalTransform().transformPosition(pos);
-        pos = Vector3(transformPos.x, transformPos.y, transformPos.z);
+      const AABox meshBounds = world.transformBox(mesh->getLocalBounds());
+      if (bounds) {
+        *bounds += meshBounds;
       }
+      else {
+        bounds = meshBounds;
+      }
+    }
+  }
+
+  if (!bounds) {
+    return SphereBoxBounds(Vector3::ZERO, Vector3::ZERO, 0.0f);
+  }
+  return SphereBoxBounds(*bounds);
+}
 
-      // Agregar a todas las posiciones
-      allPositions.insert(allPositions.end(), meshPositions.begin(), meshPositions.end());
+/*
+ * Calculate exact bounds, box first and then the sphere around its center
+ */
+SphereBoxBounds
+Model::calculateExactBounds() const {
+  struct BoundsChunk
+  {
+    Matrix3x4 world;
+    Mesh::PositionView positions;
+    uint32 begin;
+    uint32 end;
+  };
+
+  // Big meshes are cut in chunks so a single mesh can still be spread across threads.
+  Vector<BoundsChunk> chunks;
+  for (ModelNode* node : m_allNodes) {
+    for (const auto& mesh : node->getMeshes()) {
+      const Mesh::PositionView positions = mesh->getPositionView();
+      for (uint32 begin = 0; begin < positions.count; begin += EXACT_BOUNDS_CHUNK_SIZE) {
+        const uint32 end = Math::min(begin + EXACT_BOUNDS_CHUNK_SIZE, positions.count);
+        chunks.push_back(BoundsChunk{Matrix3x4(node->getGlobalTransform()),
+                                     positions, begin, end});
+      }
     }
   }
 
-  return SphereBoxBounds(allPositions);
+  if (chunks.empty()) {
+    return SphereBoxBounds(Vector3::ZERO, Vector3::ZERO, 0.0f);
+  }
+
+  Mutex mergeMutex;
+  Optional<AABox> bounds;
+  Parallel::forRange(chunks.size(), 1, [&](SIZE_T first, SIZE_T last) {
+    Optional<AABox> rangeBounds;
+    for (SIZE_T i = first; i < last; ++i) {
+      const BoundsChunk& chunk = chunks[i];
+      AABox chunkBounds;
+      if (chunk.positions.components == 3) {
+        chunkBounds = chunk.world.transformBounds(chunk.positions.at(chunk.begin),
+                                                  chunk.positions.stride,
+                                                  chunk.end - chunk.begin);
+      }
+      else {
+        const float* p = chunk.positions.at(chunk.begin);
+        const Vector3 firstPoint = chunk.world.transformPoint(Vector3(p[0], p[1], 0.0f));
+        chunkBounds = AABox(firstPoint, firstPoint);
+        for (uint32 v = chunk.begin + 1; v < chunk.end; ++v) {
+          p = chunk.positions.at(v);
+          chunkBounds += chunk.world.transformPoint(Vector3(p[0], p[1], 0.0f));
+        }
+      }
+
+      if (rangeBounds) {
+        *rangeBounds += chunkBounds;
+      }
+      else {
+        rangeBounds = chunkBounds;
+      }
+    }
+
+    LockGuard<Mutex> lock(mergeMutex);
+    if (bounds) {
+      *bounds += *rangeBounds;
+    }
+    else {
+      bounds = rangeBounds;
+    }
+  });
+
+  const Vector3 center = bounds->getCenter();
+  float maxSqrDistance = 0.0f;
+  Parallel::forRange(chunks.size(), 1, [&](SIZE_T first, SIZE_T last) {
+    float rangeMax = 0.0f;
+    for (SIZE_T i = first; i < last; ++i) {
+      const BoundsChunk& chunk = chunks[i];
+      for (uint32 v = chunk.begin; v < chunk.end; ++v) {
+        const float* p = chunk.positions.at(v);
+        const Vector3 point(p[0], p[1], chunk.positions.components == 3 ? p[2] : 0.0f);
+        const Vector3 offset = chunk.world.transformPoint(point) - center;
+        rangeMax = Math::max(rangeMax, offset.sqrMagnitude());
+      }
+    }
+
+    LockGuard<Mutex> lock(mergeMutex);
+    maxSqrDistance = Math::max(maxSqrDistance, rangeMax);
+  });
+
+  return SphereBoxBounds(center, bounds->getExtent(), Math::sqrt(maxSqrDistance));
 }
 
 /*
@@ -280,6 +462,7 @@ Model::setTransform(const Matrix4& transform) {
 void
 Model::registerMeshForNode(SPtr<Mesh> mesh, ModelNode* node) {
   m_meshToNodesMap[mesh].push_back(node);
+  addInstance(mesh, node);
 }
 
 void
@@ -290,6 +473,85 @@ Model::unregisterMeshForNode(SPtr<Mesh> mesh, ModelNode* node) {
   if (nodes.empty()) {
       m_meshToNodesMap.erase(mesh);
   }
+  removeInstance(mesh, node);
+}
+
+/*
+ * Add an instance of a mesh
+ */
+void
+Model::addInstance(const SPtr<Mesh>& mesh, ModelNode* node) {
+  auto [it, inserted] =
+      m_meshToBatch.try_emplace(mesh.get(), static_cast<uint32>(m_instanceBatches.size()));
+  if (inserted) {
+    m_instanceBatches.emplace_back().mesh = mesh;
+  }
+
+  MeshInstanceBatch& batch = m_instanceBatches[it->second];
+  node->m_instanceSlots.push_back(
+      ModelNode::InstanceSlot{it->second, static_cast<uint32>(batch.nodes.size())});
+  batch.nodes.push_back(node);
+  batch.transforms.push_back(node->getGlobalTransform());
+}
+
+/*
+ * Remove an instance of a mesh, the last instance and the last batch fill the holes
+ */
+void
+Model::removeInstance(const SPtr<Mesh>& mesh, ModelNode* node) {
+  auto batchIt = m_meshToBatch.find(mesh.get());
+  if (batchIt == m_meshToBatch.end()) {
+    return;
+  }
+
+  const uint32 batchIndex = batchIt->second;
+  ModelNode::InstanceSlotList& slots = node->m_instanceSlots;
+  auto slotIt = std::find_if(slots.begin(), slots.end(),
+                             [batchIndex](const ModelNode::InstanceSlot& slot) {
+                               return slot.batch == batchIndex;
+                             });
+  if (slotIt == slots.end()) {
+    return;
+  }
+
+  const uint32 index = slotIt->index;
+  *slotIt = slots.back();
+  slots.pop_back();
+
+  MeshInstanceBatch& batch = m_instanceBatches[batchIndex];
+  const uint32 lastIndex = static_cast<uint32>(batch.nodes.size()) - 1;
+  if (index != lastIndex) {
+    ModelNode* movedNode = batch.nodes[lastIndex];
+    batch.nodes[index] = movedNode;
+    batch.transforms[index] = batch.transforms[lastIndex];
+    for (ModelNode::InstanceSlot& slot : movedNode->m_instanceSlots) {
+      if (slot.batch == batchIndex && slot.index == lastIndex) {
+        slot.index = index;
+        break;
+      }
+    }
+  }
+  batch.nodes.pop_back();
+  batch.transforms.pop_back();
+
+  if (!batch.nodes.empty()) {
+    return;
+  }
+
+  m_meshToBatch.erase(batchIt);
+  const uint32 lastBatch = static_cast<uint32>(m_instanceBatches.size()) - 1;
+  if (batchIndex != lastBatch) {
+    m_instanceBatches[batchIndex] = std::move(m_instanceBatches[lastBatch]);
+    m_meshToBatch[m_instanceBatches[batchIndex].mesh.get()] = batchIndex;
+    for (ModelNode* movedNode : m_instanceBatches[batchIndex].nodes) {
+      for (ModelNode::InstanceSlot& slot : movedNode->m_instanceSlots) {
+        if (slot.batch == lastBatch) {
+          slot.batch = batchIndex;
+        }
+      }
+    }
+  }
+  m_instanceBatches.pop_back();
 }
 
 /*
@@ -334,6 +596,7 @@ Model::removeNodeFromStructures(ModelNode* node) {
     if (nodes.empty()) {
       m_meshToNodesMap.erase(mesh);
     }
+    removeInstance(mesh, node);
   }
 }
 
@@ -9,6 +9,7 @@
 /************************************************************************/
 #pragma once
 
+#include "chArenaAllocator.h"
 #include "chMatrix4.h"
 #include "chMesh.h"
 #include "chPrerequisitesCore.h"
@@ -19,6 +20,18 @@ namespace chEngineSDK {
  * Forward declaration of Model class
  */
 class Model;
+class ModelNode;
+
+/**
+ * A mesh and every node that draws it, with their global transforms packed in the same
+ * order so all of them can be drawn or processed as one unit
+ */
+struct MeshInstanceBatch
+{
+  SPtr<Mesh> mesh;
+  Vector<ModelNode*> nodes;
+  Vector<Matrix4> transforms;
+};
 
 /**
  * Structure representing a node in the model hierarchy
@@ -26,6 +39,10 @@ class Model;
 class CH_CORE_EXPORT ModelNode
 {
  public:
+  // Child and mesh lists live in the arena of the owning model
+  using NodeList = Vector<ModelNode*, ArenaStdAllocator<ModelNode*>>;
+  using MeshList = Vector<SPtr<Mesh>, ArenaStdAllocator<SPtr<Mesh>>>;
+
   // Constructors/Destructor
   ModelNode(const String& nodeName, Model* ownerModel, ModelNode* parent = nullptr);
   ~ModelNode() = default;
@@ -37,10 +54,10 @@ class CH_CORE_EXPORT ModelNode
   NODISCARD FORCEINLINE ModelNode*
   getParent() const { return m_parent; }
 
-  NODISCARD FORCEINLINE const Vector<ModelNode*>&
+  NODISCARD FORCEINLINE const NodeList&
   getChildren() const { return m_children; }
 
-  NODISCARD FORCEINLINE const Vector<SPtr<Mesh>>&
+  NODISCARD FORCEINLINE const MeshList&
   getMeshes() const { return m_meshes; }
 
   NODISCARD FORCEINLINE const Matrix4&
@@ -83,10 +100,21 @@ class CH_CORE_EXPORT ModelNode
   markDirty();
 
  private:
+  friend class Model;
+
+  // Where the transform of this node lives inside the instance batches of the model
+  struct InstanceSlot
+  {
+    uint32 batch;
+    uint32 index;
+  };
+  using InstanceSlotList = Vector<InstanceSlot, ArenaStdAllocator<InstanceSlot>>;
+
   ANSICHAR m_name[64]; ///< Node name
   ModelNode* m_parent;
-  Vector<ModelNode*> m_children;
-  Vector<SPtr<Mesh>> m_meshes;
+  NodeList m_children;
+  MeshList m_meshes;
+  InstanceSlotList m_instanceSlots;
 
   Matrix4 m_localTransform;
   Matrix4 m_globalTransform;
@@ -132,6 +160,15 @@ class CH_CORE_EXPORT Model
   ModelNode*
   createNode(const String& name, const Matrix4& localTransform, ModelNode* parent = nullptr);
 
+  /**
+   * Reserve memory for nodeCount more nodes, so importers that know the size of the
+   * hierarchy get a single allocation for all of them.
+   *
+   * @param nodeCount Amount of nodes about to be created
+   */
+  void
+  reserveNodes(uint32 nodeCount);
+
   /**
    * Find a node by name
    *
@@ -173,8 +210,21 @@ class CH_CORE_EXPORT Model
   NODISCARD FORCEINLINE const UnorderedMap<SPtr<Mesh>, Vector<ModelNode*>>&
   getMeshToNodesMap() const { return m_meshToNodesMap; }
 
+  /**
+   * Get the meshes of the model grouped for instanced processing
+   * There is one batch per mesh, kept up to date as meshes are added or removed and as
+   * updateTransforms() recomputes nodes. Removing an instance moves the last one of its
+   * batch into its place.
+   *
+   * @return Vector of instance batches
+   */
+  NODISCARD FORCEINLINE const Vector<MeshInstanceBatch>&
+  getInstanceBatches() const { return m_instanceBatches; }
+
   /**
    * Update transforms for all nodes that need updating
+   * Nodes are visited level by level in a flattened breadth first order, wide levels are
+   * split across threads. Results are the same as updating every node serially.
    */
   void
   updateTransforms();
@@ -190,12 +240,23 @@ class CH_CORE_EXPORT Model
 
   /**
    * Calculate the bounds of the model combining all mesh bounds
+   * Uses the cached local bounds of every mesh transformed by its node, so the result
+   * may be slightly bigger than the transformed vertices but never touches them.
    *
    * @return SphereBoxBounds containing all meshes
    */
   SphereBoxBounds
   calculateBounds() const;
 
+  /**
+   * Calculate the tightest bounds of the transformed vertices
+   * Positions are streamed from the vertex data in parallel, nothing is copied.
+   *
+   * @return SphereBoxBounds containing every transformed vertex
+   */
+  SphereBoxBounds
+  calculateExactBounds() const;
+
   /**
    * Set the global transform matrix for the model
    *
@@ -242,7 +303,21 @@ class CH_CORE_EXPORT Model
   void
   removeNodeFromStructures(ModelNode* node);
 
+  /**
+   * Add the node to the instance batch of the mesh, creating the batch if needed
+   */
+  void
+  addInstance(const SPtr<Mesh>& mesh, ModelNode* node);
+
+  /**
+   * Remove one instance of the node from the batch of the mesh
+   */
+  void
+  removeInstance(const SPtr<Mesh>& mesh, ModelNode* node);
+
  private:
+  friend class ModelNode;
+
   /*
     * Update the transform of a node and its hierarchy
     *
@@ -251,7 +326,16 @@ class CH_CORE_EXPORT Model
   void
   updateNodeHierarchy(ModelNode* node);
 
+  /**
+   * Rebuild the breadth first node order used by updateTransforms
+   */
+  void
+  rebuildTopology();
+
  private:
+  // Storage of the nodes and their lists, declared first so it outlives all of them
+  ArenaAllocator m_arena;
+
   // Root structure
   Vector<ModelNode*> m_rootNodes;
 
@@ -264,8 +348,18 @@ class CH_CORE_EXPORT Model
   // Map to track which nodes contain each mesh
   UnorderedMap<SPtr<Mesh>, Vector<ModelNode*>> m_meshToNodesMap;
 
+  // One batch per mesh, m_meshToBatch holds the index of each one
+  Vector<MeshInstanceBatch> m_instanceBatches;
+  UnorderedMap<Mesh*, uint32> m_meshToBatch;
+
   // Global transform for the entire model
   Matrix4 m_globalTransform;
+
+  // Nodes sorted breadth first, level i is [m_levelOffsets[i], m_levelOffsets[i + 1])
+  Vector<ModelNode*> m_topologicalNodes;
+  Vector<uint32> m_levelOffsets;
+  bool m_topologyDirty = true;
+  bool m_hasDirtyNodes = false;
 };
 
 } // namespace chEngineSDK
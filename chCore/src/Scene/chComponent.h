@@ -11,10 +11,45 @@
 
 #include "chPrerequisitesCore.h"
 
+#include <typeindex>
+
 namespace chEngineSDK {
 
 class GameObject;
 
+/**
+ * Shared data a component type touches during update(), used by the scene to find
+ * updates that can run at the same time. Data owned by the component itself does not
+ * need to be listed, neither does the local transform of its owner: the
+ * TransformHierarchy takes concurrent writes as long as they go to different nodes.
+ * Types that write the transform of other GameObjects, or that share an owner with
+ * another type writing its transform, declare write<TransformHierarchy>().
+ */
+struct ComponentAccess
+{
+  Vector<std::type_index> reads;
+  Vector<std::type_index> writes;
+
+  /**
+   * Runs alone on the thread updating the scene, in scene order
+   */
+  bool exclusive = false;
+
+  template<typename T>
+  ComponentAccess&
+  read() {
+    reads.emplace_back(typeid(T));
+    return *this;
+  }
+
+  template<typename T>
+  ComponentAccess&
+  write() {
+    writes.emplace_back(typeid(T));
+    return *this;
+  }
+};
+
 class CH_CORE_EXPORT Component
 {
  public:
@@ -46,6 +81,42 @@ class CH_CORE_EXPORT Component
   virtual void
   update(float deltaTime) {}
 
+  /**
+   * Declare the shared data update() reads and writes
+   * Queried once per component type, on the first instance the scene finds. Components
+   * that do not override it are exclusive, they update on the calling thread in scene
+   * order, GameObject by GameObject. Overriding it lets the scene update them on worker
+   * threads, walking the registry pool of the type.
+   *
+   * @param access Access to fill
+   */
+  virtual void
+  declareAccess(ComponentAccess& access) const {
+    access.exclusive = true;
+  }
+
+  /**
+   * Write the persistent state of the component for a scene snapshot
+   *
+   * @param data Buffer to append the state to
+   */
+  virtual void
+  serialize(Vector<uint8>& data) const { CH_PAMRAMETER_UNUSED(data); }
+
+  /**
+   * Restore the state written by serialize()
+   *
+   * @param data State of this component inside the snapshot
+   * @param size Size of the state in bytes
+   * @return True if the state could be read
+   */
+  virtual bool
+  deserialize(const uint8* data, SIZE_T size) {
+    CH_PAMRAMETER_UNUSED(data);
+    CH_PAMRAMETER_UNUSED(size);
+    return true;
+  }
+
   /**
    * Set the owner of this component
    *
@@ -86,9 +157,25 @@ class CH_CORE_EXPORT Component
     return m_enabled;
   }
 
+  /**
+   * Check if the component takes part in updates, it is enabled and its owner and every
+   * parent of the owner are active
+   *
+   * @return True if update() should be called
+   */
+  NODISCARD bool
+  isUpdatable() const {
+    return m_enabled && m_ownerActive;
+  }
+
  private:
+  friend class GameObject;
+
   GameObject* m_owner = nullptr;
   bool m_enabled = true;
+
+  // Cached by the owner so updates over a pool never read the GameObject
+  bool m_ownerActive = true;
 };
 
 } // namespace chEngineSDK
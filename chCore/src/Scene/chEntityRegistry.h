@@ -0,0 +1,498 @@
+/************************************************************************/
+/**
+ * @file chEntityRegistry.h
+ * @author AccelMR
+ * @date 2025/07/26
+ * @brief
+ *  Data oriented entity/component storage based on sparse sets.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chComponent.h"
+
+#include <typeindex>
+
+namespace chEngineSDK {
+
+/**
+ * @brief Lightweight entity identifier.
+ * The generation changes every time an index is recycled, so stale handles are detected.
+ */
+struct Entity
+{
+  static constexpr uint32 NULL_INDEX = 0xFFFFFFFF;
+
+  NODISCARD FORCEINLINE bool
+  isNull() const {
+    return index == NULL_INDEX;
+  }
+
+  NODISCARD FORCEINLINE bool
+  operator==(const Entity& other) const {
+    return index == other.index && generation == other.generation;
+  }
+
+  NODISCARD FORCEINLINE bool
+  operator!=(const Entity& other) const {
+    return !(*this == other);
+  }
+
+  uint32 index = NULL_INDEX;
+  uint32 generation = 0;
+};
+
+/**
+ * @brief Type erased part of a component pool.
+ *
+ * The sparse array maps an entity index to a slot in the dense arrays, components of one
+ * type are therefore contiguous no matter which entities own them.
+ */
+class IComponentPool
+{
+ public:
+  virtual ~IComponentPool() = default;
+
+  /**
+   * Remove the component of the entity, does nothing if it has none.
+   */
+  virtual void
+  remove(Entity entity) = 0;
+
+  /**
+   * Component base of the component in the slot, nullptr for pools of plain data.
+   */
+  NODISCARD virtual Component*
+  getComponent(uint32 slot) = 0;
+
+  /**
+   * Update the components in [begin, end) whose owner is active and that are enabled,
+   * walking the dense array. Pools of plain data do nothing.
+   */
+  virtual void
+  updateComponents(SIZE_T begin, SIZE_T end, float deltaTime) = 0;
+
+  /**
+   * True if the stored type derives from Component.
+   */
+  NODISCARD FORCEINLINE bool
+  isComponentPool() const {
+    return m_isComponentPool;
+  }
+
+  NODISCARD FORCEINLINE bool
+  contains(Entity entity) const {
+    return entity.index < m_sparse.size() && m_sparse[entity.index] != Entity::NULL_INDEX &&
+           m_dense[m_sparse[entity.index]] == entity;
+  }
+
+  /**
+   * Slot of the entity in the dense arrays, the entity must be contained.
+   */
+  NODISCARD FORCEINLINE uint32
+  slotOf(Entity entity) const {
+    CH_ASSERT(contains(entity));
+    return m_sparse[entity.index];
+  }
+
+  NODISCARD FORCEINLINE SIZE_T
+  size() const {
+    return m_dense.size();
+  }
+
+  /**
+   * Owners of the components, in the same order as the component data.
+   */
+  NODISCARD FORCEINLINE const Vector<Entity>&
+  getEntities() const {
+    return m_dense;
+  }
+
+ protected:
+  explicit IComponentPool(bool isComponentPool) : m_isComponentPool(isComponentPool) {}
+
+  Vector<uint32> m_sparse;
+  Vector<Entity> m_dense;
+  bool m_isComponentPool;
+};
+
+/**
+ * @brief Contiguous storage for every component of type T.
+ * Removal swaps the last component into the freed slot, so references to components are
+ * only stable until the next add or remove on the same pool.
+ */
+template<typename T>
+class ComponentPool final : public IComponentPool
+{
+ public:
+  ComponentPool() : IComponentPool(std::is_base_of_v<Component, T>) {}
+
+  /**
+   * Creates the component, or replaces it if the entity already has one.
+   */
+  template<typename... Args>
+  T&
+  emplace(Entity entity, Args&&... args) {
+    if (contains(entity)) {
+      T& component = m_data[m_sparse[entity.index]];
+      if constexpr (std::is_aggregate_v<T>) {
+        component = T{std::forward<Args>(args)...};
+      }
+      else {
+        component = T(std::forward<Args>(args)...);
+      }
+      return component;
+    }
+
+    if (entity.index >= m_sparse.size()) {
+      m_sparse.resize(entity.index + 1, Entity::NULL_INDEX);
+    }
+    m_sparse[entity.index] = static_cast<uint32>(m_dense.size());
+    m_dense.push_back(entity);
+    if constexpr (std::is_aggregate_v<T>) {
+      return m_data.emplace_back(T{std::forward<Args>(args)...});
+    }
+    else {
+      return m_data.emplace_back(std::forward<Args>(args)...);
+    }
+  }
+
+  NODISCARD Component*
+  getComponent(uint32 slot) override {
+    if constexpr (std::is_base_of_v<Component, T>) {
+      return &m_data[slot];
+    }
+    else {
+      CH_PAMRAMETER_UNUSED(slot);
+      return nullptr;
+    }
+  }
+
+  void
+  updateComponents(SIZE_T begin, SIZE_T end, float deltaTime) override {
+    if constexpr (std::is_base_of_v<Component, T>) {
+      // The stored type is exact, the qualified call skips the virtual dispatch
+      for (SIZE_T i = begin; i < end; ++i) {
+        if (m_data[i].isUpdatable()) {
+          m_data[i].T::update(deltaTime);
+        }
+      }
+    }
+    else {
+      CH_PAMRAMETER_UNUSED(begin);
+      CH_PAMRAMETER_UNUSED(end);
+      CH_PAMRAMETER_UNUSED(deltaTime);
+    }
+  }
+
+  void
+  remove(Entity entity) override {
+    if (!contains(entity)) {
+      return;
+    }
+
+    const uint32 slot = m_sparse[entity.index];
+    const uint32 last = static_cast<uint32>(m_dense.size() - 1);
+    if (slot != last) {
+      m_dense[slot] = m_dense[last];
+      m_data[slot] = std::move(m_data[last]);
+      m_sparse[m_dense[slot].index] = slot;
+    }
+    m_dense.pop_back();
+    m_data.pop_back();
+    m_sparse[entity.index] = Entity::NULL_INDEX;
+  }
+
+  NODISCARD FORCEINLINE T*
+  tryGet(Entity entity) {
+    return contains(entity) ? &m_data[m_sparse[entity.index]] : nullptr;
+  }
+
+  NODISCARD FORCEINLINE const T*
+  tryGet(Entity entity) const {
+    return contains(entity) ? &m_data[m_sparse[entity.index]] : nullptr;
+  }
+
+  NODISCARD FORCEINLINE T&
+  get(Entity entity) {
+    return m_data[slotOf(entity)];
+  }
+
+  NODISCARD FORCEINLINE const T&
+  get(Entity entity) const {
+    return m_data[slotOf(entity)];
+  }
+
+  /**
+   * Every component of this type, getEntities()[i] owns getData()[i].
+   */
+  NODISCARD FORCEINLINE Vector<T>&
+  getData() {
+    return m_data;
+  }
+
+  NODISCARD FORCEINLINE const Vector<T>&
+  getData() const {
+    return m_data;
+  }
+
+  void
+  reserve(SIZE_T count) {
+    m_dense.reserve(count);
+    m_data.reserve(count);
+  }
+
+ private:
+  Vector<T> m_data;
+};
+
+/*
+ * Description:
+ *     Owns entities and one ComponentPool per component type.
+ *     Components are stored by value, either plain data that systems operate on through
+ *     each(), or Component types that the scene updates pool by pool.
+ *
+ *     Adding or removing components of a type being iterated by each() is not allowed.
+ *
+ * Sample usage:
+ *  EntityRegistry registry;
+ *  Entity e = registry.create();
+ *  registry.emplace<Velocity>(e, Vector3(1.0f, 0.0f, 0.0f));
+ *  registry.each<Position, Velocity>([dt](Entity, Position& p, const Velocity& v) {
+ *    p.value += v.value * dt;
+ *  });
+ */
+class EntityRegistry
+{
+ public:
+  EntityRegistry() = default;
+  ~EntityRegistry() = default;
+
+  EntityRegistry(const EntityRegistry&) = delete;
+  EntityRegistry&
+  operator=(const EntityRegistry&) = delete;
+
+  /**
+   * Creates a new entity, recycling destroyed indices first.
+   */
+  NODISCARD Entity
+  create() {
+    if (!m_freeIndices.empty()) {
+      const uint32 index = m_freeIndices.back();
+      m_freeIndices.pop_back();
+      return Entity{index, m_generations[index]};
+    }
+
+    const uint32 index = static_cast<uint32>(m_generations.size());
+    m_generations.push_back(0);
+    return Entity{index, 0};
+  }
+
+  /**
+   * Destroys the entity and all its components. Stale handles are ignored.
+   */
+  void
+  destroy(Entity entity) {
+    if (!isValid(entity)) {
+      return;
+    }
+
+    for (auto& [type, pool] : m_pools) {
+      pool->remove(entity);
+    }
+    ++m_generations[entity.index];
+    m_freeIndices.push_back(entity.index);
+  }
+
+  NODISCARD FORCEINLINE bool
+  isValid(Entity entity) const {
+    return entity.index < m_generations.size() &&
+           m_generations[entity.index] == entity.generation;
+  }
+
+  /**
+   * Amount of alive entities.
+   */
+  NODISCARD FORCEINLINE SIZE_T
+  getEntityCount() const {
+    return m_generations.size() - m_freeIndices.size();
+  }
+
+  /**
+   * Adds a component of type T to the entity, replacing the existing one.
+   */
+  template<typename T, typename... Args>
+  T&
+  emplace(Entity entity, Args&&... args) {
+    CH_ASSERT(isValid(entity));
+    return getPool<T>().emplace(entity, std::forward<Args>(args)...);
+  }
+
+  template<typename T>
+  void
+  remove(Entity entity) {
+    if (ComponentPool<T>* pool = findPool<T>()) {
+      pool->remove(entity);
+    }
+  }
+
+  /**
+   * Removes the component of the given type, used where the type is only known at runtime
+   */
+  void
+  remove(const std::type_index& type, Entity entity) {
+    auto it = m_pools.find(type);
+    if (it != m_pools.end()) {
+      it->second->remove(entity);
+    }
+  }
+
+  template<typename T>
+  NODISCARD bool
+  has(Entity entity) const {
+    const ComponentPool<T>* pool = findPool<T>();
+    return pool && pool->contains(entity);
+  }
+
+  template<typename T>
+  NODISCARD T*
+  tryGet(Entity entity) {
+    ComponentPool<T>* pool = findPool<T>();
+    return pool ? pool->tryGet(entity) : nullptr;
+  }
+
+  template<typename T>
+  NODISCARD const T*
+  tryGet(Entity entity) const {
+    const ComponentPool<T>* pool = findPool<T>();
+    return pool ? pool->tryGet(entity) : nullptr;
+  }
+
+  template<typename T>
+  NODISCARD T&
+  get(Entity entity) {
+    T* component = tryGet<T>(entity);
+    CH_ASSERT(component);
+    return *component;
+  }
+
+  /**
+   * Component of the given type as its Component base, used where the type is only known
+   * at runtime
+   *
+   * @return The component, or nullptr if the entity has none or the type is plain data
+   */
+  NODISCARD Component*
+  tryGetComponent(const std::type_index& type, Entity entity) const {
+    auto it = m_pools.find(type);
+    if (it == m_pools.end() || !it->second->contains(entity)) {
+      return nullptr;
+    }
+    return it->second->getComponent(it->second->slotOf(entity));
+  }
+
+  /**
+   * Storage for type T, created on first use.
+   */
+  template<typename T>
+  NODISCARD ComponentPool<T>&
+  getPool() {
+    auto& pool = m_pools[std::type_index(typeid(T))];
+    if (!pool) {
+      pool = UniquePtr<IComponentPool>(new ComponentPool<T>());
+      m_poolOrder.emplace_back(std::type_index(typeid(T)), pool.get());
+    }
+    return static_cast<ComponentPool<T>&>(*pool);
+  }
+
+  /**
+   * Calls fn(type, pool) for every pool, in the order the pools were created.
+   */
+  template<typename Fn>
+  void
+  eachPool(Fn&& fn) {
+    for (auto& [type, pool] : m_poolOrder) {
+      fn(type, *pool);
+    }
+  }
+
+  /**
+   * Calls fn(entity, components&...) for every entity that has all the given types.
+   * The smallest pool drives the iteration, a single type walks its array linearly.
+   */
+  template<typename... Ts, typename Fn>
+  void
+  each(Fn&& fn) {
+    static_assert(sizeof...(Ts) > 0, "each() needs at least one component type");
+
+    if constexpr (sizeof...(Ts) == 1) {
+      using T = std::tuple_element_t<0, std::tuple<Ts...>>;
+      ComponentPool<T>* pool = findPool<T>();
+      if (!pool) {
+        return;
+      }
+      const Vector<Entity>& entities = pool->getEntities();
+      Vector<T>& data = pool->getData();
+      for (SIZE_T i = 0; i < data.size(); ++i) {
+        fn(entities[i], data[i]);
+      }
+    }
+    else {
+      std::tuple<ComponentPool<Ts>*...> pools(findPool<Ts>()...);
+      const bool allPresent = std::apply([](auto*... p) { return ((p != nullptr) && ...); },
+                                         pools);
+      if (!allPresent) {
+        return;
+      }
+
+      const IComponentPool* driver = nullptr;
+      std::apply([&driver](auto*... p) {
+        ((driver = (!driver || p->size() < driver->size()) ? p : driver), ...);
+      }, pools);
+
+      const Vector<Entity>& entities = driver->getEntities();
+      for (SIZE_T i = 0; i < entities.size(); ++i) {
+        const Entity entity = entities[i];
+        const bool hasAll = std::apply([entity](auto*... p) {
+          return (p->contains(entity) && ...);
+        }, pools);
+        if (hasAll) {
+          std::apply([&fn, entity](auto*... p) {
+            fn(entity, p->getData()[p->slotOf(entity)]...);
+          }, pools);
+        }
+      }
+    }
+  }
+
+  /**
+   * Destroys every entity and component, previous handles become invalid.
+   */
+  void
+  clear() {
+    m_poolOrder.clear();
+    m_pools.clear();
+    m_freeIndices.clear();
+    for (uint32 index = 0; index < static_cast<uint32>(m_generations.size()); ++index) {
+      ++m_generations[index];
+      m_freeIndices.push_back(index);
+    }
+  }
+
+ private:
+  template<typename T>
+  NODISCARD ComponentPool<T>*
+  findPool() const {
+    auto it = m_pools.find(std::type_index(typeid(T)));
+    return it != m_pools.end() ? static_cast<ComponentPool<T>*>(it->second.get()) : nullptr;
+  }
+
+  UnorderedMap<std::type_index, UniquePtr<IComponentPool>> m_pools;
+  Vector<std::pair<std::type_index, IComponentPool*>> m_poolOrder;
+  Vector<uint32> m_generations;
+  Vector<uint32> m_freeIndices;
+};
+
+} // namespace chEngineSDK
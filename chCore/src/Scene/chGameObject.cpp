@@ -13,12 +13,172 @@ namespace chEngineSDK {
 /*
 */
 GameObject::GameObject(const String& name)
- : Object(name) {
+ : Object(name),
+   m_registry(chMakeShared<EntityRegistry>()),
+   m_transformHierarchy(chMakeShared<TransformHierarchy>()) {
+  m_entity = m_registry->create();
+  m_transformNode = m_transformHierarchy->createNode();
 }
 
+/*
+*/
+GameObject::GameObject(const String& name,
+                       SPtr<EntityRegistry> registry,
+                       SPtr<TransformHierarchy> hierarchy,
+                       TransformHierarchy::NodeId transformNode)
+ : Object(name),
+   m_registry(std::move(registry)),
+   m_transformHierarchy(std::move(hierarchy)),
+   m_transformNode(transformNode) {
+  CH_ASSERT(m_registry);
+  CH_ASSERT(m_transformHierarchy && m_transformHierarchy->isValid(m_transformNode));
+  m_entity = m_registry->create();
+}
+
+/*
+*/
+GameObject::~GameObject() {
+  if (m_transformHierarchy->isValid(m_transformNode)) {
+    releaseChildNodes();
+    m_transformHierarchy->destroyNode(m_transformNode);
+  }
+
+  m_registry->destroy(m_entity);
+}
+
+/*
+*/
 void
 GameObject::addChild(SPtr<GameObject> child) {
+  CH_ASSERT(child && child.get() != this);
+  CH_ASSERT(child->m_transformHierarchy == m_transformHierarchy &&
+            "Children must share the transform hierarchy of their parent");
+
+  SPtr<GameObject> oldParent = child->getParent();
+  if (oldParent.get() == this) {
+    return;
+  }
+  if (oldParent) {
+    oldParent->removeChild(child);
+  }
+
+  child->m_parent = weak_from_this();
+  if (child->m_transformHierarchy == m_transformHierarchy &&
+      m_transformHierarchy->getParent(child->m_transformNode) != m_transformNode) {
+    m_transformHierarchy->setParent(child->m_transformNode, m_transformNode);
+  }
   m_children.push_back(child);
+  child->refreshActiveInHierarchy();
+}
+
+/*
+*/
+bool
+GameObject::removeChild(SPtr<GameObject> child) {
+  auto it = std::find(m_children.begin(), m_children.end(), child);
+  if (it == m_children.end()) {
+    return false;
+  }
+
+  m_children.erase(it);
+  child->m_parent.reset();
+  if (child->m_transformHierarchy == m_transformHierarchy &&
+      m_transformHierarchy->isValid(child->m_transformNode)) {
+    m_transformHierarchy->setParent(child->m_transformNode, TransformHierarchy::INVALID_NODE);
+  }
+  child->refreshActiveInHierarchy();
+  return true;
+}
+
+/*
+*/
+void
+GameObject::setParent(SPtr<GameObject> parent) {
+  if (parent) {
+    parent->addChild(shared_from_this());
+  }
+  else if (SPtr<GameObject> oldParent = getParent()) {
+    oldParent->removeChild(shared_from_this());
+  }
+}
+
+/*
+ * Ids of destroyed nodes are reused, so the children that die with this GameObject must
+ * not destroy their old ids again.
+ */
+void
+GameObject::releaseChildNodes() {
+  for (const SPtr<GameObject>& child : m_children) {
+    if (child->m_transformHierarchy != m_transformHierarchy) {
+      continue;
+    }
+
+    if (child.use_count() > 1) {
+      m_transformHierarchy->setParent(child->m_transformNode,
+                                      TransformHierarchy::INVALID_NODE);
+    }
+    else {
+      child->releaseChildNodes();
+      child->m_transformNode = TransformHierarchy::INVALID_NODE;
+    }
+  }
+}
+
+/*
+*/
+void
+GameObject::removeAllComponents() {
+  for (const std::type_index& type : m_componentTypes) {
+    m_registry->remove(type, m_entity);
+  }
+  m_componentTypes.clear();
+}
+
+/*
+*/
+void
+GameObject::setActive(bool active) {
+  m_active = active;
+  refreshActiveInHierarchy();
+}
+
+/*
+*/
+void
+GameObject::refreshActiveInHierarchy() {
+  SPtr<GameObject> parent = getParent();
+  const bool activeInHierarchy = m_active && (!parent || parent->m_activeInHierarchy);
+  if (activeInHierarchy == m_activeInHierarchy) {
+    return;
+  }
+
+  m_activeInHierarchy = activeInHierarchy;
+  eachComponent([activeInHierarchy](const std::type_index&, Component& component) {
+    component.m_ownerActive = activeInHierarchy;
+  });
+  for (const SPtr<GameObject>& child : m_children) {
+    child->refreshActiveInHierarchy();
+  }
+}
+
+/*
+ * Serial path, scenes go through their SceneUpdateScheduler instead.
+ */
+void
+GameObject::update(float deltaTime) {
+  if (!m_active) {
+    return;
+  }
+
+  eachComponent([deltaTime](const std::type_index&, Component& component) {
+    if (component.isUpdatable()) {
+      component.update(deltaTime);
+    }
+  });
+
+  for (const SPtr<GameObject>& child : m_children) {
+    child->update(deltaTime);
+  }
 }
 
 } // namespace chEngineSDK
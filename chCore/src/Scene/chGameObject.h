@@ -13,36 +13,63 @@
 
 #include "chObject.h"
 
-#include "chTransform.h"
 #include "chComponent.h"
+#include "chEntityRegistry.h"
+#include "chTransformHierarchy.h"
 
 namespace chEngineSDK {
 
-class CH_CORE_EXPORT GameObject : public Object
+class CH_CORE_EXPORT GameObject : public Object,
+                                  public std::enable_shared_from_this<GameObject>
 {
  public:
   /**
-   * Constructor
+   * Constructor for a GameObject outside of a scene, it gets a registry and a hierarchy
+   * of its own
    * 
    * @param name Name of the GameObject
    */
   GameObject(const String& name);
+
+  /**
+   * Constructor for a GameObject backed by an entity of the given registry
+   *
+   * @param name Name of the GameObject
+   * @param registry Registry that stores the data of this GameObject
+   * @param hierarchy Transform hierarchy shared by the scene
+   * @param transformNode Node of this GameObject in hierarchy
+   */
+  GameObject(const String& name,
+             SPtr<EntityRegistry> registry,
+             SPtr<TransformHierarchy> hierarchy,
+             TransformHierarchy::NodeId transformNode);
   
   /**
-   * Destructor
+   * Destructor, destroys the backing entity and its transform node
+   * Children that are still referenced elsewhere keep their nodes as hierarchy roots, the
+   * nodes of the rest go away with this one.
    */
-  ~GameObject() = default;
+  ~GameObject();
   
   /**
-   * Add a child GameObject
+   * Add a child GameObject, removing it from its previous parent
+   * The child keeps its local transform, its node is moved under this one.
    * 
-   * @param child GameObject to add as child
+   * @param child GameObject to add as child, from the same transform hierarchy
    */
   void 
   addChild(SPtr<GameObject> child);
   
   /**
-   * Remove a child GameObject
+   * Make room for children about to be added
+   *
+   * @param count Amount of children the GameObject will have
+   */
+  void
+  reserveChildren(SIZE_T count) { m_children.reserve(count); }
+
+  /**
+   * Remove a child GameObject, its node becomes a root of the transform hierarchy
    * 
    * @param child GameObject to remove
    * @return True if child was removed
@@ -51,12 +78,54 @@ class CH_CORE_EXPORT GameObject : public Object
   removeChild(SPtr<GameObject> child);
   
   /**
-   * Get the GameObject's transformation
-   * 
-   * @return Reference to the transform
+   * Get the local position, stored in the transform hierarchy node
+   */
+  NODISCARD const Vector3&
+  getLocalPosition() const {
+    return m_transformHierarchy->getLocalPosition(m_transformNode);
+  }
+
+  void
+  setLocalPosition(const Vector3& position) {
+    m_transformHierarchy->setLocalPosition(m_transformNode, position);
+  }
+
+  NODISCARD const Quaternion&
+  getLocalRotation() const {
+    return m_transformHierarchy->getLocalRotation(m_transformNode);
+  }
+
+  void
+  setLocalRotation(const Quaternion& rotation) {
+    m_transformHierarchy->setLocalRotation(m_transformNode, rotation);
+  }
+
+  NODISCARD const Vector3&
+  getLocalScale() const {
+    return m_transformHierarchy->getLocalScale(m_transformNode);
+  }
+
+  void
+  setLocalScale(const Vector3& scale) {
+    m_transformHierarchy->setLocalScale(m_transformNode, scale);
+  }
+
+  void
+  setLocalTransform(const Vector3& position,
+                    const Quaternion& rotation,
+                    const Vector3& scale) {
+    m_transformHierarchy->setLocalTransform(m_transformNode, position, rotation, scale);
+  }
+
+  /**
+   * Get the world matrix computed by the last update of the transform hierarchy
+   *
+   * @return World matrix of the GameObject
    */
-  NODISCARD Transform& 
-  getTransform() { return m_transform; }
+  NODISCARD const Matrix3x4&
+  getWorldMatrix() const {
+    return m_transformHierarchy->getWorldMatrix(m_transformNode);
+  }
   
   /**
    * Get the GameObject's name
@@ -67,82 +136,144 @@ class CH_CORE_EXPORT GameObject : public Object
   getName() const { return m_name; }
   
   /**
-   * Add a component to the GameObject
-  
+   * Create and add a component to the GameObject, replacing the one of the same type
+   * Components are stored by value in the registry pool of their exact type.
    * 
    * @tparam T Component type
-   * @param component Component to add
-   * @return Shared pointer to the added component
+   * @param args Arguments to pass to the component constructor
+   * @return Reference to the component, valid until a component of type T is added or
+   *         removed on any GameObject of the registry
    */
-  template<typename T>
-  SPtr<T> addComponent(SPtr<T> component) {
+  template<typename T, typename... Args>
+  T& addComponent(Args&&... args) {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-    m_components.push_back(component);
-    component->setOwner(this);
+    const bool replacing = m_registry->has<T>(m_entity);
+    T& component = m_registry->emplace<T>(m_entity, std::forward<Args>(args)...);
+    component.m_owner = this;
+    component.m_ownerActive = m_activeInHierarchy;
+    if (!replacing) {
+      m_componentTypes.emplace_back(typeid(T));
+    }
     return component;
   }
   
   /**
-   * Create and add a component to the GameObject
+   * Get the component of type T, found by its exact type with a sparse lookup
    * 
    * @tparam T Component type
-   * @param args Arguments to pass to the component constructor
-   * @return Shared pointer to the created component
+   * @return Pointer to the component, or nullptr if not found. Valid until a component of
+   *         type T is added or removed
    */
-  template<typename T, typename... Args>
-  SPtr<T> addComponent(Args&&... args) {
+  template<typename T>
+  NODISCARD T* getComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-    SPtr<T> component = chMakeShared<T>(std::forward<Args>(args)...);
-    m_components.push_back(component);
-    component->setOwner(this);
-    return component;
+    return m_registry->tryGet<T>(m_entity);
   }
-  
+
   /**
-   * Get a component of a specific type
-   * 
-   * @tparam T Component type
-   * @return Shared pointer to the component, or nullptr if not found
+   * Remove the component of type T
+   *
+   * @return True if the GameObject had one
    */
   template<typename T>
-  NODISCARD SPtr<T> getComponent() const {
+  bool removeComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-    for (const auto& component : m_components) {
-      SPtr<T> result = std::dynamic_pointer_cast<T>(component);
-      if (result) {
-        return result;
-      }
+    auto it = std::find(m_componentTypes.begin(), m_componentTypes.end(), typeid(T));
+    if (it == m_componentTypes.end()) {
+      return false;
     }
-    return nullptr;
+    m_componentTypes.erase(it);
+    m_registry->remove<T>(m_entity);
+    return true;
   }
-  
+
   /**
-   * Get all components of a specific type
-   * 
-   * @tparam T Component type
-   * @return Vector of components of the specified type
+   * Remove every component, plain data added with addComponentData() is kept
    */
-  template<typename T>
-  NODISCARD Vector<SPtr<T>> getComponents() const {
-    static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-    Vector<SPtr<T>> result;
-    for (const auto& component : m_components) {
-      SPtr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
-      if (typedComponent) {
-        result.push_back(typedComponent);
-      }
+  void
+  removeAllComponents();
+
+  /**
+   * Calls fn(type, component) for every component, in the order they were added
+   */
+  template<typename Fn>
+  void eachComponent(Fn&& fn) const {
+    for (const std::type_index& type : m_componentTypes) {
+      fn(type, *m_registry->tryGetComponent(type, m_entity));
     }
-    return result;
   }
-  
+
   /**
-   * Get all components
-   * 
-   * @return Vector of all components
+   * Get the types of the components, in the order they were added
    */
-  NODISCARD const Vector<SPtr<Component>>& 
-  getAllComponents() const { return m_components; }
+  NODISCARD const Vector<std::type_index>&
+  getComponentTypes() const { return m_componentTypes; }
   
+  /**
+   * Add plain data to this GameObject's entity, replacing any previous value of type T
+   *
+   * @tparam T Data type, stored contiguously with the data of every other entity
+   * @param args Arguments to construct the data
+   * @return Reference to the data, valid until data of type T is added or removed
+   */
+  template<typename T, typename... Args>
+  T& addComponentData(Args&&... args) {
+    return m_registry->emplace<T>(m_entity, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Get plain data of this GameObject's entity
+   *
+   * @tparam T Data type
+   * @return Pointer to the data, or nullptr if this entity has none
+   */
+  template<typename T>
+  NODISCARD T* getComponentData() const {
+    return m_registry->tryGet<T>(m_entity);
+  }
+
+  /**
+   * Check if this GameObject's entity has data of type T
+   */
+  template<typename T>
+  NODISCARD bool hasComponentData() const {
+    return m_registry->has<T>(m_entity);
+  }
+
+  /**
+   * Remove data of type T from this GameObject's entity
+   */
+  template<typename T>
+  void removeComponentData() {
+    m_registry->remove<T>(m_entity);
+  }
+
+  /**
+   * Get the entity backing this GameObject
+   */
+  NODISCARD Entity
+  getEntity() const { return m_entity; }
+
+  /**
+   * Get the node of this GameObject in the transform hierarchy
+   *
+   * @return Node id, INVALID_NODE once the hierarchy dropped it with its scene
+   */
+  NODISCARD TransformHierarchy::NodeId
+  getTransformNode() const { return m_transformNode; }
+
+  /**
+   * Get the transform hierarchy holding the node of this GameObject
+   */
+  NODISCARD const SPtr<TransformHierarchy>&
+  getTransformHierarchy() const { return m_transformHierarchy; }
+
+  /**
+   * Get the registry that stores this GameObject's data
+   */
+  NODISCARD const SPtr<EntityRegistry>&
+  getRegistry() const { return m_registry; }
+
   /**
    * Get all child GameObjects
    * 
@@ -162,7 +293,7 @@ class CH_CORE_EXPORT GameObject : public Object
   /**
    * Set the parent GameObject
    * 
-   * @param parent New parent GameObject
+   * @param parent New parent GameObject, nullptr detaches it from the current one
    */
   void 
   setParent(SPtr<GameObject> parent);
@@ -176,12 +307,13 @@ class CH_CORE_EXPORT GameObject : public Object
   update(float deltaTime);
   
   /**
-   * Set whether the GameObject is active
+   * Set whether the GameObject is active, inactive GameObjects skip the updates of their
+   * components and of their children
    * 
    * @param active Whether the GameObject should be active
    */
   void 
-  setActive(bool active) { m_active = active; }
+  setActive(bool active);
   
   /**
    * Check if the GameObject is active
@@ -191,12 +323,36 @@ class CH_CORE_EXPORT GameObject : public Object
   NODISCARD bool 
   isActive() const { return m_active; }
 
+  /**
+   * Check if the GameObject and all its parents are active
+   */
+  NODISCARD bool
+  isActiveInHierarchy() const { return m_activeInHierarchy; }
+
  private:
-  Transform m_transform;
-  Vector<SPtr<Component>> m_components;
+  /**
+   * Move the nodes of children referenced elsewhere out of this subtree and forget the
+   * nodes of the rest, they are destroyed together with this node
+   */
+  void
+  releaseChildNodes();
+
+  /**
+   * Recompute the active state inherited from the parent, for this subtree and its
+   * components
+   */
+  void
+  refreshActiveInHierarchy();
+
+  Vector<std::type_index> m_componentTypes;
   Vector<SPtr<GameObject>> m_children;
   WeakPtr<GameObject> m_parent;
+  SPtr<EntityRegistry> m_registry;
+  Entity m_entity;
+  SPtr<TransformHierarchy> m_transformHierarchy;
+  TransformHierarchy::NodeId m_transformNode = TransformHierarchy::INVALID_NODE;
   bool m_active = true;
+  bool m_activeInHierarchy = true;
 };
 
 } // namespace chEngineSDK
\ No newline at end of file
@@ -12,18 +12,40 @@
 namespace chEngineSDK {
 /*
 */
-Scene::Scene(const String& name, UUID id)
- : Object(name, id) {
-  SPtr<GameObject> rootObject = chMakeShared<GameObject>("Root");
+Scene::Scene(const String& name, UUID id, bool createRoot)
+ : Object(name, id),
+   m_registry(chMakeShared<EntityRegistry>()),
+   m_transformHierarchy(chMakeShared<TransformHierarchy>()) {
+  m_transformHierarchy->setDestroyCallback([this](TransformHierarchy::NodeId node) {
+    removeSpatialEntry(node);
+  });
+
+  if (!createRoot) {
+    return;
+  }
+
+  SPtr<GameObject> rootObject = chMakeShared<GameObject>(
+      "Root", m_registry, m_transformHierarchy, m_transformHierarchy->createNode());
   m_rootGameObjects.push_back(rootObject);
   m_gameObjectsMap[rootObject->getName()] = rootObject;
 }
 
+/*
+*/
+Scene::~Scene() {
+  // GameObjects still referenced elsewhere may outlive the scene with the hierarchy
+  m_transformHierarchy->setDestroyCallback(nullptr);
+  m_transformHierarchy->clear();
+}
+
 /*
 */
 SPtr<GameObject>
 Scene::createGameObject(const String& name, SPtr<GameObject> parent) {
-  SPtr<GameObject> newObject = chMakeShared<GameObject>(name);
+  const TransformHierarchy::NodeId node = m_transformHierarchy->createNode(
+      parent ? parent->getTransformNode() : TransformHierarchy::INVALID_NODE);
+  SPtr<GameObject> newObject =
+      chMakeShared<GameObject>(name, m_registry, m_transformHierarchy, node);
   if (parent) {
     parent->addChild(newObject);
   }
@@ -34,4 +56,186 @@ Scene::createGameObject(const String& name, SPtr<GameObject> parent) {
   return newObject;
 }
 
+/*
+*/
+Vector<SPtr<GameObject>>
+Scene::createGameObjects(const Vector<GameObjectDesc>& descs) {
+  const SIZE_T count = descs.size();
+  Vector<uint32> parents(count);
+  Vector<Vector3> positions(count);
+  Vector<Quaternion> rotations(count);
+  Vector<Vector3> scales(count);
+  Vector<uint32> childCounts(count, 0);
+  for (SIZE_T i = 0; i < count; ++i) {
+    const GameObjectDesc& desc = descs[i];
+    CH_ASSERT(desc.parent == NO_PARENT || desc.parent < i);
+    parents[i] = desc.parent;
+    positions[i] = desc.position;
+    rotations[i] = desc.rotation;
+    scales[i] = desc.scale;
+    if (desc.parent != NO_PARENT) {
+      ++childCounts[desc.parent];
+    }
+  }
+
+  Vector<TransformHierarchy::NodeId> nodes(count);
+  m_transformHierarchy->createNodes(count, parents.data(), positions.data(),
+                                    rotations.data(), scales.data(), nodes.data());
+
+  Vector<SPtr<GameObject>> objects;
+  objects.reserve(count);
+  m_gameObjectsMap.reserve(m_gameObjectsMap.size() + count);
+  for (SIZE_T i = 0; i < count; ++i) {
+    const GameObjectDesc& desc = descs[i];
+    SPtr<GameObject> newObject =
+        chMakeShared<GameObject>(desc.name, m_registry, m_transformHierarchy, nodes[i]);
+    newObject->setActive(desc.active);
+    newObject->reserveChildren(childCounts[i]);
+    if (desc.parent != NO_PARENT) {
+      objects[desc.parent]->addChild(newObject);
+    }
+    else {
+      m_rootGameObjects.push_back(newObject);
+    }
+    m_gameObjectsMap[desc.name] = newObject;
+    objects.push_back(std::move(newObject));
+  }
+  return objects;
+}
+
+/*
+*/
+void
+Scene::destroyGameObject(const SPtr<GameObject>& gameObject) {
+  CH_ASSERT(gameObject);
+  if (SPtr<GameObject> parent = gameObject->getParent()) {
+    parent->removeChild(gameObject);
+  }
+  else {
+    auto it = std::find(m_rootGameObjects.begin(), m_rootGameObjects.end(), gameObject);
+    if (it != m_rootGameObjects.end()) {
+      m_rootGameObjects.erase(it);
+    }
+  }
+
+  Vector<GameObject*> pending = {gameObject.get()};
+  while (!pending.empty()) {
+    GameObject* current = pending.back();
+    pending.pop_back();
+
+    // Names are not unique, only drop the entry when it points to this GameObject
+    auto it = m_gameObjectsMap.find(current->getName());
+    if (it != m_gameObjectsMap.end() && it->second.get() == current) {
+      m_gameObjectsMap.erase(it);
+    }
+
+    // Nodes kept alive by outside references would otherwise still answer queries
+    removeSpatialEntry(current->getTransformNode());
+
+    // Pools are updated without walking the tree, the components must leave them
+    current->removeAllComponents();
+    for (const SPtr<GameObject>& child : current->getChildren()) {
+      pending.push_back(child.get());
+    }
+  }
+}
+
+/*
+*/
+void
+Scene::reserveGameObjects(uint32 count) {
+  m_transformHierarchy->reserve(count);
+  m_gameObjectsMap.reserve(count);
+  m_spatialEntries.reserve(count);
+}
+
+/*
+*/
+void
+Scene::setGameObjectBounds(const SPtr<GameObject>& gameObject, const AABox& localBounds) {
+  CH_ASSERT(gameObject);
+  const TransformHierarchy::NodeId node = gameObject->getTransformNode();
+  if (!m_transformHierarchy->isValid(node)) {
+    return;
+  }
+
+  if (node >= m_spatialEntries.size()) {
+    m_spatialEntries.resize(node + 1);
+  }
+
+  SpatialEntry& entry = m_spatialEntries[node];
+  entry.localBounds = localBounds;
+  const AABox worldBounds =
+      m_transformHierarchy->getWorldMatrix(node).transformBox(localBounds);
+  if (entry.proxy == DynamicAABBTree<GameObject*>::INVALID_PROXY) {
+    entry.proxy = m_spatialIndex.insert(worldBounds, gameObject.get());
+  }
+  else {
+    m_spatialIndex.move(entry.proxy, worldBounds);
+  }
+}
+
+/*
+*/
+void
+Scene::removeGameObjectBounds(const SPtr<GameObject>& gameObject) {
+  CH_ASSERT(gameObject);
+  removeSpatialEntry(gameObject->getTransformNode());
+}
+
+/*
+*/
+void
+Scene::removeSpatialEntry(TransformHierarchy::NodeId node) {
+  if (node >= m_spatialEntries.size() ||
+      m_spatialEntries[node].proxy == DynamicAABBTree<GameObject*>::INVALID_PROXY) {
+    return;
+  }
+
+  m_spatialIndex.remove(m_spatialEntries[node].proxy);
+  m_spatialEntries[node] = SpatialEntry();
+}
+
+/*
+*/
+bool
+Scene::getGameObjectBounds(const GameObject& gameObject, AABox& outLocalBounds) const {
+  const TransformHierarchy::NodeId node = gameObject.getTransformNode();
+  if (node >= m_spatialEntries.size() ||
+      m_spatialEntries[node].proxy == DynamicAABBTree<GameObject*>::INVALID_PROXY) {
+    return false;
+  }
+
+  outLocalBounds = m_spatialEntries[node].localBounds;
+  return true;
+}
+
+/*
+*/
+void
+Scene::updateSpatialIndex() {
+  m_updatedNodes.clear();
+  m_transformHierarchy->updateWorldMatrices(&m_updatedNodes);
+
+  for (const TransformHierarchy::NodeId node : m_updatedNodes) {
+    if (node >= m_spatialEntries.size()) {
+      continue;
+    }
+
+    const SpatialEntry& entry = m_spatialEntries[node];
+    if (entry.proxy != DynamicAABBTree<GameObject*>::INVALID_PROXY) {
+      m_spatialIndex.move(entry.proxy, m_transformHierarchy->getWorldMatrix(node)
+                                            .transformBox(entry.localBounds));
+    }
+  }
+}
+
+/*
+*/
+void
+Scene::update(float deltaTime) {
+  m_updateScheduler.update(*m_registry, m_rootGameObjects, deltaTime);
+  updateSpatialIndex();
+}
+
 } // namespace chEngineSDK
@@ -12,22 +12,46 @@
 #include "chPrerequisitesCore.h"
 
 #include "chObject.h"
+#include "chDynamicAABBTree.h"
 #include "chGameObject.h"
+#include "chSceneUpdateScheduler.h"
 
 namespace chEngineSDK {
 class CH_CORE_EXPORT Scene : public Object {
  public:
+  static constexpr uint32 NO_PARENT = TransformHierarchy::INVALID_NODE;
+
+  /**
+   * GameObject created in bulk by createGameObjects()
+   */
+  struct GameObjectDesc
+  {
+    String name;
+    uint32 parent = NO_PARENT; ///< Position of the parent in the batch, lower than this one
+    Vector3 position = Vector3::ZERO;
+    Quaternion rotation = Quaternion::IDENTITY;
+    Vector3 scale = Vector3::UNIT;
+    bool active = true;
+  };
+
   /**
    * Constructor
    *
    * @param name Name of the scene
+   * @param createRoot Create the default Root GameObject, loaders that bring their own
+   *                   root skip it
    */
-  Scene(const String& name, UUID id);
+  Scene(const String& name, UUID id, bool createRoot = true);
 
   /**
-   * Destructor
+   * Destructor, drops every transform node at once instead of one GameObject at a time.
+   * GameObjects still referenced elsewhere are left without a node.
    */
-  ~Scene() = default;
+  ~Scene();
+
+  Scene(const Scene&) = delete;
+  Scene&
+  operator=(const Scene&) = delete;
 
   /**
    * Create a new GameObject in the scene
@@ -39,6 +63,26 @@ class CH_CORE_EXPORT Scene : public Object {
   SPtr<GameObject>
   createGameObject(const String& name, SPtr<GameObject> parent = nullptr);
 
+  /**
+   * Create many GameObjects at once, their transform nodes are appended in one batch and
+   * every children list grows once
+   *
+   * @param descs GameObjects to create, parents first. Those without parent become roots
+   * @return The created GameObjects, in the order of descs
+   */
+  Vector<SPtr<GameObject>>
+  createGameObjects(const Vector<GameObjectDesc>& descs);
+
+  /**
+   * Remove a GameObject and its children from the scene
+   * They leave the spatial index and lose their components right away, their transform
+   * nodes are destroyed once the last reference to them goes away.
+   *
+   * @param gameObject GameObject to remove
+   */
+  void
+  destroyGameObject(const SPtr<GameObject>& gameObject);
+
   /**
    * Find a GameObject by name
    *
@@ -56,8 +100,81 @@ class CH_CORE_EXPORT Scene : public Object {
   NODISCARD const Vector<SPtr<GameObject>>&
   getRootGameObjects() const { return m_rootGameObjects; }
 
+  /**
+   * Get the registry holding the entity data of every GameObject in the scene
+   *
+   * @return Reference to the scene registry
+   */
+  NODISCARD EntityRegistry&
+  getRegistry() const { return *m_registry; }
+
+  /**
+   * Get the flat transform hierarchy of the scene
+   *
+   * @return Reference to the transform hierarchy
+   */
+  NODISCARD TransformHierarchy&
+  getTransformHierarchy() { return *m_transformHierarchy; }
+
+  NODISCARD const TransformHierarchy&
+  getTransformHierarchy() const { return *m_transformHierarchy; }
+
+  /**
+   * Reserve room for GameObjects about to be created, used by bulk loads
+   *
+   * @param count Amount of GameObjects the scene will hold
+   */
+  void
+  reserveGameObjects(uint32 count);
+
+  /**
+   * Give a GameObject bounds so it can be found by spatial queries
+   * Calling it again replaces the bounds, they are removed when the GameObject is destroyed.
+   *
+   * @param gameObject GameObject to register
+   * @param localBounds Bounds in the space of the GameObject transform
+   */
+  void
+  setGameObjectBounds(const SPtr<GameObject>& gameObject, const AABox& localBounds);
+
+  /**
+   * Remove a GameObject from the spatial index
+   *
+   * @param gameObject GameObject to remove, nothing happens if it has no bounds
+   */
+  void
+  removeGameObjectBounds(const SPtr<GameObject>& gameObject);
+
+  /**
+   * Get the bounds given to a GameObject with setGameObjectBounds()
+   *
+   * @param gameObject GameObject to look up
+   * @param outLocalBounds Receives the bounds in the space of the GameObject transform
+   * @return True if the GameObject has bounds
+   */
+  NODISCARD bool
+  getGameObjectBounds(const GameObject& gameObject, AABox& outLocalBounds) const;
+
+  /**
+   * Update world transforms and move the bounds of every GameObject that changed
+   * Only nodes recomputed by the transform hierarchy are visited.
+   */
+  void
+  updateSpatialIndex();
+
+  /**
+   * Get the spatial index of the scene, used for picking, culling and streaming queries
+   * World bounds are as of the last updateSpatialIndex().
+   *
+   * @return Reference to the spatial index
+   */
+  NODISCARD const DynamicAABBTree<GameObject*>&
+  getSpatialIndex() const { return m_spatialIndex; }
+
   /**
    * Update all GameObjects in the scene
+   * Components run in parallel phases built from their declared access, then the spatial
+   * index picks up the moved transforms.
    *
    * @param deltaTime Time elapsed since the last update
    */
@@ -65,6 +182,31 @@ class CH_CORE_EXPORT Scene : public Object {
   update(float deltaTime);
 
  private:
+  using ProxyId = DynamicAABBTree<GameObject*>::ProxyId;
+
+  /**
+   * Drops the spatial proxy of a node, also called for destroyed nodes before their id
+   * is reused
+   */
+  void
+  removeSpatialEntry(TransformHierarchy::NodeId node);
+
+  struct SpatialEntry
+  {
+    ProxyId proxy = DynamicAABBTree<GameObject*>::INVALID_PROXY;
+    AABox localBounds;
+  };
+
+  SPtr<EntityRegistry> m_registry;
+
+  // Shared with the GameObjects, they destroy their own nodes
+  SPtr<TransformHierarchy> m_transformHierarchy;
+  DynamicAABBTree<GameObject*> m_spatialIndex;
+  SceneUpdateScheduler m_updateScheduler;
+
+  // Indexed by transform node id
+  Vector<SpatialEntry> m_spatialEntries;
+  Vector<TransformHierarchy::NodeId> m_updatedNodes;
   Vector<SPtr<GameObject>> m_rootGameObjects;
   UnorderedMap<String, SPtr<GameObject>> m_gameObjectsMap;
 };
@@ -76,7 +76,7 @@ class CH_CORE_EXPORT SceneManager : public Module<SceneManager>
   getScene(const UUID& uuid) const;
 
   /**
-   * Update all scenes
+   * Update the active scene
    *
    * @param deltaTime Time elapsed since the last update
    */
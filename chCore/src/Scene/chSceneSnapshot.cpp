@@ -0,0 +1,287 @@
+/************************************************************************/
+/**
+ * @file chSceneSnapshot.cpp
+ * @author AccelMR
+ * @date 2025/08/01
+ * @brief
+ *  Binary scene snapshot, flat tables written and read in one block each.
+ */
+/************************************************************************/
+#include "chSceneSnapshot.h"
+
+#include "chFileStream.h"
+#include "chLogger.h"
+#include "chScene.h"
+
+namespace chEngineSDK {
+
+CH_LOG_DECLARE_STATIC(SceneSnapshotLog, All);
+
+namespace {
+constexpr uint32 NO_PARENT = 0xFFFFFFFF;
+
+constexpr uint32 OBJECT_ACTIVE = 1 << 0;
+constexpr uint32 OBJECT_HAS_BOUNDS = 1 << 1;
+constexpr uint32 COMPONENT_ENABLED = 1 << 0;
+
+struct SnapshotHeader
+{
+  uint32 magic;
+  uint32 version;
+  uint32 objectCount;
+  uint32 componentCount;
+  uint32 blobSize;
+};
+
+// Math types are stored as plain floats, they are not trivially copyable
+struct ObjectRecord
+{
+  uint32 parent;
+  uint32 nameOffset;
+  uint32 nameSize;
+  uint32 flags;
+  float position[3];
+  float rotation[4];
+  float scale[3];
+  float boundsMin[3];
+  float boundsMax[3];
+};
+
+struct ComponentRecord
+{
+  UUID typeId;
+  uint32 owner;
+  uint32 dataOffset;
+  uint32 dataSize;
+  uint32 flags;
+};
+
+static_assert(std::is_trivially_copyable_v<ObjectRecord>, "Records are copied as raw bytes.");
+static_assert(std::is_trivially_copyable_v<ComponentRecord>,
+              "Records are copied as raw bytes.");
+
+struct ComponentRegistry
+{
+  UnorderedMap<std::type_index, UUID> typeIds;
+  UnorderedMap<UUID, SceneSnapshot::ComponentCreatorFunc> creators;
+};
+
+void
+storeVector(float* out, const Vector3& value) {
+  out[0] = value.x;
+  out[1] = value.y;
+  out[2] = value.z;
+}
+
+Vector3
+loadVector(const float* values) {
+  return Vector3(values[0], values[1], values[2]);
+}
+
+ComponentRegistry&
+getComponentRegistry() {
+  static ComponentRegistry registry;
+  return registry;
+}
+
+template<typename T>
+bool
+readTable(const SPtr<DataStream>& stream, Vector<T>& table, uint32 count) {
+  table.resize(count);
+  const SIZE_T bytes = sizeof(T) * count;
+  return bytes == 0 || stream->read(table.data(), bytes) == bytes;
+}
+} // namespace
+
+/*
+*/
+void
+SceneSnapshot::registerComponentType(std::type_index type,
+                                     const UUID& typeId,
+                                     ComponentCreatorFunc creator) {
+  CH_ASSERT(!typeId.isNull() && "Component type needs DECLARE_TYPE_TRAITS.");
+  ComponentRegistry& registry = getComponentRegistry();
+  registry.typeIds[type] = typeId;
+  registry.creators[typeId] = std::move(creator);
+}
+
+/*
+*/
+bool
+SceneSnapshot::save(const Scene& scene, const SPtr<DataStream>& stream) {
+  if (!stream || !stream->isWriteable()) {
+    CH_LOG_ERROR(SceneSnapshotLog, "Scene snapshot needs a writable stream.");
+    return false;
+  }
+
+  const ComponentRegistry& registry = getComponentRegistry();
+
+  Vector<ObjectRecord> objects;
+  Vector<ComponentRecord> components;
+  Vector<uint8> blob;
+  uint32 skippedComponents = 0;
+
+  // Preorder walk so every parent lands in the table before its children
+  Vector<Pair<GameObject*, uint32>> stack;
+  const Vector<SPtr<GameObject>>& roots = scene.getRootGameObjects();
+  for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+    stack.emplace_back(it->get(), NO_PARENT);
+  }
+
+  while (!stack.empty()) {
+    auto [gameObject, parent] = stack.back();
+    stack.pop_back();
+    const uint32 index = static_cast<uint32>(objects.size());
+
+    ObjectRecord& record = objects.emplace_back();
+    record.parent = parent;
+    record.nameOffset = static_cast<uint32>(blob.size());
+    record.nameSize = static_cast<uint32>(gameObject->getName().size());
+    record.flags = gameObject->isActive() ? OBJECT_ACTIVE : 0;
+    blob.insert(blob.end(), gameObject->getName().begin(), gameObject->getName().end());
+
+    const Quaternion& rotation = gameObject->getLocalRotation();
+    storeVector(record.position, gameObject->getLocalPosition());
+    storeVector(record.scale, gameObject->getLocalScale());
+    record.rotation[0] = rotation.x;
+    record.rotation[1] = rotation.y;
+    record.rotation[2] = rotation.z;
+    record.rotation[3] = rotation.w;
+
+    AABox localBounds;
+    if (scene.getGameObjectBounds(*gameObject, localBounds)) {
+      record.flags |= OBJECT_HAS_BOUNDS;
+      storeVector(record.boundsMin, localBounds.minPoint);
+      storeVector(record.boundsMax, localBounds.maxPoint);
+    }
+
+    gameObject->eachComponent([&](const std::type_index& type, const Component& component) {
+      auto typeIt = registry.typeIds.find(type);
+      if (typeIt == registry.typeIds.end()) {
+        ++skippedComponents;
+        return;
+      }
+
+      ComponentRecord& componentRecord = components.emplace_back();
+      componentRecord.typeId = typeIt->second;
+      componentRecord.owner = index;
+      componentRecord.dataOffset = static_cast<uint32>(blob.size());
+      componentRecord.flags = component.isEnabled() ? COMPONENT_ENABLED : 0;
+      component.serialize(blob);
+      componentRecord.dataSize =
+          static_cast<uint32>(blob.size()) - componentRecord.dataOffset;
+    });
+
+    const Vector<SPtr<GameObject>>& children = gameObject->getChildren();
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      stack.emplace_back(it->get(), index);
+    }
+  }
+
+  if (skippedComponents > 0) {
+    CH_LOG_WARNING(SceneSnapshotLog,
+                   "{0} components of unregistered types were not saved.",
+                   skippedComponents);
+  }
+
+  const SnapshotHeader header = {.magic = MAGIC,
+                                 .version = VERSION,
+                                 .objectCount = static_cast<uint32>(objects.size()),
+                                 .componentCount = static_cast<uint32>(components.size()),
+                                 .blobSize = static_cast<uint32>(blob.size())};
+  stream << header;
+  stream->write(objects.data(), objects.size() * sizeof(ObjectRecord));
+  stream->write(components.data(), components.size() * sizeof(ComponentRecord));
+  stream->write(blob.data(), blob.size());
+  return true;
+}
+
+/*
+*/
+SPtr<Scene>
+SceneSnapshot::load(const SPtr<DataStream>& stream, const String& name, const UUID& id) {
+  if (!stream || !stream->isReadable()) {
+    CH_LOG_ERROR(SceneSnapshotLog, "Scene snapshot needs a readable stream.");
+    return nullptr;
+  }
+
+  SnapshotHeader header;
+  if (stream->read(&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC ||
+      header.version != VERSION) {
+    CH_LOG_ERROR(SceneSnapshotLog, "Scene '{0}' is not a valid snapshot.", name);
+    return nullptr;
+  }
+
+  Vector<ObjectRecord> objectRecords;
+  Vector<ComponentRecord> componentRecords;
+  Vector<uint8> blob;
+  if (!readTable(stream, objectRecords, header.objectCount) ||
+      !readTable(stream, componentRecords, header.componentCount) ||
+      !readTable(stream, blob, header.blobSize)) {
+    CH_LOG_ERROR(SceneSnapshotLog, "Scene '{0}' snapshot is truncated.", name);
+    return nullptr;
+  }
+
+  // Whole table is checked before anything is created
+  Vector<Scene::GameObjectDesc> descs(header.objectCount);
+  for (uint32 i = 0; i < header.objectCount; ++i) {
+    const ObjectRecord& record = objectRecords[i];
+    if ((record.parent != NO_PARENT && record.parent >= i) ||
+        static_cast<SIZE_T>(record.nameOffset) + record.nameSize > blob.size()) {
+      CH_LOG_ERROR(SceneSnapshotLog,
+                   "Scene '{0}' snapshot has a corrupt object table.",
+                   name);
+      return nullptr;
+    }
+
+    Scene::GameObjectDesc& desc = descs[i];
+    desc.name.assign(reinterpret_cast<const char*>(blob.data()) + record.nameOffset,
+                     record.nameSize);
+    desc.parent = record.parent != NO_PARENT ? record.parent : Scene::NO_PARENT;
+    desc.position = loadVector(record.position);
+    desc.rotation = Quaternion(record.rotation[0], record.rotation[1], record.rotation[2],
+                               record.rotation[3]);
+    desc.scale = loadVector(record.scale);
+    desc.active = (record.flags & OBJECT_ACTIVE) != 0;
+  }
+
+  // The snapshot holds the saved root, an empty one still gets the default root
+  SPtr<Scene> scene = chMakeShared<Scene>(name, id, header.objectCount == 0);
+  scene->reserveGameObjects(header.objectCount);
+  TransformHierarchy& hierarchy = scene->getTransformHierarchy();
+  const Vector<SPtr<GameObject>> objects = scene->createGameObjects(descs);
+
+  // Bounds go in with final world matrices so the spatial index is built once
+  hierarchy.updateWorldMatrices();
+  for (uint32 i = 0; i < header.objectCount; ++i) {
+    const ObjectRecord& record = objectRecords[i];
+    if (record.flags & OBJECT_HAS_BOUNDS) {
+      scene->setGameObjectBounds(objects[i], AABox(loadVector(record.boundsMin),
+                                                   loadVector(record.boundsMax)));
+    }
+  }
+
+  const ComponentRegistry& registry = getComponentRegistry();
+  for (const ComponentRecord& record : componentRecords) {
+    auto creatorIt = registry.creators.find(record.typeId);
+    if (record.owner >= objects.size() ||
+        static_cast<SIZE_T>(record.dataOffset) + record.dataSize > blob.size() ||
+        creatorIt == registry.creators.end()) {
+      CH_LOG_WARNING(SceneSnapshotLog,
+                     "Skipping component {0} in scene '{1}'.",
+                     record.typeId.toString(), name);
+      continue;
+    }
+
+    Component* component = creatorIt->second(*objects[record.owner]);
+    if (!component->deserialize(blob.data() + record.dataOffset, record.dataSize)) {
+      CH_LOG_WARNING(SceneSnapshotLog,
+                     "Component {0} in scene '{1}' could not read its state.",
+                     record.typeId.toString(), name);
+    }
+    component->setEnabled((record.flags & COMPONENT_ENABLED) != 0);
+  }
+
+  return scene;
+}
+} // namespace chEngineSDK
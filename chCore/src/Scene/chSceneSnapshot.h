@@ -0,0 +1,86 @@
+/************************************************************************/
+/**
+ * @file chSceneSnapshot.h
+ * @author AccelMR
+ * @date 2025/08/01
+ * @brief
+ *  Binary scene snapshot, flat tables written and read in one block each.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chGameObject.h"
+#include "chTypeTraits.h"
+
+#include <typeindex>
+
+namespace chEngineSDK {
+
+/*
+ * Description:
+ *     Saves a scene as a header followed by a GameObject table, a component table and a
+ *     blob holding names and component state. GameObjects are stored parents first and
+ *     reference each other by table index, loading reads every table with a single read
+ *     and creates every GameObject and transform node in one batch from the object table.
+ *
+ *     Components are only saved when their type was registered, their state comes from
+ *     Component::serialize(). The loaded scene takes the saved root instead of creating
+ *     a default one.
+ *
+ * Sample usage:
+ *  SceneSnapshot::registerComponent<RotatorComponent>();
+ *  SceneSnapshot::save(*scene, stream);
+ *  SPtr<Scene> loaded = SceneSnapshot::load(stream, "Level", sceneId);
+ */
+class CH_CORE_EXPORT SceneSnapshot
+{
+ public:
+  static constexpr uint32 MAGIC = 0x53534843; // "CHSS"
+  static constexpr uint32 VERSION = 1;
+
+  using ComponentCreatorFunc = Function<Component*(GameObject& owner)>;
+
+  /**
+   * Register a component type so it can be saved and created again on load
+   * The type needs DECLARE_TYPE_TRAITS and a default constructor.
+   */
+  template<typename T>
+  static void
+  registerComponent() {
+    static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+    registerComponentType(std::type_index(typeid(T)), TypeTraits<T>::getTypeId(),
+                          [](GameObject& owner) -> Component* {
+                            return &owner.addComponent<T>();
+                          });
+  }
+
+  /**
+   * Write the scene to the stream
+   *
+   * @param scene Scene to save
+   * @param stream Writable stream
+   * @return True if the snapshot was written
+   */
+  static bool
+  save(const Scene& scene, const SPtr<DataStream>& stream);
+
+  /**
+   * Create a scene from a snapshot
+   *
+   * @param stream Stream positioned at the start of the snapshot
+   * @param name Name of the new scene
+   * @param id Id of the new scene
+   * @return The loaded scene, or nullptr if the snapshot is invalid
+   */
+  NODISCARD static SPtr<Scene>
+  load(const SPtr<DataStream>& stream, const String& name, const UUID& id);
+
+ private:
+  static void
+  registerComponentType(std::type_index type,
+                        const UUID& typeId,
+                        ComponentCreatorFunc creator);
+};
+} // namespace chEngineSDK
@@ -0,0 +1,181 @@
+/************************************************************************/
+/**
+ * @file chSceneUpdateScheduler.cpp
+ * @author AccelMR
+ * @date 2025/07/31
+ * @brief
+ *  Runs the component updates of a scene in parallel phases.
+ */
+/************************************************************************/
+#include "chSceneUpdateScheduler.h"
+
+#include "chGameObject.h"
+#include "chJobSystem.h"
+
+namespace chEngineSDK {
+namespace {
+bool
+sharesType(const Vector<std::type_index>& a, const Vector<std::type_index>& b) {
+  for (const std::type_index& type : a) {
+    if (std::find(b.begin(), b.end(), type) != b.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+/*
+*/
+void
+SceneUpdateScheduler::update(EntityRegistry& registry,
+                             const Vector<SPtr<GameObject>>& roots,
+                             float deltaTime) {
+  gatherPools(registry);
+
+  m_serialComponents.clear();
+  if (m_serialGroupIndex != INVALID_GROUP) {
+    for (const SPtr<GameObject>& root : roots) {
+      gatherSerial(*root);
+    }
+  }
+
+  if (m_phasesDirty) {
+    buildPhases();
+  }
+
+  JobSystem* jobSystem = JobSystem::isStarted() ? JobSystem::instancePtr() : nullptr;
+  for (const Vector<uint32>& phase : m_phases) {
+    JobCounter counter;
+    for (const uint32 groupIndex : phase) {
+      if (groupIndex == m_serialGroupIndex) {
+        for (Component* component : m_serialComponents) {
+          component->update(deltaTime);
+        }
+        continue;
+      }
+
+      const UpdateGroup& group = m_groups[groupIndex];
+      const SIZE_T count = group.pool ? group.pool->size() : 0;
+      if (count == 0) {
+        continue;
+      }
+
+      IComponentPool* pool = group.pool;
+      if (!jobSystem) {
+        pool->updateComponents(0, count, deltaTime);
+        continue;
+      }
+
+      // Instances writing the same shared data are serialized inside one job
+      const SIZE_T batchSize = group.access.writes.empty() ? INSTANCE_BATCH_SIZE : count;
+      for (SIZE_T begin = 0; begin < count; begin += batchSize) {
+        const SIZE_T end = Math::min(begin + batchSize, count);
+        jobSystem->schedule([pool, begin, end, deltaTime]() {
+          pool->updateComponents(begin, end, deltaTime);
+        }, &counter);
+      }
+    }
+
+    if (jobSystem) {
+      jobSystem->wait(counter);
+    }
+  }
+}
+
+/*
+*/
+void
+SceneUpdateScheduler::gatherPools(EntityRegistry& registry) {
+  for (UpdateGroup& group : m_groups) {
+    group.pool = nullptr;
+  }
+
+  registry.eachPool([this](const std::type_index& type, IComponentPool& pool) {
+    if (!pool.isComponentPool()) {
+      return;
+    }
+
+    auto it = m_groupIndices.find(type);
+    if (it == m_groupIndices.end()) {
+      // The access is declared by an instance, empty pools wait for one
+      if (pool.size() == 0) {
+        return;
+      }
+
+      ComponentAccess access;
+      pool.getComponent(0)->declareAccess(access);
+
+      // Every exclusive type shares the serial group, keeping the per object order
+      uint32 groupIndex = access.exclusive ? m_serialGroupIndex : INVALID_GROUP;
+      if (groupIndex == INVALID_GROUP) {
+        groupIndex = static_cast<uint32>(m_groups.size());
+        if (access.exclusive) {
+          m_serialGroupIndex = groupIndex;
+        }
+        m_groups.push_back({std::move(access), nullptr});
+        m_phasesDirty = true;
+      }
+      it = m_groupIndices.emplace(type, groupIndex).first;
+    }
+
+    if (it->second != m_serialGroupIndex) {
+      m_groups[it->second].pool = &pool;
+    }
+  });
+}
+
+/*
+*/
+void
+SceneUpdateScheduler::gatherSerial(const GameObject& gameObject) {
+  if (!gameObject.isActive()) {
+    return;
+  }
+
+  gameObject.eachComponent([this](const std::type_index& type, Component& component) {
+    auto it = m_groupIndices.find(type);
+    if (it != m_groupIndices.end() && it->second == m_serialGroupIndex &&
+        component.isUpdatable()) {
+      m_serialComponents.push_back(&component);
+    }
+  });
+
+  for (const SPtr<GameObject>& child : gameObject.getChildren()) {
+    gatherSerial(*child);
+  }
+}
+
+/*
+*/
+void
+SceneUpdateScheduler::buildPhases() {
+  m_phases.clear();
+  Vector<uint32> groupPhases(m_groups.size(), 0);
+  for (SIZE_T i = 0; i < m_groups.size(); ++i) {
+    uint32 phase = 0;
+    for (SIZE_T j = 0; j < i; ++j) {
+      if (conflicts(m_groups[i].access, m_groups[j].access)) {
+        phase = Math::max(phase, groupPhases[j] + 1);
+      }
+    }
+
+    groupPhases[i] = phase;
+    if (phase >= m_phases.size()) {
+      m_phases.resize(phase + 1);
+    }
+    m_phases[phase].push_back(static_cast<uint32>(i));
+  }
+  m_phasesDirty = false;
+}
+
+/*
+*/
+bool
+SceneUpdateScheduler::conflicts(const ComponentAccess& a, const ComponentAccess& b) {
+  return a.exclusive || b.exclusive ||
+         sharesType(a.writes, b.writes) ||
+         sharesType(a.writes, b.reads) ||
+         sharesType(a.reads, b.writes);
+}
+} // namespace chEngineSDK
@@ -0,0 +1,106 @@
+/************************************************************************/
+/**
+ * @file chSceneUpdateScheduler.h
+ * @author AccelMR
+ * @date 2025/07/31
+ * @brief
+ *  Runs the component updates of a scene in parallel phases.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesCore.h"
+
+#include "chComponent.h"
+#include "chEntityRegistry.h"
+
+namespace chEngineSDK {
+
+class GameObject;
+
+/*
+ * Description:
+ *     Groups the components of a scene by type and sorts the groups into phases from
+ *     their declared access. Groups in the same phase share no written data and run
+ *     together on the JobSystem, a group that conflicts with an earlier one waits for it
+ *     in a later phase. Groups are ordered by the creation of their registry pools.
+ *
+ *     A type with declared access is updated straight from its registry pool, walking the
+ *     contiguous components in parallel batches, or inside a single job when the type
+ *     writes shared data. Components whose owner is inactive or that are disabled are
+ *     skipped through a flag stored in the component.
+ *
+ *     Exclusive types, the ones that do not declare their access, share one serial group
+ *     that runs alone on the calling thread in scene order, component by component on
+ *     each GameObject. Only this group walks the GameObject tree. It takes the phase slot
+ *     of the first exclusive type found. Without a started JobSystem everything runs
+ *     inline.
+ *
+ *     Components and GameObjects must not be added or removed during an update, pools
+ *     may reallocate.
+ *
+ * Sample usage:
+ *  m_updateScheduler.update(*m_registry, m_rootGameObjects, deltaTime);
+ */
+class CH_CORE_EXPORT SceneUpdateScheduler
+{
+ public:
+  static constexpr SIZE_T INSTANCE_BATCH_SIZE = 32;
+  static constexpr uint32 INVALID_GROUP = UINT32_MAX;
+
+  /**
+   * Update the enabled components of every active GameObject of the scene
+   *
+   * @param registry Registry storing the components of the scene
+   * @param roots Root GameObjects of the scene, walked for the exclusive components
+   * @param deltaTime Time elapsed since the last update
+   */
+  void
+  update(EntityRegistry& registry, const Vector<SPtr<GameObject>>& roots, float deltaTime);
+
+  /**
+   * Get the number of phases, groups inside a phase run concurrently
+   *
+   * @return Phase count of the component types seen so far
+   */
+  NODISCARD uint32
+  getPhaseCount() const { return static_cast<uint32>(m_phases.size()); }
+
+ private:
+  struct UpdateGroup
+  {
+    ComponentAccess access;
+    IComponentPool* pool = nullptr; ///< Pool of the type, null for the serial group
+  };
+
+  /**
+   * Finds the groups of new component types and points every group to its pool
+   */
+  void
+  gatherPools(EntityRegistry& registry);
+
+  /**
+   * Collects the exclusive components in scene order
+   */
+  void
+  gatherSerial(const GameObject& gameObject);
+
+  /**
+   * Places every group one phase after the last earlier group it conflicts with
+   */
+  void
+  buildPhases();
+
+  NODISCARD static bool
+  conflicts(const ComponentAccess& a, const ComponentAccess& b);
+
+  UnorderedMap<std::type_index, uint32> m_groupIndices;
+
+  // In the order the types were first found in the scene
+  Vector<UpdateGroup> m_groups;
+  Vector<Component*> m_serialComponents;
+  Vector<Vector<uint32>> m_phases;
+  uint32 m_serialGroupIndex = INVALID_GROUP;
+  bool m_phasesDirty = false;
+};
+} // namespace chEngineSDK
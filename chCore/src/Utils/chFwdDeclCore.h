@@ -55,6 +55,6 @@ class Scene;
 class SceneAsset;
 class SceneManager;
 class GameObject;
-class Transform;
+class EntityRegistry;
 
 } // namespace chEngineSDK
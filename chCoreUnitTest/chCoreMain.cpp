@@ -0,0 +1,1158 @@
+/************************************************************************/
+/**
+ * @file chCoreMain.cpp
+ * @author AccelMR
+ * @date 2025/08/11
+ * @brief Unit tests of the chCore pieces that don't need a window or a graphics API.
+ */
+/************************************************************************/
+#include "chBox.h"
+#include "chDegree.h"
+#include "chFileStream.h"
+#include "chGeometryPool.h"
+#include "chIBuffer.h"
+#include "chIGraphicsAPI.h"
+#include "chJobSystem.h"
+#include "chLogger.h"
+#include "chMatrixHelpers.h"
+#include "chMesh.h"
+#include "chModel.h"
+#include "chRenderGraph.h"
+#include "chScene.h"
+#include "chSceneSnapshot.h"
+#include "chSceneUpdateScheduler.h"
+#include "chTypeTraits.h"
+
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+using namespace chEngineSDK;
+
+// chCore logs through the Logger module, it has to be running for every test. Modules
+// can't start again once shut down, the JobSystem lives for the whole run so every test
+// can go through the parallel paths
+int main(int argc, char* argv[]) {
+  Logger::startUp();
+  JobSystem::startUp(2u);
+  const int result = Catch::Session().run(argc, argv);
+  if (IGraphicsAPI::isStarted()) {
+    IGraphicsAPI::shutDown();
+  }
+  JobSystem::shutDown();
+  Logger::shutDown();
+  return result;
+}
+
+namespace {
+/**
+ * Component with state that goes through the snapshot
+ */
+class SnapshotTestComponent : public Component
+{
+ public:
+  void
+  serialize(Vector<uint8>& data) const override {
+    const uint8* bytes = reinterpret_cast<const uint8*>(&m_state);
+    data.insert(data.end(), bytes, bytes + sizeof(m_state));
+  }
+
+  bool
+  deserialize(const uint8* data, SIZE_T size) override {
+    if (size != sizeof(m_state)) {
+      return false;
+    }
+    std::memcpy(&m_state, data, sizeof(m_state));
+    return true;
+  }
+
+  struct State
+  {
+    float speed = 0.0f;
+    int32 counter = 0;
+  };
+
+  State m_state;
+};
+
+/**
+ * Never registered, it must not show up in the loaded scene
+ */
+class UnregisteredTestComponent : public Component
+{};
+
+/**
+ * Exclusive component writing its tag to a shared list when updated
+ */
+template<char Tag>
+class OrderTestComponent : public Component
+{
+ public:
+  explicit OrderTestComponent(String* order) : m_order(order) {}
+
+  void
+  update(float deltaTime) override {
+    CH_PAMRAMETER_UNUSED(deltaTime);
+    m_order->push_back(Tag);
+  }
+
+ private:
+  String* m_order;
+};
+
+/**
+ * Component with declared access, only touches its own data
+ */
+class MoverTestComponent : public Component
+{
+ public:
+  MoverTestComponent() = default;
+  explicit MoverTestComponent(const Vector3& velocity) : m_velocity(velocity) {}
+
+  void
+  update(float deltaTime) override {
+    m_position += m_velocity * deltaTime;
+    ++m_updates;
+  }
+
+  void
+  declareAccess(ComponentAccess& access) const override {
+    CH_PAMRAMETER_UNUSED(access);
+  }
+
+  Vector3 m_position = Vector3::ZERO;
+  Vector3 m_velocity = Vector3::ZERO;
+  uint32 m_updates = 0;
+};
+
+struct TestPosition
+{
+  float value = 0.0f;
+};
+
+struct TestVelocity
+{
+  float value = 0.0f;
+};
+
+/**
+ * Buffer in CPU memory, lets the tests read back what was uploaded
+ */
+class TestBuffer : public IBuffer
+{
+ public:
+  explicit TestBuffer(uint32 size) : m_data(size) {}
+
+  void
+  update(const void* data, SIZE_T size, uint32 offset = 0) override {
+    REQUIRE(offset + size <= m_data.size());
+    std::memcpy(m_data.data() + offset, data, size);
+  }
+
+  NODISCARD SIZE_T
+  getSize() const override {
+    return m_data.size();
+  }
+
+  Vector<uint8> m_data;
+};
+
+/**
+ * Graphics API that only creates TestBuffers, everything else is left empty
+ */
+class TestGraphicsAPI : public IGraphicsAPI
+{
+ public:
+  void
+  initialize(const GraphicsAPIInfo&) override {}
+
+  NODISCARD String
+  getAdapterName() const override {
+    return "Test";
+  }
+
+  NODISCARD SPtr<ISwapChain>
+  createSwapChain(uint32, uint32, bool) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IBuffer>
+  createBuffer(const BufferCreateInfo& createInfo) override {
+    return chMakeShared<TestBuffer>(createInfo.size);
+  }
+
+  NODISCARD SPtr<ITexture>
+  createTexture(const TextureCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<ICommandPool>
+  createCommandPool(QueueType, bool) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IFence>
+  createFence(bool) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<ISemaphore>
+  createSemaphore() override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IShader>
+  createShader(const ShaderCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IPipeline>
+  createPipeline(const PipelineCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IRenderPass>
+  createRenderPass(const RenderPassCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IFrameBuffer>
+  createFrameBuffer(const FrameBufferCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<ICommandQueue>
+  getQueue(QueueType) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<ISampler>
+  createSampler(const SamplerCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IDescriptorSetLayout>
+  createDescriptorSetLayout(const DescriptorSetLayoutCreateInfo&) override {
+    return nullptr;
+  }
+
+  NODISCARD SPtr<IDescriptorPool>
+  createDescriptorPool(const DescriptorPoolCreateInfo&) override {
+    return nullptr;
+  }
+
+  void
+  updateDescriptorSets(const Vector<WriteDescriptorSet>&) override {}
+
+  void
+  flushUploads(bool) override {}
+
+  void
+  savePipelineCache() override {}
+
+  void
+  waitIdle() override {}
+
+  Any
+  execute(const String&, const Vector<Any>&) override {
+    return {};
+  }
+};
+
+/**
+ * Mesh with vertexCount distinct vertices and indexCount indices into them
+ */
+SPtr<Mesh>
+makeTestMesh(uint32 vertexCount, uint32 indexCount, float marker, bool shortIndices) {
+  Vector<VertexPosColor> vertices(vertexCount);
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    vertices[i].position = Vector3(marker, static_cast<float>(i), 0.0f);
+  }
+
+  auto mesh = chMakeShared<Mesh>();
+  mesh->setVertexData(vertices);
+  if (shortIndices) {
+    Vector<uint16> indices(indexCount);
+    for (uint32 i = 0; i < indexCount; ++i) {
+      indices[i] = static_cast<uint16>((i * 7) % vertexCount);
+    }
+    mesh->setIndexData(indices);
+  }
+  else {
+    Vector<uint32> indices(indexCount);
+    for (uint32 i = 0; i < indexCount; ++i) {
+      indices[i] = (i * 7) % vertexCount;
+    }
+    mesh->setIndexData(indices);
+  }
+  return mesh;
+}
+
+/**
+ * Checks the pool buffers hold the vertices and the widened indices of the mesh
+ */
+void
+requireUploaded(const GeometryPool& pool, const SPtr<Mesh>& mesh) {
+  const GeometryRange* range = pool.find(mesh.get());
+  REQUIRE(range != nullptr);
+
+  const Vector<uint8>& vertexData =
+      static_cast<const TestBuffer&>(*pool.getVertexBuffer()).m_data;
+  const Vector<uint8>& vertices = mesh->getVertexData();
+  const SIZE_T vertexStart =
+      static_cast<SIZE_T>(range->vertexOffset) * pool.getVertexLayout().getStride(0);
+  REQUIRE(std::equal(vertices.begin(), vertices.end(), vertexData.begin() + vertexStart));
+
+  Vector<uint32> indices = mesh->getIndicesAsUInt32();
+  if (mesh->getIndexType() == IndexType::UInt16) {
+    const Vector<uint16> shortIndices = mesh->getIndicesAsUInt16();
+    indices.assign(shortIndices.begin(), shortIndices.end());
+  }
+  const Vector<uint8>& indexData =
+      static_cast<const TestBuffer&>(*pool.getIndexBuffer()).m_data;
+  REQUIRE(std::memcmp(indexData.data() + static_cast<SIZE_T>(range->firstIndex) * 4,
+                      indices.data(),
+                      indices.size() * sizeof(uint32)) == 0);
+}
+} // namespace
+
+namespace chEngineSDK {
+DECLARE_TYPE_TRAITS(SnapshotTestComponent)
+} // namespace chEngineSDK
+
+/************************************************************************/
+/*
+ * Entity registry.
+ */
+/************************************************************************/
+TEST_CASE("chCore - EntityRegistry") {
+  EntityRegistry registry;
+  Vector<Entity> entities;
+  for (int32 i = 0; i < 4; ++i) {
+    entities.push_back(registry.create());
+    registry.emplace<TestPosition>(entities.back(), static_cast<float>(i));
+  }
+
+  SECTION("Components are added, replaced and removed") {
+    const Entity entity = entities[1];
+    REQUIRE(registry.has<TestPosition>(entity));
+    REQUIRE_FALSE(registry.has<TestVelocity>(entity));
+    REQUIRE(registry.get<TestPosition>(entity).value == 1.0f);
+
+    registry.emplace<TestPosition>(entity, 10.0f);
+    REQUIRE(registry.getPool<TestPosition>().size() == 4);
+    REQUIRE(registry.get<TestPosition>(entity).value == 10.0f);
+
+    registry.remove<TestPosition>(entity);
+    REQUIRE_FALSE(registry.has<TestPosition>(entity));
+    REQUIRE(registry.tryGet<TestPosition>(entity) == nullptr);
+    REQUIRE(registry.getPool<TestPosition>().size() == 3);
+
+    registry.destroy(entities[2]);
+    REQUIRE_FALSE(registry.isValid(entities[2]));
+    REQUIRE(registry.getEntityCount() == 3);
+
+    // The index is recycled with a new generation, the stale handle finds nothing
+    const Entity recycled = registry.create();
+    REQUIRE(recycled.index == entities[2].index);
+    REQUIRE(recycled != entities[2]);
+    REQUIRE_FALSE(registry.has<TestPosition>(recycled));
+    REQUIRE_FALSE(registry.has<TestPosition>(entities[2]));
+  }
+
+  SECTION("Removal swaps the last component into the freed slot") {
+    const ComponentPool<TestPosition>& pool = registry.getPool<TestPosition>();
+    registry.remove<TestPosition>(entities[0]);
+    REQUIRE(pool.size() == 3);
+    REQUIRE(pool.getEntities()[0] == entities[3]);
+    REQUIRE(pool.getData()[0].value == 3.0f);
+    REQUIRE(pool.slotOf(entities[3]) == 0);
+    REQUIRE(registry.get<TestPosition>(entities[3]).value == 3.0f);
+
+    // Removing the last one needs no swap
+    registry.remove<TestPosition>(entities[2]);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(pool.getEntities()[1] == entities[1]);
+    REQUIRE(registry.get<TestPosition>(entities[1]).value == 1.0f);
+  }
+
+  SECTION("Iteration visits the matching entities") {
+    registry.emplace<TestVelocity>(entities[1], 2.0f);
+    registry.emplace<TestVelocity>(entities[3], 4.0f);
+
+    float sum = 0.0f;
+    SIZE_T visited = 0;
+    registry.each<TestPosition>([&](Entity, TestPosition& position) {
+      sum += position.value;
+      ++visited;
+    });
+    REQUIRE(visited == 4);
+    REQUIRE(sum == 6.0f);
+
+    Vector<Entity> moved;
+    registry.each<TestPosition, TestVelocity>(
+        [&moved](Entity entity, TestPosition& position, const TestVelocity& velocity) {
+          position.value += velocity.value;
+          moved.push_back(entity);
+        });
+    REQUIRE(moved.size() == 2);
+    REQUIRE(registry.get<TestPosition>(entities[1]).value == 3.0f);
+    REQUIRE(registry.get<TestPosition>(entities[3]).value == 7.0f);
+    REQUIRE(registry.get<TestPosition>(entities[0]).value == 0.0f);
+  }
+
+  SECTION("Component pools update in place") {
+    GameObject gameObject("Owner");
+    MoverTestComponent& mover = gameObject.addComponent<MoverTestComponent>(Vector3::UNIT);
+    REQUIRE(gameObject.getComponent<MoverTestComponent>() == &mover);
+    REQUIRE(mover.getOwner() == &gameObject);
+    REQUIRE(gameObject.getComponentTypes().size() == 1);
+
+    IComponentPool& pool = gameObject.getRegistry()->getPool<MoverTestComponent>();
+    REQUIRE(pool.isComponentPool());
+    REQUIRE_FALSE(registry.getPool<TestPosition>().isComponentPool());
+    pool.updateComponents(0, pool.size(), 2.0f);
+    REQUIRE(mover.m_position == Vector3(2.0f, 2.0f, 2.0f));
+
+    mover.setEnabled(false);
+    pool.updateComponents(0, pool.size(), 2.0f);
+    REQUIRE(mover.m_updates == 1);
+
+    REQUIRE(gameObject.removeComponent<MoverTestComponent>());
+    REQUIRE(gameObject.getComponent<MoverTestComponent>() == nullptr);
+    REQUIRE(gameObject.getComponentTypes().empty());
+  }
+}
+
+/************************************************************************/
+/*
+ * GameObject transforms.
+ */
+/************************************************************************/
+TEST_CASE("chCore - GameObject transforms") {
+  Scene scene("Transforms", UUID::createRandom(), false);
+  TransformHierarchy& hierarchy = scene.getTransformHierarchy();
+  const SPtr<GameObject> parent = scene.createGameObject("Parent");
+  const SPtr<GameObject> other = scene.createGameObject("Other");
+  SPtr<GameObject> child = scene.createGameObject("Child", parent);
+  parent->setLocalPosition(Vector3(10.0f, 0.0f, 0.0f));
+  other->setLocalPosition(Vector3(0.0f, 5.0f, 0.0f));
+  child->setLocalPosition(Vector3(1.0f, 2.0f, 3.0f));
+  hierarchy.updateWorldMatrices();
+
+  SECTION("Accessors go through the hierarchy node") {
+    REQUIRE(hierarchy.getLocalPosition(child->getTransformNode()) ==
+            Vector3(1.0f, 2.0f, 3.0f));
+    REQUIRE(child->getWorldMatrix().getTranslation() == Vector3(11.0f, 2.0f, 3.0f));
+    REQUIRE(child->getParent() == parent);
+  }
+
+  SECTION("Reparenting moves the node") {
+    other->addChild(child);
+    REQUIRE(child->getParent() == other);
+    REQUIRE(parent->getChildren().empty());
+    REQUIRE(hierarchy.getParent(child->getTransformNode()) == other->getTransformNode());
+    hierarchy.updateWorldMatrices();
+    REQUIRE(child->getWorldMatrix().getTranslation() == Vector3(1.0f, 7.0f, 3.0f));
+
+    REQUIRE(other->removeChild(child));
+    REQUIRE(child->getParent() == nullptr);
+    REQUIRE(hierarchy.getParent(child->getTransformNode()) ==
+            TransformHierarchy::INVALID_NODE);
+
+    child->setParent(parent);
+    REQUIRE(parent->getChildren().size() == 1);
+    REQUIRE(hierarchy.getParent(child->getTransformNode()) == parent->getTransformNode());
+  }
+
+  SECTION("Destroyed GameObjects release their nodes") {
+    const SPtr<GameObject> kept = scene.createGameObject("Kept", child);
+    scene.createGameObject("Leaf", child);
+    const SIZE_T nodeCount = hierarchy.getNodeCount();
+    const TransformHierarchy::NodeId childNode = child->getTransformNode();
+
+    scene.destroyGameObject(child);
+    REQUIRE(parent->getChildren().empty());
+    REQUIRE(hierarchy.isValid(childNode));
+
+    // Leaf goes with its parent, Kept is still referenced and becomes a root
+    child.reset();
+    REQUIRE(hierarchy.getNodeCount() == nodeCount - 2);
+    REQUIRE_FALSE(hierarchy.isValid(childNode));
+    REQUIRE(hierarchy.isValid(kept->getTransformNode()));
+    REQUIRE(hierarchy.getParent(kept->getTransformNode()) == TransformHierarchy::INVALID_NODE);
+  }
+}
+
+/************************************************************************/
+/*
+ * Scene spatial index.
+ */
+/************************************************************************/
+TEST_CASE("chCore - Scene spatial index") {
+  Scene scene("Spatial", UUID::createRandom(), false);
+  const AABox bounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+  SPtr<GameObject> parent = scene.createGameObject("Parent");
+  const SPtr<GameObject> child = scene.createGameObject("Child", parent);
+  const SPtr<GameObject> other = scene.createGameObject("Other");
+  for (const SPtr<GameObject>& gameObject : {parent, child, other}) {
+    scene.setGameObjectBounds(gameObject, bounds);
+  }
+  scene.updateSpatialIndex();
+  REQUIRE(scene.getSpatialIndex().getProxyCount() == 3);
+
+  SECTION("Destroyed GameObjects leave the index") {
+    scene.destroyGameObject(parent);
+    parent.reset();
+
+    // Child is still referenced, its node survives but it is no longer in the scene
+    REQUIRE(scene.getSpatialIndex().getProxyCount() == 1);
+    Vector<GameObject*> found;
+    scene.getSpatialIndex().queryAABox(bounds, [&found](GameObject* gameObject) {
+      found.push_back(gameObject);
+    });
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0] == other.get());
+
+    child->setLocalPosition(Vector3(0.5f, 0.0f, 0.0f));
+    scene.update(0.0f);
+    REQUIRE(scene.getSpatialIndex().getProxyCount() == 1);
+  }
+
+  SECTION("Reused node ids start without bounds") {
+    const TransformHierarchy::NodeId parentNode = parent->getTransformNode();
+    scene.destroyGameObject(parent);
+    parent.reset();
+    REQUIRE(scene.getSpatialIndex().getProxyCount() == 1);
+
+    const SPtr<GameObject> reused = scene.createGameObject("Reused");
+    REQUIRE(reused->getTransformNode() == parentNode);
+    AABox reusedBounds;
+    REQUIRE_FALSE(scene.getGameObjectBounds(*reused, reusedBounds));
+    REQUIRE(scene.getSpatialIndex().getProxyCount() == 1);
+  }
+}
+
+/************************************************************************/
+/*
+ * Scene snapshot.
+ */
+/************************************************************************/
+TEST_CASE("chCore - SceneSnapshot") {
+  SceneSnapshot::registerComponent<SnapshotTestComponent>();
+
+  Scene scene("Source", UUID::createRandom());
+  TransformHierarchy& hierarchy = scene.getTransformHierarchy();
+  const SPtr<GameObject> root = scene.getRootGameObjects().front();
+
+  const SPtr<GameObject> a = scene.createGameObject("A", root);
+  const SPtr<GameObject> b = scene.createGameObject("B", root);
+  const SPtr<GameObject> a1 = scene.createGameObject("A1", a);
+  const SPtr<GameObject> a2 = scene.createGameObject("A2", a);
+  const SPtr<GameObject> b1 = scene.createGameObject("B1", b);
+  const SPtr<GameObject> floating = scene.createGameObject("Floating");
+
+  float value = 1.0f;
+  for (const SPtr<GameObject>& gameObject : {root, a, b, a1, a2, b1, floating}) {
+    gameObject->setLocalTransform(Vector3(value, -value, value * 2.0f),
+                                  Quaternion(Vector3(0.0f, 1.0f, 0.0f), Degree(value * 10.0f)),
+                                  Vector3(1.0f, value, 1.0f));
+    value += 1.0f;
+  }
+  hierarchy.updateWorldMatrices();
+  a2->setActive(false);
+
+  scene.setGameObjectBounds(a1,
+                            AABox(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f)));
+  scene.setGameObjectBounds(b, AABox(Vector3(0.0f, 0.0f, 0.0f), Vector3(4.0f, 4.0f, 4.0f)));
+
+  a->addComponent<SnapshotTestComponent>().m_state = {.speed = 2.5f, .counter = 7};
+  SnapshotTestComponent& disabled = b1->addComponent<SnapshotTestComponent>();
+  disabled.m_state = {.speed = -1.0f, .counter = 42};
+  disabled.setEnabled(false);
+  a2->addComponent<UnregisteredTestComponent>();
+
+  SPtr<DataStream> stream = chMakeShared<MemoryDataStream>(64 * 1024);
+  REQUIRE(SceneSnapshot::save(scene, stream));
+  stream->seek(0);
+
+  const SPtr<Scene> loaded = SceneSnapshot::load(stream, "Loaded", UUID::createRandom());
+  REQUIRE(loaded != nullptr);
+  REQUIRE(loaded->getName() == "Loaded");
+
+  const TransformHierarchy& loadedHierarchy = loaded->getTransformHierarchy();
+  REQUIRE(loadedHierarchy.getNodeCount() == hierarchy.getNodeCount());
+  REQUIRE(loaded->getRootGameObjects().size() == scene.getRootGameObjects().size());
+
+  // Both scenes walked in the same order, everything saved has to match
+  Function<void(const GameObject&, const GameObject&)> compare =
+      [&](const GameObject& expected, const GameObject& actual) {
+        REQUIRE(actual.getName() == expected.getName());
+        REQUIRE(actual.isActive() == expected.isActive());
+
+        const TransformHierarchy::NodeId expectedNode = expected.getTransformNode();
+        const TransformHierarchy::NodeId actualNode = actual.getTransformNode();
+        REQUIRE(loadedHierarchy.getLocalPosition(actualNode) ==
+                hierarchy.getLocalPosition(expectedNode));
+        REQUIRE(loadedHierarchy.getLocalRotation(actualNode) ==
+                hierarchy.getLocalRotation(expectedNode));
+        REQUIRE(loadedHierarchy.getLocalScale(actualNode) ==
+                hierarchy.getLocalScale(expectedNode));
+
+        AABox expectedBounds;
+        AABox actualBounds;
+        const bool hasBounds = scene.getGameObjectBounds(expected, expectedBounds);
+        REQUIRE(loaded->getGameObjectBounds(actual, actualBounds) == hasBounds);
+        if (hasBounds) {
+          REQUIRE(actualBounds.minPoint == expectedBounds.minPoint);
+          REQUIRE(actualBounds.maxPoint == expectedBounds.maxPoint);
+        }
+
+        const SnapshotTestComponent* expectedComponent =
+            expected.getComponent<SnapshotTestComponent>();
+        const SnapshotTestComponent* actualComponent =
+            actual.getComponent<SnapshotTestComponent>();
+        REQUIRE((actualComponent != nullptr) == (expectedComponent != nullptr));
+        if (expectedComponent) {
+          REQUIRE(actualComponent->m_state.speed == expectedComponent->m_state.speed);
+          REQUIRE(actualComponent->m_state.counter == expectedComponent->m_state.counter);
+          REQUIRE(actualComponent->isEnabled() == expectedComponent->isEnabled());
+          REQUIRE(actualComponent->getOwner() == &actual);
+        }
+        REQUIRE(actual.getComponent<UnregisteredTestComponent>() == nullptr);
+
+        REQUIRE(actual.getChildren().size() == expected.getChildren().size());
+        for (SIZE_T i = 0; i < expected.getChildren().size(); ++i) {
+          const GameObject& actualChild = *actual.getChildren()[i];
+          REQUIRE(loadedHierarchy.getParent(actualChild.getTransformNode()) == actualNode);
+          compare(*expected.getChildren()[i], actualChild);
+        }
+      };
+
+  for (SIZE_T i = 0; i < scene.getRootGameObjects().size(); ++i) {
+    const GameObject& actualRoot = *loaded->getRootGameObjects()[i];
+    REQUIRE(loadedHierarchy.getParent(actualRoot.getTransformNode()) ==
+            TransformHierarchy::INVALID_NODE);
+    compare(*scene.getRootGameObjects()[i], actualRoot);
+  }
+
+  SECTION("Truncated snapshots are rejected") {
+    SPtr<DataStream> truncated = chMakeShared<MemoryDataStream>(32);
+    stream->seek(0);
+    Vector<uint8> head(32);
+    stream->read(head.data(), head.size());
+    truncated->write(head.data(), head.size());
+    truncated->seek(0);
+    REQUIRE(SceneSnapshot::load(truncated, "Truncated", UUID::createRandom()) == nullptr);
+  }
+}
+
+/************************************************************************/
+/*
+ * Scene update scheduler.
+ */
+/************************************************************************/
+TEST_CASE("chCore - SceneUpdateScheduler") {
+  SECTION("Exclusive components keep the per object order") {
+    Scene scene("Order", UUID::createRandom());
+    String order;
+    SPtr<GameObject> first = scene.createGameObject("First");
+    first->addComponent<OrderTestComponent<'a'>>(&order);
+    first->addComponent<OrderTestComponent<'b'>>(&order);
+    SPtr<GameObject> second = scene.createGameObject("Second", first);
+    second->addComponent<OrderTestComponent<'c'>>(&order);
+    second->addComponent<OrderTestComponent<'a'>>(&order);
+    SPtr<GameObject> third = scene.createGameObject("Third");
+    third->addComponent<OrderTestComponent<'b'>>(&order);
+    third->addComponent<OrderTestComponent<'c'>>(&order);
+
+    SceneUpdateScheduler scheduler;
+    scheduler.update(scene.getRegistry(), scene.getRootGameObjects(), 0.0f);
+    REQUIRE(order == "abcabc");
+    REQUIRE(scheduler.getPhaseCount() == 1);
+
+    order.clear();
+    scheduler.update(scene.getRegistry(), scene.getRootGameObjects(), 0.0f);
+    REQUIRE(order == "abcabc");
+  }
+
+  SECTION("Declared components update from their pool") {
+    Scene scene("Pools", UUID::createRandom(), false);
+    const SPtr<GameObject> parent = scene.createGameObject("Parent");
+    Vector<SPtr<GameObject>> children;
+    for (uint32 i = 0; i < 100; ++i) {
+      children.push_back(scene.createGameObject("Child", parent));
+      children.back()->addComponent<MoverTestComponent>(Vector3::UNIT);
+    }
+    parent->addComponent<MoverTestComponent>(Vector3::UNIT);
+    children[1]->getComponent<MoverTestComponent>()->setEnabled(false);
+    children[2]->setActive(false);
+
+    scene.update(1.0f);
+    parent->setActive(false);
+    scene.update(1.0f);
+    parent->setActive(true);
+    scene.update(1.0f);
+
+    REQUIRE(parent->getComponent<MoverTestComponent>()->m_updates == 2);
+    REQUIRE(children[0]->getComponent<MoverTestComponent>()->m_updates == 2);
+    REQUIRE(children[0]->getComponent<MoverTestComponent>()->m_position ==
+            Vector3(2.0f, 2.0f, 2.0f));
+    REQUIRE(children[1]->getComponent<MoverTestComponent>()->m_updates == 0);
+    REQUIRE(children[2]->getComponent<MoverTestComponent>()->m_updates == 0);
+    REQUIRE(children[99]->getComponent<MoverTestComponent>()->m_updates == 2);
+  }
+
+  SECTION("Destroyed GameObjects stop updating") {
+    Scene scene("Destroyed", UUID::createRandom(), false);
+    const SPtr<GameObject> kept = scene.createGameObject("Kept");
+    kept->addComponent<MoverTestComponent>(Vector3::UNIT);
+    const SPtr<GameObject> parent = scene.createGameObject("Parent");
+    parent->addComponent<MoverTestComponent>(Vector3::UNIT);
+    const SPtr<GameObject> child = scene.createGameObject("Child", parent);
+    child->addComponent<MoverTestComponent>(Vector3::UNIT);
+    scene.update(1.0f);
+
+    // Still referenced here, but no longer part of the scene
+    scene.destroyGameObject(parent);
+    REQUIRE(parent->getComponent<MoverTestComponent>() == nullptr);
+    REQUIRE(child->getComponent<MoverTestComponent>() == nullptr);
+    REQUIRE(parent->getComponentTypes().empty());
+    REQUIRE(scene.getRegistry().getPool<MoverTestComponent>().size() == 1);
+
+    scene.update(1.0f);
+    REQUIRE(kept->getComponent<MoverTestComponent>()->m_updates == 2);
+    REQUIRE(kept->getComponent<MoverTestComponent>()->getOwner() == kept.get());
+  }
+}
+
+/************************************************************************/
+/*
+ * Geometry pool.
+ */
+/************************************************************************/
+TEST_CASE("chCore - GeometryPool") {
+  // Modules can't start twice, it stays up for every section and main shuts it down
+  if (!IGraphicsAPI::isStarted()) {
+    IGraphicsAPI::startUp<TestGraphicsAPI>();
+  }
+
+  Vector<SPtr<IBuffer>> released;
+  auto releaseBuffer = [&released](SPtr<IBuffer> buffer) {
+    released.push_back(std::move(buffer));
+  };
+
+  // Capacities are exact so nothing fits anywhere but in the holes
+  GeometryPool pool(VertexPosColor::getLayout(), 30, 90, releaseBuffer);
+  const SPtr<Mesh> first = makeTestMesh(10, 30, 1.0f, true);
+  const SPtr<Mesh> second = makeTestMesh(10, 30, 2.0f, false);
+  const SPtr<Mesh> third = makeTestMesh(10, 30, 3.0f, true);
+
+  SECTION("Meshes are packed into the shared buffers") {
+    const GeometryRange firstRange = pool.add(first);
+    pool.add(second);
+    const GeometryRange thirdRange = pool.add(third);
+    REQUIRE(pool.getMeshCount() == 3);
+    REQUIRE(pool.getUsedVertexCount() == 30);
+    REQUIRE(pool.getUsedIndexCount() == 90);
+    REQUIRE(firstRange.vertexOffset != thirdRange.vertexOffset);
+    REQUIRE(firstRange.firstIndex != thirdRange.firstIndex);
+    requireUploaded(pool, first);
+    requireUploaded(pool, second);
+    requireUploaded(pool, third);
+
+    // Adding the same mesh again doesn't take more space
+    REQUIRE(pool.add(first).firstIndex == firstRange.firstIndex);
+    REQUIRE(pool.getUsedIndexCount() == 90);
+    REQUIRE(released.empty());
+  }
+
+  SECTION("Removed ranges are reused without touching the buffers") {
+    pool.add(first);
+    const GeometryRange secondRange = pool.add(second);
+    pool.add(third);
+    const SPtr<IBuffer> vertexBuffer = pool.getVertexBuffer();
+
+    pool.remove(second.get());
+    REQUIRE(pool.find(second.get()) == nullptr);
+    REQUIRE(pool.getUsedVertexCount() == 20);
+
+    const SPtr<Mesh> replacement = makeTestMesh(10, 30, 4.0f, false);
+    const GeometryRange& replacementRange = pool.add(replacement);
+    REQUIRE(replacementRange.vertexOffset == secondRange.vertexOffset);
+    REQUIRE(replacementRange.firstIndex == secondRange.firstIndex);
+    REQUIRE(pool.getVertexBuffer() == vertexBuffer);
+    REQUIRE(released.empty());
+    requireUploaded(pool, first);
+    requireUploaded(pool, replacement);
+    requireUploaded(pool, third);
+  }
+
+  SECTION("Holes are compacted before growing") {
+    pool.add(first);
+    pool.add(second);
+    pool.add(third);
+    const SPtr<IBuffer> vertexBuffer = pool.getVertexBuffer();
+    const SPtr<IBuffer> indexBuffer = pool.getIndexBuffer();
+
+    // Two separate holes of 10 vertices, a mesh of 20 only fits once they are packed
+    pool.remove(first.get());
+    pool.remove(third.get());
+    const SPtr<Mesh> large = makeTestMesh(20, 60, 5.0f, true);
+    pool.add(large);
+    REQUIRE(pool.getVertexCapacity() == 30);
+    REQUIRE(pool.getIndexCapacity() == 90);
+    REQUIRE(pool.getUsedVertexCount() == 30);
+    requireUploaded(pool, second);
+    requireUploaded(pool, large);
+
+    // The replaced buffers are handed out instead of being destroyed right away
+    REQUIRE(released.size() == 2);
+    REQUIRE(released[0] == vertexBuffer);
+    REQUIRE(released[1] == indexBuffer);
+
+    pool.remove(second.get());
+    pool.compact();
+    REQUIRE(released.size() == 4);
+    REQUIRE(pool.find(large.get())->vertexOffset == 0);
+    requireUploaded(pool, large);
+  }
+
+  SECTION("The pool grows when the holes are not enough") {
+    pool.add(first);
+    pool.add(second);
+    pool.add(third);
+
+    const SPtr<Mesh> extra = makeTestMesh(10, 30, 6.0f, false);
+    pool.add(extra);
+    REQUIRE(pool.getVertexCapacity() == 60);
+    REQUIRE(pool.getIndexCapacity() == 180);
+    REQUIRE(released.size() == 2);
+    requireUploaded(pool, first);
+    requireUploaded(pool, second);
+    requireUploaded(pool, third);
+    requireUploaded(pool, extra);
+  }
+}
+
+/************************************************************************/
+/*
+ * Model.
+ */
+/************************************************************************/
+TEST_CASE("chCore - Model transforms") {
+  // Levels far wider than the parallel batch size of updateTransforms, 2048 nodes
+  constexpr uint32 ROOT_COUNT = 4;
+  constexpr uint32 CHILDREN_PER_ROOT = 2500;
+
+  auto buildModel = [](Model& model) {
+    model.reserveNodes(ROOT_COUNT * (1 + 2 * CHILDREN_PER_ROOT));
+    for (uint32 root = 0; root < ROOT_COUNT; ++root) {
+      ModelNode* rootNode = model.createNode(
+          "Root", RotationTranslationMatrix(Rotator(0.0f, 30.0f * root, 0.0f),
+                                            Vector3(10.0f * root, 0.0f, 0.0f)));
+      for (uint32 i = 0; i < CHILDREN_PER_ROOT; ++i) {
+        const float value = static_cast<float>(i);
+        ModelNode* child = model.createNode(
+            "Child", RotationTranslationMatrix(Rotator(value, 0.0f, 0.5f * value),
+                                               Vector3(0.0f, value, 1.0f)), rootNode);
+        model.createNode("Leaf", TranslationMatrix(Vector3(1.0f, 0.0f, 0.01f * value)),
+                         child);
+      }
+    }
+    model.setTransform(TranslationMatrix(Vector3(0.0f, 0.0f, -5.0f)));
+  };
+
+  // Recursive walk from the roots, one node at a time
+  auto updateSerial = [](Model& model) {
+    for (ModelNode* root : model.getRootNodes()) {
+      model.updateNodeTransform(root, root->getLocalTransform());
+    }
+  };
+
+  auto requireSameTransforms = [](const Model& parallel, const Model& serial) {
+    REQUIRE(parallel.getNodeCount() == serial.getNodeCount());
+    bool allMatch = true;
+    for (uint32 i = 0; i < parallel.getNodeCount(); ++i) {
+      const ModelNode* parallelNode = parallel.getAllNodes()[i];
+      allMatch &= !parallelNode->isDirty() &&
+                  parallelNode->getGlobalTransform() ==
+                      serial.getAllNodes()[i]->getGlobalTransform();
+    }
+    REQUIRE(allMatch);
+  };
+
+  REQUIRE(JobSystem::isStarted());
+  Model parallel;
+  Model serial;
+  buildModel(parallel);
+  buildModel(serial);
+
+  parallel.updateTransforms();
+  updateSerial(serial);
+  requireSameTransforms(parallel, serial);
+
+  const ModelNode* leaf = parallel.getAllNodes()[2];
+  REQUIRE(leaf->getGlobalTransform() == parallel.getTransform() *
+                                            parallel.getAllNodes()[0]->getLocalTransform() *
+                                            parallel.getAllNodes()[1]->getLocalTransform() *
+                                            leaf->getLocalTransform());
+
+  // Only the subtree under the moved root is dirty the second time
+  const Matrix4 moved = TranslationMatrix(Vector3(0.0f, 3.0f, 0.0f));
+  parallel.getRootNodes()[1]->setLocalTransform(moved);
+  serial.getRootNodes()[1]->setLocalTransform(moved);
+  parallel.updateTransforms();
+  updateSerial(serial);
+  requireSameTransforms(parallel, serial);
+
+  SECTION("Instance batches stay packed") {
+    Model model;
+    ModelNode* root = model.createNode("Root", TranslationMatrix(Vector3(0.0f, 0.0f, -1.0f)));
+    Vector<ModelNode*> nodes;
+    for (uint32 i = 0; i < 5; ++i) {
+      nodes.push_back(model.createNode(
+          "Node", TranslationMatrix(Vector3(static_cast<float>(i), 0.0f, 0.0f)), root));
+    }
+
+    const SPtr<Mesh> shared = chMakeShared<Mesh>();
+    const SPtr<Mesh> other = chMakeShared<Mesh>();
+    for (ModelNode* node : nodes) {
+      node->addMesh(shared);
+    }
+    root->addMesh(other);
+    nodes[3]->addMesh(other);
+
+    // Every node with the mesh sits in its batch once, next to its current transform
+    auto requirePacked = [&model]() {
+      model.updateTransforms();
+      SIZE_T instanceCount = 0;
+      for (const MeshInstanceBatch& batch : model.getInstanceBatches()) {
+        REQUIRE(batch.nodes.size() == batch.transforms.size());
+        const auto& meshNodes = model.getMeshToNodesMap().at(batch.mesh);
+        REQUIRE(batch.nodes.size() == meshNodes.size());
+        for (SIZE_T i = 0; i < batch.nodes.size(); ++i) {
+          REQUIRE(std::count(batch.nodes.begin(), batch.nodes.end(), batch.nodes[i]) == 1);
+          REQUIRE(std::find(meshNodes.begin(), meshNodes.end(), batch.nodes[i]) !=
+                  meshNodes.end());
+          REQUIRE(batch.transforms[i] == batch.nodes[i]->getGlobalTransform());
+        }
+        instanceCount += batch.nodes.size();
+      }
+      SIZE_T expectedCount = 0;
+      for (const auto& [mesh, meshNodes] : model.getMeshToNodesMap()) {
+        expectedCount += meshNodes.size();
+      }
+      REQUIRE(instanceCount == expectedCount);
+    };
+
+    requirePacked();
+    REQUIRE(model.getInstanceBatches().size() == 2);
+    REQUIRE(model.getInstanceBatches()[0].mesh == shared);
+    REQUIRE(model.getInstanceBatches()[0].nodes.size() == 5);
+
+    // The last instance fills the hole
+    nodes[2]->removeMesh(shared);
+    REQUIRE(model.getInstanceBatches()[0].nodes.size() == 4);
+    REQUIRE(model.getInstanceBatches()[0].nodes[2] == nodes[4]);
+    nodes[4]->setLocalTransform(TranslationMatrix(Vector3(0.0f, 7.0f, 0.0f)));
+    root->setLocalTransform(TranslationMatrix(Vector3(0.0f, 0.0f, 2.0f)));
+    requirePacked();
+
+    // The last batch fills the hole
+    for (ModelNode* node : nodes) {
+      node->removeMesh(shared);
+    }
+    REQUIRE(model.getInstanceBatches().size() == 1);
+    REQUIRE(model.getInstanceBatches()[0].mesh == other);
+    nodes[3]->setLocalTransform(TranslationMatrix(Vector3(5.0f, 0.0f, 0.0f)));
+    requirePacked();
+
+    nodes[1]->addMesh(shared);
+    REQUIRE(model.getInstanceBatches().size() == 2);
+    REQUIRE(model.getInstanceBatches()[1].mesh == shared);
+    nodes[1]->setLocalTransform(TranslationMatrix(Vector3(0.0f, 0.0f, 9.0f)));
+    requirePacked();
+  }
+}
+
+/************************************************************************/
+/*
+ * Render graph.
+ */
+/************************************************************************/
+TEST_CASE("chCore - RenderGraph") {
+  using Builder = RenderGraph::PassBuilder;
+  RenderGraph graph;
+
+  SECTION("Passes nothing alive reads are culled") {
+    const RenderGraphHandle unused = graph.createResource("Unused");
+    const RenderGraphHandle shadows = graph.createResource("Shadows");
+    const RenderGraphHandle frame = graph.createResource("Frame");
+    graph.markOutput(frame);
+
+    const uint32 unusedPass =
+        graph.addPass("Unused", [&](Builder& builder) { builder.write(unused); }, nullptr);
+    const uint32 shadowPass =
+        graph.addPass("Shadows", [&](Builder& builder) { builder.write(shadows); }, nullptr);
+    const uint32 debugPass =
+        graph.addPass("Debug", [](Builder& builder) { builder.setSideEffect(); }, nullptr);
+    const uint32 lightingPass = graph.addPass("Lighting", [&](Builder& builder) {
+      builder.read(shadows);
+      builder.write(frame);
+    }, nullptr);
+
+    REQUIRE(graph.compile());
+    REQUIRE(graph.isPassCulled(unusedPass));
+    REQUIRE_FALSE(graph.isPassCulled(shadowPass));
+    REQUIRE_FALSE(graph.isPassCulled(debugPass));
+    REQUIRE_FALSE(graph.isPassCulled(lightingPass));
+    REQUIRE(graph.getExecutionOrder() == Vector<uint32>{shadowPass, debugPass, lightingPass});
+  }
+
+  SECTION("Writers run before the readers added ahead of them") {
+    const RenderGraphHandle depth = graph.createResource("Depth");
+    const RenderGraphHandle lighting = graph.createResource("Lighting");
+    const RenderGraphHandle frame = graph.createResource("Frame");
+    graph.markOutput(frame);
+
+    const uint32 uiPass =
+        graph.addPass("UI", [](Builder& builder) { builder.setSideEffect(); }, nullptr);
+    const uint32 compositePass = graph.addPass("Composite", [&](Builder& builder) {
+      builder.read(lighting);
+      builder.write(frame);
+    }, nullptr);
+    const uint32 lightingPass = graph.addPass("Lighting", [&](Builder& builder) {
+      builder.read(depth);
+      builder.write(lighting);
+    }, nullptr);
+    const uint32 depthPass =
+        graph.addPass("Depth", [&](Builder& builder) { builder.write(depth); }, nullptr);
+
+    REQUIRE(graph.compile());
+    REQUIRE(graph.getExecutionOrder() ==
+            Vector<uint32>{uiPass, depthPass, lightingPass, compositePass});
+  }
+
+  SECTION("Writes wait for the reads added before them") {
+    const RenderGraphHandle history = graph.createResource("History");
+    const RenderGraphHandle first = graph.createResource("First");
+    const RenderGraphHandle second = graph.createResource("Second");
+    graph.markOutput(first);
+    graph.markOutput(second);
+
+    const uint32 firstWrite = graph.addPass("FirstWrite", [&](Builder& builder) {
+      builder.write(history);
+    }, nullptr);
+    const uint32 firstRead = graph.addPass("FirstRead", [&](Builder& builder) {
+      builder.read(history);
+      builder.write(first);
+    }, nullptr);
+    const uint32 secondWrite = graph.addPass("SecondWrite", [&](Builder& builder) {
+      builder.write(history);
+    }, nullptr);
+    const uint32 secondRead = graph.addPass("SecondRead", [&](Builder& builder) {
+      builder.read(history);
+      builder.write(second);
+    }, nullptr);
+
+    REQUIRE(graph.compile());
+    REQUIRE(graph.getExecutionOrder() ==
+            Vector<uint32>{firstWrite, firstRead, secondWrite, secondRead});
+  }
+
+  SECTION("A write no later pass reads is culled") {
+    const RenderGraphHandle history = graph.createResource("History");
+    const RenderGraphHandle frame = graph.createResource("Frame");
+    graph.markOutput(frame);
+
+    graph.addPass("FirstWrite", [&](Builder& builder) { builder.write(history); }, nullptr);
+    graph.addPass("Read", [&](Builder& builder) {
+      builder.read(history);
+      builder.write(frame);
+    }, nullptr);
+    const uint32 lateWrite =
+        graph.addPass("LateWrite", [&](Builder& builder) { builder.write(history); }, nullptr);
+
+    REQUIRE(graph.compile());
+    REQUIRE(graph.isPassCulled(lateWrite));
+    REQUIRE(graph.getExecutedPassCount() == 2);
+  }
+
+  SECTION("Cycles make compile fail") {
+    const RenderGraphHandle a = graph.createResource("A");
+    const RenderGraphHandle b = graph.createResource("B");
+    graph.markOutput(a);
+
+    graph.addPass("WritesA", [&](Builder& builder) {
+      builder.read(b);
+      builder.write(a);
+    }, nullptr);
+    graph.addPass("WritesB", [&](Builder& builder) {
+      builder.read(a);
+      builder.write(b);
+    }, nullptr);
+
+    REQUIRE_FALSE(graph.compile());
+    REQUIRE(graph.getExecutedPassCount() == 0);
+  }
+}
+
+// Run with: chCoreUnitTest "[benchmark]"
+TEST_CASE("chCore - EntityRegistryBenchmark", "[.][benchmark]") {
+  using Clock = std::chrono::high_resolution_clock;
+  using Micro = std::chrono::microseconds;
+  const SIZE_T COUNT = 100000;
+  const int32 FRAMES = 10;
+
+  Scene scene("Benchmark", UUID::createRandom(), false);
+  Vector<Scene::GameObjectDesc> descs(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    descs[i].name = "Object" + std::to_string(i);
+    descs[i].parent = i == 0 ? Scene::NO_PARENT : static_cast<uint32>((i - 1) / 8);
+  }
+  const Vector<SPtr<GameObject>> objects = scene.createGameObjects(descs);
+  for (const SPtr<GameObject>& gameObject : objects) {
+    gameObject->addComponent<MoverTestComponent>(Vector3::UNIT);
+  }
+
+  // What the pools replace, one heap allocation per component in scene order
+  Vector<SPtr<Component>> separate;
+  separate.reserve(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    separate.push_back(chMakeShared<MoverTestComponent>(Vector3::UNIT));
+  }
+
+  SceneUpdateScheduler scheduler;
+  auto start = Clock::now();
+  for (int32 frame = 0; frame < FRAMES; ++frame) {
+    scheduler.update(scene.getRegistry(), scene.getRootGameObjects(), 0.016f);
+  }
+  const auto poolTime = (Clock::now() - start) / FRAMES;
+
+  start = Clock::now();
+  for (int32 frame = 0; frame < FRAMES; ++frame) {
+    for (const SPtr<Component>& component : separate) {
+      if (component->isEnabled()) {
+        component->update(0.016f);
+      }
+    }
+  }
+  const auto separateTime = (Clock::now() - start) / FRAMES;
+
+  start = Clock::now();
+  for (int32 frame = 0; frame < FRAMES; ++frame) {
+    objects.front()->update(0.016f);
+  }
+  const auto treeTime = (Clock::now() - start) / FRAMES;
+
+  WARN("Registry pool update:    " << COUNT << " components, "
+                                   << std::chrono::duration_cast<Micro>(poolTime).count()
+                                   << " us");
+  WARN("Separate SPtr update:    " << COUNT << " components, "
+                                   << std::chrono::duration_cast<Micro>(separateTime).count()
+                                   << " us");
+  WARN("GameObject tree update:  " << COUNT << " components, "
+                                   << std::chrono::duration_cast<Micro>(treeTime).count()
+                                   << " us");
+  REQUIRE(objects.back()->getComponent<MoverTestComponent>()->m_updates == 2 * FRAMES);
+}
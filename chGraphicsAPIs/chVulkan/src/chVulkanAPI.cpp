@@ -10,6 +10,7 @@
 #include "chVulkanAPI.h"
 
 #include "chDisplaySurface.h"
+#include "chEnginePaths.h"
 #include "chVulkanBuffer.h"
 #include "chVulkanCommandBuffer.h"
 #include "chVulkanCommandPool.h"
@@ -177,16 +178,16 @@ VulkanAPI::createSwapChain(uint32 width, uint32 height, bool vsync) {
  */
 NODISCARD SPtr<IBuffer>
 VulkanAPI::createBuffer(const BufferCreateInfo& createInfo) {
-  return chMakeShared<VulkanBuffer>(m_vulkanData->device, m_vulkanData->physicalDevice,
-                                    createInfo);
+  return chMakeShared<VulkanBuffer>(m_vulkanData->device, *m_memoryAllocator,
+                                    *m_uploadManager, createInfo);
 }
 
 /*
  */
 NODISCARD SPtr<ITexture>
 VulkanAPI::createTexture(const TextureCreateInfo& createInfo) {
-  return chMakeShared<VulkanTexture>(m_vulkanData->device, m_vulkanData->physicalDevice,
-                                     createInfo);
+  return chMakeShared<VulkanTexture>(m_vulkanData->device, *m_memoryAllocator,
+                                     *m_uploadManager, createInfo);
 }
 
 /*
@@ -202,6 +203,9 @@ VulkanAPI::createCommandPool(QueueType queueType, bool transient) {
   case QueueType::Present:
     queueFamilyIndex = m_presentQueueFamilyIndex;
     break;
+  case QueueType::Transfer:
+    queueFamilyIndex = m_transferQueueFamilyIndex;
+    break;
   default:
     CH_LOG_WARNING(Vulkan, "Unsupported queue type, falling back to graphics queue");
     queueFamilyIndex = m_graphicsQueueFamilyIndex;
@@ -235,7 +239,13 @@ VulkanAPI::createShader(const ShaderCreateInfo& createInfo) {
  */
 NODISCARD SPtr<IPipeline>
 VulkanAPI::createPipeline(const PipelineCreateInfo& createInfo) {
-  return chMakeShared<VulkanPipeline>(m_vulkanData->device, createInfo);
+  const auto start = std::chrono::steady_clock::now();
+  SPtr<VulkanPipeline> pipeline = chMakeShared<VulkanPipeline>(
+      m_vulkanData->device, m_pipelineCache->getHandle(), createInfo);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  m_pipelineCache->addPipelineCreation(static_cast<uint64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+  return pipeline;
 }
 
 /*
@@ -319,6 +329,12 @@ VulkanAPI::updateDescriptorSets(const Vector<WriteDescriptorSet>& descriptorWrit
     case DescriptorType::CombinedImageSampler:
       vkWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
       break;
+    case DescriptorType::UniformBufferDynamic:
+      vkWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+      break;
+    case DescriptorType::StorageBufferDynamic:
+      vkWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+      break;
     }
 
     if (!write.bufferInfos.empty()) {
@@ -590,14 +606,17 @@ VulkanAPI::isDeviceSuitable(VkPhysicalDevice device) const {
 /*
  */
 NODISCARD Optional<uint32>
-VulkanAPI::findQueueFamily(VkPhysicalDevice device, VkQueueFlags queueFlags) const {
+VulkanAPI::findQueueFamily(VkPhysicalDevice device,
+                           VkQueueFlags queueFlags,
+                           VkQueueFlags excludedFlags) const {
   uint32 queueFamilyCount = 0;
   vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
   Vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
   vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
   for (uint32 i = 0; i < queueFamilyCount; i++) {
-    if (queueFamilies[i].queueFlags & queueFlags) {
+    if ((queueFamilies[i].queueFlags & queueFlags) &&
+        !(queueFamilies[i].queueFlags & excludedFlags)) {
       return i;
     }
   }
@@ -621,28 +640,46 @@ VulkanAPI::createLogicalDevice() {
   // For now we are using the same queue for graphics and present
   m_presentQueueFamilyIndex = *graphicsQueueFamily;
 
-  // auto computeQueueFamily = findQueueFamily(m_vulkanData->physicalDevice,
-  // VK_QUEUE_COMPUTE_BIT); auto transferQueueFamily =
-  // findQueueFamily(m_vulkanData->physicalDevice, VK_QUEUE_TRANSFER_BIT);
+  // A family without graphics and compute usually maps to the copy engines, uploads run
+  // there next to rendering. Every family with graphics supports transfers as well.
+  auto transferQueueFamily = findQueueFamily(m_vulkanData->physicalDevice,
+                                             VK_QUEUE_TRANSFER_BIT,
+                                             VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+  m_transferQueueFamilyIndex = transferQueueFamily.value_or(m_graphicsQueueFamilyIndex);
 
-  // Set<uint32> uniqueQueueFamilies = { m_vulkanData->graphicsQueueFamilyIndex };
-
-  // Queue creation info, for now we are using only one queue
   float queuePriority = 1.0f;
-  VkDeviceQueueCreateInfo queueCreateInfo{.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-                                          .pNext = nullptr,
-                                          .flags = 0,
-                                          .queueFamilyIndex = m_graphicsQueueFamilyIndex,
-                                          .queueCount = 1,
-                                          .pQueuePriorities = &queuePriority};
+  Vector<VkDeviceQueueCreateInfo> queueCreateInfos{
+      {.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+       .pNext = nullptr,
+       .flags = 0,
+       .queueFamilyIndex = m_graphicsQueueFamilyIndex,
+       .queueCount = 1,
+       .pQueuePriorities = &queuePriority}};
+
+  if (m_transferQueueFamilyIndex != m_graphicsQueueFamilyIndex) {
+    queueCreateInfos.push_back({.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+                                .pNext = nullptr,
+                                .flags = 0,
+                                .queueFamilyIndex = m_transferQueueFamilyIndex,
+                                .queueCount = 1,
+                                .pQueuePriorities = &queuePriority});
+  }
+
+  VkPhysicalDeviceFeatures supportedFeatures{};
+  vkGetPhysicalDeviceFeatures(m_vulkanData->physicalDevice, &supportedFeatures);
 
+  // Optional, indirect draws fall back to one call per command without them
   VkPhysicalDeviceFeatures deviceFeatures{};
+  deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+  deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+  m_multiDrawIndirectEnabled = supportedFeatures.multiDrawIndirect == VK_TRUE;
 
   VkDeviceCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
                                 .pNext = nullptr,
                                 .flags = 0,
-                                .queueCreateInfoCount = 1,
-                                .pQueueCreateInfos = &queueCreateInfo,
+                                .queueCreateInfoCount =
+                                    static_cast<uint32>(queueCreateInfos.size()),
+                                .pQueueCreateInfos = queueCreateInfos.data(),
                                 .enabledLayerCount = 0,
                                 .ppEnabledLayerNames = nullptr,
                                 .enabledExtensionCount =
@@ -653,6 +690,16 @@ VulkanAPI::createLogicalDevice() {
   VK_CHECK(vkCreateDevice(m_vulkanData->physicalDevice, &createInfo, nullptr,
                           &m_vulkanData->device));
 
+  m_memoryAllocator = chMakeUnique<VulkanMemoryAllocator>(m_vulkanData->device,
+                                                          m_vulkanData->physicalDevice);
+  m_uploadManager = chMakeUnique<VulkanUploadManager>(m_vulkanData->device,
+                                                      *m_memoryAllocator,
+                                                      m_graphicsQueueFamilyIndex,
+                                                      m_transferQueueFamilyIndex);
+  m_pipelineCache = chMakeUnique<VulkanPipelineCache>(
+      m_vulkanData->device, m_vulkanData->physicalDevice,
+      Path(EnginePaths::getEngineCacheDirectory(), Path("VulkanPipelineCache.bin")));
+
   // Get the graphics queue and encapsulate it in a command queue
   m_graphicsQueue = chMakeShared<VulkanCommandQueue>(
       m_vulkanData->device, m_graphicsQueueFamilyIndex, QueueType::Graphics);
@@ -768,10 +815,30 @@ VulkanAPI::createSurface(WeakPtr<DisplaySurface> display) {
   return true;
 }
 
+/*
+ */
+void
+VulkanAPI::flushUploads(bool waitForCompletion) {
+  if (waitForCompletion) {
+    m_uploadManager->waitIdle();
+  }
+  else {
+    m_uploadManager->submit();
+  }
+}
+
+/*
+ */
+void
+VulkanAPI::savePipelineCache() {
+  m_pipelineCache->save();
+}
+
 /*
  */
 void
 VulkanAPI::waitIdle() {
+  m_uploadManager->waitIdle();
   VkResult res = vkDeviceWaitIdle(m_vulkanData->device);
   if (res != VK_SUCCESS) {
     std::cout << res << std::endl;
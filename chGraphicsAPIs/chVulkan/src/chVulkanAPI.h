@@ -12,6 +12,9 @@
 #include "chVulkanPrerequisites.h"
 
 #include "chIGraphicsAPI.h"
+#include "chVulkanMemoryAllocator.h"
+#include "chVulkanPipelineCache.h"
+#include "chVulkanUploadManager.h"
 
 namespace chEngineSDK {
 
@@ -82,6 +85,12 @@ class VulkanAPI : public IGraphicsAPI {
   void
   updateDescriptorSets(const Vector<WriteDescriptorSet>& writeDescriptorSets) override;
 
+  void
+  flushUploads(bool waitForCompletion = false) override;
+
+  void
+  savePipelineCache() override;
+
   void
   waitIdle() override;
 
@@ -100,11 +109,34 @@ class VulkanAPI : public IGraphicsAPI {
     return m_vulkanData->instance;
   }
 
+  FORCEINLINE VulkanMemoryAllocator&
+  getMemoryAllocator() const {
+    return *m_memoryAllocator;
+  }
+
+  FORCEINLINE VulkanUploadManager&
+  getUploadManager() const {
+    return *m_uploadManager;
+  }
+
   FORCEINLINE uint32
   getGraphicsQueueFamilyIndex() const {
     return m_graphicsQueueFamilyIndex;
   }
 
+  FORCEINLINE uint32
+  getTransferQueueFamilyIndex() const {
+    return m_transferQueueFamilyIndex;
+  }
+
+  /**
+   * True when one indirect call can issue several draws
+   */
+  FORCEINLINE bool
+  isMultiDrawIndirectEnabled() const {
+    return m_multiDrawIndirectEnabled;
+  }
+
   void
   waitForDeviceIdle();
 
@@ -123,7 +155,9 @@ class VulkanAPI : public IGraphicsAPI {
   isDeviceSuitable(VkPhysicalDevice device) const;
 
   NODISCARD Optional<uint32>
-  findQueueFamily(VkPhysicalDevice device, VkQueueFlags queueFlags) const;
+  findQueueFamily(VkPhysicalDevice device,
+                  VkQueueFlags queueFlags,
+                  VkQueueFlags excludedFlags = 0) const;
 
   void
   createLogicalDevice();
@@ -141,6 +175,9 @@ class VulkanAPI : public IGraphicsAPI {
   initializeFunctionMap();
 
   UniquePtr<VulkanData> m_vulkanData;
+  UniquePtr<VulkanMemoryAllocator> m_memoryAllocator;
+  UniquePtr<VulkanUploadManager> m_uploadManager;
+  UniquePtr<VulkanPipelineCache> m_pipelineCache;
 
   SPtr<ICommandQueue> m_graphicsQueue;
   uint32 m_graphicsQueueFamilyIndex = 0;
@@ -148,6 +185,10 @@ class VulkanAPI : public IGraphicsAPI {
   SPtr<ICommandQueue> m_presentQueue;
   uint32 m_presentQueueFamilyIndex = 0;
 
+  uint32 m_transferQueueFamilyIndex = 0;
+
+  bool m_multiDrawIndirectEnabled = false;
+
   Map<String, Function<Any(const Vector<Any>&)>> m_functionMap;
 };
 
@@ -16,32 +16,16 @@
 #include "chVulkanAPI.h"
 
 namespace chEngineSDK {
-namespace chVulkanBufferUtils {
-uint32
-findMemoryType(VkPhysicalDevice physicalDevice,
-               uint32 typeFilter,
-               VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-
-    for (uint32 i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) &&
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-
-    CH_EXCEPT(VulkanErrorException, "Failed to find suitable memory type");
-}
-} // namespace chVulkanBufferUtils
-using namespace chVulkanBufferUtils;
-
 /*
 */
 VulkanBuffer::VulkanBuffer(VkDevice device,
-                           VkPhysicalDevice physicalDevice,
+                           VulkanMemoryAllocator& allocator,
+                           VulkanUploadManager& uploadManager,
                            const BufferCreateInfo& createInfo)
-    : m_device(device), m_size(createInfo.size) {
+    : m_device(device),
+      m_allocator(&allocator),
+      m_uploadManager(&uploadManager),
+      m_size(createInfo.size) {
   VkBufferUsageFlags usage = 0;
   if (createInfo.usage.isSet(BufferUsage::VertexBuffer)) {
     usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
@@ -55,10 +39,15 @@ VulkanBuffer::VulkanBuffer(VkDevice device,
   if (createInfo.usage.isSet(BufferUsage::StorageBuffer)) {
     usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
   }
+  if (createInfo.usage.isSet(BufferUsage::IndirectBuffer)) {
+    usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+  }
   if (createInfo.usage.isSet(BufferUsage::TransferSrc)) {
     usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
-  if (createInfo.usage.isSet(BufferUsage::TransferDst)) {
+  // Device local memory is only written through staging copies
+  if (createInfo.usage.isSet(BufferUsage::TransferDst) ||
+      createInfo.memoryUsage == MemoryUsage::GpuOnly) {
     usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   }
 
@@ -75,48 +64,10 @@ VulkanBuffer::VulkanBuffer(VkDevice device,
 
   VK_CHECK(vkCreateBuffer(device, &bufferInfo, nullptr, &m_buffer));
 
-  VkMemoryRequirements memRequirements;
-  vkGetBufferMemoryRequirements(device, m_buffer, &memRequirements);
+  m_allocation = allocator.allocateForBuffer(m_buffer, createInfo.memoryUsage);
 
-  VkMemoryPropertyFlags memoryFlags = 0;
-  switch (createInfo.memoryUsage) {
-  case MemoryUsage::GpuOnly:
-    memoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-    m_mappable = false;
-    break;
-  case MemoryUsage::CpuOnly:
-    memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    m_mappable = true;
-    break;
-  case MemoryUsage::CpuToGpu:
-    memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    m_mappable = true;
-    break;
-  case MemoryUsage::GpuToCpu:
-    memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
-    m_mappable = true;
-    break;
-  }
-
-  uint32 memoryTypeIndex = findMemoryType(physicalDevice,
-                                          memRequirements.memoryTypeBits,
-                                          memoryFlags);
-
-  VkMemoryAllocateInfo allocInfo = {
-    .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-    .pNext = nullptr,
-    .allocationSize = memRequirements.size,
-    .memoryTypeIndex = memoryTypeIndex
-  };
-  VK_CHECK(vkAllocateMemory(device, &allocInfo, nullptr, &m_memory));
-  VK_CHECK(vkBindBufferMemory(device, m_buffer, m_memory, 0));
-
-  if (m_mappable){
-    VK_CHECK(vkMapMemory(device, m_memory, 0, m_size, 0, (void**)&m_mappedData));
-
-    if (createInfo.initialData) {
-      update(createInfo.initialData, createInfo.initialDataSize);
-    }
+  if (createInfo.initialData && createInfo.initialDataSize > 0) {
+    update(createInfo.initialData, createInfo.initialDataSize);
   }
 }
 
@@ -126,9 +77,14 @@ VulkanBuffer::~VulkanBuffer() {
   if (m_device == VK_NULL_HANDLE) {
     return;
   }
-  VkResult result = vkDeviceWaitIdle(m_device);
-  if (result != VK_SUCCESS) {
-    CH_LOG_ERROR(Vulkan, "VulkanBuffer::Destructor: Failed to wait for device idle.");
+
+  // A copy into this buffer may still be in an upload batch, the upload manager destroys
+  // it when that batch retires. Graphics work reading it is the owner's to wait for,
+  // renderers defer the release until their frames retire
+  if (m_lastUploadSerial != 0) {
+    m_uploadManager->releaseBuffer(m_buffer, m_allocation, m_lastUploadSerial);
+    m_buffer = VK_NULL_HANDLE;
+    return;
   }
 
   if (m_buffer != VK_NULL_HANDLE) {
@@ -136,32 +92,30 @@ VulkanBuffer::~VulkanBuffer() {
     m_buffer = VK_NULL_HANDLE;
   }
 
-  if (m_mappedData && m_mappable) {
-    vkUnmapMemory(m_device, m_memory);
-    m_mappedData = nullptr;
-  }
-
-  if (m_memory != VK_NULL_HANDLE) {
-    vkFreeMemory(m_device, m_memory, nullptr);
-    m_memory = VK_NULL_HANDLE;
-  }
+  m_allocator->free(m_allocation);
 }
 
 /*
 */
 void
 VulkanBuffer::update(const void* data, SIZE_T size, uint32 offset) {
-  if (m_mappable && m_mappedData) {
-    memcpy(static_cast<uint8*>(m_mappedData) + offset, data, size);
-  }
-  else if (m_mappable) {
-    void* mappedData = nullptr;
-    VK_CHECK(vkMapMemory(m_device, m_memory, offset, size, 0, &mappedData));
-    memcpy(static_cast<uint8*>(mappedData), data, size);
-    vkUnmapMemory(m_device, m_memory);
-  }
-  else {
-    CH_LOG_ERROR(Vulkan, "Buffer is not mappable");
+  CH_ASSERT(offset + size <= m_size);
+
+  // Device local memory is written through the staging ring, ordered before the next
+  // graphics submit. Graphics only sees the buffer once a batch writing it was submitted,
+  // writes recorded before that, like a pool being filled, need no barrier against it
+  if (!m_allocation.mappedData) {
+    const bool inUse = m_firstUploadSerial != 0 &&
+                       m_firstUploadSerial <= m_uploadManager->getSubmittedSerial();
+    const uint64 serial = m_uploadManager->uploadBuffer(m_buffer, offset, data, size, inUse);
+    if (m_firstUploadSerial == 0) {
+      m_firstUploadSerial = serial;
+    }
+    m_lastUploadSerial = serial;
+    return;
   }
+
+  memcpy(m_allocation.mappedData + offset, data, size);
+  m_allocator->flush(m_allocation, offset, size);
 }
-} // namespace chEngineSDK
+} // namespace chEngineSDK
\ No newline at end of file
@@ -14,12 +14,18 @@
 #include "chVulkanPrerequisites.h"
 
 #include "chIBuffer.h"
+#include "chVulkanMemoryAllocator.h"
+#include "chVulkanUploadManager.h"
 
 namespace chEngineSDK {
 class VulkanBuffer : public IBuffer {
  public:
+  /**
+   * Initial data of memory the CPU can't map goes through the upload manager.
+   */
   VulkanBuffer(VkDevice device,
-               VkPhysicalDevice physicalDevice, 
+               VulkanMemoryAllocator& allocator,
+               VulkanUploadManager& uploadManager,
                const BufferCreateInfo& createInfo);
 
   ~VulkanBuffer();
@@ -35,10 +41,12 @@ class VulkanBuffer : public IBuffer {
 
  private:
   VkBuffer m_buffer = VK_NULL_HANDLE;
-  VkDeviceMemory m_memory = VK_NULL_HANDLE;
   VkDevice m_device = VK_NULL_HANDLE;
+  VulkanMemoryAllocator* m_allocator = nullptr;
+  VulkanUploadManager* m_uploadManager = nullptr;
+  VulkanAllocation m_allocation;
   SIZE_T m_size = 0;
-  bool m_mappable = false;
-  void* m_mappedData = nullptr;
+  uint64 m_firstUploadSerial = 0; ///< Upload batch of the first staged write, zero if none
+  uint64 m_lastUploadSerial = 0;  ///< Upload batch of the last staged write, zero if none
 };
 } // namespace chEngineSDK
\ No newline at end of file
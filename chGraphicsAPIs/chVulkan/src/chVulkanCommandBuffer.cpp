@@ -19,18 +19,22 @@
 #include "chVulkanFrameBuffer.h"
 #include "chVulkanPipeline.h"
 #include "chVulkanPipelineLayout.h"
+#include "chVulkanTexture.h"
 
 
 namespace chEngineSDK {
 /*
 */
-VulkanCommandBuffer::VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool)
-    : m_device(device), m_commandPool(commandPool) {
+VulkanCommandBuffer::VulkanCommandBuffer(VkDevice device,
+                                         VkCommandPool commandPool,
+                                         CommandBufferLevel level)
+    : m_device(device), m_level(level), m_commandPool(commandPool) {
   VkCommandBufferAllocateInfo allocInfo = {
     .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
     .pNext = nullptr,
     .commandPool = commandPool,
-    .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .level = level == CommandBufferLevel::Secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY
+                                                    : VK_COMMAND_BUFFER_LEVEL_PRIMARY,
     .commandBufferCount = 1
   };
 
@@ -65,6 +69,44 @@ VulkanCommandBuffer::begin() {
   m_state = CommandBufferState::Recording;
 }
 
+/*
+*/
+void
+VulkanCommandBuffer::beginSecondary(const CommandBufferInheritanceInfo& inheritanceInfo) {
+  CH_ASSERT(m_level == CommandBufferLevel::Secondary);
+  CH_ASSERT(inheritanceInfo.renderPass != nullptr);
+
+  auto vulkanRenderPass =
+      std::static_pointer_cast<VulkanRenderPass>(inheritanceInfo.renderPass);
+  VkFramebuffer framebuffer = VK_NULL_HANDLE;
+  if (inheritanceInfo.framebuffer) {
+    framebuffer =
+        std::static_pointer_cast<VulkanFrameBuffer>(inheritanceInfo.framebuffer)->getHandle();
+  }
+
+  VkCommandBufferInheritanceInfo vkInheritanceInfo = {
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+    .pNext = nullptr,
+    .renderPass = vulkanRenderPass->getHandle(),
+    .subpass = inheritanceInfo.subpass,
+    .framebuffer = framebuffer,
+    .occlusionQueryEnable = VK_FALSE,
+    .queryFlags = 0,
+    .pipelineStatistics = 0
+  };
+
+  VkCommandBufferBeginInfo beginInfo = {
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .pNext = nullptr,
+    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+             VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+    .pInheritanceInfo = &vkInheritanceInfo
+  };
+
+  VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &beginInfo));
+  m_state = CommandBufferState::Recording;
+}
+
 /*
 */
 void
@@ -112,7 +154,11 @@ VulkanCommandBuffer::beginRenderPass(const RenderPassBeginInfo& beginInfo) {
     .pClearValues = clearValues.data(),
   };
 
-  vkCmdBeginRenderPass(m_commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+  const VkSubpassContents contents =
+      beginInfo.contents == SubpassContents::SecondaryCommandBuffers
+          ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+          : VK_SUBPASS_CONTENTS_INLINE;
+  vkCmdBeginRenderPass(m_commandBuffer, &renderPassInfo, contents);
   //m_state = CommandBufferState::Executable;
 }
 
@@ -170,6 +216,44 @@ VulkanCommandBuffer::drawIndexed(uint32 indexCount, uint32 instanceCount, uint32
   //m_state = CommandBufferState::Executable;
 }
 
+/*
+*/
+void
+VulkanCommandBuffer::drawIndirect(SPtr<IBuffer> buffer,
+                                  uint64 offset,
+                                  uint32 drawCount,
+                                  uint32 stride) {
+  VkBuffer vkBuffer = std::static_pointer_cast<VulkanBuffer>(buffer)->getHandle();
+  if (drawCount <= 1 || g_vulkanAPI().isMultiDrawIndirectEnabled()) {
+    vkCmdDrawIndirect(m_commandBuffer, vkBuffer, offset, drawCount, stride);
+    return;
+  }
+
+  for (uint32 i = 0; i < drawCount; ++i) {
+    vkCmdDrawIndirect(m_commandBuffer, vkBuffer, offset + static_cast<uint64>(i) * stride,
+                      1, stride);
+  }
+}
+
+/*
+*/
+void
+VulkanCommandBuffer::drawIndexedIndirect(SPtr<IBuffer> buffer,
+                                         uint64 offset,
+                                         uint32 drawCount,
+                                         uint32 stride) {
+  VkBuffer vkBuffer = std::static_pointer_cast<VulkanBuffer>(buffer)->getHandle();
+  if (drawCount <= 1 || g_vulkanAPI().isMultiDrawIndirectEnabled()) {
+    vkCmdDrawIndexedIndirect(m_commandBuffer, vkBuffer, offset, drawCount, stride);
+    return;
+  }
+
+  for (uint32 i = 0; i < drawCount; ++i) {
+    vkCmdDrawIndexedIndirect(m_commandBuffer, vkBuffer,
+                             offset + static_cast<uint64>(i) * stride, 1, stride);
+  }
+}
+
 /*
 */
 void
@@ -240,6 +324,72 @@ VulkanCommandBuffer::bindDescriptorSets(PipelineBindPoint bindPoint,
                           dynamicOffsets.empty() ? nullptr : dynamicOffsets.data());
 }
 
+/*
+*/
+void
+VulkanCommandBuffer::executeCommands(const Vector<SPtr<ICommandBuffer>>& commandBuffers) {
+  CH_ASSERT(m_level == CommandBufferLevel::Primary);
+  if (commandBuffers.empty()) {
+    return;
+  }
+
+  Vector<VkCommandBuffer> vkCommandBuffers;
+  vkCommandBuffers.reserve(commandBuffers.size());
+  for (const auto& commandBuffer : commandBuffers) {
+    auto vulkanCommandBuffer = std::static_pointer_cast<VulkanCommandBuffer>(commandBuffer);
+    vkCommandBuffers.push_back(vulkanCommandBuffer->getHandle());
+  }
+
+  vkCmdExecuteCommands(m_commandBuffer,
+                       static_cast<uint32>(vkCommandBuffers.size()),
+                       vkCommandBuffers.data());
+}
+
+/*
+*/
+void
+VulkanCommandBuffer::pipelineBarrier(PipelineStageFlags srcStages,
+                                     PipelineStageFlags dstStages,
+                                     const Vector<TextureBarrier>& textureBarriers) {
+  Vector<VkImageMemoryBarrier> imageBarriers;
+  imageBarriers.reserve(textureBarriers.size());
+
+  for (const auto& textureBarrier : textureBarriers) {
+    CH_ASSERT(textureBarrier.texture != nullptr);
+    const auto& texture = static_cast<const VulkanTexture&>(*textureBarrier.texture);
+
+    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    if (texture.getFormat() == Format::D24_UNORM_S8_UINT) {
+      aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    else if (isDepthFormat(texture.getFormat())) {
+      aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = accessFlagsToVkAccessFlags(textureBarrier.srcAccess);
+    barrier.dstAccessMask = accessFlagsToVkAccessFlags(textureBarrier.dstAccess);
+    barrier.oldLayout = textureLayoutToVkImageLayout(textureBarrier.oldLayout);
+    barrier.newLayout = textureLayoutToVkImageLayout(textureBarrier.newLayout);
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.getHandle();
+    barrier.subresourceRange.aspectMask = aspectMask;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    imageBarriers.push_back(barrier);
+  }
+
+  vkCmdPipelineBarrier(m_commandBuffer,
+                       pipelineStageToVkPipelineStage(srcStages),
+                       pipelineStageToVkPipelineStage(dstStages),
+                       0,
+                       0, nullptr,
+                       0, nullptr,
+                       static_cast<uint32>(imageBarriers.size()), imageBarriers.data());
+}
+
 
 
 } // namespace chEngineSDK
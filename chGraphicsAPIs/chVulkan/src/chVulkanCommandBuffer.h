@@ -16,7 +16,9 @@
 namespace chEngineSDK {
 class VulkanCommandBuffer : public ICommandBuffer {
  public:
-  VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool);
+  VulkanCommandBuffer(VkDevice device,
+                      VkCommandPool commandPool,
+                      CommandBufferLevel level = CommandBufferLevel::Primary);
   ~VulkanCommandBuffer() override;
 
   NODISCARD void*
@@ -26,6 +28,10 @@ class VulkanCommandBuffer : public ICommandBuffer {
 
   void
   begin() override;
+
+  void
+  beginSecondary(const CommandBufferInheritanceInfo& inheritanceInfo) override;
+
   void
   end() override;
 
@@ -61,6 +67,18 @@ class VulkanCommandBuffer : public ICommandBuffer {
               int32 vertexOffset = 0,
               uint32 firstInstance = 0) override;
 
+  void
+  drawIndirect(SPtr<IBuffer> buffer,
+               uint64 offset,
+               uint32 drawCount = 1,
+               uint32 stride = sizeof(DrawIndirectCommand)) override;
+
+  void
+  drawIndexedIndirect(SPtr<IBuffer> buffer,
+                      uint64 offset,
+                      uint32 drawCount = 1,
+                      uint32 stride = sizeof(DrawIndexedIndirectCommand)) override;
+
   void
   setViewport(float x, float y,
               float width, float height,
@@ -76,6 +94,13 @@ class VulkanCommandBuffer : public ICommandBuffer {
                      const Vector<SPtr<IDescriptorSet>>& descriptorSets,
                      const Vector<uint32>& dynamicOffsets = {}) override;
 
+  void
+  pipelineBarrier(PipelineStageFlags srcStages,
+                  PipelineStageFlags dstStages,
+                  const Vector<TextureBarrier>& textureBarriers) override;
+
+  void
+  executeCommands(const Vector<SPtr<ICommandBuffer>>& commandBuffers) override;
 
   NODISCARD CommandBufferState
   getState() const {
@@ -91,6 +116,7 @@ class VulkanCommandBuffer : public ICommandBuffer {
   VkCommandBuffer m_commandBuffer = VK_NULL_HANDLE;
   VkDevice m_device = VK_NULL_HANDLE;
   CommandBufferState m_state = CommandBufferState::Initial;
+  CommandBufferLevel m_level = CommandBufferLevel::Primary;
   VkCommandPool m_commandPool = VK_NULL_HANDLE;
 };
 } // namespace chEngineSDK
@@ -46,8 +46,8 @@ VulkanCommandPool::~VulkanCommandPool() {
 /*
 */
 SPtr<ICommandBuffer>
-VulkanCommandPool::allocateCommandBuffer() {
-  return chMakeShared<VulkanCommandBuffer>(m_device, m_commandPool);
+VulkanCommandPool::allocateCommandBuffer(CommandBufferLevel level) {
+  return chMakeShared<VulkanCommandBuffer>(m_device, m_commandPool, level);
 }
 
 /*
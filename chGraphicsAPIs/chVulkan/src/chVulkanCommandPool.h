@@ -23,8 +23,8 @@ class VulkanCommandPool : public ICommandPool {
 
   ~VulkanCommandPool() override;
 
-  NODISCARD SPtr<ICommandBuffer> 
-  allocateCommandBuffer() override;
+  NODISCARD SPtr<ICommandBuffer>
+  allocateCommandBuffer(CommandBufferLevel level = CommandBufferLevel::Primary) override;
 
   void 
   reset() override;
@@ -12,6 +12,7 @@
 
 #include "chVulkanCommandQueue.h"
 
+#include "chVulkanAPI.h"
 #include "chVulkanCommandBuffer.h"
 #include "chVulkanCommandPool.h"
 #include "chVulkanSynchronization.h"
@@ -26,7 +27,7 @@ VulkanCommandQueue::VulkanCommandQueue(VkDevice device,
       m_queue(VK_NULL_HANDLE),
       m_queueType(queueType) ,
       m_graphicsQueueFamilyIndex(graphicsQueueIndex){
-  vkGetDeviceQueue(m_device, static_cast<uint32>(queueType), 0, &m_queue);
+  vkGetDeviceQueue(m_device, m_graphicsQueueFamilyIndex, 0, &m_queue);
 }
 
 /*
@@ -39,6 +40,11 @@ VulkanCommandQueue::~VulkanCommandQueue() {
 */
 void
 VulkanCommandQueue::submit(const SubmitInfo& submitInfo, const SPtr<IFence>& fence) {
+  // Pending staging copies go first, so this work sees the uploaded resources
+  if (m_queueType == QueueType::Graphics) {
+    g_vulkanAPI().getUploadManager().submit();
+  }
+
   Vector<VkCommandBuffer> vkCommandBuffers;
   Vector<VkSemaphore> vkWaitSemaphores;
   Vector<VkSemaphore> vkSignalSemaphores;
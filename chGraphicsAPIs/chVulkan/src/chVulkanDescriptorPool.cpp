@@ -37,6 +37,12 @@ VulkanDescriptorPool::VulkanDescriptorPool(VkDevice device,
       case DescriptorType::CombinedImageSampler:
         poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         break;
+      case DescriptorType::UniformBufferDynamic:
+        poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        break;
+      case DescriptorType::StorageBufferDynamic:
+        poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        break;
     }
 
     poolSize.descriptorCount = size.second;
@@ -48,7 +54,9 @@ VulkanDescriptorPool::VulkanDescriptorPool(VkDevice device,
   poolInfo.poolSizeCount = static_cast<uint32>(poolSizes.size());
   poolInfo.pPoolSizes = poolSizes.data();
   poolInfo.maxSets = createInfo.maxSets;
-  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  // Pools that are only reset in bulk let the driver allocate linearly
+  poolInfo.flags =
+      createInfo.freeDescriptorSets ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
 
   VK_CHECK(vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_pool));
 }
@@ -62,6 +70,15 @@ VulkanDescriptorPool::~VulkanDescriptorPool() {
 
 SPtr<IDescriptorSet>
 VulkanDescriptorPool::allocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) {
+  SPtr<IDescriptorSet> descriptorSet = tryAllocateDescriptorSet(allocInfo);
+  if (!descriptorSet) {
+    CH_EXCEPT(VulkanErrorException, "Descriptor pool has no room left for the set");
+  }
+  return descriptorSet;
+}
+
+SPtr<IDescriptorSet>
+VulkanDescriptorPool::tryAllocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) {
   auto vulkanLayout = std::static_pointer_cast<VulkanDescriptorSetLayout>(allocInfo.layout);
 
   VkDescriptorSetLayout layout = vulkanLayout->getHandle();
@@ -73,8 +90,17 @@ VulkanDescriptorPool::allocateDescriptorSet(const DescriptorSetAllocateInfo& all
   allocateInfo.pSetLayouts = &layout;
 
   VkDescriptorSet descriptorSet;
-  VK_CHECK(vkAllocateDescriptorSets(m_device, &allocateInfo, &descriptorSet));
+  const VkResult result = vkAllocateDescriptorSets(m_device, &allocateInfo, &descriptorSet);
+  if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+    return nullptr;
+  }
+  VK_CHECK(result);
 
   return chMakeShared<VulkanDescriptorSet>(m_device, descriptorSet);
 }
+
+void
+VulkanDescriptorPool::reset() {
+  VK_CHECK(vkResetDescriptorPool(m_device, m_pool, 0));
+}
 } // namespace chEngineSDK
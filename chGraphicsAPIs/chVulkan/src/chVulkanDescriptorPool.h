@@ -29,6 +29,12 @@ public:
   SPtr<IDescriptorSet>
   allocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) override;
 
+  SPtr<IDescriptorSet>
+  tryAllocateDescriptorSet(const DescriptorSetAllocateInfo& allocInfo) override;
+
+  void
+  reset() override;
+
   NODISCARD FORCEINLINE VkDescriptorPool
   getHandle() const { return m_pool; }
 
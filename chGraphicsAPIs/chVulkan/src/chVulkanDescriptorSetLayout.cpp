@@ -36,6 +36,12 @@ VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(VkDevice device,
       case DescriptorType::CombinedImageSampler:
         vkBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         break;
+      case DescriptorType::UniformBufferDynamic:
+        vkBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        break;
+      case DescriptorType::StorageBufferDynamic:
+        vkBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        break;
     }
     
     vkBinding.descriptorCount = binding.count;
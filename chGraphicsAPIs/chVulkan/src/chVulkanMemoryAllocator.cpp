@@ -0,0 +1,520 @@
+/************************************************************************/
+/**
+ * @file chVulkanMemoryAllocator.cpp
+ * @author AccelMR
+ * @date 2025/08/03
+ * @brief
+ * Block based device memory sub-allocator for buffers and images.
+ */
+/************************************************************************/
+#include "chVulkanMemoryAllocator.h"
+
+#include "chRangeAllocator.h"
+
+namespace chEngineSDK {
+struct VulkanMemoryBlock
+{
+  struct AllocationRecord
+  {
+    VkDeviceSize size;
+    VkDeviceSize alignment;
+    void* userData;
+  };
+
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  VkDeviceSize size = 0;
+  uint8* mappedData = nullptr;
+  uint32 poolIndex = 0;
+  bool dedicated = false;
+  UniquePtr<RangeAllocator> ranges;
+  UnorderedMap<VkDeviceSize, AllocationRecord> allocations;
+};
+
+namespace {
+constexpr uint32 RESOURCE_KIND_COUNT = 2;
+constexpr uint32 STRATEGY_COUNT = 2;
+
+FORCEINLINE VkDeviceSize
+alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+FORCEINLINE VkMemoryPropertyFlags
+getRequiredFlags(MemoryUsage usage) {
+  switch (usage) {
+  case MemoryUsage::GpuOnly:
+    return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+  case MemoryUsage::CpuOnly:
+  case MemoryUsage::CpuToGpu:
+    return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  case MemoryUsage::GpuToCpu:
+    return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+  }
+  return 0;
+}
+} // namespace
+
+/*
+*/
+VulkanMemoryAllocator::VulkanMemoryAllocator(VkDevice device,
+                                             VkPhysicalDevice physicalDevice,
+                                             VkDeviceSize blockSize)
+  : m_device(device),
+    m_blockSize(blockSize) {
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+  m_nonCoherentAtomSize = Math::max(properties.limits.nonCoherentAtomSize, VkDeviceSize(1));
+  m_maxAllocationCount = properties.limits.maxMemoryAllocationCount;
+
+  m_pools.resize(m_memoryProperties.memoryTypeCount * RESOURCE_KIND_COUNT * STRATEGY_COUNT);
+  for (uint32 type = 0; type < m_memoryProperties.memoryTypeCount; ++type) {
+    for (uint32 kind = 0; kind < RESOURCE_KIND_COUNT; ++kind) {
+      for (uint32 strategy = 0; strategy < STRATEGY_COUNT; ++strategy) {
+        Pool& pool = m_pools[getPoolIndex(type, static_cast<VulkanResourceKind>(kind),
+                                          static_cast<VulkanAllocationStrategy>(strategy))];
+        pool.memoryTypeIndex = type;
+        pool.strategy = static_cast<VulkanAllocationStrategy>(strategy);
+      }
+    }
+  }
+}
+
+/*
+*/
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+  LockGuard<Mutex> lock(m_mutex);
+  uint32 leakedAllocations = 0;
+  for (Pool& pool : m_pools) {
+    for (UniquePtr<VulkanMemoryBlock>& block : pool.blocks) {
+      leakedAllocations += block->ranges->getAllocationCount();
+      if (block->mappedData) {
+        vkUnmapMemory(m_device, block->memory);
+      }
+      vkFreeMemory(m_device, block->memory, nullptr);
+    }
+    pool.blocks.clear();
+  }
+
+  if (leakedAllocations > 0) {
+    CH_LOG_WARNING(Vulkan, "VulkanMemoryAllocator destroyed with {0} live allocations.",
+                   leakedAllocations);
+  }
+}
+
+/*
+*/
+VulkanAllocation
+VulkanMemoryAllocator::allocate(const VkMemoryRequirements& requirements,
+                                MemoryUsage usage,
+                                VulkanResourceKind kind,
+                                VulkanAllocationStrategy strategy) {
+  LockGuard<Mutex> lock(m_mutex);
+  const uint32 memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, usage);
+  const uint32 poolIndex = getPoolIndex(memoryTypeIndex, kind, strategy);
+
+  VkDeviceSize size = requirements.size;
+  VkDeviceSize alignment = Math::max(requirements.alignment, VkDeviceSize(1));
+  if (!isCoherent(memoryTypeIndex)) {
+    alignment = Math::max(alignment, m_nonCoherentAtomSize);
+    size = alignUp(size, m_nonCoherentAtomSize);
+  }
+
+  const VkDeviceSize blockSize = getPreferredBlockSize(memoryTypeIndex);
+  if (size > blockSize / 2) {
+    VulkanMemoryBlock* block = createBlock(poolIndex, size, true);
+    if (!block) {
+      CH_EXCEPT(VulkanErrorException,
+                chString::format("Out of device memory for a {0} byte allocation.", size));
+    }
+    return allocateFromBlock(*block, size, alignment);
+  }
+
+  for (UniquePtr<VulkanMemoryBlock>& block : m_pools[poolIndex].blocks) {
+    if (block->dedicated) {
+      continue;
+    }
+    VulkanAllocation allocation = allocateFromBlock(*block, size, alignment);
+    if (allocation.isValid()) {
+      return allocation;
+    }
+  }
+
+  // Smaller blocks when the device is running out, down to what the request needs
+  for (VkDeviceSize newBlockSize = blockSize; newBlockSize >= size; newBlockSize /= 2) {
+    if (VulkanMemoryBlock* block = createBlock(poolIndex, newBlockSize, false)) {
+      return allocateFromBlock(*block, size, alignment);
+    }
+  }
+
+  CH_EXCEPT(VulkanErrorException,
+            chString::format("Out of device memory for a {0} byte allocation.", size));
+}
+
+/*
+*/
+VulkanAllocation
+VulkanMemoryAllocator::allocateForBuffer(VkBuffer buffer,
+                                         MemoryUsage usage,
+                                         VulkanAllocationStrategy strategy) {
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(m_device, buffer, &requirements);
+
+  VulkanAllocation allocation =
+      allocate(requirements, usage, VulkanResourceKind::Buffer, strategy);
+  VK_CHECK(vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset));
+  return allocation;
+}
+
+/*
+*/
+VulkanAllocation
+VulkanMemoryAllocator::allocateForImage(VkImage image, MemoryUsage usage) {
+  VkMemoryRequirements requirements;
+  vkGetImageMemoryRequirements(m_device, image, &requirements);
+
+  VulkanAllocation allocation = allocate(requirements, usage, VulkanResourceKind::Image);
+  VK_CHECK(vkBindImageMemory(m_device, image, allocation.memory, allocation.offset));
+  return allocation;
+}
+
+/*
+ * One empty block per pool is kept so allocations coming and going don't thrash
+ * vkAllocateMemory, dedicated blocks go right away.
+ */
+void
+VulkanMemoryAllocator::free(VulkanAllocation& allocation) {
+  if (!allocation.isValid()) {
+    return;
+  }
+
+  LockGuard<Mutex> lock(m_mutex);
+  VulkanMemoryBlock* block = allocation.block;
+  CH_ASSERT(block && block->memory == allocation.memory);
+  block->ranges->free(allocation.offset);
+  block->allocations.erase(allocation.offset);
+  allocation = VulkanAllocation();
+
+  if (!block->ranges->isEmpty()) {
+    return;
+  }
+
+  bool keepBlock = !block->dedicated;
+  if (keepBlock) {
+    for (const UniquePtr<VulkanMemoryBlock>& other : m_pools[block->poolIndex].blocks) {
+      if (other.get() != block && !other->dedicated && other->ranges->isEmpty()) {
+        keepBlock = false;
+        break;
+      }
+    }
+  }
+
+  if (!keepBlock) {
+    destroyBlock(block);
+  }
+}
+
+/*
+*/
+void
+VulkanMemoryAllocator::setUserData(const VulkanAllocation& allocation, void* userData) {
+  LockGuard<Mutex> lock(m_mutex);
+  auto it = allocation.block->allocations.find(allocation.offset);
+  CH_ASSERT(it != allocation.block->allocations.end());
+  it->second.userData = userData;
+}
+
+/*
+*/
+void
+VulkanMemoryAllocator::flush(const VulkanAllocation& allocation,
+                             VkDeviceSize offset,
+                             VkDeviceSize size) {
+  if (!allocation.isValid() || isCoherent(allocation.memoryTypeIndex)) {
+    return;
+  }
+
+  // The allocation itself is atom aligned, so rounding stays inside it
+  const VkDeviceSize begin = offset - offset % m_nonCoherentAtomSize;
+  const VkDeviceSize end = size == VK_WHOLE_SIZE
+                               ? allocation.size
+                               : Math::min(alignUp(offset + size, m_nonCoherentAtomSize),
+                                           allocation.size);
+  const VkMappedMemoryRange range{.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+                                  .pNext = nullptr,
+                                  .memory = allocation.memory,
+                                  .offset = allocation.offset + begin,
+                                  .size = end - begin};
+  VK_CHECK(vkFlushMappedMemoryRanges(m_device, 1, &range));
+}
+
+/*
+ * Blocks are sorted most used first, allocations of the tail move towards the head.
+ */
+uint32
+VulkanMemoryAllocator::defragment(const VulkanDefragmentationMoveFunc& move) {
+  LockGuard<Mutex> lock(m_mutex);
+  uint32 moved = 0;
+
+  for (Pool& pool : m_pools) {
+    if (pool.strategy != VulkanAllocationStrategy::General || pool.blocks.size() < 2) {
+      continue;
+    }
+
+    Vector<VulkanMemoryBlock*> blocks;
+    for (const UniquePtr<VulkanMemoryBlock>& block : pool.blocks) {
+      if (!block->dedicated) {
+        blocks.push_back(block.get());
+      }
+    }
+    std::sort(blocks.begin(), blocks.end(),
+              [](const VulkanMemoryBlock* a, const VulkanMemoryBlock* b) {
+                return a->ranges->getUsedSize() > b->ranges->getUsedSize();
+              });
+
+    for (SIZE_T source = blocks.size(); source-- > 1;) {
+      VulkanMemoryBlock& sourceBlock = *blocks[source];
+      const Vector<Pair<VkDeviceSize, VulkanMemoryBlock::AllocationRecord>> records(
+          sourceBlock.allocations.begin(), sourceBlock.allocations.end());
+
+      for (const auto& [offset, record] : records) {
+        VulkanAllocation from;
+        from.memory = sourceBlock.memory;
+        from.offset = offset;
+        from.size = record.size;
+        from.mappedData = sourceBlock.mappedData ? sourceBlock.mappedData + offset : nullptr;
+        from.memoryTypeIndex = pool.memoryTypeIndex;
+        from.block = &sourceBlock;
+
+        for (SIZE_T destination = 0; destination < source; ++destination) {
+          VulkanAllocation to =
+              allocateFromBlock(*blocks[destination], record.size, record.alignment);
+          if (!to.isValid()) {
+            continue;
+          }
+
+          if (move(from, to, record.userData)) {
+            blocks[destination]->allocations[to.offset].userData = record.userData;
+            sourceBlock.ranges->free(offset);
+            sourceBlock.allocations.erase(offset);
+            ++moved;
+          }
+          else {
+            blocks[destination]->ranges->free(to.offset);
+            blocks[destination]->allocations.erase(to.offset);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  releaseEmptyBlocksLocked();
+  return moved;
+}
+
+/*
+*/
+uint32
+VulkanMemoryAllocator::releaseEmptyBlocks() {
+  LockGuard<Mutex> lock(m_mutex);
+  return releaseEmptyBlocksLocked();
+}
+
+/*
+*/
+VulkanMemoryStats
+VulkanMemoryAllocator::getStats() const {
+  LockGuard<Mutex> lock(m_mutex);
+  VulkanMemoryStats stats;
+  for (const Pool& pool : m_pools) {
+    for (const UniquePtr<VulkanMemoryBlock>& block : pool.blocks) {
+      addStats(stats, *block);
+    }
+  }
+  return stats;
+}
+
+/*
+*/
+VulkanMemoryStats
+VulkanMemoryAllocator::getHeapStats(uint32 heapIndex) const {
+  LockGuard<Mutex> lock(m_mutex);
+  VulkanMemoryStats stats;
+  for (const Pool& pool : m_pools) {
+    if (m_memoryProperties.memoryTypes[pool.memoryTypeIndex].heapIndex != heapIndex) {
+      continue;
+    }
+    for (const UniquePtr<VulkanMemoryBlock>& block : pool.blocks) {
+      addStats(stats, *block);
+    }
+  }
+  return stats;
+}
+
+/*
+ * Memory types are listed by the driver from the most to the least performant.
+ */
+uint32
+VulkanMemoryAllocator::findMemoryType(uint32 memoryTypeBits, MemoryUsage usage) const {
+  const VkMemoryPropertyFlags required = getRequiredFlags(usage);
+  for (uint32 i = 0; i < m_memoryProperties.memoryTypeCount; ++i) {
+    if ((memoryTypeBits & (1u << i)) &&
+        (m_memoryProperties.memoryTypes[i].propertyFlags & required) == required) {
+      return i;
+    }
+  }
+
+  CH_EXCEPT(VulkanErrorException, "Failed to find suitable memory type");
+}
+
+/*
+*/
+uint32
+VulkanMemoryAllocator::getPoolIndex(uint32 memoryTypeIndex,
+                                    VulkanResourceKind kind,
+                                    VulkanAllocationStrategy strategy) const {
+  return (memoryTypeIndex * RESOURCE_KIND_COUNT + static_cast<uint32>(kind)) *
+             STRATEGY_COUNT +
+         static_cast<uint32>(strategy);
+}
+
+/*
+*/
+VkDeviceSize
+VulkanMemoryAllocator::getPreferredBlockSize(uint32 memoryTypeIndex) const {
+  const uint32 heapIndex = m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+  const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[heapIndex].size;
+  return heapSize <= SMALL_HEAP_SIZE ? alignUp(heapSize / 8, 32) : m_blockSize;
+}
+
+/*
+*/
+bool
+VulkanMemoryAllocator::isCoherent(uint32 memoryTypeIndex) const {
+  const VkMemoryPropertyFlags flags =
+      m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+  return !(flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ||
+         (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
+/*
+*/
+VulkanMemoryBlock*
+VulkanMemoryAllocator::createBlock(uint32 poolIndex, VkDeviceSize size, bool dedicated) {
+  Pool& pool = m_pools[poolIndex];
+  const VkMemoryAllocateInfo allocateInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                                          .pNext = nullptr,
+                                          .allocationSize = size,
+                                          .memoryTypeIndex = pool.memoryTypeIndex};
+
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  const VkResult result = vkAllocateMemory(m_device, &allocateInfo, nullptr, &memory);
+  if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY || result == VK_ERROR_OUT_OF_HOST_MEMORY) {
+    return nullptr;
+  }
+  VK_CHECK(result);
+
+  if (++m_deviceAllocationCount > m_maxAllocationCount) {
+    CH_LOG_WARNING(Vulkan, "{0} device memory allocations, the device supports {1}.",
+                   m_deviceAllocationCount, m_maxAllocationCount);
+  }
+
+  UniquePtr<VulkanMemoryBlock> block = chMakeUnique<VulkanMemoryBlock>();
+  block->memory = memory;
+  block->size = size;
+  block->poolIndex = poolIndex;
+  block->dedicated = dedicated;
+  if (pool.strategy == VulkanAllocationStrategy::Linear && !dedicated) {
+    block->ranges = UniquePtr<RangeAllocator>(new LinearRangeAllocator(size));
+  }
+  else {
+    block->ranges = UniquePtr<RangeAllocator>(new TLSFRangeAllocator(size));
+  }
+
+  const VkMemoryPropertyFlags flags =
+      m_memoryProperties.memoryTypes[pool.memoryTypeIndex].propertyFlags;
+  if (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+    void* mappedData = nullptr;
+    VK_CHECK(vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, &mappedData));
+    block->mappedData = static_cast<uint8*>(mappedData);
+  }
+
+  pool.blocks.push_back(std::move(block));
+  return pool.blocks.back().get();
+}
+
+/*
+*/
+void
+VulkanMemoryAllocator::destroyBlock(VulkanMemoryBlock* block) {
+  CH_ASSERT(block->ranges->isEmpty());
+  if (block->mappedData) {
+    vkUnmapMemory(m_device, block->memory);
+  }
+  vkFreeMemory(m_device, block->memory, nullptr);
+  --m_deviceAllocationCount;
+
+  Vector<UniquePtr<VulkanMemoryBlock>>& blocks = m_pools[block->poolIndex].blocks;
+  auto it = std::find_if(blocks.begin(), blocks.end(),
+                         [block](const UniquePtr<VulkanMemoryBlock>& candidate) {
+                           return candidate.get() == block;
+                         });
+  CH_ASSERT(it != blocks.end());
+  blocks.erase(it);
+}
+
+/*
+*/
+VulkanAllocation
+VulkanMemoryAllocator::allocateFromBlock(VulkanMemoryBlock& block,
+                                         VkDeviceSize size,
+                                         VkDeviceSize alignment) {
+  VulkanAllocation allocation;
+  const uint64 offset = block.ranges->allocate(size, alignment);
+  if (offset == RangeAllocator::INVALID_OFFSET) {
+    return allocation;
+  }
+
+  block.allocations[offset] = {.size = size, .alignment = alignment, .userData = nullptr};
+  allocation.memory = block.memory;
+  allocation.offset = offset;
+  allocation.size = size;
+  allocation.mappedData = block.mappedData ? block.mappedData + offset : nullptr;
+  allocation.memoryTypeIndex = m_pools[block.poolIndex].memoryTypeIndex;
+  allocation.block = &block;
+  return allocation;
+}
+
+/*
+*/
+void
+VulkanMemoryAllocator::addStats(VulkanMemoryStats& stats,
+                                const VulkanMemoryBlock& block) const {
+  ++stats.blockCount;
+  stats.dedicatedBlockCount += block.dedicated ? 1 : 0;
+  stats.allocationCount += block.ranges->getAllocationCount();
+  stats.reservedBytes += block.size;
+  stats.usedBytes += block.ranges->getUsedSize();
+}
+
+/*
+*/
+uint32
+VulkanMemoryAllocator::releaseEmptyBlocksLocked() {
+  Vector<VulkanMemoryBlock*> emptyBlocks;
+  for (const Pool& pool : m_pools) {
+    for (const UniquePtr<VulkanMemoryBlock>& block : pool.blocks) {
+      if (block->ranges->isEmpty()) {
+        emptyBlocks.push_back(block.get());
+      }
+    }
+  }
+
+  for (VulkanMemoryBlock* block : emptyBlocks) {
+    destroyBlock(block);
+  }
+  return static_cast<uint32>(emptyBlocks.size());
+}
+} // namespace chEngineSDK
@@ -0,0 +1,235 @@
+/************************************************************************/
+/**
+ * @file chVulkanMemoryAllocator.h
+ * @author AccelMR
+ * @date 2025/08/03
+ * @brief
+ * Block based device memory sub-allocator for buffers and images.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chVulkanPrerequisites.h"
+
+namespace chEngineSDK {
+struct VulkanMemoryBlock;
+
+/**
+ * Resources with linear and optimal tiling live in different blocks, so neighbours
+ * never have to honour bufferImageGranularity.
+ */
+enum class VulkanResourceKind : uint8 {
+  Buffer,
+  Image
+};
+
+enum class VulkanAllocationStrategy : uint8 {
+  General, ///< TLSF, for resources with their own lifetimes
+  Linear   ///< Bump allocated, a block is reclaimed when all its allocations are freed
+};
+
+/**
+ * A range inside a VkDeviceMemory, owned by whoever asked the allocator for it
+ */
+struct VulkanAllocation
+{
+  NODISCARD FORCEINLINE bool
+  isValid() const { return memory != VK_NULL_HANDLE; }
+
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  VkDeviceSize offset = 0;
+  VkDeviceSize size = 0;
+  uint8* mappedData = nullptr; ///< Start of the range for host visible memory
+  uint32 memoryTypeIndex = 0;
+  VulkanMemoryBlock* block = nullptr;
+};
+
+struct VulkanMemoryStats
+{
+  uint32 blockCount = 0;
+  uint32 dedicatedBlockCount = 0;
+  uint32 allocationCount = 0;
+  VkDeviceSize reservedBytes = 0;
+  VkDeviceSize usedBytes = 0;
+};
+
+/**
+ * Called for every allocation defragment wants to move. The destination range is already
+ * reserved, the callback copies the contents, binds a new resource to it and updates the
+ * owner found through userData. Returning false keeps the allocation where it was.
+ * It runs under the allocator lock and must not call the allocator.
+ */
+using VulkanDefragmentationMoveFunc = Function<bool(const VulkanAllocation& from,
+                                                    const VulkanAllocation& to,
+                                                    void* userData)>;
+
+/*
+ * Description:
+ *     Sub-allocates buffers and images from big VkDeviceMemory blocks instead of calling
+ *     vkAllocateMemory per resource. Every memory type has its own pools, split by
+ *     resource kind and strategy. Requests larger than half a block get a dedicated block
+ *     that is released with them. Host visible blocks stay mapped for their whole life,
+ *     ranges of non coherent memory are aligned to nonCoherentAtomSize so they can be
+ *     flushed on their own.
+ *
+ *     Thread safe.
+ *
+ * Sample usage:
+ *  VulkanAllocation allocation = allocator.allocateForBuffer(buffer, MemoryUsage::CpuToGpu);
+ *  memcpy(allocation.mappedData, data, size);
+ *  allocator.flush(allocation);
+ *  ...
+ *  vkDestroyBuffer(device, buffer, nullptr);
+ *  allocator.free(allocation);
+ */
+class VulkanMemoryAllocator
+{
+ public:
+  static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+  /**
+   * Heaps up to this size use an eighth of the heap as block size.
+   */
+  static constexpr VkDeviceSize SMALL_HEAP_SIZE = 1024ull * 1024 * 1024;
+
+  VulkanMemoryAllocator(VkDevice device,
+                        VkPhysicalDevice physicalDevice,
+                        VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+
+  ~VulkanMemoryAllocator();
+
+  VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+  VulkanMemoryAllocator&
+  operator=(const VulkanMemoryAllocator&) = delete;
+
+  /**
+   * Allocate memory for a resource
+   * Throws VulkanErrorException when no memory type fits or the device is out of memory.
+   *
+   * @param requirements Requirements reported by the driver for the resource
+   * @param usage How the CPU and GPU access the memory
+   * @param kind Buffer or optimal tiling image
+   * @param strategy Pool strategy to allocate from
+   * @return The allocation, not bound to anything yet
+   */
+  NODISCARD VulkanAllocation
+  allocate(const VkMemoryRequirements& requirements,
+           MemoryUsage usage,
+           VulkanResourceKind kind,
+           VulkanAllocationStrategy strategy = VulkanAllocationStrategy::General);
+
+  /**
+   * Allocate memory for a buffer and bind it
+   */
+  NODISCARD VulkanAllocation
+  allocateForBuffer(VkBuffer buffer,
+                    MemoryUsage usage,
+                    VulkanAllocationStrategy strategy = VulkanAllocationStrategy::General);
+
+  /**
+   * Allocate memory for an optimal tiling image and bind it
+   */
+  NODISCARD VulkanAllocation
+  allocateForImage(VkImage image, MemoryUsage usage);
+
+  /**
+   * Give the range back, the allocation is reset. The resource bound to it must be
+   * destroyed already, or at least not used any more.
+   */
+  void
+  free(VulkanAllocation& allocation);
+
+  /**
+   * Attach a pointer that defragment hands to its move callback
+   */
+  void
+  setUserData(const VulkanAllocation& allocation, void* userData);
+
+  /**
+   * Make CPU writes visible to the device, does nothing for coherent memory
+   *
+   * @param allocation Allocation written through mappedData
+   * @param offset Offset of the written bytes inside the allocation
+   * @param size Written bytes, VK_WHOLE_SIZE for everything after offset
+   */
+  void
+  flush(const VulkanAllocation& allocation,
+        VkDeviceSize offset = 0,
+        VkDeviceSize size = VK_WHOLE_SIZE);
+
+  /**
+   * Move allocations of the least used general blocks into the most used ones and free
+   * the blocks left empty
+   *
+   * @param move Callback that relocates a resource
+   * @return Number of allocations moved
+   */
+  uint32
+  defragment(const VulkanDefragmentationMoveFunc& move);
+
+  /**
+   * Free every block without allocations
+   *
+   * @return Number of blocks freed
+   */
+  uint32
+  releaseEmptyBlocks();
+
+  NODISCARD VulkanMemoryStats
+  getStats() const;
+
+  NODISCARD VulkanMemoryStats
+  getHeapStats(uint32 heapIndex) const;
+
+ private:
+  struct Pool
+  {
+    Vector<UniquePtr<VulkanMemoryBlock>> blocks;
+    uint32 memoryTypeIndex = 0;
+    VulkanAllocationStrategy strategy = VulkanAllocationStrategy::General;
+  };
+
+  NODISCARD uint32
+  findMemoryType(uint32 memoryTypeBits, MemoryUsage usage) const;
+
+  NODISCARD uint32
+  getPoolIndex(uint32 memoryTypeIndex,
+               VulkanResourceKind kind,
+               VulkanAllocationStrategy strategy) const;
+
+  NODISCARD VkDeviceSize
+  getPreferredBlockSize(uint32 memoryTypeIndex) const;
+
+  NODISCARD bool
+  isCoherent(uint32 memoryTypeIndex) const;
+
+  /**
+   * Create a block in the pool, nullptr if the device is out of memory
+   */
+  NODISCARD VulkanMemoryBlock*
+  createBlock(uint32 poolIndex, VkDeviceSize size, bool dedicated);
+
+  void
+  destroyBlock(VulkanMemoryBlock* block);
+
+  NODISCARD VulkanAllocation
+  allocateFromBlock(VulkanMemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment);
+
+  void
+  addStats(VulkanMemoryStats& stats, const VulkanMemoryBlock& block) const;
+
+  uint32
+  releaseEmptyBlocksLocked();
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  VkDeviceSize m_blockSize = DEFAULT_BLOCK_SIZE;
+  VkDeviceSize m_nonCoherentAtomSize = 1;
+  uint32 m_maxAllocationCount = 0;
+  uint32 m_deviceAllocationCount = 0;
+
+  // memoryTypeCount * resource kinds * strategies
+  Vector<Pool> m_pools;
+  mutable Mutex m_mutex;
+};
+} // namespace chEngineSDK
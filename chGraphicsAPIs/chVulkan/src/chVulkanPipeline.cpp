@@ -21,7 +21,9 @@
 namespace chEngineSDK {
 /*
 */
-VulkanPipeline::VulkanPipeline(VkDevice device, const PipelineCreateInfo& createInfo)
+VulkanPipeline::VulkanPipeline(VkDevice device,
+                               VkPipelineCache pipelineCache,
+                               const PipelineCreateInfo& createInfo)
     : m_device(device) {
 
   Vector<VkDescriptorSetLayout> descriptorSetLayouts;
@@ -79,7 +81,9 @@ VulkanPipeline::VulkanPipeline(VkDevice device, const PipelineCreateInfo& create
     VkVertexInputBindingDescription bindingDesc = {
       .binding = i,
       .stride = layout.getStride(i),
-      .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+      .inputRate = layout.getInputRate(i) == VertexInputRate::Instance
+                       ? VK_VERTEX_INPUT_RATE_INSTANCE
+                       : VK_VERTEX_INPUT_RATE_VERTEX
     };
     bindingDescriptions.push_back(bindingDesc);
   }
@@ -231,7 +235,8 @@ VulkanPipeline::VulkanPipeline(VkDevice device, const PipelineCreateInfo& create
     .basePipelineIndex = 0
   };
 
-  VK_CHECK(vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  VK_CHECK(vkCreateGraphicsPipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr,
+                                     &m_pipeline));
 }
 
 /*
@@ -17,7 +17,9 @@
 namespace chEngineSDK {
 class VulkanPipeline : public IPipeline {
  public:
-  VulkanPipeline(VkDevice device, const PipelineCreateInfo& createInfo);
+  VulkanPipeline(VkDevice device,
+                 VkPipelineCache pipelineCache,
+                 const PipelineCreateInfo& createInfo);
   ~VulkanPipeline() override;
 
   NODISCARD FORCEINLINE virtual VkPipeline
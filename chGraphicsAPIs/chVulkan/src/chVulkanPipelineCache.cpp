@@ -0,0 +1,212 @@
+/************************************************************************/
+/**
+ * @file chVulkanPipelineCache.cpp
+ * @author AccelMR
+ * @date 2025/08/06
+ * @brief
+ * VkPipelineCache persisted between runs.
+ */
+/************************************************************************/
+#include "chVulkanPipelineCache.h"
+
+#include "chFileStream.h"
+#include "chFileSystem.h"
+
+namespace chEngineSDK {
+namespace {
+constexpr uint32 CACHE_FILE_MAGIC = 0x43504843; // CHPC
+constexpr uint32 CACHE_FILE_VERSION = 1;
+
+struct CacheFileHeader
+{
+  uint32 magic;
+  uint32 version;
+  uint32 vendorID;
+  uint32 deviceID;
+  uint32 driverVersion;
+  uint8 pipelineCacheUUID[VK_UUID_SIZE];
+  uint64 dataSize;
+  uint64 checksum;
+};
+
+/*
+ * FNV-1a, catches truncated or damaged files before the driver sees them
+ */
+uint64
+computeChecksum(const uint8* data, SIZE_T size) {
+  uint64 hash = 14695981039346656037ull;
+  for (SIZE_T i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+} // namespace
+
+/*
+*/
+VulkanPipelineCache::VulkanPipelineCache(VkDevice device,
+                                         VkPhysicalDevice physicalDevice,
+                                         const Path& filePath)
+  : m_device(device),
+    m_filePath(filePath) {
+  vkGetPhysicalDeviceProperties(physicalDevice, &m_deviceProperties);
+
+  const Vector<uint8> initialData = loadCacheData();
+
+  VkPipelineCacheCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  createInfo.initialDataSize = initialData.size();
+  createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+  VkResult result = vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache);
+  if (result != VK_SUCCESS && !initialData.empty()) {
+    CH_LOG_WARNING(Vulkan, "Driver rejected pipeline cache {0}, starting empty",
+                   m_filePath.toString());
+    createInfo.initialDataSize = 0;
+    createInfo.pInitialData = nullptr;
+    result = vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache);
+  }
+  else {
+    m_bIsWarm = !initialData.empty();
+  }
+  VK_CHECK(result);
+
+  if (m_bIsWarm) {
+    CH_LOG_INFO(Vulkan, "Pipeline cache loaded {0} bytes from {1}", initialData.size(),
+                m_filePath.toString());
+  }
+}
+
+/*
+*/
+VulkanPipelineCache::~VulkanPipelineCache() {
+  if (m_pipelineCache != VK_NULL_HANDLE) {
+    vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+    m_pipelineCache = VK_NULL_HANDLE;
+  }
+}
+
+/*
+*/
+bool
+VulkanPipelineCache::save() const {
+  SIZE_T dataSize = 0;
+  VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, nullptr));
+
+  Vector<uint8> data(dataSize);
+  // Pipelines created meanwhile can grow the cache, a truncated copy is still valid
+  const VkResult result = vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize,
+                                                 data.data());
+  if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+    CH_LOG_ERROR(Vulkan, "Failed to read pipeline cache data");
+    return false;
+  }
+  data.resize(dataSize);
+
+  const Vector<uint8> file = buildCacheFile(m_deviceProperties, data);
+
+  // Written next to the old file first, a crash halfway never leaves a broken cache
+  const Path tempPath(m_filePath.toString() + ".tmp");
+  SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+  if (!stream) {
+    CH_LOG_WARNING(Vulkan, "Could not create pipeline cache file {0}", tempPath.toString());
+    return false;
+  }
+  stream->write(file.data(), file.size());
+  stream->close();
+
+  if (!FileSystem::renameFile(tempPath, m_filePath)) {
+    CH_LOG_WARNING(Vulkan, "Could not replace pipeline cache file {0}",
+                   m_filePath.toString());
+    return false;
+  }
+
+  CH_LOG_INFO(Vulkan, "Pipeline cache saved {0} bytes, {1} pipelines took {2} ms ({3} cache)",
+              data.size(), m_pipelineCount.load(), m_creationMicroseconds.load() / 1000,
+              m_bIsWarm ? "warm" : "cold");
+  return true;
+}
+
+/*
+*/
+Vector<uint8>
+VulkanPipelineCache::loadCacheData() const {
+  if (!FileSystem::isFile(m_filePath)) {
+    return {};
+  }
+
+  Vector<uint8> data;
+  switch (readCacheFile(m_deviceProperties, FileSystem::fastRead(m_filePath), data)) {
+  case PipelineCacheFileStatus::Valid:
+    break;
+  case PipelineCacheFileStatus::Truncated:
+    CH_LOG_WARNING(Vulkan, "Pipeline cache {0} is truncated, ignoring it",
+                   m_filePath.toString());
+    break;
+  case PipelineCacheFileStatus::Damaged:
+    CH_LOG_WARNING(Vulkan, "Pipeline cache {0} is damaged, ignoring it",
+                   m_filePath.toString());
+    break;
+  case PipelineCacheFileStatus::OtherDevice:
+    CH_LOG_INFO(Vulkan, "Pipeline cache {0} belongs to another device or driver, rebuilding",
+                m_filePath.toString());
+    break;
+  }
+  return data;
+}
+
+/*
+*/
+Vector<uint8>
+VulkanPipelineCache::buildCacheFile(const VkPhysicalDeviceProperties& properties,
+                                    const Vector<uint8>& data) {
+  CacheFileHeader header{};
+  header.magic = CACHE_FILE_MAGIC;
+  header.version = CACHE_FILE_VERSION;
+  header.vendorID = properties.vendorID;
+  header.deviceID = properties.deviceID;
+  header.driverVersion = properties.driverVersion;
+  memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+  header.dataSize = data.size();
+  header.checksum = computeChecksum(data.data(), data.size());
+
+  Vector<uint8> file(sizeof(header) + data.size());
+  memcpy(file.data(), &header, sizeof(header));
+  if (!data.empty()) {
+    memcpy(file.data() + sizeof(header), data.data(), data.size());
+  }
+  return file;
+}
+
+/*
+*/
+PipelineCacheFileStatus
+VulkanPipelineCache::readCacheFile(const VkPhysicalDeviceProperties& properties,
+                                   const Vector<uint8>& file,
+                                   Vector<uint8>& outData) {
+  CacheFileHeader header{};
+  if (file.size() < sizeof(header)) {
+    return PipelineCacheFileStatus::Truncated;
+  }
+  memcpy(&header, file.data(), sizeof(header));
+
+  const uint8* data = file.data() + sizeof(header);
+  const SIZE_T dataSize = file.size() - sizeof(header);
+
+  if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION ||
+      header.dataSize != dataSize || header.checksum != computeChecksum(data, dataSize)) {
+    return PipelineCacheFileStatus::Damaged;
+  }
+
+  if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+      header.driverVersion != properties.driverVersion ||
+      memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+    return PipelineCacheFileStatus::OtherDevice;
+  }
+
+  outData.assign(data, data + dataSize);
+  return PipelineCacheFileStatus::Valid;
+}
+
+} // namespace chEngineSDK
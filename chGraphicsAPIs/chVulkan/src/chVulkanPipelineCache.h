@@ -0,0 +1,130 @@
+/************************************************************************/
+/**
+ * @file chVulkanPipelineCache.h
+ * @author AccelMR
+ * @date 2025/08/06
+ * @brief
+ * VkPipelineCache persisted between runs.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chVulkanPrerequisites.h"
+
+#include "chPath.h"
+
+namespace chEngineSDK {
+/**
+ * What readCacheFile found in a cache file
+ */
+enum class PipelineCacheFileStatus : uint8 {
+  Valid,
+  Truncated,  ///< Shorter than its header
+  Damaged,    ///< Wrong magic, version, size or checksum
+  OtherDevice ///< Written by another device, driver version or cache UUID
+};
+
+/*
+ * Description:
+ *     Pipeline cache shared by every pipeline the device creates. The driver data is
+ *     loaded from disk on construction and written back by save, so shaders compiled in a
+ *     previous run are not compiled again.
+ *
+ *     The file starts with a header holding the vendor, device, driver version and
+ *     pipeline cache UUID it was written with plus a checksum of the data. A file that
+ *     doesn't match the current device or driver is ignored and the cache starts empty,
+ *     some drivers don't survive foreign or truncated data.
+ *
+ *     VkPipelineCache is internally synchronized, pipelines can be created from several
+ *     threads at the same time. Nothing does so yet: VulkanAPI::createPipeline builds one
+ *     pipeline on the calling thread and the renderer only creates one at startup, so
+ *     there is no batch to spread over the JobSystem. The creation time save() logs
+ *     against the warm / cold state is what a parallel path would be measured with.
+ *
+ * Sample usage:
+ *  VulkanPipelineCache cache(device, physicalDevice, cachePath);
+ *  vkCreateGraphicsPipelines(device, cache.getHandle(), 1, &info, nullptr, &pipeline);
+ *  ...
+ *  cache.save();
+ */
+class VulkanPipelineCache
+{
+ public:
+  VulkanPipelineCache(VkDevice device, VkPhysicalDevice physicalDevice, const Path& filePath);
+
+  ~VulkanPipelineCache();
+
+  VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache&
+  operator=(const VulkanPipelineCache&) = delete;
+
+  /**
+   * Write the cache to its file, replacing the previous one only once the new one is
+   * complete.
+   *
+   * @return True if the file was written
+   */
+  bool
+  save() const;
+
+  /**
+   * Account a pipeline creation, reported when the cache is saved to compare runs with
+   * and without cached data.
+   */
+  FORCEINLINE void
+  addPipelineCreation(uint64 microseconds) {
+    ++m_pipelineCount;
+    m_creationMicroseconds += microseconds;
+  }
+
+  /**
+   * Header plus driver data, as written to the cache file.
+   *
+   * @param properties Device the data was read from
+   * @param data Driver data from vkGetPipelineCacheData
+   */
+  NODISCARD static Vector<uint8>
+  buildCacheFile(const VkPhysicalDeviceProperties& properties, const Vector<uint8>& data);
+
+  /**
+   * Validate a cache file against a device and extract its driver data.
+   *
+   * @param properties Device the data is going to be loaded on
+   * @param file Whole contents of the cache file
+   * @param outData Driver data, only filled if the file is valid
+   */
+  NODISCARD static PipelineCacheFileStatus
+  readCacheFile(const VkPhysicalDeviceProperties& properties,
+                const Vector<uint8>& file,
+                Vector<uint8>& outData);
+
+  NODISCARD FORCEINLINE VkPipelineCache
+  getHandle() const {
+    return m_pipelineCache;
+  }
+
+  /**
+   * True if the cache started with data from a previous run
+   */
+  NODISCARD FORCEINLINE bool
+  isWarm() const {
+    return m_bIsWarm;
+  }
+
+ private:
+  /**
+   * Reads the cache file, empty if it is missing or was written for another device
+   */
+  NODISCARD Vector<uint8>
+  loadCacheData() const;
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+  VkPhysicalDeviceProperties m_deviceProperties{};
+  Path m_filePath;
+  bool m_bIsWarm = false;
+
+  Atomic<uint32> m_pipelineCount{0};
+  Atomic<uint64> m_creationMicroseconds{0};
+};
+} // namespace chEngineSDK
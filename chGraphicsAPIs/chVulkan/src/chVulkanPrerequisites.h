@@ -23,7 +23,7 @@
 #if defined(CH_VULKAN_IMGUI)
 #define CH_VK_IMGUI IN_USE
 #else
-#define CH_VK_IMGUI IN_NOT_USE
+#define CH_VK_IMGUI NOT_IN_USE
 #endif // defined(CH_VULKAN_IMGUI)
 
 #if USING(CH_VK_IMGUI)
@@ -219,6 +219,12 @@ pipelineStageToVkPipelineStage(PipelineStageFlags stageFlags) {
   if (stageFlags & PipelineStage::AllCommands) {
     result |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
   }
+  if (stageFlags & PipelineStage::EarlyFragmentTests) {
+    result |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+  }
+  if (stageFlags & PipelineStage::LateFragmentTests) {
+    result |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+  }
 
   return (result == 0) ?
           static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT) :
@@ -238,7 +238,6 @@ NODISCARD SPtr<ITexture>
 VulkanSwapChain::getTexture(uint32 index) const {
   CH_ASSERT(index < m_imageCount);
   return chMakeShared<VulkanTexture>(m_device,
-                                     m_physicalDevice,
                                      m_images[index],
                                      m_colorFormat,
                                      m_width, m_height,
@@ -13,24 +13,24 @@
 
 #include "chVulkanPrerequisites.h"
 #include "chITexture.h"
+#include "chVulkanMemoryAllocator.h"
+#include "chVulkanUploadManager.h"
 
 namespace chEngineSDK {
 class VulkanTexture : public ITexture {
  public:
   VulkanTexture(VkDevice device,
-                VkPhysicalDevice physicalDevice,
+                VulkanMemoryAllocator& allocator,
+                VulkanUploadManager& uploadManager,
                 const TextureCreateInfo& createInfo);
 
   VulkanTexture(VkDevice device,
-                VkPhysicalDevice physicalDevice,
                 VkImage image,
                 VkFormat format,
                 uint32 width, uint32 height,
                 uint32 depth, uint32 mipLevels,
                 uint32 arrayLayers = 1)
   : m_device(device),
-    m_physicalDevice(physicalDevice),
-    m_memory(VK_NULL_HANDLE),
     m_image(image),
     m_width(width),
     m_height(height),
@@ -67,6 +67,9 @@ class VulkanTexture : public ITexture {
   NODISCARD SPtr<ITextureView>
   createView(const TextureViewCreateInfo& createInfo = {}) override;
 
+  /**
+   * Queue a copy into the first mip, it reaches the GPU with the next upload batch.
+   */
   void
   uploadData(const void* data, size_t size) override;
 
@@ -75,8 +78,9 @@ class VulkanTexture : public ITexture {
 
  private:
   VkDevice m_device = VK_NULL_HANDLE;
-  VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
-  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  VulkanMemoryAllocator* m_allocator = nullptr;
+  VulkanUploadManager* m_uploadManager = nullptr;
+  VulkanAllocation m_allocation;
   VkImage m_image = VK_NULL_HANDLE;
 
   uint32 m_width = 0;
@@ -0,0 +1,607 @@
+/************************************************************************/
+/**
+ * @file chVulkanUploadManager.cpp
+ * @author AccelMR
+ * @date 2025/08/05
+ * @brief
+ * Batched staging uploads for device local buffers and images.
+ */
+/************************************************************************/
+#include "chVulkanUploadManager.h"
+
+namespace chEngineSDK {
+namespace {
+// Covers the texel size of every uncompressed format and the 4 bytes copies need
+constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+constexpr VkAccessFlags BUFFER_READ_ACCESS = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                                             VK_ACCESS_INDEX_READ_BIT |
+                                             VK_ACCESS_UNIFORM_READ_BIT |
+                                             VK_ACCESS_SHADER_READ_BIT;
+
+constexpr VkPipelineStageFlags CONSUMER_STAGES = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                                 VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+// Every stage a buffer written by the uploads can be read from
+constexpr VkPipelineStageFlags BUFFER_READER_STAGES = CONSUMER_STAGES |
+                                                      VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                                      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+FORCEINLINE VkDeviceSize
+alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VkCommandPool
+createCommandPool(VkDevice device, uint32 queueFamilyIndex) {
+  VkCommandPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                   VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+  VkCommandPool commandPool = VK_NULL_HANDLE;
+  VK_CHECK(vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool));
+  return commandPool;
+}
+
+VkCommandBuffer
+allocateCommandBuffer(VkDevice device, VkCommandPool commandPool) {
+  VkCommandBufferAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocInfo.commandPool = commandPool;
+  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.commandBufferCount = 1;
+
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  VK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer));
+  return commandBuffer;
+}
+
+void
+beginCommandBuffer(VkCommandBuffer commandBuffer) {
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+}
+} // namespace
+
+/*
+*/
+VulkanUploadManager::VulkanUploadManager(VkDevice device,
+                                         VulkanMemoryAllocator& allocator,
+                                         uint32 graphicsQueueFamilyIndex,
+                                         uint32 transferQueueFamilyIndex,
+                                         VkDeviceSize stagingSize)
+  : m_device(device),
+    m_allocator(&allocator),
+    m_graphicsQueueFamilyIndex(graphicsQueueFamilyIndex),
+    m_transferQueueFamilyIndex(transferQueueFamilyIndex),
+    m_stagingSize(stagingSize) {
+  vkGetDeviceQueue(m_device, m_graphicsQueueFamilyIndex, 0, &m_graphicsQueue);
+  vkGetDeviceQueue(m_device, m_transferQueueFamilyIndex, 0, &m_transferQueue);
+
+  m_transferCommandPool = createCommandPool(m_device, m_transferQueueFamilyIndex);
+  if (hasDedicatedTransferQueue()) {
+    m_acquireCommandPool = createCommandPool(m_device, m_graphicsQueueFamilyIndex);
+  }
+
+  for (Batch& batch : m_batches) {
+    batch.transferCommands = allocateCommandBuffer(m_device, m_transferCommandPool);
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VK_CHECK(vkCreateFence(m_device, &fenceInfo, nullptr, &batch.fence));
+
+    if (hasDedicatedTransferQueue()) {
+      batch.acquireCommands = allocateCommandBuffer(m_device, m_acquireCommandPool);
+      batch.graphicsReleaseCommands = allocateCommandBuffer(m_device, m_acquireCommandPool);
+
+      VkSemaphoreCreateInfo semaphoreInfo{};
+      semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+      VK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &batch.transferDone));
+      VK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &batch.graphicsReleased));
+    }
+  }
+
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = m_stagingSize;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VK_CHECK(vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_staging.buffer));
+  m_staging.allocation = m_allocator->allocateForBuffer(m_staging.buffer,
+                                                        MemoryUsage::CpuOnly);
+}
+
+/*
+*/
+VulkanUploadManager::~VulkanUploadManager() {
+  waitIdle();
+
+  for (Batch& batch : m_batches) {
+    vkDestroyFence(m_device, batch.fence, nullptr);
+    if (batch.transferDone != VK_NULL_HANDLE) {
+      vkDestroySemaphore(m_device, batch.transferDone, nullptr);
+      vkDestroySemaphore(m_device, batch.graphicsReleased, nullptr);
+    }
+  }
+
+  // Destroying the pools frees their command buffers
+  vkDestroyCommandPool(m_device, m_transferCommandPool, nullptr);
+  if (m_acquireCommandPool != VK_NULL_HANDLE) {
+    vkDestroyCommandPool(m_device, m_acquireCommandPool, nullptr);
+  }
+
+  vkDestroyBuffer(m_device, m_staging.buffer, nullptr);
+  m_allocator->free(m_staging.allocation);
+}
+
+/*
+*/
+uint64
+VulkanUploadManager::uploadBuffer(VkBuffer buffer,
+                                  VkDeviceSize offset,
+                                  const void* data,
+                                  VkDeviceSize size,
+                                  bool inUse) {
+  CH_ASSERT(buffer != VK_NULL_HANDLE);
+  CH_ASSERT(data != nullptr && size > 0);
+
+  const auto [source, sourceOffset] = stage(data, size);
+  Batch& batch = getRecordingBatch();
+
+  VkBufferMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  barrier.buffer = buffer;
+  barrier.offset = offset;
+  barrier.size = size;
+
+  // Write after read, the copy can't start until earlier graphics work stopped reading
+  if (inUse) {
+    VkPipelineStageFlags srcStages = BUFFER_READER_STAGES;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    if (hasDedicatedTransferQueue()) {
+      // Graphics releases the range after its readers, the transfer submit waits on that
+      // release, this barrier is the matching acquire
+      barrier.srcQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+      barrier.dstQueueFamilyIndex = m_transferQueueFamilyIndex;
+      barrier.dstAccessMask = 0;
+      batch.graphicsBufferReleases.push_back(barrier);
+
+      srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+
+    vkCmdPipelineBarrier(batch.transferCommands,
+                         srcStages,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0, nullptr,
+                         1, &barrier,
+                         0, nullptr);
+  }
+
+  const VkBufferCopy region{.srcOffset = sourceOffset, .dstOffset = offset, .size = size};
+  vkCmdCopyBuffer(batch.transferCommands, source, buffer, 1, &region);
+
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  if (hasDedicatedTransferQueue()) {
+    barrier.srcQueueFamilyIndex = m_transferQueueFamilyIndex;
+    barrier.dstQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+    barrier.dstAccessMask = 0;
+    batch.bufferReleases.push_back(barrier);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = BUFFER_READ_ACCESS;
+    batch.bufferAcquires.push_back(barrier);
+  }
+  else {
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstAccessMask = BUFFER_READ_ACCESS;
+    batch.bufferReleases.push_back(barrier);
+  }
+
+  ++batch.copyCount;
+  ++m_stats.copyCount;
+  m_stats.uploadedBytes += size;
+  return batch.serial;
+}
+
+/*
+*/
+void
+VulkanUploadManager::uploadImage(VkImage image,
+                                 const void* data,
+                                 VkDeviceSize size,
+                                 const VkExtent3D& extent,
+                                 uint32 mipLevels,
+                                 uint32 arrayLayers) {
+  CH_ASSERT(image != VK_NULL_HANDLE);
+  CH_ASSERT(data != nullptr && size > 0);
+
+  const auto [source, sourceOffset] = stage(data, size);
+  Batch& batch = getRecordingBatch();
+
+  VkImageMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = 0;
+  barrier.subresourceRange.levelCount = mipLevels;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount = arrayLayers;
+  barrier.srcAccessMask = 0;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(batch.transferCommands,
+                       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       0,
+                       0, nullptr,
+                       0, nullptr,
+                       1, &barrier);
+
+  VkBufferImageCopy region{
+    .bufferOffset = sourceOffset,
+    .bufferRowLength = 0,
+    .bufferImageHeight = 0,
+    .imageSubresource = {
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .mipLevel = 0,
+      .baseArrayLayer = 0,
+      .layerCount = 1,
+    },
+    .imageOffset = {0, 0, 0},
+    .imageExtent = extent,
+  };
+
+  vkCmdCopyBufferToImage(batch.transferCommands,
+                         source,
+                         image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                         1,
+                         &region);
+
+  barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  if (hasDedicatedTransferQueue()) {
+    // Same layouts on both sides, the transition happens once between release and acquire
+    barrier.srcQueueFamilyIndex = m_transferQueueFamilyIndex;
+    barrier.dstQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+    barrier.dstAccessMask = 0;
+    batch.imageReleases.push_back(barrier);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    batch.imageAcquires.push_back(barrier);
+  }
+  else {
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    batch.imageReleases.push_back(barrier);
+  }
+
+  ++batch.copyCount;
+  ++m_stats.copyCount;
+  m_stats.uploadedBytes += size;
+}
+
+/*
+*/
+void
+VulkanUploadManager::submit() {
+  if (!m_isRecording) {
+    return;
+  }
+
+  Batch& batch = m_batches[m_recordingBatch];
+  recordBarriers(batch);
+  VK_CHECK(vkEndCommandBuffer(batch.transferCommands));
+
+  if (hasDedicatedTransferQueue()) {
+    VK_CHECK(vkEndCommandBuffer(batch.acquireCommands));
+
+    const bool releasesFromGraphics = !batch.graphicsBufferReleases.empty();
+    if (releasesFromGraphics) {
+      submitGraphicsReleases(batch);
+    }
+
+    const VkPipelineStageFlags releaseWaitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    const VkSubmitInfo transferSubmit{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                      .pNext = nullptr,
+                                      .waitSemaphoreCount = releasesFromGraphics ? 1u : 0u,
+                                      .pWaitSemaphores = &batch.graphicsReleased,
+                                      .pWaitDstStageMask = &releaseWaitStage,
+                                      .commandBufferCount = 1,
+                                      .pCommandBuffers = &batch.transferCommands,
+                                      .signalSemaphoreCount = 1,
+                                      .pSignalSemaphores = &batch.transferDone};
+    VK_CHECK(vkQueueSubmit(m_transferQueue, 1, &transferSubmit, VK_NULL_HANDLE));
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    const VkSubmitInfo acquireSubmit{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                     .pNext = nullptr,
+                                     .waitSemaphoreCount = 1,
+                                     .pWaitSemaphores = &batch.transferDone,
+                                     .pWaitDstStageMask = &waitStage,
+                                     .commandBufferCount = 1,
+                                     .pCommandBuffers = &batch.acquireCommands,
+                                     .signalSemaphoreCount = 0,
+                                     .pSignalSemaphores = nullptr};
+    VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &acquireSubmit, batch.fence));
+  }
+  else {
+    const VkSubmitInfo submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                  .pNext = nullptr,
+                                  .waitSemaphoreCount = 0,
+                                  .pWaitSemaphores = nullptr,
+                                  .pWaitDstStageMask = nullptr,
+                                  .commandBufferCount = 1,
+                                  .pCommandBuffers = &batch.transferCommands,
+                                  .signalSemaphoreCount = 0,
+                                  .pSignalSemaphores = nullptr};
+    VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, batch.fence));
+  }
+
+  batch.stagingEnd = m_stagingHead;
+  m_submittedSerial = batch.serial;
+  m_recordingBatch = (m_recordingBatch + 1) % MAX_BATCHES;
+  ++m_inFlightCount;
+  m_isRecording = false;
+  ++m_stats.submitCount;
+}
+
+/*
+*/
+void
+VulkanUploadManager::releaseBuffer(VkBuffer buffer,
+                                   VulkanAllocation& allocation,
+                                   uint64 serial) {
+  retireCompletedBatches();
+
+  // Serials are unique and a batch keeps its own until it is recorded again, which only
+  // happens after it retired
+  if (serial > m_completedSerial) {
+    for (Batch& batch : m_batches) {
+      if (batch.serial == serial) {
+        batch.pendingReleases.push_back({buffer, allocation});
+        allocation = VulkanAllocation{};
+        return;
+      }
+    }
+  }
+
+  vkDestroyBuffer(m_device, buffer, nullptr);
+  m_allocator->free(allocation);
+}
+
+/*
+*/
+void
+VulkanUploadManager::waitIdle() {
+  submit();
+  while (retireOldestBatch(true)) {}
+}
+
+/*
+*/
+VulkanUploadManager::Batch&
+VulkanUploadManager::getRecordingBatch() {
+  Batch& batch = m_batches[m_recordingBatch];
+  if (m_isRecording) {
+    return batch;
+  }
+
+  // Every batch is on the GPU, the oldest one is the one about to be recorded again
+  if (m_inFlightCount == MAX_BATCHES) {
+    retireOldestBatch(true);
+  }
+
+  beginCommandBuffer(batch.transferCommands);
+  if (hasDedicatedTransferQueue()) {
+    beginCommandBuffer(batch.acquireCommands);
+  }
+  batch.serial = m_submittedSerial + 1;
+  m_isRecording = true;
+  return batch;
+}
+
+/*
+*/
+Pair<VkBuffer, VkDeviceSize>
+VulkanUploadManager::stage(const void* data, VkDeviceSize size) {
+  VkDeviceSize offset = 0;
+  bool staged = tryAllocateStaging(size, offset);
+
+  if (!staged && size <= m_stagingSize) {
+    retireCompletedBatches();
+    staged = tryAllocateStaging(size, offset);
+
+    // The ring is full of copies waiting to be submitted or still on the GPU
+    if (!staged) {
+      submit();
+      while (!staged && retireOldestBatch(true)) {
+        staged = tryAllocateStaging(size, offset);
+      }
+    }
+  }
+
+  if (staged) {
+    memcpy(m_staging.allocation.mappedData + offset, data, size);
+    m_allocator->flush(m_staging.allocation, offset, size);
+    return {m_staging.buffer, offset};
+  }
+
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = size;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  StagingBuffer oversized;
+  VK_CHECK(vkCreateBuffer(m_device, &bufferInfo, nullptr, &oversized.buffer));
+  oversized.allocation = m_allocator->allocateForBuffer(oversized.buffer,
+                                                        MemoryUsage::CpuOnly,
+                                                        VulkanAllocationStrategy::Linear);
+  memcpy(oversized.allocation.mappedData, data, size);
+  m_allocator->flush(oversized.allocation);
+
+  getRecordingBatch().pendingReleases.push_back(oversized);
+  return {oversized.buffer, 0};
+}
+
+/*
+ * Free space is [head, size) + [0, tail) while head >= tail and [head, tail) otherwise.
+ * Head never reaches tail from behind, so head == tail only happens on an empty ring.
+ */
+bool
+VulkanUploadManager::tryAllocateStaging(VkDeviceSize size, VkDeviceSize& offset) {
+  if (size > m_stagingSize) {
+    return false;
+  }
+
+  const bool recordingCopies = m_isRecording && m_batches[m_recordingBatch].copyCount > 0;
+  if (m_inFlightCount == 0 && !recordingCopies) {
+    m_stagingHead = 0;
+    m_stagingTail = 0;
+  }
+
+  // Every range starts aligned, whether it follows the head or wraps to the start
+  auto allocateFrom = [&](VkDeviceSize start, VkDeviceSize end) {
+    const VkDeviceSize alignedStart = alignUp(start, STAGING_ALIGNMENT);
+    if (alignedStart + size > end) {
+      return false;
+    }
+    offset = alignedStart;
+    m_stagingHead = alignedStart + size;
+    return true;
+  };
+
+  // Ranges behind the tail stop one byte short so head doesn't catch up with it
+  if (m_stagingHead >= m_stagingTail) {
+    return allocateFrom(m_stagingHead, m_stagingSize) ||
+           (m_stagingTail > 0 && allocateFrom(0, m_stagingTail - 1));
+  }
+  return allocateFrom(m_stagingHead, m_stagingTail - 1);
+}
+
+/*
+*/
+void
+VulkanUploadManager::recordBarriers(Batch& batch) {
+  // Without a transfer family the releases already make the data visible to the shaders
+  const VkPipelineStageFlags releaseDstStages = hasDedicatedTransferQueue()
+                                                    ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+                                                    : CONSUMER_STAGES;
+
+  if (!batch.bufferReleases.empty() || !batch.imageReleases.empty()) {
+    vkCmdPipelineBarrier(batch.transferCommands,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         releaseDstStages,
+                         0,
+                         0, nullptr,
+                         static_cast<uint32>(batch.bufferReleases.size()),
+                         batch.bufferReleases.data(),
+                         static_cast<uint32>(batch.imageReleases.size()),
+                         batch.imageReleases.data());
+  }
+
+  if (!batch.bufferAcquires.empty() || !batch.imageAcquires.empty()) {
+    vkCmdPipelineBarrier(batch.acquireCommands,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         CONSUMER_STAGES,
+                         0,
+                         0, nullptr,
+                         static_cast<uint32>(batch.bufferAcquires.size()),
+                         batch.bufferAcquires.data(),
+                         static_cast<uint32>(batch.imageAcquires.size()),
+                         batch.imageAcquires.data());
+  }
+
+  batch.bufferReleases.clear();
+  batch.imageReleases.clear();
+  batch.bufferAcquires.clear();
+  batch.imageAcquires.clear();
+}
+
+/*
+*/
+void
+VulkanUploadManager::submitGraphicsReleases(Batch& batch) {
+  beginCommandBuffer(batch.graphicsReleaseCommands);
+  vkCmdPipelineBarrier(batch.graphicsReleaseCommands,
+                       BUFFER_READER_STAGES,
+                       VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                       0,
+                       0, nullptr,
+                       static_cast<uint32>(batch.graphicsBufferReleases.size()),
+                       batch.graphicsBufferReleases.data(),
+                       0, nullptr);
+  VK_CHECK(vkEndCommandBuffer(batch.graphicsReleaseCommands));
+  batch.graphicsBufferReleases.clear();
+
+  // Graphics submits before this one are ordered ahead of the release barrier
+  const VkSubmitInfo releaseSubmit{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                   .pNext = nullptr,
+                                   .waitSemaphoreCount = 0,
+                                   .pWaitSemaphores = nullptr,
+                                   .pWaitDstStageMask = nullptr,
+                                   .commandBufferCount = 1,
+                                   .pCommandBuffers = &batch.graphicsReleaseCommands,
+                                   .signalSemaphoreCount = 1,
+                                   .pSignalSemaphores = &batch.graphicsReleased};
+  VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &releaseSubmit, VK_NULL_HANDLE));
+}
+
+/*
+*/
+bool
+VulkanUploadManager::retireOldestBatch(bool wait) {
+  if (m_inFlightCount == 0) {
+    return false;
+  }
+
+  Batch& batch = m_batches[(m_recordingBatch + MAX_BATCHES - m_inFlightCount) % MAX_BATCHES];
+  if (wait) {
+    VK_CHECK(vkWaitForFences(m_device, 1, &batch.fence, VK_TRUE, UINT64_MAX));
+  }
+  else if (vkGetFenceStatus(m_device, batch.fence) != VK_SUCCESS) {
+    return false;
+  }
+  VK_CHECK(vkResetFences(m_device, 1, &batch.fence));
+
+  for (StagingBuffer& released : batch.pendingReleases) {
+    vkDestroyBuffer(m_device, released.buffer, nullptr);
+    m_allocator->free(released.allocation);
+  }
+  batch.pendingReleases.clear();
+  batch.copyCount = 0;
+
+  m_stagingTail = batch.stagingEnd;
+  m_completedSerial = batch.serial;
+  --m_inFlightCount;
+  return true;
+}
+
+/*
+*/
+void
+VulkanUploadManager::retireCompletedBatches() {
+  while (retireOldestBatch(false)) {}
+}
+} // namespace chEngineSDK
@@ -0,0 +1,244 @@
+/************************************************************************/
+/**
+ * @file chVulkanUploadManager.h
+ * @author AccelMR
+ * @date 2025/08/05
+ * @brief
+ * Batched staging uploads for device local buffers and images.
+ */
+/************************************************************************/
+#pragma once
+
+#include "chVulkanPrerequisites.h"
+
+#include "chVulkanMemoryAllocator.h"
+
+namespace chEngineSDK {
+struct VulkanUploadStats
+{
+  uint32 submitCount = 0;
+  uint32 copyCount = 0;
+  VkDeviceSize uploadedBytes = 0;
+};
+
+/*
+ * Description:
+ *     Copies CPU data into device local resources through one persistently mapped staging
+ *     ring. Copies are recorded into the current batch and go to the GPU together when the
+ *     batch is submitted, so loading many resources costs a handful of submits instead of
+ *     one blocking submit per resource.
+ *
+ *     With a dedicated transfer queue family the copies run there and the resources are
+ *     handed over to the graphics family with release / acquire barriers, the acquire side
+ *     is a small command buffer on the graphics queue that waits on the transfer submit.
+ *     Without one everything is recorded on the graphics queue.
+ *
+ *     Buffers updated while graphics work may still read them are written after those
+ *     reads: on the graphics queue a barrier after the shader and vertex input stages
+ *     comes first, with a transfer queue the graphics family releases the range with a
+ *     submit of its own and the copy waits on it before acquiring it.
+ *
+ *     Staging memory of a batch is reused once its fence signals. Data bigger than the
+ *     ring gets a staging buffer of its own that lives until the batch completes.
+ *
+ *     Every batch gets a serial, increasing by one per batch. A copy reports the serial of
+ *     the batch it went into, comparing it with getSubmittedSerial() tells whether graphics
+ *     work may have seen the copy yet. A buffer destroyed while its last copy is pending is
+ *     handed to releaseBuffer and destroyed when that batch retires, nothing waits for it.
+ *
+ *     Not thread safe, it submits to the graphics queue and has to be used from the thread
+ *     that owns it.
+ *
+ * Sample usage:
+ *  uploads.uploadBuffer(vertexBuffer, 0, vertices.data(), vertexBytes, false);
+ *  uploads.uploadImage(image, pixels, pixelBytes, {width, height, 1}, 1, 1);
+ *  ...
+ *  uploads.submit(); // VulkanCommandQueue does this before every graphics submit
+ */
+class VulkanUploadManager
+{
+ public:
+  static constexpr VkDeviceSize DEFAULT_STAGING_SIZE = 32ull * 1024 * 1024;
+
+  /**
+   * Batches that can wait on the GPU before recording has to block
+   */
+  static constexpr uint32 MAX_BATCHES = 4;
+
+  VulkanUploadManager(VkDevice device,
+                      VulkanMemoryAllocator& allocator,
+                      uint32 graphicsQueueFamilyIndex,
+                      uint32 transferQueueFamilyIndex,
+                      VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+
+  ~VulkanUploadManager();
+
+  VulkanUploadManager(const VulkanUploadManager&) = delete;
+  VulkanUploadManager&
+  operator=(const VulkanUploadManager&) = delete;
+
+  /**
+   * Record a copy into a buffer created with transfer destination usage. The data is
+   * copied to staging memory before returning.
+   *
+   * @param inUse Graphics work submitted before may read the buffer, the copy waits on it
+   * @return Serial of the batch the copy was recorded into
+   */
+  uint64
+  uploadBuffer(VkBuffer buffer,
+               VkDeviceSize offset,
+               const void* data,
+               VkDeviceSize size,
+               bool inUse);
+
+  /**
+   * Record a copy into the first mip and layer of an optimal tiling color image. Every
+   * subresource ends in shader read only layout.
+   */
+  void
+  uploadImage(VkImage image,
+              const void* data,
+              VkDeviceSize size,
+              const VkExtent3D& extent,
+              uint32 mipLevels,
+              uint32 arrayLayers);
+
+  /**
+   * Send the recorded copies to the GPU, does nothing if there are none. Graphics work
+   * submitted afterwards sees the uploaded data.
+   */
+  void
+  submit();
+
+  /**
+   * Destroy a buffer and free its memory once the batch with the given serial completed,
+   * right away if it already did. Never blocks.
+   *
+   * @param serial Batch of the last copy into the buffer
+   * @param allocation Reset, the manager owns the memory from now on
+   */
+  void
+  releaseBuffer(VkBuffer buffer, VulkanAllocation& allocation, uint64 serial);
+
+  /**
+   * Submit and block until every batch completed
+   */
+  void
+  waitIdle();
+
+  /**
+   * Serial of the last batch sent to the GPU, zero before the first one
+   */
+  NODISCARD FORCEINLINE uint64
+  getSubmittedSerial() const {
+    return m_submittedSerial;
+  }
+
+  NODISCARD FORCEINLINE bool
+  hasDedicatedTransferQueue() const {
+    return m_transferQueueFamilyIndex != m_graphicsQueueFamilyIndex;
+  }
+
+  NODISCARD FORCEINLINE const VulkanUploadStats&
+  getStats() const {
+    return m_stats;
+  }
+
+ private:
+  struct StagingBuffer
+  {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VulkanAllocation allocation;
+  };
+
+  struct Batch
+  {
+    VkCommandBuffer transferCommands = VK_NULL_HANDLE;
+    VkCommandBuffer acquireCommands = VK_NULL_HANDLE;
+    VkCommandBuffer graphicsReleaseCommands = VK_NULL_HANDLE;
+    VkSemaphore transferDone = VK_NULL_HANDLE;
+    VkSemaphore graphicsReleased = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+
+    /**
+     * Ring position after the last staging range of the batch
+     */
+    VkDeviceSize stagingEnd = 0;
+    /**
+     * Oversized staging and buffers released while a copy into them was in the batch,
+     * destroyed when the batch retires
+     */
+    Vector<StagingBuffer> pendingReleases;
+
+    // Recorded on the command buffers when the batch is submitted
+    Vector<VkBufferMemoryBarrier> graphicsBufferReleases;
+    Vector<VkBufferMemoryBarrier> bufferReleases;
+    Vector<VkImageMemoryBarrier> imageReleases;
+    Vector<VkBufferMemoryBarrier> bufferAcquires;
+    Vector<VkImageMemoryBarrier> imageAcquires;
+
+    uint32 copyCount = 0;
+    uint64 serial = 0;
+  };
+
+  NODISCARD Batch&
+  getRecordingBatch();
+
+  /**
+   * Copy data to staging memory, a ring range if it fits, an oversized buffer otherwise
+   *
+   * @return Buffer and offset to copy from
+   */
+  NODISCARD Pair<VkBuffer, VkDeviceSize>
+  stage(const void* data, VkDeviceSize size);
+
+  NODISCARD bool
+  tryAllocateStaging(VkDeviceSize size, VkDeviceSize& offset);
+
+  void
+  recordBarriers(Batch& batch);
+
+  /**
+   * Hand the buffers graphics was using to the transfer family, submitted before the
+   *   copies of the batch
+   */
+  void
+  submitGraphicsReleases(Batch& batch);
+
+  /**
+   * Release the resources of the oldest batch in flight
+   *
+   * @param wait Block until it completes instead of returning false
+   * @return True if a batch was retired
+   */
+  bool
+  retireOldestBatch(bool wait);
+
+  void
+  retireCompletedBatches();
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VulkanMemoryAllocator* m_allocator = nullptr;
+
+  uint32 m_graphicsQueueFamilyIndex = 0;
+  uint32 m_transferQueueFamilyIndex = 0;
+  VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+  VkQueue m_transferQueue = VK_NULL_HANDLE;
+  VkCommandPool m_transferCommandPool = VK_NULL_HANDLE;
+  VkCommandPool m_acquireCommandPool = VK_NULL_HANDLE;
+
+  StagingBuffer m_staging;
+  VkDeviceSize m_stagingSize = 0;
+  VkDeviceSize m_stagingHead = 0;
+  VkDeviceSize m_stagingTail = 0;
+
+  Array<Batch, MAX_BATCHES> m_batches;
+  uint32 m_recordingBatch = 0;
+  uint32 m_inFlightCount = 0;
+  bool m_isRecording = false;
+  uint64 m_submittedSerial = 0;
+  uint64 m_completedSerial = 0;
+
+  VulkanUploadStats m_stats;
+};
+} // namespace chEngineSDK
@@ -0,0 +1,666 @@
+/************************************************************************/
+/**
+ * @file chBVH.h
+ * @author AccelMR
+ * @date 2025/07/22
+ * @brief Bounding volume hierarchy over axis aligned boxes.
+ *
+ * Built with binned SAH, large subtrees are built in parallel. The payload is a template
+ * parameter so the same structure can index model nodes, meshes or game objects.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chBoundsUtils.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Bounding volume hierarchy for items with an AABox.
+ *
+ *     Nodes live in a single array, the two children of an internal node are adjacent and
+ *     always stored after their parent, so refit() is a single reverse sweep.
+ *     Items are stored in leaf order, query callbacks get a reference to them.
+ *
+ *     Query callbacks may return void or bool, returning false stops the query.
+ *
+ * Sample usage:
+ *  BVH<uint32> bvh;
+ *  bvh.build(boxes, ids);
+ *  bvh.queryAABox(area, [](const uint32& id) { ... });
+ *  bvh.refit(movedBoxes);
+ */
+template<typename T>
+class BVH
+{
+ public:
+  struct BuildSettings
+  {
+    /**
+     * Leaves are only split above this size, or when SAH says it is cheaper.
+     */
+    uint32 maxLeafSize = 4;
+
+    /**
+     * Bins per axis used to evaluate SAH splits, clamped to [2, MAX_BINS].
+     */
+    uint32 binCount = 16;
+
+    /**
+     * Subtrees with at least this amount of items are built on their own thread.
+     */
+    SIZE_T parallelThreshold = 8192;
+
+    /**
+     * Upper limit of threads used for building, 0 uses the hardware concurrency.
+     */
+    uint32 maxThreads = 0;
+  };
+
+  struct Node
+  {
+    NODISCARD FORCEINLINE bool
+    isLeaf() const {
+      return itemCount > 0;
+    }
+
+    AABox bounds;
+
+    /**
+     * Internal nodes: index of the left child, the right one is next to it.
+     * Leaves: index of the first item.
+     */
+    uint32 firstChildOrItem;
+
+    /**
+     * Amount of items in a leaf, 0 for internal nodes.
+     */
+    uint32 itemCount;
+  };
+
+  BVH() = default;
+  ~BVH() = default;
+
+  /**
+   *   Builds the hierarchy. bounds[i] is the box of items[i].
+   **/
+  void
+  build(const AABox* bounds,
+        const T* items,
+        SIZE_T count,
+        const BuildSettings& settings = BuildSettings());
+
+  void
+  build(const Vector<AABox>& bounds,
+        const Vector<T>& items,
+        const BuildSettings& settings = BuildSettings()) {
+    CH_ASSERT(bounds.size() == items.size());
+    build(bounds.data(), items.data(), items.size(), settings);
+  }
+
+  /**
+   *   Updates the item boxes and recomputes every node without changing the topology.
+   *   Bounds are given in the same order used for build(). Cheap enough to run every
+   *   frame for moving objects, rebuild when the tree quality degrades.
+   **/
+  void
+  refit(const AABox* bounds);
+
+  void
+  refit(const Vector<AABox>& bounds) {
+    CH_ASSERT(bounds.size() == m_items.size());
+    refit(bounds.data());
+  }
+
+  void
+  clear();
+
+  /**
+   *   Calls fn(item) for every item whose box overlaps the given one.
+   **/
+  template<class Fn>
+  void
+  queryAABox(const AABox& box, Fn&& fn) const;
+
+  /**
+   *   Calls fn(item) for every item whose box is at least partially inside all planes.
+   *   A point p is inside a plane when plane.planeDot(p) >= 0, same as Camera frustums.
+   **/
+  template<class Fn>
+  void
+  queryFrustum(const Plane* planes, SIZE_T planeCount, Fn&& fn) const;
+
+  /**
+   *   Calls fn(item, entryDistance) for every item whose box is hit by the ray before
+   *   maxDistance. Items are not sorted.
+   **/
+  template<class Fn>
+  void
+  queryRay(const Vector3& origin,
+           const Vector3& direction,
+           float maxDistance,
+           Fn&& fn) const;
+
+  /**
+   *   Finds the closest item hit by the ray. hitFn(item, distance) performs the exact
+   *   test and must return true and write the distance when the item is hit closer than
+   *   the given value. Nodes are visited front to back so far subtrees are culled early.
+   *
+   * @param distance
+   *   In: max distance. Out: distance to the closest hit.
+   **/
+  template<class HitFn>
+  Optional<T>
+  raycast(const Vector3& origin,
+          const Vector3& direction,
+          float& distance,
+          HitFn&& hitFn) const;
+
+  NODISCARD FORCEINLINE bool
+  empty() const {
+    return m_nodes.empty();
+  }
+
+  NODISCARD FORCEINLINE SIZE_T
+  getItemCount() const {
+    return m_items.size();
+  }
+
+  NODISCARD FORCEINLINE const Vector<Node>&
+  getNodes() const {
+    return m_nodes;
+  }
+
+  NODISCARD FORCEINLINE const Vector<T>&
+  getItems() const {
+    return m_items;
+  }
+
+  /**
+   *   Bounds of the whole hierarchy, only valid when not empty.
+   **/
+  NODISCARD FORCEINLINE const AABox&
+  getBounds() const {
+    CH_ASSERT(!empty());
+    return m_nodes[0].bounds;
+  }
+
+ public:
+  static constexpr uint32 MAX_BINS = 32;
+  static constexpr uint32 MAX_DEPTH = 64;
+
+ private:
+  struct BuildContext
+  {
+    const AABox* bounds;
+    Vector<Vector3> centroids;
+    Vector<uint32> order;
+    Atomic<uint32> nodeCount;
+    uint32 maxLeafSize;
+    uint32 binCount;
+    SIZE_T parallelThreshold;
+    uint32 maxParallelDepth;
+  };
+
+  void
+  buildNode(BuildContext& context, uint32 nodeIndex, uint32 first, uint32 count, uint32 depth);
+
+  Vector<Node> m_nodes;
+
+  /**
+   *  Items and their boxes in leaf order.
+   */
+  Vector<T> m_items;
+  Vector<AABox> m_itemBounds;
+
+  /**
+   *  Build input index to position in m_items, used by refit.
+   */
+  Vector<uint32> m_inputToItem;
+};
+
+/************************************************************************/
+/*
+ * Implementation
+ */
+/************************************************************************/
+
+/*
+*/
+template<typename T>
+void
+BVH<T>::clear() {
+  m_nodes.clear();
+  m_items.clear();
+  m_itemBounds.clear();
+  m_inputToItem.clear();
+}
+
+/*
+*/
+template<typename T>
+void
+BVH<T>::build(const AABox* bounds,
+              const T* items,
+              SIZE_T count,
+              const BuildSettings& settings) {
+  clear();
+  if (count == 0) {
+    return;
+  }
+  CH_ASSERT(count < std::numeric_limits<uint32>::max() / 2);
+
+  BuildContext context;
+  context.bounds = bounds;
+  context.centroids.resize(count);
+  context.order.resize(count);
+  context.nodeCount = 1;
+  context.maxLeafSize = Math::max(settings.maxLeafSize, 1u);
+  context.binCount = Math::clamp(settings.binCount, 2u, MAX_BINS);
+  context.parallelThreshold = Math::max(settings.parallelThreshold, static_cast<SIZE_T>(2));
+
+  const uint32 threads = settings.maxThreads != 0
+                             ? settings.maxThreads
+                             : Math::max(std::thread::hardware_concurrency(), 1u);
+  context.maxParallelDepth = 0;
+  while ((1u << context.maxParallelDepth) < threads) {
+    ++context.maxParallelDepth;
+  }
+
+  for (SIZE_T i = 0; i < count; ++i) {
+    context.centroids[i] = bounds[i].getCenter();
+    context.order[i] = static_cast<uint32>(i);
+  }
+
+  m_nodes.resize(count * 2 - 1);
+  buildNode(context, 0, 0, static_cast<uint32>(count), 0);
+  m_nodes.resize(context.nodeCount.load());
+
+  m_items.resize(count);
+  m_itemBounds.resize(count);
+  m_inputToItem.resize(count);
+  for (SIZE_T slot = 0; slot < count; ++slot) {
+    const uint32 input = context.order[slot];
+    m_items[slot] = items[input];
+    m_itemBounds[slot] = bounds[input];
+    m_inputToItem[input] = static_cast<uint32>(slot);
+  }
+}
+
+/*
+*/
+template<typename T>
+void
+BVH<T>::buildNode(BuildContext& context,
+                  uint32 nodeIndex,
+                  uint32 first,
+                  uint32 count,
+                  uint32 depth) {
+  Node& node = m_nodes[nodeIndex];
+
+  AABox nodeBounds = BoundsUtils::emptyBox();
+  AABox centroidBounds = BoundsUtils::emptyBox();
+  for (uint32 i = first; i < first + count; ++i) {
+    const uint32 input = context.order[i];
+    BoundsUtils::grow(nodeBounds, context.bounds[input]);
+    centroidBounds += context.centroids[input];
+  }
+  node.bounds = nodeBounds;
+
+  auto makeLeaf = [&]() {
+    node.firstChildOrItem = first;
+    node.itemCount = count;
+  };
+
+  if (count == 1) {
+    makeLeaf();
+    return;
+  }
+
+  // Binned SAH over the centroid bounds.
+  struct Bin
+  {
+    AABox bounds;
+    uint32 count;
+  };
+
+  const uint32 binCount = context.binCount;
+  float bestCost = std::numeric_limits<float>::max();
+  int32 bestAxis = -1;
+  uint32 bestSplit = 0;
+
+  // Past half the depth budget only median splits are used, keeping traversal stacks bounded.
+  const int32 axisCount = depth < MAX_DEPTH / 2 ? 3 : 0;
+  for (int32 axis = 0; axis < axisCount; ++axis) {
+    const float axisMin = (&centroidBounds.minPoint.x)[axis];
+    const float axisMax = (&centroidBounds.maxPoint.x)[axis];
+    if (axisMax - axisMin <= Math::SMALL_NUMBER) {
+      continue;
+    }
+
+    Bin bins[MAX_BINS];
+    for (uint32 b = 0; b < binCount; ++b) {
+      bins[b].bounds = BoundsUtils::emptyBox();
+      bins[b].count = 0;
+    }
+
+    const float scale = static_cast<float>(binCount) / (axisMax - axisMin);
+    for (uint32 i = first; i < first + count; ++i) {
+      const uint32 input = context.order[i];
+      const float centroid = (&context.centroids[input].x)[axis];
+      const uint32 b = Math::min(static_cast<uint32>((centroid - axisMin) * scale),
+                                 binCount - 1);
+      BoundsUtils::grow(bins[b].bounds, context.bounds[input]);
+      ++bins[b].count;
+    }
+
+    // Sweep from the right storing the cost of every right side, then from the left.
+    float rightCost[MAX_BINS];
+    AABox accumulated = BoundsUtils::emptyBox();
+    uint32 accumulatedCount = 0;
+    for (uint32 b = binCount - 1; b > 0; --b) {
+      BoundsUtils::grow(accumulated, bins[b].bounds);
+      accumulatedCount += bins[b].count;
+      rightCost[b] =
+          accumulatedCount > 0 ? BoundsUtils::halfArea(accumulated) * accumulatedCount : 0.0f;
+    }
+
+    accumulated = BoundsUtils::emptyBox();
+    accumulatedCount = 0;
+    for (uint32 b = 0; b < binCount - 1; ++b) {
+      BoundsUtils::grow(accumulated, bins[b].bounds);
+      accumulatedCount += bins[b].count;
+      if (accumulatedCount == 0 || accumulatedCount == count) {
+        continue;
+      }
+      const float cost =
+          BoundsUtils::halfArea(accumulated) * accumulatedCount + rightCost[b + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestSplit = b;
+      }
+    }
+  }
+
+  const float leafCost = static_cast<float>(count);
+  const float nodeArea = BoundsUtils::halfArea(nodeBounds);
+  const float splitCost = nodeArea > 0.0f ? 1.0f + bestCost / nodeArea : leafCost;
+
+  if (count <= context.maxLeafSize && (bestAxis < 0 || splitCost >= leafCost)) {
+    makeLeaf();
+    return;
+  }
+
+  uint32* begin = context.order.data() + first;
+  uint32* end = begin + count;
+  uint32* middle = begin + count / 2;
+
+  if (bestAxis >= 0) {
+    const float axisMin = (&centroidBounds.minPoint.x)[bestAxis];
+    const float axisMax = (&centroidBounds.maxPoint.x)[bestAxis];
+    const float scale = static_cast<float>(binCount) / (axisMax - axisMin);
+    middle = std::partition(begin, end, [&](uint32 input) {
+      const float centroid = (&context.centroids[input].x)[bestAxis];
+      const uint32 b = Math::min(static_cast<uint32>((centroid - axisMin) * scale),
+                                 binCount - 1);
+      return b <= bestSplit;
+    });
+  }
+
+  // Every centroid landed on the same side, fall back to a median split.
+  if (middle == begin || middle == end) {
+    middle = begin + count / 2;
+  }
+
+  const uint32 leftCount = static_cast<uint32>(middle - begin);
+  const uint32 leftIndex = context.nodeCount.fetch_add(2);
+  node.firstChildOrItem = leftIndex;
+  node.itemCount = 0;
+
+  if (count >= context.parallelThreshold && depth < context.maxParallelDepth) {
+    Thread leftThread([&, leftIndex, first, leftCount, depth]() {
+      buildNode(context, leftIndex, first, leftCount, depth + 1);
+    });
+    buildNode(context, leftIndex + 1, first + leftCount, count - leftCount, depth + 1);
+    leftThread.join();
+  }
+  else {
+    buildNode(context, leftIndex, first, leftCount, depth + 1);
+    buildNode(context, leftIndex + 1, first + leftCount, count - leftCount, depth + 1);
+  }
+}
+
+/*
+*/
+template<typename T>
+void
+BVH<T>::refit(const AABox* bounds) {
+  for (SIZE_T input = 0; input < m_inputToItem.size(); ++input) {
+    m_itemBounds[m_inputToItem[input]] = bounds[input];
+  }
+
+  for (SIZE_T i = m_nodes.size(); i > 0; --i) {
+    Node& node = m_nodes[i - 1];
+    if (node.isLeaf()) {
+      node.bounds = m_itemBounds[node.firstChildOrItem];
+      for (uint32 item = 1; item < node.itemCount; ++item) {
+        BoundsUtils::grow(node.bounds, m_itemBounds[node.firstChildOrItem + item]);
+      }
+    }
+    else {
+      node.bounds = m_nodes[node.firstChildOrItem].bounds;
+      BoundsUtils::grow(node.bounds, m_nodes[node.firstChildOrItem + 1].bounds);
+    }
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+BVH<T>::queryAABox(const AABox& box, Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  uint32 stack[MAX_DEPTH * 2];
+  uint32 stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const Node& node = m_nodes[stack[--stackSize]];
+    if (!BoundsUtils::overlaps(node.bounds, box)) {
+      continue;
+    }
+
+    if (node.isLeaf()) {
+      for (uint32 i = node.firstChildOrItem; i < node.firstChildOrItem + node.itemCount; ++i) {
+        if (BoundsUtils::overlaps(m_itemBounds[i], box) &&
+            !BoundsUtils::visit(fn, m_items[i])) {
+          return;
+        }
+      }
+      continue;
+    }
+
+    CH_ASSERT(stackSize + 2 <= MAX_DEPTH * 2);
+    stack[stackSize++] = node.firstChildOrItem + 1;
+    stack[stackSize++] = node.firstChildOrItem;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+BVH<T>::queryFrustum(const Plane* planes, SIZE_T planeCount, Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  // Bit 31 marks subtrees already known to be fully inside.
+  constexpr uint32 INSIDE_FLAG = 0x80000000u;
+  uint32 stack[MAX_DEPTH * 2];
+  uint32 stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const uint32 entry = stack[--stackSize];
+    const Node& node = m_nodes[entry & ~INSIDE_FLAG];
+    bool inside = (entry & INSIDE_FLAG) != 0;
+
+    if (!inside) {
+      const int32 classification =
+          BoundsUtils::classifyFrustum(node.bounds, planes, planeCount);
+      if (classification < 0) {
+        continue;
+      }
+      inside = classification > 0;
+    }
+
+    if (node.isLeaf()) {
+      for (uint32 i = node.firstChildOrItem; i < node.firstChildOrItem + node.itemCount; ++i) {
+        const bool visible =
+            inside || BoundsUtils::classifyFrustum(m_itemBounds[i], planes, planeCount) >= 0;
+        if (visible && !BoundsUtils::visit(fn, m_items[i])) {
+          return;
+        }
+      }
+      continue;
+    }
+
+    const uint32 flag = inside ? INSIDE_FLAG : 0;
+    CH_ASSERT(stackSize + 2 <= MAX_DEPTH * 2);
+    stack[stackSize++] = (node.firstChildOrItem + 1) | flag;
+    stack[stackSize++] = node.firstChildOrItem | flag;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+BVH<T>::queryRay(const Vector3& origin,
+                 const Vector3& direction,
+                 float maxDistance,
+                 Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  const Vector3 invDirection = BoundsUtils::inverseDirection(direction);
+  uint32 stack[MAX_DEPTH * 2];
+  uint32 stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const Node& node = m_nodes[stack[--stackSize]];
+    if (BoundsUtils::rayEntry(node.bounds, origin, invDirection, maxDistance) < 0.0f) {
+      continue;
+    }
+
+    if (node.isLeaf()) {
+      for (uint32 i = node.firstChildOrItem; i < node.firstChildOrItem + node.itemCount; ++i) {
+        const float entry =
+            BoundsUtils::rayEntry(m_itemBounds[i], origin, invDirection, maxDistance);
+        if (entry >= 0.0f && !BoundsUtils::visit(fn, m_items[i], entry)) {
+          return;
+        }
+      }
+      continue;
+    }
+
+    CH_ASSERT(stackSize + 2 <= MAX_DEPTH * 2);
+    stack[stackSize++] = node.firstChildOrItem + 1;
+    stack[stackSize++] = node.firstChildOrItem;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class HitFn>
+Optional<T>
+BVH<T>::raycast(const Vector3& origin,
+                const Vector3& direction,
+                float& distance,
+                HitFn&& hitFn) const {
+  Optional<T> closest;
+  if (empty()) {
+    return closest;
+  }
+
+  const Vector3 invDirection = BoundsUtils::inverseDirection(direction);
+  if (BoundsUtils::rayEntry(m_nodes[0].bounds, origin, invDirection, distance) < 0.0f) {
+    return closest;
+  }
+
+  struct StackEntry
+  {
+    uint32 node;
+    float entry;
+  };
+  StackEntry stack[MAX_DEPTH * 2];
+  uint32 stackSize = 0;
+  stack[stackSize++] = {0, 0.0f};
+
+  while (stackSize > 0) {
+    const StackEntry current = stack[--stackSize];
+    if (current.entry > distance) {
+      continue;
+    }
+
+    const Node& node = m_nodes[current.node];
+    if (node.isLeaf()) {
+      for (uint32 i = node.firstChildOrItem; i < node.firstChildOrItem + node.itemCount; ++i) {
+        if (BoundsUtils::rayEntry(m_itemBounds[i], origin, invDirection, distance) < 0.0f) {
+          continue;
+        }
+        float hitDistance = distance;
+        if (hitFn(m_items[i], hitDistance) && hitDistance <= distance) {
+          distance = hitDistance;
+          closest = m_items[i];
+        }
+      }
+      continue;
+    }
+
+    const uint32 left = node.firstChildOrItem;
+    const float leftEntry =
+        BoundsUtils::rayEntry(m_nodes[left].bounds, origin, invDirection, distance);
+    const float rightEntry =
+        BoundsUtils::rayEntry(m_nodes[left + 1].bounds, origin, invDirection, distance);
+
+    // Push the far child first so the near one is popped next.
+    CH_ASSERT(stackSize + 2 <= MAX_DEPTH * 2);
+    const bool leftFirst = leftEntry >= 0.0f && (rightEntry < 0.0f || leftEntry <= rightEntry);
+    if (leftFirst) {
+      if (rightEntry >= 0.0f) {
+        stack[stackSize++] = {left + 1, rightEntry};
+      }
+      stack[stackSize++] = {left, leftEntry};
+    }
+    else {
+      if (leftEntry >= 0.0f) {
+        stack[stackSize++] = {left, leftEntry};
+      }
+      if (rightEntry >= 0.0f) {
+        stack[stackSize++] = {left + 1, rightEntry};
+      }
+    }
+  }
+
+  return closest;
+}
+} // namespace chEngineSDK
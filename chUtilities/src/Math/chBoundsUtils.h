@@ -0,0 +1,165 @@
+/************************************************************************/
+/**
+ * @file chBoundsUtils.h
+ * @author AccelMR
+ * @date 2025/07/30
+ * @brief Box tests shared by the bounding volume hierarchies.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chBox.h"
+#include "chPlane.h"
+#include "chVector3.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Static helpers used by BVH and DynamicAABBTree traversals. Everything is inline
+ *     since they run once per visited node.
+ *
+ * Sample usage:
+ *  const Vector3 invDirection = BoundsUtils::inverseDirection(direction);
+ *  if (BoundsUtils::rayEntry(box, origin, invDirection, maxDistance) >= 0.0f) { ... }
+ */
+class BoundsUtils
+{
+ public:
+  /**
+   *   Inverted box, growing it by anything gives that thing's bounds.
+   **/
+  NODISCARD FORCEINLINE static AABox
+  emptyBox() {
+    const float maxValue = std::numeric_limits<float>::max();
+    return AABox(Vector3(maxValue, maxValue, maxValue),
+                 Vector3(-maxValue, -maxValue, -maxValue));
+  }
+
+  FORCEINLINE static void
+  grow(AABox& box, const AABox& other) {
+    box.minPoint = Vector3(Math::min(box.minPoint.x, other.minPoint.x),
+                           Math::min(box.minPoint.y, other.minPoint.y),
+                           Math::min(box.minPoint.z, other.minPoint.z));
+    box.maxPoint = Vector3(Math::max(box.maxPoint.x, other.maxPoint.x),
+                           Math::max(box.maxPoint.y, other.maxPoint.y),
+                           Math::max(box.maxPoint.z, other.maxPoint.z));
+  }
+
+  NODISCARD FORCEINLINE static AABox
+  merge(const AABox& a, const AABox& b) {
+    AABox Result = a;
+    grow(Result, b);
+    return Result;
+  }
+
+  /**
+   *   Half the surface area, enough to compare SAH costs.
+   **/
+  NODISCARD FORCEINLINE static float
+  halfArea(const AABox& box) {
+    const Vector3 size = box.maxPoint - box.minPoint;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+  }
+
+  NODISCARD FORCEINLINE static bool
+  overlaps(const AABox& a, const AABox& b) {
+    return a.minPoint.x <= b.maxPoint.x && a.maxPoint.x >= b.minPoint.x &&
+           a.minPoint.y <= b.maxPoint.y && a.maxPoint.y >= b.minPoint.y &&
+           a.minPoint.z <= b.maxPoint.z && a.maxPoint.z >= b.minPoint.z;
+  }
+
+  NODISCARD FORCEINLINE static bool
+  contains(const AABox& outer, const AABox& inner) {
+    return outer.minPoint.x <= inner.minPoint.x && outer.maxPoint.x >= inner.maxPoint.x &&
+           outer.minPoint.y <= inner.minPoint.y && outer.maxPoint.y >= inner.maxPoint.y &&
+           outer.minPoint.z <= inner.minPoint.z && outer.maxPoint.z >= inner.maxPoint.z;
+  }
+
+  /**
+   *   True when the sphere touches the box, using the closest point of the box.
+   **/
+  NODISCARD FORCEINLINE static bool
+  overlapsSphere(const AABox& box, const Vector3& center, float radius) {
+    const float dx = center.x - Math::clamp(center.x, box.minPoint.x, box.maxPoint.x);
+    const float dy = center.y - Math::clamp(center.y, box.minPoint.y, box.maxPoint.y);
+    const float dz = center.z - Math::clamp(center.z, box.minPoint.z, box.maxPoint.z);
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+  }
+
+  /**
+   *   Slab test, returns the entry distance or a negative value on miss.
+   **/
+  NODISCARD FORCEINLINE static float
+  rayEntry(const AABox& box, const Vector3& origin, const Vector3& invDirection, float maxT) {
+    const float tx1 = (box.minPoint.x - origin.x) * invDirection.x;
+    const float tx2 = (box.maxPoint.x - origin.x) * invDirection.x;
+    float tMin = Math::min(tx1, tx2);
+    float tMax = Math::max(tx1, tx2);
+    const float ty1 = (box.minPoint.y - origin.y) * invDirection.y;
+    const float ty2 = (box.maxPoint.y - origin.y) * invDirection.y;
+    tMin = Math::max(tMin, Math::min(ty1, ty2));
+    tMax = Math::min(tMax, Math::max(ty1, ty2));
+    const float tz1 = (box.minPoint.z - origin.z) * invDirection.z;
+    const float tz2 = (box.maxPoint.z - origin.z) * invDirection.z;
+    tMin = Math::max(tMin, Math::min(tz1, tz2));
+    tMax = Math::min(tMax, Math::max(tz1, tz2));
+    tMin = Math::max(tMin, 0.0f);
+    return (tMin <= tMax && tMin <= maxT) ? tMin : -1.0f;
+  }
+
+  NODISCARD FORCEINLINE static Vector3
+  inverseDirection(const Vector3& direction) {
+    const float maxValue = std::numeric_limits<float>::max();
+    return Vector3(direction.x != 0.0f ? 1.0f / direction.x : maxValue,
+                   direction.y != 0.0f ? 1.0f / direction.y : maxValue,
+                   direction.z != 0.0f ? 1.0f / direction.z : maxValue);
+  }
+
+  /**
+   *   -1 when the box is outside, 0 when it crosses a plane and 1 when fully inside.
+   *   A point p is inside a plane when plane.planeDot(p) >= 0, same as Camera frustums.
+   **/
+  NODISCARD FORCEINLINE static int32
+  classifyFrustum(const AABox& box, const Plane* planes, SIZE_T planeCount) {
+    int32 result = 1;
+    for (SIZE_T p = 0; p < planeCount; ++p) {
+      const Plane& plane = planes[p];
+      const Vector3 positive(plane.x >= 0.0f ? box.maxPoint.x : box.minPoint.x,
+                             plane.y >= 0.0f ? box.maxPoint.y : box.minPoint.y,
+                             plane.z >= 0.0f ? box.maxPoint.z : box.minPoint.z);
+      if (plane.planeDot(positive) < 0.0f) {
+        return -1;
+      }
+      const Vector3 negative(plane.x >= 0.0f ? box.minPoint.x : box.maxPoint.x,
+                             plane.y >= 0.0f ? box.minPoint.y : box.maxPoint.y,
+                             plane.z >= 0.0f ? box.minPoint.z : box.maxPoint.z);
+      if (plane.planeDot(negative) < 0.0f) {
+        result = 0;
+      }
+    }
+    return result;
+  }
+
+  /**
+   *   Calls a query callback, callbacks returning void always continue the query.
+   **/
+  template<class Fn, class... Args>
+  FORCEINLINE static bool
+  visit(Fn& fn, Args&&... args) {
+    if constexpr (std::is_same_v<std::invoke_result_t<Fn&, Args...>, bool>) {
+      return fn(std::forward<Args>(args)...);
+    }
+    else {
+      fn(std::forward<Args>(args)...);
+      return true;
+    }
+  }
+};
+} // namespace chEngineSDK
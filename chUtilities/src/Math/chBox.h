@@ -7,6 +7,7 @@
  *   Box classes along the engine.
  */
  /************************************************************************/
+#pragma once
 
  /************************************************************************/
  /*
@@ -110,6 +111,18 @@ class AABox
   FORCEINLINE AABox&
   operator+=(const Vector3& v);
 
+  /**
+   *   Grows this bounding box to also contain another one.
+   *
+   * @param other
+   *    The box to include.
+   *
+   * @return
+   *   Reference to this bounding box after resizing.
+   */
+  FORCEINLINE AABox&
+  operator+=(const AABox& other);
+
  public:
 
   /*
@@ -211,4 +224,14 @@ AABox::operator+=(const Vector3& v)
   return *this;
 }
 
+/*
+*/
+FORCEINLINE AABox&
+AABox::operator+=(const AABox& other)
+{
+  *this += other.minPoint;
+  *this += other.maxPoint;
+  return *this;
+}
+
 } // namespace chEngineSDK
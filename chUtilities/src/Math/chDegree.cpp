@@ -38,14 +38,6 @@ Degree::operator=(const Radian& radian)
   return *this;
 }
 
-/*
-*/
-float
-Degree::valueRadian() const
-{
-  return m_degree * Math::DEG2RAD;
-}
-
 /*
 */
 void
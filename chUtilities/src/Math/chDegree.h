@@ -20,6 +20,8 @@
  /************************************************************************/
 #include "chPrerequisitesUtilities.h"
 
+#include "chPlatformMath.h"
+
 namespace chEngineSDK {
 /**
  *  Wrapper class for a Degree angle.
@@ -50,7 +52,7 @@ public:
    * @param degree
    *   Degree angle
    */
-  explicit Degree(float _degree) : m_degree(_degree) {}
+  explicit constexpr Degree(float _degree) : m_degree(_degree) {}
 
   /**
    * Radian constructor
@@ -86,7 +88,7 @@ public:
    * @return
    *   This Degree with the new given Degree as float.
    */
-  FORCEINLINE Degree&
+  FORCEINLINE constexpr Degree&
   operator=(float degree);
 
   /**
@@ -95,7 +97,7 @@ public:
    * @return
    *   Float raw value as Radian
    */
-  float
+  FORCEINLINE constexpr float
   valueRadian() const;
 
   /**
@@ -107,7 +109,7 @@ public:
    * @return
    *   Float raw value as degree.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   valueDegree() const;
 
   /**
@@ -140,7 +142,7 @@ public:
    * @return
    *   Degree created from this action.
    */
-  FORCEINLINE Degree
+  FORCEINLINE constexpr Degree
   operator+(const Degree& degree) const;
 
   /**
@@ -164,7 +166,7 @@ public:
    * @return
    *   Modify this Degree depending on the math action.
    */
-  FORCEINLINE Degree&
+  FORCEINLINE constexpr Degree&
   operator+=(const Degree& degree);
 
   /**
@@ -188,7 +190,7 @@ public:
    * @return Degree
    *  New Degree created from the multiplication;
    **/
-  FORCEINLINE Degree
+  FORCEINLINE constexpr Degree
   operator*(float scalar) const;
 
   /**
@@ -197,7 +199,7 @@ public:
    * @param scalar
    * The scalar to be multiplied.
    **/
-  FORCEINLINE Degree&
+  FORCEINLINE constexpr Degree&
   operator*=(float scalar);
 
   /**
@@ -206,7 +208,7 @@ public:
    * @return
    *   Degree created from this action.
    */
-  FORCEINLINE Degree
+  FORCEINLINE constexpr Degree
   operator-() const;
 
   /**
@@ -218,7 +220,7 @@ public:
    * @return
    *   Degree created from this action.
    */
-  FORCEINLINE Degree
+  FORCEINLINE constexpr Degree
   operator-(const Degree& degree) const;
 
   /**
@@ -242,7 +244,7 @@ public:
    * @return
    *   Modify this Degree depending on the math action.
    */
-  FORCEINLINE Degree&
+  FORCEINLINE constexpr Degree&
   operator-=(const Degree& degree);
 
   /**
@@ -266,7 +268,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<(const Degree& degree) const;
 
   /**
@@ -278,7 +280,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>(const Degree& degree) const;
 
   /**
@@ -290,7 +292,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<=(const Degree& degree) const;
 
   /**
@@ -302,7 +304,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>=(const Degree& degree) const;
 
   /**
@@ -314,7 +316,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Degree& degree) const;
 
   /**
@@ -326,7 +328,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(const Degree& degree) const;
 
   /**
@@ -338,7 +340,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<(float degree) const;
 
   /**
@@ -350,7 +352,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>(float degree) const;
 
   /**
@@ -362,7 +364,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<=(float degree) const;
 
   /**
@@ -374,7 +376,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>=(float degree) const;
 
   /**
@@ -386,7 +388,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(float degree) const;
 
   /**
@@ -398,7 +400,7 @@ public:
    * @return
    *   Bool from condition.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(float degree) const;
 
   /**
@@ -492,7 +494,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator<(float floatDegree, const Degree& degree);
 
   /**
@@ -507,7 +509,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator>(float floatDegree, const Degree& degree);
 
   /**
@@ -522,7 +524,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator<=(float floatDegree, const Degree& degree);
 
   /**
@@ -537,7 +539,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator>=(float floatDegree, const Degree& degree);
 
   /**
@@ -552,7 +554,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator==(float floatDegree, const Degree& degree);
 
   /**
@@ -567,7 +569,7 @@ private:
    * @return
    *   Compares a float against given Degree.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator!=(float floatDegree, const Degree& degree);
 
 private:
@@ -585,7 +587,7 @@ private:
  /************************************************************************/
  /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Degree::valueDegree() const
 {
   return m_degree;
@@ -593,7 +595,15 @@ Degree::valueDegree() const
 
 /*
 */
-FORCEINLINE Degree&
+FORCEINLINE constexpr float
+Degree::valueRadian() const
+{
+  return m_degree * PlatformMath::DEG2RAD;
+}
+
+/*
+*/
+FORCEINLINE constexpr Degree&
 Degree::operator=(float degree)
 {
   m_degree = degree;
@@ -602,7 +612,7 @@ Degree::operator=(float degree)
 
 /*
 */
-FORCEINLINE Degree
+FORCEINLINE constexpr Degree
 Degree::operator+(const Degree& degree) const
 {
   return Degree(m_degree + degree.m_degree);
@@ -610,7 +620,7 @@ Degree::operator+(const Degree& degree) const
 
 /*
 */
-FORCEINLINE Degree&
+FORCEINLINE constexpr Degree&
 Degree::operator+=(const Degree& degree)
 {
   m_degree += degree.m_degree;
@@ -619,7 +629,7 @@ Degree::operator+=(const Degree& degree)
 
 /*
 */
-FORCEINLINE Degree
+FORCEINLINE constexpr Degree
 Degree::operator*(float scalar) const
 {
   Degree d = *this;
@@ -629,7 +639,7 @@ Degree::operator*(float scalar) const
 
 /*
 */
-FORCEINLINE Degree&
+FORCEINLINE constexpr Degree&
 Degree::operator*=(float scalar)
 {
   m_degree *= scalar;
@@ -638,7 +648,7 @@ Degree::operator*=(float scalar)
 
 /*
 */
-FORCEINLINE Degree
+FORCEINLINE constexpr Degree
 Degree::operator-() const
 {
   return Degree(-m_degree);
@@ -646,7 +656,7 @@ Degree::operator-() const
 
 /*
 */
-FORCEINLINE Degree
+FORCEINLINE constexpr Degree
 Degree::operator-(const Degree& degree) const
 {
   return Degree(m_degree - degree.m_degree);
@@ -654,7 +664,7 @@ Degree::operator-(const Degree& degree) const
 
 /*
 */
-FORCEINLINE Degree&
+FORCEINLINE constexpr Degree&
 Degree::operator-=(const Degree& degree)
 {
   m_degree -= degree.m_degree;
@@ -663,7 +673,7 @@ Degree::operator-=(const Degree& degree)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator<(const Degree& degree) const
 {
   return m_degree < degree.m_degree;
@@ -671,7 +681,7 @@ Degree::operator<(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator>(const Degree& degree) const
 {
   return m_degree > degree.m_degree;
@@ -679,7 +689,7 @@ Degree::operator>(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator<=(const Degree& degree) const
 {
   return m_degree <= degree.m_degree;
@@ -687,7 +697,7 @@ Degree::operator<=(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator>=(const Degree& degree) const
 {
   return m_degree >= degree.m_degree;
@@ -695,7 +705,7 @@ Degree::operator>=(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator==(const Degree& degree) const
 {
   return m_degree == degree.m_degree;
@@ -703,7 +713,7 @@ Degree::operator==(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator!=(const Degree& degree) const
 {
   return m_degree != degree.m_degree;
@@ -711,7 +721,7 @@ Degree::operator!=(const Degree& degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator<(float degree) const
 {
   return m_degree < degree;
@@ -719,7 +729,7 @@ Degree::operator<(float degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator>(float degree) const
 {
   return m_degree > degree;
@@ -727,7 +737,7 @@ Degree::operator>(float degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator<=(float degree) const
 {
   return m_degree <= degree;
@@ -735,7 +745,7 @@ Degree::operator<=(float degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator>=(float degree) const
 {
   return m_degree >= degree;
@@ -743,7 +753,7 @@ Degree::operator>=(float degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator==(float degree) const
 {
   return m_degree == degree;
@@ -751,7 +761,7 @@ Degree::operator==(float degree) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Degree::operator!=(float degree) const
 {
   return m_degree != degree;
@@ -759,7 +769,7 @@ Degree::operator!=(float degree) const
 
 /*
 */
-FORCEINLINE  bool
+FORCEINLINE constexpr bool
 operator<(float floatDegree, const Degree& degree)
 {
   return floatDegree < degree.m_degree;
@@ -767,7 +777,7 @@ operator<(float floatDegree, const Degree& degree)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator>(float floatDegree, const Degree& degree)
 {
   return floatDegree > degree.m_degree;
@@ -775,7 +785,7 @@ operator>(float floatDegree, const Degree& degree)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator>=(float floatDegree, const Degree& degree)
 {
   return floatDegree >= degree.m_degree;
@@ -783,14 +793,14 @@ operator>=(float floatDegree, const Degree& degree)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator<=(float floatDegree, const Degree& degree)
 {
   return floatDegree <= degree.m_degree;
 }
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator!=(float floatDegree, const Degree& degree)
 {
   return floatDegree != degree.m_degree;
@@ -798,7 +808,7 @@ operator!=(float floatDegree, const Degree& degree)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator==(float floatDegree, const Degree& degree)
 {
   return floatDegree == degree.m_degree;
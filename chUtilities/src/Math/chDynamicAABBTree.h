@@ -0,0 +1,782 @@
+/************************************************************************/
+/**
+ * @file chDynamicAABBTree.h
+ * @author AccelMR
+ * @date 2025/07/30
+ * @brief Incremental bounding volume hierarchy for moving items.
+ *
+ * Unlike BVH, items are inserted, moved and removed one by one. Leaves store enlarged
+ * boxes so small movements do not touch the tree, and the tree is kept balanced with
+ * rotations so queries stay logarithmic.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chBoundsUtils.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Dynamic AABB tree, every item is a leaf and every internal node has two children.
+ *
+ *     Insertion picks the sibling with the lowest surface area cost and walks back up
+ *     rotating unbalanced nodes. Leaves keep the exact box of the item, used by queries,
+ *     and a fat box grown by the margin, used by the tree. move() only reinserts an item
+ *     when it leaves its fat box.
+ *
+ *     Query callbacks may return void or bool, returning false stops the query.
+ *
+ * Sample usage:
+ *  DynamicAABBTree<GameObject*> tree;
+ *  auto proxy = tree.insert(bounds, object);
+ *  tree.move(proxy, newBounds);
+ *  tree.querySphere(center, radius, [](GameObject* object) { ... });
+ *  tree.remove(proxy);
+ */
+template<typename T>
+class DynamicAABBTree
+{
+ public:
+  using ProxyId = uint32;
+  static constexpr ProxyId INVALID_PROXY = 0xFFFFFFFF;
+  static constexpr float DEFAULT_MARGIN = 0.1f;
+
+  explicit DynamicAABBTree(float margin = DEFAULT_MARGIN)
+    : m_margin(margin)
+  {}
+
+  /**
+   *   Adds an item, the returned id is stable until the item is removed.
+   **/
+  ProxyId
+  insert(const AABox& bounds, const T& item);
+
+  void
+  remove(ProxyId proxy);
+
+  /**
+   *   Updates the box of an item.
+   *
+   * @return
+   *   True when the item had to be reinserted in the tree.
+   **/
+  bool
+  move(ProxyId proxy, const AABox& bounds);
+
+  NODISCARD FORCEINLINE bool
+  isValid(ProxyId proxy) const {
+    return proxy < m_nodes.size() && m_nodes[proxy].height == 0;
+  }
+
+  NODISCARD FORCEINLINE const T&
+  getItem(ProxyId proxy) const {
+    CH_ASSERT(isValid(proxy));
+    return m_nodes[proxy].item;
+  }
+
+  /**
+   *   Exact box given to the last insert() or move().
+   **/
+  NODISCARD FORCEINLINE const AABox&
+  getBounds(ProxyId proxy) const {
+    CH_ASSERT(isValid(proxy));
+    return m_nodes[proxy].itemBounds;
+  }
+
+  /**
+   *   Calls fn(item) for every item whose box overlaps the given one.
+   **/
+  template<class Fn>
+  void
+  queryAABox(const AABox& box, Fn&& fn) const;
+
+  /**
+   *   Calls fn(item) for every item whose box touches the sphere.
+   **/
+  template<class Fn>
+  void
+  querySphere(const Vector3& center, float radius, Fn&& fn) const;
+
+  /**
+   *   Calls fn(item) for every item whose box is at least partially inside all planes.
+   *   A point p is inside a plane when plane.planeDot(p) >= 0, same as Camera frustums.
+   **/
+  template<class Fn>
+  void
+  queryFrustum(const Plane* planes, SIZE_T planeCount, Fn&& fn) const;
+
+  /**
+   *   Calls fn(item, entryDistance) for every item whose box is hit by the ray before
+   *   maxDistance. Items are not sorted.
+   **/
+  template<class Fn>
+  void
+  queryRay(const Vector3& origin,
+           const Vector3& direction,
+           float maxDistance,
+           Fn&& fn) const;
+
+  /**
+   *   Finds the closest item hit by the ray. hitFn(item, distance) performs the exact
+   *   test and must return true and write the distance when the item is hit closer than
+   *   the given value. Nodes are visited front to back so far subtrees are culled early.
+   *
+   * @param distance
+   *   In: max distance. Out: distance to the closest hit.
+   **/
+  template<class HitFn>
+  Optional<T>
+  raycast(const Vector3& origin,
+          const Vector3& direction,
+          float& distance,
+          HitFn&& hitFn) const;
+
+  NODISCARD FORCEINLINE bool
+  empty() const {
+    return m_root == NULL_NODE;
+  }
+
+  NODISCARD FORCEINLINE SIZE_T
+  getProxyCount() const {
+    return m_proxyCount;
+  }
+
+  /**
+   *   Longest path from the root to a leaf, 0 for a single item.
+   **/
+  NODISCARD FORCEINLINE uint32
+  getHeight() const {
+    return empty() ? 0 : static_cast<uint32>(m_nodes[m_root].height);
+  }
+
+  void
+  clear();
+
+ public:
+  /**
+   *  Traversal stack size, balanced trees stay far below it.
+   */
+  static constexpr uint32 MAX_STACK = 256;
+
+ private:
+  static constexpr uint32 NULL_NODE = 0xFFFFFFFF;
+
+  struct Node
+  {
+    NODISCARD FORCEINLINE bool
+    isLeaf() const {
+      return child1 == NULL_NODE;
+    }
+
+    /**
+     * Fat box for leaves, union of the children otherwise.
+     */
+    AABox bounds;
+    AABox itemBounds;
+    T item{};
+
+    /**
+     * Next free node while the node is in the free list.
+     */
+    uint32 parent = NULL_NODE;
+    uint32 child1 = NULL_NODE;
+    uint32 child2 = NULL_NODE;
+
+    /**
+     * 0 for leaves, -1 for free nodes.
+     */
+    int32 height = -1;
+  };
+
+  NODISCARD FORCEINLINE AABox
+  fatten(const AABox& bounds, float margin) const {
+    const Vector3 offset(margin, margin, margin);
+    return AABox(bounds.minPoint - offset, bounds.maxPoint + offset);
+  }
+
+  uint32
+  allocateNode();
+
+  void
+  freeNode(uint32 node);
+
+  void
+  insertLeaf(uint32 leaf);
+
+  void
+  removeLeaf(uint32 leaf);
+
+  /**
+   *   Recomputes bounds and heights from the node up to the root, rotating on the way.
+   **/
+  void
+  refitUpwards(uint32 node);
+
+  /**
+   *   Rotates the node if its children heights differ by more than one.
+   *
+   * @return
+   *   Node now at the position of the given one.
+   **/
+  uint32
+  balance(uint32 node);
+
+  Vector<Node> m_nodes;
+  uint32 m_root = NULL_NODE;
+  uint32 m_freeList = NULL_NODE;
+  SIZE_T m_proxyCount = 0;
+  float m_margin;
+};
+
+/************************************************************************/
+/*
+ * Implementation
+ */
+/************************************************************************/
+
+/*
+*/
+template<typename T>
+typename DynamicAABBTree<T>::ProxyId
+DynamicAABBTree<T>::insert(const AABox& bounds, const T& item) {
+  const uint32 leaf = allocateNode();
+  Node& node = m_nodes[leaf];
+  node.bounds = fatten(bounds, m_margin);
+  node.itemBounds = bounds;
+  node.item = item;
+  node.height = 0;
+
+  insertLeaf(leaf);
+  ++m_proxyCount;
+  return leaf;
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::remove(ProxyId proxy) {
+  CH_ASSERT(isValid(proxy));
+  removeLeaf(proxy);
+  freeNode(proxy);
+  --m_proxyCount;
+}
+
+/*
+ * The fat box is kept while it contains the item and is not much bigger than needed,
+ * otherwise an item that shrank would keep a huge box forever.
+ */
+template<typename T>
+bool
+DynamicAABBTree<T>::move(ProxyId proxy, const AABox& bounds) {
+  CH_ASSERT(isValid(proxy));
+  Node& node = m_nodes[proxy];
+  node.itemBounds = bounds;
+
+  if (BoundsUtils::contains(node.bounds, bounds) &&
+      BoundsUtils::contains(fatten(bounds, m_margin * 4.0f), node.bounds)) {
+    return false;
+  }
+
+  removeLeaf(proxy);
+  m_nodes[proxy].bounds = fatten(bounds, m_margin);
+  insertLeaf(proxy);
+  return true;
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::clear() {
+  m_nodes.clear();
+  m_root = NULL_NODE;
+  m_freeList = NULL_NODE;
+  m_proxyCount = 0;
+}
+
+/*
+*/
+template<typename T>
+uint32
+DynamicAABBTree<T>::allocateNode() {
+  if (m_freeList == NULL_NODE) {
+    m_nodes.emplace_back();
+    return static_cast<uint32>(m_nodes.size() - 1);
+  }
+
+  const uint32 node = m_freeList;
+  m_freeList = m_nodes[node].parent;
+  m_nodes[node] = Node();
+  return node;
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::freeNode(uint32 node) {
+  m_nodes[node].item = T{};
+  m_nodes[node].parent = m_freeList;
+  m_nodes[node].child1 = NULL_NODE;
+  m_nodes[node].child2 = NULL_NODE;
+  m_nodes[node].height = -1;
+  m_freeList = node;
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::insertLeaf(uint32 leaf) {
+  if (m_root == NULL_NODE) {
+    m_root = leaf;
+    m_nodes[leaf].parent = NULL_NODE;
+    return;
+  }
+
+  // Descend while going down is cheaper than making the current node our sibling. The
+  // cost of a child is the area it would gain plus what every ancestor already gains.
+  const AABox leafBounds = m_nodes[leaf].bounds;
+  uint32 index = m_root;
+  while (!m_nodes[index].isLeaf()) {
+    const Node& node = m_nodes[index];
+    const float area = BoundsUtils::halfArea(node.bounds);
+    const float combinedArea =
+        BoundsUtils::halfArea(BoundsUtils::merge(node.bounds, leafBounds));
+    const float siblingCost = 2.0f * combinedArea;
+    const float inheritanceCost = 2.0f * (combinedArea - area);
+
+    auto childCost = [&](uint32 child) {
+      const Node& childNode = m_nodes[child];
+      const float mergedArea =
+          BoundsUtils::halfArea(BoundsUtils::merge(childNode.bounds, leafBounds));
+      return childNode.isLeaf()
+                 ? mergedArea + inheritanceCost
+                 : mergedArea - BoundsUtils::halfArea(childNode.bounds) + inheritanceCost;
+    };
+    const float cost1 = childCost(node.child1);
+    const float cost2 = childCost(node.child2);
+
+    if (siblingCost < cost1 && siblingCost < cost2) {
+      break;
+    }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const uint32 sibling = index;
+  const uint32 oldParent = m_nodes[sibling].parent;
+  const uint32 newParent = allocateNode();
+  Node& parentNode = m_nodes[newParent];
+  parentNode.parent = oldParent;
+  parentNode.bounds = BoundsUtils::merge(leafBounds, m_nodes[sibling].bounds);
+  parentNode.height = m_nodes[sibling].height + 1;
+  parentNode.child1 = sibling;
+  parentNode.child2 = leaf;
+
+  if (oldParent != NULL_NODE) {
+    Node& grandParent = m_nodes[oldParent];
+    if (grandParent.child1 == sibling) {
+      grandParent.child1 = newParent;
+    }
+    else {
+      grandParent.child2 = newParent;
+    }
+  }
+  else {
+    m_root = newParent;
+  }
+  m_nodes[sibling].parent = newParent;
+  m_nodes[leaf].parent = newParent;
+
+  refitUpwards(m_nodes[leaf].parent);
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::removeLeaf(uint32 leaf) {
+  if (leaf == m_root) {
+    m_root = NULL_NODE;
+    return;
+  }
+
+  const uint32 parent = m_nodes[leaf].parent;
+  const uint32 grandParent = m_nodes[parent].parent;
+  const uint32 sibling =
+      m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+  m_nodes[sibling].parent = grandParent;
+  freeNode(parent);
+
+  if (grandParent == NULL_NODE) {
+    m_root = sibling;
+    return;
+  }
+
+  Node& grandParentNode = m_nodes[grandParent];
+  if (grandParentNode.child1 == parent) {
+    grandParentNode.child1 = sibling;
+  }
+  else {
+    grandParentNode.child2 = sibling;
+  }
+  refitUpwards(grandParent);
+}
+
+/*
+*/
+template<typename T>
+void
+DynamicAABBTree<T>::refitUpwards(uint32 node) {
+  uint32 index = node;
+  while (index != NULL_NODE) {
+    index = balance(index);
+
+    Node& current = m_nodes[index];
+    const Node& child1 = m_nodes[current.child1];
+    const Node& child2 = m_nodes[current.child2];
+    current.height = 1 + Math::max(child1.height, child2.height);
+    current.bounds = BoundsUtils::merge(child1.bounds, child2.bounds);
+
+    index = current.parent;
+  }
+}
+
+/*
+ * Single rotation promoting the taller child: A with children B and C becomes C with
+ * children A and the taller of C's children, A keeps the shorter one.
+ */
+template<typename T>
+uint32
+DynamicAABBTree<T>::balance(uint32 iA) {
+  Node& A = m_nodes[iA];
+  if (A.isLeaf() || A.height < 2) {
+    return iA;
+  }
+
+  const uint32 iB = A.child1;
+  const uint32 iC = A.child2;
+  Node& B = m_nodes[iB];
+  Node& C = m_nodes[iC];
+  const int32 difference = C.height - B.height;
+
+  auto replaceInParent = [&](uint32 oldChild, uint32 newChild) {
+    const uint32 parent = m_nodes[newChild].parent;
+    if (parent == NULL_NODE) {
+      m_root = newChild;
+    }
+    else if (m_nodes[parent].child1 == oldChild) {
+      m_nodes[parent].child1 = newChild;
+    }
+    else {
+      m_nodes[parent].child2 = newChild;
+    }
+  };
+
+  // Promote C.
+  if (difference > 1) {
+    const uint32 iF = C.child1;
+    const uint32 iG = C.child2;
+    Node& F = m_nodes[iF];
+    Node& G = m_nodes[iG];
+
+    C.child1 = iA;
+    C.parent = A.parent;
+    A.parent = iC;
+    replaceInParent(iA, iC);
+
+    if (F.height > G.height) {
+      C.child2 = iF;
+      A.child2 = iG;
+      G.parent = iA;
+      A.bounds = BoundsUtils::merge(B.bounds, G.bounds);
+      C.bounds = BoundsUtils::merge(A.bounds, F.bounds);
+      A.height = 1 + Math::max(B.height, G.height);
+      C.height = 1 + Math::max(A.height, F.height);
+    }
+    else {
+      C.child2 = iG;
+      A.child2 = iF;
+      F.parent = iA;
+      A.bounds = BoundsUtils::merge(B.bounds, F.bounds);
+      C.bounds = BoundsUtils::merge(A.bounds, G.bounds);
+      A.height = 1 + Math::max(B.height, F.height);
+      C.height = 1 + Math::max(A.height, G.height);
+    }
+    return iC;
+  }
+
+  // Promote B.
+  if (difference < -1) {
+    const uint32 iD = B.child1;
+    const uint32 iE = B.child2;
+    Node& D = m_nodes[iD];
+    Node& E = m_nodes[iE];
+
+    B.child1 = iA;
+    B.parent = A.parent;
+    A.parent = iB;
+    replaceInParent(iA, iB);
+
+    if (D.height > E.height) {
+      B.child2 = iD;
+      A.child1 = iE;
+      E.parent = iA;
+      A.bounds = BoundsUtils::merge(C.bounds, E.bounds);
+      B.bounds = BoundsUtils::merge(A.bounds, D.bounds);
+      A.height = 1 + Math::max(C.height, E.height);
+      B.height = 1 + Math::max(A.height, D.height);
+    }
+    else {
+      B.child2 = iE;
+      A.child1 = iD;
+      D.parent = iA;
+      A.bounds = BoundsUtils::merge(C.bounds, D.bounds);
+      B.bounds = BoundsUtils::merge(A.bounds, E.bounds);
+      A.height = 1 + Math::max(C.height, D.height);
+      B.height = 1 + Math::max(A.height, E.height);
+    }
+    return iB;
+  }
+
+  return iA;
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+DynamicAABBTree<T>::queryAABox(const AABox& box, Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  uint32 stack[MAX_STACK];
+  uint32 stackSize = 0;
+  stack[stackSize++] = m_root;
+
+  while (stackSize > 0) {
+    const Node& node = m_nodes[stack[--stackSize]];
+    if (!BoundsUtils::overlaps(node.bounds, box)) {
+      continue;
+    }
+
+    if (node.isLeaf()) {
+      if (BoundsUtils::overlaps(node.itemBounds, box) && !BoundsUtils::visit(fn, node.item)) {
+        return;
+      }
+      continue;
+    }
+
+    CH_ASSERT(stackSize + 2 <= MAX_STACK);
+    stack[stackSize++] = node.child2;
+    stack[stackSize++] = node.child1;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+DynamicAABBTree<T>::querySphere(const Vector3& center, float radius, Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  uint32 stack[MAX_STACK];
+  uint32 stackSize = 0;
+  stack[stackSize++] = m_root;
+
+  while (stackSize > 0) {
+    const Node& node = m_nodes[stack[--stackSize]];
+    if (!BoundsUtils::overlapsSphere(node.bounds, center, radius)) {
+      continue;
+    }
+
+    if (node.isLeaf()) {
+      if (BoundsUtils::overlapsSphere(node.itemBounds, center, radius) &&
+          !BoundsUtils::visit(fn, node.item)) {
+        return;
+      }
+      continue;
+    }
+
+    CH_ASSERT(stackSize + 2 <= MAX_STACK);
+    stack[stackSize++] = node.child2;
+    stack[stackSize++] = node.child1;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+DynamicAABBTree<T>::queryFrustum(const Plane* planes, SIZE_T planeCount, Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  // Bit 31 marks subtrees already known to be fully inside.
+  constexpr uint32 INSIDE_FLAG = 0x80000000u;
+  uint32 stack[MAX_STACK];
+  uint32 stackSize = 0;
+  stack[stackSize++] = m_root;
+
+  while (stackSize > 0) {
+    const uint32 entry = stack[--stackSize];
+    const Node& node = m_nodes[entry & ~INSIDE_FLAG];
+    bool inside = (entry & INSIDE_FLAG) != 0;
+
+    if (!inside) {
+      const int32 classification =
+          BoundsUtils::classifyFrustum(node.bounds, planes, planeCount);
+      if (classification < 0) {
+        continue;
+      }
+      inside = classification > 0;
+    }
+
+    if (node.isLeaf()) {
+      // The fat box being inside says nothing about the exact one being outside.
+      const bool visible =
+          inside || BoundsUtils::classifyFrustum(node.itemBounds, planes, planeCount) >= 0;
+      if (visible && !BoundsUtils::visit(fn, node.item)) {
+        return;
+      }
+      continue;
+    }
+
+    const uint32 flag = inside ? INSIDE_FLAG : 0;
+    CH_ASSERT(stackSize + 2 <= MAX_STACK);
+    stack[stackSize++] = node.child2 | flag;
+    stack[stackSize++] = node.child1 | flag;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class Fn>
+void
+DynamicAABBTree<T>::queryRay(const Vector3& origin,
+                             const Vector3& direction,
+                             float maxDistance,
+                             Fn&& fn) const {
+  if (empty()) {
+    return;
+  }
+
+  const Vector3 invDirection = BoundsUtils::inverseDirection(direction);
+  uint32 stack[MAX_STACK];
+  uint32 stackSize = 0;
+  stack[stackSize++] = m_root;
+
+  while (stackSize > 0) {
+    const Node& node = m_nodes[stack[--stackSize]];
+    if (BoundsUtils::rayEntry(node.bounds, origin, invDirection, maxDistance) < 0.0f) {
+      continue;
+    }
+
+    if (node.isLeaf()) {
+      const float entry =
+          BoundsUtils::rayEntry(node.itemBounds, origin, invDirection, maxDistance);
+      if (entry >= 0.0f && !BoundsUtils::visit(fn, node.item, entry)) {
+        return;
+      }
+      continue;
+    }
+
+    CH_ASSERT(stackSize + 2 <= MAX_STACK);
+    stack[stackSize++] = node.child2;
+    stack[stackSize++] = node.child1;
+  }
+}
+
+/*
+*/
+template<typename T>
+template<class HitFn>
+Optional<T>
+DynamicAABBTree<T>::raycast(const Vector3& origin,
+                            const Vector3& direction,
+                            float& distance,
+                            HitFn&& hitFn) const {
+  Optional<T> closest;
+  if (empty()) {
+    return closest;
+  }
+
+  const Vector3 invDirection = BoundsUtils::inverseDirection(direction);
+  const float rootEntry =
+      BoundsUtils::rayEntry(m_nodes[m_root].bounds, origin, invDirection, distance);
+  if (rootEntry < 0.0f) {
+    return closest;
+  }
+
+  struct StackEntry
+  {
+    uint32 node;
+    float entry;
+  };
+  StackEntry stack[MAX_STACK];
+  uint32 stackSize = 0;
+  stack[stackSize++] = {m_root, rootEntry};
+
+  while (stackSize > 0) {
+    const StackEntry current = stack[--stackSize];
+    if (current.entry > distance) {
+      continue;
+    }
+
+    const Node& node = m_nodes[current.node];
+    if (node.isLeaf()) {
+      if (BoundsUtils::rayEntry(node.itemBounds, origin, invDirection, distance) < 0.0f) {
+        continue;
+      }
+      float hitDistance = distance;
+      if (hitFn(node.item, hitDistance) && hitDistance <= distance) {
+        distance = hitDistance;
+        closest = node.item;
+      }
+      continue;
+    }
+
+    const float entry1 =
+        BoundsUtils::rayEntry(m_nodes[node.child1].bounds, origin, invDirection, distance);
+    const float entry2 =
+        BoundsUtils::rayEntry(m_nodes[node.child2].bounds, origin, invDirection, distance);
+
+    // Push the far child first so the near one is popped next.
+    CH_ASSERT(stackSize + 2 <= MAX_STACK);
+    const bool firstIsNear = entry1 >= 0.0f && (entry2 < 0.0f || entry1 <= entry2);
+    if (firstIsNear) {
+      if (entry2 >= 0.0f) {
+        stack[stackSize++] = {node.child2, entry2};
+      }
+      stack[stackSize++] = {node.child1, entry1};
+    }
+    else {
+      if (entry1 >= 0.0f) {
+        stack[stackSize++] = {node.child1, entry1};
+      }
+      if (entry2 >= 0.0f) {
+        stack[stackSize++] = {node.child2, entry2};
+      }
+    }
+  }
+
+  return closest;
+}
+} // namespace chEngineSDK
@@ -0,0 +1,277 @@
+/************************************************************************/
+/**
+ * @file chMatrix3x4.cpp
+ * @author AccelMR
+ * @date 2025/07/24
+ *   Affine 3x4 matrix implementation.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chMatrix3x4.h"
+
+#include "chBox.h"
+#include "chMatrix4.h"
+#include "chQuaternion.h"
+
+namespace chEngineSDK {
+
+/*
+*/
+Matrix3x4::Matrix3x4(const Matrix4& m4)
+  : Matrix3x4(m4[0][0], m4[1][0], m4[2][0], m4[3][0],
+              m4[0][1], m4[1][1], m4[2][1], m4[3][1],
+              m4[0][2], m4[1][2], m4[2][2], m4[3][2])
+{}
+
+/*
+*/
+Matrix3x4::Matrix3x4(const Quaternion& rotation, const Vector3& translation)
+  : Matrix3x4(Vector3::UNIT, rotation, translation)
+{}
+
+/*
+*/
+Matrix3x4::Matrix3x4(const Vector3& scale,
+                     const Quaternion& rotation,
+                     const Vector3& translation) {
+  const float xx = rotation.x * rotation.x;
+  const float yy = rotation.y * rotation.y;
+  const float zz = rotation.z * rotation.z;
+  const float xy = rotation.x * rotation.y;
+  const float xz = rotation.x * rotation.z;
+  const float yz = rotation.y * rotation.z;
+  const float wx = rotation.w * rotation.x;
+  const float wy = rotation.w * rotation.y;
+  const float wz = rotation.w * rotation.z;
+
+  // Each column is a rotated basis axis, scaled before rotating.
+  m_data[0][0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+  m_data[0][1] = (2.0f * (xy - wz)) * scale.y;
+  m_data[0][2] = (2.0f * (xz + wy)) * scale.z;
+  m_data[0][3] = translation.x;
+
+  m_data[1][0] = (2.0f * (xy + wz)) * scale.x;
+  m_data[1][1] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+  m_data[1][2] = (2.0f * (yz - wx)) * scale.z;
+  m_data[1][3] = translation.y;
+
+  m_data[2][0] = (2.0f * (xz - wy)) * scale.x;
+  m_data[2][1] = (2.0f * (yz + wx)) * scale.y;
+  m_data[2][2] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+  m_data[2][3] = translation.z;
+}
+
+/*
+*/
+Matrix4
+Matrix3x4::toMatrix4() const {
+  return Matrix4(m_data[0][0], m_data[1][0], m_data[2][0], 0.0f,
+                 m_data[0][1], m_data[1][1], m_data[2][1], 0.0f,
+                 m_data[0][2], m_data[1][2], m_data[2][2], 0.0f,
+                 m_data[0][3], m_data[1][3], m_data[2][3], 1.0f);
+}
+
+/*
+*/
+Vector3
+Matrix3x4::getScale() const {
+  return Vector3(Math::sqrt(m_data[0][0] * m_data[0][0] + m_data[1][0] * m_data[1][0] +
+                            m_data[2][0] * m_data[2][0]),
+                 Math::sqrt(m_data[0][1] * m_data[0][1] + m_data[1][1] * m_data[1][1] +
+                            m_data[2][1] * m_data[2][1]),
+                 Math::sqrt(m_data[0][2] * m_data[0][2] + m_data[1][2] * m_data[1][2] +
+                            m_data[2][2] * m_data[2][2]));
+}
+
+/*
+*/
+Quaternion
+Matrix3x4::getRotation() const {
+  const Vector3 scale = getScale();
+  const float invX = scale.x > Math::SMALL_NUMBER ? 1.0f / scale.x : 0.0f;
+  const float invY = scale.y > Math::SMALL_NUMBER ? 1.0f / scale.y : 0.0f;
+  const float invZ = scale.z > Math::SMALL_NUMBER ? 1.0f / scale.z : 0.0f;
+
+  const Matrix4 rotation(m_data[0][0] * invX, m_data[1][0] * invX, m_data[2][0] * invX, 0.0f,
+                         m_data[0][1] * invY, m_data[1][1] * invY, m_data[2][1] * invY, 0.0f,
+                         m_data[0][2] * invZ, m_data[1][2] * invZ, m_data[2][2] * invZ, 0.0f,
+                         0.0f, 0.0f, 0.0f, 1.0f);
+  return Quaternion(rotation);
+}
+
+/*
+ * Rows of the inverse linear part are the cross products of the columns divided by the
+ * determinant, the translation is then -inverse(A) * t.
+ */
+Matrix3x4
+Matrix3x4::getInverse() const {
+  const float det = getDeterminant();
+  if (Math::abs(det) < Math::SMALL_NUMBER) {
+    return IDENTITY;
+  }
+  const float invDet = 1.0f / det;
+
+  Matrix3x4 Result;
+
+#if USING(CH_SIMD_SSE2)
+  __m128 column0 = _mm_load_ps(m_data[0]);
+  __m128 column1 = _mm_load_ps(m_data[1]);
+  __m128 column2 = _mm_load_ps(m_data[2]);
+  __m128 translation = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+
+  auto cross = [](__m128 a, __m128 b) {
+    const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    const __m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+  };
+
+  const __m128 scale = _mm_set1_ps(invDet);
+  __m128 row0 = _mm_mul_ps(cross(column1, column2), scale);
+  __m128 row1 = _mm_mul_ps(cross(column2, column0), scale);
+  __m128 row2 = _mm_mul_ps(cross(column0, column1), scale);
+
+  // Transposed inverse rows give its columns, so -inverse(A) * t is a broadcast sum.
+  __m128 inverse0 = row0;
+  __m128 inverse1 = row1;
+  __m128 inverse2 = row2;
+  __m128 unused = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(inverse0, inverse1, inverse2, unused);
+
+  __m128 newTranslation =
+      _mm_mul_ps(inverse0, _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(0, 0, 0, 0)));
+  newTranslation = _mm_add_ps(
+      newTranslation,
+      _mm_mul_ps(inverse1, _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(1, 1, 1, 1))));
+  newTranslation = _mm_add_ps(
+      newTranslation,
+      _mm_mul_ps(inverse2, _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(2, 2, 2, 2))));
+  newTranslation = _mm_sub_ps(_mm_setzero_ps(), newTranslation);
+
+  _mm_store_ps(Result.m_data[0], row0);
+  _mm_store_ps(Result.m_data[1], row1);
+  _mm_store_ps(Result.m_data[2], row2);
+
+  alignas(16) float t[4];
+  _mm_store_ps(t, newTranslation);
+  Result.m_data[0][3] = t[0];
+  Result.m_data[1][3] = t[1];
+  Result.m_data[2][3] = t[2];
+#else
+  const Vector3 column0(m_data[0][0], m_data[1][0], m_data[2][0]);
+  const Vector3 column1(m_data[0][1], m_data[1][1], m_data[2][1]);
+  const Vector3 column2(m_data[0][2], m_data[1][2], m_data[2][2]);
+  const Vector3 rows[3] = {column1.cross(column2) * invDet,
+                           column2.cross(column0) * invDet,
+                           column0.cross(column1) * invDet};
+  const Vector3 translation = getTranslation();
+
+  for (int32 i = 0; i < 3; ++i) {
+    Result.m_data[i][0] = rows[i].x;
+    Result.m_data[i][1] = rows[i].y;
+    Result.m_data[i][2] = rows[i].z;
+    Result.m_data[i][3] =
+        -((&rows[0].x)[i] * translation.x + (&rows[1].x)[i] * translation.y +
+          (&rows[2].x)[i] * translation.z);
+  }
+#endif // USING(CH_SIMD_SSE2)
+
+  return Result;
+}
+
+/*
+*/
+void
+Matrix3x4::transformPoints(const Vector3* in, Vector3* out, SIZE_T count) const {
+#if USING(CH_SIMD_SSE2)
+  __m128 column0 = _mm_load_ps(m_data[0]);
+  __m128 column1 = _mm_load_ps(m_data[1]);
+  __m128 column2 = _mm_load_ps(m_data[2]);
+  __m128 translation = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+
+  alignas(16) float result[4];
+  for (SIZE_T i = 0; i < count; ++i) {
+    const Vector3 p = in[i];
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), column0), translation);
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(p.y), column1));
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(p.z), column2));
+    _mm_store_ps(result, v);
+    out[i] = Vector3(result[0], result[1], result[2]);
+  }
+#else
+  for (SIZE_T i = 0; i < count; ++i) {
+    out[i] = transformPoint(in[i]);
+  }
+#endif // USING(CH_SIMD_SSE2)
+}
+
+/*
+ * Center and extent form: the new extent is the absolute linear part times the old one.
+ */
+AABox
+Matrix3x4::transformBox(const AABox& box) const {
+  const Vector3 center = transformPoint(box.getCenter());
+  const Vector3 extent = box.getExtent();
+  const Vector3 newExtent(
+      Math::abs(m_data[0][0]) * extent.x + Math::abs(m_data[0][1]) * extent.y +
+          Math::abs(m_data[0][2]) * extent.z,
+      Math::abs(m_data[1][0]) * extent.x + Math::abs(m_data[1][1]) * extent.y +
+          Math::abs(m_data[1][2]) * extent.z,
+      Math::abs(m_data[2][0]) * extent.x + Math::abs(m_data[2][1]) * extent.y +
+          Math::abs(m_data[2][2]) * extent.z);
+  return AABox(center - newExtent, center + newExtent);
+}
+
+/*
+*/
+AABox
+Matrix3x4::transformBounds(const float* positions, SIZE_T strideBytes, SIZE_T count) const {
+  CH_ASSERT(positions && count > 0);
+  const uint8* bytes = reinterpret_cast<const uint8*>(positions);
+
+#if USING(CH_SIMD_SSE2)
+  __m128 column0 = _mm_load_ps(m_data[0]);
+  __m128 column1 = _mm_load_ps(m_data[1]);
+  __m128 column2 = _mm_load_ps(m_data[2]);
+  __m128 translation = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+
+  // Components are broadcast one by one so nothing past the last position is read.
+  const float maxValue = std::numeric_limits<float>::max();
+  __m128 minPoint = _mm_set1_ps(maxValue);
+  __m128 maxPoint = _mm_set1_ps(-maxValue);
+  for (SIZE_T i = 0; i < count; ++i) {
+    const float* p = reinterpret_cast<const float*>(bytes + i * strideBytes);
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_load1_ps(p), column0), translation);
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_load1_ps(p + 1), column1));
+    v = _mm_add_ps(v, _mm_mul_ps(_mm_load1_ps(p + 2), column2));
+    minPoint = _mm_min_ps(minPoint, v);
+    maxPoint = _mm_max_ps(maxPoint, v);
+  }
+
+  alignas(16) float minValues[4];
+  alignas(16) float maxValues[4];
+  _mm_store_ps(minValues, minPoint);
+  _mm_store_ps(maxValues, maxPoint);
+  return AABox(Vector3(minValues[0], minValues[1], minValues[2]),
+               Vector3(maxValues[0], maxValues[1], maxValues[2]));
+#else
+  const float* first = positions;
+  const Vector3 firstPoint = transformPoint(Vector3(first[0], first[1], first[2]));
+  AABox Result(firstPoint, firstPoint);
+  for (SIZE_T i = 1; i < count; ++i) {
+    const float* p = reinterpret_cast<const float*>(bytes + i * strideBytes);
+    Result += transformPoint(Vector3(p[0], p[1], p[2]));
+  }
+  return Result;
+#endif // USING(CH_SIMD_SSE2)
+}
+} // namespace chEngineSDK
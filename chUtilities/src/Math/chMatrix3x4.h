@@ -0,0 +1,355 @@
+/************************************************************************/
+/**
+ * @file chMatrix3x4.h
+ * @author AccelMR
+ * @date 2025/07/24
+ *   Affine 3x4 matrix, the compact form of a Matrix4 whose last column is (0, 0, 0, 1).
+ *
+ * Coordinate system being X = front, Z = up, Y = right
+ *
+ * Left hand
+ */
+/************************************************************************/
+#pragma once
+
+#include "chPrerequisitesUtilities.h"
+
+#include "chMath.h"
+#include "chVector3.h"
+
+#if USING(CH_SIMD_SSE2)
+#include <emmintrin.h>
+#endif // USING(CH_SIMD_SSE2)
+
+namespace chEngineSDK {
+using std::ostream;
+/*
+ * Description:
+ *     Affine transform stored in 12 floats instead of 16.
+ *
+ *     Composition follows Matrix4: A * B first applies A and then B, so
+ *     Matrix3x4(a * b) == Matrix3x4(a) * Matrix3x4(b) for affine Matrix4 a and b.
+ *
+ *     Storage is the transpose of the first three columns of the equivalent Matrix4, each
+ *     row holds (axis.x, axis.y, axis.z, translation) for one output component. This is
+ *     the layout of a row major float3x4 in shaders, so data() can be uploaded as is.
+ *
+ * Sample usage:
+ *  Matrix3x4 world = Matrix3x4(Vector3::UNIT, rotation, position) * parentWorld;
+ *  Vector3 p = world.transformPoint(localPoint);
+ *
+ */
+class CH_UTILITY_EXPORT Matrix3x4
+{
+ public:
+  /*
+   * @brief Default constructor
+   */
+  Matrix3x4() = default;
+
+  /**
+   * @brief Construct from the 12 stored values, row by row.
+   */
+  FORCEINLINE constexpr
+  Matrix3x4(float _m00, float _m01, float _m02, float _m03,
+            float _m10, float _m11, float _m12, float _m13,
+            float _m20, float _m21, float _m22, float _m23);
+
+  /**
+   * @brief Constructor from an affine Matrix4, the projective column is dropped.
+   */
+  explicit Matrix3x4(const Matrix4& m4);
+
+  /**
+   * @brief Constructor from a rotation and a translation
+   */
+  Matrix3x4(const Quaternion& rotation, const Vector3& translation);
+
+  /**
+   * @brief Constructor from scale, rotation and translation, applied in that order
+   */
+  Matrix3x4(const Vector3& scale, const Quaternion& rotation, const Vector3& translation);
+
+  ~Matrix3x4() = default;
+
+  /************************************************************************/
+  /*
+   * Methods
+   */
+  /************************************************************************/
+
+  /**
+   * @brief Expands this to a full Matrix4
+   */
+  NODISCARD Matrix4
+  toMatrix4() const;
+
+  /**
+   * @brief Rotation part as a quaternion, scale is removed first.
+   */
+  NODISCARD Quaternion
+  getRotation() const;
+
+  /**
+   * @brief Length of each transformed axis
+   */
+  NODISCARD Vector3
+  getScale() const;
+
+  NODISCARD FORCEINLINE constexpr Vector3
+  getTranslation() const;
+
+  FORCEINLINE constexpr void
+  setTranslation(const Vector3& translation);
+
+  /**
+   * @brief Determinant of the linear part
+   */
+  NODISCARD FORCEINLINE constexpr float
+  getDeterminant() const;
+
+  /**
+   * @brief Computes the inverse affine transform.
+   * Returns IDENTITY when the linear part is singular.
+   */
+  NODISCARD Matrix3x4
+  getInverse() const;
+
+  /**
+   * @brief Transforms a position, translation included
+   */
+  NODISCARD FORCEINLINE constexpr Vector3
+  transformPoint(const Vector3& p) const;
+
+  /**
+   * @brief Transforms a direction, translation ignored
+   */
+  NODISCARD FORCEINLINE constexpr Vector3
+  transformVector(const Vector3& v) const;
+
+  /**
+   * @brief Transforms count positions, out may alias in.
+   */
+  void
+  transformPoints(const Vector3* in, Vector3* out, SIZE_T count) const;
+
+  /**
+   * @brief Axis aligned bounds of a transformed box, tight for the box corners.
+   */
+  NODISCARD AABox
+  transformBox(const AABox& box) const;
+
+  /**
+   * @brief Bounds of count transformed positions without writing them anywhere.
+   * Positions are three floats read every strideBytes, so they can be taken straight
+   * from an interleaved vertex buffer. count must be greater than zero.
+   */
+  NODISCARD AABox
+  transformBounds(const float* positions, SIZE_T strideBytes, SIZE_T count) const;
+
+  NODISCARD FORCEINLINE constexpr float&
+  at(int32 row, int32 col);
+
+  NODISCARD FORCEINLINE constexpr const float&
+  at(int32 row, int32 col) const;
+
+  /**
+   * @brief All elements as 12 contiguous floats, ready for GPU upload
+   */
+  NODISCARD FORCEINLINE constexpr const float*
+  data() const;
+
+  /************************************************************************/
+  /*
+   * Operator overload
+   */
+  /************************************************************************/
+
+  /**
+   * @brief Composes two transforms, the result applies this first and then other.
+   */
+  NODISCARD FORCEINLINE constexpr Matrix3x4
+  operator*(const Matrix3x4& other) const;
+
+  FORCEINLINE constexpr Matrix3x4&
+  operator*=(const Matrix3x4& other);
+
+  NODISCARD FORCEINLINE constexpr bool
+  operator==(const Matrix3x4& other) const;
+
+ private:
+  friend ostream&
+  operator<<(ostream& output, const Matrix3x4& matrix);
+
+ public:
+  /**
+   * Identity transform
+   */
+  static const Matrix3x4 IDENTITY;
+
+ protected:
+  alignas(16) float m_data[3][4];
+};
+
+/************************************************************************/
+/*
+ * Implementation
+ */
+/************************************************************************/
+
+/*
+ */
+FORCEINLINE constexpr
+Matrix3x4::Matrix3x4(float _m00, float _m01, float _m02, float _m03,
+                     float _m10, float _m11, float _m12, float _m13,
+                     float _m20, float _m21, float _m22, float _m23)
+  : m_data{{_m00, _m01, _m02, _m03}, {_m10, _m11, _m12, _m13}, {_m20, _m21, _m22, _m23}}
+{}
+
+/*
+ */
+FORCEINLINE constexpr float&
+Matrix3x4::at(int32 row, int32 col) {
+  CH_ASSERT(row >= 0 && row < 3 && col >= 0 && col < 4);
+  return m_data[row][col];
+}
+
+/*
+ */
+FORCEINLINE constexpr const float&
+Matrix3x4::at(int32 row, int32 col) const {
+  CH_ASSERT(row >= 0 && row < 3 && col >= 0 && col < 4);
+  return m_data[row][col];
+}
+
+/*
+ */
+FORCEINLINE constexpr const float*
+Matrix3x4::data() const {
+  return &m_data[0][0];
+}
+
+/*
+ */
+FORCEINLINE constexpr Vector3
+Matrix3x4::getTranslation() const {
+  return Vector3(m_data[0][3], m_data[1][3], m_data[2][3]);
+}
+
+/*
+ */
+FORCEINLINE constexpr void
+Matrix3x4::setTranslation(const Vector3& translation) {
+  m_data[0][3] = translation.x;
+  m_data[1][3] = translation.y;
+  m_data[2][3] = translation.z;
+}
+
+/*
+ */
+FORCEINLINE constexpr float
+Matrix3x4::getDeterminant() const {
+  return m_data[0][0] * (m_data[1][1] * m_data[2][2] - m_data[1][2] * m_data[2][1]) -
+         m_data[0][1] * (m_data[1][0] * m_data[2][2] - m_data[1][2] * m_data[2][0]) +
+         m_data[0][2] * (m_data[1][0] * m_data[2][1] - m_data[1][1] * m_data[2][0]);
+}
+
+/*
+ */
+FORCEINLINE constexpr Vector3
+Matrix3x4::transformPoint(const Vector3& p) const {
+  return Vector3(m_data[0][0] * p.x + m_data[0][1] * p.y + m_data[0][2] * p.z + m_data[0][3],
+                 m_data[1][0] * p.x + m_data[1][1] * p.y + m_data[1][2] * p.z + m_data[1][3],
+                 m_data[2][0] * p.x + m_data[2][1] * p.y + m_data[2][2] * p.z + m_data[2][3]);
+}
+
+/*
+ */
+FORCEINLINE constexpr Vector3
+Matrix3x4::transformVector(const Vector3& v) const {
+  return Vector3(m_data[0][0] * v.x + m_data[0][1] * v.y + m_data[0][2] * v.z,
+                 m_data[1][0] * v.x + m_data[1][1] * v.y + m_data[1][2] * v.z,
+                 m_data[2][0] * v.x + m_data[2][1] * v.y + m_data[2][2] * v.z);
+}
+
+/*
+ */
+FORCEINLINE constexpr Matrix3x4
+Matrix3x4::operator*(const Matrix3x4& other) const {
+  Matrix3x4 Result;
+
+#if USING(CH_SIMD_SSE2)
+  // Runtime path, same summation order as the scalar loop so both give identical results.
+  if (!std::is_constant_evaluated()) {
+    const __m128 row0 = _mm_load_ps(m_data[0]);
+    const __m128 row1 = _mm_load_ps(m_data[1]);
+    const __m128 row2 = _mm_load_ps(m_data[2]);
+    const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    for (int32 i = 0; i < 3; ++i) {
+      __m128 row = _mm_mul_ps(_mm_set1_ps(other.m_data[i][0]), row0);
+      row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(other.m_data[i][1]), row1));
+      row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(other.m_data[i][2]), row2));
+      row = _mm_add_ps(row, _mm_and_ps(_mm_load_ps(other.m_data[i]), translationMask));
+      _mm_store_ps(Result.m_data[i], row);
+    }
+
+    return Result;
+  }
+#endif // USING(CH_SIMD_SSE2)
+
+  for (int32 i = 0; i < 3; ++i) {
+    for (int32 j = 0; j < 4; ++j) {
+      Result.m_data[i][j] = other.m_data[i][0] * m_data[0][j] +
+                            other.m_data[i][1] * m_data[1][j] +
+                            other.m_data[i][2] * m_data[2][j] +
+                            (j == 3 ? other.m_data[i][3] : 0.0f);
+    }
+  }
+
+  return Result;
+}
+
+/*
+ */
+FORCEINLINE constexpr Matrix3x4&
+Matrix3x4::operator*=(const Matrix3x4& other) {
+  *this = *this * other;
+  return *this;
+}
+
+/*
+ */
+FORCEINLINE constexpr bool
+Matrix3x4::operator==(const Matrix3x4& other) const {
+  for (int32 i = 0; i < 3; ++i) {
+    for (int32 j = 0; j < 4; ++j) {
+      if (m_data[i][j] != other.m_data[i][j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Implementation of friend output operator
+inline ostream&
+operator<<(ostream& output, const Matrix3x4& matrix) {
+  for (int32 i = 0; i < 3; ++i) {
+    for (int32 j = 0; j < 4; ++j) {
+      output << matrix.m_data[i][j] << ", ";
+    }
+    output << std::endl;
+  }
+  return output;
+}
+
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Matrix3x4 Matrix3x4::IDENTITY = Matrix3x4(1.0f, 0.0f, 0.0f, 0.0f,
+                                                           0.0f, 1.0f, 0.0f, 0.0f,
+                                                           0.0f, 0.0f, 1.0f, 0.0f);
+} // namespace chEngineSDK
@@ -14,6 +14,10 @@
 
 #include "chPrerequisitesUtilities.h"
 
+#if USING(CH_SIMD_SSE2)
+#include <xmmintrin.h>
+#endif // USING(CH_SIMD_SSE2)
+
 namespace chEngineSDK {
 using std::ostream;
 /*
@@ -37,7 +41,7 @@ class CH_UTILITY_EXPORT Matrix4
   /**
    * @brief Construct a Matrix4 from 16 individual float values
    */
-  FORCEINLINE
+  FORCEINLINE constexpr
   Matrix4(float _m00, float _m01, float _m02, float _m03, float _m10, float _m11, float _m12,
           float _m13, float _m20, float _m21, float _m22, float _m23, float _m30, float _m31,
           float _m32, float _m33);
@@ -45,7 +49,7 @@ class CH_UTILITY_EXPORT Matrix4
   /**
    * @brief Copy constructor
    */
-  FORCEINLINE
+  FORCEINLINE constexpr
   Matrix4(const Matrix4& copy);
 
   /*
@@ -79,7 +83,7 @@ class CH_UTILITY_EXPORT Matrix4
   /**
    * @brief Sets this matrix to identity
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   setIdentity();
 
   /**
@@ -87,7 +91,7 @@ class CH_UTILITY_EXPORT Matrix4
    *
    * @return Matrix4 The new matrix created from this
    */
-  NODISCARD FORCEINLINE Matrix4
+  NODISCARD FORCEINLINE constexpr Matrix4
   getTransposed() const;
 
   /**
@@ -95,7 +99,7 @@ class CH_UTILITY_EXPORT Matrix4
    *
    * @return Matrix4& This reference
    */
-  FORCEINLINE Matrix4&
+  FORCEINLINE constexpr Matrix4&
   transposed();
 
   /**
@@ -103,7 +107,7 @@ class CH_UTILITY_EXPORT Matrix4
    *
    * @return float The determinant value
    */
-  NODISCARD FORCEINLINE float
+  NODISCARD FORCEINLINE constexpr float
   getDeterminant() const;
 
   /**
@@ -165,7 +169,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param col Column index (0-3)
    * @return float& Reference to the element
    */
-  NODISCARD FORCEINLINE float&
+  NODISCARD FORCEINLINE constexpr float&
   at(int32 row, int32 col);
 
   /**
@@ -175,7 +179,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param col Column index (0-3)
    * @return const float& Const reference to the element
    */
-  NODISCARD FORCEINLINE const float&
+  NODISCARD FORCEINLINE constexpr const float&
   at(int32 row, int32 col) const;
 
   /**
@@ -184,7 +188,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param row Row index (0-3)
    * @return const float* Pointer to the row
    */
-  NODISCARD FORCEINLINE const float*
+  NODISCARD FORCEINLINE constexpr const float*
   getRow(int32 row) const;
 
   /**
@@ -192,7 +196,7 @@ class CH_UTILITY_EXPORT Matrix4
    *
    * @return const float* Pointer to the elements
    */
-  NODISCARD FORCEINLINE const float*
+  NODISCARD FORCEINLINE constexpr const float*
   data() const;
 
   /************************************************************************/
@@ -207,7 +211,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param other The other matrix to be multiplied
    * @return Matrix4 A new matrix result
    */
-  NODISCARD FORCEINLINE Matrix4
+  NODISCARD FORCEINLINE constexpr Matrix4
   operator*(const Matrix4& other) const;
 
   /**
@@ -215,7 +219,7 @@ class CH_UTILITY_EXPORT Matrix4
    *
    * @param other The other matrix to be multiplied
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   operator*=(const Matrix4& other);
 
   /**
@@ -224,7 +228,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param other The other matrix to be summed
    * @return Matrix4 A new matrix result
    */
-  NODISCARD FORCEINLINE Matrix4
+  NODISCARD FORCEINLINE constexpr Matrix4
   operator+(const Matrix4& other) const;
 
   /**
@@ -233,7 +237,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param other The other matrix to be subtracted
    * @return Matrix4 A new matrix result
    */
-  NODISCARD FORCEINLINE Matrix4
+  NODISCARD FORCEINLINE constexpr Matrix4
   operator-(const Matrix4& other) const;
 
   /**
@@ -244,7 +248,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param value The float value to be multiplied
    * @return Matrix4 A new matrix result
    */
-  NODISCARD FORCEINLINE Matrix4
+  NODISCARD FORCEINLINE constexpr Matrix4
   operator*(float value) const;
 
   /**
@@ -253,7 +257,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param value The float value to be multiplied
    * @return Matrix4& Reference to this modified matrix
    */
-  FORCEINLINE Matrix4&
+  FORCEINLINE constexpr Matrix4&
   operator*=(float value);
 
   /**
@@ -262,7 +266,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param assignable Matrix4 to be taken as source
    * @return Matrix4& Reference to this changed Matrix4
    */
-  FORCEINLINE Matrix4&
+  FORCEINLINE constexpr Matrix4&
   operator=(const Matrix4& assignable);
 
   /**
@@ -271,7 +275,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param move RValue matrix4 to be taken as source
    * @return Matrix4& Reference to this changed Matrix4
    */
-  FORCEINLINE Matrix4&
+  FORCEINLINE constexpr Matrix4&
   operator=(Matrix4&& move) noexcept;
 
   /**
@@ -280,7 +284,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param other The other matrix to check against this one
    * @return bool True if both matrices are exactly equals
    */
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   operator==(const Matrix4& other) const;
 
   /**
@@ -289,7 +293,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param row Row index (0-3)
    * @return float* Pointer to the row
    */
-  NODISCARD FORCEINLINE float*
+  NODISCARD FORCEINLINE constexpr float*
   operator[](int32 row);
 
   /**
@@ -298,7 +302,7 @@ class CH_UTILITY_EXPORT Matrix4
    * @param row Row index (0-3)
    * @return const float* Pointer to the row
    */
-  NODISCARD FORCEINLINE const float*
+  NODISCARD FORCEINLINE constexpr const float*
   operator[](int32 row) const;
 
  private:
@@ -341,7 +345,7 @@ class CH_UTILITY_EXPORT Matrix4
 
 /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Matrix4::Matrix4(float _m00, float _m01, float _m02, float _m03, float _m10, float _m11,
                  float _m12, float _m13, float _m20, float _m21, float _m22, float _m23,
                  float _m30, float _m31, float _m32, float _m33) {
@@ -365,7 +369,7 @@ Matrix4::Matrix4(float _m00, float _m01, float _m02, float _m03, float _m10, flo
 
 /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Matrix4::Matrix4(const Matrix4& copy) {
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
@@ -376,7 +380,7 @@ Matrix4::Matrix4(const Matrix4& copy) {
 
 /*
  */
-FORCEINLINE float&
+FORCEINLINE constexpr float&
 Matrix4::at(int32 row, int32 col) {
   CH_ASSERT(row >= 0 && row < 4 && col >= 0 && col < 4);
   return m_data[row][col];
@@ -384,7 +388,7 @@ Matrix4::at(int32 row, int32 col) {
 
 /*
  */
-FORCEINLINE const float&
+FORCEINLINE constexpr const float&
 Matrix4::at(int32 row, int32 col) const {
   CH_ASSERT(row >= 0 && row < 4 && col >= 0 && col < 4);
   return m_data[row][col];
@@ -392,7 +396,7 @@ Matrix4::at(int32 row, int32 col) const {
 
 /*
  */
-FORCEINLINE const float*
+FORCEINLINE constexpr const float*
 Matrix4::getRow(int32 row) const {
   CH_ASSERT(row >= 0 && row < 4);
   return m_data[row];
@@ -400,14 +404,14 @@ Matrix4::getRow(int32 row) const {
 
 /*
  */
-FORCEINLINE const float*
+FORCEINLINE constexpr const float*
 Matrix4::data() const {
   return &m_data[0][0];
 }
 
 /*
  */
-FORCEINLINE float*
+FORCEINLINE constexpr float*
 Matrix4::operator[](int32 row) {
   CH_ASSERT(row >= 0 && row < 4);
   return m_data[row];
@@ -415,7 +419,7 @@ Matrix4::operator[](int32 row) {
 
 /*
  */
-FORCEINLINE const float*
+FORCEINLINE constexpr const float*
 Matrix4::operator[](int32 row) const {
   CH_ASSERT(row >= 0 && row < 4);
   return m_data[row];
@@ -423,14 +427,14 @@ Matrix4::operator[](int32 row) const {
 
 /*
  */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Matrix4::setIdentity() {
   *this = Matrix4::IDENTITY;
 }
 
 /*
  */
-FORCEINLINE Matrix4
+FORCEINLINE constexpr Matrix4
 Matrix4::getTransposed() const {
   Matrix4 Result;
 
@@ -445,7 +449,7 @@ Matrix4::getTransposed() const {
 
 /*
  */
-FORCEINLINE Matrix4&
+FORCEINLINE constexpr Matrix4&
 Matrix4::transposed() {
   *this = getTransposed();
   return *this;
@@ -453,7 +457,7 @@ Matrix4::transposed() {
 
 /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Matrix4::getDeterminant() const {
   return m_data[0][0] *
              (m_data[1][1] * (m_data[2][2] * m_data[3][3] - m_data[2][3] * m_data[3][2]) -
@@ -475,10 +479,30 @@ Matrix4::getDeterminant() const {
 
 /*
  */
-FORCEINLINE Matrix4
+FORCEINLINE constexpr Matrix4
 Matrix4::operator*(const Matrix4& other) const {
   Matrix4 Result;
 
+#if USING(CH_SIMD_SSE2)
+  // Runtime path, same summation order as the scalar loop so both give identical results.
+  if (!std::is_constant_evaluated()) {
+    const __m128 otherRow0 = _mm_loadu_ps(other.m_data[0]);
+    const __m128 otherRow1 = _mm_loadu_ps(other.m_data[1]);
+    const __m128 otherRow2 = _mm_loadu_ps(other.m_data[2]);
+    const __m128 otherRow3 = _mm_loadu_ps(other.m_data[3]);
+
+    for (int32 i = 0; i < 4; ++i) {
+      __m128 row = _mm_mul_ps(_mm_set1_ps(m_data[i][0]), otherRow0);
+      row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m_data[i][1]), otherRow1));
+      row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m_data[i][2]), otherRow2));
+      row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m_data[i][3]), otherRow3));
+      _mm_storeu_ps(Result.m_data[i], row);
+    }
+
+    return Result;
+  }
+#endif // USING(CH_SIMD_SSE2)
+
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
       Result.m_data[i][j] =
@@ -492,14 +516,14 @@ Matrix4::operator*(const Matrix4& other) const {
 
 /*
  */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Matrix4::operator*=(const Matrix4& other) {
   *this = *this * other;
 }
 
 /*
  */
-FORCEINLINE Matrix4
+FORCEINLINE constexpr Matrix4
 Matrix4::operator+(const Matrix4& other) const {
   Matrix4 Result;
 
@@ -514,7 +538,7 @@ Matrix4::operator+(const Matrix4& other) const {
 
 /*
  */
-FORCEINLINE Matrix4
+FORCEINLINE constexpr Matrix4
 Matrix4::operator-(const Matrix4& other) const {
   Matrix4 Result;
 
@@ -529,7 +553,7 @@ Matrix4::operator-(const Matrix4& other) const {
 
 /*
  */
-FORCEINLINE Matrix4
+FORCEINLINE constexpr Matrix4
 Matrix4::operator*(float value) const {
   Matrix4 Result;
 
@@ -544,7 +568,7 @@ Matrix4::operator*(float value) const {
 
 /*
  */
-FORCEINLINE Matrix4&
+FORCEINLINE constexpr Matrix4&
 Matrix4::operator*=(float value) {
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
@@ -557,7 +581,7 @@ Matrix4::operator*=(float value) {
 
 /*
  */
-FORCEINLINE Matrix4&
+FORCEINLINE constexpr Matrix4&
 Matrix4::operator=(const Matrix4& assignable) {
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
@@ -569,7 +593,7 @@ Matrix4::operator=(const Matrix4& assignable) {
 
 /*
  */
-FORCEINLINE Matrix4&
+FORCEINLINE constexpr Matrix4&
 Matrix4::operator=(Matrix4&& move) noexcept {
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
@@ -581,7 +605,7 @@ Matrix4::operator=(Matrix4&& move) noexcept {
 
 /*
  */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Matrix4::operator==(const Matrix4& other) const {
   for (int32 i = 0; i < 4; ++i) {
     for (int32 j = 0; j < 4; ++j) {
@@ -604,4 +628,21 @@ operator<<(ostream& output, const Matrix4& matrix4) {
   }
   return output;
 }
+
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Matrix4 Matrix4::ZERO = Matrix4(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                                 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                                 0.0f, 0.0f);
+
+inline constexpr Matrix4 Matrix4::IDENTITY = Matrix4(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                                                     0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                                                     0.0f, 1.0f);
+
+inline constexpr Matrix4 Matrix4::UNITY = Matrix4(1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+                                                  1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+                                                  1.0f, 1.0f);
 } // namespace chEngineSDK
@@ -26,52 +26,12 @@
 #include "chSphereBoxBounds.h"
 
 namespace chEngineSDK {
-
-/************************************************************************/
-/*
- * Static variables.
- */
- /************************************************************************/
-const float PlatformMath::PI = acosf(-1.0f);
-
-const float PlatformMath::RAD2DEG = 180.0f / PI;
-
-const float PlatformMath::DEG2RAD = PI / 180.0f;
-
-const float PlatformMath::TWO_PI = PI * 2.0f;
-
-const float PlatformMath::HALF_PI = PI * 0.5f;
-
-const float PlatformMath::FORTH_PI = PI / 4.0f;
-
-const float PlatformMath::SMALL_NUMBER = (1.e-6f);
-
-const float PlatformMath::KINDA_SMALL_NUMBER = (1.e-4f);
-
-const float PlatformMath::INV_PI = 1.0f / PI;
-
 /************************************************************************/
 /*
  * Functions.
  */
  /************************************************************************/
 
-/*
-*/
-float
-PlatformMath::sqrt(float value)
-{
-  return std::sqrt(value);
-}
-
-/*
-*/
-float
-PlatformMath::invSqrt(float value)
-{
-  return 1.0f / sqrtf(value);
-}
-
 /*
 */
 float
@@ -80,22 +40,6 @@ PlatformMath::pow(float value, const float vPow)
   return std::pow(value, vPow);
 }
 
-/*
-*/
-float
-PlatformMath::abs(float value)
-{
-  return std::abs(value);
-}
-
-/*
-*/
-bool
-PlatformMath::isFinite(float value)
-{
-  return std::isfinite(value);
-}
-
 /*
 */
 float
@@ -50,7 +50,7 @@ public:
   *
   * @return float The result of the square root of value.
   */
-  static float
+  FORCEINLINE static constexpr float
   sqrt(float value);
 
   /**
@@ -60,7 +60,7 @@ public:
    *
    * @return float The inverse square root of value.
    */
-  static float
+  FORCEINLINE static constexpr float
   invSqrt(float value);
 
   /**
@@ -87,7 +87,7 @@ public:
    * @return float
    *  The abs calculated.
    **/
-  static float
+  FORCEINLINE static constexpr float
   abs(float value);
 
   /**
@@ -103,14 +103,14 @@ public:
    *
    * @return
    **/
-  FORCEINLINE static float
+  FORCEINLINE static constexpr float
   lerp(float val1, const float& val2, const float& time);
 
   /**
    *   Clamp a value within an inclusive range.
    */
   template<class T>
-  FORCEINLINE static T
+  FORCEINLINE static constexpr T
   clamp(const T X, const T Min, const T Max){
     return X < Min ? Min : X < Max ? X : Max;
   }
@@ -131,7 +131,7 @@ public:
    *
    * @return
    **/
-  FORCEINLINE static float
+  FORCEINLINE static constexpr float
   invLerp(float val1, const float& val2, const float& time);
 
   /**
@@ -143,7 +143,7 @@ public:
    * @return bool
    *  False if value is Nan or infinite.
    **/
-  static bool
+  FORCEINLINE static constexpr bool
   isFinite(float value);
 
   /**
@@ -156,7 +156,7 @@ public:
    *    Second value.
    **/
   template <class T>
-  static T
+  FORCEINLINE static constexpr T
   min(const T x, const T y);
 
   /**
@@ -169,7 +169,7 @@ public:
    *    Second value.
    **/
   template <class T>
-  static T
+  FORCEINLINE static constexpr T
   max(const T x, const T y);
 
   /**
@@ -244,7 +244,7 @@ public:
    * @param Value
    *    input angles
    */
-  static FORCEINLINE void
+  FORCEINLINE static constexpr void
   sin_cos(float* ScalarSin, float* ScalarCos, float Value);
 
   /**
@@ -412,7 +412,7 @@ public:
    *
    * @return degree float as unwind degree angle value.
    */
-  FORCEINLINE static float
+  FORCEINLINE static constexpr float
   unwindDegrees(float degree);
 
   /**
@@ -420,10 +420,10 @@ public:
    *
    * @param radian float angle value as radian.
    */
-  FORCEINLINE static float
+  FORCEINLINE static constexpr float
   unwindRadians(float radian);
 
-  NODISCARD FORCEINLINE static bool
+  NODISCARD FORCEINLINE static constexpr bool
   nearEqual(float a, const float& b, const float& epsilon = SMALL_NUMBER);
 
   /************************************************************************/
@@ -565,47 +565,47 @@ public:
   /**
    *  PI value.
    */
-  static const float PI;
+  static constexpr float PI = 3.14159265358979323846f;
 
   /**
    *  This Multiplied by a radian value equals Degree angle.
    */
-  static const float RAD2DEG;
+  static constexpr float RAD2DEG = 180.0f / PI;
 
   /**
    *  This Multiplied by a degree value equals Radian angle.
    */
-  static const float DEG2RAD;
+  static constexpr float DEG2RAD = PI / 180.0f;
 
   /**
    *  Two PI.
    */
-  static const float TWO_PI;
+  static constexpr float TWO_PI = PI * 2.0f;
 
   /**
    *  Half PI.
    */
-  static const float HALF_PI;
+  static constexpr float HALF_PI = PI * 0.5f;
 
   /**
    *  Forth PI.
    */
-  static const float FORTH_PI;
+  static constexpr float FORTH_PI = PI / 4.0f;
 
   /**
    *  Small number.
    */
-  static const float SMALL_NUMBER;
+  static constexpr float SMALL_NUMBER = 1.e-6f;
 
   /**
    *  Kind a small number.
    */
-  static const float KINDA_SMALL_NUMBER;
+  static constexpr float KINDA_SMALL_NUMBER = 1.e-4f;
 
   /**
    *   Inverse PI
    **/
-  static const float INV_PI;
+  static constexpr float INV_PI = 1.0f / PI;
 };
 
 /************************************************************************/
@@ -614,10 +614,58 @@ public:
  */
  /************************************************************************/
 
+/*
+*/
+FORCEINLINE constexpr float
+PlatformMath::sqrt(float value) {
+  if (std::is_constant_evaluated()) {
+    // Newton-Raphson from above, converges monotonically to within one ulp of std::sqrt.
+    if (!(value > 0.0f) || value == std::numeric_limits<float>::infinity()) {
+      return value < 0.0f ? std::numeric_limits<float>::quiet_NaN() : value;
+    }
+    float current = value > 1.0f ? value : 1.0f;
+    float next = 0.5f * (current + value / current);
+    while (next < current) {
+      current = next;
+      next = 0.5f * (current + value / current);
+    }
+    return current;
+  }
+  return std::sqrt(value);
+}
+
+/*
+*/
+FORCEINLINE constexpr float
+PlatformMath::invSqrt(float value) {
+  return 1.0f / sqrt(value);
+}
+
+/*
+*/
+FORCEINLINE constexpr float
+PlatformMath::abs(float value) {
+  if (std::is_constant_evaluated()) {
+    return value < 0.0f ? -value : value;
+  }
+  return std::abs(value);
+}
+
+/*
+*/
+FORCEINLINE constexpr bool
+PlatformMath::isFinite(float value) {
+  if (std::is_constant_evaluated()) {
+    return value == value && value <= std::numeric_limits<float>::max() &&
+           value >= std::numeric_limits<float>::lowest();
+  }
+  return std::isfinite(value);
+}
+
 /*
 */
 template <class T>
-T
+FORCEINLINE constexpr T
 PlatformMath::min(const T x, const T y) {
   return x < y ? x : y;
 }
@@ -625,14 +673,14 @@ PlatformMath::min(const T x, const T y) {
 /*
 */
 template <class T>
-T
+FORCEINLINE constexpr T
 PlatformMath::max(const T x, const T y) {
   return x > y ? x : y;
 }
 
  /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 PlatformMath::unwindDegrees(float degree)
 {
   while (180.f < degree) {
@@ -646,7 +694,7 @@ PlatformMath::unwindDegrees(float degree)
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 PlatformMath::unwindRadians(float radian)
 {
   while (PI < radian) {
@@ -660,7 +708,7 @@ PlatformMath::unwindRadians(float radian)
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 PlatformMath::lerp(float val1, const float& val2, const float& time)
 {
   return val1 + time * (val2 - val1);
@@ -668,7 +716,7 @@ PlatformMath::lerp(float val1, const float& val2, const float& time)
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 PlatformMath::invLerp(float val1, const float& val2, const float& time)
 {
   return (time - val1) / (val2 - val1);
@@ -676,7 +724,7 @@ PlatformMath::invLerp(float val1, const float& val2, const float& time)
 
 /*
 */
-FORCEINLINE void
+FORCEINLINE constexpr void
 PlatformMath::sin_cos( float *ScalarSin, float *ScalarCos, float Value )
 {
   //Map Value to y in [-pi, pi], x = 2*pi*quotient + remainder.
@@ -719,7 +767,7 @@ PlatformMath::sin_cos( float *ScalarSin, float *ScalarCos, float Value )
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 PlatformMath::nearEqual(float a, const float& b, const float& epsilon) {
   return (abs(a - b) <= epsilon);
 }
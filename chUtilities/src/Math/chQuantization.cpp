@@ -0,0 +1,591 @@
+/************************************************************************/
+/**
+ * @file chQuantization.cpp
+ * @author AccelMR
+ * @date 2025/07/20
+ * @brief Compact representations of floats, unit vectors and rotations.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chQuantization.h"
+
+#include "chMath.h"
+
+#if USING(CH_SIMD_SSE2)
+#include <emmintrin.h>
+#endif // USING(CH_SIMD_SSE2)
+
+namespace chEngineSDK {
+namespace {
+const float SNORM16_SCALE = 32767.0f;
+const float INV_SNORM16_SCALE = 1.0f / 32767.0f;
+const float SQRT2 = 1.41421356237f;
+const float INV_SQRT2 = 0.70710678118f;
+const uint32 QUAT_COMPONENT_MASK = 0x7FFF;
+
+/*
+*/
+FORCEINLINE uint32
+floatBits(float value) {
+  uint32 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/*
+*/
+FORCEINLINE float
+bitsToFloat(uint32 bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/*
+*/
+FORCEINLINE float
+signNotZero(float value) {
+  return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+#if USING(CH_SIMD_SSE2)
+/*
+ * Float to half with round to nearest even, results are in the low 16 bits of each lane
+ * and sign extended so they can be narrowed with _mm_packs_epi32.
+ */
+FORCEINLINE __m128i
+floatToHalfSSE2(__m128 f) {
+  const __m128i signMask = _mm_set1_epi32(static_cast<int32>(0x80000000u));
+  const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+  const __m128i nanBit = _mm_set1_epi32(0x200);
+  const __m128i infinityHalf = _mm_set1_epi32(0x7C00);
+  const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+  const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+  const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+  const __m128 justSign = _mm_and_ps(_mm_castsi128_ps(signMask), f);
+  const __m128 absF = _mm_xor_ps(f, justSign);
+  const __m128i absBits = _mm_castps_si128(absF);
+
+  const __m128 isNan = _mm_cmpunord_ps(absF, absF);
+  const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absBits);
+  const __m128i infOrNan =
+      _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNan), nanBit), infinityHalf);
+
+  const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absBits);
+  const __m128 subnormal1 = _mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic));
+  const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormal1), subnormalMagic);
+
+  const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+  const __m128i rounded = _mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd);
+  const __m128i normal = _mm_srli_epi32(rounded, 13);
+
+  const __m128i nonSpecial = _mm_or_si128(_mm_and_si128(subnormal, isSubnormal),
+                                          _mm_andnot_si128(isSubnormal, normal));
+  const __m128i joined = _mm_or_si128(_mm_and_si128(nonSpecial, isRegular),
+                                      _mm_andnot_si128(isRegular, infOrNan));
+
+  return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+}
+
+/*
+ * Half to float, expects the halves zero extended in each 32 bit lane.
+ */
+FORCEINLINE __m128
+halfToFloatSSE2(__m128i h) {
+  const __m128i noSignMask = _mm_set1_epi32(0x7FFF);
+  const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+  const __m128i wasInfNan = _mm_set1_epi32(0x7BFF);
+  const __m128 infNanExponent = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+  const __m128i expMantissa = _mm_and_si128(noSignMask, h);
+  const __m128i justSign = _mm_xor_si128(h, expMantissa);
+  const __m128 scaled =
+      _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMantissa, 13)), magic);
+  const __m128i isInfNan = _mm_cmpgt_epi32(expMantissa, wasInfNan);
+  const __m128 signAndInf = _mm_or_ps(_mm_castsi128_ps(_mm_slli_epi32(justSign, 16)),
+                                      _mm_and_ps(_mm_castsi128_ps(isInfNan), infNanExponent));
+
+  return _mm_or_ps(scaled, signAndInf);
+}
+
+/*
+*/
+FORCEINLINE __m128i
+floatToSnorm16SSE2(__m128 f) {
+  const __m128 clamped = _mm_min_ps(_mm_max_ps(f, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+  return _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(SNORM16_SCALE)));
+}
+
+/*
+ * Expects the snorm16 values sign extended in each 32 bit lane.
+ */
+FORCEINLINE __m128
+snorm16ToFloatSSE2(__m128i v) {
+  const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(INV_SNORM16_SCALE));
+  return _mm_max_ps(f, _mm_set1_ps(-1.0f));
+}
+
+/*
+*/
+FORCEINLINE __m128
+absSSE2(__m128 v) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+/*
+*/
+FORCEINLINE __m128
+selectSSE2(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif // USING(CH_SIMD_SSE2)
+} // namespace
+
+/*
+*/
+uint16
+Quantization::floatToHalf(float value) {
+  const uint32 f32Infinity = 255u << 23;
+  const uint32 f16Max = (127u + 16u) << 23;
+  const uint32 denormalMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  uint32 bits = floatBits(value);
+  const uint32 sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32 result;
+  if (bits >= f16Max) {
+    result = bits > f32Infinity ? 0x7E00u : 0x7C00u;
+  }
+  else if (bits < (113u << 23)) {
+    const float denormal = bitsToFloat(bits) + bitsToFloat(denormalMagicBits);
+    result = floatBits(denormal) - denormalMagicBits;
+  }
+  else {
+    const uint32 mantissaOdd = (bits >> 13) & 1u;
+    bits += (static_cast<uint32>(15 - 127) << 23) + 0xFFFu;
+    bits += mantissaOdd;
+    result = bits >> 13;
+  }
+
+  return static_cast<uint16>(result | (sign >> 16));
+}
+
+/*
+*/
+float
+Quantization::halfToFloat(uint16 half) {
+  const uint32 shiftedExponent = 0x7C00u << 13;
+
+  uint32 bits = (half & 0x7FFFu) << 13;
+  const uint32 exponent = shiftedExponent & bits;
+  bits += (127u - 15u) << 23;
+
+  if (exponent == shiftedExponent) {
+    bits += (128u - 16u) << 23;
+  }
+  else if (exponent == 0) {
+    bits += 1u << 23;
+    bits = floatBits(bitsToFloat(bits) - bitsToFloat(113u << 23));
+  }
+
+  return bitsToFloat(bits | (static_cast<uint32>(half & 0x8000u) << 16));
+}
+
+/*
+*/
+int16
+Quantization::floatToSnorm16(float value) {
+  const float clamped = Math::min(Math::max(value, -1.0f), 1.0f);
+  return static_cast<int16>(std::lrintf(clamped * SNORM16_SCALE));
+}
+
+/*
+*/
+float
+Quantization::snorm16ToFloat(int16 value) {
+  return Math::max(static_cast<float>(value) * INV_SNORM16_SCALE, -1.0f);
+}
+
+/*
+*/
+OctahedralNormal
+Quantization::encodeOctahedral(const Vector3& unitVector) {
+  const float invL1 =
+      1.0f / (Math::abs(unitVector.x) + Math::abs(unitVector.y) + Math::abs(unitVector.z));
+  float px = unitVector.x * invL1;
+  float py = unitVector.y * invL1;
+
+  // Lower hemisphere folds over the diagonals.
+  if (unitVector.z < 0.0f) {
+    const float foldedX = (1.0f - Math::abs(py)) * signNotZero(px);
+    const float foldedY = (1.0f - Math::abs(px)) * signNotZero(py);
+    px = foldedX;
+    py = foldedY;
+  }
+
+  return {floatToSnorm16(px), floatToSnorm16(py)};
+}
+
+/*
+*/
+Vector3
+Quantization::decodeOctahedral(const OctahedralNormal& encoded) {
+  float x = snorm16ToFloat(encoded.x);
+  float y = snorm16ToFloat(encoded.y);
+  const float z = 1.0f - Math::abs(x) - Math::abs(y);
+  const float t = Math::max(-z, 0.0f);
+  x += x >= 0.0f ? -t : t;
+  y += y >= 0.0f ? -t : t;
+
+  const float length = std::sqrt(x * x + y * y + z * z);
+  return Vector3(x / length, y / length, z / length);
+}
+
+/*
+*/
+PackedQuaternion
+Quantization::packQuaternion(const Quaternion& q) {
+  const float components[4] = {q.x, q.y, q.z, q.w};
+
+  uint32 largest = 0;
+  for (uint32 i = 1; i < 4; ++i) {
+    if (Math::abs(components[i]) > Math::abs(components[largest])) {
+      largest = i;
+    }
+  }
+
+  // q and -q are the same rotation, flip so the dropped component is positive.
+  const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+  uint64 bits = largest;
+  for (uint32 i = 0; i < 4; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    const float normalized = components[i] * sign * SQRT2 * 0.5f + 0.5f;
+    const float clamped = Math::min(Math::max(normalized, 0.0f), 1.0f);
+    const uint32 quantized = static_cast<uint32>(std::lrintf(clamped * 32767.0f));
+    bits = (bits << 15) | (quantized & QUAT_COMPONENT_MASK);
+  }
+
+  PackedQuaternion packed;
+  packed.data[0] = static_cast<uint16>(bits >> 32);
+  packed.data[1] = static_cast<uint16>(bits >> 16);
+  packed.data[2] = static_cast<uint16>(bits);
+  return packed;
+}
+
+/*
+*/
+Quaternion
+Quantization::unpackQuaternion(const PackedQuaternion& packed) {
+  const uint64 bits = (static_cast<uint64>(packed.data[0]) << 32) |
+                      (static_cast<uint64>(packed.data[1]) << 16) |
+                      static_cast<uint64>(packed.data[2]);
+  const uint32 largest = static_cast<uint32>(bits >> 45) & 3u;
+
+  float components[4];
+  float sumSquares = 0.0f;
+  int32 shift = 30;
+  for (uint32 i = 0; i < 4; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    const uint32 quantized = static_cast<uint32>(bits >> shift) & QUAT_COMPONENT_MASK;
+    components[i] = (static_cast<float>(quantized) / 32767.0f * 2.0f - 1.0f) * INV_SQRT2;
+    sumSquares += components[i] * components[i];
+    shift -= 15;
+  }
+  components[largest] = std::sqrt(Math::max(0.0f, 1.0f - sumSquares));
+
+  return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+/*
+*/
+void
+Quantization::packHalf(const float* in, uint16* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    const __m128i halves = floatToHalfSSE2(_mm_loadu_ps(in + i));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(halves, halves));
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = floatToHalf(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::unpackHalf(const uint16* in, float* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 4 <= count; i += 4) {
+    const __m128i halves = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+    _mm_storeu_ps(out + i, halfToFloatSSE2(_mm_unpacklo_epi16(halves, zero)));
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = halfToFloat(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::packSnorm16(const float* in, int16* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i low = floatToSnorm16SSE2(_mm_loadu_ps(in + i));
+    const __m128i high = floatToSnorm16SSE2(_mm_loadu_ps(in + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(low, high));
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = floatToSnorm16(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::unpackSnorm16(const int16* in, float* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+    const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16);
+    _mm_storeu_ps(out + i, snorm16ToFloatSSE2(low));
+    _mm_storeu_ps(out + i + 4, snorm16ToFloatSSE2(high));
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = snorm16ToFloat(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::encodeOctahedral(const Vector3* in, OctahedralNormal* out, SIZE_T count) {
+  static_assert(sizeof(OctahedralNormal) == 4, "OctahedralNormal must be tightly packed");
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  for (; i + 4 <= count; i += 4) {
+    const Vector3* v = in + i;
+    const __m128 x = _mm_setr_ps(v[0].x, v[1].x, v[2].x, v[3].x);
+    const __m128 y = _mm_setr_ps(v[0].y, v[1].y, v[2].y, v[3].y);
+    const __m128 z = _mm_setr_ps(v[0].z, v[1].z, v[2].z, v[3].z);
+
+    const __m128 l1 = _mm_add_ps(_mm_add_ps(absSSE2(x), absSSE2(y)), absSSE2(z));
+    const __m128 invL1 = _mm_div_ps(one, l1);
+    const __m128 px = _mm_mul_ps(x, invL1);
+    const __m128 py = _mm_mul_ps(y, invL1);
+
+    const __m128 signX = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(px, zero), signMask), one);
+    const __m128 signY = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(py, zero), signMask), one);
+    const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, absSSE2(py)), signX);
+    const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, absSSE2(px)), signY);
+
+    const __m128 lowerHemisphere = _mm_cmplt_ps(z, zero);
+    const __m128i qx = floatToSnorm16SSE2(selectSSE2(lowerHemisphere, foldedX, px));
+    const __m128i qy = floatToSnorm16SSE2(selectSSE2(lowerHemisphere, foldedY, py));
+
+    // x0..x3 y0..y3 -> x0 y0 x1 y1 x2 y2 x3 y3
+    const __m128i packed = _mm_packs_epi32(qx, qy);
+    const __m128i interleaved = _mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), interleaved);
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = encodeOctahedral(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::decodeOctahedral(const OctahedralNormal* in, Vector3* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128 x = snorm16ToFloatSSE2(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16));
+    __m128 y = snorm16ToFloatSSE2(_mm_srai_epi32(packed, 16));
+    const __m128 z = _mm_sub_ps(_mm_sub_ps(one, absSSE2(x)), absSSE2(y));
+    const __m128 t = _mm_max_ps(_mm_xor_ps(z, signMask), zero);
+    const __m128 negT = _mm_xor_ps(t, signMask);
+    x = _mm_add_ps(x, selectSSE2(_mm_cmpge_ps(x, zero), negT, t));
+    y = _mm_add_ps(y, selectSSE2(_mm_cmpge_ps(y, zero), negT, t));
+
+    const __m128 length = _mm_sqrt_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+    alignas(16) float rx[4], ry[4], rz[4];
+    _mm_store_ps(rx, _mm_div_ps(x, length));
+    _mm_store_ps(ry, _mm_div_ps(y, length));
+    _mm_store_ps(rz, _mm_div_ps(z, length));
+    for (uint32 j = 0; j < 4; ++j) {
+      out[i + j] = Vector3(rx[j], ry[j], rz[j]);
+    }
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = decodeOctahedral(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::packQuaternions(const Quaternion* in, PackedQuaternion* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  const __m128i mask16 = _mm_set1_epi32(0xFFFF);
+  for (; i + 4 <= count; i += 4) {
+    const Quaternion* q = in + i;
+    const __m128 components[4] = {_mm_setr_ps(q[0].x, q[1].x, q[2].x, q[3].x),
+                                  _mm_setr_ps(q[0].y, q[1].y, q[2].y, q[3].y),
+                                  _mm_setr_ps(q[0].z, q[1].z, q[2].z, q[3].z),
+                                  _mm_setr_ps(q[0].w, q[1].w, q[2].w, q[3].w)};
+
+    // Strictly greater, so ties keep the lowest index like the scalar path
+    __m128 largestAbs = absSSE2(components[0]);
+    __m128 largestValue = components[0];
+    __m128i largest = _mm_setzero_si128();
+    for (int32 c = 1; c < 4; ++c) {
+      const __m128 absC = absSSE2(components[c]);
+      const __m128 greater = _mm_cmpgt_ps(absC, largestAbs);
+      largestAbs = selectSSE2(greater, absC, largestAbs);
+      largestValue = selectSSE2(greater, components[c], largestValue);
+      largest = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(greater), largest),
+                             _mm_and_si128(_mm_castps_si128(greater), _mm_set1_epi32(c)));
+    }
+    const __m128 sign =
+        _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(largestValue, zero), signMask), one);
+
+    __m128i quantized[4];
+    for (int32 c = 0; c < 4; ++c) {
+      const __m128 scaled = _mm_mul_ps(_mm_mul_ps(components[c], sign), _mm_set1_ps(SQRT2));
+      const __m128 normalized = _mm_add_ps(_mm_mul_ps(scaled, half), half);
+      const __m128 clamped = _mm_min_ps(_mm_max_ps(normalized, zero), one);
+      quantized[c] = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(32767.0f)));
+    }
+
+    // The three kept components in index order, skipping the largest
+    const __m128i isLargest0 = _mm_cmpeq_epi32(largest, _mm_setzero_si128());
+    const __m128i isLargest3 = _mm_cmpeq_epi32(largest, _mm_set1_epi32(3));
+    const __m128i belowTwo = _mm_cmplt_epi32(largest, _mm_set1_epi32(2));
+    const __m128i a = _mm_or_si128(_mm_and_si128(isLargest0, quantized[1]),
+                                   _mm_andnot_si128(isLargest0, quantized[0]));
+    const __m128i b = _mm_or_si128(_mm_and_si128(belowTwo, quantized[2]),
+                                   _mm_andnot_si128(belowTwo, quantized[1]));
+    const __m128i c = _mm_or_si128(_mm_and_si128(isLargest3, quantized[2]),
+                                   _mm_andnot_si128(isLargest3, quantized[3]));
+
+    // largest << 45 | a << 30 | b << 15 | c, split in three 16 bit words
+    alignas(16) uint32 words[3][4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(words[0]),
+                    _mm_or_si128(_mm_slli_epi32(largest, 13), _mm_srli_epi32(a, 2)));
+    _mm_store_si128(reinterpret_cast<__m128i*>(words[1]),
+                    _mm_and_si128(_mm_or_si128(_mm_slli_epi32(a, 14), _mm_srli_epi32(b, 1)),
+                                  mask16));
+    _mm_store_si128(reinterpret_cast<__m128i*>(words[2]),
+                    _mm_and_si128(_mm_or_si128(_mm_slli_epi32(b, 15), c), mask16));
+    for (uint32 j = 0; j < 4; ++j) {
+      out[i + j].data[0] = static_cast<uint16>(words[0][j]);
+      out[i + j].data[1] = static_cast<uint16>(words[1][j]);
+      out[i + j].data[2] = static_cast<uint16>(words[2][j]);
+    }
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = packQuaternion(in[i]);
+  }
+}
+
+/*
+*/
+void
+Quantization::unpackQuaternions(const PackedQuaternion* in, Quaternion* out, SIZE_T count) {
+  SIZE_T i = 0;
+#if USING(CH_SIMD_SSE2)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128i componentMask = _mm_set1_epi32(static_cast<int32>(QUAT_COMPONENT_MASK));
+  for (; i + 4 <= count; i += 4) {
+    const PackedQuaternion* p = in + i;
+    const __m128i word0 =
+        _mm_setr_epi32(p[0].data[0], p[1].data[0], p[2].data[0], p[3].data[0]);
+    const __m128i word1 =
+        _mm_setr_epi32(p[0].data[1], p[1].data[1], p[2].data[1], p[3].data[1]);
+    const __m128i word2 =
+        _mm_setr_epi32(p[0].data[2], p[1].data[2], p[2].data[2], p[3].data[2]);
+
+    const __m128i largest = _mm_and_si128(_mm_srli_epi32(word0, 13), _mm_set1_epi32(3));
+    const __m128i quantized[3] = {
+        _mm_and_si128(_mm_or_si128(_mm_slli_epi32(word0, 2), _mm_srli_epi32(word1, 14)),
+                      componentMask),
+        _mm_and_si128(_mm_or_si128(_mm_slli_epi32(word1, 1), _mm_srli_epi32(word2, 15)),
+                      componentMask),
+        _mm_and_si128(word2, componentMask)};
+
+    // Same operation order as the scalar path, the division is not replaced by a product
+    __m128 kept[3];
+    for (int32 k = 0; k < 3; ++k) {
+      const __m128 unit = _mm_div_ps(_mm_cvtepi32_ps(quantized[k]), _mm_set1_ps(32767.0f));
+      kept[k] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(unit, _mm_set1_ps(2.0f)), one),
+                           _mm_set1_ps(INV_SQRT2));
+    }
+    const __m128 sumSquares = _mm_add_ps(_mm_add_ps(_mm_mul_ps(kept[0], kept[0]),
+                                                    _mm_mul_ps(kept[1], kept[1])),
+                                         _mm_mul_ps(kept[2], kept[2]));
+    const __m128 rebuilt = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, sumSquares), zero));
+
+    const __m128 isLargest[4] = {
+        _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_setzero_si128())),
+        _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1))),
+        _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2))),
+        _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)))};
+    const __m128 belowTwo = _mm_castsi128_ps(_mm_cmplt_epi32(largest, _mm_set1_epi32(2)));
+
+    alignas(16) float components[4][4];
+    _mm_store_ps(components[0], selectSSE2(isLargest[0], rebuilt, kept[0]));
+    _mm_store_ps(components[1], selectSSE2(isLargest[1], rebuilt,
+                                           selectSSE2(isLargest[0], kept[0], kept[1])));
+    _mm_store_ps(components[2], selectSSE2(isLargest[2], rebuilt,
+                                           selectSSE2(belowTwo, kept[1], kept[2])));
+    _mm_store_ps(components[3], selectSSE2(isLargest[3], rebuilt, kept[2]));
+    for (uint32 j = 0; j < 4; ++j) {
+      out[i + j] = Quaternion(components[0][j], components[1][j], components[2][j],
+                              components[3][j]);
+    }
+  }
+#endif // USING(CH_SIMD_SSE2)
+  for (; i < count; ++i) {
+    out[i] = unpackQuaternion(in[i]);
+  }
+}
+} // namespace chEngineSDK
@@ -0,0 +1,163 @@
+/************************************************************************/
+/**
+ * @file chQuantization.h
+ * @author AccelMR
+ * @date 2025/07/20
+ * @brief Compact representations of floats, unit vectors and rotations.
+ *
+ * Half floats, snorm16 values, octahedral encoded unit vectors and smallest-three
+ * quaternions. Every type has a scalar conversion and a batch conversion that uses SSE2
+ * when CH_SIMD_SSE2 is set; both paths produce bit identical results.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chQuaternion.h"
+#include "chVector3.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     IEEE 754 binary16 float. Conversions round to nearest even, overflow goes to infinity.
+ *
+ * Sample usage:
+ *  Half h(0.5f);
+ *  float f = h.toFloat();
+ */
+struct Half
+{
+  Half() = default;
+
+  explicit Half(float value);
+
+  NODISCARD float
+  toFloat() const;
+
+  uint16 bits;
+};
+
+/*
+ * Description:
+ *     Unit vector stored as the two snorm16 coordinates of its projection onto an
+ *     octahedron. 4 bytes instead of 12 with a max error around 0.01 degrees.
+ */
+struct OctahedralNormal
+{
+  int16 x;
+  int16 y;
+};
+
+/*
+ * Description:
+ *     Unit quaternion stored with the smallest-three method in 48 bits.
+ *     The largest component is dropped and rebuilt from the unit length constraint, the
+ *     other three are stored in 15 bits each and the dropped index in the remaining 2 bits.
+ */
+struct PackedQuaternion
+{
+  uint16 data[3];
+};
+
+/*
+ * Description:
+ *     Pack/unpack routines for quantized math types.
+ */
+class CH_UTILITY_EXPORT Quantization
+{
+ public:
+  /************************************************************************/
+  /*
+   * Scalar conversions.
+   */
+  /************************************************************************/
+
+  NODISCARD static uint16
+  floatToHalf(float value);
+
+  NODISCARD static float
+  halfToFloat(uint16 half);
+
+  /**
+   *   Clamps to [-1, 1] and rounds to the nearest of 65535 steps.
+   **/
+  NODISCARD static int16
+  floatToSnorm16(float value);
+
+  NODISCARD static float
+  snorm16ToFloat(int16 value);
+
+  /**
+   *   Encodes a normalized vector, non unit vectors are normalized by the projection.
+   **/
+  NODISCARD static OctahedralNormal
+  encodeOctahedral(const Vector3& unitVector);
+
+  NODISCARD static Vector3
+  decodeOctahedral(const OctahedralNormal& encoded);
+
+  /**
+   *   Encodes a normalized quaternion. q and -q are the same rotation so the sign of the
+   *   result may differ from the input.
+   **/
+  NODISCARD static PackedQuaternion
+  packQuaternion(const Quaternion& q);
+
+  NODISCARD static Quaternion
+  unpackQuaternion(const PackedQuaternion& packed);
+
+  /************************************************************************/
+  /*
+   * Batch conversions.
+   */
+  /************************************************************************/
+
+  static void
+  packHalf(const float* in, uint16* out, SIZE_T count);
+
+  static void
+  unpackHalf(const uint16* in, float* out, SIZE_T count);
+
+  static void
+  packSnorm16(const float* in, int16* out, SIZE_T count);
+
+  static void
+  unpackSnorm16(const int16* in, float* out, SIZE_T count);
+
+  static void
+  encodeOctahedral(const Vector3* in, OctahedralNormal* out, SIZE_T count);
+
+  static void
+  decodeOctahedral(const OctahedralNormal* in, Vector3* out, SIZE_T count);
+
+  static void
+  packQuaternions(const Quaternion* in, PackedQuaternion* out, SIZE_T count);
+
+  static void
+  unpackQuaternions(const PackedQuaternion* in, Quaternion* out, SIZE_T count);
+};
+
+/************************************************************************/
+/*
+ * Implementation
+ */
+/************************************************************************/
+
+/*
+*/
+FORCEINLINE
+Half::Half(float value) : bits(Quantization::floatToHalf(value)) {}
+
+/*
+*/
+FORCEINLINE float
+Half::toFloat() const {
+  return Quantization::halfToFloat(bits);
+}
+} // namespace chEngineSDK
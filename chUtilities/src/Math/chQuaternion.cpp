@@ -17,9 +17,6 @@
 
 namespace chEngineSDK {
 
-// Static identity quaternion definition
-const Quaternion Quaternion::IDENTITY = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
-
 /*
  * Construct a quaternion from an axis and angle
  */
@@ -39,18 +39,19 @@ class CH_UTILITY_EXPORT Quaternion
   /*
    * @brief Default constructor
    */
+  FORCEINLINE constexpr
   Quaternion();
 
   /**
    * @brief Copy constructor
    */
-  FORCEINLINE
+  FORCEINLINE constexpr
   Quaternion(const Quaternion& q);
 
   /**
    * @brief Constructor with 4 components (x, y, z, w)
    */
-  FORCEINLINE
+  FORCEINLINE constexpr
   Quaternion(float _x, float _y, float _z, float _w);
 
   /**
@@ -90,7 +91,7 @@ class CH_UTILITY_EXPORT Quaternion
   /**
    * @brief Normalizes this quaternion
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   normalize();
 
   /**
@@ -98,13 +99,13 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return Quaternion The new quaternion created
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   getNormalized() const;
 
   /**
    * @brief Conjugates this quaternion (negates the vector part)
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   conjugate();
 
   /**
@@ -120,14 +121,14 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return Quaternion New quaternion created from this
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   getConjugated() const;
 
   /**
    * @brief Checks if this quaternion is valid and has no NaNs
    * NOTE: If this quaternion has any NaN value, it'll be converted to IDENTITY
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   diagnosticCheckNaN() const;
 
   /**
@@ -135,7 +136,7 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return bool True if this quaternion has an invalid component
    */
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   containsNaN() const;
 
   /**
@@ -145,7 +146,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param threshold The range of acceptance to compare
    * @return bool True if quaternions are nearly equal
    */
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   nearEqual(const Quaternion& q, float threshold = Math::SMALL_NUMBER) const;
 
   /**
@@ -171,7 +172,7 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return float Squared length of the quaternion
    */
-  NODISCARD FORCEINLINE float
+  NODISCARD FORCEINLINE constexpr float
   squaredLength() const;
 
   /**
@@ -179,7 +180,7 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return float Length of the quaternion
    */
-  NODISCARD FORCEINLINE float
+  NODISCARD FORCEINLINE constexpr float
   length() const;
 
   /**
@@ -187,7 +188,7 @@ class CH_UTILITY_EXPORT Quaternion
    *
    * @return Quaternion The inverse quaternion
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   getInverse() const;
 
   /************************************************************************/
@@ -202,7 +203,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param q The quaternion to copy
    * @return Quaternion& Reference to this
    */
-  FORCEINLINE Quaternion&
+  FORCEINLINE constexpr Quaternion&
   operator=(const Quaternion& q);
 
   /**
@@ -211,7 +212,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param q The quaternion to check against
    * @return bool True if both quaternions are the same
    */
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   operator==(const Quaternion& q) const;
 
   /**
@@ -220,7 +221,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param scalar The scalar to be multiplied
    * @return Quaternion New quaternion multiplied by the scalar
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   operator*(float scalar) const;
 
   /**
@@ -229,7 +230,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param scalar The scalar to be multiplied
    * @return Quaternion& Reference to this
    */
-  FORCEINLINE Quaternion&
+  FORCEINLINE constexpr Quaternion&
   operator*=(float scalar);
 
   /**
@@ -238,7 +239,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param q The quaternion to be multiplied
    * @return Quaternion New quaternion from multiplication
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   operator*(const Quaternion& q) const;
 
   /**
@@ -247,7 +248,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param q The quaternion to be multiplied
    * @return Quaternion& Reference to this
    */
-  FORCEINLINE Quaternion&
+  FORCEINLINE constexpr Quaternion&
   operator*=(const Quaternion& q);
 
   /**
@@ -256,7 +257,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param q The quaternion to add
    * @return Quaternion Result of addition
    */
-  NODISCARD FORCEINLINE Quaternion
+  NODISCARD FORCEINLINE constexpr Quaternion
   operator+(const Quaternion& q) const;
 
   /**
@@ -265,7 +266,7 @@ class CH_UTILITY_EXPORT Quaternion
    * @param index Index (0-3 for x,y,z,w)
    * @return float& Reference to the component
    */
-  NODISCARD FORCEINLINE float&
+  NODISCARD FORCEINLINE constexpr float&
   operator[](int32 index);
 
   /**
@@ -274,10 +275,10 @@ class CH_UTILITY_EXPORT Quaternion
    * @param index Index (0-3 for x,y,z,w)
    * @return const float& Reference to the component
    */
-  NODISCARD FORCEINLINE const float&
+  NODISCARD FORCEINLINE constexpr const float&
   operator[](int32 index) const;
 
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   isRotationEqual(const Quaternion& q, float tolerance = Math::SMALL_NUMBER) const;
 
  public:
@@ -307,26 +308,26 @@ class CH_UTILITY_EXPORT Quaternion
 
 /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Quaternion::Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
 
 /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Quaternion::Quaternion(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {
   diagnosticCheckNaN();
 }
 
 /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Quaternion::Quaternion(const Quaternion& q) : x(q.x), y(q.y), z(q.z), w(q.w) {
   diagnosticCheckNaN();
 }
 
 /*
  */
-FORCEINLINE Quaternion&
+FORCEINLINE constexpr Quaternion&
 Quaternion::operator=(const Quaternion& q) {
   x = q.x;
   y = q.y;
@@ -337,7 +338,7 @@ Quaternion::operator=(const Quaternion& q) {
 
 /*
  */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Quaternion::nearEqual(const Quaternion& q, const float threshold) const {
   return (Math::abs(q.x - x) <= threshold) && (Math::abs(q.y - y) <= threshold) &&
          (Math::abs(q.z - z) <= threshold) && (Math::abs(q.w - w) <= threshold);
@@ -345,21 +346,21 @@ Quaternion::nearEqual(const Quaternion& q, const float threshold) const {
 
 /*
  */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Quaternion::operator==(const Quaternion& q) const {
   return nearEqual(q, 0.0f);
 }
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::operator*(float scalar) const {
   return Quaternion(x * scalar, y * scalar, z * scalar, w * scalar);
 }
 
 /*
  */
-FORCEINLINE Quaternion&
+FORCEINLINE constexpr Quaternion&
 Quaternion::operator*=(float scalar) {
   x *= scalar;
   y *= scalar;
@@ -370,7 +371,7 @@ Quaternion::operator*=(float scalar) {
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::operator*(const Quaternion& q) const {
   return Quaternion(
       w * q.x + x * q.w + y * q.z - z * q.y,
@@ -381,7 +382,7 @@ Quaternion::operator*(const Quaternion& q) const {
 
 /*
  */
-FORCEINLINE Quaternion&
+FORCEINLINE constexpr Quaternion&
 Quaternion::operator*=(const Quaternion& q) {
   const float newX = w * q.x + x * q.w + y * q.z - z * q.y;
   const float newY = w * q.y - x * q.z + y * q.w + z * q.x;
@@ -398,14 +399,14 @@ Quaternion::operator*=(const Quaternion& q) {
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::operator+(const Quaternion& q) const {
   return Quaternion(x + q.x, y + q.y, z + q.z, w + q.w);
 }
 
 /*
  */
-FORCEINLINE float&
+FORCEINLINE constexpr float&
 Quaternion::operator[](int32 index) {
   CH_ASSERT(index >= 0 && index < 4);
   return (&x)[index];
@@ -413,7 +414,7 @@ Quaternion::operator[](int32 index) {
 
 /*
  */
-FORCEINLINE const float&
+FORCEINLINE constexpr const float&
 Quaternion::operator[](int32 index) const {
   CH_ASSERT(index >= 0 && index < 4);
   return (&x)[index];
@@ -421,21 +422,21 @@ Quaternion::operator[](int32 index) const {
 
 /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Quaternion::squaredLength() const {
   return x * x + y * y + z * z + w * w;
 }
 
 /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Quaternion::length() const {
   return Math::sqrt(squaredLength());
 }
 
 /*
  */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Quaternion::normalize() {
   const float len = length();
   if (len > Math::SMALL_NUMBER) {
@@ -452,7 +453,7 @@ Quaternion::normalize() {
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::getNormalized() const {
   Quaternion result = *this;
   result.normalize();
@@ -461,7 +462,7 @@ Quaternion::getNormalized() const {
 
 /*
  */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Quaternion::conjugate() {
   x = -x;
   y = -y;
@@ -470,14 +471,14 @@ Quaternion::conjugate() {
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::getConjugated() const {
   return Quaternion(-x, -y, -z, w);
 }
 
 /*
  */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Quaternion::diagnosticCheckNaN() const {
 #if USING(CH_DEBUG_MODE)
   if (containsNaN()) {
@@ -488,7 +489,7 @@ Quaternion::diagnosticCheckNaN() const {
 
 /*
  */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Quaternion::containsNaN() const {
   return (!Math::isFinite(x) || !Math::isFinite(y) || !Math::isFinite(z) ||
           !Math::isFinite(w));
@@ -496,7 +497,7 @@ Quaternion::containsNaN() const {
 
 /*
  */
-FORCEINLINE Quaternion
+FORCEINLINE constexpr Quaternion
 Quaternion::getInverse() const {
   const float squareSum = squaredLength();
   if (squareSum >= Math::SMALL_NUMBER) {
@@ -510,11 +511,18 @@ Quaternion::getInverse() const {
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Quaternion::isRotationEqual(const Quaternion& q, float tolerance) const {
   // Two quaternions represent the same rotation if their dot product
   // is close to 1.0 or -1.0
   float dotProduct = x * q.x + y * q.y + z * q.z + w * q.w;
   return (Math::abs(dotProduct) >= (1.0f - tolerance));
 }
+
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Quaternion Quaternion::IDENTITY = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
 } // namespace chEngineSDK
@@ -38,14 +38,6 @@ Radian::operator=(const Degree& degree)
   return *this;
 }
 
-/*
-*/
-float
-Radian::valueDegree() const
-{
-  return m_radian * Math::RAD2DEG;
-}
-
 /*
 */
 void
@@ -20,6 +20,8 @@
  /************************************************************************/
 #include "chPrerequisitesUtilities.h"
 
+#include "chPlatformMath.h"
+
 namespace chEngineSDK {
 /**
  *   Radian class that could be converted to degree easy.
@@ -50,7 +52,7 @@ public:
    * @param radian
    *   Float radian angle value.
    */
-  explicit Radian(float _radian) : m_radian(_radian)
+  explicit constexpr Radian(float _radian) : m_radian(_radian)
   {}
 
   /**
@@ -87,7 +89,7 @@ public:
    * @return
    *   Modify this radian with given value.
    */
-  FORCEINLINE Radian&
+  FORCEINLINE constexpr Radian&
   operator=(float radian);
 
 
@@ -97,7 +99,7 @@ public:
    * @return
    *   This Radian as degree.
    */
-  float
+  FORCEINLINE constexpr float
   valueDegree() const;
 
   /**
@@ -106,7 +108,7 @@ public:
    * @return
    *   Radian raw value.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   valueRadian() const;
 
   /**
@@ -139,7 +141,7 @@ public:
    * @return
    *   Creates a new Radian depending on overload action.
    */
-  FORCEINLINE Radian
+  FORCEINLINE constexpr Radian
   operator+(const Radian& radian) const;
 
   /**
@@ -163,7 +165,7 @@ public:
    * @return
    *   Modify this Radian depending on overload action.
    */
-  FORCEINLINE Radian&
+  FORCEINLINE constexpr Radian&
   operator+=(const Radian& radian);
 
   /**
@@ -184,7 +186,7 @@ public:
    * @return
    *   Creates a new Radian depending on overload action.
    */
-  FORCEINLINE Radian
+  FORCEINLINE constexpr Radian
   operator-() const;
 
   /**
@@ -196,7 +198,7 @@ public:
    * @return
    *   Creates a new Radian depending on overload action.
    */
-  FORCEINLINE Radian
+  FORCEINLINE constexpr Radian
   operator-(const Radian& radian) const;
 
   /**
@@ -217,7 +219,7 @@ public:
    * @param degree
    *   Degree to be subtracted.
    */
-  FORCEINLINE Radian&
+  FORCEINLINE constexpr Radian&
   operator-=(const Radian& radian);
 
   /**
@@ -241,7 +243,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<(const Radian& radian) const;
 
   /**
@@ -253,7 +255,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>(const Radian& radian) const;
 
   /**
@@ -265,7 +267,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<=(const Radian& radian) const;
 
   /**
@@ -277,7 +279,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>=(const Radian& radian) const;
 
   /**
@@ -289,7 +291,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Radian& radian) const;
 
   /**
@@ -301,7 +303,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(const Radian& radian) const;
 
   /**
@@ -313,7 +315,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<(float radian) const;
 
   /**
@@ -325,7 +327,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>(float radian) const;
 
   /**
@@ -337,7 +339,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator<=(float radian) const;
 
   /**
@@ -349,7 +351,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator>=(float radian) const;
 
   /**
@@ -361,7 +363,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(float radian) const;
 
   /**
@@ -373,7 +375,7 @@ public:
    * @return
    *   Compares this Radian against given value.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(float radian) const;
 
   /**
@@ -479,7 +481,7 @@ private:
  * @return
   *    Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator<(float floatRadian, const Radian& radian);
 
   /**
@@ -494,7 +496,7 @@ private:
    * @return
    *   Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator>(float floatRadian, const Radian& radian);
 
   /**
@@ -509,7 +511,7 @@ private:
    * @return
    *   Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator<=(float floatRadian, const Radian& radian);
 
   /**
@@ -523,7 +525,7 @@ private:
    *
    * @return Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator>=(float floatRadian, const Radian& radian);
 
   /**
@@ -538,7 +540,7 @@ private:
    * @return
    *   Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator==(float floatRadian, const Radian& radian);
 
   /**
@@ -553,7 +555,7 @@ private:
    * @return
    *   Compares a float against given Radian.
    */
-  FORCEINLINE friend bool
+  FORCEINLINE constexpr friend bool
   operator!=(float floatRadian, const Radian& radian);
 
 
@@ -572,7 +574,7 @@ private:
 
  /*
  */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Radian::valueRadian() const
 {
   return m_radian;
@@ -580,7 +582,15 @@ Radian::valueRadian() const
 
 /*
 */
-FORCEINLINE Radian&
+FORCEINLINE constexpr float
+Radian::valueDegree() const
+{
+  return m_radian * PlatformMath::RAD2DEG;
+}
+
+/*
+*/
+FORCEINLINE constexpr Radian&
 Radian::operator=(float radian)
 {
   m_radian = radian;
@@ -589,7 +599,7 @@ Radian::operator=(float radian)
 
 /*
  */
-FORCEINLINE Radian
+FORCEINLINE constexpr Radian
 Radian::operator+(const Radian& radian) const
 {
   return Radian(m_radian + radian.m_radian);
@@ -597,7 +607,7 @@ Radian::operator+(const Radian& radian) const
 
 /*
 */
-FORCEINLINE Radian&
+FORCEINLINE constexpr Radian&
 Radian::operator+=(const Radian& radian)
 {
   m_radian += radian.m_radian;
@@ -606,7 +616,7 @@ Radian::operator+=(const Radian& radian)
 
 /*
 */
-FORCEINLINE Radian
+FORCEINLINE constexpr Radian
 Radian::operator-() const
 {
   return Radian(-m_radian);
@@ -614,7 +624,7 @@ Radian::operator-() const
 
 /*
 */
-FORCEINLINE Radian
+FORCEINLINE constexpr Radian
 Radian::operator-(const Radian& radian) const
 {
   return Radian(m_radian - radian.m_radian);
@@ -622,7 +632,7 @@ Radian::operator-(const Radian& radian) const
 
 /*
 */
-FORCEINLINE Radian&
+FORCEINLINE constexpr Radian&
 Radian::operator-=(const Radian& radian)
 {
   m_radian -= radian.m_radian;
@@ -631,7 +641,7 @@ Radian::operator-=(const Radian& radian)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator<(const Radian& radian) const
 {
   return m_radian < radian.m_radian;
@@ -639,7 +649,7 @@ Radian::operator<(const Radian& radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator<(float radian) const
 {
   return m_radian < radian;
@@ -647,7 +657,7 @@ Radian::operator<(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator>(const Radian& radian) const
 {
   return m_radian > radian.m_radian;
@@ -655,7 +665,7 @@ Radian::operator>(const Radian& radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator>=(const Radian& radian) const
 {
   return m_radian >= radian.m_radian;
@@ -663,7 +673,7 @@ Radian::operator>=(const Radian& radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator>(float radian) const
 {
   return m_radian > radian;
@@ -671,7 +681,7 @@ Radian::operator>(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator>=(float radian) const
 {
   return m_radian >= radian;
@@ -679,7 +689,7 @@ Radian::operator>=(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator!=(float radian) const
 {
   return m_radian != radian;
@@ -687,7 +697,7 @@ Radian::operator!=(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator==(float radian) const
 {
   return m_radian == radian;
@@ -695,7 +705,7 @@ Radian::operator==(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator<=(float radian) const
 {
   return m_radian <= radian;
@@ -703,7 +713,7 @@ Radian::operator<=(float radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator==(const Radian& radian) const
 {
   return m_radian == radian.m_radian;
@@ -711,14 +721,14 @@ Radian::operator==(const Radian& radian) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator!=(const Radian& radian) const
 {
   return m_radian != radian.m_radian;
 }
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Radian::operator<=(const Radian& radian) const
 {
   return m_radian <= radian.m_radian;
@@ -726,7 +736,7 @@ Radian::operator<=(const Radian& radian) const
 
 /*
 */
-FORCEINLINE  bool
+FORCEINLINE constexpr bool
 operator<(float floatRadian, const Radian& radian)
 {
   return floatRadian < radian.m_radian;
@@ -734,7 +744,7 @@ operator<(float floatRadian, const Radian& radian)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator>(float floatRadian, const Radian& radian)
 {
   return floatRadian > radian.m_radian;
@@ -742,7 +752,7 @@ operator>(float floatRadian, const Radian& radian)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator>=(float floatRadian, const Radian& radian)
 {
   return floatRadian >= radian.m_radian;
@@ -750,14 +760,14 @@ operator>=(float floatRadian, const Radian& radian)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator<=(float floatRadian, const Radian& radian)
 {
   return floatRadian <= radian.m_radian;
 }
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator!=(float floatRadian, const Radian& radian)
 {
   return floatRadian != radian.m_radian;
@@ -765,7 +775,7 @@ operator!=(float floatRadian, const Radian& radian)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 operator==(float floatRadian, const Radian& radian)
 {
   return floatRadian == radian.m_radian;
@@ -15,6 +15,12 @@
 /************************************************************************/
 #include "chRandom.h"
 
+#include "chMath.h"
+
+#if USING(CH_SIMD_SSE2)
+#include <emmintrin.h>
+#endif // USING(CH_SIMD_SSE2)
+
 namespace chEngineSDK {
 /************************************************************************/
 /*
@@ -24,7 +30,400 @@ namespace chEngineSDK {
 const uint32 Random::A = 24589395;
 
 const uint32 Random::C = 72790363;
+
+const float RandomStream::FLOAT_UNIT = 1.0f / 16777216.0f;
+
+namespace {
+/**
+ *  xoshiro128 jump polynomials, equivalent to 2^64 and 2^96 calls to next().
+ */
+const uint32 JUMP_POLYNOMIAL[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+const uint32 LONG_JUMP_POLYNOMIAL[4] = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+
+/**
+ *  Amount of values generated on the stack before being transformed by the shaped fills.
+ */
+constexpr SIZE_T FILL_CHUNK = 64;
+
+/*
+*/
+FORCEINLINE uint64
+splitMix64(uint64& x) {
+  uint64 z = (x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
 }
 
+/*
+*/
+FORCEINLINE Vector3
+unitVectorFrom01(float u, float v) {
+  const float z = 1.0f - 2.0f * u;
+  const float r = Math::sqrt(Math::max(0.0f, 1.0f - z * z));
+  float sinPhi, cosPhi;
+  Math::sin_cos(&sinPhi, &cosPhi, Math::TWO_PI * v);
+  return Vector3(r * cosPhi, r * sinPhi, z);
+}
 
+#if USING(CH_SIMD_SSE2)
+/*
+ * Four xoshiro128++ generators advanced in lockstep, one per SSE lane.
+ */
+struct LanesSSE2
+{
+  explicit FORCEINLINE
+  LanesSSE2(uint32 lanes[4][4])
+    : s0(_mm_load_si128(reinterpret_cast<const __m128i*>(lanes[0]))),
+      s1(_mm_load_si128(reinterpret_cast<const __m128i*>(lanes[1]))),
+      s2(_mm_load_si128(reinterpret_cast<const __m128i*>(lanes[2]))),
+      s3(_mm_load_si128(reinterpret_cast<const __m128i*>(lanes[3]))) {}
+
+  FORCEINLINE void
+  store(uint32 lanes[4][4]) const {
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), s0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), s1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[2]), s2);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[3]), s3);
+  }
+
+  FORCEINLINE static __m128i
+  rotl(__m128i x, int32 k) {
+    return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+  }
+
+  FORCEINLINE __m128i
+  next() {
+    const __m128i result = _mm_add_epi32(rotl(_mm_add_epi32(s0, s3), 7), s0);
+    const __m128i t = _mm_slli_epi32(s1, 9);
+
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = rotl(s3, 11);
 
+    return result;
+  }
+
+  __m128i s0, s1, s2, s3;
+};
+#endif // USING(CH_SIMD_SSE2)
+} // namespace
+
+/*
+*/
+RandomStream::RandomStream(uint64 seed) {
+  setSeed(seed);
+}
+
+/*
+*/
+void
+RandomStream::setSeed(uint64 seed) {
+  const uint64 a = splitMix64(seed);
+  const uint64 b = splitMix64(seed);
+  m_state[0] = static_cast<uint32>(a);
+  m_state[1] = static_cast<uint32>(a >> 32);
+  m_state[2] = static_cast<uint32>(b);
+  m_state[3] = static_cast<uint32>(b >> 32);
+
+  initLanes();
+}
+
+/*
+*/
+void
+RandomStream::initLanes() {
+  uint32 saved[4] = {m_state[0], m_state[1], m_state[2], m_state[3]};
+
+  for (uint32 lane = 0; lane < 4; ++lane) {
+    applyJump(LONG_JUMP_POLYNOMIAL);
+    for (uint32 word = 0; word < 4; ++word) {
+      m_lanes[word][lane] = m_state[word];
+    }
+  }
+
+  std::memcpy(m_state, saved, sizeof(m_state));
+  m_leftoverBegin = 4;
+}
+
+/*
+*/
+void
+RandomStream::nextLanes(uint32 out[4]) {
+  for (uint32 lane = 0; lane < 4; ++lane) {
+    const uint32 s0 = m_lanes[0][lane];
+    const uint32 s1 = m_lanes[1][lane];
+    const uint32 s2 = m_lanes[2][lane] ^ s0;
+    const uint32 s3 = m_lanes[3][lane] ^ s1;
+
+    out[lane] = rotl(s0 + m_lanes[3][lane], 7) + s0;
+
+    m_lanes[1][lane] = s1 ^ s2;
+    m_lanes[0][lane] = s0 ^ s3;
+    m_lanes[2][lane] = s2 ^ (s1 << 9);
+    m_lanes[3][lane] = rotl(s3, 11);
+  }
+}
+
+/*
+*/
+SIZE_T
+RandomStream::takeLeftover(uint32* out, SIZE_T count) {
+  const SIZE_T taken = Math::min(count, static_cast<SIZE_T>(4 - m_leftoverBegin));
+  std::memcpy(out, m_leftover + m_leftoverBegin, taken * sizeof(uint32));
+  m_leftoverBegin += static_cast<uint32>(taken);
+  return taken;
+}
+
+/*
+*/
+void
+RandomStream::nextLanesPartial(uint32* out, SIZE_T count) {
+  CH_ASSERT(count < 4);
+  nextLanes(m_leftover);
+  std::memcpy(out, m_leftover, count * sizeof(uint32));
+  m_leftoverBegin = static_cast<uint32>(count);
+}
+
+/*
+*/
+void
+RandomStream::applyJump(const uint32 polynomial[4]) {
+  uint32 s[4] = {0, 0, 0, 0};
+  for (uint32 i = 0; i < 4; ++i) {
+    for (uint32 b = 0; b < 32; ++b) {
+      if (polynomial[i] & (1u << b)) {
+        s[0] ^= m_state[0];
+        s[1] ^= m_state[1];
+        s[2] ^= m_state[2];
+        s[3] ^= m_state[3];
+      }
+      next();
+    }
+  }
+
+  std::memcpy(m_state, s, sizeof(m_state));
+}
+
+/*
+*/
+void
+RandomStream::jump() {
+  applyJump(JUMP_POLYNOMIAL);
+  initLanes();
+}
+
+/*
+*/
+void
+RandomStream::longJump() {
+  applyJump(LONG_JUMP_POLYNOMIAL);
+  initLanes();
+}
+
+/*
+*/
+RandomStream
+RandomStream::split() {
+  // The copy keeps the lanes derived from the current state, jump() derives new ones for
+  // this stream so the bulk fills don't repeat the child either.
+  RandomStream child(*this);
+  jump();
+  return child;
+}
+
+/*
+*/
+int32
+RandomStream::nextIntRange(int32 min, int32 max) {
+  CH_ASSERT(min <= max);
+  const uint32 range = static_cast<uint32>(max) - static_cast<uint32>(min) + 1u;
+  if (range == 0) {
+    return static_cast<int32>(next());
+  }
+
+  // Lemire's nearly divisionless method, rejects the few values that would add bias.
+  uint64 m = static_cast<uint64>(next()) * range;
+  uint32 low = static_cast<uint32>(m);
+  if (low < range) {
+    const uint32 threshold = (0u - range) % range;
+    while (low < threshold) {
+      m = static_cast<uint64>(next()) * range;
+      low = static_cast<uint32>(m);
+    }
+  }
+
+  return static_cast<int32>(static_cast<uint32>(min) + static_cast<uint32>(m >> 32));
+}
+
+/*
+*/
+Vector3
+RandomStream::nextUnitVector() {
+  const float u = nextFloat01();
+  const float v = nextFloat01();
+  return unitVectorFrom01(u, v);
+}
+
+/*
+*/
+Vector3
+RandomStream::nextPointInSphere(const Vector3& center, float radius) {
+  const Vector3 direction = nextUnitVector();
+  return center + direction * (radius * std::cbrt(nextFloat01()));
+}
+
+/*
+*/
+Vector3
+RandomStream::nextPointInBox(const Vector3& min, const Vector3& max) {
+  const float u = nextFloat01();
+  const float v = nextFloat01();
+  const float w = nextFloat01();
+  return Vector3(min.x + (max.x - min.x) * u,
+                 min.y + (max.y - min.y) * v,
+                 min.z + (max.z - min.z) * w);
+}
+
+/*
+*/
+void
+RandomStream::fillUint32(uint32* out, SIZE_T count) {
+  SIZE_T i = takeLeftover(out, count);
+  const SIZE_T blockEnd = i + ((count - i) & ~static_cast<SIZE_T>(3));
+
+#if USING(CH_SIMD_SSE2)
+  LanesSSE2 lanes(m_lanes);
+  for (; i < blockEnd; i += 4) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lanes.next());
+  }
+  lanes.store(m_lanes);
+#else
+  for (; i < blockEnd; i += 4) {
+    nextLanes(out + i);
+  }
+#endif // USING(CH_SIMD_SSE2)
+
+  if (i < count) {
+    nextLanesPartial(out + i, count - i);
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillFloat01(float* out, SIZE_T count) {
+  uint32 partial[4];
+  SIZE_T i = takeLeftover(partial, count);
+  for (SIZE_T j = 0; j < i; ++j) {
+    out[j] = static_cast<float>(partial[j] >> 8) * FLOAT_UNIT;
+  }
+  const SIZE_T blockEnd = i + ((count - i) & ~static_cast<SIZE_T>(3));
+
+#if USING(CH_SIMD_SSE2)
+  LanesSSE2 lanes(m_lanes);
+  const __m128 unit = _mm_set1_ps(FLOAT_UNIT);
+  for (; i < blockEnd; i += 4) {
+    const __m128i bits = _mm_srli_epi32(lanes.next(), 8);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(bits), unit));
+  }
+  lanes.store(m_lanes);
+#else
+  for (; i < blockEnd; i += 4) {
+    uint32 block[4];
+    nextLanes(block);
+    for (uint32 j = 0; j < 4; ++j) {
+      out[i + j] = static_cast<float>(block[j] >> 8) * FLOAT_UNIT;
+    }
+  }
+#endif // USING(CH_SIMD_SSE2)
+
+  if (i < count) {
+    nextLanesPartial(partial, count - i);
+    for (uint32 j = 0; i < count; ++i, ++j) {
+      out[i] = static_cast<float>(partial[j] >> 8) * FLOAT_UNIT;
+    }
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillFloatRange(float* out, SIZE_T count, float min, float max) {
+  fillFloat01(out, count);
+  const float scale = max - min;
+  for (SIZE_T i = 0; i < count; ++i) {
+    out[i] = min + scale * out[i];
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillIntRange(int32* out, SIZE_T count, int32 min, int32 max) {
+  CH_ASSERT(min <= max);
+  const uint64 range = static_cast<uint64>(static_cast<int64>(max) - min) + 1;
+
+  uint32* raw = reinterpret_cast<uint32*>(out);
+  fillUint32(raw, count);
+  for (SIZE_T i = 0; i < count; ++i) {
+    const uint32 offset = static_cast<uint32>((raw[i] * range) >> 32);
+    out[i] = static_cast<int32>(static_cast<uint32>(min) + offset);
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillUnitVectors(Vector3* out, SIZE_T count) {
+  float values[FILL_CHUNK * 2];
+  for (SIZE_T base = 0; base < count; base += FILL_CHUNK) {
+    const SIZE_T chunk = Math::min(FILL_CHUNK, count - base);
+    fillFloat01(values, chunk * 2);
+    for (SIZE_T i = 0; i < chunk; ++i) {
+      out[base + i] = unitVectorFrom01(values[i * 2], values[i * 2 + 1]);
+    }
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillPointsInSphere(Vector3* out,
+                                 SIZE_T count,
+                                 const Vector3& center,
+                                 float radius) {
+  float values[FILL_CHUNK * 3];
+  for (SIZE_T base = 0; base < count; base += FILL_CHUNK) {
+    const SIZE_T chunk = Math::min(FILL_CHUNK, count - base);
+    fillFloat01(values, chunk * 3);
+    for (SIZE_T i = 0; i < chunk; ++i) {
+      const Vector3 direction = unitVectorFrom01(values[i * 3], values[i * 3 + 1]);
+      out[base + i] = center + direction * (radius * std::cbrt(values[i * 3 + 2]));
+    }
+  }
+}
+
+/*
+*/
+void
+RandomStream::fillPointsInBox(Vector3* out,
+                              SIZE_T count,
+                              const Vector3& min,
+                              const Vector3& max) {
+  const Vector3 size = max - min;
+  float values[FILL_CHUNK * 3];
+  for (SIZE_T base = 0; base < count; base += FILL_CHUNK) {
+    const SIZE_T chunk = Math::min(FILL_CHUNK, count - base);
+    fillFloat01(values, chunk * 3);
+    for (SIZE_T i = 0; i < chunk; ++i) {
+      out[base + i] = Vector3(min.x + size.x * values[i * 3],
+                              min.y + size.y * values[i * 3 + 1],
+                              min.z + size.z * values[i * 3 + 2]);
+    }
+  }
+}
+}
@@ -18,6 +18,8 @@
 /************************************************************************/
 #include "chPrerequisitesUtilities.h"
 
+#include "chVector3.h"
+
 namespace chEngineSDK{
 /*
  * Description:
@@ -129,4 +131,252 @@ Random::setSeed(uint32 seed) {
   m_seed = seed;
 }
 
+/*
+ * Description:
+ *     xoshiro128++ pseudo random generator.
+ *
+ *     Unlike Random this generator has a 128 bit state, passes the usual statistical
+ *     batteries and can be split in independent streams with jump() and split(), so every
+ *     worker thread can own its own generator without sharing state.
+ *
+ *     Bulk fill functions draw from four interleaved lanes that are advanced together with
+ *     SSE2 when available. The scalar fallback produces the exact same sequence, so results
+ *     don't depend on the instruction set the engine was built with. Numbers of the last
+ *     lane step a fill did not use are kept for the next fill, so fill(3) followed by
+ *     fill(3) gives the same numbers as fill(6).
+ *
+ * Sample usage:
+ *  RandomStream rnd(1234);
+ *  RandomStream workerRnd = rnd.split();
+ *  Vector<float> values(1024);
+ *  workerRnd.fillFloat01(values.data(), values.size());
+ */
+class CH_UTILITY_EXPORT RandomStream
+{
+ public:
+  /**
+   * @brief Constructor using the given value as a seed. The 128 bit state is expanded
+   *        from the seed using SplitMix64.
+   **/
+  explicit RandomStream(uint64 seed = 0);
+
+  /**
+   * @brief Default destructor
+   **/
+  ~RandomStream() = default;
+
+  /************************************************************************/
+  /*
+   * Methods.
+   */
+  /************************************************************************/
+
+  /**
+   * Resets both the scalar and the bulk state from the given seed.
+   **/
+  void
+  setSeed(uint64 seed);
+
+  /**
+   * Gets the next 32 bit pseudo random number.
+   **/
+  FORCEINLINE uint32
+  next();
+
+  /**
+   * Gets a random float in the range [0, 1).
+   **/
+  NODISCARD FORCEINLINE float
+  nextFloat01() {
+    return static_cast<float>(next() >> 8) * FLOAT_UNIT;
+  }
+
+  /**
+   * Gets a random float in the range [min, max).
+   **/
+  NODISCARD FORCEINLINE float
+  nextFloatRange(float min, float max) {
+    return min + (max - min) * nextFloat01();
+  }
+
+  /**
+   * Gets an unbiased random integer in the range [min, max].
+   **/
+  NODISCARD int32
+  nextIntRange(int32 min, int32 max);
+
+  /**
+   * Gets a uniformly distributed direction of length 1.
+   **/
+  NODISCARD Vector3
+  nextUnitVector();
+
+  /**
+   * Gets a uniformly distributed point inside the given sphere.
+   **/
+  NODISCARD Vector3
+  nextPointInSphere(const Vector3& center, float radius);
+
+  /**
+   * Gets a uniformly distributed point inside the box defined by min and max.
+   **/
+  NODISCARD Vector3
+  nextPointInBox(const Vector3& min, const Vector3& max);
+
+  /**
+   * Advances the scalar state 2^64 steps and derives the bulk lanes again from it. Used to
+   *   create non overlapping streams.
+   **/
+  void
+  jump();
+
+  /**
+   * Advances the scalar state 2^96 steps and derives the bulk lanes again from it.
+   **/
+  void
+  longJump();
+
+  /**
+   * Returns a generator that starts at the current state and jumps this one ahead, the two
+   *   streams won't overlap for 2^64 numbers. Call it once per worker thread.
+   **/
+  NODISCARD RandomStream
+  split();
+
+  /**
+   * Fills the buffer with raw 32 bit numbers.
+   **/
+  void
+  fillUint32(uint32* out, SIZE_T count);
+
+  /**
+   * Fills the buffer with floats in the range [0, 1).
+   **/
+  void
+  fillFloat01(float* out, SIZE_T count);
+
+  /**
+   * Fills the buffer with floats in the range [min, max).
+   **/
+  void
+  fillFloatRange(float* out, SIZE_T count, float min, float max);
+
+  /**
+   * Fills the buffer with integers in the range [min, max].
+   *
+   * Uses a multiply-shift reduction without rejection, the bias is below
+   *   (max - min + 1) / 2^32 which is negligible for gameplay ranges.
+   **/
+  void
+  fillIntRange(int32* out, SIZE_T count, int32 min, int32 max);
+
+  /**
+   * Fills the buffer with uniformly distributed unit vectors.
+   **/
+  void
+  fillUnitVectors(Vector3* out, SIZE_T count);
+
+  /**
+   * Fills the buffer with points uniformly distributed inside a sphere.
+   **/
+  void
+  fillPointsInSphere(Vector3* out, SIZE_T count, const Vector3& center, float radius);
+
+  /**
+   * Fills the buffer with points uniformly distributed inside the box [min, max].
+   **/
+  void
+  fillPointsInBox(Vector3* out, SIZE_T count, const Vector3& min, const Vector3& max);
+
+ private:
+  /**
+   * Expands m_state into the four bulk lanes, each one a long jump apart.
+   **/
+  void
+  initLanes();
+
+  /**
+   * Advances the four bulk lanes once and writes one number per lane.
+   **/
+  void
+  nextLanes(uint32 out[4]);
+
+  /**
+   * Writes up to count numbers left over by the previous fill.
+   *
+   * @return
+   *   Amount of numbers written.
+   **/
+  SIZE_T
+  takeLeftover(uint32* out, SIZE_T count);
+
+  /**
+   * Advances the lanes once, writes the first count numbers and keeps the rest for the
+   *   next fill. count must be lower than 4.
+   **/
+  void
+  nextLanesPartial(uint32* out, SIZE_T count);
+
+  /**
+   * Shared implementation of jump() and longJump().
+   **/
+  void
+  applyJump(const uint32 polynomial[4]);
+
+  FORCEINLINE static uint32
+  rotl(uint32 x, int32 k) {
+    return (x << k) | (x >> (32 - k));
+  }
+
+  /************************************************************************/
+  /*
+   * Constants.
+   */
+  /************************************************************************/
+ public:
+  /**
+   *  2^-24, maps the upper 24 bits of a number to [0, 1).
+   */
+  static const float FLOAT_UNIT;
+
+  /************************************************************************/
+  /*
+   * Members.
+   */
+  /************************************************************************/
+ private:
+  /**
+   *  Scalar xoshiro128++ state.
+   */
+  uint32 m_state[4];
+
+  /**
+   *  Bulk state stored as structure of arrays, m_lanes[word][lane].
+   */
+  alignas(16) uint32 m_lanes[4][4];
+
+  /**
+   *  Lane step partially used by the last fill, valid from m_leftoverBegin to the end.
+   */
+  uint32 m_leftover[4];
+  uint32 m_leftoverBegin = 4;
+};
+
+/*
+*/
+FORCEINLINE uint32
+RandomStream::next() {
+  const uint32 result = rotl(m_state[0] + m_state[3], 7) + m_state[0];
+  const uint32 t = m_state[1] << 9;
+
+  m_state[2] ^= m_state[0];
+  m_state[3] ^= m_state[1];
+  m_state[1] ^= m_state[2];
+  m_state[0] ^= m_state[3];
+  m_state[2] ^= t;
+  m_state[3] = rotl(m_state[3], 11);
+
+  return result;
+}
+
 }
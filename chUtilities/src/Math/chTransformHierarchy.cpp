@@ -0,0 +1,358 @@
+/************************************************************************/
+/**
+ * @file chTransformHierarchy.cpp
+ * @author AccelMR
+ * @date 2025/07/27
+ * @brief
+ *  Flat transform hierarchy, parents always stored before their children.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chTransformHierarchy.h"
+
+namespace chEngineSDK {
+
+/*
+*/
+TransformHierarchy::NodeId
+TransformHierarchy::createNode(NodeId parent,
+                               const Vector3& position,
+                               const Quaternion& rotation,
+                               const Vector3& scale) {
+  const uint32 parentIndex = parent != INVALID_NODE ? indexOf(parent) : INVALID_NODE;
+
+  NodeId node;
+  if (!m_freeNodes.empty()) {
+    node = m_freeNodes.back();
+    m_freeNodes.pop_back();
+  }
+  else {
+    node = static_cast<NodeId>(m_nodeToIndex.size());
+    m_nodeToIndex.push_back(INVALID_NODE);
+  }
+
+  // Appending keeps the parent before child order.
+  const uint32 index = static_cast<uint32>(m_indexToNode.size());
+  m_parentIndices.push_back(parentIndex);
+  m_localPositions.push_back(position);
+  m_localRotations.push_back(rotation);
+  m_localScales.push_back(scale);
+  m_worldMatrices.push_back(Matrix3x4::IDENTITY);
+  m_dirty.push_back(0);
+  m_indexToNode.push_back(node);
+  m_nodeToIndex[node] = index;
+
+  markDirty(index);
+  return node;
+}
+
+/*
+*/
+void
+TransformHierarchy::createNodes(SIZE_T count,
+                                const uint32* parents,
+                                const Vector3* positions,
+                                const Quaternion* rotations,
+                                const Vector3* scales,
+                                NodeId* outNodes) {
+  if (count == 0) {
+    return;
+  }
+
+  const uint32 first = static_cast<uint32>(m_indexToNode.size());
+  const SIZE_T newCount = first + count;
+  m_localPositions.insert(m_localPositions.end(), positions, positions + count);
+  m_localRotations.insert(m_localRotations.end(), rotations, rotations + count);
+  m_localScales.insert(m_localScales.end(), scales, scales + count);
+  m_worldMatrices.resize(newCount, Matrix3x4::IDENTITY);
+  m_dirty.resize(newCount, 1);
+  m_parentIndices.resize(newCount);
+  m_indexToNode.resize(newCount);
+
+  for (uint32 i = 0; i < static_cast<uint32>(count); ++i) {
+    CH_ASSERT(parents[i] == INVALID_NODE || parents[i] < i);
+    const uint32 index = first + i;
+    m_parentIndices[index] = parents[i] != INVALID_NODE ? first + parents[i] : INVALID_NODE;
+
+    NodeId node;
+    if (!m_freeNodes.empty()) {
+      node = m_freeNodes.back();
+      m_freeNodes.pop_back();
+    }
+    else {
+      node = static_cast<NodeId>(m_nodeToIndex.size());
+      m_nodeToIndex.push_back(INVALID_NODE);
+    }
+    m_indexToNode[index] = node;
+    m_nodeToIndex[node] = index;
+    outNodes[i] = node;
+  }
+
+  // Appended after everything else, so the parent before child order still holds
+  lowerFirstDirty(first);
+}
+
+/*
+*/
+void
+TransformHierarchy::destroyNode(NodeId node) {
+  sortIfNeeded();
+
+  const uint32 first = indexOf(node);
+  const uint32 count = static_cast<uint32>(m_indexToNode.size());
+
+  // Children always come after their parent, one forward pass finds the whole subtree.
+  Vector<uint8> removed(count, 0);
+  removed[first] = 1;
+  for (uint32 i = first + 1; i < count; ++i) {
+    const uint32 parent = m_parentIndices[i];
+    removed[i] = parent != INVALID_NODE && parent >= first && removed[parent];
+  }
+
+  const SIZE_T firstFreed = m_freeNodes.size();
+  Vector<uint32> order;
+  order.reserve(count);
+  for (uint32 i = 0; i < count; ++i) {
+    if (removed[i]) {
+      m_nodeToIndex[m_indexToNode[i]] = INVALID_NODE;
+      m_freeNodes.push_back(m_indexToNode[i]);
+    }
+    else {
+      order.push_back(i);
+    }
+  }
+
+  reorder(order);
+
+  if (m_destroyCallback) {
+    for (SIZE_T i = firstFreed; i < m_freeNodes.size(); ++i) {
+      m_destroyCallback(m_freeNodes[i]);
+    }
+  }
+}
+
+/*
+*/
+void
+TransformHierarchy::setParent(NodeId node, NodeId parent) {
+  const uint32 index = indexOf(node);
+  const uint32 parentIndex = parent != INVALID_NODE ? indexOf(parent) : INVALID_NODE;
+
+#if USING(CH_DEBUG_MODE)
+  for (uint32 ancestor = parentIndex; ancestor != INVALID_NODE;
+       ancestor = m_parentIndices[ancestor]) {
+    CH_ASSERT(ancestor != index && "A node can't be parented to its own subtree");
+  }
+#endif // USING(CH_DEBUG_MODE)
+
+  m_parentIndices[index] = parentIndex;
+  if (parentIndex != INVALID_NODE && parentIndex > index) {
+    m_needsSort = true;
+  }
+  markDirty(index);
+}
+
+/*
+*/
+TransformHierarchy::NodeId
+TransformHierarchy::getParent(NodeId node) const {
+  const uint32 parentIndex = m_parentIndices[indexOf(node)];
+  return parentIndex != INVALID_NODE ? m_indexToNode[parentIndex] : INVALID_NODE;
+}
+
+/*
+*/
+void
+TransformHierarchy::setLocalPosition(NodeId node, const Vector3& position) {
+  const uint32 index = indexOf(node);
+  m_localPositions[index] = position;
+  markDirty(index);
+}
+
+/*
+*/
+void
+TransformHierarchy::setLocalRotation(NodeId node, const Quaternion& rotation) {
+  const uint32 index = indexOf(node);
+  m_localRotations[index] = rotation;
+  markDirty(index);
+}
+
+/*
+*/
+void
+TransformHierarchy::setLocalScale(NodeId node, const Vector3& scale) {
+  const uint32 index = indexOf(node);
+  m_localScales[index] = scale;
+  markDirty(index);
+}
+
+/*
+*/
+void
+TransformHierarchy::setLocalTransform(NodeId node,
+                                      const Vector3& position,
+                                      const Quaternion& rotation,
+                                      const Vector3& scale) {
+  const uint32 index = indexOf(node);
+  m_localPositions[index] = position;
+  m_localRotations[index] = rotation;
+  m_localScales[index] = scale;
+  markDirty(index);
+}
+
+/*
+*/
+SIZE_T
+TransformHierarchy::updateWorldMatrices(Vector<NodeId>* updatedNodes) {
+  sortIfNeeded();
+  const uint32 firstDirty = m_firstDirty.load(std::memory_order_relaxed);
+  if (firstDirty == INVALID_NODE) {
+    return 0;
+  }
+
+  // A node is recomputed when it is dirty or its parent was, the flag is propagated in
+  // place so a single pass covers whole subtrees.
+  SIZE_T updated = 0;
+  const uint32 count = static_cast<uint32>(m_indexToNode.size());
+  for (uint32 i = firstDirty; i < count; ++i) {
+    const uint32 parent = m_parentIndices[i];
+    if (!m_dirty[i] && (parent == INVALID_NODE || !m_dirty[parent])) {
+      continue;
+    }
+
+    m_dirty[i] = 1;
+    const Matrix3x4 local(m_localScales[i], m_localRotations[i], m_localPositions[i]);
+    m_worldMatrices[i] = parent == INVALID_NODE ? local : local * m_worldMatrices[parent];
+    ++updated;
+    if (updatedNodes) {
+      updatedNodes->push_back(m_indexToNode[i]);
+    }
+  }
+
+  std::fill(m_dirty.begin() + firstDirty, m_dirty.end(), 0);
+  m_firstDirty = INVALID_NODE;
+  return updated;
+}
+
+/*
+*/
+void
+TransformHierarchy::reserve(SIZE_T nodeCount) {
+  m_parentIndices.reserve(nodeCount);
+  m_localPositions.reserve(nodeCount);
+  m_localRotations.reserve(nodeCount);
+  m_localScales.reserve(nodeCount);
+  m_worldMatrices.reserve(nodeCount);
+  m_dirty.reserve(nodeCount);
+  m_indexToNode.reserve(nodeCount);
+  m_nodeToIndex.reserve(nodeCount);
+}
+
+/*
+*/
+void
+TransformHierarchy::clear() {
+  m_parentIndices.clear();
+  m_localPositions.clear();
+  m_localRotations.clear();
+  m_localScales.clear();
+  m_worldMatrices.clear();
+  m_dirty.clear();
+  m_indexToNode.clear();
+  m_nodeToIndex.clear();
+  m_freeNodes.clear();
+  m_firstDirty = INVALID_NODE;
+  m_needsSort = false;
+}
+
+/*
+*/
+void
+TransformHierarchy::sortIfNeeded() {
+  if (!m_needsSort) {
+    return;
+  }
+  m_needsSort = false;
+
+  const uint32 count = static_cast<uint32>(m_indexToNode.size());
+  constexpr uint32 UNKNOWN_DEPTH = 0xFFFFFFFF;
+  Vector<uint32> depths(count, UNKNOWN_DEPTH);
+  Vector<uint32> chain;
+  uint32 maxDepth = 0;
+
+  for (uint32 i = 0; i < count; ++i) {
+    // Walk up until a node with known depth, then assign depths on the way back.
+    uint32 current = i;
+    while (current != INVALID_NODE && depths[current] == UNKNOWN_DEPTH) {
+      chain.push_back(current);
+      current = m_parentIndices[current];
+    }
+    uint32 depth = current == INVALID_NODE ? 0 : depths[current] + 1;
+    while (!chain.empty()) {
+      depths[chain.back()] = depth++;
+      chain.pop_back();
+    }
+    maxDepth = Math::max(maxDepth, depths[i]);
+  }
+
+  // Counting sort by depth, stable so siblings keep their relative order.
+  Vector<uint32> offsets(maxDepth + 2, 0);
+  for (uint32 i = 0; i < count; ++i) {
+    ++offsets[depths[i] + 1];
+  }
+  for (uint32 d = 1; d < offsets.size(); ++d) {
+    offsets[d] += offsets[d - 1];
+  }
+  Vector<uint32> order(count);
+  for (uint32 i = 0; i < count; ++i) {
+    order[offsets[depths[i]]++] = i;
+  }
+
+  reorder(order);
+}
+
+/*
+*/
+void
+TransformHierarchy::reorder(const Vector<uint32>& order) {
+  const uint32 oldCount = static_cast<uint32>(m_indexToNode.size());
+  Vector<uint32> newIndex(oldCount, INVALID_NODE);
+  for (uint32 i = 0; i < static_cast<uint32>(order.size()); ++i) {
+    newIndex[order[i]] = i;
+  }
+
+  auto permute = [&order](auto& values) {
+    std::remove_reference_t<decltype(values)> result;
+    result.reserve(order.size());
+    for (uint32 oldIndex : order) {
+      result.push_back(values[oldIndex]);
+    }
+    values.swap(result);
+  };
+
+  permute(m_parentIndices);
+  permute(m_localPositions);
+  permute(m_localRotations);
+  permute(m_localScales);
+  permute(m_worldMatrices);
+  permute(m_dirty);
+  permute(m_indexToNode);
+
+  m_firstDirty = INVALID_NODE;
+  for (uint32 i = 0; i < static_cast<uint32>(order.size()); ++i) {
+    if (m_parentIndices[i] != INVALID_NODE) {
+      m_parentIndices[i] = newIndex[m_parentIndices[i]];
+    }
+    m_nodeToIndex[m_indexToNode[i]] = i;
+    if (m_dirty[i]) {
+      lowerFirstDirty(i);
+    }
+  }
+}
+} // namespace chEngineSDK
@@ -0,0 +1,258 @@
+/************************************************************************/
+/**
+ * @file chTransformHierarchy.h
+ * @author AccelMR
+ * @date 2025/07/27
+ * @brief
+ *  Flat transform hierarchy, parents always stored before their children.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chMatrix3x4.h"
+#include "chQuaternion.h"
+#include "chVector3.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Stores a whole hierarchy of transforms as parallel arrays sorted so that every parent
+ *     comes before its children. World matrices are then computed by a single linear pass
+ *     that only recomputes dirty nodes and the subtrees below them.
+ *
+ *     Nodes are referenced by stable NodeIds, the array position of a node may change
+ *     when the hierarchy is re-sorted after reparenting or destroying nodes.
+ *
+ * Sample usage:
+ *  TransformHierarchy hierarchy;
+ *  auto root = hierarchy.createNode();
+ *  auto child = hierarchy.createNode(root, Vector3(1.0f, 0.0f, 0.0f));
+ *  hierarchy.setLocalRotation(root, rotation);
+ *  hierarchy.updateWorldMatrices();
+ *  const Matrix3x4& world = hierarchy.getWorldMatrix(child);
+ */
+class CH_UTILITY_EXPORT TransformHierarchy
+{
+ public:
+  using NodeId = uint32;
+  using DestroyCallback = Function<void(NodeId)>;
+  static constexpr NodeId INVALID_NODE = 0xFFFFFFFF;
+
+  TransformHierarchy() = default;
+  ~TransformHierarchy() = default;
+
+  /**
+   *   Creates a node, it is marked dirty so its world matrix is computed on the next
+   *   updateWorldMatrices().
+   **/
+  NodeId
+  createNode(NodeId parent = INVALID_NODE,
+             const Vector3& position = Vector3::ZERO,
+             const Quaternion& rotation = Quaternion::IDENTITY,
+             const Vector3& scale = Vector3::UNIT);
+
+  /**
+   *   Creates count nodes appending to every array once, used by bulk loads. Nodes of the
+   *   batch come parents first, like createNode() they start dirty.
+   *
+   * @param parents
+   *   Position inside the batch of the parent of each node, lower than the position of
+   *   the node, or INVALID_NODE for a root.
+   *
+   * @param outNodes
+   *   Receives the id of each created node.
+   **/
+  void
+  createNodes(SIZE_T count,
+              const uint32* parents,
+              const Vector3* positions,
+              const Quaternion* rotations,
+              const Vector3* scales,
+              NodeId* outNodes);
+
+  /**
+   *   Destroys the node and every node below it.
+   **/
+  void
+  destroyNode(NodeId node);
+
+  /**
+   *   Called by destroyNode() for every destroyed node, before its id can be reused, so
+   *   data indexed by NodeId outside the hierarchy can be released.
+   **/
+  void
+  setDestroyCallback(DestroyCallback callback) {
+    m_destroyCallback = std::move(callback);
+  }
+
+  /**
+   *   Moves the node and its subtree under a new parent, INVALID_NODE makes it a root.
+   **/
+  void
+  setParent(NodeId node, NodeId parent);
+
+  NODISCARD NodeId
+  getParent(NodeId node) const;
+
+  NODISCARD FORCEINLINE bool
+  isValid(NodeId node) const {
+    return node < m_nodeToIndex.size() && m_nodeToIndex[node] != INVALID_NODE;
+  }
+
+  /**
+   *   The local setters may run concurrently as long as every thread writes different
+   *   nodes. Creating, destroying or reparenting nodes needs exclusive access.
+   **/
+  void
+  setLocalPosition(NodeId node, const Vector3& position);
+
+  void
+  setLocalRotation(NodeId node, const Quaternion& rotation);
+
+  void
+  setLocalScale(NodeId node, const Vector3& scale);
+
+  void
+  setLocalTransform(NodeId node,
+                    const Vector3& position,
+                    const Quaternion& rotation,
+                    const Vector3& scale);
+
+  NODISCARD FORCEINLINE const Vector3&
+  getLocalPosition(NodeId node) const {
+    return m_localPositions[indexOf(node)];
+  }
+
+  NODISCARD FORCEINLINE const Quaternion&
+  getLocalRotation(NodeId node) const {
+    return m_localRotations[indexOf(node)];
+  }
+
+  NODISCARD FORCEINLINE const Vector3&
+  getLocalScale(NodeId node) const {
+    return m_localScales[indexOf(node)];
+  }
+
+  /**
+   *   World matrix computed by the last updateWorldMatrices().
+   **/
+  NODISCARD FORCEINLINE const Matrix3x4&
+  getWorldMatrix(NodeId node) const {
+    return m_worldMatrices[indexOf(node)];
+  }
+
+  /**
+   *   Recomputes the world matrix of every dirty node and of everything below them.
+   *
+   * @param updatedNodes
+   *   Optional, the id of every recomputed node is appended to it.
+   *
+   * @return
+   *   Amount of world matrices recomputed.
+   **/
+  SIZE_T
+  updateWorldMatrices(Vector<NodeId>* updatedNodes = nullptr);
+
+  NODISCARD FORCEINLINE SIZE_T
+  getNodeCount() const {
+    return m_indexToNode.size();
+  }
+
+  /**
+   *   World matrices in hierarchy order, ready to be uploaded as a single block.
+   **/
+  NODISCARD FORCEINLINE const Vector<Matrix3x4>&
+  getWorldMatrices() const {
+    return m_worldMatrices;
+  }
+
+  /**
+   *   Position of the node inside getWorldMatrices(), valid until the next structural
+   *   change.
+   **/
+  NODISCARD uint32
+  getHierarchyIndex(NodeId node) {
+    sortIfNeeded();
+    return indexOf(node);
+  }
+
+  /**
+   *   Grows the node arrays so nodeCount nodes can be created without reallocating.
+   **/
+  void
+  reserve(SIZE_T nodeCount);
+
+  void
+  clear();
+
+ private:
+  NODISCARD FORCEINLINE uint32
+  indexOf(NodeId node) const {
+    CH_ASSERT(isValid(node));
+    return m_nodeToIndex[node];
+  }
+
+  /**
+   *   Safe to call for different nodes from several threads, the local setters run it
+   *   from parallel component updates. Each node has its own flag byte.
+   **/
+  FORCEINLINE void
+  markDirty(uint32 index) {
+    m_dirty[index] = 1;
+    lowerFirstDirty(index);
+  }
+
+  FORCEINLINE void
+  lowerFirstDirty(uint32 index) {
+    uint32 current = m_firstDirty.load(std::memory_order_relaxed);
+    while (index < current &&
+           !m_firstDirty.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   *   Restores the parent before child order with a stable counting sort by depth, siblings
+   *   keep their relative order.
+   **/
+  void
+  sortIfNeeded();
+
+  /**
+   *   Rebuilds every array keeping only order[i] as the new position i.
+   **/
+  void
+  reorder(const Vector<uint32>& order);
+
+  /**
+   *  Per node data, all arrays are indexed by hierarchy position.
+   */
+  Vector<uint32> m_parentIndices;
+  Vector<Vector3> m_localPositions;
+  Vector<Quaternion> m_localRotations;
+  Vector<Vector3> m_localScales;
+  Vector<Matrix3x4> m_worldMatrices;
+  Vector<uint8> m_dirty;
+  Vector<NodeId> m_indexToNode;
+
+  /**
+   *  NodeId to hierarchy position, INVALID_NODE for destroyed ids.
+   */
+  Vector<uint32> m_nodeToIndex;
+  Vector<NodeId> m_freeNodes;
+
+  /**
+   *  Lowest dirty position, nothing before it needs to be visited by the update.
+   */
+  Atomic<uint32> m_firstDirty = INVALID_NODE;
+  bool m_needsSort = false;
+
+  DestroyCallback m_destroyCallback;
+};
+} // namespace chEngineSDK
@@ -29,10 +29,6 @@ Vector2::Vector2(const Vector3& vector3)
     y(vector3.y)
 {}
 
-const Vector2 Vector2::ZERO = Vector2(0.0f, 0.0f);
-const Vector2 Vector2::UNIT = Vector2(1.0f, 1.0f);
-const Vector2 Vector2::UNIT_X = Vector2(1.0f, 0.0f);
-const Vector2 Vector2::UNIT_Y = Vector2(0.0f, 1.0f);
 
 }
 
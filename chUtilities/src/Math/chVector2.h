@@ -40,7 +40,7 @@ public:
   /*
    * Default constructor
    */
-  FORCEINLINE Vector2() = default;
+  FORCEINLINE constexpr Vector2() = default;
 
   /**
    * Constructor using initial given values.
@@ -51,7 +51,7 @@ public:
    * @param _y
    *   Y value
    */
-  FORCEINLINE Vector2(float _x, float _y);
+  FORCEINLINE constexpr Vector2(float _x, float _y);
 
   /**
    * Constructor using initial given values as an C++ Array.
@@ -59,14 +59,14 @@ public:
    * @param vector2Array
    *   C++ array to be converted to this Vector2 type
    */
-  FORCEINLINE explicit Vector2(const float vector2Array[2]);
+  FORCEINLINE constexpr explicit Vector2(const float vector2Array[2]);
 
-  //FORCEINLINE explicit Vector2(const float* v2Arr);
+  //FORCEINLINE constexpr explicit Vector2(const float* v2Arr);
 
   /**
    * Copy Constructor.
    */
-  FORCEINLINE Vector2(const Vector2& toCopy);
+  FORCEINLINE constexpr Vector2(const Vector2& toCopy);
 
   /**
    *
@@ -87,7 +87,7 @@ public:
    * @return
    *  Float Scalar Z of the result vector2.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   cross(const Vector2& vector2) const;
 
   /**
@@ -99,7 +99,7 @@ public:
    * @return
    *  Float value of dot product.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   dot(const Vector2& vector2) const;
 
   /**
@@ -111,7 +111,7 @@ public:
    * @return
    *  Float Between 0.0f - 1.0f. Projection A over B.
    */
-  FORCEINLINE  Vector2
+  FORCEINLINE constexpr Vector2
   projection(const Vector2& vector2) const;
 
   /**
@@ -120,7 +120,7 @@ public:
    * @return
    *  Float the magnitude of this vector.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   magnitude() const;
 
   /**
@@ -130,13 +130,13 @@ public:
    * @return
    *  Float magnitude before square root.
    */
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   sqrMagnitude() const;
 
   /**
    * Normalize this vector.
    */
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   normalize(float tolerance = Math::SMALL_NUMBER);
 
   /**
@@ -145,7 +145,7 @@ public:
    * @return
    *  Vector2 new Vector created from normalization
    */
-  FORCEINLINE Vector2
+  FORCEINLINE constexpr Vector2
   getNormalized(float tolerance = Math::SMALL_NUMBER) const;
 
 
@@ -164,7 +164,7 @@ public:
     * @return
     *  True if both vectors are equal.
     */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Vector2& vector2) const;
 
   /**
@@ -176,7 +176,7 @@ public:
    * @return
    *   true if both vectors are equal.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(const Vector2& vector2) const;
 
   /**
@@ -188,7 +188,7 @@ public:
    * @return
    *    Vector2 new Vector2 created from this operation.
    */
-  FORCEINLINE Vector2
+  FORCEINLINE constexpr Vector2
   operator*(float scalar) const;
 
   /**
@@ -200,7 +200,7 @@ public:
    * @return
    *   THIS reference. Note that this function modifies this Vector.
    */
-  FORCEINLINE Vector2&
+  FORCEINLINE constexpr Vector2&
   operator*=(float scalar);
 
   /**
@@ -212,7 +212,7 @@ public:
    * @return Vecto3
    *  The new vector created from adding other two vector.
    **/
-  FORCEINLINE Vector2
+  FORCEINLINE constexpr Vector2
   operator+(const Vector2& vector3) const;
 
   /**
@@ -224,7 +224,7 @@ public:
    * @return Vecto3
    *  This reference modified.
    **/
-  FORCEINLINE Vector2&
+  FORCEINLINE constexpr Vector2&
   operator+=(const Vector2& vector3);
 
   /**
@@ -236,7 +236,7 @@ public:
    * @return Vector3
    *  The new created vector.
    **/
-  FORCEINLINE Vector2
+  FORCEINLINE constexpr Vector2
   operator-(const Vector2& vector3) const;
 
   /**
@@ -248,7 +248,7 @@ public:
    * @return Vector3
    *  This vector reference modified.
    **/
-  FORCEINLINE Vector2&
+  FORCEINLINE constexpr Vector2&
   operator-=(const Vector2& vector3);
 
   /**
@@ -257,13 +257,13 @@ public:
    * @return
    *  A new vector3 created from this vector.
    **/
-  FORCEINLINE Vector2
+  FORCEINLINE constexpr Vector2
   operator-() const;
 
-  FORCEINLINE Vector2&
+  FORCEINLINE constexpr Vector2&
   operator=(const float* v2Arr);
 
-  FORCEINLINE Vector2&
+  FORCEINLINE constexpr Vector2&
   operator=(const Vector2& vector2);
 
   /**
@@ -272,7 +272,7 @@ public:
    * @return
    *  A new Array 2 x,y
    **/
-  FORCEINLINE Array<float, 2>
+  FORCEINLINE constexpr Array<float, 2>
   xy() const { return {x, y};}
 
 private:
@@ -304,22 +304,22 @@ public:
    /**
     * Global 2D zero vector constant (0.0f, 0.0f).
     */
-  static CH_UTILITY_EXPORT const Vector2 ZERO;
+  static const Vector2 ZERO;
 
   /**
    * Global 2D Unit vector constant (1.0f, 1.0f).
    */
-  static CH_UTILITY_EXPORT const Vector2 UNIT;
+  static const Vector2 UNIT;
 
   /**
    * Global 2D Unit x vector constant (1.0f, 0.0f).
    */
-  static CH_UTILITY_EXPORT const Vector2 UNIT_X;
+  static const Vector2 UNIT_X;
 
   /**
    * Global 2D Unit y vector constant (0.0f, 1.0f).
    */
-  static CH_UTILITY_EXPORT const Vector2 UNIT_Y;
+  static const Vector2 UNIT_Y;
 
 public:
 
@@ -334,25 +334,25 @@ public:
  /************************************************************************/
  /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector2::Vector2(float _x, float _y) : x(_x), y(_y)
 {}
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector2::Vector2(const float vector2Array[2]) : x(vector2Array[0]), y(vector2Array[1])
 {}
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector2::Vector2(const Vector2& copyVector) : x(copyVector.x), y(copyVector.y)
 {}
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector2::cross(const Vector2& vector2) const
 {
   return x * vector2.y - y * vector2.x;
@@ -360,7 +360,7 @@ Vector2::cross(const Vector2& vector2) const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector2::dot(const Vector2& vector2) const
 {
   return x * vector2.x + y * vector2.y;
@@ -368,7 +368,7 @@ Vector2::dot(const Vector2& vector2) const
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::projection(const Vector2& vector2) const
 {
   const float dotP = dot(vector2);
@@ -377,7 +377,7 @@ Vector2::projection(const Vector2& vector2) const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector2::magnitude() const
 {
   return Math::sqrt(sqrMagnitude());
@@ -385,7 +385,7 @@ Vector2::magnitude() const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector2::sqrMagnitude() const
 {
   return x * x + y * y;
@@ -393,7 +393,7 @@ Vector2::sqrMagnitude() const
 
 /*
 */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Vector2::normalize(float tolerance)
 {
   const float SquareSum = x * x + y * y;
@@ -409,7 +409,7 @@ Vector2::normalize(float tolerance)
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::getNormalized(float tolerance) const
 {
   Vector2 Res = *this;
@@ -419,7 +419,7 @@ Vector2::getNormalized(float tolerance) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector2::operator==(const Vector2& vector2) const
 {
   return x == vector2.x && y == vector2.y;
@@ -427,7 +427,7 @@ Vector2::operator==(const Vector2& vector2) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector2::operator!=(const Vector2& vector2) const
 {
   return x != vector2.x || y != vector2.y;
@@ -436,7 +436,7 @@ Vector2::operator!=(const Vector2& vector2) const
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::operator*(float scalar) const
 {
   return {x * scalar, y * scalar};
@@ -444,7 +444,7 @@ Vector2::operator*(float scalar) const
 
 /*
 */
-FORCEINLINE Vector2&
+FORCEINLINE constexpr Vector2&
 Vector2::operator*=(float scalar)
 {
   x *= scalar;
@@ -454,7 +454,7 @@ Vector2::operator*=(float scalar)
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::operator+(const Vector2& vector3) const
 {
   return { x + vector3.x, y + vector3.y };
@@ -462,7 +462,7 @@ Vector2::operator+(const Vector2& vector3) const
 
 /*
 */
-FORCEINLINE Vector2&
+FORCEINLINE constexpr Vector2&
 Vector2::operator+=(const Vector2& vector3)
 {
   x += vector3.x;
@@ -472,7 +472,7 @@ Vector2::operator+=(const Vector2& vector3)
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::operator-(const Vector2& vector3) const
 {
   return {x - vector3.x, y - vector3.y};
@@ -480,7 +480,7 @@ Vector2::operator-(const Vector2& vector3) const
 
 /*
 */
-FORCEINLINE Vector2&
+FORCEINLINE constexpr Vector2&
 Vector2::operator-=(const Vector2& vector3)
 {
   x -= vector3.x;
@@ -490,7 +490,7 @@ Vector2::operator-=(const Vector2& vector3)
 
 /*
 */
-FORCEINLINE Vector2
+FORCEINLINE constexpr Vector2
 Vector2::operator-() const
 {
   return {-x, -y};
@@ -498,7 +498,7 @@ Vector2::operator-() const
 
 /*
 */
-FORCEINLINE Vector2&
+FORCEINLINE constexpr Vector2&
 Vector2::operator=(const float* v2Arr) {
   x = v2Arr[0];
   y = v2Arr[1];
@@ -507,12 +507,20 @@ Vector2::operator=(const float* v2Arr) {
 
 /*
 */
-FORCEINLINE Vector2&
+FORCEINLINE constexpr Vector2&
 Vector2::operator=(const Vector2& vector2) {
   x = vector2.x;
   y = vector2.y;
   return *this;
 }
 
-
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Vector2 Vector2::ZERO = Vector2(0.0f, 0.0f);
+inline constexpr Vector2 Vector2::UNIT = Vector2(1.0f, 1.0f);
+inline constexpr Vector2 Vector2::UNIT_X = Vector2(1.0f, 0.0f);
+inline constexpr Vector2 Vector2::UNIT_Y = Vector2(0.0f, 1.0f);
 }
@@ -35,12 +35,12 @@ public:
   /*
    * Default constructor
    */
-  FORCEINLINE Vector3() = default;
+  FORCEINLINE constexpr Vector3() = default;
 
   /**
    * Constructor using initial given values.
    */
-  FORCEINLINE Vector3(float _x, float _y, float _z);
+  FORCEINLINE constexpr Vector3(float _x, float _y, float _z);
 
   /**
    * Constructor from Vector2.
@@ -52,12 +52,12 @@ public:
   /**
    *   Constructor from Array 3.
    **/
-  explicit FORCEINLINE Vector3(const float f3[3]);
+  explicit FORCEINLINE constexpr Vector3(const float f3[3]);
 
   /**
    *   Copy constructor.
    **/
-  FORCEINLINE Vector3(const Vector3& copyVector3);
+  FORCEINLINE constexpr Vector3(const Vector3& copyVector3);
 
   /**
    *    Constructor using the XYZ components from a 4D vector.
@@ -74,7 +74,7 @@ public:
    * @param Vector4
    *  The Vector4 where this vector wil;l take values.
    **/
-   //FORCEINLINE Vector3(const Vector4& vector4);
+   //FORCEINLINE constexpr Vector3(const Vector4& vector4);
 
     /*
      * Default destructor
@@ -96,7 +96,7 @@ public:
     * @return float
     *  The dot product from this vector against param.
     **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   dot(const Vector3& vector3) const;
 
   /**
@@ -107,7 +107,7 @@ public:
    *
    * @return
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   cross(const Vector3& vector3) const;
 
   /**
@@ -116,7 +116,7 @@ public:
    * @return Vector3
    *  The new created vector.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   getAbs() const;
 
   /**
@@ -125,7 +125,7 @@ public:
    * @return float
    *  Magnitude computed from this vector.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   magnitude() const;
 
   /**
@@ -134,7 +134,7 @@ public:
    * @return float
    *  Square magnitude computed from this vector.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   sqrMagnitude() const;
 
   /**
@@ -143,7 +143,7 @@ public:
    *
    * @return
    **/
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   normalize(float tolerance = Math::SMALL_NUMBER);
 
   /**
@@ -152,7 +152,7 @@ public:
    * @return Vector3
    *  The new normalized vector.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   getNormalized(float tolerance = Math::SMALL_NUMBER) const;
 
   /**
@@ -161,7 +161,7 @@ public:
    * @return Vector3
    *  Projected version of vector based on Z.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   projection(const Vector3& vector3) const;
 
   /**
@@ -176,7 +176,7 @@ public:
    * @return
    *   True if the two vector are almost equal.
    **/
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   nearEqual(const Vector3& v, const float& tolerance = Math::SMALL_NUMBER) const;
 
   /**
@@ -189,7 +189,7 @@ public:
    * @return
    *   Squared distance between two vectors.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   sqrDistance(const Vector3& v) const;
 
   /**
@@ -201,7 +201,7 @@ public:
    * @return
    *  Distance between two points.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   distance(const Vector3& v) const;
 
   /************************************************************************/
@@ -219,7 +219,7 @@ public:
   * @return
   *  true if both vectors are equal.
   */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Vector3& vector3) const;
 
   /**
@@ -231,7 +231,7 @@ public:
    * @return
    *  true if both vectors are equal.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(const Vector3& vector3) const;
 
   /**
@@ -243,7 +243,7 @@ public:
    * @return
    *  Vector2 new Vector2 created from this operation.
    */
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   operator*(float scalar) const;
 
   /**
@@ -255,12 +255,12 @@ public:
    * @return
    *  Vector2 new Vector2 created from this operation.
    */
-  FORCEINLINE Vector3&
+  FORCEINLINE constexpr Vector3&
   operator*=(float scalar);
 
   /*
   */
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   operator/(float scale) const;
 
   /**
@@ -272,7 +272,7 @@ public:
    * @return Vecto3
    *  The new vector created from adding other two vector.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   operator+(const Vector3& vector3) const;
 
   /**
@@ -284,7 +284,7 @@ public:
    * @return Vecto3
    *  This reference modified.
    **/
-  FORCEINLINE Vector3&
+  FORCEINLINE constexpr Vector3&
   operator+=(const Vector3& vector3);
 
   /**
@@ -296,7 +296,7 @@ public:
    * @return Vector3
    *  The new created vector.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   operator-(const Vector3& vector3) const;
 
   /**
@@ -308,7 +308,7 @@ public:
    * @return Vector3
    *  This vector reference modified.
    **/
-  FORCEINLINE Vector3&
+  FORCEINLINE constexpr Vector3&
   operator-=(const Vector3& vector3);
 
   /**
@@ -317,7 +317,7 @@ public:
    * @return
    *  A new vector3 created from this vector.
    **/
-  FORCEINLINE Vector3
+  FORCEINLINE constexpr Vector3
   operator-() const;
 
   /**
@@ -326,7 +326,7 @@ public:
    * @param vector3
    *  The other vector to be set.
    **/
-  FORCEINLINE Vector3&
+  FORCEINLINE constexpr Vector3&
   operator=(const Vector3& vector3);
 
 
@@ -336,7 +336,7 @@ public:
    * @return
    *  A new Array 2 x,y
    **/
-  FORCEINLINE Array<float, 2>
+  FORCEINLINE constexpr Array<float, 2>
   xy() const { return {x, y};}
 
 
@@ -346,7 +346,7 @@ public:
    * @return
    *  A new Array 3 x,y
    **/
-  FORCEINLINE Array<float, 3>
+  FORCEINLINE constexpr Array<float, 3>
   xyz() const { return {x, y, z};}
 
 private:
@@ -420,7 +420,7 @@ public:
  * @param v Vector to scale.
  * @return Result of multiplication.
  */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 operator*(float scale, const Vector3& v) {
   return v.operator*(scale);
 }
@@ -433,19 +433,19 @@ operator*(float scale, const Vector3& v) {
 
  /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector3::Vector3(float _x, float _y, float _z) : x(_x), y(_y), z(_z)
 {}
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector3::Vector3(const float f3[3]) : x(f3[0]), y(f3[1]), z(f3[2])
 {}
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector3::Vector3(const Vector3& copyVector)
   : x(copyVector.x),
     y(copyVector.y),
@@ -454,7 +454,7 @@ Vector3::Vector3(const Vector3& copyVector)
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector3::dot(const Vector3& vector3) const
 {
   return {x * vector3.x + y * vector3.y + z * vector3.z};
@@ -462,7 +462,7 @@ Vector3::dot(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::cross(const Vector3& vector3) const
 {
   return {y * vector3.z - z * vector3.y,
@@ -472,7 +472,7 @@ Vector3::cross(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::getAbs() const
 {
   return {Math::abs(x), Math::abs(y), Math::abs(z)};
@@ -480,7 +480,7 @@ Vector3::getAbs() const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector3::magnitude() const
 {
   return Math::sqrt(sqrMagnitude());
@@ -488,15 +488,15 @@ Vector3::magnitude() const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector3::sqrMagnitude() const
 {
-  return Math::pow(x, 2) + Math::pow(y, 2) + Math::pow(z, 2);
+  return x * x + y * y + z * z;
 }
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector3::sqrDistance(const Vector3& v) const
 {
   return  (*this - v).sqrMagnitude();
@@ -504,7 +504,7 @@ Vector3::sqrDistance(const Vector3& v) const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector3::distance(const Vector3& v) const
 {
   return Math::sqrt(sqrDistance(v));
@@ -512,7 +512,7 @@ Vector3::distance(const Vector3& v) const
 
 /*
 */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Vector3::normalize(float tolerance)
 {
   const float SquareMag = sqrMagnitude();
@@ -528,7 +528,7 @@ Vector3::normalize(float tolerance)
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::getNormalized(float tolerance) const
 {
   Vector3 Res = *this;
@@ -536,7 +536,7 @@ Vector3::getNormalized(float tolerance) const
   return Res;
 }
 
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::projection(const Vector3& vector3) const
 {
   return (vector3 * ((dot(vector3)) / (vector3.dot( vector3))));
@@ -544,7 +544,7 @@ Vector3::projection(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector3::nearEqual( const Vector3 &v, const float &tolerance /*= Math::SMALL_NUMBER*/ ) const
 {
   return (Math::abs(v.x - x) <= tolerance) &&
@@ -554,7 +554,7 @@ Vector3::nearEqual( const Vector3 &v, const float &tolerance /*= Math::SMALL_NUM
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector3::operator==(const Vector3& vector3) const
 {
   return x == vector3.x && y == vector3.y && z == vector3.z;
@@ -562,7 +562,7 @@ Vector3::operator==(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector3::operator!=(const Vector3& vector3) const
 {
   return x != vector3.x || y != vector3.y || z != vector3.z;
@@ -571,7 +571,7 @@ Vector3::operator!=(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::operator*(float scalar) const
 {
   return {x * scalar, y * scalar, z * scalar};
@@ -579,7 +579,7 @@ Vector3::operator*(float scalar) const
 
 /*
 */
-FORCEINLINE Vector3&
+FORCEINLINE constexpr Vector3&
 Vector3::operator*=(float scalar)
 {
   x*= scalar;
@@ -589,7 +589,7 @@ Vector3::operator*=(float scalar)
 }
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::operator+(const Vector3& vector3) const
 {
   return {x + vector3.x, y + vector3.y, z + vector3.z};
@@ -597,7 +597,7 @@ Vector3::operator+(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE Vector3&
+FORCEINLINE constexpr Vector3&
 Vector3::operator+=(const Vector3& vector3)
 {
   x += vector3.x;
@@ -608,7 +608,7 @@ Vector3::operator+=(const Vector3& vector3)
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::operator-(const Vector3& vector3) const
 {
   return {x - vector3.x, y - vector3.y, z - vector3.z};
@@ -616,7 +616,7 @@ Vector3::operator-(const Vector3& vector3) const
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::operator/(float scale) const {
   const float RScale = 1.f / scale;
   return { x * RScale, y * RScale, z * RScale };
@@ -624,7 +624,7 @@ Vector3::operator/(float scale) const {
 
 /*
 */
-FORCEINLINE Vector3&
+FORCEINLINE constexpr Vector3&
 Vector3::operator-=(const Vector3& vector3)
 {
   x -= vector3.x;
@@ -635,7 +635,7 @@ Vector3::operator-=(const Vector3& vector3)
 
 /*
 */
-FORCEINLINE Vector3
+FORCEINLINE constexpr Vector3
 Vector3::operator-() const
 {
   return {-x, -y, -z};
@@ -643,7 +643,7 @@ Vector3::operator-() const
 
 /*
 */
-FORCEINLINE Vector3&
+FORCEINLINE constexpr Vector3&
 Vector3::operator=(const Vector3& vector3)
 {
   x = vector3.x;
@@ -652,5 +652,20 @@ Vector3::operator=(const Vector3& vector3)
   return *this;
 }
 
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Vector3 Vector3::ZERO = Vector3(0.0f, 0.0f, 0.0f);
+inline constexpr Vector3 Vector3::UNIT = Vector3(1.0f, 1.0f, 1.0f);
+
+inline constexpr Vector3 Vector3::RIGHT = Vector3(0.0f, 1.0f, 0.0f);
+inline constexpr Vector3 Vector3::LEFT = Vector3::RIGHT * -1.0f;
+
+inline constexpr Vector3 Vector3::UP = Vector3(0.0f, 0.0f, 1.0f);
+inline constexpr Vector3 Vector3::DOWN = Vector3::UP * -1.0f;
 
+inline constexpr Vector3 Vector3::FORWARD = Vector3(1.0f, 0.0f, 0.0f);
+inline constexpr Vector3 Vector3::BACKWARD = Vector3::FORWARD * -1.0f;
 }
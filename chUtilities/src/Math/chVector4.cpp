@@ -19,10 +19,6 @@
 
 namespace chEngineSDK{
 
-const Vector4 Vector4::ZERO = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-
-const Vector4 Vector4::UNIT = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-
 /*
 */
 Vector4::Vector4(const Vector3& vector3, const float& _w)
@@ -43,24 +43,24 @@ public:
   /*
    * @brief Default constructor
    */
-  FORCEINLINE Vector4() = default;
+  FORCEINLINE constexpr Vector4() = default;
 
   /**
    *   Constructor from 4 floats.
    * NOTE: W can be ignored since it initializes as 1.0f
    **/
-  FORCEINLINE Vector4(float _x, const float& _y, const float& _z, const float& _w = 1.0f);
+  FORCEINLINE constexpr Vector4(float _x, const float& _y, const float& _z, const float& _w = 1.0f);
 
   /**
    *   Constructor from an 4 Array.
    **/
-  explicit FORCEINLINE Vector4(const float arrayV4[4]);
+  explicit FORCEINLINE constexpr Vector4(const float arrayV4[4]);
 
 
   /**
    *   Constructor from an 4 Array.
    **/
-  explicit FORCEINLINE Vector4(const Array<float, 4> arrayV4);
+  explicit FORCEINLINE constexpr Vector4(const Array<float, 4> arrayV4);
 
   /**
    *   Constructor from Vector4
@@ -71,7 +71,7 @@ public:
   /**
    *   Copy constructor.
    **/
-  FORCEINLINE Vector4(const Vector4& copyVector4);
+  FORCEINLINE constexpr Vector4(const Vector4& copyVector4);
   /*
    * @brief Default destructor
    */
@@ -92,7 +92,7 @@ public:
     * @return float
     *  The dot product from this vector against param.
     **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   dot(const Vector4& vector4) const;
 
   /**
@@ -103,7 +103,7 @@ public:
    *
    * @return
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   cross(const Vector4& vector4) const;
 
   /**
@@ -112,7 +112,7 @@ public:
    * @return Vector4
    *  The new created vector.
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   getAbs() const;
 
   /**
@@ -121,7 +121,7 @@ public:
    * @return float
    *  Magnitude computed from this vector.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   magnitude() const;
 
   /**
@@ -130,7 +130,7 @@ public:
    * @return float
    *  Square magnitude computed from this vector.
    **/
-  FORCEINLINE float
+  FORCEINLINE constexpr float
   sqrMagnitude() const;
 
   /**
@@ -139,7 +139,7 @@ public:
    *
    * @return
    **/
-  FORCEINLINE void
+  FORCEINLINE constexpr void
   normalize(float tolerance = Math::SMALL_NUMBER);
 
   /**
@@ -148,10 +148,10 @@ public:
    * @return Vector4
    *  The new normalized vector.
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   getNormalized(float tolerance = Math::SMALL_NUMBER) const;
 
-  NODISCARD FORCEINLINE bool
+  NODISCARD FORCEINLINE constexpr bool
   nearEqual(const Vector4& v, const float& tolerance = Math::SMALL_NUMBER) const;
 
   /************************************************************************/
@@ -169,7 +169,7 @@ public:
     * @return
     *  true if both vectors are equal.
     */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Vector4& vector4) const;
 
   /**
@@ -181,7 +181,7 @@ public:
    * @return
    *  true if both vectors are equal.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator==(const Array<float, 4>& v4) const;
 
   /**
@@ -193,7 +193,7 @@ public:
    * @return
    *  true if both vectors are equal.
    */
-  FORCEINLINE bool
+  FORCEINLINE constexpr bool
   operator!=(const Vector4& vector4) const;
 
   /**
@@ -205,7 +205,7 @@ public:
    * @return
    *  Vector2 new Vector2 created from this operation.
    */
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   operator*(float scalar) const;
 
   /**
@@ -217,7 +217,7 @@ public:
    * @return
    *  Vector2 new Vector2 created from this operation.
    */
-  FORCEINLINE Vector4&
+  FORCEINLINE constexpr Vector4&
   operator*=(float scalar);
 
   /**
@@ -229,7 +229,7 @@ public:
    * @return Vecto3
    *  The new vector created from adding other two vector.
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   operator+(const Vector4& vector4) const;
 
   /**
@@ -241,7 +241,7 @@ public:
    * @return Vecto3
    *  This reference modified.
    **/
-  FORCEINLINE Vector4&
+  FORCEINLINE constexpr Vector4&
   operator+=(const Vector4& vector4);
 
   /**
@@ -253,7 +253,7 @@ public:
    * @return Vector4
    *  The new created vector.
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   operator-(const Vector4& vector4) const;
 
   /**
@@ -265,7 +265,7 @@ public:
    * @return Vector4
    *  This vector reference modified.
    **/
-  FORCEINLINE Vector4&
+  FORCEINLINE constexpr Vector4&
   operator-=(const Vector4& vector4);
 
   /**
@@ -274,7 +274,7 @@ public:
    * @return
    *  A new vector4 created from this vector.
    **/
-  FORCEINLINE Vector4
+  FORCEINLINE constexpr Vector4
   operator-() const;
 
   /**
@@ -283,7 +283,7 @@ public:
    * @param vector3
    *  The other vector to be set.
    **/
-  FORCEINLINE Vector4&
+  FORCEINLINE constexpr Vector4&
   operator=(const Vector4& vector4);
 
 
@@ -293,7 +293,7 @@ public:
    * @return
    *  A new Array 2 x,y
    **/
-  FORCEINLINE Array<float, 2>
+  FORCEINLINE constexpr Array<float, 2>
   xy() const { return {x, y};}
 
 
@@ -303,7 +303,7 @@ public:
    * @return
    *  A new Array 3 x,y,z
    **/
-  FORCEINLINE Array<float, 3>
+  FORCEINLINE constexpr Array<float, 3>
   xyz() const { return {x, y, z};}
 
   /**
@@ -312,7 +312,7 @@ public:
    * @return
    *  A new Array 4 x,y,z,w
    **/
-  FORCEINLINE Array<float, 4>
+  FORCEINLINE constexpr Array<float, 4>
   xyzw() const { return {x, y, z, w};}
 
 private:
@@ -368,7 +368,7 @@ public:
 
  /*
  */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector4::Vector4(float _x,
                  const float& _y,
                  const float& _z,
@@ -381,7 +381,7 @@ Vector4::Vector4(float _x,
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector4::Vector4(const float arayV4[4])
   : x(arayV4[0]),
     y(arayV4[1]),
@@ -391,7 +391,7 @@ Vector4::Vector4(const float arayV4[4])
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector4::Vector4(const Array<float, 4> arayV4)
   : x(arayV4[0]),
     y(arayV4[1]),
@@ -401,7 +401,7 @@ Vector4::Vector4(const Array<float, 4> arayV4)
 
 /*
 */
-FORCEINLINE
+FORCEINLINE constexpr
 Vector4::Vector4(const Vector4& copyVector)
   : x(copyVector.x),
     y(copyVector.y),
@@ -411,7 +411,7 @@ Vector4::Vector4(const Vector4& copyVector)
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector4::dot(const Vector4& vector4) const
 {
   return x * vector4.x + y * vector4.y + z * vector4.z + w * vector4.w;
@@ -419,7 +419,7 @@ Vector4::dot(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::cross(const Vector4& vector4) const
 {
   return {y * vector4.z - z * vector4.y,
@@ -430,7 +430,7 @@ Vector4::cross(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::getAbs() const
 {
   return {Math::abs(x), Math::abs(y), Math::abs(z), Math::abs(w)};
@@ -438,7 +438,7 @@ Vector4::getAbs() const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector4::magnitude() const
 {
   return Math::sqrt(sqrMagnitude());
@@ -446,15 +446,15 @@ Vector4::magnitude() const
 
 /*
 */
-FORCEINLINE float
+FORCEINLINE constexpr float
 Vector4::sqrMagnitude() const
 {
-  return Math::pow(x, 2.0f) + Math::pow(y, 2.0f) + Math::pow(z, 2.0f) + Math::pow(w, 2.0f);
+  return x * x + y * y + z * z + w * w;
 }
 
 /*
 */
-FORCEINLINE void
+FORCEINLINE constexpr void
 Vector4::normalize(float tolerance /*= Math::SMALL_NUMBER*/)
 {
   const float SquareSum = x * x + y * y + z * z;
@@ -471,7 +471,7 @@ Vector4::normalize(float tolerance /*= Math::SMALL_NUMBER*/)
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector4::nearEqual(const Vector4& v, const float& tolerance /*= Math::SMALL_NUMBER*/) const
 {
   return (Math::abs(v.x - x) <= tolerance) &&
@@ -482,7 +482,7 @@ Vector4::nearEqual(const Vector4& v, const float& tolerance /*= Math::SMALL_NUMB
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::getNormalized(float tolerance /*= Math::SMALL_NUMBER*/) const
 {
   Vector4 Res = *this;
@@ -492,7 +492,7 @@ Vector4::getNormalized(float tolerance /*= Math::SMALL_NUMBER*/) const
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::operator*(float scalar) const
 {
   return {x * scalar, y * scalar, z * scalar, w *scalar};
@@ -500,7 +500,7 @@ Vector4::operator*(float scalar) const
 
 /*
 */
-FORCEINLINE Vector4&
+FORCEINLINE constexpr Vector4&
 Vector4::operator*=(float scalar)
 {
   x *= scalar;
@@ -512,7 +512,7 @@ Vector4::operator*=(float scalar)
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::operator+(const Vector4& vector4) const
 {
   return {x + vector4.x, y + vector4.y, z + vector4.z, w + vector4.w};
@@ -520,7 +520,7 @@ Vector4::operator+(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE Vector4&
+FORCEINLINE constexpr Vector4&
 Vector4::operator+=(const Vector4& vector4)
 {
   x += vector4.x;
@@ -532,7 +532,7 @@ Vector4::operator+=(const Vector4& vector4)
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::operator-(const Vector4& vector4) const
 {
   return {x - vector4.x, y - vector4.y, z - vector4.z, w - vector4.w};
@@ -540,7 +540,7 @@ Vector4::operator-(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE Vector4&
+FORCEINLINE constexpr Vector4&
 Vector4::operator-=(const Vector4& vector4)
 {
   x -= vector4.x;
@@ -552,7 +552,7 @@ Vector4::operator-=(const Vector4& vector4)
 
 /*
 */
-FORCEINLINE Vector4
+FORCEINLINE constexpr Vector4
 Vector4::operator-() const
 {
   return {-x, -y, -z, -w};
@@ -560,7 +560,7 @@ Vector4::operator-() const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector4::operator!=(const Vector4& vector4) const
 {
   return x != vector4.x || y != vector4.y || z != vector4.z || w != vector4.w;
@@ -568,7 +568,7 @@ Vector4::operator!=(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector4::operator==(const Vector4& vector4) const
 {
   return x == vector4.x && y == vector4.y && z == vector4.z && w == vector4.w;
@@ -576,7 +576,7 @@ Vector4::operator==(const Vector4& vector4) const
 
 /*
 */
-FORCEINLINE bool
+FORCEINLINE constexpr bool
 Vector4::operator==(const Array<float, 4>& v4) const
 {
   return x == v4[0] && y == v4[1] && z == v4[2] && w == v4[3];
@@ -584,7 +584,7 @@ Vector4::operator==(const Array<float, 4>& v4) const
 
 /*
 */
-FORCEINLINE Vector4&
+FORCEINLINE constexpr Vector4&
 Vector4::operator=(const Vector4& vector4)
 {
   x = vector4.x;
@@ -593,4 +593,13 @@ Vector4::operator=(const Vector4& vector4)
   w = vector4.w;
   return *this;
 }
+
+/************************************************************************/
+/*
+ * Constants
+ */
+/************************************************************************/
+inline constexpr Vector4 Vector4::ZERO = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+inline constexpr Vector4 Vector4::UNIT = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
 }
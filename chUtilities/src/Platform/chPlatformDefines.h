@@ -167,7 +167,7 @@
  * Find the architecture type
  */
  /************************************************************************/
-#if defined (__x86_x64__) || defined(_M_X64)    //If this is a x64 compile
+#if defined (__x86_64__) || defined(_M_X64)    //If this is a x64 compile
 # define CH_ARCHITECTURE_X86_64             IN_USE
 # define CH_ARCHITECTURE_X86_32             NOT_IN_USE
 #else                                         //If it's a x86 compile
@@ -175,6 +175,17 @@
 # define CH_ARCHITECTURE_X86_32             IN_USE
 #endif
 
+/************************************************************************/
+/**
+ * SIMD instruction sets available at compile time
+ */
+ /************************************************************************/
+#if defined (__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define CH_SIMD_SSE2                       IN_USE
+#else
+# define CH_SIMD_SSE2                       NOT_IN_USE
+#endif
+
 /************************************************************************/
 /**
  * Memory Alignment macros
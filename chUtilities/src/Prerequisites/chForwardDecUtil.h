@@ -21,6 +21,7 @@ class Vector2;
 class Vector3;
 class Vector4;
 class Matrix4;
+class Matrix3x4;
 
 class Rotator;
 class Quaternion;
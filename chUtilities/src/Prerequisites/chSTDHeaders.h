@@ -77,6 +77,7 @@
 /************************************************************************/
 #include <mutex>
 #include <thread>
+#include <condition_variable>
 
 #include <optional>
 #include <variant>
@@ -335,6 +336,17 @@ using Mutex = std::mutex;
 template<typename Mutex>
 using LockGuard = std::lock_guard<Mutex>;
 
+/**
+ * @brief Wrapper for unique_lock.
+ */
+template<typename Mutex>
+using UniqueLock = std::unique_lock<Mutex>;
+
+/**
+ * @brief Wrapper for the C++ condition_variable.
+ */
+using ConditionVariable = std::condition_variable;
+
 /**
  * @brief Wrapper for the C++ std::atomic.
  */
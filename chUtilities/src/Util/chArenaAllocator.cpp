@@ -0,0 +1,118 @@
+/************************************************************************/
+/**
+ * @file chArenaAllocator.cpp
+ * @author AccelMR
+ * @date 2025/07/29
+ * @brief
+ *  Block based bump allocator implementation.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chArenaAllocator.h"
+
+#include "chMath.h"
+
+namespace chEngineSDK {
+
+/*
+*/
+ArenaAllocator::ArenaAllocator(SIZE_T blockSize)
+  : m_blockSize(blockSize)
+{}
+
+/*
+*/
+ArenaAllocator::~ArenaAllocator() {
+  for (const Block& block : m_blocks) {
+    ::operator delete(block.data, std::align_val_t(alignof(std::max_align_t)));
+  }
+}
+
+/*
+*/
+void*
+ArenaAllocator::allocate(SIZE_T size, SIZE_T alignment) {
+  CH_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  CH_ASSERT(alignment <= alignof(std::max_align_t));
+
+  SIZE_T alignedOffset = (m_offset + alignment - 1) & ~(alignment - 1);
+  if (m_blocks.empty() || alignedOffset + size > m_blocks.back().size) {
+    addBlock(size);
+    alignedOffset = 0;
+  }
+
+  m_usedBytes += alignedOffset + size - m_offset;
+  m_offset = alignedOffset + size;
+  return m_blocks.back().data + alignedOffset;
+}
+
+/*
+*/
+void
+ArenaAllocator::deallocate(void* ptr, SIZE_T size) {
+  if (!ptr || m_blocks.empty()) {
+    return;
+  }
+
+  const Block& block = m_blocks.back();
+  uint8* bytes = static_cast<uint8*>(ptr);
+  if (bytes + size == block.data + m_offset) {
+    m_usedBytes -= size;
+    m_offset -= size;
+  }
+}
+
+/*
+*/
+void
+ArenaAllocator::reserve(SIZE_T bytes) {
+  if (m_blocks.empty() || m_offset + bytes > m_blocks.back().size) {
+    addBlock(bytes);
+  }
+}
+
+/*
+*/
+void
+ArenaAllocator::reset() {
+  if (m_blocks.empty()) {
+    return;
+  }
+
+  for (SIZE_T i = 1; i < m_blocks.size(); ++i) {
+    ::operator delete(m_blocks[i].data, std::align_val_t(alignof(std::max_align_t)));
+  }
+  m_blocks.resize(1);
+  m_reservedBytes = m_blocks[0].size;
+  m_offset = 0;
+  m_usedBytes = 0;
+}
+
+/*
+ * Blocks are never chained back, the space left in the previous one is lost until reset.
+ */
+void
+ArenaAllocator::addBlock(SIZE_T minSize) {
+  const SIZE_T size = Math::max(minSize, m_blockSize);
+  uint8* data = static_cast<uint8*>(
+      ::operator new(size, std::align_val_t(alignof(std::max_align_t))));
+
+  // An unused current block is swapped for the bigger one instead of being kept around.
+  if (!m_blocks.empty() && m_offset == 0) {
+    m_reservedBytes -= m_blocks.back().size;
+    ::operator delete(m_blocks.back().data, std::align_val_t(alignof(std::max_align_t)));
+    m_blocks.back() = Block{data, size};
+  }
+  else {
+    m_blocks.push_back(Block{data, size});
+  }
+
+  m_reservedBytes += size;
+  m_offset = 0;
+}
+} // namespace chEngineSDK
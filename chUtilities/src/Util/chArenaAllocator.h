@@ -0,0 +1,180 @@
+/************************************************************************/
+/**
+ * @file chArenaAllocator.h
+ * @author AccelMR
+ * @date 2025/07/29
+ * @brief
+ *  Block based bump allocator and the std allocator adapter on top of it.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Hands out memory by bumping an offset inside big blocks. Single allocations are
+ *     never returned to the system, everything is released at once by reset() or when the
+ *     arena is destroyed. Destructors of objects placed in the arena are not called.
+ *
+ *     Not thread safe.
+ *
+ * Sample usage:
+ *  ArenaAllocator arena;
+ *  Node* node = arena.construct<Node>(name);
+ *  ...
+ *  node->~Node();
+ *  arena.reset();
+ */
+class CH_UTILITY_EXPORT ArenaAllocator
+{
+ public:
+  static constexpr SIZE_T DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  explicit ArenaAllocator(SIZE_T blockSize = DEFAULT_BLOCK_SIZE);
+  ~ArenaAllocator();
+
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator&
+  operator=(const ArenaAllocator&) = delete;
+
+  /**
+   *   Returns size bytes aligned to alignment, requests bigger than the block size get a
+   *   block of their own.
+   **/
+  NODISCARD void*
+  allocate(SIZE_T size, SIZE_T alignment = alignof(std::max_align_t));
+
+  /**
+   *   Only gives the memory back when it is the last allocation, which lets a growing
+   *   container reuse its own tail. Anything else waits for reset().
+   **/
+  void
+  deallocate(void* ptr, SIZE_T size);
+
+  template<typename T, typename... Args>
+  NODISCARD T*
+  construct(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /**
+   *   Makes sure the next bytes can be allocated without a new block.
+   **/
+  void
+  reserve(SIZE_T bytes);
+
+  /**
+   *   Releases every block but the first one, which is kept for reuse.
+   **/
+  void
+  reset();
+
+  /**
+   *   Bytes handed out since the last reset, alignment padding included.
+   **/
+  NODISCARD FORCEINLINE SIZE_T
+  getUsedBytes() const {
+    return m_usedBytes;
+  }
+
+  /**
+   *   Bytes owned by the arena, used or not.
+   **/
+  NODISCARD FORCEINLINE SIZE_T
+  getReservedBytes() const {
+    return m_reservedBytes;
+  }
+
+  NODISCARD FORCEINLINE SIZE_T
+  getBlockCount() const {
+    return m_blocks.size();
+  }
+
+ private:
+  struct Block
+  {
+    uint8* data;
+    SIZE_T size;
+  };
+
+  void
+  addBlock(SIZE_T minSize);
+
+  Vector<Block> m_blocks;
+  SIZE_T m_blockSize;
+  SIZE_T m_offset = 0;
+  SIZE_T m_usedBytes = 0;
+  SIZE_T m_reservedBytes = 0;
+};
+
+/*
+ * Description:
+ *     Std allocator that takes its memory from an ArenaAllocator, so containers can be
+ *     released in bulk together with the arena. Without an arena it falls back to the
+ *     global heap.
+ *
+ * Sample usage:
+ *  Vector<uint32, ArenaStdAllocator<uint32>> values{ArenaStdAllocator<uint32>(&arena)};
+ */
+template<typename T>
+class ArenaStdAllocator
+{
+ public:
+  using value_type = T;
+
+  ArenaStdAllocator() noexcept = default;
+
+  explicit ArenaStdAllocator(ArenaAllocator* arena) noexcept
+    : m_arena(arena)
+  {}
+
+  template<typename U>
+  ArenaStdAllocator(const ArenaStdAllocator<U>& other) noexcept
+    : m_arena(other.getArena())
+  {}
+
+  NODISCARD T*
+  allocate(SIZE_T count) {
+    if (m_arena) {
+      return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    return Alloc<T>().allocate(count);
+  }
+
+  void
+  deallocate(T* ptr, SIZE_T count) noexcept {
+    if (m_arena) {
+      m_arena->deallocate(ptr, count * sizeof(T));
+      return;
+    }
+    Alloc<T>().deallocate(ptr, count);
+  }
+
+  NODISCARD FORCEINLINE ArenaAllocator*
+  getArena() const noexcept {
+    return m_arena;
+  }
+
+  template<typename U>
+  NODISCARD FORCEINLINE bool
+  operator==(const ArenaStdAllocator<U>& other) const noexcept {
+    return m_arena == other.getArena();
+  }
+
+  template<typename U>
+  NODISCARD FORCEINLINE bool
+  operator!=(const ArenaStdAllocator<U>& other) const noexcept {
+    return m_arena != other.getArena();
+  }
+
+ private:
+  ArenaAllocator* m_arena = nullptr;
+};
+} // namespace chEngineSDK
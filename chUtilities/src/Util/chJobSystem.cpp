@@ -0,0 +1,271 @@
+/************************************************************************/
+/**
+ * @file chJobSystem.cpp
+ * @author AccelMR
+ * @date 2025/07/31
+ * @brief
+ *  Worker pool that balances jobs through per thread work stealing deques.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chJobSystem.h"
+
+namespace chEngineSDK {
+namespace {
+constexpr int64 DEQUE_MASK = JobSystem::DEQUE_CAPACITY - 1;
+static_assert((JobSystem::DEQUE_CAPACITY & DEQUE_MASK) == 0,
+              "Deque capacity must be a power of two.");
+
+thread_local const JobSystem* t_jobSystem = nullptr;
+thread_local int32 t_dequeIndex = -1;
+} // namespace
+
+/*
+*/
+bool
+JobSystem::WorkDeque::push(Task* task) {
+  const int64 bottom = m_bottom.load(std::memory_order_relaxed);
+  const int64 top = m_top.load(std::memory_order_acquire);
+  if (bottom - top >= static_cast<int64>(DEQUE_CAPACITY)) {
+    return false;
+  }
+
+  m_tasks[bottom & DEQUE_MASK].store(task, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  return true;
+}
+
+/*
+ * The last task is raced against thieves through the top index.
+ */
+JobSystem::Task*
+JobSystem::WorkDeque::pop() {
+  const int64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+  m_bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64 top = m_top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  Task* task = m_tasks[bottom & DEQUE_MASK].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+/*
+*/
+JobSystem::Task*
+JobSystem::WorkDeque::steal() {
+  int64 top = m_top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64 bottom = m_bottom.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+
+  Task* task = m_tasks[top & DEQUE_MASK].load(std::memory_order_relaxed);
+  if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return task;
+}
+
+/*
+*/
+JobSystem::JobSystem(uint32 workerCount) {
+  if (workerCount == 0) {
+    workerCount = Math::max(std::thread::hardware_concurrency(), 1u) - 1;
+  }
+
+  m_deques.reserve(workerCount + 1);
+  for (uint32 i = 0; i <= workerCount; ++i) {
+    m_deques.push_back(chMakeUnique<WorkDeque>());
+  }
+
+  t_jobSystem = this;
+  t_dequeIndex = 0;
+
+  m_workers.reserve(workerCount);
+  for (uint32 i = 1; i <= workerCount; ++i) {
+    m_workers.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+/*
+ * Jobs still queued are run before the workers stop, nothing is dropped.
+ */
+JobSystem::~JobSystem() {
+  const int32 ownDeque = getCurrentDeque();
+  while (m_queuedTasks.load() > 0) {
+    if (!runPendingJob(ownDeque)) {
+      std::this_thread::yield();
+    }
+  }
+
+  m_running.store(false);
+  {
+    LockGuard<Mutex> lock(m_sleepMutex);
+  }
+  m_wakeUp.notify_all();
+
+  for (Thread& worker : m_workers) {
+    worker.join();
+  }
+
+  if (t_jobSystem == this) {
+    t_jobSystem = nullptr;
+    t_dequeIndex = -1;
+  }
+}
+
+/*
+*/
+void
+JobSystem::schedule(Job job, JobCounter* counter) {
+  if (m_workers.empty()) {
+    job();
+    return;
+  }
+
+  Task* task = new Task{std::move(job), counter};
+  if (counter) {
+    counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  m_queuedTasks.fetch_add(1);
+  const int32 ownDeque = getCurrentDeque();
+  if (ownDeque >= 0) {
+    if (!m_deques[ownDeque]->push(task)) {
+      m_queuedTasks.fetch_sub(1);
+      execute(task);
+      return;
+    }
+  }
+  else {
+    LockGuard<Mutex> lock(m_sharedMutex);
+    m_sharedTasks.push_back(task);
+  }
+
+  // Pairs with the sleeping count raised before a worker checks the queue
+  if (m_sleepingWorkers.load() > 0) {
+    {
+      LockGuard<Mutex> lock(m_sleepMutex);
+    }
+    m_wakeUp.notify_one();
+  }
+}
+
+/*
+*/
+void
+JobSystem::wait(const JobCounter& counter) {
+  const int32 ownDeque = getCurrentDeque();
+  while (!counter.isDone()) {
+    if (!runPendingJob(ownDeque)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/*
+*/
+void
+JobSystem::workerLoop(uint32 dequeIndex) {
+  t_jobSystem = this;
+  t_dequeIndex = static_cast<int32>(dequeIndex);
+
+  while (m_running.load()) {
+    if (runPendingJob(t_dequeIndex)) {
+      continue;
+    }
+
+    UniqueLock<Mutex> lock(m_sleepMutex);
+    m_sleepingWorkers.fetch_add(1);
+    m_wakeUp.wait(lock, [this]() { return m_queuedTasks.load() > 0 || !m_running.load(); });
+    m_sleepingWorkers.fetch_sub(1);
+  }
+}
+
+/*
+*/
+bool
+JobSystem::runPendingJob(int32 ownDeque) {
+  Task* task = findTask(ownDeque);
+  if (!task) {
+    return false;
+  }
+
+  m_queuedTasks.fetch_sub(1);
+  execute(task);
+  return true;
+}
+
+/*
+ * Own work first while it is hot in cache, then the oldest work of everybody else.
+ */
+JobSystem::Task*
+JobSystem::findTask(int32 ownDeque) {
+  if (ownDeque >= 0) {
+    if (Task* task = m_deques[ownDeque]->pop()) {
+      return task;
+    }
+  }
+
+  {
+    LockGuard<Mutex> lock(m_sharedMutex);
+    if (!m_sharedTasks.empty()) {
+      Task* task = m_sharedTasks.front();
+      m_sharedTasks.pop_front();
+      return task;
+    }
+  }
+
+  const int32 dequeCount = static_cast<int32>(m_deques.size());
+  for (int32 i = 1; i <= dequeCount; ++i) {
+    const int32 victim = (ownDeque + i) % dequeCount;
+    if (victim == ownDeque) {
+      continue;
+    }
+    if (Task* task = m_deques[victim]->steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ * The counter can be destroyed by its waiter as soon as it reaches zero.
+ */
+void
+JobSystem::execute(Task* task) {
+  task->job();
+  JobCounter* counter = task->counter;
+  delete task;
+  if (counter) {
+    counter->m_pending.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+/*
+*/
+int32
+JobSystem::getCurrentDeque() const {
+  return t_jobSystem == this ? t_dequeIndex : -1;
+}
+} // namespace chEngineSDK
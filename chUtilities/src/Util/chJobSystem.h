@@ -0,0 +1,180 @@
+/************************************************************************/
+/**
+ * @file chJobSystem.h
+ * @author AccelMR
+ * @date 2025/07/31
+ * @brief
+ *  Worker pool that balances jobs through per thread work stealing deques.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chMath.h"
+#include "chModule.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Counts the jobs of a group that have not finished yet. Pass it to
+ *     JobSystem::schedule() and wait on it with JobSystem::wait(). It must outlive the
+ *     jobs it tracks.
+ */
+class JobCounter
+{
+ public:
+  NODISCARD FORCEINLINE bool
+  isDone() const {
+    return m_pending.load(std::memory_order_acquire) == 0;
+  }
+
+ private:
+  friend class JobSystem;
+
+  Atomic<uint32> m_pending{0};
+};
+
+/*
+ * Description:
+ *     Every worker owns a fixed size Chase-Lev deque, it pushes and pops its own jobs
+ *     at the bottom (newest first) while idle workers steal from the top (oldest first).
+ *     The thread that created the system owns a deque too, any other thread submits
+ *     through a shared locked queue.
+ *
+ *     Waiting never blocks: the waiting thread runs pending jobs until its counter is
+ *     done, so jobs can schedule and wait on other jobs. Without workers, jobs run inline
+ *     when they are scheduled.
+ *
+ * Sample usage:
+ *  JobSystem::startUp();
+ *  JobCounter counter;
+ *  JobSystem::instance().schedule([&]() { simulate(); }, &counter);
+ *  JobSystem::instance().wait(counter);
+ */
+class CH_UTILITY_EXPORT JobSystem : public Module<JobSystem>
+{
+ public:
+  using Job = Function<void()>;
+
+  static constexpr uint32 DEQUE_CAPACITY = 4096;
+
+  /**
+   *   workerCount 0 uses one worker per hardware thread but the calling one.
+   **/
+  explicit JobSystem(uint32 workerCount = 0);
+  ~JobSystem();
+
+  /**
+   *   Queues a job, counter is incremented now and decremented once the job has run.
+   *   A full deque runs the job inline.
+   **/
+  void
+  schedule(Job job, JobCounter* counter = nullptr);
+
+  /**
+   *   Runs pending jobs on the calling thread until every job tracked by counter is done.
+   **/
+  void
+  wait(const JobCounter& counter);
+
+  /**
+   *   Calls fn(begin, end) over [0, count) in batches of at least minBatchSize elements and
+   *   returns once every batch is done. Batches are kept small enough to be balanced.
+   **/
+  template<typename Fn>
+  void
+  parallelFor(SIZE_T count, SIZE_T minBatchSize, Fn&& fn) {
+    if (count == 0) {
+      return;
+    }
+
+    const SIZE_T threadCount = static_cast<SIZE_T>(getWorkerCount()) + 1;
+    const SIZE_T balancedSize = (count + threadCount * 4 - 1) / (threadCount * 4);
+    const SIZE_T batchSize =
+        Math::max(Math::max(minBatchSize, static_cast<SIZE_T>(1)), balancedSize);
+    if (batchSize >= count || threadCount == 1) {
+      fn(static_cast<SIZE_T>(0), count);
+      return;
+    }
+
+    JobCounter counter;
+    for (SIZE_T begin = batchSize; begin < count; begin += batchSize) {
+      const SIZE_T end = Math::min(begin + batchSize, count);
+      schedule([&fn, begin, end]() { fn(begin, end); }, &counter);
+    }
+
+    fn(static_cast<SIZE_T>(0), batchSize);
+    wait(counter);
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getWorkerCount() const {
+    return static_cast<uint32>(m_workers.size());
+  }
+
+ private:
+  struct Task
+  {
+    Job job;
+    JobCounter* counter;
+  };
+
+  /*
+   * Chase-Lev deque, only the owner calls push() and pop().
+   */
+  class WorkDeque
+  {
+   public:
+    bool
+    push(Task* task);
+
+    NODISCARD Task*
+    pop();
+
+    NODISCARD Task*
+    steal();
+
+   private:
+    Atomic<int64> m_top{0};
+    Atomic<int64> m_bottom{0};
+    Array<Atomic<Task*>, DEQUE_CAPACITY> m_tasks{};
+  };
+
+  void
+  workerLoop(uint32 dequeIndex);
+
+  /**
+   *   Takes a job from the own deque, the shared queue or another deque and runs it.
+   **/
+  bool
+  runPendingJob(int32 ownDeque);
+
+  NODISCARD Task*
+  findTask(int32 ownDeque);
+
+  void
+  execute(Task* task);
+
+  NODISCARD int32
+  getCurrentDeque() const;
+
+  // Index 0 belongs to the creating thread, the rest to the workers
+  Vector<UniquePtr<WorkDeque>> m_deques;
+  Vector<Thread> m_workers;
+
+  Mutex m_sharedMutex;
+  Deque<Task*> m_sharedTasks;
+
+  Mutex m_sleepMutex;
+  ConditionVariable m_wakeUp;
+  Atomic<int64> m_queuedTasks{0};
+  Atomic<uint32> m_sleepingWorkers{0};
+  Atomic<bool> m_running{true};
+};
+} // namespace chEngineSDK
@@ -0,0 +1,468 @@
+/************************************************************************/
+/**
+ * @file chMeshOptimizer.cpp
+ * @author AccelMR
+ * @date 2025/08/02
+ * @brief
+ *  Index and vertex buffer reordering for faster and smaller triangle meshes.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chMeshOptimizer.h"
+
+#include "chMath.h"
+#include "chVector3.h"
+
+namespace chEngineSDK {
+namespace {
+/*
+ * Forsyth's scoring, the LRU cache is larger than the real one so scores stay smooth.
+ */
+constexpr uint32 SCORE_CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+float
+getVertexScore(int32 cachePosition, uint32 liveTriangles) {
+  if (liveTriangles == 0) {
+    return -1.0f;
+  }
+
+  float score = 0.0f;
+  if (cachePosition >= 0) {
+    // The last triangle's vertices get a fixed score so it isn't reused right away
+    if (cachePosition < 3) {
+      score = LAST_TRIANGLE_SCORE;
+    }
+    else {
+      const float scaler = 1.0f / static_cast<float>(SCORE_CACHE_SIZE - 3);
+      score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler,
+                       CACHE_DECAY_POWER);
+    }
+  }
+
+  // Vertices with few triangles left are finished first to avoid lonely triangles
+  return score + VALENCE_BOOST_SCALE *
+                 std::pow(static_cast<float>(liveTriangles), -VALENCE_BOOST_POWER);
+}
+
+/*
+ * FIFO cache simulation, a vertex is a hit while fewer than cacheSize misses happened
+ * after its own. Advancing timestamp by cacheSize + 1 flushes the cache.
+ */
+uint32
+updateCache(const uint32* triangle,
+            uint32 cacheSize,
+            Vector<uint32>& timestamps,
+            uint32& timestamp) {
+  uint32 misses = 0;
+  for (uint32 k = 0; k < 3; ++k) {
+    const uint32 vertex = triangle[k];
+    if (timestamp - timestamps[vertex] > cacheSize) {
+      timestamps[vertex] = timestamp++;
+      ++misses;
+    }
+  }
+  return misses;
+}
+
+uint64
+hashVertex(const uint8* vertex, uint32 stride) {
+  uint64 hash = 14695981039346656037ull;
+  for (uint32 i = 0; i < stride; ++i) {
+    hash = (hash ^ vertex[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+Vector3
+getPosition(const uint8* positions, uint32 positionStride, uint32 vertex) {
+  const SIZE_T offset = static_cast<SIZE_T>(vertex) * positionStride;
+  const float* p = reinterpret_cast<const float*>(positions + offset);
+  return Vector3(p[0], p[1], p[2]);
+}
+} // namespace
+
+/*
+ * Open addressing table of vertex indices keyed by the vertex bytes.
+ */
+uint32
+MeshOptimizer::generateVertexRemap(const Vector<uint32>& indices,
+                                   const uint8* vertices,
+                                   uint32 vertexCount,
+                                   uint32 stride,
+                                   Vector<uint32>& outRemap) {
+  outRemap.assign(vertexCount, UNUSED_VERTEX);
+
+  SIZE_T tableSize = 16;
+  while (tableSize < static_cast<SIZE_T>(vertexCount) * 2) {
+    tableSize *= 2;
+  }
+  const SIZE_T tableMask = tableSize - 1;
+  Vector<uint32> table(tableSize, UNUSED_VERTEX);
+
+  uint32 uniqueCount = 0;
+  for (const uint32 index : indices) {
+    CH_ASSERT(index < vertexCount);
+    if (outRemap[index] != UNUSED_VERTEX) {
+      continue;
+    }
+
+    const uint8* vertex = vertices + static_cast<SIZE_T>(index) * stride;
+    SIZE_T slot = static_cast<SIZE_T>(hashVertex(vertex, stride)) & tableMask;
+    while (table[slot] != UNUSED_VERTEX &&
+           std::memcmp(vertices + static_cast<SIZE_T>(table[slot]) * stride,
+                       vertex, stride) != 0) {
+      slot = (slot + 1) & tableMask;
+    }
+
+    if (table[slot] == UNUSED_VERTEX) {
+      table[slot] = index;
+      outRemap[index] = uniqueCount++;
+    }
+    else {
+      outRemap[index] = outRemap[table[slot]];
+    }
+  }
+  return uniqueCount;
+}
+
+/*
+*/
+uint32
+MeshOptimizer::generateVertexFetchRemap(const Vector<uint32>& indices,
+                                        uint32 vertexCount,
+                                        Vector<uint32>& outRemap) {
+  outRemap.assign(vertexCount, UNUSED_VERTEX);
+
+  uint32 nextVertex = 0;
+  for (const uint32 index : indices) {
+    CH_ASSERT(index < vertexCount);
+    if (outRemap[index] == UNUSED_VERTEX) {
+      outRemap[index] = nextVertex++;
+    }
+  }
+  return nextVertex;
+}
+
+/*
+*/
+void
+MeshOptimizer::remapIndices(Vector<uint32>& indices, const Vector<uint32>& remap) {
+  for (uint32& index : indices) {
+    CH_ASSERT(remap[index] != UNUSED_VERTEX);
+    index = remap[index];
+  }
+}
+
+/*
+*/
+Vector<uint8>
+MeshOptimizer::remapVertices(const uint8* vertices,
+                             uint32 vertexCount,
+                             uint32 stride,
+                             const Vector<uint32>& remap,
+                             uint32 newVertexCount) {
+  Vector<uint8> result(static_cast<SIZE_T>(newVertexCount) * stride);
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    if (remap[i] == UNUSED_VERTEX) {
+      continue;
+    }
+    std::memcpy(result.data() + static_cast<SIZE_T>(remap[i]) * stride,
+                vertices + static_cast<SIZE_T>(i) * stride, stride);
+  }
+  return result;
+}
+
+/*
+ * Greedy: emit the best scored triangle among the ones touching the cache, when none is
+ * left fall back to the next triangle in input order.
+ */
+void
+MeshOptimizer::optimizeVertexCache(Vector<uint32>& indices, uint32 vertexCount) {
+  const SIZE_T triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return;
+  }
+
+  Vector<uint32> liveTriangles(vertexCount, 0);
+  for (const uint32 index : indices) {
+    CH_ASSERT(index < vertexCount);
+    ++liveTriangles[index];
+  }
+
+  // Triangles of every vertex, the live ones are kept at the front of each range
+  Vector<uint32> adjacencyOffsets(static_cast<SIZE_T>(vertexCount) + 1, 0);
+  for (uint32 v = 0; v < vertexCount; ++v) {
+    adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+  }
+
+  Vector<uint32> adjacency(indices.size());
+  Vector<uint32> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+  for (SIZE_T t = 0; t < triangleCount; ++t) {
+    for (SIZE_T k = 0; k < 3; ++k) {
+      adjacency[fillOffsets[indices[t * 3 + k]]++] = static_cast<uint32>(t);
+    }
+  }
+
+  Vector<int32> cachePositions(vertexCount, -1);
+  Vector<float> vertexScores(vertexCount);
+  for (uint32 v = 0; v < vertexCount; ++v) {
+    vertexScores[v] = getVertexScore(-1, liveTriangles[v]);
+  }
+
+  Vector<float> triangleScores(triangleCount);
+  for (SIZE_T t = 0; t < triangleCount; ++t) {
+    triangleScores[t] = vertexScores[indices[t * 3]] +
+                        vertexScores[indices[t * 3 + 1]] +
+                        vertexScores[indices[t * 3 + 2]];
+  }
+
+  Vector<uint8> emitted(triangleCount, 0);
+  Vector<uint32> result;
+  result.reserve(indices.size());
+
+  Array<uint32, SCORE_CACHE_SIZE + 3> cache;
+  Array<uint32, SCORE_CACHE_SIZE + 3> newCache;
+  uint32 cacheCount = 0;
+  SIZE_T inputCursor = 0;
+  int64 bestTriangle = -1;
+
+  for (SIZE_T emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+    if (bestTriangle < 0) {
+      while (emitted[inputCursor]) {
+        ++inputCursor;
+      }
+      bestTriangle = static_cast<int64>(inputCursor);
+    }
+
+    const SIZE_T triangle = static_cast<SIZE_T>(bestTriangle);
+    const uint32* vertices = &indices[triangle * 3];
+    emitted[triangle] = 1;
+    result.insert(result.end(), vertices, vertices + 3);
+
+    // The triangle's vertices move to the front of the cache
+    uint32 newCount = 0;
+    for (uint32 k = 0; k < 3; ++k) {
+      const uint32 vertex = vertices[k];
+      if (std::find(newCache.begin(), newCache.begin() + newCount, vertex) ==
+          newCache.begin() + newCount) {
+        newCache[newCount++] = vertex;
+      }
+
+      const uint32 begin = adjacencyOffsets[vertex];
+      const uint32 end = begin + liveTriangles[vertex];
+      for (uint32 i = begin; i < end; ++i) {
+        if (adjacency[i] == triangle) {
+          std::swap(adjacency[i], adjacency[end - 1]);
+          --liveTriangles[vertex];
+          break;
+        }
+      }
+    }
+
+    for (uint32 i = 0; i < cacheCount; ++i) {
+      const uint32 vertex = cache[i];
+      if (vertex != vertices[0] && vertex != vertices[1] && vertex != vertices[2]) {
+        newCache[newCount++] = vertex;
+      }
+    }
+
+    // Vertices pushed out only lose score, their triangles are no candidates any more
+    for (uint32 i = SCORE_CACHE_SIZE; i < newCount; ++i) {
+      cachePositions[newCache[i]] = -1;
+    }
+    cacheCount = Math::min(newCount, SCORE_CACHE_SIZE);
+
+    for (uint32 i = 0; i < newCount; ++i) {
+      const uint32 vertex = newCache[i];
+      if (i < cacheCount) {
+        cache[i] = vertex;
+        cachePositions[vertex] = static_cast<int32>(i);
+      }
+
+      const float score = getVertexScore(cachePositions[vertex], liveTriangles[vertex]);
+      const float delta = score - vertexScores[vertex];
+      vertexScores[vertex] = score;
+
+      const uint32 begin = adjacencyOffsets[vertex];
+      const uint32 end = begin + liveTriangles[vertex];
+      for (uint32 j = begin; j < end; ++j) {
+        triangleScores[adjacency[j]] += delta;
+      }
+    }
+
+    bestTriangle = -1;
+    float bestScore = 0.0f;
+    for (uint32 i = 0; i < cacheCount; ++i) {
+      const uint32 vertex = cache[i];
+      const uint32 begin = adjacencyOffsets[vertex];
+      const uint32 end = begin + liveTriangles[vertex];
+      for (uint32 j = begin; j < end; ++j) {
+        const uint32 candidate = adjacency[j];
+        if (bestTriangle < 0 || triangleScores[candidate] > bestScore) {
+          bestTriangle = candidate;
+          bestScore = triangleScores[candidate];
+        }
+      }
+    }
+  }
+
+  indices = std::move(result);
+}
+
+/*
+ * Clusters and their sort follow Sander et al, "Fast Triangle Reordering for Vertex
+ * Locality and Reduced Overdraw".
+ */
+void
+MeshOptimizer::optimizeOverdraw(Vector<uint32>& indices,
+                                const uint8* positions,
+                                uint32 positionStride,
+                                uint32 vertexCount,
+                                float threshold) {
+  const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+  if (triangleCount < 2) {
+    return;
+  }
+
+  const uint32 cacheSize = DEFAULT_CACHE_SIZE;
+  Vector<uint32> timestamps(vertexCount, 0);
+  uint32 timestamp = cacheSize + 1;
+
+  // Hard boundaries, triangles where every vertex misses the cache
+  Vector<uint32> hardClusters;
+  for (uint32 t = 0; t < triangleCount; ++t) {
+    const uint32 misses = updateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+    if (t == 0 || misses == 3) {
+      hardClusters.push_back(t);
+    }
+  }
+  hardClusters.push_back(triangleCount);
+
+  // Soft boundaries, split as soon as a cluster reaches the cache efficiency target
+  Vector<uint32> clusters;
+  for (SIZE_T c = 0; c + 1 < hardClusters.size(); ++c) {
+    const uint32 start = hardClusters[c];
+    const uint32 end = hardClusters[c + 1];
+
+    timestamp += cacheSize + 1;
+    uint32 clusterMisses = 0;
+    for (uint32 t = start; t < end; ++t) {
+      clusterMisses += updateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+    }
+    const float clusterThreshold =
+        threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+    clusters.push_back(start);
+    timestamp += cacheSize + 1;
+    uint32 runningMisses = 0;
+    uint32 runningTriangles = 0;
+    for (uint32 t = start; t < end; ++t) {
+      runningMisses += updateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+      ++runningTriangles;
+
+      if (static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <=
+          clusterThreshold) {
+        clusters.push_back(t + 1);
+        timestamp += cacheSize + 1;
+        runningMisses = 0;
+        runningTriangles = 0;
+      }
+    }
+
+    if (clusters.back() == end) {
+      clusters.pop_back();
+    }
+  }
+  clusters.push_back(triangleCount);
+
+  Vector3 meshCenter = Vector3::ZERO;
+  for (const uint32 index : indices) {
+    meshCenter += getPosition(positions, positionStride, index);
+  }
+  meshCenter = meshCenter / static_cast<float>(indices.size());
+
+  const SIZE_T clusterCount = clusters.size() - 1;
+  Vector<Pair<float, uint32>> sortKeys(clusterCount);
+  for (SIZE_T c = 0; c < clusterCount; ++c) {
+    Vector3 centroid = Vector3::ZERO;
+    Vector3 normal = Vector3::ZERO;
+    float area = 0.0f;
+    for (uint32 t = clusters[c]; t < clusters[c + 1]; ++t) {
+      const Vector3 p0 = getPosition(positions, positionStride, indices[t * 3]);
+      const Vector3 p1 = getPosition(positions, positionStride, indices[t * 3 + 1]);
+      const Vector3 p2 = getPosition(positions, positionStride, indices[t * 3 + 2]);
+      const Vector3 triangleNormal = (p1 - p0).cross(p2 - p0);
+      const float triangleArea = triangleNormal.magnitude();
+
+      centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+      normal += triangleNormal;
+      area += triangleArea;
+    }
+
+    float key = 0.0f;
+    const float normalLength = normal.magnitude();
+    if (area > 0.0f && normalLength > 0.0f) {
+      key = (centroid / area - meshCenter).dot(normal / normalLength);
+    }
+    sortKeys[c] = {key, static_cast<uint32>(c)};
+  }
+
+  // Outward facing clusters first, stable so equal keys keep the cache friendly order
+  std::stable_sort(sortKeys.begin(), sortKeys.end(),
+                   [](const Pair<float, uint32>& a, const Pair<float, uint32>& b) {
+                     return a.first > b.first;
+                   });
+
+  Vector<uint32> result;
+  result.reserve(indices.size());
+  for (const Pair<float, uint32>& sortKey : sortKeys) {
+    const uint32 cluster = sortKey.second;
+    result.insert(result.end(),
+                  indices.begin() + static_cast<SIZE_T>(clusters[cluster]) * 3,
+                  indices.begin() + static_cast<SIZE_T>(clusters[cluster + 1]) * 3);
+  }
+  indices = std::move(result);
+}
+
+/*
+*/
+VertexCacheStats
+MeshOptimizer::analyzeVertexCache(const Vector<uint32>& indices,
+                                  uint32 vertexCount,
+                                  uint32 cacheSize) {
+  VertexCacheStats stats;
+  const SIZE_T triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return stats;
+  }
+
+  Vector<uint32> timestamps(vertexCount, 0);
+  uint32 timestamp = cacheSize + 1;
+  for (SIZE_T t = 0; t < triangleCount; ++t) {
+    stats.transformedVertices +=
+        updateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+  }
+
+  uint32 referencedVertices = 0;
+  Vector<uint8> referenced(vertexCount, 0);
+  for (const uint32 index : indices) {
+    referencedVertices += referenced[index] == 0 ? 1 : 0;
+    referenced[index] = 1;
+  }
+
+  stats.acmr = static_cast<float>(stats.transformedVertices) /
+               static_cast<float>(triangleCount);
+  stats.atvr = static_cast<float>(stats.transformedVertices) /
+               static_cast<float>(referencedVertices);
+  return stats;
+}
+} // namespace chEngineSDK
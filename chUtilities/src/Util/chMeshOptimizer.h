@@ -0,0 +1,155 @@
+/************************************************************************/
+/**
+ * @file chMeshOptimizer.h
+ * @author AccelMR
+ * @date 2025/08/02
+ * @brief
+ *  Index and vertex buffer reordering for faster and smaller triangle meshes.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Post-transform vertex cache statistics of an index buffer.
+ *     acmr is the average transformed vertices per triangle (0.5 is the best a regular
+ *     grid can get, 3 the worst), atvr the transformed vertices per referenced vertex
+ *     (1 is optimal).
+ */
+struct VertexCacheStats
+{
+  float acmr = 0.0f;
+  float atvr = 0.0f;
+  uint32 transformedVertices = 0;
+};
+
+/*
+ * Description:
+ *     Optimization passes for indexed triangle lists, meant to run once at import time.
+ *     Indices are always uint32 here, vertices are raw bytes of a fixed stride. The usual
+ *     order is:
+ *       1. generateVertexRemap + remapIndices/remapVertices to drop duplicated vertices.
+ *       2. optimizeVertexCache to reorder triangles for the post-transform cache.
+ *       3. optimizeOverdraw to sort triangle clusters front to back, keeping most of 2.
+ *       4. generateVertexFetchRemap + remapIndices/remapVertices so vertices are stored in
+ *          the order they are first used.
+ *
+ * Sample usage:
+ *  Vector<uint32> remap;
+ *  uint32 unique =
+ *      MeshOptimizer::generateVertexRemap(indices, vertices.data(), count, stride, remap);
+ *  MeshOptimizer::remapIndices(indices, remap);
+ *  vertices = MeshOptimizer::remapVertices(vertices.data(), count, stride, remap, unique);
+ *  MeshOptimizer::optimizeVertexCache(indices, unique);
+ */
+class CH_UTILITY_EXPORT MeshOptimizer
+{
+ public:
+  /**
+   * Remap value of vertices that no index references.
+   */
+  static constexpr uint32 UNUSED_VERTEX = 0xFFFFFFFF;
+
+  /**
+   * FIFO size used by analyzeVertexCache by default, close to what current GPUs reuse.
+   */
+  static constexpr uint32 DEFAULT_CACHE_SIZE = 16;
+
+  /**
+   * Find vertices with identical bytes and build a remap table to unique vertices
+   * Unique vertices are numbered in the order the indices first reference them.
+   *
+   * @param indices Triangle list indices
+   * @param vertices Vertex data, vertexCount * stride bytes
+   * @param vertexCount Number of vertices
+   * @param stride Size of a vertex in bytes
+   * @param outRemap Receives the new index of every vertex, or UNUSED_VERTEX
+   * @return Number of unique referenced vertices
+   */
+  static uint32
+  generateVertexRemap(const Vector<uint32>& indices,
+                      const uint8* vertices,
+                      uint32 vertexCount,
+                      uint32 stride,
+                      Vector<uint32>& outRemap);
+
+  /**
+   * Build a remap table that stores vertices in the order the indices first use them,
+   * so the vertex fetch reads memory mostly forward. Unreferenced vertices are dropped.
+   *
+   * @param indices Triangle list indices
+   * @param vertexCount Number of vertices
+   * @param outRemap Receives the new index of every vertex, or UNUSED_VERTEX
+   * @return Number of referenced vertices
+   */
+  static uint32
+  generateVertexFetchRemap(const Vector<uint32>& indices,
+                           uint32 vertexCount,
+                           Vector<uint32>& outRemap);
+
+  static void
+  remapIndices(Vector<uint32>& indices, const Vector<uint32>& remap);
+
+  /**
+   * Build the vertex data for a remap table, vertices mapped to UNUSED_VERTEX are dropped
+   *
+   * @param newVertexCount Count returned with the remap table
+   */
+  NODISCARD static Vector<uint8>
+  remapVertices(const uint8* vertices,
+                uint32 vertexCount,
+                uint32 stride,
+                const Vector<uint32>& remap,
+                uint32 newVertexCount);
+
+  /**
+   * Reorder triangles for the post-transform vertex cache (Forsyth's linear speed
+   * algorithm). The set of triangles and their winding do not change.
+   *
+   * @param indices Triangle list indices, reordered in place
+   * @param vertexCount Number of vertices the indices refer to
+   */
+  static void
+  optimizeVertexCache(Vector<uint32>& indices, uint32 vertexCount);
+
+  /**
+   * Reorder clusters of triangles so surfaces facing away from the mesh center are drawn
+   * first, they are the most likely to occlude the rest. Clusters are split where the
+   * cache is cold, and where their cache efficiency stays within threshold of the input,
+   * so threshold bounds how much ACMR can be traded for less overdraw.
+   *
+   * @param indices Triangle list indices already optimized for the vertex cache
+   * @param positions First position, 3 floats
+   * @param positionStride Bytes between two positions
+   * @param vertexCount Number of vertices
+   * @param threshold Allowed ACMR growth, 1.05 allows 5%
+   */
+  static void
+  optimizeOverdraw(Vector<uint32>& indices,
+                   const uint8* positions,
+                   uint32 positionStride,
+                   uint32 vertexCount,
+                   float threshold = 1.05f);
+
+  /**
+   * Simulate a FIFO post-transform cache over the indices
+   *
+   * @param indices Triangle list indices
+   * @param vertexCount Number of vertices
+   * @param cacheSize Entries of the simulated cache
+   * @return Cache statistics, zero for an empty index buffer
+   */
+  NODISCARD static VertexCacheStats
+  analyzeVertexCache(const Vector<uint32>& indices,
+                     uint32 vertexCount,
+                     uint32 cacheSize = DEFAULT_CACHE_SIZE);
+};
+} // namespace chEngineSDK
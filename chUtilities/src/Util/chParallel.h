@@ -0,0 +1,82 @@
+/************************************************************************/
+/**
+ * @file chParallel.h
+ * @author AccelMR
+ * @date 2025/07/28
+ * @brief Helpers to split data parallel loops across threads.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+#include "chJobSystem.h"
+#include "chMath.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Static class with data parallel loop helpers. The calling thread always takes a
+ *     share of the work and every call returns once all ranges are done. Once the
+ *     JobSystem is started the ranges run on its workers instead of new threads.
+ *
+ * Sample usage:
+ *  Parallel::forRange(values.size(), 1024, [&](SIZE_T begin, SIZE_T end) {
+ *    for (SIZE_T i = begin; i < end; ++i) { values[i] *= 2.0f; }
+ *  });
+ */
+class Parallel
+{
+ public:
+  /**
+   *   Amount of hardware threads, at least 1.
+   **/
+  NODISCARD static FORCEINLINE uint32
+  getThreadCount() {
+    static const uint32 s_threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    return s_threadCount;
+  }
+
+  /**
+   *   Splits [0, count) into contiguous ranges of at least minBatchSize elements and calls
+   *   fn(begin, end) for each of them. Small counts run inline.
+   **/
+  template<typename Fn>
+  static void
+  forRange(SIZE_T count, SIZE_T minBatchSize, Fn&& fn) {
+    if (count == 0) {
+      return;
+    }
+
+    if (JobSystem::isStarted()) {
+      JobSystem::instance().parallelFor(count, minBatchSize, std::forward<Fn>(fn));
+      return;
+    }
+
+    const SIZE_T maxRanges = count / Math::max(minBatchSize, static_cast<SIZE_T>(1));
+    const SIZE_T rangeCount = Math::min(static_cast<SIZE_T>(getThreadCount()), maxRanges);
+    if (rangeCount <= 1) {
+      fn(static_cast<SIZE_T>(0), count);
+      return;
+    }
+
+    const SIZE_T rangeSize = (count + rangeCount - 1) / rangeCount;
+    Vector<Thread> workers;
+    workers.reserve(rangeCount - 1);
+    for (SIZE_T begin = rangeSize; begin < count; begin += rangeSize) {
+      const SIZE_T end = Math::min(begin + rangeSize, count);
+      workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+    }
+
+    fn(static_cast<SIZE_T>(0), Math::min(rangeSize, count));
+    for (Thread& worker : workers) {
+      worker.join();
+    }
+  }
+};
+} // namespace chEngineSDK
@@ -0,0 +1,358 @@
+/************************************************************************/
+/**
+ * @file chRangeAllocator.cpp
+ * @author AccelMR
+ * @date 2025/08/03
+ * @brief
+ *  Offset allocators that sub-allocate ranges of a memory block they don't own.
+ */
+/************************************************************************/
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chRangeAllocator.h"
+
+#include "chMath.h"
+
+#include <bit>
+
+namespace chEngineSDK {
+namespace {
+FORCEINLINE uint64
+alignUp(uint64 value, uint64 alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/*
+ * Sizes under the second level count get a list each, bigger sizes are split by their
+ * highest bit and the secondLevelBits bits below it.
+ */
+FORCEINLINE void
+mapSize(uint64 size, uint32 secondLevelBits, uint32& firstLevel, uint32& secondLevel) {
+  const uint64 secondLevelCount = uint64(1) << secondLevelBits;
+  if (size < secondLevelCount) {
+    firstLevel = 0;
+    secondLevel = static_cast<uint32>(size);
+    return;
+  }
+
+  const uint32 highestBit = 63 - static_cast<uint32>(std::countl_zero(size));
+  firstLevel = highestBit - secondLevelBits + 1;
+  secondLevel =
+      static_cast<uint32>((size >> (highestBit - secondLevelBits)) - secondLevelCount);
+}
+} // namespace
+
+/*
+*/
+TLSFRangeAllocator::TLSFRangeAllocator(uint64 size) : RangeAllocator(size) {
+  CH_ASSERT(size > 0);
+  reset();
+}
+
+/*
+*/
+uint64
+TLSFRangeAllocator::allocate(uint64 size, uint64 alignment) {
+  CH_ASSERT(size > 0);
+  CH_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  if (size > m_size) {
+    return INVALID_OFFSET;
+  }
+
+  const uint32 node = findFree(size, alignment);
+  if (node == NO_NODE) {
+    return INVALID_OFFSET;
+  }
+  removeFree(node);
+
+  // Nodes are addressed by index, createNode can move them
+  const uint64 nodeOffset = m_nodes[node].offset;
+  const uint64 alignedOffset = alignUp(nodeOffset, alignment);
+  const uint64 padding = alignedOffset - nodeOffset;
+  if (padding > 0) {
+    // The previous node is in use, otherwise both would have been merged
+    const uint32 prevPhysical = m_nodes[node].prevPhysical;
+    const uint32 front = createNode(nodeOffset, padding, prevPhysical, node);
+    if (prevPhysical != NO_NODE) {
+      m_nodes[prevPhysical].nextPhysical = front;
+    }
+    m_nodes[node].prevPhysical = front;
+    m_nodes[node].offset = alignedOffset;
+    m_nodes[node].size -= padding;
+    insertFree(front);
+  }
+
+  const uint64 remaining = m_nodes[node].size - size;
+  if (remaining > 0) {
+    const uint32 nextPhysical = m_nodes[node].nextPhysical;
+    const uint32 back = createNode(alignedOffset + size, remaining, node, nextPhysical);
+    if (nextPhysical != NO_NODE) {
+      m_nodes[nextPhysical].prevPhysical = back;
+    }
+    m_nodes[node].nextPhysical = back;
+    m_nodes[node].size = size;
+    insertFree(back);
+  }
+
+  m_usedNodes[alignedOffset] = node;
+  m_usedSize += size;
+  ++m_allocationCount;
+  return alignedOffset;
+}
+
+/*
+*/
+void
+TLSFRangeAllocator::free(uint64 offset) {
+  auto it = m_usedNodes.find(offset);
+  CH_ASSERT(it != m_usedNodes.end() && "Offset was not allocated here.");
+  if (it == m_usedNodes.end()) {
+    return;
+  }
+
+  uint32 node = it->second;
+  m_usedNodes.erase(it);
+  m_usedSize -= m_nodes[node].size;
+  --m_allocationCount;
+
+  const uint32 next = m_nodes[node].nextPhysical;
+  if (next != NO_NODE && m_nodes[next].isFree) {
+    removeFree(next);
+    m_nodes[node].size += m_nodes[next].size;
+    m_nodes[node].nextPhysical = m_nodes[next].nextPhysical;
+    if (m_nodes[next].nextPhysical != NO_NODE) {
+      m_nodes[m_nodes[next].nextPhysical].prevPhysical = node;
+    }
+    releaseNode(next);
+  }
+
+  const uint32 prev = m_nodes[node].prevPhysical;
+  if (prev != NO_NODE && m_nodes[prev].isFree) {
+    removeFree(prev);
+    m_nodes[prev].size += m_nodes[node].size;
+    m_nodes[prev].nextPhysical = m_nodes[node].nextPhysical;
+    if (m_nodes[node].nextPhysical != NO_NODE) {
+      m_nodes[m_nodes[node].nextPhysical].prevPhysical = prev;
+    }
+    releaseNode(node);
+    node = prev;
+  }
+
+  insertFree(node);
+}
+
+/*
+*/
+void
+TLSFRangeAllocator::reset() {
+  m_nodes.clear();
+  m_unusedNodes.clear();
+  m_usedNodes.clear();
+  m_freeLists.fill(NO_NODE);
+  m_secondLevelBitmaps.fill(0);
+  m_firstLevelBitmap = 0;
+  m_usedSize = 0;
+  m_freeRangeCount = 0;
+  m_allocationCount = 0;
+
+  insertFree(createNode(0, m_size, NO_NODE, NO_NODE));
+}
+
+/*
+*/
+uint64
+TLSFRangeAllocator::getLargestFreeRange() const {
+  if (m_firstLevelBitmap == 0) {
+    return 0;
+  }
+
+  const uint32 firstLevel = 63 - static_cast<uint32>(std::countl_zero(m_firstLevelBitmap));
+  const uint32 secondLevel =
+      31 - static_cast<uint32>(std::countl_zero(m_secondLevelBitmaps[firstLevel]));
+
+  uint64 largest = 0;
+  uint32 node = m_freeLists[firstLevel * SECOND_LEVEL_COUNT + secondLevel];
+  for (; node != NO_NODE; node = m_nodes[node].nextFree) {
+    largest = Math::max(largest, m_nodes[node].size);
+  }
+  return largest;
+}
+
+/*
+*/
+uint32
+TLSFRangeAllocator::createNode(uint64 offset,
+                               uint64 size,
+                               uint32 prevPhysical,
+                               uint32 nextPhysical) {
+  uint32 node;
+  if (!m_unusedNodes.empty()) {
+    node = m_unusedNodes.back();
+    m_unusedNodes.pop_back();
+  }
+  else {
+    node = static_cast<uint32>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+
+  m_nodes[node] = {.offset = offset,
+                   .size = size,
+                   .prevPhysical = prevPhysical,
+                   .nextPhysical = nextPhysical,
+                   .prevFree = NO_NODE,
+                   .nextFree = NO_NODE,
+                   .isFree = false};
+  return node;
+}
+
+/*
+*/
+void
+TLSFRangeAllocator::releaseNode(uint32 node) {
+  m_unusedNodes.push_back(node);
+}
+
+/*
+*/
+void
+TLSFRangeAllocator::insertFree(uint32 node) {
+  uint32 firstLevel, secondLevel;
+  mapSize(m_nodes[node].size, SECOND_LEVEL_BITS, firstLevel, secondLevel);
+
+  uint32& head = m_freeLists[firstLevel * SECOND_LEVEL_COUNT + secondLevel];
+  m_nodes[node].isFree = true;
+  m_nodes[node].prevFree = NO_NODE;
+  m_nodes[node].nextFree = head;
+  if (head != NO_NODE) {
+    m_nodes[head].prevFree = node;
+  }
+  head = node;
+
+  m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+  m_firstLevelBitmap |= uint64(1) << firstLevel;
+  ++m_freeRangeCount;
+}
+
+/*
+*/
+void
+TLSFRangeAllocator::removeFree(uint32 node) {
+  uint32 firstLevel, secondLevel;
+  mapSize(m_nodes[node].size, SECOND_LEVEL_BITS, firstLevel, secondLevel);
+
+  const uint32 prevFree = m_nodes[node].prevFree;
+  const uint32 nextFree = m_nodes[node].nextFree;
+  if (prevFree != NO_NODE) {
+    m_nodes[prevFree].nextFree = nextFree;
+  }
+  else {
+    m_freeLists[firstLevel * SECOND_LEVEL_COUNT + secondLevel] = nextFree;
+  }
+  if (nextFree != NO_NODE) {
+    m_nodes[nextFree].prevFree = prevFree;
+  }
+
+  if (m_freeLists[firstLevel * SECOND_LEVEL_COUNT + secondLevel] == NO_NODE) {
+    m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+    if (m_secondLevelBitmaps[firstLevel] == 0) {
+      m_firstLevelBitmap &= ~(uint64(1) << firstLevel);
+    }
+  }
+
+  m_nodes[node].isFree = false;
+  --m_freeRangeCount;
+}
+
+/*
+ * The search size covers the worst alignment padding and is rounded up to the next list
+ * start, so every node of the list found fits. When nothing is found that way the lists
+ * between the size and the search size may still hold a node that fits once aligned.
+ */
+uint32
+TLSFRangeAllocator::findFree(uint64 size, uint64 alignment) const {
+  const uint64 searchSize = size + alignment - 1;
+  if (searchSize <= m_size) {
+    uint64 roundedSize = searchSize;
+    if (searchSize >= SECOND_LEVEL_COUNT) {
+      const uint32 highestBit = 63 - static_cast<uint32>(std::countl_zero(searchSize));
+      roundedSize += (uint64(1) << (highestBit - SECOND_LEVEL_BITS)) - 1;
+    }
+
+    if (roundedSize <= m_size) {
+      uint32 firstLevel, secondLevel;
+      mapSize(roundedSize, SECOND_LEVEL_BITS, firstLevel, secondLevel);
+
+      uint32 secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+      if (secondLevelMap == 0) {
+        const uint64 firstLevelMap =
+            firstLevel + 1 < 64 ? m_firstLevelBitmap & (~uint64(0) << (firstLevel + 1)) : 0;
+        if (firstLevelMap != 0) {
+          firstLevel = static_cast<uint32>(std::countr_zero(firstLevelMap));
+          secondLevelMap = m_secondLevelBitmaps[firstLevel];
+        }
+      }
+
+      if (secondLevelMap != 0) {
+        secondLevel = static_cast<uint32>(std::countr_zero(secondLevelMap));
+        return m_freeLists[firstLevel * SECOND_LEVEL_COUNT + secondLevel];
+      }
+    }
+  }
+
+  uint32 firstLevel, secondLevel, lastFirstLevel, lastSecondLevel;
+  mapSize(size, SECOND_LEVEL_BITS, firstLevel, secondLevel);
+  mapSize(Math::min(searchSize, m_size), SECOND_LEVEL_BITS, lastFirstLevel, lastSecondLevel);
+  const uint32 lastList = lastFirstLevel * SECOND_LEVEL_COUNT + lastSecondLevel;
+  for (uint32 list = firstLevel * SECOND_LEVEL_COUNT + secondLevel; list <= lastList; ++list) {
+    uint32 node = m_freeLists[list];
+    for (; node != NO_NODE; node = m_nodes[node].nextFree) {
+      const uint64 padding = alignUp(m_nodes[node].offset, alignment) - m_nodes[node].offset;
+      if (m_nodes[node].size >= size && m_nodes[node].size - size >= padding) {
+        return node;
+      }
+    }
+  }
+  return NO_NODE;
+}
+
+/*
+*/
+uint64
+LinearRangeAllocator::allocate(uint64 size, uint64 alignment) {
+  CH_ASSERT(size > 0);
+  CH_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  const uint64 offset = alignUp(m_head, alignment);
+  if (offset > m_size || size > m_size - offset) {
+    return INVALID_OFFSET;
+  }
+
+  m_head = offset + size;
+  ++m_allocationCount;
+  return offset;
+}
+
+/*
+*/
+void
+LinearRangeAllocator::free(uint64 offset) {
+  CH_ASSERT(m_allocationCount > 0 && offset < m_head);
+  CH_PAMRAMETER_UNUSED(offset);
+  if (--m_allocationCount == 0) {
+    m_head = 0;
+  }
+}
+
+/*
+*/
+void
+LinearRangeAllocator::reset() {
+  m_head = 0;
+  m_allocationCount = 0;
+}
+} // namespace chEngineSDK
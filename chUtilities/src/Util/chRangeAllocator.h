@@ -0,0 +1,219 @@
+/************************************************************************/
+/**
+ * @file chRangeAllocator.h
+ * @author AccelMR
+ * @date 2025/08/03
+ * @brief
+ *  Offset allocators that sub-allocate ranges of a memory block they don't own.
+ */
+/************************************************************************/
+#pragma once
+
+/************************************************************************/
+/*
+ * Includes
+ */
+/************************************************************************/
+#include "chPrerequisitesUtilities.h"
+
+namespace chEngineSDK {
+/*
+ * Description:
+ *     Hands out [offset, offset + size) ranges inside a range of a fixed size. Only
+ *     offsets are managed, the memory itself lives somewhere else (a GPU memory block, a
+ *     mapped buffer...), so the bookkeeping never touches it.
+ *
+ *     Not thread safe.
+ */
+class CH_UTILITY_EXPORT RangeAllocator
+{
+ public:
+  static constexpr uint64 INVALID_OFFSET = 0xFFFFFFFFFFFFFFFF;
+
+  explicit RangeAllocator(uint64 size) : m_size(size) {}
+  virtual ~RangeAllocator() = default;
+
+  /**
+   * Allocate a range
+   *
+   * @param size Size of the range, must be greater than zero
+   * @param alignment Power of two alignment of the offset
+   * @return Offset of the range, INVALID_OFFSET if it doesn't fit
+   */
+  NODISCARD virtual uint64
+  allocate(uint64 size, uint64 alignment = 1) = 0;
+
+  /**
+   * Release a range returned by allocate
+   */
+  virtual void
+  free(uint64 offset) = 0;
+
+  /**
+   * Release every range at once
+   */
+  virtual void
+  reset() = 0;
+
+  /**
+   * Bytes that can't be handed out right now. For the linear allocator this includes
+   * padding and freed ranges that were not reclaimed yet.
+   */
+  NODISCARD virtual uint64
+  getUsedSize() const = 0;
+
+  /**
+   * Biggest size an allocate call with an alignment of one would succeed with
+   */
+  NODISCARD virtual uint64
+  getLargestFreeRange() const = 0;
+
+  NODISCARD FORCEINLINE uint64
+  getSize() const {
+    return m_size;
+  }
+
+  NODISCARD FORCEINLINE uint32
+  getAllocationCount() const {
+    return m_allocationCount;
+  }
+
+  NODISCARD FORCEINLINE bool
+  isEmpty() const {
+    return m_allocationCount == 0;
+  }
+
+ protected:
+  uint64 m_size;
+  uint32 m_allocationCount = 0;
+};
+
+/*
+ * Description:
+ *     Two-level segregated fit allocator (Masmano et al). Free ranges are kept in lists
+ *     indexed by the power of two of their size and a linear subdivision of it, two
+ *     bitmaps find a list that is known to fit in constant time. Neighbour free ranges
+ *     are merged on free.
+ *
+ * Sample usage:
+ *  TLSFRangeAllocator ranges(blockSize);
+ *  uint64 offset = ranges.allocate(requirements.size, requirements.alignment);
+ *  ...
+ *  ranges.free(offset);
+ */
+class CH_UTILITY_EXPORT TLSFRangeAllocator : public RangeAllocator
+{
+ public:
+  explicit TLSFRangeAllocator(uint64 size);
+
+  NODISCARD uint64
+  allocate(uint64 size, uint64 alignment = 1) override;
+
+  void
+  free(uint64 offset) override;
+
+  void
+  reset() override;
+
+  NODISCARD uint64
+  getUsedSize() const override {
+    return m_usedSize;
+  }
+
+  NODISCARD uint64
+  getLargestFreeRange() const override;
+
+  /**
+   * Number of free ranges, 1 for an empty allocator. More ranges for the same free size
+   * means more fragmentation.
+   */
+  NODISCARD uint32
+  getFreeRangeCount() const {
+    return m_freeRangeCount;
+  }
+
+ private:
+  static constexpr uint32 SECOND_LEVEL_BITS = 5;
+  static constexpr uint32 SECOND_LEVEL_COUNT = 1 << SECOND_LEVEL_BITS;
+  static constexpr uint32 FIRST_LEVEL_COUNT = 64 - SECOND_LEVEL_BITS + 1;
+  static constexpr uint32 NO_NODE = 0xFFFFFFFF;
+
+  struct Node
+  {
+    uint64 offset;
+    uint64 size;
+    uint32 prevPhysical;
+    uint32 nextPhysical;
+    uint32 prevFree;
+    uint32 nextFree;
+    bool isFree;
+  };
+
+  NODISCARD uint32
+  createNode(uint64 offset, uint64 size, uint32 prevPhysical, uint32 nextPhysical);
+
+  void
+  releaseNode(uint32 node);
+
+  void
+  insertFree(uint32 node);
+
+  void
+  removeFree(uint32 node);
+
+  /**
+   * Find a free node that fits size bytes at the given alignment, NO_NODE if there is none
+   */
+  NODISCARD uint32
+  findFree(uint64 size, uint64 alignment) const;
+
+  Vector<Node> m_nodes;
+  Vector<uint32> m_unusedNodes;
+  UnorderedMap<uint64, uint32> m_usedNodes;
+
+  Array<uint32, FIRST_LEVEL_COUNT * SECOND_LEVEL_COUNT> m_freeLists;
+  Array<uint32, FIRST_LEVEL_COUNT> m_secondLevelBitmaps;
+  uint64 m_firstLevelBitmap = 0;
+
+  uint64 m_usedSize = 0;
+  uint32 m_freeRangeCount = 0;
+};
+
+/*
+ * Description:
+ *     Bump allocator over a range. Freed ranges are only reclaimed once every range is
+ *     free, which fits memory that is filled and released together (per frame data,
+ *     staging uploads).
+ *
+ * Sample usage:
+ *  LinearRangeAllocator ranges(blockSize);
+ *  uint64 offset = ranges.allocate(size, 256);
+ */
+class CH_UTILITY_EXPORT LinearRangeAllocator : public RangeAllocator
+{
+ public:
+  explicit LinearRangeAllocator(uint64 size) : RangeAllocator(size) {}
+
+  NODISCARD uint64
+  allocate(uint64 size, uint64 alignment = 1) override;
+
+  void
+  free(uint64 offset) override;
+
+  void
+  reset() override;
+
+  NODISCARD uint64
+  getUsedSize() const override {
+    return m_head;
+  }
+
+  NODISCARD uint64
+  getLargestFreeRange() const override {
+    return m_size - m_head;
+  }
+
+ private:
+  uint64 m_head = 0;
+};
+} // namespace chEngineSDK
@@ -9,25 +9,35 @@
  */
 /************************************************************************/
 // #ifdef RUN_UNIT_TESTS
+#include "chArenaAllocator.h"
+#include "chBVH.h"
 #include "chBox2D.h"
 #include "chCommandParser.h"
 #include "chDegree.h"
+#include "chDynamicAABBTree.h"
 #include "chDynamicLibManager.h"
 #include "chEventSystem.h"
 #include "chFileSystem.h"
+#include "chJobSystem.h"
 #include "chLogger.h"
 #include "chMath.h"
+#include "chMatrix3x4.h"
 #include "chMatrix4.h"
 #include "chMatrixHelpers.h"
+#include "chMeshOptimizer.h"
 #include "chModule.h"
+#include "chParallel.h"
 #include "chPath.h"
 #include "chPlane.h"
+#include "chQuantization.h"
 #include "chQuaternion.h"
 #include "chRadian.h"
 #include "chRandom.h"
+#include "chRangeAllocator.h"
 #include "chRotator.h"
 #include "chSphereBoxBounds.h"
 #include "chStringUtils.h"
+#include "chTransformHierarchy.h"
 #include "chUnicode.h"
 #include "chVector2.h"
 #include "chVector3.h"
@@ -1103,6 +1113,133 @@ TEST_CASE("chUtilities - Matrix4") {
   REQUIRE(isNear(lookAtMatrix.at(2, 2), -0.2673f));  // ZAxis.z
 }
 
+/************************************************************************/
+/*
+ * Matrix3x4.
+ */
+/************************************************************************/
+TEST_CASE("chUtilities - Matrix3x4") {
+  auto requireNearMatrix = [](const Matrix3x4& a, const Matrix3x4& b, float eps) {
+    for (int32 i = 0; i < 3; ++i) {
+      for (int32 j = 0; j < 4; ++j) {
+        REQUIRE(isNear(a.at(i, j), b.at(i, j), eps));
+      }
+    }
+  };
+  auto requireNearVector = [](const Vector3& a, const Vector3& b, float eps) {
+    REQUIRE(isNear(a.x, b.x, eps));
+    REQUIRE(isNear(a.y, b.y, eps));
+    REQUIRE(isNear(a.z, b.z, eps));
+  };
+
+  static_assert(sizeof(Matrix3x4) == sizeof(float) * 12);
+  static_assert(Matrix3x4::IDENTITY * Matrix3x4::IDENTITY == Matrix3x4::IDENTITY);
+  static_assert(Matrix3x4::IDENTITY.transformPoint(Vector3(1.0f, 2.0f, 3.0f)) ==
+                Vector3(1.0f, 2.0f, 3.0f));
+
+  const ScaleRotationTranslationMatrix parent(Vector3(2.0f, 1.0f, 0.5f),
+                                              Rotator(30.0f, 45.0f, -20.0f),
+                                              Vector3(10.0f, -4.0f, 3.0f));
+  const ScaleRotationTranslationMatrix child(Vector3(1.0f, 3.0f, 1.0f),
+                                             Rotator(-60.0f, 10.0f, 75.0f),
+                                             Vector3(-1.0f, 2.0f, 7.0f));
+  const Matrix3x4 parent34(parent);
+  const Matrix3x4 child34(child);
+
+  // Round trip and composition match Matrix4.
+  const Matrix4 back = parent34.toMatrix4();
+  for (int32 i = 0; i < 4; ++i) {
+    for (int32 j = 0; j < 4; ++j) {
+      REQUIRE(back.at(i, j) == parent.at(i, j));
+    }
+  }
+  requireNearMatrix(child34 * parent34, Matrix3x4(child * parent), 1e-5f);
+
+  Matrix3x4 composed = child34;
+  composed *= parent34;
+  REQUIRE(composed == child34 * parent34);
+
+  const Vector3 point(3.0f, -2.0f, 5.0f);
+  const Vector4 expected = parent.transformPosition(point);
+  requireNearVector(parent34.transformPoint(point),
+                    Vector3(expected.x, expected.y, expected.z), 1e-4f);
+  const Vector4 expectedDirection = parent.transformVector(point);
+  requireNearVector(parent34.transformVector(point),
+                    Vector3(expectedDirection.x, expectedDirection.y, expectedDirection.z),
+                    1e-4f);
+
+  // Scale, quaternion and translation behave like scaling, rotating then translating.
+  const Quaternion rotation(Vector3(1.0f, 2.0f, -1.0f).getNormalized(), Degree(70.0f));
+  const Vector3 scale(2.0f, 0.5f, 3.0f);
+  const Vector3 translation(1.0f, 2.0f, 3.0f);
+  const Matrix3x4 srt(scale, rotation, translation);
+  const Vector3 scaledPoint(point.x * scale.x, point.y * scale.y, point.z * scale.z);
+  requireNearVector(srt.transformPoint(point), rotation.rotateVector(scaledPoint) + translation,
+                    1e-4f);
+  requireNearVector(srt.getScale(), scale, 1e-4f);
+  requireNearVector(srt.getTranslation(), translation, 0.0f);
+  const Quaternion extracted = srt.getRotation();
+  requireNearVector(extracted.rotateVector(point), rotation.rotateVector(point), 1e-4f);
+  requireNearVector(Matrix3x4(rotation, translation).transformPoint(point),
+                    rotation.rotateVector(point) + translation, 1e-4f);
+
+  // Inverse undoes the transform from either side.
+  const Matrix3x4 inverse = srt.getInverse();
+  requireNearMatrix(srt * inverse, Matrix3x4::IDENTITY, 1e-5f);
+  requireNearMatrix(inverse * srt, Matrix3x4::IDENTITY, 1e-5f);
+  requireNearVector(inverse.transformPoint(srt.transformPoint(point)), point, 1e-4f);
+  REQUIRE(Matrix3x4(0.0f, 0.0f, 0.0f, 1.0f,
+                    0.0f, 0.0f, 0.0f, 1.0f,
+                    0.0f, 0.0f, 0.0f, 1.0f).getInverse() == Matrix3x4::IDENTITY);
+
+  // Batch transform matches the single point version.
+  RandomStream random(30);
+  Vector<Vector3> points(37);
+  random.fillPointsInBox(points.data(), points.size(), Vector3(-10.0f, -10.0f, -10.0f),
+                         Vector3(10.0f, 10.0f, 10.0f));
+  Vector<Vector3> transformed(points.size());
+  srt.transformPoints(points.data(), transformed.data(), points.size());
+  for (SIZE_T i = 0; i < points.size(); ++i) {
+    requireNearVector(transformed[i], srt.transformPoint(points[i]), 1e-4f);
+  }
+  srt.transformPoints(points.data(), points.data(), points.size());
+  REQUIRE(points == transformed);
+
+  // Streamed bounds read a strided array and match the transformed points.
+  struct Vertex
+  {
+    Vector3 position;
+    float uv[2];
+  };
+  Vector<Vertex> vertices(points.size());
+  random.fillPointsInBox(points.data(), points.size(), Vector3(-10.0f, -10.0f, -10.0f),
+                         Vector3(10.0f, 10.0f, 10.0f));
+  AABox expectedBounds(srt.transformPoint(points[0]), srt.transformPoint(points[0]));
+  AABox localBounds(points[0], points[0]);
+  for (SIZE_T i = 0; i < points.size(); ++i) {
+    vertices[i].position = points[i];
+    expectedBounds += srt.transformPoint(points[i]);
+    localBounds += points[i];
+  }
+  const AABox streamed = srt.transformBounds(&vertices[0].position.x, sizeof(Vertex),
+                                             vertices.size());
+  requireNearVector(streamed.minPoint, expectedBounds.minPoint, 1e-4f);
+  requireNearVector(streamed.maxPoint, expectedBounds.maxPoint, 1e-4f);
+
+  // A transformed box contains every transformed point of the original one.
+  const AABox transformedBox = srt.transformBox(localBounds);
+  REQUIRE(transformedBox.minPoint.x <= streamed.minPoint.x + 1e-4f);
+  REQUIRE(transformedBox.minPoint.y <= streamed.minPoint.y + 1e-4f);
+  REQUIRE(transformedBox.minPoint.z <= streamed.minPoint.z + 1e-4f);
+  REQUIRE(transformedBox.maxPoint.x >= streamed.maxPoint.x - 1e-4f);
+  REQUIRE(transformedBox.maxPoint.y >= streamed.maxPoint.y - 1e-4f);
+  REQUIRE(transformedBox.maxPoint.z >= streamed.maxPoint.z - 1e-4f);
+  const AABox unitBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+  const AABox moved = Matrix3x4(Quaternion::IDENTITY, translation).transformBox(unitBox);
+  requireNearVector(moved.minPoint, translation - Vector3::UNIT, 1e-5f);
+  requireNearVector(moved.maxPoint, translation + Vector3::UNIT, 1e-5f);
+}
+
 /************************************************************************/
 /*
  * Quaternion.
@@ -1322,6 +1459,134 @@ TEST_CASE("chUtilities - Quaternion") {
  *                            Shapes
  */
 /***********************************************************************/
+TEST_CASE("chUtilities - ConstexprMath") {
+  static_assert(Math::sqrt(16.0f) == 4.0f);
+  static_assert(Math::abs(-2.5f) == 2.5f);
+  static_assert(Math::clamp(5, 0, 3) == 3);
+  static_assert(Degree(180.0f).valueRadian() == Math::PI);
+  static_assert(Radian(Math::HALF_PI).valueDegree() == 90.0f);
+
+  static_assert(Vector3::UP.cross(Vector3::FORWARD) == Vector3::RIGHT);
+  static_assert(Vector3(3.0f, 4.0f, 0.0f).magnitude() == 5.0f);
+  static_assert(Vector2::UNIT_X.dot(Vector2::UNIT_Y) == 0.0f);
+  static_assert((Vector4::UNIT * 2.0f).sqrMagnitude() == 16.0f);
+  static_assert(Quaternion::IDENTITY.getConjugated() == Quaternion::IDENTITY);
+
+  constexpr Matrix4 scale(2.0f, 0.0f, 0.0f, 0.0f,
+                          0.0f, 2.0f, 0.0f, 0.0f,
+                          0.0f, 0.0f, 2.0f, 0.0f,
+                          0.0f, 0.0f, 0.0f, 1.0f);
+  constexpr Matrix4 composed = scale * Matrix4::IDENTITY * scale;
+  static_assert(composed.at(0, 0) == 4.0f);
+  static_assert(composed.getDeterminant() == 64.0f);
+
+  // The runtime SIMD path has to match the compile time evaluation.
+  Matrix4 runtimeScale = scale;
+  REQUIRE(runtimeScale * Matrix4::IDENTITY * runtimeScale == composed);
+
+  constexpr auto SIN_TABLE = [] {
+    Array<float, 8> table{};
+    for (int32 i = 0; i < 8; ++i) {
+      float s = 0.0f, c = 0.0f;
+      Math::sin_cos(&s, &c, static_cast<float>(i) * Math::FORTH_PI);
+      table[i] = s;
+    }
+    return table;
+  }();
+  REQUIRE(isNear(SIN_TABLE[2], 1.0f));
+  REQUIRE(isNear(SIN_TABLE[6], -1.0f));
+}
+
+TEST_CASE("chUtilities - Quantization") {
+  // Half floats, exact values and specials.
+  REQUIRE(Quantization::floatToHalf(1.0f) == 0x3C00);
+  REQUIRE(Quantization::floatToHalf(-2.0f) == 0xC000);
+  REQUIRE(Quantization::floatToHalf(65504.0f) == 0x7BFF);
+  REQUIRE(Quantization::floatToHalf(1.0e6f) == 0x7C00);
+  REQUIRE(Quantization::halfToFloat(0x3555) == Approx(0.33325f));
+  REQUIRE(Quantization::halfToFloat(0x0001) == Approx(5.96046448e-8f));
+  REQUIRE(Half(0.5f).toFloat() == 0.5f);
+
+  const SIZE_T COUNT = 37;
+  Vector<float> floats(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    floats[i] = (static_cast<float>(i) - 18.0f) * 0.0573f;
+  }
+
+  // Batch conversions must match the scalar ones.
+  Vector<uint16> halves(COUNT);
+  Vector<float> unpacked(COUNT);
+  Quantization::packHalf(floats.data(), halves.data(), COUNT);
+  Quantization::unpackHalf(halves.data(), unpacked.data(), COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    REQUIRE(halves[i] == Quantization::floatToHalf(floats[i]));
+    REQUIRE(isNear(unpacked[i], floats[i], 0.001f));
+  }
+
+  Vector<int16> snorms(COUNT);
+  Quantization::packSnorm16(floats.data(), snorms.data(), COUNT);
+  Quantization::unpackSnorm16(snorms.data(), unpacked.data(), COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    REQUIRE(snorms[i] == Quantization::floatToSnorm16(floats[i]));
+    REQUIRE(isNear(unpacked[i], Math::clamp(floats[i], -1.0f, 1.0f), 0.0001f));
+  }
+
+  // Octahedral normals on both hemispheres.
+  RandomStream rnd(3);
+  Vector<Vector3> normals(COUNT);
+  Vector<OctahedralNormal> encoded(COUNT);
+  Vector<Vector3> decoded(COUNT);
+  rnd.fillUnitVectors(normals.data(), COUNT);
+  Quantization::encodeOctahedral(normals.data(), encoded.data(), COUNT);
+  Quantization::decodeOctahedral(encoded.data(), decoded.data(), COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    const OctahedralNormal scalar = Quantization::encodeOctahedral(normals[i]);
+    REQUIRE(encoded[i].x == scalar.x);
+    REQUIRE(encoded[i].y == scalar.y);
+    REQUIRE(decoded[i] == Quantization::decodeOctahedral(scalar));
+    REQUIRE(decoded[i].nearEqual(normals[i], 0.0005f));
+  }
+
+  // Smallest-three quaternions.
+  const Quaternion rotations[] = {Quaternion(0.0f, 0.0f, 0.0f, 1.0f),
+                                  Quaternion(Vector3(0.0f, 0.0f, 1.0f), Degree(90.0f)),
+                                  Quaternion(Vector3(1.0f, 0.0f, 0.0f), Degree(-135.0f)),
+                                  Quaternion(Vector3(0.0f, 1.0f, 0.0f), Degree(200.0f))};
+  PackedQuaternion packed[4];
+  Quaternion restored[4];
+  Quantization::packQuaternions(rotations, packed, 4);
+  Quantization::unpackQuaternions(packed, restored, 4);
+  const Vector3 probe(1.0f, 2.0f, 3.0f);
+  for (uint32 i = 0; i < 4; ++i) {
+    REQUIRE(restored[i].rotateVector(probe).nearEqual(rotations[i].rotateVector(probe),
+                                                      0.001f));
+  }
+
+  // Batch quaternions must match the scalar ones bit for bit, ties and negative largest
+  // components included.
+  Vector<Quaternion> quaternions(COUNT);
+  quaternions[0] = Quaternion(0.5f, 0.5f, 0.5f, 0.5f);
+  quaternions[1] = Quaternion(-0.5f, 0.5f, -0.5f, 0.5f);
+  quaternions[2] = Quaternion(0.0f, 0.0f, -1.0f, -0.0f);
+  quaternions[3] = Quaternion(0.6f, -0.8f, 0.0f, 0.0f);
+  for (SIZE_T i = 4; i < COUNT; ++i) {
+    quaternions[i] = Quaternion(rnd.nextUnitVector(),
+                                Degree(rnd.nextFloatRange(-360.0f, 360.0f)));
+  }
+  Vector<PackedQuaternion> packedBatch(COUNT);
+  Vector<Quaternion> restoredBatch(COUNT);
+  Quantization::packQuaternions(quaternions.data(), packedBatch.data(), COUNT);
+  Quantization::unpackQuaternions(packedBatch.data(), restoredBatch.data(), COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    const PackedQuaternion scalar = Quantization::packQuaternion(quaternions[i]);
+    REQUIRE(packedBatch[i].data[0] == scalar.data[0]);
+    REQUIRE(packedBatch[i].data[1] == scalar.data[1]);
+    REQUIRE(packedBatch[i].data[2] == scalar.data[2]);
+    const Quaternion scalarRestored = Quantization::unpackQuaternion(scalar);
+    REQUIRE(std::memcmp(&restoredBatch[i], &scalarRestored, sizeof(Quaternion)) == 0);
+  }
+}
+
 TEST_CASE("chUtilities - AABox") {
   REQUIRE(sizeof(AABox) == 12 * 2);
 
@@ -1431,6 +1696,948 @@ TEST_CASE("chUtilities - SphereBoxBounds") {
   REQUIRE_FALSE(Math::boxesIntersect(FromPoints, FromSphereBoxTRUE));
 }
 
+namespace {
+Vector<AABox>
+makeRandomBoxes(RandomStream& random, SIZE_T count, float worldSize, float maxSize) {
+  Vector<AABox> boxes(count);
+  for (auto& box : boxes) {
+    const Vector3 center = random.nextPointInBox(Vector3(-worldSize, -worldSize, -worldSize),
+                                                 Vector3(worldSize, worldSize, worldSize));
+    const Vector3 extent(random.nextFloatRange(0.01f, maxSize),
+                         random.nextFloatRange(0.01f, maxSize),
+                         random.nextFloatRange(0.01f, maxSize));
+    box = AABox(center - extent, center + extent);
+  }
+  return boxes;
+}
+
+bool
+boxesOverlap(const AABox& a, const AABox& b) {
+  return a.minPoint.x <= b.maxPoint.x && a.maxPoint.x >= b.minPoint.x &&
+         a.minPoint.y <= b.maxPoint.y && a.maxPoint.y >= b.minPoint.y &&
+         a.minPoint.z <= b.maxPoint.z && a.maxPoint.z >= b.minPoint.z;
+}
+
+float
+rayEntry(const AABox& box, const Vector3& origin, const Vector3& direction, float maxT) {
+  float tMin = 0.0f;
+  float tMax = maxT;
+  for (int32 axis = 0; axis < 3; ++axis) {
+    const float o = (&origin.x)[axis];
+    const float d = (&direction.x)[axis];
+    const float bMin = (&box.minPoint.x)[axis];
+    const float bMax = (&box.maxPoint.x)[axis];
+    if (Math::abs(d) < 1e-12f) {
+      if (o < bMin || o > bMax) {
+        return -1.0f;
+      }
+      continue;
+    }
+    float t1 = (bMin - o) / d;
+    float t2 = (bMax - o) / d;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    tMin = Math::max(tMin, t1);
+    tMax = Math::min(tMax, t2);
+  }
+  return tMin <= tMax ? tMin : -1.0f;
+}
+} // namespace
+
+TEST_CASE("chUtilities - BVH") {
+  RandomStream random(29);
+  const SIZE_T COUNT = 2000;
+  Vector<AABox> boxes = makeRandomBoxes(random, COUNT, 100.0f, 3.0f);
+  Vector<uint32> ids(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    ids[i] = static_cast<uint32>(i);
+  }
+
+  BVH<uint32> bvh;
+  REQUIRE(bvh.empty());
+
+  BVH<uint32>::BuildSettings settings;
+  settings.parallelThreshold = 256;
+  bvh.build(boxes, ids, settings);
+  REQUIRE_FALSE(bvh.empty());
+  REQUIRE(bvh.getItemCount() == COUNT);
+  REQUIRE(bvh.getNodes().size() <= COUNT * 2 - 1);
+
+  auto checkTree = [&]() {
+    // Every input item ends in exactly one leaf, parents contain their children.
+    Vector<uint32> seen(COUNT, 0);
+    for (const auto& node : bvh.getNodes()) {
+      if (node.isLeaf()) {
+        for (uint32 i = 0; i < node.itemCount; ++i) {
+          ++seen[bvh.getItems()[node.firstChildOrItem + i]];
+        }
+        continue;
+      }
+      for (uint32 child = 0; child < 2; ++child) {
+        const AABox& childBounds = bvh.getNodes()[node.firstChildOrItem + child].bounds;
+        REQUIRE(childBounds.minPoint.x >= node.bounds.minPoint.x);
+        REQUIRE(childBounds.minPoint.y >= node.bounds.minPoint.y);
+        REQUIRE(childBounds.minPoint.z >= node.bounds.minPoint.z);
+        REQUIRE(childBounds.maxPoint.x <= node.bounds.maxPoint.x);
+        REQUIRE(childBounds.maxPoint.y <= node.bounds.maxPoint.y);
+        REQUIRE(childBounds.maxPoint.z <= node.bounds.maxPoint.z);
+      }
+    }
+    REQUIRE(std::all_of(seen.begin(), seen.end(), [](uint32 v) { return v == 1; }));
+  };
+
+  auto checkQueries = [&]() {
+    for (int32 q = 0; q < 50; ++q) {
+      const AABox area = makeRandomBoxes(random, 1, 100.0f, 20.0f)[0];
+      Vector<uint32> found;
+      bvh.queryAABox(area, [&](const uint32& id) { found.push_back(id); });
+      Vector<uint32> expected;
+      for (uint32 i = 0; i < COUNT; ++i) {
+        if (boxesOverlap(boxes[i], area)) {
+          expected.push_back(i);
+        }
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+    }
+
+    for (int32 q = 0; q < 50; ++q) {
+      const Vector3 origin = random.nextPointInBox(Vector3(-120.0f, -120.0f, -120.0f),
+                                                   Vector3(120.0f, 120.0f, 120.0f));
+      const Vector3 direction = random.nextUnitVector();
+      Vector<uint32> found;
+      bvh.queryRay(origin, direction, 150.0f, [&](const uint32& id, float) {
+        found.push_back(id);
+      });
+      Vector<uint32> expected;
+      for (uint32 i = 0; i < COUNT; ++i) {
+        if (rayEntry(boxes[i], origin, direction, 150.0f) >= 0.0f) {
+          expected.push_back(i);
+        }
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+
+      // Closest hit using the box itself as the exact shape.
+      float distance = 150.0f;
+      Optional<uint32> closest =
+          bvh.raycast(origin, direction, distance, [&](const uint32& id, float& t) {
+            const float entry = rayEntry(boxes[id], origin, direction, t);
+            if (entry < 0.0f) {
+              return false;
+            }
+            t = entry;
+            return true;
+          });
+      REQUIRE(closest.has_value() == !expected.empty());
+      if (closest.has_value()) {
+        float nearest = 150.0f;
+        for (uint32 id : expected) {
+          nearest = Math::min(nearest, rayEntry(boxes[id], origin, direction, 150.0f));
+        }
+        REQUIRE(isNear(distance, nearest, 1e-4f));
+      }
+    }
+
+    // Axis aligned frustum equivalent to a box query on its interior.
+    Array<Plane, 6> planes;
+    planes[0] = Plane(1.0f, 0.0f, 0.0f, -10.0f);
+    planes[1] = Plane(-1.0f, 0.0f, 0.0f, -30.0f);
+    planes[2] = Plane(0.0f, 1.0f, 0.0f, -40.0f);
+    planes[3] = Plane(0.0f, -1.0f, 0.0f, -5.0f);
+    planes[4] = Plane(0.0f, 0.0f, 1.0f, -50.0f);
+    planes[5] = Plane(0.0f, 0.0f, -1.0f, -50.0f);
+    const AABox frustumBox(Vector3(-10.0f, -40.0f, -50.0f), Vector3(30.0f, 5.0f, 50.0f));
+    Vector<uint32> found;
+    bvh.queryFrustum(planes.data(), planes.size(), [&](const uint32& id) {
+      found.push_back(id);
+    });
+    Vector<uint32> expected;
+    for (uint32 i = 0; i < COUNT; ++i) {
+      if (boxesOverlap(boxes[i], frustumBox)) {
+        expected.push_back(i);
+      }
+    }
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == expected);
+  };
+
+  checkTree();
+  checkQueries();
+
+  SECTION("Refit after moving every item") {
+    for (auto& box : boxes) {
+      const Vector3 offset(random.nextFloatRange(-5.0f, 5.0f),
+                           random.nextFloatRange(-5.0f, 5.0f),
+                           random.nextFloatRange(-5.0f, 5.0f));
+      box = AABox(box.minPoint + offset, box.maxPoint + offset);
+    }
+    bvh.refit(boxes);
+    checkTree();
+    checkQueries();
+  }
+
+  SECTION("Early exit") {
+    uint32 visited = 0;
+    bvh.queryAABox(bvh.getBounds(), [&](const uint32&) { return ++visited < 10; });
+    REQUIRE(visited == 10);
+  }
+
+  SECTION("Degenerate input") {
+    Vector<AABox> same(100, AABox(Vector3(1.0f, 1.0f, 1.0f), Vector3(2.0f, 2.0f, 2.0f)));
+    Vector<uint32> sameIds(100, 7);
+    BVH<uint32> degenerate;
+    degenerate.build(same, sameIds);
+    uint32 hits = 0;
+    degenerate.queryAABox(same[0], [&](const uint32&) { ++hits; });
+    REQUIRE(hits == 100);
+
+    degenerate.clear();
+    REQUIRE(degenerate.empty());
+  }
+}
+
+// Run with: chUtilitiesTest "[benchmark]"
+TEST_CASE("chUtilities - BVHBenchmark", "[.][benchmark]") {
+  using Clock = std::chrono::high_resolution_clock;
+  using Micro = std::chrono::microseconds;
+  RandomStream random(29);
+  const SIZE_T COUNT = 1 << 18;
+  Vector<AABox> boxes = makeRandomBoxes(random, COUNT, 1000.0f, 2.0f);
+  Vector<uint32> ids(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    ids[i] = static_cast<uint32>(i);
+  }
+
+  BVH<uint32> bvh;
+  BVH<uint32>::BuildSettings singleThread;
+  singleThread.maxThreads = 1;
+  auto start = Clock::now();
+  bvh.build(boxes, ids, singleThread);
+  const auto serialBuild = Clock::now() - start;
+
+  start = Clock::now();
+  bvh.build(boxes, ids);
+  const auto parallelBuild = Clock::now() - start;
+
+  start = Clock::now();
+  bvh.refit(boxes);
+  const auto refitTime = Clock::now() - start;
+
+  const SIZE_T RAYS = 100000;
+  Vector<Vector3> origins(RAYS);
+  Vector<Vector3> directions(RAYS);
+  random.fillPointsInBox(origins.data(), RAYS, Vector3(-1000.0f, -1000.0f, -1000.0f),
+                         Vector3(1000.0f, 1000.0f, 1000.0f));
+  random.fillUnitVectors(directions.data(), RAYS);
+  SIZE_T hits = 0;
+  start = Clock::now();
+  for (SIZE_T i = 0; i < RAYS; ++i) {
+    float distance = 500.0f;
+    hits += bvh.raycast(origins[i], directions[i], distance, [](const uint32&, float&) {
+              return true;
+            }).has_value();
+  }
+  const auto rayTime = Clock::now() - start;
+
+  WARN("BVH build 1 thread:  " << std::chrono::duration_cast<Micro>(serialBuild).count()
+                               << " us");
+  WARN("BVH build parallel:  " << std::chrono::duration_cast<Micro>(parallelBuild).count()
+                               << " us");
+  WARN("BVH refit:           " << std::chrono::duration_cast<Micro>(refitTime).count()
+                               << " us");
+  const double raySeconds = std::chrono::duration<double>(rayTime).count();
+  WARN("BVH raycast:         " << static_cast<uint64>(RAYS / raySeconds) << " rays/s, "
+                               << hits << " hits");
+  REQUIRE(bvh.getItemCount() == COUNT);
+}
+
+TEST_CASE("chUtilities - DynamicAABBTree") {
+  using Tree = DynamicAABBTree<uint32>;
+  RandomStream random(36);
+  const SIZE_T COUNT = 2000;
+  Vector<AABox> boxes = makeRandomBoxes(random, COUNT, 100.0f, 3.0f);
+  Vector<bool> alive(COUNT, true);
+
+  Tree tree;
+  REQUIRE(tree.empty());
+  Vector<Tree::ProxyId> proxies(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    proxies[i] = tree.insert(boxes[i], static_cast<uint32>(i));
+  }
+  REQUIRE(tree.getProxyCount() == COUNT);
+
+  auto checkQueries = [&]() {
+    // Rotations keep the tree close to balanced, log2(2000) is about 11.
+    REQUIRE(tree.getHeight() <= 24);
+
+    for (int32 q = 0; q < 30; ++q) {
+      const AABox area = makeRandomBoxes(random, 1, 100.0f, 20.0f)[0];
+      Vector<uint32> found;
+      tree.queryAABox(area, [&](const uint32& id) { found.push_back(id); });
+      Vector<uint32> expected;
+      for (uint32 i = 0; i < COUNT; ++i) {
+        if (alive[i] && boxesOverlap(boxes[i], area)) {
+          expected.push_back(i);
+        }
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+
+      const Vector3 center = area.getCenter();
+      const float radius = area.getExtent().x;
+      found.clear();
+      tree.querySphere(center, radius, [&](const uint32& id) { found.push_back(id); });
+      expected.clear();
+      for (uint32 i = 0; i < COUNT; ++i) {
+        const Vector3 closest(Math::clamp(center.x, boxes[i].minPoint.x, boxes[i].maxPoint.x),
+                              Math::clamp(center.y, boxes[i].minPoint.y, boxes[i].maxPoint.y),
+                              Math::clamp(center.z, boxes[i].minPoint.z, boxes[i].maxPoint.z));
+        if (alive[i] && (closest - center).sqrMagnitude() <= radius * radius) {
+          expected.push_back(i);
+        }
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+    }
+
+    for (int32 q = 0; q < 30; ++q) {
+      const Vector3 origin = random.nextPointInBox(Vector3(-120.0f, -120.0f, -120.0f),
+                                                   Vector3(120.0f, 120.0f, 120.0f));
+      const Vector3 direction = random.nextUnitVector();
+      Vector<uint32> found;
+      tree.queryRay(origin, direction, 150.0f, [&](const uint32& id, float) {
+        found.push_back(id);
+      });
+      Vector<uint32> expected;
+      float nearest = 150.0f;
+      for (uint32 i = 0; i < COUNT; ++i) {
+        const float entry = rayEntry(boxes[i], origin, direction, 150.0f);
+        if (alive[i] && entry >= 0.0f) {
+          expected.push_back(i);
+          nearest = Math::min(nearest, entry);
+        }
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+
+      float distance = 150.0f;
+      Optional<uint32> closest =
+          tree.raycast(origin, direction, distance, [&](const uint32& id, float& t) {
+            const float entry = rayEntry(boxes[id], origin, direction, t);
+            if (entry < 0.0f) {
+              return false;
+            }
+            t = entry;
+            return true;
+          });
+      REQUIRE(closest.has_value() == !expected.empty());
+      if (closest.has_value()) {
+        REQUIRE(isNear(distance, nearest, 1e-4f));
+      }
+    }
+
+    Array<Plane, 6> planes;
+    planes[0] = Plane(1.0f, 0.0f, 0.0f, -10.0f);
+    planes[1] = Plane(-1.0f, 0.0f, 0.0f, -30.0f);
+    planes[2] = Plane(0.0f, 1.0f, 0.0f, -40.0f);
+    planes[3] = Plane(0.0f, -1.0f, 0.0f, -5.0f);
+    planes[4] = Plane(0.0f, 0.0f, 1.0f, -50.0f);
+    planes[5] = Plane(0.0f, 0.0f, -1.0f, -50.0f);
+    const AABox frustumBox(Vector3(-10.0f, -40.0f, -50.0f), Vector3(30.0f, 5.0f, 50.0f));
+    Vector<uint32> found;
+    tree.queryFrustum(planes.data(), planes.size(), [&](const uint32& id) {
+      found.push_back(id);
+    });
+    Vector<uint32> expected;
+    for (uint32 i = 0; i < COUNT; ++i) {
+      if (alive[i] && boxesOverlap(boxes[i], frustumBox)) {
+        expected.push_back(i);
+      }
+    }
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == expected);
+  };
+
+  checkQueries();
+
+  SECTION("Move, remove and reinsert") {
+    SIZE_T reinserted = 0;
+    for (SIZE_T i = 0; i < COUNT; ++i) {
+      const float maxOffset = i % 2 == 0 ? 0.05f : 10.0f;
+      const Vector3 offset(random.nextFloatRange(-maxOffset, maxOffset),
+                           random.nextFloatRange(-maxOffset, maxOffset),
+                           random.nextFloatRange(-maxOffset, maxOffset));
+      boxes[i] = AABox(boxes[i].minPoint + offset, boxes[i].maxPoint + offset);
+      reinserted += tree.move(proxies[i], boxes[i]) ? 1 : 0;
+      REQUIRE(tree.getBounds(proxies[i]).minPoint == boxes[i].minPoint);
+    }
+    // Small moves stay inside the fat boxes.
+    REQUIRE(reinserted < COUNT);
+
+    for (SIZE_T i = 0; i < COUNT; i += 3) {
+      tree.remove(proxies[i]);
+      alive[i] = false;
+    }
+    REQUIRE(tree.getProxyCount() == COUNT - (COUNT + 2) / 3);
+    checkQueries();
+
+    // Freed slots are recycled.
+    for (SIZE_T i = 0; i < COUNT; i += 3) {
+      proxies[i] = tree.insert(boxes[i], static_cast<uint32>(i));
+      REQUIRE(tree.getItem(proxies[i]) == i);
+      alive[i] = true;
+    }
+    REQUIRE(tree.getProxyCount() == COUNT);
+    checkQueries();
+  }
+
+  SECTION("Early exit and clear") {
+    uint32 visited = 0;
+    tree.queryAABox(AABox(Vector3(-200.0f, -200.0f, -200.0f), Vector3(200.0f, 200.0f, 200.0f)),
+                    [&](const uint32&) { return ++visited < 10; });
+    REQUIRE(visited == 10);
+
+    tree.clear();
+    REQUIRE(tree.empty());
+    REQUIRE(tree.getProxyCount() == 0);
+    const Tree::ProxyId single = tree.insert(boxes[0], 0);
+    REQUIRE(tree.getHeight() == 0);
+    tree.remove(single);
+    REQUIRE(tree.empty());
+  }
+}
+
+TEST_CASE("chUtilities - TransformHierarchy") {
+  using NodeId = TransformHierarchy::NodeId;
+  TransformHierarchy hierarchy;
+  RandomStream random(32);
+
+  auto randomRotation = [&random]() {
+    return Quaternion(random.nextUnitVector(), Degree(random.nextFloatRange(-180.0f, 180.0f)));
+  };
+
+  // Random forest, every node gets a parent created before it.
+  const SIZE_T COUNT = 500;
+  Vector<NodeId> nodes;
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    const NodeId parent = (i < 3) ? TransformHierarchy::INVALID_NODE
+                                  : nodes[random.nextIntRange(0, static_cast<int32>(i) - 1)];
+    nodes.push_back(hierarchy.createNode(parent,
+                                         random.nextPointInBox(Vector3(-5.0f, -5.0f, -5.0f),
+                                                               Vector3(5.0f, 5.0f, 5.0f)),
+                                         randomRotation(),
+                                         Vector3(random.nextFloatRange(0.5f, 1.5f),
+                                                 random.nextFloatRange(0.5f, 1.5f),
+                                                 random.nextFloatRange(0.5f, 1.5f))));
+  }
+
+  // Reference world matrix walking the parent chain.
+  std::function<Matrix3x4(NodeId)> expectedWorld = [&](NodeId node) {
+    const Matrix3x4 local(hierarchy.getLocalScale(node), hierarchy.getLocalRotation(node),
+                          hierarchy.getLocalPosition(node));
+    const NodeId parent = hierarchy.getParent(node);
+    return parent == TransformHierarchy::INVALID_NODE ? local : local * expectedWorld(parent);
+  };
+  auto checkAll = [&]() {
+    for (NodeId node : nodes) {
+      if (!hierarchy.isValid(node)) {
+        continue;
+      }
+      const Matrix3x4 expected = expectedWorld(node);
+      const Matrix3x4& world = hierarchy.getWorldMatrix(node);
+      for (int32 r = 0; r < 3; ++r) {
+        for (int32 c = 0; c < 4; ++c) {
+          REQUIRE(isNear(world.at(r, c), expected.at(r, c), 1e-3f));
+        }
+      }
+    }
+  };
+
+  REQUIRE(hierarchy.updateWorldMatrices() == COUNT);
+  checkAll();
+  REQUIRE(hierarchy.updateWorldMatrices() == 0);
+
+  SECTION("Only dirty subtrees are recomputed") {
+    const NodeId leaf = hierarchy.createNode(nodes[10]);
+    REQUIRE(hierarchy.updateWorldMatrices() == 1);
+    hierarchy.setLocalPosition(leaf, Vector3(1.0f, 2.0f, 3.0f));
+    Vector<NodeId> updatedNodes;
+    REQUIRE(hierarchy.updateWorldMatrices(&updatedNodes) == 1);
+    REQUIRE(updatedNodes == Vector<NodeId>{leaf});
+
+    SIZE_T subtree = 0;
+    for (NodeId node : nodes) {
+      for (NodeId n = node; n != TransformHierarchy::INVALID_NODE; n = hierarchy.getParent(n)) {
+        if (n == nodes[0]) {
+          ++subtree;
+          break;
+        }
+      }
+    }
+    hierarchy.setLocalRotation(nodes[0], randomRotation());
+    REQUIRE(hierarchy.updateWorldMatrices() == subtree);
+    checkAll();
+  }
+
+  SECTION("Reparenting under a later node re-sorts the hierarchy") {
+    hierarchy.setParent(nodes[1], nodes[COUNT - 1]);
+    hierarchy.setParent(nodes[2], TransformHierarchy::INVALID_NODE);
+    REQUIRE(hierarchy.getParent(nodes[1]) == nodes[COUNT - 1]);
+    hierarchy.updateWorldMatrices();
+    checkAll();
+    REQUIRE(hierarchy.getHierarchyIndex(nodes[COUNT - 1]) <
+            hierarchy.getHierarchyIndex(nodes[1]));
+  }
+
+  SECTION("Destroying a node removes its subtree") {
+    hierarchy.destroyNode(nodes[0]);
+    REQUIRE_FALSE(hierarchy.isValid(nodes[0]));
+    SIZE_T alive = 0;
+    for (NodeId node : nodes) {
+      if (hierarchy.isValid(node)) {
+        ++alive;
+        REQUIRE(hierarchy.getParent(node) != nodes[0]);
+      }
+    }
+    REQUIRE(hierarchy.getNodeCount() == alive);
+    REQUIRE(alive < COUNT);
+
+    const NodeId reused = hierarchy.createNode(nodes[1]);
+    REQUIRE(hierarchy.isValid(reused));
+    hierarchy.updateWorldMatrices();
+    checkAll();
+  }
+
+  SECTION("Nodes created in bulk match nodes created one by one") {
+    const SIZE_T BATCH = 64;
+    Vector<uint32> parents(BATCH);
+    Vector<Vector3> positions(BATCH);
+    Vector<Quaternion> rotations(BATCH);
+    Vector<Vector3> scales(BATCH, Vector3::UNIT);
+    for (SIZE_T i = 0; i < BATCH; ++i) {
+      const int32 lastParent = static_cast<int32>(i) - 1;
+      parents[i] = i == 0 ? TransformHierarchy::INVALID_NODE
+                          : static_cast<uint32>(random.nextIntRange(0, lastParent));
+      positions[i] =
+          random.nextPointInBox(Vector3(-5.0f, -5.0f, -5.0f), Vector3(5.0f, 5.0f, 5.0f));
+      rotations[i] = randomRotation();
+    }
+
+    Vector<NodeId> batch(BATCH);
+    hierarchy.createNodes(BATCH, parents.data(), positions.data(), rotations.data(),
+                          scales.data(), batch.data());
+    for (SIZE_T i = 0; i < BATCH; ++i) {
+      REQUIRE(hierarchy.getParent(batch[i]) ==
+              (i == 0 ? TransformHierarchy::INVALID_NODE : batch[parents[i]]));
+      REQUIRE(hierarchy.getLocalPosition(batch[i]) == positions[i]);
+    }
+
+    REQUIRE(hierarchy.updateWorldMatrices() == BATCH);
+    nodes.insert(nodes.end(), batch.begin(), batch.end());
+    checkAll();
+  }
+
+  SECTION("Different nodes can be moved from several threads") {
+    Vector<Vector3> positions(COUNT);
+    for (Vector3& position : positions) {
+      position =
+          random.nextPointInBox(Vector3(-5.0f, -5.0f, -5.0f), Vector3(5.0f, 5.0f, 5.0f));
+    }
+
+    JobSystem jobs(3);
+    jobs.parallelFor(COUNT, 8, [&](SIZE_T begin, SIZE_T end) {
+      for (SIZE_T i = begin; i < end; ++i) {
+        hierarchy.setLocalPosition(nodes[i], positions[i]);
+      }
+    });
+
+    REQUIRE(hierarchy.updateWorldMatrices() == COUNT);
+    for (SIZE_T i = 0; i < COUNT; ++i) {
+      REQUIRE(hierarchy.getLocalPosition(nodes[i]) == positions[i]);
+    }
+    checkAll();
+  }
+}
+
+// Run with: chUtilitiesTest "[benchmark]"
+TEST_CASE("chUtilities - TransformHierarchyBenchmark", "[.][benchmark]") {
+  using Clock = std::chrono::high_resolution_clock;
+  using Micro = std::chrono::microseconds;
+  using NodeId = TransformHierarchy::NodeId;
+  const SIZE_T COUNT = 100000;
+  RandomStream random(32);
+
+  TransformHierarchy hierarchy;
+  hierarchy.reserve(COUNT);
+  Vector<NodeId> nodes;
+  nodes.reserve(COUNT);
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    // Roughly 8 children per node, keeps the tree a few levels deep.
+    const NodeId parent = i == 0 ? TransformHierarchy::INVALID_NODE : nodes[(i - 1) / 8];
+    nodes.push_back(hierarchy.createNode(parent, Vector3(1.0f, 0.0f, 0.0f)));
+  }
+
+  auto start = Clock::now();
+  const SIZE_T full = hierarchy.updateWorldMatrices();
+  const auto fullTime = Clock::now() - start;
+
+  // Touch 1% of the nodes, mostly leaves.
+  for (SIZE_T i = 0; i < COUNT / 100; ++i) {
+    hierarchy.setLocalPosition(nodes[random.nextIntRange(0, static_cast<int32>(COUNT) - 1)],
+                               Vector3(0.0f, 1.0f, 0.0f));
+  }
+  start = Clock::now();
+  const SIZE_T partial = hierarchy.updateWorldMatrices();
+  const auto partialTime = Clock::now() - start;
+
+  start = Clock::now();
+  hierarchy.setLocalPosition(nodes[0], Vector3(0.0f, 0.0f, 1.0f));
+  const SIZE_T root = hierarchy.updateWorldMatrices();
+  const auto rootTime = Clock::now() - start;
+
+  WARN("Full update:       " << full << " nodes, "
+                             << std::chrono::duration_cast<Micro>(fullTime).count() << " us");
+  WARN("1% dirty update:   " << partial << " nodes, "
+                             << std::chrono::duration_cast<Micro>(partialTime).count()
+                             << " us");
+  WARN("Root moved update: " << root << " nodes, "
+                             << std::chrono::duration_cast<Micro>(rootTime).count() << " us");
+  REQUIRE(full == COUNT);
+  REQUIRE(root == COUNT);
+}
+
+TEST_CASE("chUtilities - Parallel") {
+  for (SIZE_T count : {static_cast<SIZE_T>(0), static_cast<SIZE_T>(7),
+                       static_cast<SIZE_T>(100000)}) {
+    Vector<uint32> visits(count, 0);
+    // Catch assertions are not thread safe, record and check after the loop.
+    Atomic<SIZE_T> ranges = 0;
+    Atomic<bool> emptyRange = false;
+    Parallel::forRange(count, 1000, [&](SIZE_T begin, SIZE_T end) {
+      emptyRange = emptyRange || begin >= end;
+      ++ranges;
+      for (SIZE_T i = begin; i < end; ++i) {
+        ++visits[i];
+      }
+    });
+    REQUIRE_FALSE(emptyRange);
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](uint32 v) { return v == 1; }));
+    REQUIRE(ranges <= Math::max(static_cast<SIZE_T>(Parallel::getThreadCount()),
+                                static_cast<SIZE_T>(1)));
+  }
+}
+
+TEST_CASE("chUtilities - JobSystem") {
+  JobSystem jobs(3);
+  REQUIRE(jobs.getWorkerCount() == 3);
+
+  for (SIZE_T count : {static_cast<SIZE_T>(0), static_cast<SIZE_T>(7),
+                       static_cast<SIZE_T>(100000)}) {
+    Vector<uint32> visits(count, 0);
+    Atomic<bool> emptyRange = false;
+    jobs.parallelFor(count, 64, [&](SIZE_T begin, SIZE_T end) {
+      emptyRange = emptyRange || begin >= end;
+      for (SIZE_T i = begin; i < end; ++i) {
+        ++visits[i];
+      }
+    });
+    REQUIRE_FALSE(emptyRange);
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](uint32 v) { return v == 1; }));
+  }
+
+  // Jobs waiting on their own jobs, the waiting threads keep running work
+  Atomic<uint32> innerRuns = 0;
+  JobCounter outerCounter;
+  for (uint32 i = 0; i < 16; ++i) {
+    jobs.schedule([&]() {
+      JobCounter innerCounter;
+      for (uint32 j = 0; j < 32; ++j) {
+        jobs.schedule([&]() { ++innerRuns; }, &innerCounter);
+      }
+      jobs.wait(innerCounter);
+    }, &outerCounter);
+  }
+  jobs.wait(outerCounter);
+  REQUIRE(outerCounter.isDone());
+  REQUIRE(innerRuns == 16 * 32);
+
+  // More jobs than a deque holds, the overflow runs inline
+  Atomic<uint32> runs = 0;
+  JobCounter counter;
+  const uint32 jobCount = JobSystem::DEQUE_CAPACITY * 2;
+  for (uint32 i = 0; i < jobCount; ++i) {
+    jobs.schedule([&]() { ++runs; }, &counter);
+  }
+  jobs.wait(counter);
+  REQUIRE(runs == jobCount);
+
+  // Threads outside the pool go through the shared queue
+  Atomic<uint32> foreignRuns = 0;
+  Thread foreign([&]() {
+    JobCounter foreignCounter;
+    for (uint32 i = 0; i < 100; ++i) {
+      jobs.schedule([&]() { ++foreignRuns; }, &foreignCounter);
+    }
+    jobs.wait(foreignCounter);
+  });
+  foreign.join();
+  REQUIRE(foreignRuns == 100);
+
+  // Jobs nobody waits on still run before the system is destroyed
+  Atomic<uint32> detachedRuns = 0;
+  {
+    JobSystem detached(2);
+    for (uint32 i = 0; i < 500; ++i) {
+      detached.schedule([&]() { ++detachedRuns; });
+    }
+  }
+  REQUIRE(detachedRuns == 500);
+}
+
+namespace {
+// Triangles as position triples, rotated so the smallest corner comes first (same winding)
+Vector<Array<float, 9>>
+getTriangleSet(const Vector<uint32>& indices, const Vector<float>& positions) {
+  Vector<Array<float, 9>> triangles;
+  for (SIZE_T t = 0; t < indices.size(); t += 3) {
+    Array<Array<float, 3>, 3> corners;
+    for (SIZE_T k = 0; k < 3; ++k) {
+      const float* p = &positions[indices[t + k] * 3];
+      corners[k] = {p[0], p[1], p[2]};
+    }
+    std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()),
+                corners.end());
+
+    Array<float, 9>& triangle = triangles.emplace_back();
+    for (SIZE_T k = 0; k < 9; ++k) {
+      triangle[k] = corners[k / 3][k % 3];
+    }
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+} // namespace
+
+TEST_CASE("chUtilities - MeshOptimizer") {
+  // Grid triangles in random order with three vertices of their own each
+  constexpr uint32 GRID_SIZE = 32;
+  Vector<Array<uint32, 3>> gridTriangles;
+  for (uint32 y = 0; y < GRID_SIZE; ++y) {
+    for (uint32 x = 0; x < GRID_SIZE; ++x) {
+      const uint32 corner = y * (GRID_SIZE + 1) + x;
+      gridTriangles.push_back({corner, corner + 1, corner + GRID_SIZE + 1});
+      gridTriangles.push_back({corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1});
+    }
+  }
+
+  RandomStream random(40);
+  for (SIZE_T i = gridTriangles.size() - 1; i > 0; --i) {
+    std::swap(gridTriangles[i],
+              gridTriangles[random.nextIntRange(0, static_cast<int32>(i))]);
+  }
+
+  Vector<float> positions;
+  Vector<uint32> indices;
+  for (const Array<uint32, 3>& triangle : gridTriangles) {
+    for (const uint32 corner : triangle) {
+      indices.push_back(static_cast<uint32>(indices.size()));
+      positions.push_back(static_cast<float>(corner % (GRID_SIZE + 1)));
+      positions.push_back(static_cast<float>(corner / (GRID_SIZE + 1)));
+      positions.push_back(0.0f);
+    }
+  }
+  const Vector<Array<float, 9>> originalTriangles = getTriangleSet(indices, positions);
+  constexpr uint32 STRIDE = 3 * sizeof(float);
+
+  // Deduplication
+  uint32 vertexCount = static_cast<uint32>(indices.size());
+  Vector<uint32> remap;
+  const uint32 uniqueCount = MeshOptimizer::generateVertexRemap(
+      indices, reinterpret_cast<const uint8*>(positions.data()), vertexCount, STRIDE, remap);
+  REQUIRE(uniqueCount == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+
+  MeshOptimizer::remapIndices(indices, remap);
+  Vector<uint8> vertexBytes = MeshOptimizer::remapVertices(
+      reinterpret_cast<const uint8*>(positions.data()), vertexCount, STRIDE, remap,
+      uniqueCount);
+  vertexCount = uniqueCount;
+  positions.resize(vertexCount * 3);
+  std::memcpy(positions.data(), vertexBytes.data(), vertexBytes.size());
+  REQUIRE(getTriangleSet(indices, positions) == originalTriangles);
+
+  // Vertex cache
+  const VertexCacheStats shuffledStats =
+      MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+  MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+  const VertexCacheStats cacheStats = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+  REQUIRE(shuffledStats.acmr > 2.0f);
+  REQUIRE(cacheStats.acmr < 0.8f);
+  REQUIRE(cacheStats.atvr < 1.6f);
+  REQUIRE(getTriangleSet(indices, positions) == originalTriangles);
+
+  // Overdraw, the cache efficiency stays inside the threshold
+  MeshOptimizer::optimizeOverdraw(indices, vertexBytes.data(), STRIDE, vertexCount, 1.05f);
+  const VertexCacheStats overdrawStats =
+      MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+  REQUIRE(overdrawStats.acmr <= cacheStats.acmr * 1.05f + 0.01f);
+  REQUIRE(getTriangleSet(indices, positions) == originalTriangles);
+
+  // Vertex fetch, vertices are stored in first use order
+  REQUIRE(MeshOptimizer::generateVertexFetchRemap(indices, vertexCount, remap) == vertexCount);
+  MeshOptimizer::remapIndices(indices, remap);
+  vertexBytes = MeshOptimizer::remapVertices(vertexBytes.data(), vertexCount, STRIDE, remap,
+                                             vertexCount);
+  std::memcpy(positions.data(), vertexBytes.data(), vertexBytes.size());
+  REQUIRE(getTriangleSet(indices, positions) == originalTriangles);
+
+  uint32 nextVertex = 0;
+  for (const uint32 index : indices) {
+    REQUIRE(index <= nextVertex);
+    nextVertex = Math::max(nextVertex, index + 1);
+  }
+
+  // Unreferenced vertices are dropped
+  const Vector<uint32> partial = {3, 1, 0};
+  REQUIRE(MeshOptimizer::generateVertexFetchRemap(partial, 4, remap) == 3);
+  REQUIRE(remap[2] == MeshOptimizer::UNUSED_VERTEX);
+  REQUIRE(remap[3] == 0);
+  REQUIRE(MeshOptimizer::analyzeVertexCache({}, 0).acmr == 0.0f);
+}
+
+TEST_CASE("chUtilities - RangeAllocator") {
+  constexpr uint64 RANGE_SIZE = 1 << 20;
+  TLSFRangeAllocator tlsf(RANGE_SIZE);
+  REQUIRE(tlsf.isEmpty());
+  REQUIRE(tlsf.getFreeRangeCount() == 1);
+  REQUIRE(tlsf.getLargestFreeRange() == RANGE_SIZE);
+
+  // The whole range and nothing more
+  const uint64 whole = tlsf.allocate(RANGE_SIZE);
+  REQUIRE(whole == 0);
+  REQUIRE(tlsf.allocate(1) == RangeAllocator::INVALID_OFFSET);
+  tlsf.free(whole);
+  REQUIRE(tlsf.allocate(RANGE_SIZE + 1) == RangeAllocator::INVALID_OFFSET);
+
+  // An aligned free range fits exactly, without room for the worst case padding
+  const uint64 alignedWhole = tlsf.allocate(RANGE_SIZE, 256);
+  REQUIRE(alignedWhole == 0);
+  tlsf.free(alignedWhole);
+
+  // Random allocations never overlap, respect their alignment and merge back on free
+  RandomStream random(41);
+  Map<uint64, uint64> live;
+  uint64 liveBytes = 0;
+  for (uint32 i = 0; i < 20000; ++i) {
+    if (!live.empty() && random.nextFloat01() < 0.45f) {
+      auto it = live.begin();
+      std::advance(it, random.nextIntRange(0, static_cast<int32>(live.size()) - 1));
+      tlsf.free(it->first);
+      liveBytes -= it->second;
+      live.erase(it);
+      continue;
+    }
+
+    const uint64 size = static_cast<uint64>(random.nextIntRange(1, 8192));
+    const uint64 alignment = uint64(1) << random.nextIntRange(0, 8);
+    const uint64 offset = tlsf.allocate(size, alignment);
+    if (offset == RangeAllocator::INVALID_OFFSET) {
+      REQUIRE(tlsf.getLargestFreeRange() < size + alignment - 1);
+      continue;
+    }
+
+    REQUIRE(offset % alignment == 0);
+    REQUIRE(offset + size <= RANGE_SIZE);
+    auto next = live.lower_bound(offset);
+    REQUIRE((next == live.end() || offset + size <= next->first));
+    if (next != live.begin()) {
+      auto prev = std::prev(next);
+      REQUIRE(prev->first + prev->second <= offset);
+    }
+
+    live[offset] = size;
+    liveBytes += size;
+    REQUIRE(tlsf.getUsedSize() == liveBytes);
+  }
+  REQUIRE(tlsf.getAllocationCount() == live.size());
+
+  for (const auto& [offset, size] : live) {
+    tlsf.free(offset);
+  }
+  REQUIRE(tlsf.isEmpty());
+  REQUIRE(tlsf.getUsedSize() == 0);
+  REQUIRE(tlsf.getFreeRangeCount() == 1);
+  REQUIRE(tlsf.getLargestFreeRange() == RANGE_SIZE);
+
+  // Linear ranges are reclaimed once all of them are free
+  LinearRangeAllocator linear(1024);
+  REQUIRE(linear.allocate(100) == 0);
+  const uint64 aligned = linear.allocate(100, 256);
+  REQUIRE(aligned == 256);
+  REQUIRE(linear.getUsedSize() == 356);
+  REQUIRE(linear.allocate(700) == RangeAllocator::INVALID_OFFSET);
+  linear.free(0);
+  REQUIRE(linear.getUsedSize() == 356);
+  linear.free(aligned);
+  REQUIRE(linear.isEmpty());
+  REQUIRE(linear.allocate(1024) == 0);
+  linear.reset();
+  REQUIRE(linear.getLargestFreeRange() == 1024);
+}
+
+TEST_CASE("chUtilities - ArenaAllocator") {
+  ArenaAllocator arena(256);
+  REQUIRE(arena.getBlockCount() == 0);
+
+  uint8* a = static_cast<uint8*>(arena.allocate(3, 1));
+  double* b = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+  REQUIRE(reinterpret_cast<SIZE_T>(b) % alignof(double) == 0);
+  REQUIRE(reinterpret_cast<uint8*>(b) >= a + 3);
+  REQUIRE(arena.getBlockCount() == 1);
+
+  // Only the last allocation is given back.
+  const SIZE_T used = arena.getUsedBytes();
+  arena.deallocate(a, 3);
+  REQUIRE(arena.getUsedBytes() == used);
+  arena.deallocate(b, sizeof(double));
+  REQUIRE(arena.getUsedBytes() == used - sizeof(double));
+
+  // Bigger than a block gets a block of its own.
+  void* big = arena.allocate(1000);
+  REQUIRE(big != nullptr);
+  REQUIRE(arena.getBlockCount() == 2);
+  REQUIRE(arena.getReservedBytes() >= 1256);
+
+  struct Counted
+  {
+    explicit Counted(int32 v) : value(v) {}
+    int32 value;
+  };
+  Counted* counted = arena.construct<Counted>(42);
+  REQUIRE(counted->value == 42);
+
+  arena.reset();
+  REQUIRE(arena.getBlockCount() == 1);
+  REQUIRE(arena.getUsedBytes() == 0);
+
+  // A vector growing at the top of the arena reuses its own tail.
+  Vector<uint32, ArenaStdAllocator<uint32>> values{ArenaStdAllocator<uint32>(&arena)};
+  for (uint32 i = 0; i < 32; ++i) {
+    values.push_back(i);
+  }
+  REQUIRE(values.size() == 32);
+  REQUIRE(values[31] == 31);
+  REQUIRE(arena.getUsedBytes() < 2 * 32 * sizeof(uint32));
+
+  // Without an arena it behaves like the default allocator.
+  Vector<uint32, ArenaStdAllocator<uint32>> heapValues;
+  heapValues.assign(100, 7u);
+  REQUIRE(heapValues.back() == 7);
+  REQUIRE(ArenaStdAllocator<uint32>(&arena) == ArenaStdAllocator<float>(&arena));
+  REQUIRE(ArenaStdAllocator<uint32>(&arena) != ArenaStdAllocator<uint32>());
+}
+
 TEST_CASE("chUtilities - Utilities") {
   class Submodule : public Module<Submodule>
   {
@@ -1638,6 +2845,151 @@ TEST_CASE("chUtilities - RandomNumbers") {
   REQUIRE(randomNumber == 735);
 }
 
+TEST_CASE("chUtilities - RandomStream") {
+  RandomStream rnd(42);
+  RandomStream sameSeed(42);
+
+  for (uint32 i = 0; i < 100; ++i) {
+    REQUIRE(rnd.next() == sameSeed.next());
+  }
+
+  for (uint32 i = 0; i < 1000; ++i) {
+    const float f = rnd.nextFloat01();
+    REQUIRE(f >= 0.0f);
+    REQUIRE(f < 1.0f);
+
+    const int32 n = rnd.nextIntRange(-3, 5);
+    REQUIRE(n >= -3);
+    REQUIRE(n <= 5);
+
+    REQUIRE(isNear(rnd.nextUnitVector().magnitude(), 1.0f, 0.001f));
+  }
+
+  // Split streams must not repeat the parent sequence.
+  RandomStream parent(7);
+  RandomStream child = parent.split();
+  RandomStream reference(7);
+  REQUIRE(child.next() == reference.next());
+  REQUIRE(parent.next() != child.next());
+
+  // The bulk lanes are split as well.
+  RandomStream bulkParent(7);
+  RandomStream bulkChild = bulkParent.split();
+  Vector<uint32> parentBulk(64);
+  Vector<uint32> childBulk(64);
+  bulkParent.fillUint32(parentBulk.data(), parentBulk.size());
+  bulkChild.fillUint32(childBulk.data(), childBulk.size());
+  for (SIZE_T i = 0; i < parentBulk.size(); i += 8) {
+    REQUIRE(parentBulk[i] != childBulk[i]);
+  }
+
+  // Bulk fills continue one stream, chunked fills give the numbers of a single fill even
+  // when the chunks are not multiples of the lane count.
+  const SIZE_T COUNT = 1027;
+  Vector<uint32> bulkA(COUNT);
+  Vector<uint32> bulkB(COUNT);
+  Vector<uint32> bulkC(COUNT);
+  RandomStream bulkRndA(99);
+  RandomStream bulkRndB(99);
+  RandomStream bulkRndC(99);
+  bulkRndA.fillUint32(bulkA.data(), COUNT);
+  for (SIZE_T i = 0; i < COUNT; i += 4) {
+    bulkRndB.fillUint32(bulkB.data() + i, Math::min<SIZE_T>(4, COUNT - i));
+  }
+  for (SIZE_T i = 0, chunk = 1; i < COUNT; i += chunk, chunk = chunk % 7 + 1) {
+    bulkRndC.fillUint32(bulkC.data() + i, Math::min(chunk, COUNT - i));
+  }
+  REQUIRE(bulkA == bulkB);
+  REQUIRE(bulkA == bulkC);
+
+  Vector<float> floatsA(6);
+  Vector<float> floatsB(6);
+  RandomStream floatRndA(5);
+  RandomStream floatRndB(5);
+  floatRndA.fillFloat01(floatsA.data(), 6);
+  floatRndB.fillFloat01(floatsB.data(), 3);
+  floatRndB.fillFloat01(floatsB.data() + 3, 3);
+  REQUIRE(floatsA == floatsB);
+
+  Vector<float> floats(COUNT);
+  rnd.fillFloatRange(floats.data(), COUNT, -2.0f, 2.0f);
+  float mean = 0.0f;
+  for (float f : floats) {
+    REQUIRE(f >= -2.0f);
+    REQUIRE(f < 2.0f);
+    mean += f;
+  }
+  REQUIRE(isNear(mean / COUNT, 0.0f, 0.2f));
+
+  Vector<int32> ints(COUNT);
+  rnd.fillIntRange(ints.data(), COUNT, 10, 20);
+  for (int32 n : ints) {
+    REQUIRE(n >= 10);
+    REQUIRE(n <= 20);
+  }
+
+  Vector<Vector3> points(COUNT);
+  rnd.fillUnitVectors(points.data(), COUNT);
+  for (const Vector3& p : points) {
+    REQUIRE(isNear(p.magnitude(), 1.0f, 0.001f));
+  }
+
+  const Vector3 center(1.0f, 2.0f, 3.0f);
+  rnd.fillPointsInSphere(points.data(), COUNT, center, 2.0f);
+  for (const Vector3& p : points) {
+    REQUIRE(p.distance(center) <= 2.0f + 0.001f);
+  }
+
+  const Vector3 boxMin(-1.0f, 0.0f, 5.0f);
+  const Vector3 boxMax(1.0f, 4.0f, 6.0f);
+  rnd.fillPointsInBox(points.data(), COUNT, boxMin, boxMax);
+  for (const Vector3& p : points) {
+    REQUIRE(p.x >= boxMin.x);
+    REQUIRE(p.y >= boxMin.y);
+    REQUIRE(p.z >= boxMin.z);
+    REQUIRE(p.x <= boxMax.x);
+    REQUIRE(p.y <= boxMax.y);
+    REQUIRE(p.z <= boxMax.z);
+  }
+}
+
+// Run with: chUtilitiesTest "[benchmark]"
+TEST_CASE("chUtilities - RandomBenchmark", "[.][benchmark]") {
+  using Clock = std::chrono::high_resolution_clock;
+  const SIZE_T COUNT = 1 << 22;
+  Vector<float> values(COUNT);
+
+  Random lcg(1);
+  auto start = Clock::now();
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    values[i] = lcg.getRandom01();
+  }
+  const auto lcgTime = Clock::now() - start;
+  float checksum = values[COUNT - 1];
+
+  RandomStream stream(1);
+  start = Clock::now();
+  for (SIZE_T i = 0; i < COUNT; ++i) {
+    values[i] = stream.nextFloat01();
+  }
+  const auto streamTime = Clock::now() - start;
+  checksum += values[COUNT - 1];
+
+  start = Clock::now();
+  stream.fillFloat01(values.data(), COUNT);
+  const auto bulkTime = Clock::now() - start;
+  checksum += values[COUNT - 1];
+
+  using Micro = std::chrono::microseconds;
+  WARN("LCG getRandom01:          " << std::chrono::duration_cast<Micro>(lcgTime).count()
+                                    << " us");
+  WARN("RandomStream nextFloat01: " << std::chrono::duration_cast<Micro>(streamTime).count()
+                                    << " us");
+  WARN("RandomStream fillFloat01: " << std::chrono::duration_cast<Micro>(bulkTime).count()
+                                    << " us");
+  REQUIRE(checksum >= 0.0f);
+}
+
 TEST_CASE("CommandParser Tests", "[CommandParser]") {
 
   SECTION("TestParse") {
@@ -0,0 +1,682 @@
+/************************************************************************/
+/**
+ * @file chVulkanMain.cpp
+ * @author AccelMR
+ * @date 2025/08/11
+ * @brief Unit tests of the Vulkan backend pieces that don't need a window.
+ *
+ * Tests tagged [device] run on whatever device the loader finds, a software driver like
+ * lavapipe is enough. Without a Vulkan driver they are left out of the default run and
+ * the executable returns SKIP_RETURN_CODE, so a machine without a driver never reports
+ * them as passed. Naming them explicitly without a driver makes them fail.
+ */
+/************************************************************************/
+#include "chVulkanMemoryAllocator.h"
+#include "chVulkanPipelineCache.h"
+#include "chVulkanUploadManager.h"
+
+#include "chLogger.h"
+
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+namespace chEngineSDK {
+CH_LOG_DEFINE_CATEGORY_SHARED(Vulkan, All);
+} // namespace chEngineSDK
+
+using namespace chEngineSDK;
+
+namespace {
+/**
+ * Headless instance and device on the first physical device, destroyed with the test.
+ */
+struct TestDevice
+{
+  TestDevice() {
+    VkApplicationInfo appInfo{};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "chVulkanTest";
+    appInfo.apiVersion = VK_API_VERSION_1_0;
+
+    VkInstanceCreateInfo instanceInfo{};
+    instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instanceInfo.pApplicationInfo = &appInfo;
+    if (vkCreateInstance(&instanceInfo, nullptr, &instance) != VK_SUCCESS) {
+      instance = VK_NULL_HANDLE;
+      return;
+    }
+
+    uint32 deviceCount = 1;
+    const VkResult result =
+        vkEnumeratePhysicalDevices(instance, &deviceCount, &physicalDevice);
+    if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || deviceCount == 0) {
+      physicalDevice = VK_NULL_HANDLE;
+      return;
+    }
+
+    const float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo{};
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = 0;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo deviceInfo{};
+    deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    if (vkCreateDevice(physicalDevice, &deviceInfo, nullptr, &device) != VK_SUCCESS) {
+      device = VK_NULL_HANDLE;
+    }
+  }
+
+  ~TestDevice() {
+    if (device != VK_NULL_HANDLE) {
+      vkDestroyDevice(device, nullptr);
+    }
+    if (instance != VK_NULL_HANDLE) {
+      vkDestroyInstance(instance, nullptr);
+    }
+  }
+
+  NODISCARD bool
+  isValid() const {
+    return device != VK_NULL_HANDLE;
+  }
+
+  NODISCARD VkBuffer
+  createBuffer(VkDeviceSize size,
+               VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) const {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    REQUIRE(vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) == VK_SUCCESS);
+    return buffer;
+  }
+
+  NODISCARD VkImage
+  createImage(uint32 width, uint32 height) const {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    REQUIRE(vkCreateImage(device, &imageInfo, nullptr, &image) == VK_SUCCESS);
+    return image;
+  }
+
+  /**
+   * Same rule the allocator uses: small heaps are split in eighths
+   */
+  NODISCARD VkDeviceSize
+  getBlockSize(uint32 memoryTypeIndex, VkDeviceSize blockSize) const {
+    VkPhysicalDeviceMemoryProperties properties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &properties);
+    const uint32 heapIndex = properties.memoryTypes[memoryTypeIndex].heapIndex;
+    const VkDeviceSize heapSize = properties.memoryHeaps[heapIndex].size;
+    return heapSize <= VulkanMemoryAllocator::SMALL_HEAP_SIZE
+               ? (heapSize / 8 + 31) & ~VkDeviceSize(31)
+               : blockSize;
+  }
+
+  VkInstance instance = VK_NULL_HANDLE;
+  VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+  VkDevice device = VK_NULL_HANDLE;
+};
+
+/**
+ * Resource owner the defragment callback finds through the user data
+ */
+struct TestResource
+{
+  VulkanAllocation allocation;
+  uint32 value = 0;
+};
+
+constexpr VkDeviceSize TEST_BLOCK_SIZE = 4ull * 1024 * 1024;
+
+/**
+ * Exit code of a run that had to leave the [device] tests out, the usual test skip code
+ */
+constexpr int SKIP_RETURN_CODE = 77;
+} // namespace
+
+// The allocator logs through the Logger module, it has to be running for every test
+int main(int argc, char* argv[]) {
+  Logger::startUp();
+
+  Catch::Session session;
+  int result = session.applyCommandLine(argc, argv);
+  if (result == 0) {
+    const bool hasDriver = TestDevice().isValid();
+    const bool runsDefaultTests = session.configData().testsOrTags.empty();
+    if (!hasDriver && runsDefaultTests) {
+      session.configData().testsOrTags.push_back("~[device]");
+    }
+
+    result = session.run();
+
+    if (!hasDriver && runsDefaultTests && result == 0) {
+      std::cerr << "No Vulkan driver found, the [device] tests were SKIPPED.\n";
+      result = SKIP_RETURN_CODE;
+    }
+  }
+
+  Logger::shutDown();
+  return result;
+}
+
+/************************************************************************/
+/*
+ * Pipeline cache file, no device needed.
+ */
+/************************************************************************/
+namespace {
+VkPhysicalDeviceProperties
+makeCacheDeviceProperties() {
+  VkPhysicalDeviceProperties properties{};
+  properties.vendorID = 0x10005;
+  properties.deviceID = 0x0001;
+  properties.driverVersion = 0x00400001;
+  for (uint32 i = 0; i < VK_UUID_SIZE; ++i) {
+    properties.pipelineCacheUUID[i] = static_cast<uint8>(i * 7 + 1);
+  }
+  return properties;
+}
+
+Vector<uint8>
+makeCacheData(SIZE_T size) {
+  Vector<uint8> data(size);
+  for (SIZE_T i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8>(i * 31 + 5);
+  }
+  return data;
+}
+} // namespace
+
+TEST_CASE("chVulkan - PipelineCacheFile") {
+  const VkPhysicalDeviceProperties properties = makeCacheDeviceProperties();
+  const Vector<uint8> data = makeCacheData(1000);
+  const Vector<uint8> file = VulkanPipelineCache::buildCacheFile(properties, data);
+  REQUIRE(file.size() > data.size());
+
+  SECTION("RoundTrip") {
+    Vector<uint8> loaded;
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, file, loaded) ==
+            PipelineCacheFileStatus::Valid);
+    REQUIRE(loaded == data);
+
+    // A cache with no driver data yet is still a valid file
+    Vector<uint8> empty;
+    REQUIRE(VulkanPipelineCache::readCacheFile(
+                properties, VulkanPipelineCache::buildCacheFile(properties, {}), empty) ==
+            PipelineCacheFileStatus::Valid);
+    REQUIRE(empty.empty());
+  }
+
+  SECTION("OtherDevice") {
+    Vector<uint8> loaded;
+
+    VkPhysicalDeviceProperties other = properties;
+    other.vendorID += 1;
+    REQUIRE(VulkanPipelineCache::readCacheFile(other, file, loaded) ==
+            PipelineCacheFileStatus::OtherDevice);
+
+    other = properties;
+    other.deviceID += 1;
+    REQUIRE(VulkanPipelineCache::readCacheFile(other, file, loaded) ==
+            PipelineCacheFileStatus::OtherDevice);
+
+    other = properties;
+    other.driverVersion += 1;
+    REQUIRE(VulkanPipelineCache::readCacheFile(other, file, loaded) ==
+            PipelineCacheFileStatus::OtherDevice);
+
+    other = properties;
+    other.pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 0xFF;
+    REQUIRE(VulkanPipelineCache::readCacheFile(other, file, loaded) ==
+            PipelineCacheFileStatus::OtherDevice);
+
+    REQUIRE(loaded.empty());
+  }
+
+  SECTION("Truncated") {
+    Vector<uint8> loaded;
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, {}, loaded) ==
+            PipelineCacheFileStatus::Truncated);
+
+    const SIZE_T headerSize = file.size() - data.size();
+    const Vector<uint8> shortHeader(file.begin(), file.begin() + (headerSize - 1));
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, shortHeader, loaded) ==
+            PipelineCacheFileStatus::Truncated);
+
+    // A whole header with part of the data fails the size check
+    const Vector<uint8> shortData(file.begin(), file.end() - 1);
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, shortData, loaded) ==
+            PipelineCacheFileStatus::Damaged);
+
+    REQUIRE(loaded.empty());
+  }
+
+  SECTION("OneByteCorruption") {
+    Vector<uint8> loaded;
+
+    // Every byte of the driver data is covered by the checksum
+    for (SIZE_T i = file.size() - data.size(); i < file.size(); i += 97) {
+      Vector<uint8> corrupted = file;
+      corrupted[i] ^= 0x01;
+      REQUIRE(VulkanPipelineCache::readCacheFile(properties, corrupted, loaded) ==
+              PipelineCacheFileStatus::Damaged);
+    }
+
+    // So are the magic and the checksum in the header
+    Vector<uint8> corrupted = file;
+    corrupted[0] ^= 0x01;
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, corrupted, loaded) ==
+            PipelineCacheFileStatus::Damaged);
+
+    corrupted = file;
+    corrupted[file.size() - data.size() - 1] ^= 0x01;
+    REQUIRE(VulkanPipelineCache::readCacheFile(properties, corrupted, loaded) ==
+            PipelineCacheFileStatus::Damaged);
+
+    REQUIRE(loaded.empty());
+  }
+}
+
+/************************************************************************/
+/*
+ * Memory allocator.
+ */
+/************************************************************************/
+TEST_CASE("chVulkan - MemoryAllocator", "[device]") {
+  TestDevice testDevice;
+  REQUIRE(testDevice.isValid());
+
+  VulkanMemoryAllocator allocator(testDevice.device, testDevice.physicalDevice,
+                                  TEST_BLOCK_SIZE);
+
+  SECTION("BuffersAndImages") {
+    VkBuffer buffer = testDevice.createBuffer(64 * 1024);
+    VkImage image = testDevice.createImage(256, 256);
+
+    VulkanAllocation bufferAllocation =
+        allocator.allocateForBuffer(buffer, MemoryUsage::GpuOnly);
+    VulkanAllocation imageAllocation = allocator.allocateForImage(image, MemoryUsage::GpuOnly);
+    REQUIRE(bufferAllocation.isValid());
+    REQUIRE(imageAllocation.isValid());
+
+    // Linear and optimal tiling resources never share a block
+    REQUIRE(bufferAllocation.block != imageAllocation.block);
+
+    VulkanMemoryStats stats = allocator.getStats();
+    REQUIRE(stats.allocationCount == 2);
+    REQUIRE(stats.blockCount == 2);
+    REQUIRE(stats.dedicatedBlockCount == 0);
+    REQUIRE(stats.usedBytes >= bufferAllocation.size + imageAllocation.size);
+    REQUIRE(stats.reservedBytes >= stats.usedBytes);
+
+    vkDestroyBuffer(testDevice.device, buffer, nullptr);
+    vkDestroyImage(testDevice.device, image, nullptr);
+    allocator.free(bufferAllocation);
+    allocator.free(imageAllocation);
+    REQUIRE_FALSE(bufferAllocation.isValid());
+    REQUIRE_FALSE(imageAllocation.isValid());
+
+    // The last empty block of each pool is kept around
+    stats = allocator.getStats();
+    REQUIRE(stats.allocationCount == 0);
+    REQUIRE(stats.usedBytes == 0);
+    REQUIRE(stats.blockCount == 2);
+    REQUIRE(allocator.releaseEmptyBlocks() == 2);
+    REQUIRE(allocator.getStats().blockCount == 0);
+  }
+
+  SECTION("SubAllocation") {
+    Vector<VkBuffer> buffers;
+    Vector<VulkanAllocation> allocations;
+    for (uint32 i = 0; i < 16; ++i) {
+      buffers.push_back(testDevice.createBuffer(4 * 1024));
+      allocations.push_back(
+          allocator.allocateForBuffer(buffers.back(), MemoryUsage::CpuToGpu));
+      REQUIRE(allocations.back().mappedData != nullptr);
+    }
+
+    VulkanMemoryStats stats = allocator.getStats();
+    REQUIRE(stats.allocationCount == 16);
+    REQUIRE(stats.blockCount == 1);
+
+    // Every range is usable on its own
+    for (uint32 i = 0; i < 16; ++i) {
+      std::memset(allocations[i].mappedData, static_cast<int>(i), 4 * 1024);
+      allocator.flush(allocations[i]);
+    }
+    for (uint32 i = 0; i < 16; ++i) {
+      REQUIRE(allocations[i].mappedData[0] == i);
+      REQUIRE(allocations[i].mappedData[4 * 1024 - 1] == i);
+    }
+
+    for (uint32 i = 0; i < 16; ++i) {
+      vkDestroyBuffer(testDevice.device, buffers[i], nullptr);
+      allocator.free(allocations[i]);
+    }
+    REQUIRE(allocator.getStats().allocationCount == 0);
+  }
+
+  SECTION("DedicatedBlocks") {
+    VkBuffer buffer = testDevice.createBuffer(1024);
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(testDevice.device, buffer, &requirements);
+    vkDestroyBuffer(testDevice.device, buffer, nullptr);
+
+    VulkanAllocation small =
+        allocator.allocate(requirements, MemoryUsage::GpuOnly, VulkanResourceKind::Buffer);
+    const VkDeviceSize blockSize =
+        testDevice.getBlockSize(small.memoryTypeIndex, TEST_BLOCK_SIZE);
+
+    // More than half a block gets a block of its own
+    requirements.size = blockSize / 2 + requirements.alignment;
+    VulkanAllocation large =
+        allocator.allocate(requirements, MemoryUsage::GpuOnly, VulkanResourceKind::Buffer);
+    REQUIRE(large.isValid());
+    REQUIRE(large.block != small.block);
+
+    VulkanMemoryStats stats = allocator.getStats();
+    REQUIRE(stats.blockCount == 2);
+    REQUIRE(stats.dedicatedBlockCount == 1);
+    REQUIRE(stats.allocationCount == 2);
+
+    // Dedicated blocks are released with their allocation
+    allocator.free(large);
+    stats = allocator.getStats();
+    REQUIRE(stats.blockCount == 1);
+    REQUIRE(stats.dedicatedBlockCount == 0);
+
+    allocator.free(small);
+  }
+
+  SECTION("Defragment") {
+    VkBuffer buffer = testDevice.createBuffer(1024);
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(testDevice.device, buffer, &requirements);
+    vkDestroyBuffer(testDevice.device, buffer, nullptr);
+
+    // Host visible memory, so the move callback can copy with memcpy
+    Vector<UniquePtr<TestResource>> resources;
+    resources.push_back(chMakeUnique<TestResource>());
+    resources[0]->allocation =
+        allocator.allocate(requirements, MemoryUsage::CpuOnly, VulkanResourceKind::Buffer);
+    const VkDeviceSize blockSize =
+        testDevice.getBlockSize(resources[0]->allocation.memoryTypeIndex, TEST_BLOCK_SIZE);
+    allocator.free(resources[0]->allocation);
+    REQUIRE(allocator.releaseEmptyBlocks() == 1);
+
+    // Eighths of a block, the twelve of them need a second block
+    requirements.size = blockSize / 8;
+    resources.clear();
+    for (uint32 i = 0; i < 12; ++i) {
+      UniquePtr<TestResource> resource = chMakeUnique<TestResource>();
+      resource->allocation =
+          allocator.allocate(requirements, MemoryUsage::CpuOnly, VulkanResourceKind::Buffer);
+      resource->value = i + 1;
+      std::memset(resource->allocation.mappedData, static_cast<int>(resource->value),
+                  static_cast<SIZE_T>(requirements.size));
+      allocator.setUserData(resource->allocation, resource.get());
+      resources.push_back(std::move(resource));
+    }
+    REQUIRE(allocator.getStats().blockCount == 2);
+
+    // Leave a few allocations in each block, the second one ends up the least used
+    const VulkanMemoryBlock* firstBlock = resources[0]->allocation.block;
+    uint32 keptInFirst = 0;
+    uint32 keptInSecond = 0;
+    for (UniquePtr<TestResource>& resource : resources) {
+      const bool inFirst = resource->allocation.block == firstBlock;
+      uint32& kept = inFirst ? keptInFirst : keptInSecond;
+      if (kept < (inFirst ? 3u : 1u)) {
+        ++kept;
+        continue;
+      }
+      allocator.free(resource->allocation);
+    }
+    REQUIRE(keptInFirst == 3);
+    REQUIRE(keptInSecond == 1);
+    REQUIRE(allocator.getStats().allocationCount == 4);
+
+    uint32 callbackCount = 0;
+    const uint32 moved = allocator.defragment(
+        [&callbackCount](const VulkanAllocation& from, const VulkanAllocation& to,
+                         void* userData) {
+          ++callbackCount;
+          TestResource* resource = static_cast<TestResource*>(userData);
+          REQUIRE(resource != nullptr);
+          REQUIRE(resource->allocation.memory == from.memory);
+          REQUIRE(resource->allocation.offset == from.offset);
+          std::memcpy(to.mappedData, from.mappedData, static_cast<SIZE_T>(from.size));
+          resource->allocation = to;
+          return true;
+        });
+    REQUIRE(moved == 1);
+    REQUIRE(callbackCount == 1);
+
+    const VulkanMemoryStats stats = allocator.getStats();
+    REQUIRE(stats.blockCount == 1);
+    REQUIRE(stats.allocationCount == 4);
+
+    // Everything lives in one block and kept its contents
+    for (UniquePtr<TestResource>& resource : resources) {
+      if (!resource->allocation.isValid()) {
+        continue;
+      }
+      REQUIRE(resource->allocation.block == firstBlock);
+      REQUIRE(resource->allocation.mappedData[0] == resource->value);
+      REQUIRE(resource->allocation.mappedData[requirements.size - 1] == resource->value);
+      allocator.free(resource->allocation);
+    }
+    REQUIRE(allocator.getStats().allocationCount == 0);
+  }
+
+  SECTION("DefragmentRejectedMove") {
+    VkBuffer buffer = testDevice.createBuffer(1024);
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(testDevice.device, buffer, &requirements);
+    vkDestroyBuffer(testDevice.device, buffer, nullptr);
+
+    VulkanAllocation probe =
+        allocator.allocate(requirements, MemoryUsage::GpuOnly, VulkanResourceKind::Buffer);
+    requirements.size = testDevice.getBlockSize(probe.memoryTypeIndex, TEST_BLOCK_SIZE) / 4;
+    allocator.free(probe);
+
+    // Two blocks of one allocation each
+    Vector<VulkanAllocation> allocations;
+    for (uint32 i = 0; i < 5; ++i) {
+      allocations.push_back(
+          allocator.allocate(requirements, MemoryUsage::GpuOnly, VulkanResourceKind::Buffer));
+    }
+    for (uint32 i = 1; i < 4; ++i) {
+      allocator.free(allocations[i]);
+    }
+    REQUIRE(allocator.getStats().blockCount == 2);
+
+    // A refused move leaves the allocation and the destination block as they were
+    const uint32 moved = allocator.defragment(
+        [](const VulkanAllocation&, const VulkanAllocation&, void*) { return false; });
+    REQUIRE(moved == 0);
+
+    const VulkanMemoryStats stats = allocator.getStats();
+    REQUIRE(stats.blockCount == 2);
+    REQUIRE(stats.allocationCount == 2);
+
+    allocator.free(allocations[0]);
+    allocator.free(allocations[4]);
+  }
+}
+
+/************************************************************************/
+/*
+ * Upload manager.
+ */
+/************************************************************************/
+namespace {
+/**
+ * Copy device local buffers into one mapped buffer on queue family 0 and wait for it
+ */
+void
+readBack(const TestDevice& testDevice,
+         const Vector<VkBuffer>& buffers,
+         const Vector<VkDeviceSize>& sizes,
+         VkBuffer readbackBuffer) {
+  VkCommandPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.queueFamilyIndex = 0;
+  VkCommandPool commandPool = VK_NULL_HANDLE;
+  REQUIRE(vkCreateCommandPool(testDevice.device, &poolInfo, nullptr, &commandPool) ==
+          VK_SUCCESS);
+
+  VkCommandBufferAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocInfo.commandPool = commandPool;
+  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.commandBufferCount = 1;
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  REQUIRE(vkAllocateCommandBuffers(testDevice.device, &allocInfo, &commandBuffer) ==
+          VK_SUCCESS);
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  REQUIRE(vkBeginCommandBuffer(commandBuffer, &beginInfo) == VK_SUCCESS);
+
+  // The uploads end with a barrier towards the shader stages, the copies need their own
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                       nullptr);
+
+  VkDeviceSize offset = 0;
+  for (SIZE_T i = 0; i < buffers.size(); ++i) {
+    const VkBufferCopy region{.srcOffset = 0, .dstOffset = offset, .size = sizes[i]};
+    vkCmdCopyBuffer(commandBuffer, buffers[i], readbackBuffer, 1, &region);
+    offset += sizes[i];
+  }
+
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  REQUIRE(vkEndCommandBuffer(commandBuffer) == VK_SUCCESS);
+
+  VkQueue queue = VK_NULL_HANDLE;
+  vkGetDeviceQueue(testDevice.device, 0, 0, &queue);
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &commandBuffer;
+  REQUIRE(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS);
+  REQUIRE(vkQueueWaitIdle(queue) == VK_SUCCESS);
+
+  vkDestroyCommandPool(testDevice.device, commandPool, nullptr);
+}
+} // namespace
+
+TEST_CASE("chVulkan - UploadManager", "[device]") {
+  TestDevice testDevice;
+  REQUIRE(testDevice.isValid());
+
+  constexpr VkDeviceSize RING_SIZE = 1024 * 1024;
+  constexpr uint32 BUFFER_COUNT = 500;
+
+  VulkanMemoryAllocator allocator(testDevice.device, testDevice.physicalDevice,
+                                  TEST_BLOCK_SIZE);
+  VulkanUploadManager uploads(testDevice.device, allocator, 0, 0, RING_SIZE);
+
+  // Sizes from 1 to 8 KB, about 2 MB in total so the ring wraps
+  Vector<VkBuffer> buffers;
+  Vector<VulkanAllocation> allocations;
+  Vector<VkDeviceSize> sizes;
+  Vector<uint8> expected;
+  VkDeviceSize totalBytes = 0;
+  for (uint32 i = 0; i < BUFFER_COUNT; ++i) {
+    const VkDeviceSize size = 1024 + (i * 2654435761u) % (7 * 1024);
+    Vector<uint8> data(static_cast<SIZE_T>(size));
+    for (SIZE_T j = 0; j < data.size(); ++j) {
+      data[j] = static_cast<uint8>(i * 13 + j * 7);
+    }
+
+    buffers.push_back(testDevice.createBuffer(
+        size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+    allocations.push_back(allocator.allocateForBuffer(buffers.back(), MemoryUsage::GpuOnly));
+    sizes.push_back(size);
+
+    const uint64 serial = uploads.uploadBuffer(buffers.back(), 0, data.data(), size, false);
+    REQUIRE(serial > uploads.getSubmittedSerial());
+
+    expected.insert(expected.end(), data.begin(), data.end());
+    totalBytes += size;
+  }
+
+  // One image bigger than the ring takes a staging buffer of its own
+  VkImage image = testDevice.createImage(1024, 1024);
+  VulkanAllocation imageAllocation = allocator.allocateForImage(image, MemoryUsage::GpuOnly);
+  const Vector<uint8> pixels(1024 * 1024 * 4, 0x5A);
+  uploads.uploadImage(image, pixels.data(), pixels.size(), {1024, 1024, 1}, 1, 1);
+
+  uploads.waitIdle();
+
+  // A submit per ring's worth of data, plus the one that sends the rest
+  const VulkanUploadStats& stats = uploads.getStats();
+  REQUIRE(stats.copyCount == BUFFER_COUNT + 1);
+  REQUIRE(stats.uploadedBytes == totalBytes + pixels.size());
+  REQUIRE(stats.submitCount <= totalBytes / RING_SIZE + 2);
+  REQUIRE(uploads.getSubmittedSerial() == stats.submitCount);
+  CH_LOG_INFO(Vulkan, "Upload test: {0} buffers and one image took {1} submits",
+              BUFFER_COUNT, stats.submitCount);
+
+  VkBuffer readbackBuffer =
+      testDevice.createBuffer(totalBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  VulkanAllocation readbackAllocation =
+      allocator.allocateForBuffer(readbackBuffer, MemoryUsage::CpuOnly);
+  REQUIRE(readbackAllocation.mappedData != nullptr);
+
+  readBack(testDevice, buffers, sizes, readbackBuffer);
+  REQUIRE(std::memcmp(readbackAllocation.mappedData, expected.data(), expected.size()) == 0);
+
+  vkDestroyBuffer(testDevice.device, readbackBuffer, nullptr);
+  allocator.free(readbackAllocation);
+  vkDestroyImage(testDevice.device, image, nullptr);
+  allocator.free(imageAllocation);
+  for (SIZE_T i = 0; i < buffers.size(); ++i) {
+    vkDestroyBuffer(testDevice.device, buffers[i], nullptr);
+    allocator.free(allocations[i]);
+  }
+  REQUIRE(allocator.getStats().allocationCount == 1);
+
+  // A buffer released while its copy is pending lives until the batch retires
+  VkBuffer released = testDevice.createBuffer(4096, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  VulkanAllocation releasedAllocation =
+      allocator.allocateForBuffer(released, MemoryUsage::GpuOnly);
+  const uint64 serial = uploads.uploadBuffer(released, 0, expected.data(), 4096, false);
+  uploads.releaseBuffer(released, releasedAllocation, serial);
+  REQUIRE_FALSE(releasedAllocation.isValid());
+  REQUIRE(allocator.getStats().allocationCount == 2);
+
+  uploads.waitIdle();
+  REQUIRE(allocator.getStats().allocationCount == 1);
+}